@@ -0,0 +1,47 @@
+#ifndef BENCH_H
+#define BENCH_H
+
+#include "../include/collision.h"
+#include "../include/draw.h"
+#include "../include/init.h"
+#include "../include/particle_simd.h"
+#include "../include/particle_system.h"
+#include "../include/polygon.h"
+#include "../include/rng.h"
+#include "../include/stds.h"
+#include "../include/text.h"
+
+#include "../lib/structures/include/stds_queue.h"
+#include "../lib/structures/include/stds_stack.h"
+#include "../lib/structures/include/stds_vector.h"
+
+#define BENCH_SCREEN_WIDTH  1280
+#define BENCH_SCREEN_HEIGHT 720
+#define BENCH_MIN_SECONDS   0.25
+#define BENCH_MIN_SAMPLES   5
+#define BENCH_MAX_SAMPLES   1000
+#define BENCH_SEED          0x5eed
+#define BENCH_FONT          "tests/scroller_test/res/fonts/nes.ttf"
+
+/*
+ * Results are folded into bench_sink so the compiler cannot discard the
+ * work being timed.
+ */
+extern volatile int64_t bench_sink;
+
+extern void bench_run( const char *name, const int64_t items, void ( *fn )( void * ),
+                       void *data );
+
+extern bool bench_is_selected( const char *name );
+
+extern void bench_particles( void );
+
+extern void bench_collision( void );
+
+extern void bench_cache( void );
+
+extern void bench_structures( void );
+
+extern void bench_text( void );
+
+#endif // BENCH_H
@@ -0,0 +1,106 @@
+/**
+ * @file bench_cache.c
+ * @author Joshua Crotts
+ * @date October 14 2026
+ * @version 1.0
+ *
+ * @section LICENSE
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License as
+ * published by the Free Software Foundation; either version 2 of
+ * the License, or (at your option) any later version.
+ *
+ * @section DESCRIPTION
+ *
+ * Lookup cost of the texture and font caches once everything is resident:
+ * hashing a path to a texture handle, resolving handles to textures, and
+ * finding a cached font by file and size.
+ */
+#include "bench.h"
+
+#define TEXTURE_COUNT 256
+#define FONT_LOOKUPS  256
+
+static const uint16_t font_sizes[] = { 12, 16, 24, 32 };
+
+static char    texture_names[TEXTURE_COUNT][MAX_FILE_NAME_LEN];
+static int32_t texture_handles[TEXTURE_COUNT];
+
+static void run_texture_handle( void *data );
+static void run_texture_from_handle( void *data );
+static void run_font_lookup( void *data );
+
+/**
+ * @param void.
+ *
+ * @return void.
+ */
+void
+bench_cache( void ) {
+  SDL_Surface *surface = SDL_CreateRGBSurfaceWithFormat( 0, 16, 16, 32, SDL_PIXELFORMAT_RGBA8888 );
+
+  for ( int32_t i = 0; i < TEXTURE_COUNT; i++ ) {
+    snprintf( texture_names[i], MAX_FILE_NAME_LEN, "bench/res/img/texture_%03d.png", i );
+    texture_handles[i] = Stds_TextureHandleFromSurface( texture_names[i], surface );
+  }
+
+  SDL_FreeSurface( surface );
+
+  for ( size_t i = 0; i < sizeof( font_sizes ) / sizeof( font_sizes[0] ); i++ ) {
+    Stds_AddFont( BENCH_FONT, font_sizes[i] );
+  }
+
+  bench_run( "cache/texture_handle", TEXTURE_COUNT, run_texture_handle, NULL );
+  bench_run( "cache/texture_from_handle", TEXTURE_COUNT, run_texture_from_handle, NULL );
+  bench_run( "cache/font_lookup", FONT_LOOKUPS, run_font_lookup, NULL );
+}
+
+/**
+ * @param void * unused.
+ *
+ * @return void.
+ */
+static void
+run_texture_handle( void *data ) {
+  int64_t sum = 0;
+  for ( int32_t i = 0; i < TEXTURE_COUNT; i++ ) {
+    sum += Stds_TextureHandle( texture_names[i] );
+  }
+  bench_sink += sum;
+}
+
+/**
+ * @param void * unused.
+ *
+ * @return void.
+ */
+static void
+run_texture_from_handle( void *data ) {
+  int64_t sum = 0;
+  for ( int32_t i = 0; i < TEXTURE_COUNT; i++ ) {
+    sum += Stds_TextureFromHandle( texture_handles[i] ) != NULL;
+  }
+  bench_sink += sum;
+}
+
+/**
+ * Looks fonts up through Stds_GetStringSize with a one character string, so
+ * the time is dominated by the cache rather than by measuring glyphs.
+ *
+ * @param void * unused.
+ *
+ * @return void.
+ */
+static void
+run_font_lookup( void *data ) {
+  const size_t sizes = sizeof( font_sizes ) / sizeof( font_sizes[0] );
+  int64_t      sum   = 0;
+
+  for ( int32_t i = 0; i < FONT_LOOKUPS; i++ ) {
+    int32_t w, h;
+    Stds_GetStringSize( "A", BENCH_FONT, font_sizes[( size_t ) i % sizes], &w, &h );
+    sum += w;
+  }
+  bench_sink += sum;
+}
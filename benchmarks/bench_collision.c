@@ -0,0 +1,112 @@
+/**
+ * @file bench_collision.c
+ * @author Joshua Crotts
+ * @date October 14 2026
+ * @version 1.0
+ *
+ * @section LICENSE
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License as
+ * published by the Free Software Foundation; either version 2 of
+ * the License, or (at your option) any later version.
+ *
+ * @section DESCRIPTION
+ *
+ * Narrow-phase collision throughput: SAT between convex polygons, and the
+ * rectangle and circle overlap tests. Each call tests every shape against
+ * its neighbour. Every odd shape is placed a random distance from the one
+ * before it, so both overlapping and separated pairs are timed.
+ */
+#include "bench.h"
+
+#define POLYGON_COUNT 1024
+#define SHAPE_COUNT   4096
+
+static struct polygon_t *polygons[POLYGON_COUNT];
+static SDL_FRect         rects[SHAPE_COUNT];
+static struct circle_t   circles[SHAPE_COUNT];
+
+static void run_sat( void *data );
+static void run_rect( void *data );
+static void run_circle( void *data );
+
+/**
+ * @param void.
+ *
+ * @return void.
+ */
+void
+bench_collision( void ) {
+  for ( int32_t i = 0; i < POLYGON_COUNT; i++ ) {
+    struct vec2_t position = Stds_CreateVec2( ( float ) ( i / 2 ) * 64.f, 0 );
+    position.x += Stds_RandomFloat( 0, 40.f ) * ( float ) ( i % 2 );
+
+    polygons[i] = Stds_CreatePolygon( 6, 16.f, position, Stds_RandomFloat( 0, 360.f ) );
+    Stds_UpdatePolygon( polygons[i] );
+  }
+
+  for ( int32_t i = 0; i < SHAPE_COUNT; i++ ) {
+    float x = Stds_RandomFloat( 0, BENCH_SCREEN_WIDTH );
+    float y = Stds_RandomFloat( 0, BENCH_SCREEN_HEIGHT );
+    float s = Stds_RandomFloat( 8.f, 64.f );
+
+    if ( i % 2 == 1 ) {
+      x = rects[i - 1].x + Stds_RandomFloat( 0, rects[i - 1].w * 2.f );
+      y = rects[i - 1].y;
+    }
+
+    rects[i]   = ( SDL_FRect ){ x, y, s, s };
+    circles[i] = ( struct circle_t ){ x, y, s };
+  }
+
+  bench_run( "collision/sat", POLYGON_COUNT - 1, run_sat, NULL );
+  bench_run( "collision/rect", SHAPE_COUNT - 1, run_rect, NULL );
+  bench_run( "collision/circle", SHAPE_COUNT - 1, run_circle, NULL );
+
+  for ( int32_t i = 0; i < POLYGON_COUNT; i++ ) {
+    Stds_CleanUpPolygon( polygons[i] );
+  }
+}
+
+/**
+ * @param void * unused.
+ *
+ * @return void.
+ */
+static void
+run_sat( void *data ) {
+  int64_t hits = 0;
+  for ( int32_t i = 0; i < POLYGON_COUNT - 1; i++ ) {
+    hits += Stds_CheckSATOverlap( polygons[i], polygons[i + 1] );
+  }
+  bench_sink += hits;
+}
+
+/**
+ * @param void * unused.
+ *
+ * @return void.
+ */
+static void
+run_rect( void *data ) {
+  int64_t hits = 0;
+  for ( int32_t i = 0; i < SHAPE_COUNT - 1; i++ ) {
+    hits += Stds_RectVsRect( &rects[i], &rects[i + 1] );
+  }
+  bench_sink += hits;
+}
+
+/**
+ * @param void * unused.
+ *
+ * @return void.
+ */
+static void
+run_circle( void *data ) {
+  int64_t hits = 0;
+  for ( int32_t i = 0; i < SHAPE_COUNT - 1; i++ ) {
+    hits += Stds_CheckCircularCollision( &circles[i], &circles[i + 1] );
+  }
+  bench_sink += hits;
+}
@@ -0,0 +1,151 @@
+/**
+ * @file bench_particles.c
+ * @author Joshua Crotts
+ * @date October 14 2026
+ * @version 1.0
+ *
+ * @section LICENSE
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License as
+ * published by the Free Software Foundation; either version 2 of
+ * the License, or (at your option) any later version.
+ *
+ * @section DESCRIPTION
+ *
+ * Particle system update and draw throughput for the callback (AoS),
+ * structure-of-arrays and stateless backends. Particles are given effectively infinite
+ * life so every call processes the full population.
+ */
+#include "bench.h"
+
+static const int32_t particle_counts[] = { 10000, 50000, 200000 };
+static const char *  layout_names[]    = { "aos", "soa", "stateless" };
+
+static struct particle_system_t *create_system( const int32_t layout, const int32_t n );
+static void                      update_particle( struct particle_t *p );
+static void                      draw_particle( struct particle_t *p );
+static void                      run_update( void *data );
+static void                      run_draw( void *data );
+
+/**
+ * @param void.
+ *
+ * @return void.
+ */
+void
+bench_particles( void ) {
+  char name[64];
+
+  for ( size_t i = 0; i < sizeof( particle_counts ) / sizeof( particle_counts[0] ); i++ ) {
+    const int32_t n = particle_counts[i];
+
+    for ( int32_t layout = 0; layout < 3; layout++ ) {
+      const char *suffix = layout_names[layout];
+
+      snprintf( name, sizeof( name ), "particles/update_%s", suffix );
+      bool is_update = bench_is_selected( name );
+      snprintf( name, sizeof( name ), "particles/draw_%s", suffix );
+      bool is_draw = bench_is_selected( name );
+
+      if ( !is_update && !is_draw ) {
+        continue;
+      }
+
+      struct particle_system_t *ps = create_system( layout, n );
+
+      snprintf( name, sizeof( name ), "particles/update_%s", suffix );
+      bench_run( name, n, run_update, ps );
+      snprintf( name, sizeof( name ), "particles/draw_%s", suffix );
+      bench_run( name, n, run_draw, ps );
+
+      Stds_ParticleSystemDie( ps );
+    }
+  }
+}
+
+/**
+ * Fills a new system with n small, slow, opaque particles spread over the
+ * screen.
+ *
+ * @param int32_t index into layout_names.
+ * @param int32_t number of particles.
+ *
+ * @return particle_system_t * pointer to the full system.
+ */
+static struct particle_system_t *
+create_system( const int32_t layout, const int32_t n ) {
+  struct particle_system_t *ps = layout == 2   ? Stds_CreateParticleSystemStateless( n )
+                                 : layout == 1 ? Stds_CreateParticleSystemSoA( n )
+                                               : Stds_CreateParticleSystem( n );
+
+  for ( int32_t i = 0; i < n; i++ ) {
+    struct particle_t p;
+    memset( &p, 0, sizeof( struct particle_t ) );
+
+    p.pos         = Stds_CreateVec2( Stds_RandomFloat( 0, BENCH_SCREEN_WIDTH ),
+                             Stds_RandomFloat( 0, BENCH_SCREEN_HEIGHT ) );
+    p.velocity    = Stds_CreateVec2( Stds_RandomFloat( -0.01f, 0.01f ),
+                                  Stds_RandomFloat( -0.01f, 0.01f ) );
+    p.w           = 4;
+    p.h           = 4;
+    p.life        = INT32_MAX;
+    p.color       = ( SDL_Color ){ ( uint8_t ) Stds_RandomInt( 0, 255 ), 128, 255, 255 };
+    p.particle_update = update_particle;
+    p.particle_draw   = draw_particle;
+
+    Stds_InsertParticle( ps, &p );
+  }
+
+  return ps;
+}
+
+/**
+ * @param particle_t * particle in a callback system.
+ *
+ * @return void.
+ */
+static void
+update_particle( struct particle_t *p ) {
+  p->velocity.x += p->delta_accel.x;
+  p->velocity.y += p->delta_accel.y;
+  p->pos.x += p->velocity.x;
+  p->pos.y += p->velocity.y;
+  p->life--;
+}
+
+/**
+ * @param particle_t * particle in a callback system.
+ *
+ * @return void.
+ */
+static void
+draw_particle( struct particle_t *p ) {
+  SDL_FRect rect = { p->pos.x, p->pos.y, p->w, p->h };
+  Stds_DrawRectF( &rect, &p->color, true, false );
+}
+
+/**
+ * @param void * particle system.
+ *
+ * @return void.
+ */
+static void
+run_update( void *data ) {
+  Stds_ParticleSystemUpdate( data );
+}
+
+/**
+ * Draws the system as one frame, so the time includes rasterizing into the
+ * headless target.
+ *
+ * @param void * particle system.
+ *
+ * @return void.
+ */
+static void
+run_draw( void *data ) {
+  Stds_PrepareScene();
+  Stds_ParticleSystemDraw( data );
+  Stds_PresentScene();
+}
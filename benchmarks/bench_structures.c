@@ -0,0 +1,135 @@
+/**
+ * @file bench_structures.c
+ * @author Joshua Crotts
+ * @date October 14 2026
+ * @version 1.0
+ *
+ * @section LICENSE
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License as
+ * published by the Free Software Foundation; either version 2 of
+ * the License, or (at your option) any later version.
+ *
+ * @section DESCRIPTION
+ *
+ * Operation throughput of the generic containers in lib/structures. Each
+ * call builds a container of STRUCTURE_ITEMS integers from empty and drains
+ * or reads it back, so growth and shrinking are part of the time.
+ */
+#include "bench.h"
+
+#define STRUCTURE_ITEMS 100000
+
+static int32_t values[STRUCTURE_ITEMS];
+
+static void run_vector_append( void *data );
+static void run_vector_get( void *data );
+static void run_queue( void *data );
+static void run_stack( void *data );
+
+/**
+ * @param void.
+ *
+ * @return void.
+ */
+void
+bench_structures( void ) {
+  for ( int32_t i = 0; i < STRUCTURE_ITEMS; i++ ) {
+    values[i] = Stds_RandomInt( 0, STRUCTURE_ITEMS - 1 );
+  }
+
+  struct stds_vector_t *v = Stds_VectorCreate( sizeof( int32_t ) );
+  for ( int32_t i = 0; i < STRUCTURE_ITEMS; i++ ) {
+    Stds_VectorAppend( v, &values[i] );
+  }
+
+  bench_run( "structures/vector_append", STRUCTURE_ITEMS, run_vector_append, NULL );
+  bench_run( "structures/vector_get", STRUCTURE_ITEMS, run_vector_get, v );
+  bench_run( "structures/queue_add_poll", STRUCTURE_ITEMS, run_queue, NULL );
+  bench_run( "structures/stack_push_pop", STRUCTURE_ITEMS, run_stack, NULL );
+
+  Stds_VectorDestroy( v );
+}
+
+/**
+ * @param void * unused.
+ *
+ * @return void.
+ */
+static void
+run_vector_append( void *data ) {
+  struct stds_vector_t *v = Stds_VectorCreate( sizeof( int32_t ) );
+  for ( int32_t i = 0; i < STRUCTURE_ITEMS; i++ ) {
+    Stds_VectorAppend( v, &values[i] );
+  }
+  bench_sink += ( int64_t ) Stds_VectorSize( v );
+  Stds_VectorDestroy( v );
+}
+
+/**
+ * Reads the vector at the random indices in values, so the time includes
+ * cache misses rather than only a sequential scan.
+ *
+ * @param void * full vector.
+ *
+ * @return void.
+ */
+static void
+run_vector_get( void *data ) {
+  const struct stds_vector_t *v   = data;
+  int64_t                     sum = 0;
+
+  for ( int32_t i = 0; i < STRUCTURE_ITEMS; i++ ) {
+    sum += *( int32_t * ) Stds_VectorGet( v, values[i] );
+  }
+  bench_sink += sum;
+}
+
+/**
+ * @param void * unused.
+ *
+ * @return void.
+ */
+static void
+run_queue( void *data ) {
+  struct stds_queue_t *q   = Stds_QueueCreate( sizeof( int32_t ) );
+  int64_t              sum = 0;
+
+  for ( int32_t i = 0; i < STRUCTURE_ITEMS; i++ ) {
+    Stds_QueueAdd( q, &values[i] );
+  }
+
+  while ( !Stds_QueueIsEmpty( q ) ) {
+    int32_t value;
+    Stds_QueuePoll( q, &value );
+    sum += value;
+  }
+
+  bench_sink += sum;
+  Stds_QueueDestroy( q );
+}
+
+/**
+ * The stack stores pointers, so it is filled with pointers into values.
+ *
+ * @param void * unused.
+ *
+ * @return void.
+ */
+static void
+run_stack( void *data ) {
+  struct stds_stack_t *s   = Stds_StackCreate( sizeof( int32_t * ) );
+  int64_t              sum = 0;
+
+  for ( int32_t i = 0; i < STRUCTURE_ITEMS; i++ ) {
+    Stds_StackPush( s, &values[i] );
+  }
+
+  while ( !Stds_StackIsEmpty( s ) ) {
+    sum += *( int32_t * ) Stds_StackPop( s );
+  }
+
+  bench_sink += sum;
+  Stds_StackDestroy( s );
+}
@@ -0,0 +1,106 @@
+/**
+ * @file bench_text.c
+ * @author Joshua Crotts
+ * @date October 14 2026
+ * @version 1.0
+ *
+ * @section LICENSE
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License as
+ * published by the Free Software Foundation; either version 2 of
+ * the License, or (at your option) any later version.
+ *
+ * @section DESCRIPTION
+ *
+ * Text rendering cost per string: immediate Stds_DrawText calls, retained
+ * text objects that reuse their texture, and retained objects whose string
+ * changes every frame so they are rasterized again. Each call draws
+ * TEXT_COUNT strings as one frame.
+ */
+#include "bench.h"
+
+#define TEXT_COUNT     64
+#define TEXT_FONT_SIZE 16
+
+static const SDL_Color text_color = { 0xff, 0xff, 0x00, 0xff };
+
+static struct text_t *texts[TEXT_COUNT];
+static uint32_t       frame;
+
+static void run_draw_immediate( void *data );
+static void run_draw_retained( void *data );
+static void run_draw_changing( void *data );
+
+/**
+ * @param void.
+ *
+ * @return void.
+ */
+void
+bench_text( void ) {
+  char str[SMALL_TEXT_BUFFER];
+
+  Stds_AddFont( BENCH_FONT, TEXT_FONT_SIZE );
+
+  for ( int32_t i = 0; i < TEXT_COUNT; i++ ) {
+    snprintf( str, sizeof( str ), "Score: %d", i * 1000 );
+    texts[i] = Stds_TextCreate( BENCH_FONT, TEXT_FONT_SIZE, &text_color, str );
+  }
+
+  bench_run( "text/draw_immediate", TEXT_COUNT, run_draw_immediate, NULL );
+  bench_run( "text/draw_retained", TEXT_COUNT, run_draw_retained, NULL );
+  bench_run( "text/draw_changing", TEXT_COUNT, run_draw_changing, NULL );
+
+  for ( int32_t i = 0; i < TEXT_COUNT; i++ ) {
+    Stds_TextDie( texts[i] );
+  }
+}
+
+/**
+ * @param void * unused.
+ *
+ * @return void.
+ */
+static void
+run_draw_immediate( void *data ) {
+  Stds_PrepareScene();
+  for ( int32_t i = 0; i < TEXT_COUNT; i++ ) {
+    Stds_DrawText( 8.f, ( float ) ( i * 10 ), BENCH_FONT, TEXT_FONT_SIZE, &text_color,
+                   "Score: %d", i * 1000 );
+  }
+  Stds_PresentScene();
+}
+
+/**
+ * @param void * unused.
+ *
+ * @return void.
+ */
+static void
+run_draw_retained( void *data ) {
+  Stds_PrepareScene();
+  for ( int32_t i = 0; i < TEXT_COUNT; i++ ) {
+    Stds_TextDraw( texts[i], 8.f, ( float ) ( i * 10 ) );
+  }
+  Stds_PresentScene();
+}
+
+/**
+ * @param void * unused.
+ *
+ * @return void.
+ */
+static void
+run_draw_changing( void *data ) {
+  char str[SMALL_TEXT_BUFFER];
+
+  frame++;
+  Stds_PrepareScene();
+  for ( int32_t i = 0; i < TEXT_COUNT; i++ ) {
+    snprintf( str, sizeof( str ), "Score: %u", frame * TEXT_COUNT + ( uint32_t ) i );
+    Stds_TextSet( texts[i], str );
+    Stds_TextDraw( texts[i], 8.f, ( float ) ( i * 10 ) );
+  }
+  Stds_PresentScene();
+}
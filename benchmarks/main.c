@@ -0,0 +1,144 @@
+/**
+ * @file main.c
+ * @author Joshua Crotts
+ * @date October 14 2026
+ * @version 1.0
+ *
+ * @section LICENSE
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License as
+ * published by the Free Software Foundation; either version 2 of
+ * the License, or (at your option) any later version.
+ *
+ * @section DESCRIPTION
+ *
+ * Entry point of the microbenchmark suite built by make bench. Every
+ * benchmark prints one JSON object per line to stdout:
+ *
+ *   {"type":"result","benchmark":"particles/update_soa","n":10000,...}
+ *
+ * preceded by a single "context" line describing the build. Timings are
+ * nanoseconds per call of the benchmark body; ns_per_item divides the
+ * median by n. Passing an argument runs only the benchmarks whose name
+ * contains it, e.g. ./bench particles/.
+ *
+ * Run it from the repository root so the test resources can be found.
+ */
+#include "bench.h"
+
+volatile int64_t bench_sink;
+
+static const char *filter;
+
+static int compare_samples( const void *a, const void *b );
+
+/**
+ * @param int number of cmd arguments.
+ * @param char *[] array of string arguments. argv[1] is an optional name filter.
+ *
+ * @return status code.
+ */
+int
+main( int argc, char *argv[] ) {
+  filter = argc > 1 ? argv[1] : NULL;
+
+  Stds_InitGameHeadless( BENCH_SCREEN_WIDTH, BENCH_SCREEN_HEIGHT, BENCH_SCREEN_WIDTH,
+                         BENCH_SCREEN_HEIGHT );
+  Stds_SeedRandom( BENCH_SEED );
+
+  SDL_version version;
+  SDL_GetVersion( &version );
+  printf( "{\"type\":\"context\",\"simd\":\"%s\",\"sdl\":\"%d.%d.%d\",\"min_seconds\":%.2f}\n",
+          Stds_ParticleSimdName(), version.major, version.minor, version.patch,
+          BENCH_MIN_SECONDS );
+
+  bench_particles();
+  bench_collision();
+  bench_cache();
+  bench_structures();
+  bench_text();
+
+  return 0;
+}
+
+/**
+ * Returns whether a benchmark passes the command line filter, so suites can
+ * skip building inputs for benchmarks that will not run.
+ *
+ * @param const char * name of the benchmark.
+ *
+ * @return bool true if it should run.
+ */
+bool
+bench_is_selected( const char *name ) {
+  return filter == NULL || strstr( name, filter ) != NULL;
+}
+
+/**
+ * Times fn( data ) and prints the result as one JSON line. The body runs once
+ * untimed to warm caches, then repeatedly until at least BENCH_MIN_SECONDS
+ * have passed and BENCH_MIN_SAMPLES calls were timed, or BENCH_MAX_SAMPLES
+ * calls were made.
+ *
+ * @param const char * name of the benchmark, e.g. "collision/sat".
+ * @param int64_t number of items one call processes, used for ns_per_item.
+ * @param void (*)( void * ) benchmark body.
+ * @param void * data passed to the body.
+ *
+ * @return void.
+ */
+void
+bench_run( const char *name, const int64_t items, void ( *fn )( void * ), void *data ) {
+  static uint64_t samples[BENCH_MAX_SAMPLES];
+
+  if ( !bench_is_selected( name ) ) {
+    return;
+  }
+
+  const double frequency = ( double ) SDL_GetPerformanceFrequency();
+  const double to_ns     = 1e9 / frequency;
+  double       elapsed   = 0;
+  int32_t      count     = 0;
+
+  fn( data );
+
+  while ( count < BENCH_MAX_SAMPLES &&
+          ( count < BENCH_MIN_SAMPLES || elapsed < BENCH_MIN_SECONDS ) ) {
+    uint64_t start = SDL_GetPerformanceCounter();
+    fn( data );
+    samples[count] = SDL_GetPerformanceCounter() - start;
+    elapsed += ( double ) samples[count] / frequency;
+    count++;
+  }
+
+  qsort( samples, ( size_t ) count, sizeof( uint64_t ), compare_samples );
+
+  double total = 0;
+  for ( int32_t i = 0; i < count; i++ ) {
+    total += ( double ) samples[i];
+  }
+
+  double min      = ( double ) samples[0] * to_ns;
+  double median   = ( double ) samples[count / 2] * to_ns;
+  double mean     = total / count * to_ns;
+  double per_item = median / ( double ) ( items > 0 ? items : 1 );
+
+  printf( "{\"type\":\"result\",\"benchmark\":\"%s\",\"n\":%lld,\"iterations\":%d,"
+          "\"ns_min\":%.0f,\"ns_median\":%.0f,\"ns_mean\":%.0f,\"ns_per_item\":%.3f}\n",
+          name, ( long long ) items, count, min, median, mean, per_item );
+  fflush( stdout );
+}
+
+/**
+ * @param const void * first sample.
+ * @param const void * second sample.
+ *
+ * @return int ordering of the two samples.
+ */
+static int
+compare_samples( const void *a, const void *b ) {
+  uint64_t x = *( const uint64_t * ) a;
+  uint64_t y = *( const uint64_t * ) b;
+  return ( x > y ) - ( x < y );
+}
@@ -0,0 +1,45 @@
+#ifndef AABB_TREE_H
+#define AABB_TREE_H
+
+#include "collision.h"
+#include "stds.h"
+
+extern struct aabb_tree_t *Stds_CreateAABBTree( const float margin );
+
+extern int32_t Stds_AABBTreeInsert( struct aabb_tree_t *tree, const SDL_FRect *aabb, void *data );
+
+extern void Stds_AABBTreeRemove( struct aabb_tree_t *tree, const int32_t proxy );
+
+extern bool Stds_AABBTreeMove( struct aabb_tree_t *tree, const int32_t proxy, const SDL_FRect *aabb,
+                               const struct vec2_t *displacement );
+
+extern void *Stds_AABBTreeGetData( const struct aabb_tree_t *tree, const int32_t proxy );
+
+extern void Stds_AABBTreeQueryRect( struct aabb_tree_t *tree, const SDL_FRect *rect,
+                                    bool ( *callback )( int32_t, void *, void * ), void *user );
+
+extern int32_t Stds_AABBTreeRayCast( struct aabb_tree_t *tree, const struct vec2_t *ray,
+                                     const struct vec2_t *ray_direction,
+                                     struct vec2_t *contact_point, struct vec2_t *contact_norm,
+                                     float *hit_near );
+
+extern int32_t Stds_AABBTreeSweepRect( struct aabb_tree_t *tree, const SDL_FRect *rect,
+                                       const struct vec2_t *velocity, const int32_t ignore,
+                                       struct vec2_t *contact_point, struct vec2_t *contact_norm,
+                                       float *hit_near );
+
+extern int32_t Stds_AABBTreeSweepEntity( struct aabb_tree_t *tree, const int32_t proxy,
+                                         struct entity_t *e, const int32_t max_iterations,
+                                         struct sweep_contact_t *contacts,
+                                         const int32_t max_contacts );
+
+extern void Stds_AABBTreeSweepPass( struct aabb_tree_t *tree, struct entity_t **entities,
+                                    const int32_t *proxies, const int32_t n,
+                                    const int32_t max_iterations,
+                                    void ( *on_contact )( struct entity_t *,
+                                                          const struct sweep_contact_t *, void * ),
+                                    void *data );
+
+extern void Stds_AABBTreeDie( struct aabb_tree_t *tree );
+
+#endif // AABB_TREE_H
@@ -1,11 +1,59 @@
 #ifndef ANIMATION_H
 #define ANIMATION_H
 
+#include "../lib/structures/include/stds_pool.h"
+#include "atlas.h"
 #include "draw.h"
+#include "job.h"
 #include "stds.h"
 
 extern struct app_t g_app;
 
+extern struct animation_clip_t *Stds_CreateSpritesheetClip( const char *file_directory,
+                                                          const uint8_t n, const float frame_time,
+                                                          const uint16_t start_x,
+                                                          const uint16_t start_y, const size_t rows,
+                                                          const size_t cols );
+
+extern struct animation_clip_t *Stds_CreateAnimationClip( const char *files_directory,
+                                                        const uint8_t n, const float frame_time );
+
+extern struct animation_clip_t *Stds_CreateAtlasClip( struct atlas_t *atlas,
+                                                    const char *files_directory, const uint8_t n,
+                                                    const float frame_time );
+
+extern void Stds_ClipDie( struct animation_clip_t *clip );
+
+extern void Stds_PlayClip( struct animation_state_t *state, const struct animation_clip_t *clip,
+                           const uint32_t flags );
+
+extern void Stds_AnimationStateUpdate( struct animation_state_t *state, const float dt );
+
+extern void Stds_AnimationStateDraw( const struct animation_state_t *state, const float x,
+                                     const float y, const float w, const float h,
+                                     const uint16_t angle, const SDL_RendererFlip flip,
+                                     const SDL_FPoint *rotate_point, const bool camera_offset );
+
+extern struct animation_t *Stds_AddAnimationFromClip( struct animation_clip_t *clip );
+
+extern int32_t Stds_AddAnimationInstance( const struct animation_clip_t *clip,
+                                          const uint32_t flags );
+
+extern void Stds_RemoveAnimationInstance( const int32_t handle );
+
+extern struct animation_state_t *Stds_GetAnimationInstance( const int32_t handle );
+
+extern void Stds_SetAnimationInstanceDest( const int32_t handle, const SDL_FRect *dst,
+                                           const SDL_RendererFlip flip );
+
+extern void Stds_SetAnimationSystemParallel( const bool is_parallel );
+
+extern void Stds_AnimationSystemUpdate( const float dt );
+
+extern void Stds_AnimationSystemDraw( const int32_t layer, const bool camera_offset );
+
+extern void Stds_AnimationSystemDie( void );
+
 extern struct animation_t *Stds_AddSpritesheet( const char *file_directory, const uint8_t n,
                                                 const float frame_time, const uint16_t start_x,
                                                 const uint16_t start_y, const size_t rows,
@@ -14,10 +62,16 @@ extern struct animation_t *Stds_AddSpritesheet( const char *file_directory, cons
 extern struct animation_t *Stds_AddAnimation( const char *files_directory, const uint8_t n,
                                               const float frame_time );
 
+extern struct animation_t *Stds_AddAnimationAtlas( struct atlas_t *atlas,
+                                                   const char *files_directory, const uint8_t n,
+                                                   const float frame_time );
+
 extern void Stds_AnimationUpdate( struct animation_t *animation );
 
 extern void Stds_AnimationDraw( const struct animation_t *animation );
 
+extern void Stds_RestartAnimation( struct animation_t *animation );
+
 extern void Stds_AnimationDie( struct animation_t *animation );
 
 #endif // ANIMATION_H
@@ -0,0 +1,22 @@
+#ifndef ATLAS_H
+#define ATLAS_H
+
+#include "draw.h"
+#include "stds.h"
+
+extern struct app_t g_app;
+
+extern struct atlas_t *Stds_AtlasCreate( const int32_t page_width, const int32_t page_height );
+
+extern int32_t Stds_AtlasAddImage( struct atlas_t *atlas, const char *file_name );
+
+extern int32_t Stds_AtlasAddSurface( struct atlas_t *atlas, SDL_Surface *surface );
+
+extern void Stds_AtlasUpload( struct atlas_t *atlas );
+
+extern const struct atlas_region_t *Stds_AtlasGetRegion( const struct atlas_t *atlas,
+                                                         const int32_t region );
+
+extern void Stds_AtlasDie( struct atlas_t *atlas );
+
+#endif // ATLAS_H
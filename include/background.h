@@ -1,6 +1,7 @@
 #ifndef BACKGROUND_H
 #define BACKGROUND_H
 
+#include "../include/command_buffer.h"
 #include "../include/draw.h"
 #include "stds.h"
 
@@ -15,6 +16,8 @@ extern void Stds_ParallaxBackgroundUpdate( struct parallax_background_t *paralla
 
 extern void Stds_ParallaxBackgroundDraw( const struct parallax_background_t *parallax );
 
+extern void Stds_CompositeParallaxBackgrounds( void );
+
 extern struct background_t *Stds_AddBackground( const char *bg_directory );
 
 extern void Stds_BackgroundUpdate( struct background_t *bg );
@@ -1,13 +1,16 @@
 #ifndef BUTTON_H
 #define BUTTON_H
 
+#include "../lib/structures/include/stds_pool.h"
 #include "draw.h"
 #include "stds.h"
 #include "text.h"
 
 extern void Stds_UpdateButtons( void );
 
-extern void Stds_UpdateButtons( void );
+extern void Stds_DrawButtons( void );
+
+extern void Stds_InvalidateButtonGrid( void );
 
 extern struct button_t *Stds_AddButton( const float x, const float y, const uint32_t w,
                                         const uint32_t h, const bool is_filled,
@@ -27,4 +30,6 @@ extern bool Stds_IsMouseOverButton( struct button_t *button );
 
 extern bool Stds_IsButtonClicked( struct button_t *button, const int32_t mouse_code );
 
+extern void Stds_ButtonDie( struct button_t *button );
+
 #endif // BUTTON_H
\ No newline at end of file
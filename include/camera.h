@@ -1,10 +1,52 @@
 #ifndef CAMERA_H
 #define CAMERA_H
 
+#include "command_buffer.h"
 #include "stds.h"
+#include "vec2.h"
 
 extern struct app_t g_app;
 
 extern void Stds_CameraUpdate( const struct entity_t *parent );
 
+extern bool Stds_IsRectVisible( const SDL_FRect *rect, const bool camera_offset );
+
+extern bool Stds_IsEntityVisible( const struct entity_t *e );
+
+extern bool Stds_GetVisibleCellRange( const float x, const float y, const float cell_w,
+                                      const float cell_h, const uint32_t cols,
+                                      const uint32_t rows, const bool camera_offset,
+                                      uint32_t *first_col, uint32_t *first_row,
+                                      uint32_t *last_col, uint32_t *last_row );
+
+extern struct camera_t *Stds_CreateCamera( const SDL_Rect *viewport );
+
+extern void Stds_SetCameraViewport( struct camera_t *camera, const SDL_Rect *viewport );
+
+extern void Stds_SetCameraSpring( struct camera_t *camera, const float stiffness,
+                                  const float damping );
+
+extern void Stds_SetCameraSmoothTime( struct camera_t *camera, const float seconds );
+
+extern void Stds_SetCameraDeadZone( struct camera_t *camera, const float w, const float h );
+
+extern void Stds_SetCameraLookAhead( struct camera_t *camera, const float updates );
+
+extern void Stds_ShakeCamera( struct camera_t *camera, const float magnitude,
+                              const float seconds );
+
+extern void Stds_CameraCenterOn( struct camera_t *camera, const float x, const float y );
+
+extern void Stds_CameraFollowPoint( struct camera_t *camera, const struct vec2_t *point,
+                                    const struct vec2_t *velocity, const float dt );
+
+extern void Stds_CameraFollow( struct camera_t *camera, const struct entity_t *focus,
+                               const float dt );
+
+extern void Stds_CameraBegin( struct camera_t *camera );
+
+extern void Stds_CameraEnd( struct camera_t *camera );
+
+extern void Stds_CameraDie( struct camera_t *camera );
+
 #endif // CAMERA_H
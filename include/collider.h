@@ -0,0 +1,43 @@
+#ifndef COLLIDER_H
+#define COLLIDER_H
+
+#include "collision.h"
+#include "simd.h"
+#include "stds.h"
+
+extern struct collider_pool_t *Stds_CreateColliderPool( void );
+
+extern void Stds_ColliderClear( struct collider_pool_t *pool );
+
+extern int32_t Stds_ColliderAddRect( struct collider_pool_t *pool, const SDL_FRect *rect );
+
+extern int32_t Stds_ColliderAddCircle( struct collider_pool_t *pool, const struct circle_t *circle );
+
+extern int32_t Stds_ColliderAddPolygon( struct collider_pool_t *pool,
+                                        const struct polygon_t *polygon );
+
+extern void Stds_ColliderSetRect( struct collider_pool_t *pool, const int32_t index,
+                                  const SDL_FRect *rect );
+
+extern void Stds_ColliderSetCircle( struct collider_pool_t *pool, const int32_t index,
+                                    const struct circle_t *circle );
+
+extern int32_t Stds_ColliderRectVsRects( const struct collider_pool_t *pool, const SDL_FRect *rect,
+                                         uint32_t *hit_mask );
+
+extern int32_t Stds_ColliderCircleVsCircles( const struct collider_pool_t *pool,
+                                             const struct circle_t *circle, uint32_t *hit_mask );
+
+extern int32_t Stds_ColliderRectVsCircles( const struct collider_pool_t *pool,
+                                           const SDL_FRect *rect, uint32_t *hit_mask );
+
+extern int32_t Stds_ColliderPolygonVsPolygons( const struct collider_pool_t *pool,
+                                               const struct polygon_t *polygon,
+                                               uint32_t *hit_mask );
+
+extern int32_t Stds_ColliderMaskToIndices( const uint32_t *hit_mask, const int32_t count,
+                                           int32_t *out, const int32_t max_out );
+
+extern void Stds_ColliderPoolDie( struct collider_pool_t *pool );
+
+#endif // COLLIDER_H
@@ -7,6 +7,8 @@
 
 extern enum CollisionSide Stds_CheckAABBCollision( struct entity_t *a, struct entity_t *b );
 
+extern enum CollisionSide Stds_CheckAABBCollisionRect( struct entity_t *a, const SDL_FRect *b );
+
 extern bool Stds_CheckCircularCollision( const struct circle_t *c1, const struct circle_t *c2 );
 
 extern void Stds_ResolveCircularCollision( struct circle_t *c1, struct circle_t *c2 );
@@ -29,4 +31,32 @@ extern bool Stds_AdvRectVsRect( const SDL_FRect *r1, const SDL_FRect *r2,
 
 extern bool Stds_CheckSATOverlap( struct polygon_t *p1, struct polygon_t *p2 );
 
+extern struct spatial_hash_t *Stds_CreateSpatialHash( const float cell_size,
+                                                      const int32_t bucket_count );
+
+extern void Stds_SpatialClear( struct spatial_hash_t *hash );
+
+extern void Stds_SpatialInsert( struct spatial_hash_t *hash, struct entity_t *e );
+
+extern void Stds_SpatialBuild( struct spatial_hash_t *hash, struct entity_t *head );
+
+extern int32_t Stds_SpatialQueryRect( struct spatial_hash_t *hash, const SDL_FRect *rect,
+                                      struct entity_t **out, const int32_t max_out );
+
+extern void Stds_SpatialForEachPair( struct spatial_hash_t *hash,
+                                     void ( *callback )( struct entity_t *, struct entity_t *,
+                                                         void * ),
+                                     void *data );
+
+extern void Stds_SpatialHashDie( struct spatial_hash_t *hash );
+
+extern struct sweep_and_prune_t *Stds_CreateSweepAndPrune( void );
+
+extern void Stds_SweepAndPrune( struct sweep_and_prune_t *sap, struct entity_t **entities,
+                                const int32_t n,
+                                void ( *callback )( struct entity_t *, struct entity_t *, void * ),
+                                void *data );
+
+extern void Stds_SweepAndPruneDie( struct sweep_and_prune_t *sap );
+
 #endif // COLLISION_H
\ No newline at end of file
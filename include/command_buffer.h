@@ -0,0 +1,27 @@
+#ifndef COMMAND_BUFFER_H
+#define COMMAND_BUFFER_H
+
+#include "draw.h"
+#include "stds.h"
+
+extern void Stds_SetCommandBuffering( const uint32_t flags );
+
+extern uint32_t Stds_GetCommandFlags( void );
+
+extern void Stds_BeginCommands( void );
+
+extern void Stds_EndCommands( void );
+
+extern void Stds_SwapCommands( void );
+
+extern void Stds_SubmitCommands( void );
+
+extern bool Stds_IsRecordingCommands( void );
+
+extern struct render_command_t *Stds_PushCommand( const uint8_t type );
+
+extern void *Stds_PushCommandPayload( const void *data, const size_t size, uint32_t *offset );
+
+extern void Stds_CommandBufferDie( void );
+
+#endif // COMMAND_BUFFER_H
@@ -13,6 +13,10 @@ extern void Stds_DrawTexture( SDL_Texture *texture, const float x, const float y
                               const float h, const uint16_t angle, const SDL_RendererFlip flip,
                               const SDL_FPoint *rotate_point, const bool camera_offset );
 
+extern void Stds_DrawTextureTransformed( SDL_Texture *texture, const float w, const float h,
+                                        const struct transform_t *m, SDL_RendererFlip flip,
+                                        const bool camera_offset );
+
 extern void Stds_BlitTexture( SDL_Texture *texture, const SDL_Rect *src, const float x,
                               const float y, const float w, const float h, const uint16_t angle,
                               const SDL_RendererFlip flip, const SDL_FPoint *rotate_point,
@@ -28,14 +32,76 @@ extern void Stds_DrawRectStroke( float x, float y, uint32_t w, uint32_t h,
                                  const uint32_t stroke_width, const SDL_Color *c,
                                  const bool camera_offset );
 
+extern void Stds_DrawQuads( SDL_Texture *texture, const SDL_FRect *dst, const SDL_Rect *src,
+                            const SDL_Color *colors, const int32_t count, const bool camera_offset );
+
 extern void Stds_DrawCircle( const struct circle_t *circle, const SDL_Color *c,
                              const bool is_filled );
 
+extern void Stds_DrawCircles( const struct circle_t *circles, const SDL_Color *colors,
+                              const int32_t count, const bool is_filled );
+
+extern void Stds_DrawRects( const SDL_FRect *rects, const int32_t count, const SDL_Color *c,
+                            const bool is_filled, const bool camera_offset );
+
 extern void Stds_DrawLine( const float x1, const float y1, const float x2, const float y2,
                            const SDL_Color *c );
 
+extern void Stds_DrawLines( const SDL_FPoint *points, const int32_t count, const SDL_Color *c );
+
 extern SDL_Texture *Stds_LoadTexture( const char *directory );
 
+extern int32_t Stds_TextureHandle( const char *file_name );
+
+extern SDL_Texture *Stds_TextureFromHandle( const int32_t handle );
+
+extern int32_t Stds_FindTextureHandle( SDL_Texture *texture );
+
+extern int32_t Stds_TextureHandleFromSurface( const char *file_name, SDL_Surface *surface );
+
+extern void Stds_ReleaseTexture( SDL_Texture *texture );
+
+extern void Stds_RetainTextureHandle( const int32_t handle );
+
+extern void Stds_ReleaseTextureHandle( const int32_t handle );
+
+extern void Stds_SetTextureMemoryBudget( const size_t bytes );
+
+extern size_t Stds_GetTextureMemoryUsage( void );
+
+extern void Stds_BatchBegin( void );
+
+extern void Stds_BatchSetLayer( const int32_t layer );
+
+extern void Stds_BatchSetDepth( const uint16_t depth );
+
+extern uint64_t Stds_MakeSortKey( int32_t layer, const uint16_t depth, const SDL_BlendMode blend,
+                                  const SDL_Texture *texture );
+
+extern void Stds_GetTextureMods( SDL_Texture *texture, SDL_Color *mod, SDL_BlendMode *blend );
+
+extern void Stds_BatchPush( SDL_Texture *texture, const SDL_Rect *src, const SDL_FRect *dst,
+                            const float angle, const SDL_FPoint *center,
+                            const SDL_RendererFlip flip, const SDL_Color *color,
+                            const int32_t layer );
+
+extern void Stds_BatchEnd( void );
+
+extern void Stds_SetDrawColor( const SDL_Color *c );
+
+extern void Stds_SetDrawBlendMode( const SDL_BlendMode mode );
+
+extern void Stds_SetTextureBlendMode( SDL_Texture *texture, const SDL_BlendMode mode );
+
+extern void Stds_SetTextureColorMod( SDL_Texture *texture, const uint8_t r, const uint8_t g,
+                                     const uint8_t b );
+
+extern void Stds_SetTextureAlphaMod( SDL_Texture *texture, const uint8_t a );
+
+extern void Stds_ForgetTextureState( SDL_Texture *texture );
+
+extern void Stds_InvalidateRenderState( void );
+
 extern SDL_Color Stds_CombineFadeColor( struct fade_color_t *fade_color );
 
 #endif // DRAW_H
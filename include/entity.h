@@ -0,0 +1,53 @@
+#ifndef ENTITY_H
+#define ENTITY_H
+
+#include "animation.h"
+#include "polygon.h"
+#include "stds.h"
+
+extern struct entity_registry_t *Stds_CreateEntityRegistry( const uint32_t capacity,
+                                                            const size_t cold_size );
+
+extern uint32_t Stds_RegisterEntityType(
+  struct entity_registry_t *reg,
+  void ( *update_batch )( struct entity_registry_t *, uint32_t, uint32_t ),
+  void ( *draw_batch )( struct entity_registry_t *, uint32_t, uint32_t ) );
+
+extern uint32_t Stds_CreateEntity( struct entity_registry_t *reg );
+
+extern uint32_t Stds_CreateEntityOfType( struct entity_registry_t *reg, const uint32_t type );
+
+extern int32_t Stds_GetEntityType( const struct entity_registry_t *reg, const uint32_t id );
+
+extern void Stds_UpdateEntityTypes( struct entity_registry_t *reg );
+
+extern void Stds_DrawEntityTypes( struct entity_registry_t *reg );
+
+extern void Stds_DestroyEntity( struct entity_registry_t *reg, const uint32_t id );
+
+extern bool Stds_IsEntityAlive( const struct entity_registry_t *reg, const uint32_t id );
+
+extern int32_t Stds_GetEntityIndex( const struct entity_registry_t *reg, const uint32_t id );
+
+extern void *Stds_GetEntityColdData( struct entity_registry_t *reg, const uint32_t id );
+
+extern SDL_FRect Stds_GetEntityWorldBounds( const struct entity_registry_t *reg,
+                                            const uint32_t index );
+
+extern void Stds_IntegrateEntities( struct entity_registry_t *reg, const float dt );
+
+extern void Stds_ClearEntityRegistry( struct entity_registry_t *reg );
+
+extern void Stds_EntityRegistryDie( struct entity_registry_t *reg );
+
+extern struct entity_pool_t *Stds_CreateEntityPool( const uint32_t capacity );
+
+extern struct entity_t *Stds_EntityPoolAcquire( struct entity_pool_t *pool );
+
+extern void Stds_EntityPoolRelease( struct entity_pool_t *pool, struct entity_t *e );
+
+extern uint32_t Stds_EntityPoolActiveCount( const struct entity_pool_t *pool );
+
+extern void Stds_EntityPoolDie( struct entity_pool_t *pool );
+
+#endif // ENTITY_H
@@ -1,7 +1,14 @@
 #ifndef GAME_H
 #define GAME_H
 
+#include "../lib/structures/include/stds_arena.h"
+#include "job.h"
+#include "loader.h"
+#include "profiler.h"
+#include "replay.h"
+#include "sound.h"
 #include "stds.h"
+#include "telemetry.h"
 
 extern struct app_t g_app;
 
@@ -15,6 +22,18 @@ extern void Stds_GameLoop( void );
 
 extern void Stds_InitAppStructures( void );
 
+extern void Stds_SetFixedTimestep( const uint32_t updates_per_second, const uint32_t max_updates );
+
+extern void Stds_SetVSync( const bool is_enabled );
+
+extern void Stds_SetRedrawOnDemand( const bool is_enabled );
+
+extern void Stds_RequestRedraw( void );
+
+extern float Stds_GetInterpolationAlpha( void );
+
+extern void *Stds_FrameAlloc( const size_t size );
+
 extern void init_window_fps( void  ); 
 
 #endif // GAME_H
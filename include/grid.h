@@ -29,6 +29,10 @@ extern int32_t Stds_AddAnimationToGrid( struct grid_t *grid, struct animation_t
 
 extern int32_t Stds_AddGridTexture( struct grid_t *grid, const char *filePath );
 
+extern bool Stds_GetGridVisibleRange( const struct grid_t *grid, uint32_t *first_col,
+                                      uint32_t *first_row, uint32_t *last_col,
+                                      uint32_t *last_row );
+
 extern void Stds_DrawLineGrid( struct grid_t *grid );
 
 extern void Stds_FillWholeGrid( struct grid_t *grid );
@@ -57,4 +61,22 @@ extern void Stds_RenderAnimationToGrid( const struct grid_t *grid, const uint32_
 
 extern void Stds_RenderPreMadeSpriteSheet( struct grid_t *grid );
 
+extern void Stds_EnableGridTilemap( struct grid_t *grid, const uint32_t chunk_size );
+
+extern void Stds_ClearGridTile( struct grid_t *grid, const uint32_t col, const uint32_t row );
+
+extern void Stds_InvalidateGridTilemap( struct grid_t *grid );
+
+extern void Stds_DrawGridTilemap( struct grid_t *grid );
+
+extern void Stds_SetGridTileIndex( struct grid_t *grid, const uint32_t col, const uint32_t row,
+                                   const uint16_t index );
+
+extern uint16_t Stds_GetGridTileIndex( const struct grid_t *grid, const uint32_t col,
+                                       const uint32_t row );
+
+extern void Stds_SetGridTileIndices( struct grid_t *grid, const uint16_t *indices );
+
+extern void Stds_DrawGridTiles( const struct grid_t *grid );
+
 #endif // GRID_H
\ No newline at end of file
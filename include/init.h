@@ -2,15 +2,33 @@
 #define INIT_H
 
 #include "background.h"
+#include "button.h"
+#include "input_thread.h"
+#include "job.h"
+#include "loader.h"
+#include "pack.h"
+#include "scene.h"
 #include "sound.h"
 #include "stds.h"
+#include "telemetry.h"
 #include "text.h"
+#include "text_field.h"
+#include "trail.h"
 
 extern struct app_t g_app;
 
 extern void Stds_InitGame( const char *title, const uint32_t w, const uint32_t h, const uint32_t lw,
                            const uint32_t lh );
 
+extern void Stds_InitGameHeadless( const uint32_t w, const uint32_t h, const uint32_t lw,
+                                   const uint32_t lh );
+
+extern struct init_config_t Stds_CreateInitConfig( const uint32_t subsystems );
+
+extern void Stds_InitGameWithConfig( const char *title, const uint32_t w, const uint32_t h,
+                                     const uint32_t lw, const uint32_t lh,
+                                     const struct init_config_t *config );
+
 extern void Stds_Quit( void );
 
 extern void Stds_ToggleDebugMode( bool is_debugging );
@@ -2,6 +2,7 @@
 #define INPUT_H
 
 #include "init.h"
+#include "replay.h"
 #include "stds.h"
 #include "text_field.h"
 
@@ -9,4 +10,18 @@ extern struct app_t g_app;
 
 extern void Stds_ProcessInput( void );
 
+extern bool Stds_IsKeyDown( const SDL_Scancode key );
+
+extern bool Stds_IsKeyPressed( const SDL_Scancode key );
+
+extern bool Stds_IsKeyReleased( const SDL_Scancode key );
+
+extern bool Stds_IsMouseButtonDown( const uint8_t button );
+
+extern bool Stds_IsMouseButtonPressed( const uint8_t button );
+
+extern bool Stds_IsMouseButtonReleased( const uint8_t button );
+
+extern void Stds_GetMouseDelta( int32_t *dx, int32_t *dy );
+
 #endif // INPUT_H
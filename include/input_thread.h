@@ -0,0 +1,18 @@
+#ifndef INPUT_THREAD_H
+#define INPUT_THREAD_H
+
+#include "stds.h"
+
+extern struct app_t g_app;
+
+extern bool Stds_StartInputThread( void );
+
+extern void Stds_StopInputThread( void );
+
+extern bool Stds_IsInputThreadRunning( void );
+
+extern int32_t Stds_PollQueuedEvent( SDL_Event *event );
+
+extern uint64_t Stds_GetInputEventTime( void );
+
+#endif // INPUT_THREAD_H
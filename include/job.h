@@ -0,0 +1,25 @@
+#ifndef JOB_H
+#define JOB_H
+
+#include "stds.h"
+
+extern void Stds_InitJobs( int32_t thread_count );
+
+extern void Stds_JobSubmit( void ( *fn )( void *, int32_t ), void *data,
+                            struct job_counter_t *counter );
+
+extern void Stds_JobSubmitAfter( struct job_counter_t *dependency, void ( *fn )( void *, int32_t ),
+                                 void *data, struct job_counter_t *counter );
+
+extern void Stds_JobParallelFor( void ( *fn )( void *, int32_t ), void *data, const int32_t count,
+                                 int32_t grain, struct job_counter_t *counter );
+
+extern bool Stds_IsJobDone( struct job_counter_t *counter );
+
+extern void Stds_JobWait( struct job_counter_t *counter );
+
+extern int32_t Stds_GetJobThreadCount( void );
+
+extern void Stds_JobsDie( void );
+
+#endif // JOB_H
@@ -0,0 +1,30 @@
+#ifndef LOADER_H
+#define LOADER_H
+
+#include "stds.h"
+
+extern struct app_t g_app;
+
+extern void Stds_InitAssetLoader( int32_t thread_count );
+
+extern int32_t Stds_LoadTextureAsync( const char *file_name );
+
+extern int32_t Stds_LoadSFXAsync( const char *path, const int16_t id );
+
+extern int32_t Stds_LoadMusicAsync( const char *file_name );
+
+extern int32_t Stds_AddFontAsync( const char *font_file, const uint16_t size );
+
+extern int32_t Stds_GetAssetState( const int32_t handle );
+
+extern int32_t Stds_WaitForAsset( const int32_t handle );
+
+extern SDL_Texture *Stds_GetAssetTexture( const int32_t handle );
+
+extern int32_t Stds_GetAssetTextureHandle( const int32_t handle );
+
+extern void Stds_UpdateAssetLoader( const float budget_ms );
+
+extern void Stds_AssetLoaderDie( void );
+
+#endif // LOADER_H
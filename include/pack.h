@@ -0,0 +1,20 @@
+#ifndef PACK_H
+#define PACK_H
+
+#include "stds.h"
+
+extern struct app_t g_app;
+
+extern bool Stds_MountPack( const char *file_path );
+
+extern void Stds_UnmountPacks( void );
+
+extern const struct pack_entry_t *Stds_FindPackEntry( const char *name );
+
+extern SDL_RWops *Stds_OpenPackRW( const char *name );
+
+extern SDL_Surface *Stds_LoadPackSurface( const char *name );
+
+extern SDL_Texture *Stds_LoadPackTexture( const char *name );
+
+#endif // PACK_H
@@ -0,0 +1,12 @@
+#ifndef PARTICLE_SIMD_H
+#define PARTICLE_SIMD_H
+
+#include "stds.h"
+#include "simd.h"
+
+extern void Stds_ParticleIntegrateSoA( struct particle_soa_t *soa, const int32_t start,
+                                       const int32_t count, uint32_t *death_mask );
+
+extern const char *Stds_ParticleSimdName( void );
+
+#endif // PARTICLE_SIMD_H
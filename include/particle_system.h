@@ -2,15 +2,26 @@
 #define PARTICLE_SYSTEM_H
 
 #include "stds.h"
+#include "draw.h"
+#include "worker_pool.h"
 
 enum { PS_SUCCESS, PS_FULL, PS_INVALID_FP };
 
 extern struct particle_system_t *Stds_CreateParticleSystem( const int32_t max_particles );
 
+extern struct particle_system_t *Stds_CreateParticleSystemSoA( const int32_t max_particles );
+
+extern struct particle_system_t *Stds_CreateParticleSystemStateless( const int32_t max_particles );
+
 extern int32_t Stds_InsertParticle( struct particle_system_t *ps, const struct particle_t *p );
 
 extern void Stds_ParticleSystemUpdate( struct particle_system_t *ps );
 
+extern void Stds_ParticleSystemUpdateParallel( struct particle_system_t *ps,
+                                               struct worker_pool_t *    pool );
+
 extern void Stds_ParticleSystemDraw( const struct particle_system_t *ps );
 
+extern void Stds_ParticleSystemDie( struct particle_system_t *ps );
+
 #endif // PARTICLE_SYSTEM_H
\ No newline at end of file
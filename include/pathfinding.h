@@ -0,0 +1,41 @@
+#ifndef PATHFINDING_H
+#define PATHFINDING_H
+
+#include "../lib/structures/include/stds_heap.h"
+#include "grid.h"
+#include "stds.h"
+
+extern void Stds_SetGridCellWalkable( struct grid_t *grid, const uint32_t col, const uint32_t row,
+                                      const bool is_walkable );
+
+extern bool Stds_IsGridCellWalkable( const struct grid_t *grid, const int32_t col,
+                                     const int32_t row );
+
+extern void Stds_SetGridCellCost( struct grid_t *grid, const uint32_t col, const uint32_t row,
+                                  const uint8_t cost );
+
+extern bool Stds_GridFindPath( struct grid_t *grid, const struct grid_pair_t *start,
+                               const struct grid_pair_t *goal, struct grid_path_t *out_path );
+
+extern void Stds_FreeGridPath( struct grid_path_t *path );
+
+extern void Stds_FreeGridPathData( struct grid_t *grid );
+
+extern struct grid_flow_field_t *Stds_CreateFlowField( struct grid_t *grid );
+
+extern bool Stds_GridBuildFlowField( struct grid_flow_field_t *field,
+                                     const struct grid_pair_t *goal, const bool is_async );
+
+extern bool Stds_UpdateFlowField( struct grid_flow_field_t *field );
+
+extern void Stds_InvalidateFlowField( struct grid_flow_field_t *field );
+
+extern bool Stds_SampleFlowField( const struct grid_flow_field_t *field, const float x,
+                                  const float y, struct vec2_t *out_direction );
+
+extern float Stds_GetFlowFieldDistance( const struct grid_flow_field_t *field, const uint32_t col,
+                                        const uint32_t row );
+
+extern void Stds_FlowFieldDie( struct grid_flow_field_t *field );
+
+#endif // PATHFINDING_H
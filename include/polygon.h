@@ -1,6 +1,7 @@
 #ifndef POLYGON_H
 #define POLYGON_H
 
+#include "../lib/structures/include/stds_pool.h"
 #include "draw.h"
 #include "stds.h"
 #include "vec2.h"
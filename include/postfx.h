@@ -0,0 +1,41 @@
+#ifndef POSTFX_H
+#define POSTFX_H
+
+#include "command_buffer.h"
+#include "draw.h"
+#include "game.h"
+#include "stds.h"
+
+extern struct app_t g_app;
+
+extern SDL_Texture *Stds_CreateLightTexture( const int32_t radius );
+
+extern struct lightmap_t *Stds_CreateLightmap( const int32_t scale, const SDL_Color *ambient );
+
+extern void Stds_SetLightmapAmbient( struct lightmap_t *lightmap, const SDL_Color *ambient );
+
+extern bool Stds_LightmapBegin( struct lightmap_t *lightmap );
+
+extern void Stds_DrawLights( struct lightmap_t *lightmap, SDL_Texture *texture,
+                             const struct light_t *lights, const int32_t count,
+                             const bool camera_offset );
+
+extern void Stds_LightmapEnd( struct lightmap_t *lightmap );
+
+extern bool Stds_IsLightmapDrawn( struct lightmap_t *lightmap );
+
+extern void Stds_LightmapApply( struct lightmap_t *lightmap );
+
+extern void Stds_LightmapDie( struct lightmap_t *lightmap );
+
+extern struct bloom_t *Stds_CreateBloom( const int32_t downsample, const uint8_t intensity );
+
+extern bool Stds_BloomBegin( struct bloom_t *bloom );
+
+extern void Stds_BloomEnd( struct bloom_t *bloom );
+
+extern void Stds_BloomApply( struct bloom_t *bloom );
+
+extern void Stds_BloomDie( struct bloom_t *bloom );
+
+#endif // POSTFX_H
@@ -0,0 +1,59 @@
+#ifndef PROFILER_H
+#define PROFILER_H
+
+#include "draw.h"
+#include "stds.h"
+#include "text.h"
+
+extern struct app_t g_app;
+
+/*
+ * Scoped timing markers. BEGIN and END take the same bare identifier, which
+ * names the scope, and must appear in the same block, e.g.
+ *
+ *   STDS_PROFILE_BEGIN( physics );
+ *   update_physics();
+ *   STDS_PROFILE_END( physics );
+ *
+ * Defining STDS_NO_PROFILER compiles every marker out.
+ */
+#ifndef STDS_NO_PROFILER
+#define STDS_PROFILE_BEGIN( id )                                                                   \
+  static int32_t stds_profile_##id = -1;                                                           \
+  if ( stds_profile_##id < 0 ) {                                                                   \
+    stds_profile_##id = Stds_ProfilerRegisterScope( #id );                                         \
+  }                                                                                                \
+  Stds_ProfilerBegin( stds_profile_##id )
+#define STDS_PROFILE_END( id ) Stds_ProfilerEnd( stds_profile_##id )
+#define STDS_PROFILE_FRAME_BEGIN() Stds_ProfilerBeginFrame()
+#define STDS_PROFILE_FRAME_END() Stds_ProfilerEndFrame()
+#else
+#define STDS_PROFILE_BEGIN( id ) ( void ) 0
+#define STDS_PROFILE_END( id ) ( void ) 0
+#define STDS_PROFILE_FRAME_BEGIN() ( void ) 0
+#define STDS_PROFILE_FRAME_END() ( void ) 0
+#endif // STDS_NO_PROFILER
+
+extern int32_t Stds_ProfilerRegisterScope( const char *name );
+
+extern void Stds_ProfilerBegin( const int32_t scope );
+
+extern void Stds_ProfilerEnd( const int32_t scope );
+
+extern void Stds_ProfilerAddJobScope( const int32_t scope, const uint64_t start,
+                                      const uint64_t end );
+
+extern void Stds_ProfilerBeginFrame( void );
+
+extern void Stds_ProfilerEndFrame( void );
+
+extern void Stds_ProfilerGetStats( const int32_t scope, float *min_ms, float *avg_ms,
+                                   float *p99_ms );
+
+extern void Stds_ProfilerSetFont( const char *font_path, const uint16_t font_size );
+
+extern void Stds_ProfilerDrawOverlay( const float x, const float y );
+
+extern bool Stds_ProfilerExportChromeTrace( const char *file_path );
+
+#endif // PROFILER_H
@@ -0,0 +1,24 @@
+#ifndef REPLAY_H
+#define REPLAY_H
+
+#include "stds.h"
+
+extern struct app_t g_app;
+
+extern bool Stds_StartInputRecording( const char *file_path );
+
+extern void Stds_StopInputRecording( void );
+
+extern bool Stds_StartInputReplay( const char *file_path, const bool is_quit_at_end );
+
+extern void Stds_StopInputReplay( void );
+
+extern bool Stds_IsReplayingInput( void );
+
+extern double Stds_ReplayFrameTime( const double frame_time );
+
+extern int32_t Stds_PollInputEvent( SDL_Event *event );
+
+extern void Stds_EndInputFrame( void );
+
+#endif // REPLAY_H
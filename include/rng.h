@@ -0,0 +1,22 @@
+#ifndef RNG_H
+#define RNG_H
+
+#include "simd.h"
+#include "stds.h"
+
+extern void Stds_RngSeed( struct rng_t *rng, const uint64_t seed );
+
+extern uint32_t Stds_RngNext( struct rng_t *rng );
+
+extern int32_t Stds_RngInt( struct rng_t *rng, const int32_t min, const int32_t max );
+
+extern float Stds_RngFloat( struct rng_t *rng, const float min, const float max );
+
+extern void Stds_RngFillFloats( struct rng_t *rng, float *out, const int32_t count,
+                                const float min, const float max );
+
+extern void Stds_SeedRandom( const uint64_t seed );
+
+extern struct rng_t *Stds_GetThreadRng( void );
+
+#endif // RNG_H
@@ -0,0 +1,34 @@
+#ifndef SCENE_H
+#define SCENE_H
+
+#include "draw.h"
+#include "loader.h"
+#include "stds.h"
+
+extern struct app_t g_app;
+
+extern struct scene_t *Stds_CreateScene( void ( *update )( void ), void ( *draw )( void ) );
+
+extern SDL_Texture *Stds_SceneLoadTexture( struct scene_t *scene, const char *file_name );
+
+extern int32_t Stds_ScenePreloadTexture( struct scene_t *scene, const char *file_name );
+
+extern void Stds_SceneAwaitAsset( struct scene_t *scene, const int32_t request );
+
+extern void Stds_PreloadScene( struct scene_t *scene );
+
+extern bool Stds_IsSceneLoaded( struct scene_t *scene );
+
+extern bool Stds_PushScene( struct scene_t *scene );
+
+extern void Stds_PopScene( void );
+
+extern bool Stds_SwitchScene( struct scene_t *scene );
+
+extern struct scene_t *Stds_GetScene( void );
+
+extern void Stds_ClearScenes( void );
+
+extern void Stds_SceneDie( struct scene_t *scene );
+
+#endif // SCENE_H
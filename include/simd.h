@@ -0,0 +1,85 @@
+#ifndef SIMD_H
+#define SIMD_H
+
+/*
+ * Compile-time selection of the vector instruction set. AVX2 is only picked
+ * when the compiler targets it (e.g. make SIMD_FLAGS=-mavx2); SSE2 is part of
+ * every x86-64 target and NEON of every AArch64 target. Define STDS_NO_SIMD
+ * to force the scalar paths.
+ */
+#if !defined( STDS_NO_SIMD ) && defined( __AVX2__ )
+#define STDS_SIMD_AVX2 1
+#define STDS_SIMD_SSE2 1
+#include <immintrin.h>
+#elif !defined( STDS_NO_SIMD ) &&                                                                  \
+  ( defined( __SSE2__ ) || defined( _M_X64 ) || ( defined( _M_IX86_FP ) && _M_IX86_FP >= 2 ) )
+#define STDS_SIMD_SSE2 1
+#include <emmintrin.h>
+#elif !defined( STDS_NO_SIMD ) && ( defined( __ARM_NEON ) || defined( __ARM_NEON__ ) )
+#define STDS_SIMD_NEON 1
+#include <arm_neon.h>
+#else
+#define STDS_SIMD_SCALAR 1
+#endif
+
+#if defined( STDS_SIMD_AVX2 )
+#define STDS_SIMD_WIDTH 8
+#elif defined( STDS_SIMD_SSE2 ) || defined( STDS_SIMD_NEON )
+#define STDS_SIMD_WIDTH 4
+#else
+#define STDS_SIMD_WIDTH 1
+#endif
+
+#include <stdint.h>
+
+#if defined( _MSC_VER )
+#include <intrin.h>
+#endif
+
+/*
+ * Bit scans over 32-bit masks. The compiler builtins map to one instruction;
+ * MSVC uses its intrinsics and other compilers a short shift loop. bits must
+ * not be 0.
+ */
+static inline int32_t
+Stds_HighestBit( uint32_t bits ) {
+#if defined( __GNUC__ ) || defined( __clang__ )
+  return 31 - __builtin_clz( bits );
+#elif defined( _MSC_VER )
+  unsigned long index;
+  _BitScanReverse( &index, bits );
+  return ( int32_t ) index;
+#else
+  int32_t index = 0;
+  while ( bits >>= 1 ) {
+    index++;
+  }
+  return index;
+#endif
+}
+
+static inline int32_t
+Stds_LowestBit( uint32_t bits ) {
+#if defined( __GNUC__ ) || defined( __clang__ )
+  return __builtin_ctz( bits );
+#elif defined( _MSC_VER )
+  unsigned long index;
+  _BitScanForward( &index, bits );
+  return ( int32_t ) index;
+#else
+  return Stds_HighestBit( bits & ( ~bits + 1 ) );
+#endif
+}
+
+static inline int32_t
+Stds_PopCount( uint32_t bits ) {
+#if defined( __GNUC__ ) || defined( __clang__ )
+  return __builtin_popcount( bits );
+#else
+  bits = bits - ( ( bits >> 1 ) & 0x55555555u );
+  bits = ( bits & 0x33333333u ) + ( ( bits >> 2 ) & 0x33333333u );
+  return ( int32_t ) ( ( ( bits + ( bits >> 4 ) ) & 0x0f0f0f0fu ) * 0x01010101u >> 24 );
+#endif
+}
+
+#endif // SIMD_H
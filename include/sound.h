@@ -7,12 +7,29 @@ extern struct app_t g_app;
 
 extern void Stds_InitAudio( void );
 
+extern bool Stds_OpenAudio( void );
+
 extern void Stds_LoadMusic( const char *music_path );
 
 extern void Stds_LoadSFX( const char *sfx_path, int16_t sfx_id );
 
+extern void Stds_RegisterSFX( const char *sfx_path, int16_t sfx_id );
+
+extern void Stds_PreloadSFX( const int16_t sound_effect_id, const bool is_pinned );
+
+extern void Stds_SetSFXMemoryBudget( const size_t bytes );
+
+extern size_t Stds_GetSFXMemoryUsage( void );
+
 extern void Stds_PlayMusic( const bool is_playing );
 
 extern void Stds_PlaySFX( const int16_t sound_effect_id, const int16_t channel );
 
+extern void Stds_SetSFXVoices( const int16_t sound_effect_id, const int16_t max_voices,
+                               const int16_t priority );
+
+extern void Stds_UpdateAudio( void );
+
+extern void Stds_AudioDie( void );
+
 #endif // SOUND_H
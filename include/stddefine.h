@@ -5,11 +5,14 @@
 #define FPS                 60
 #define FPS_TIME            ( 1000 / FPS )
 #define MAX_SND_CHANNELS    16
+#define SFX_DEFAULT_VOICES  4 /* Concurrent instances of one sound unless set otherwise. */
+#define SFX_MEMORY_BUDGET   ( 32 * 1024 * 1024 ) /* Decoded bytes of lazy sound effects. */
 #define MAX_LINE_LENGTH     1024
 #define SMALL_TEXT_BUFFER   64
 #define LARGE_TEXT_BUFFER   512
 #define MAX_KEYBOARD_KEYS   350
 #define MAX_MOUSE_BUTTONS   350
+#define STDS_KEY_WORDS      ( ( MAX_KEYBOARD_KEYS + 63 ) / 64 ) /* Words of a key bitset. */
 #define MAX_FILE_NUM_DIGITS 3
 #define MAX_BUFFER_SIZE     128
 #define MAX_FILE_NAME_LEN   48
@@ -17,6 +20,7 @@
 #define WINDOW_UPDATE_TIMER 1000
 #define PI                  3.14159265358979323846
 
+#define STDS_ATLAS_ANIMATION_MASK           4
 #define STDS_SPRITE_SHEET_MASK              2
 #define STDS_ANIMATION_MASK                 1
 #define STDS_DEATH_MASK                     0x10000000
@@ -25,6 +29,128 @@
 #define STDS_TRAIL_CIRCLE_MASK              0x00300000
 #define STDS_TRAIL_SQUARE_MASK              0x00400000
 #define STDS_ANIMATION_ACTIVE_MASK          0x01000000
+#define STDS_ANIMATION_ONCE_MASK            0x02000000 /* Stop on the last frame instead of looping. */
+#define STDS_ANIMATION_OWNS_CLIP_MASK       0x04000000
+#define STDS_ANIMATION_CHUNK                256 /* Playback states advanced per job. */
+#define STDS_CLIP_OWNS_TEXTURES             1
+#define STDS_CLIP_SHEET                     2 /* Every frame shares textures[0]. */
+#define STDS_PARTICLE_SOA_MASK              0x00000100 /* Particle system uses the structure-of-arrays layout. */
+#define STDS_PARTICLE_STATELESS_MASK        0x00000200 /* Particle system evaluates particles from their spawn state. */
+#define STDS_QUAD_BATCH_SIZE                2048 /* Max quads per SDL_RenderGeometry call. */
+#define STDS_CIRCLE_BUCKETS                 5    /* Cached circle meshes, 8 << b segments each. */
+#define STDS_CIRCLE_MAX_SEGMENTS            128  /* Segments of the largest bucket. */
+#define STDS_ATLAS_PAGE_SIZE                2048
+#define STDS_GLYPH_FIRST                    32  /* First cached glyph (space). */
+#define STDS_GLYPH_COUNT                    95  /* Glyphs cached per font: ' ' through '~'. */
+#define STDS_GLYPH_PAGE_SIZE                512
+#define STDS_MAX_FRAME_TIME                 0.25 /* Seconds of real time simulated per frame at most. */
+#define STDS_MAX_UPDATES_PER_FRAME          8
+#define STDS_PROFILER_FRAMES                240  /* Frames of history kept for profiler statistics. */
+#define STDS_PROFILER_MAX_SCOPES            32
+#define STDS_PROFILER_MAX_DEPTH             16
+#define STDS_PROFILER_MAX_EVENTS            8192 /* Scope events kept for trace export. */
+#define STDS_TEXTURE_STATE_SLOTS            256  /* Direct-mapped cache of per-texture blend and mod state. */
+#define STDS_TEXTURE_BUDGET                 ( 256 * 1024 * 1024 ) /* Resident cached textures. */
+#define STDS_SWEEP_MAX_CONTACTS             8   /* Contacts reported per entity by a sweep pass. */
+#define STDS_GRID_CHUNK_SIZE                16  /* Tiles per side of a baked tilemap chunk. */
+#define STDS_GRID_TILE_EMPTY                0
+#define STDS_GRID_TILE_TEXTURE              1
+#define STDS_GRID_TILE_SPRITE               2
+#define STDS_TILEMAP_VERSION                1
+#define STDS_TILEMAP_HEADER_SIZE            40  /* Magic plus nine 32-bit fields. */
+#define STDS_TILEMAP_MAX_CHUNK_SIZE         256 /* Tiles per side of a chunk. */
+#define STDS_TILEMAP_MAX_SIDE               65536 /* Columns or rows of a tilemap. */
+#define STDS_REPLAY_VERSION                 1
+#define STDS_REPLAY_FRAME_SIZE              20  /* Frame time, mouse position, event count. */
+#define STDS_RNG_LANES                      4   /* Interleaved generators of a batch fill. */
+#define STDS_TILEMAP_STREAM_MARGIN          1   /* Chunks kept resident around the view. */
+#define STDS_LOADER_THREADS                 2
+#define STDS_LOADER_BUDGET_MS               2.0f /* Main-thread upload time per frame. */
+#define STDS_ASSET_PENDING                  0
+#define STDS_ASSET_DECODED                  1
+#define STDS_ASSET_READY                    2
+#define STDS_ASSET_FAILED                   3
+#define STDS_ASSET_TEXTURE                  0
+#define STDS_ASSET_SFX                      1
+#define STDS_ASSET_MUSIC                    2
+#define STDS_ASSET_FONT                     3
+#define STDS_PACK_VERSION                   1
+#define STDS_PACK_HEADER_SIZE               16  /* Magic, version, entry count, reserved. */
+#define STDS_PACK_NAME_LEN                  120
+#define STDS_PACK_ENTRY_SIZE                136 /* Name plus offset, size, width, height, type. */
+#define STDS_PACK_ALIGNMENT                 16  /* Blobs start on this boundary. */
+#define STDS_PACK_RAW                       0   /* Blob is the file as-is. */
+#define STDS_PACK_RGBA                      1   /* Blob is pre-decoded RGBA32 pixels. */
+#define STDS_MAX_PACKS                      4
+#define STDS_TRAIL_POOL_BLOCK               256 /* Trail segments per pool block. */
+#define STDS_OBJECT_POOL_BLOCK              32  /* Buttons, polygons, etc. per pool block. */
+#define STDS_POLYGON_INLINE_SIDES           8   /* Sides a polygon_t stores inside itself. */
+#define STDS_CAMERA_STEP                    ( 1.0f / 240.0f ) /* Longest camera spring integration step. */
+#define STDS_FRAME_ARENA_SIZE               65536 /* Initial bytes of the per-frame arena. */
+#define STDS_FLOW_NONE                      0xff /* Flow field cell with no direction. */
+#define STDS_ENTITY_INDEX_BITS              20 /* Slot bits of an entity id; the rest is generation. */
+#define STDS_ENTITY_INDEX_MASK              0x000fffffu
+#define STDS_ENTITY_GENERATION_MASK         0xfffu
+#define STDS_ENTITY_NONE                    0xffffffffu
+#define STDS_JOB_DEQUE_SIZE                 1024 /* Jobs per thread deque; a power of two. */
+#define STDS_JOB_MAX_CONTINUATIONS          8
+#define STDS_JOB_SPLIT                      4 /* Parallel-for chunks per thread. */
+#define STDS_JOB_IDLE_MS                    2 /* Longest idle sleep before re-checking. */
+#define STDS_COMMANDS_ON                    1 /* Record the draw delegate, then replay it. */
+#define STDS_COMMANDS_BATCH                 2 /* Replay runs of sprites as sorted batches. */
+#define STDS_COMMANDS_OVERLAP               4 /* Record one frame ahead on a job thread. */
+#define STDS_COMMANDS_SORT                  8 /* Replay every draw in sort-key order. */
+#define STDS_COMMAND_TEXTURE                0
+#define STDS_COMMAND_SPRITE                 1
+#define STDS_COMMAND_RECT                   2
+#define STDS_COMMAND_LINE                   3
+#define STDS_COMMAND_CIRCLE                 4
+#define STDS_COMMAND_QUADS                  5
+#define STDS_COMMAND_BATCH_BEGIN            6
+#define STDS_COMMAND_BATCH_LAYER            7
+#define STDS_COMMAND_BATCH_END              8
+#define STDS_COMMAND_DRAW_COLOR             9
+#define STDS_COMMAND_DRAW_BLEND             10
+#define STDS_COMMAND_TEXTURE_BLEND          11
+#define STDS_COMMAND_TEXTURE_COLOR          12
+#define STDS_COMMAND_TEXTURE_ALPHA          13
+#define STDS_COMMAND_BATCH_DEPTH            14
+#define STDS_COMMAND_CIRCLES                15
+#define STDS_COMMAND_RECTS                  16
+#define STDS_COMMAND_LINES                  17
+#define STDS_COMMAND_HAS_SRC                1
+#define STDS_COMMAND_HAS_CENTER             2
+#define STDS_COMMAND_IS_FILLED              4
+#define STDS_COMMAND_HAS_COLORS             8
+#define STDS_UI_DIRTY_RECTS                 16 /* Regions a UI layer tracks before merging them. */
+#define STDS_UI_BUTTON                      0
+#define STDS_UI_TEXT_FIELD                  1
+#define STDS_UI_CUSTOM                      2
+#define STDS_BUTTON_CELL_SIZE               64 /* Pixels per side of a button hit-test cell. */
+#define STDS_LIGHT_TEXTURE_RADIUS           128 /* Radius of the default light sprite. */
+#define STDS_BLOOM_LEVELS                   2   /* Downsampled targets blurred into a bloom. */
+#define STDS_INPUT_RING_SIZE                256 /* Input thread queue; a power of two. */
+#define STDS_INPUT_POLL_MS                  1   /* Sleep of the input thread between pumps. */
+#define STDS_SIN_TABLE_SIZE                 360 /* Sine table entries, one per degree. */
+#define STDS_TELEMETRY_CSV                  0
+#define STDS_TELEMETRY_JSON                 1   /* One JSON object per line. */
+#define STDS_TELEMETRY_SUB_BITS             4   /* Histogram buckets per power of two, as bits. */
+#define STDS_TELEMETRY_MAX_BITS             26  /* Frame times up to 2^26 us (67 s). */
+#define STDS_TELEMETRY_BUCKETS              368 /* ( MAX_BITS - SUB_BITS + 1 ) << SUB_BITS. */
+#define STDS_TELEMETRY_MAX_WATCHED          32  /* Particle systems and entity sets counted. */
+#define STDS_TELEMETRY_PARTICLES            0
+#define STDS_TELEMETRY_ENTITIES             1
+#define STDS_TELEMETRY_ENTITY_POOL          2
+#define STDS_SCENE_STACK_SIZE               8   /* Scenes that can be stacked at once. */
+#define STDS_INIT_VIDEO                     0x01 /* Window and renderer; headless without. */
+#define STDS_INIT_AUDIO                     0x02 /* Open the mixer at startup. */
+#define STDS_INIT_LAZY_AUDIO                0x04 /* Open the mixer at the first sound use. */
+#define STDS_INIT_FONTS                     0x08 /* Start SDL_ttf now, not at the first font. */
+#define STDS_INIT_CONTROLLERS               0x10 /* Joysticks, game controllers and haptics. */
+#define STDS_INIT_EVERYTHING                0x1b /* All but STDS_INIT_LAZY_AUDIO. */
+#define STDS_AUDIO_FREQUENCY                44100
+#define STDS_AUDIO_CHANNELS                 2    /* Output channels, 2 for stereo. */
+#define STDS_AUDIO_BUFFER                   1024 /* Mixer chunk size in sample frames. */
 
 enum GameState { RUNNING, PREGAME, INIT, TRANSITION, PAUSED };
 
@@ -57,6 +57,12 @@ extern float Stds_ToRadians( const float degree_angle );
 
 extern float Stds_ToDegrees( const float radian_angle );
 
+extern void Stds_InitSinTable( void );
+
+extern void Stds_SinCos( const float radians, float *s, float *c );
+
+extern void Stds_SinCosDegrees( const float degrees, float *s, float *c );
+
 extern bool Stds_IsMouseOverRect( const float x, const float y, const SDL_Rect *rect );
 
 extern SDL_Color Stds_ConvertARGBToColor( const uint32_t c );
@@ -71,4 +77,9 @@ extern char *Stds_StrCatIntPtr( const char *s, const int32_t n );
 
 extern char *Stds_StrCatIntArray( const char s[], const int32_t n );
 
+extern uint32_t Stds_HashString( const char *s );
+
+extern void Stds_RadixSortKeys( const uint64_t *keys, uint32_t *order, uint32_t *scratch,
+                                const int32_t count );
+
 #endif // STDS_H
\ No newline at end of file
@@ -8,6 +8,62 @@ struct vec2_t {
   float y;
 };
 
+/*
+ * 2x3 affine matrix. A point (x, y) maps to (a * x + c * y + tx,
+ * b * x + d * y + ty), so a rotation by t is a = d = cos(t), b = sin(t)
+ * and c = -sin(t).
+ */
+struct transform_t {
+  float a;
+  float b;
+  float c;
+  float d;
+  float tx;
+  float ty;
+};
+
+/*
+ * Node of a transform hierarchy. The local matrix is built from position,
+ * angle (degrees) and scale; world is the parent's world matrix composed
+ * with it. world is only recomputed after this node or an ancestor changes.
+ */
+struct transform_node_t {
+  struct transform_node_t *parent;
+  struct transform_t       local;
+  struct transform_t       world;
+  struct vec2_t            position;
+  struct vec2_t            scale;
+  float                    angle;
+  uint32_t                 version;        /* Bumped every time world is recomputed. */
+  uint32_t                 parent_version; /* parent->version world was computed from. */
+  bool                     is_dirty;
+};
+
+/*
+ * Camera that follows a point through a spring, with a dead zone, look-ahead
+ * and screen shake. view is the world rectangle it shows and viewport the
+ * screen rectangle that view is drawn into, so several cameras can split
+ * the screen.
+ */
+struct camera_t {
+  SDL_FRect     view;
+  SDL_Rect      viewport;
+  struct vec2_t velocity;   /* Of the view, in pixels per second. */
+  float         stiffness;  /* Spring constant; 0 snaps to the target. */
+  float         damping;    /* 2 * sqrt( stiffness ) is critically damped. */
+  struct vec2_t dead_zone;  /* Half-extents around the view center where the focus is free. */
+  float         look_ahead; /* Updates of focus velocity the view leads by. */
+  float         shake_magnitude;
+  float         shake_duration;
+  float         shake_time;
+  struct vec2_t shake_offset;
+  bool          is_clamped; /* Keeps the view inside the level. */
+
+  /* Renderer state replaced between Stds_CameraBegin and Stds_CameraEnd. */
+  SDL_FRect saved_camera;
+  SDL_Rect  saved_viewport;
+};
+
 struct polygon_t {
   struct vec2_t *points;
   struct vec2_t  position;
@@ -16,20 +72,187 @@ struct polygon_t {
   float   angle;
   int32_t sides;
   bool    has_overlap;
+
+  /* Unique SAT axes. model_normals are unit edge normals of the model with
+     parallel edges removed; normals are the same rotated by the angle. */
+  struct vec2_t *model_normals;
+  struct vec2_t *normals;
+  int32_t        normal_count;
+
+  /* Transform the points were last computed with. Stds_UpdatePolygon skips
+     the work while angle and position match and is_dirty is false; set
+     is_dirty after editing model directly. */
+  float         cached_angle;
+  struct vec2_t cached_position;
+  float         cos_angle;
+  float         sin_angle;
+  bool          is_dirty;
+
+  SDL_FRect aabb; /* World bounds of points, checked before SAT. */
+
+  /* model, points, model_normals and normals, back to back. Polygons of up
+     to STDS_POLYGON_INLINE_SIDES sides keep them in inline_vertices, so one
+     pool allocation holds the whole polygon; larger ones share the single
+     heap block in heap_vertices. */
+  struct vec2_t *heap_vertices;
+  struct vec2_t  inline_vertices[STDS_POLYGON_INLINE_SIDES * 4];
 };
 
 /**
  *
  */
+/*
+ * Last blend mode and color/alpha mods set on a texture, as remembered by the
+ * render state cache. known says which of the fields are valid.
+ */
+struct texture_state_t {
+  SDL_Texture * texture;
+  SDL_BlendMode blend_mode;
+  SDL_Color     mod;
+  uint8_t       known;
+};
+
+/*
+ * Shadow copy of the renderer state set through draw.c, used to skip SDL
+ * calls that would not change anything.
+ */
+struct render_state_t {
+  bool          is_valid;
+  SDL_Color     draw_color;
+  SDL_BlendMode draw_blend_mode;
+
+  struct texture_state_t textures[STDS_TEXTURE_STATE_SLOTS];
+};
+
+/*
+ * One queued sprite of a sprite batch. dst is in screen coordinates and
+ * center is the rotation point relative to dst; src.w == 0 draws the whole
+ * texture. key is the sort key from Stds_MakeSortKey.
+ */
+struct sprite_t {
+  SDL_Texture *    texture;
+  SDL_Rect         src;
+  SDL_FRect        dst;
+  SDL_FPoint       center;
+  float            angle;
+  SDL_RendererFlip flip;
+  SDL_Color        color;
+  uint64_t         key;
+};
+
+/*
+ * Sprites collected between Stds_BatchBegin and Stds_BatchEnd.
+ */
+struct sprite_batch_t {
+  struct sprite_t *sprites;
+  int32_t          count;
+  int32_t          capacity;
+  int32_t          layer; /* Layer given to Stds_DrawTexture/Stds_BlitTexture calls. */
+  uint16_t         depth; /* Depth within the layer, likewise. */
+  bool             is_active;
+
+  /* Scratch for sorting, sized to sort_capacity sprites. */
+  struct sprite_t *sorted;
+  uint64_t *       keys;
+  uint32_t *       order;
+  uint32_t *       scratch;
+  int32_t          sort_capacity;
+};
+
+/*
+ * Circle meshes built once per radius bucket. Bucket b has 8 << b segments,
+ * takes every (STDS_CIRCLE_MAX_SEGMENTS >> (b + 3))th point of the unit rim,
+ * and is used up to max_radius[b], where its chords stay within a quarter
+ * pixel of the true circle. fan and ring hold the triangle indices of a
+ * filled disc (center first, then the rim) and of a one-pixel outline (outer
+ * and inner rim points interleaved).
+ */
+struct shape_cache_t {
+  SDL_FPoint rim[STDS_CIRCLE_MAX_SEGMENTS];
+  float      max_radius[STDS_CIRCLE_BUCKETS];
+  int32_t    fan[STDS_CIRCLE_BUCKETS][STDS_CIRCLE_MAX_SEGMENTS * 3];
+  int32_t    ring[STDS_CIRCLE_BUCKETS][STDS_CIRCLE_MAX_SEGMENTS * 6];
+  bool       is_ready;
+};
+
+/*
+ * One recorded draw call of a command buffer. Coordinates are already in
+ * screen space. The fields used depend on type: lines keep their end points
+ * in dst as x, y, w = x2, h = y2, circles keep the center and radius in dst.x,
+ * dst.y and dst.w, and quads, circles, rects and lines keep their arrays in
+ * the buffer's payload at offset.
+ */
+struct render_command_t {
+  SDL_Texture *    texture;
+  SDL_Rect         src;
+  SDL_FRect        dst;
+  SDL_FPoint       center;
+  float            angle;
+  SDL_Color        color;
+  SDL_BlendMode    blend_mode;
+  SDL_RendererFlip flip;
+  int32_t          layer;
+  uint32_t         offset;
+  int32_t          count;
+  uint8_t          type;
+  uint8_t          flags;
+};
+
+/*
+ * Commands recorded during one frame, plus the bytes they point into.
+ */
+struct command_buffer_t {
+  struct render_command_t *commands;
+  int32_t                  count;
+  int32_t                  capacity;
+
+  uint8_t *payload;
+  size_t   payload_size;
+  size_t   payload_capacity;
+};
+
+/*
+ * Scratch of a sorted command submit, grown to the largest frame seen. mods
+ * maps a texture to its color and alpha mods as of each recorded draw.
+ */
+struct command_sort_t {
+  uint64_t * keys;
+  uint32_t * order;
+  uint32_t * scratch;
+  int32_t *  commands;
+  SDL_Color *colors;
+  int32_t    capacity;
+
+  struct stds_hashmap_t *mods;
+};
+
+/*
+ * Retained text object. The string is rasterized into its own texture once and
+ * only again when the string or font changes; color changes are applied as a
+ * texture color mod.
+ */
+struct text_t {
+  char        text[LARGE_TEXT_BUFFER];
+  const char *font_path;
+  uint16_t    font_size;
+  SDL_Color   color;
+
+  SDL_Texture *texture;
+  int32_t      w;
+  int32_t      h;
+  bool         is_dirty;
+};
+
 struct text_field_t {
   float    x;
   float    y;
   uint16_t font_size;
   bool     toggle_text_input;
 
-  char        text[LARGE_TEXT_BUFFER];
-  const char *font_directory;
-  SDL_Color * font_color;
+  char           text[LARGE_TEXT_BUFFER];
+  const char *   font_directory;
+  SDL_Color *    font_color;
+  struct text_t *text_object;
 
   struct text_field_t *next;
 };
@@ -63,9 +286,100 @@ struct button_t {
   SDL_Color    text_color;
   SDL_Rect     rect;
 
+  struct text_t *text_object;
+
+  bool is_hovered; /* Topmost indexed button under the mouse. */
+  bool is_indexed; /* In the hit-test grid as of its last rebuild. */
+
   struct button_t *next;
 };
 
+/*
+ * Hit-test grid over the screen for the buttons in g_app.button_head. The
+ * buttons overlapping cell i are entries[cell_start[i]] up to
+ * entries[cell_start[i + 1]], in list order.
+ */
+struct button_grid_t {
+  struct button_t **entries;
+  int32_t *         cell_start;
+  int32_t *         cell_fill;
+  int32_t           entry_capacity;
+  int32_t           cell_capacity;
+  int32_t           cols;
+  int32_t           rows;
+  int32_t           mouse_x;
+  int32_t           mouse_y;
+  struct button_t * hovered;
+  bool              is_dirty;
+};
+
+/*
+ * Light drawn into a lightmap: the light sprite is centered on x, y, scaled
+ * to radius and tinted by color.
+ */
+struct light_t {
+  float     x;
+  float     y;
+  float     radius;
+  SDL_Color color;
+};
+
+/*
+ * Screen-sized render target, possibly downsampled by scale, that lights are
+ * added into over an ambient color and that multiplies the scene once.
+ */
+struct lightmap_t {
+  SDL_Texture *texture;
+  SDL_Texture *light_texture;
+  SDL_Texture *previous_target;
+  SDL_Color    ambient;
+  int32_t      scale;
+  uint32_t     target_resets; /* g_app.target_resets the texture was drawn under. */
+  bool         is_drawn;
+};
+
+/*
+ * Chain of downsampled render targets: whatever is drawn into the first one
+ * is blurred by filtering down the chain, then every level is added onto the
+ * screen at intensity.
+ */
+struct bloom_t {
+  SDL_Texture *levels[STDS_BLOOM_LEVELS];
+  SDL_Texture *previous_target;
+  int32_t      downsample;
+  uint8_t      intensity;
+  bool         is_drawn;
+};
+
+/*
+ * Element drawn by a UI layer. rect and signature describe the element as it
+ * was last drawn into the layer; a change to either marks it dirty.
+ */
+struct ui_element_t {
+  uint8_t  kind; /* STDS_UI_BUTTON, STDS_UI_TEXT_FIELD or STDS_UI_CUSTOM. */
+  void *   widget;
+  void ( *draw )( void * ); /* Only for STDS_UI_CUSTOM. */
+  SDL_Rect rect;
+  uint32_t signature;
+};
+
+/*
+ * Retained UI layer: its elements are drawn into a cached texture, and only
+ * the regions whose elements changed are drawn again.
+ */
+struct ui_layer_t {
+  SDL_Texture *        texture;
+  SDL_Color            background;
+  int32_t              w;
+  int32_t              h;
+  struct ui_element_t *elements;
+  int32_t              element_count;
+  int32_t              element_capacity;
+  SDL_Rect             dirty[STDS_UI_DIRTY_RECTS];
+  int32_t              dirty_count;
+  uint32_t             target_resets; /* g_app.target_resets the texture was drawn under. */
+};
+
 /*
  *
  */
@@ -96,6 +410,69 @@ struct particle_t {
   void ( *particle_draw )( struct particle_t * );
 };
 
+/*
+ * One stored cell of a tilemap grid: either a texture from the grid's
+ * texture array or a clip of its sprite sheet.
+ */
+struct grid_tile_t {
+  SDL_Rect clip;
+  int32_t  texture_index;
+  uint16_t angle;
+  uint8_t  flip;
+  uint8_t  kind; /* STDS_GRID_TILE_EMPTY, _TEXTURE or _SPRITE. */
+};
+
+/*
+ * A chunk_size x chunk_size block of tiles baked into one texture. It is
+ * rebaked the next time it is drawn after one of its cells changes.
+ */
+struct grid_chunk_t {
+  SDL_Texture *texture;
+  bool         is_dirty;
+};
+
+/*
+ * One chunk of a binary tilemap. While resident, tiles and flags point at
+ * the chunk's block, inside the file mapping or in buffer when the map is
+ * streamed through SDL_RWops. texture is the baked chunk, if drawn.
+ */
+struct tilemap_chunk_t {
+  const uint16_t *tiles;
+  const uint8_t * flags;
+  void *          buffer;
+  SDL_Texture *   texture;
+  bool            is_resident;
+};
+
+/*
+ * A tilemap loaded from the binary format written by Stds_SaveTilemap. Only
+ * the chunks around the camera are kept resident; see tilemap.c.
+ */
+struct tilemap_t {
+  uint32_t cols;
+  uint32_t rows;
+  uint32_t tile_w;
+  uint32_t tile_h;
+  uint32_t chunk_size;
+  uint32_t chunk_cols;
+  uint32_t chunk_rows;
+
+  uint32_t *              chunk_offsets;
+  struct tilemap_chunk_t *chunks;
+  uint32_t                resident_count;
+
+  /* Memory-mapped file, or the open file when chunks are read on demand. */
+  void *     map;
+  size_t     map_size;
+  SDL_RWops *rw;
+
+  /* Tile index t > 0 draws cell t - 1 of the sheet; 0 is empty. */
+  SDL_Texture *sprite_sheet;
+  uint32_t     sheet_cols;
+  uint32_t     target_resets; /* g_app.target_resets the chunks were baked under. */
+  bool         is_camera_offset_enabled;
+};
+
 /**
  *
  */
@@ -134,17 +511,466 @@ struct grid_t {
   int32_t animation_buffer;
 
   struct stds_vector_t *animation;
+
+  /* Tilemap mode: cells are stored instead of drawn immediately, then
+     baked per chunk into render-target textures. */
+  bool                 is_tilemap_enabled;
+  struct grid_tile_t * tiles;
+  struct grid_chunk_t *chunks;
+  uint32_t             chunk_size;
+  uint32_t             chunk_cols;
+  uint32_t             chunk_rows;
+  uint32_t             target_resets; /* g_app.target_resets the chunks were baked under. */
+
+  /* Instanced tiles: one index per cell, 0 for empty, otherwise 1 + the
+     sprite sheet cell (row-major) or 1 + the slot in textures when the grid
+     has no sprite sheet. Allocated by the first Stds_SetGridTileIndex. */
+  uint16_t *tile_indices;
+
+  /* Pathfinding: one walkability bit per cell (NULL means every cell is
+     walkable), optional per-cell step costs (NULL means uniform cost, which
+     enables Jump Point Search), and buffers reused between queries. */
+  uint32_t *                  walkable;
+  uint8_t *                   path_costs;
+  struct grid_path_scratch_t *path_scratch;
+};
+
+/*
+ * A path found by Stds_GridFindPath: every cell from start to goal
+ * inclusive, as (col, row) points. The points buffer is reused and grown by
+ * later queries; free it with Stds_FreeGridPath.
+ */
+struct grid_path_t {
+  SDL_Point *points;
+  int32_t    count;
+  int32_t    capacity;
+  float      cost;
+};
+
+/*
+ * Per-cell search state. stamp says which query last touched the cell, so
+ * nothing has to be cleared between queries.
+ */
+struct grid_path_node_t {
+  float    g;
+  int32_t  parent;
+  int32_t  handle;
+  uint32_t stamp;
+  bool     is_closed;
+};
+
+/*
+ * Search buffers owned by a grid: one node per cell and the open set.
+ */
+struct grid_path_scratch_t {
+  struct grid_path_node_t *nodes;
+  struct stds_heap_t *     open;
+  uint32_t                 stamp;
+};
+
+/*
+ * Direction field toward one goal cell, shared by every agent chasing it.
+ * Agents read the front buffers; a build writes the back buffers, possibly
+ * on a worker thread, and Stds_UpdateFlowField swaps them once it is done.
+ * directions holds an index into the eight neighbor offsets, or
+ * STDS_FLOW_NONE for blocked and unreachable cells.
+ */
+struct grid_flow_field_t {
+  struct grid_t *grid;
+
+  float *  distances;
+  uint8_t *directions;
+  float *  back_distances;
+  uint8_t *back_directions;
+
+  struct stds_heap_t *open;
+  int32_t *           handles;
+
+  int32_t goal_cell;
+  int32_t building_goal_cell;
+  bool    is_dirty;
+
+  SDL_Thread * thread;
+  SDL_atomic_t is_build_done;
+};
+
+/*
+ * Node of a dynamic AABB tree. Leaves hold user data and a tight box; every
+ * node's aabb is fattened by the tree margin. Free nodes reuse parent as the
+ * free-list link.
+ */
+struct aabb_node_t {
+  SDL_FRect aabb;
+  SDL_FRect tight;
+  void *    data;
+
+  int32_t parent;
+  int32_t left;
+  int32_t right;
+  int32_t height; /* 0 for leaves, -1 for free nodes. */
+};
+
+/*
+ * Dynamic bounding-volume tree with fat AABBs, for broad phases where object
+ * sizes vary too much for a uniform grid.
+ */
+struct aabb_tree_t {
+  struct aabb_node_t *nodes;
+  int32_t             node_capacity;
+  int32_t             root;
+  int32_t             free_list;
+  float               margin;
+
+  int32_t *stack;
+  int32_t  stack_capacity;
+};
+
+/*
+ * One time-of-impact contact found by a continuous collision sweep.
+ */
+struct sweep_contact_t {
+  int32_t       proxy; /* Tree proxy that was hit. */
+  void *        data;  /* The proxy's user data. */
+  struct vec2_t point;
+  struct vec2_t normal;
+  float         time; /* Fraction of the frame's movement at impact, in [0, 1]. */
+};
+
+/*
+ * Entity indexed by a spatial hash, with the AABB it was inserted with.
+ */
+struct spatial_item_t {
+  struct entity_t *entity;
+  SDL_FRect        aabb;
+  int32_t          stamp; /* Last query that visited this item, for de-duplication. */
+};
+
+/*
+ * One item's membership in one grid cell. Entries of a bucket form a singly
+ * linked list through next; cx/cy tell apart cells that share a bucket.
+ */
+struct spatial_cell_entry_t {
+  int32_t item;
+  int32_t cx;
+  int32_t cy;
+  int32_t next;
+};
+
+/*
+ * Uniform-grid spatial hash over entity AABBs. Cells are cell_size wide and
+ * hashed into bucket_count (a power of two) buckets, so the world is unbounded.
+ */
+struct spatial_hash_t {
+  float cell_size;
+  float inv_cell_size;
+
+  int32_t *buckets;
+  int32_t  bucket_count;
+
+  struct spatial_item_t *items;
+  int32_t                item_count;
+  int32_t                item_capacity;
+
+  struct spatial_cell_entry_t *entries;
+  int32_t                      entry_count;
+  int32_t                      entry_capacity;
+
+  int32_t stamp;
+};
+
+/*
+ * Contiguous storage for many colliders of the same kind, so batch tests
+ * stream through flat float arrays instead of chasing entity pointers.
+ * Capacities are multiples of 8, the widest SIMD lane count. Polygon i owns
+ * poly_points[poly_offset[i]] .. poly_points[poly_offset[i] + poly_sides[i] - 1].
+ */
+struct collider_pool_t {
+  float * rect_x;
+  float * rect_y;
+  float * rect_w;
+  float * rect_h;
+  int32_t rect_count;
+  int32_t rect_capacity;
+
+  float * circle_x;
+  float * circle_y;
+  float * circle_r;
+  int32_t circle_count;
+  int32_t circle_capacity;
+
+  struct vec2_t *poly_points;
+  int32_t        poly_point_count;
+  int32_t        poly_point_capacity;
+  int32_t *      poly_offset;
+  int32_t *      poly_sides;
+  SDL_FRect *    poly_aabb;
+  int32_t        poly_count;
+  int32_t        poly_capacity;
+};
+
+/*
+ * One entity's projection onto the x axis in a sweep-and-prune list.
+ */
+struct sap_interval_t {
+  int32_t index; /* Index into the caller's entity array. */
+  float   min_x;
+  float   max_x;
+};
+
+/*
+ * Sweep-and-prune state kept between frames. Intervals stay sorted by min_x,
+ * so when entities move a little each frame re-sorting is nearly linear.
+ */
+struct sweep_and_prune_t {
+  struct sap_interval_t *intervals;
+  int32_t                count;
+  int32_t                capacity;
+};
+
+/*
+ * Segment of an atlas page's skyline: the packed height over [x, x + w).
+ */
+struct atlas_node_t {
+  int32_t x;
+  int32_t y;
+  int32_t w;
+};
+
+/*
+ * One page of a texture atlas. Images are packed into the surface on the CPU
+ * and copied into the texture by Stds_AtlasUpload; the texture pointer never
+ * changes, so it can be stored as soon as the page exists.
+ */
+struct atlas_page_t {
+  SDL_Surface *surface;
+  SDL_Texture *texture;
+
+  struct atlas_node_t *nodes;
+  int32_t              node_count;
+  int32_t              node_capacity;
+
+  bool is_dirty;
+};
+
+/*
+ * Sub-rectangle of an atlas page holding one packed image.
+ */
+struct atlas_region_t {
+  SDL_Texture *texture;
+  SDL_Rect     rect;
+  int32_t      page;
+};
+
+/*
+ * Runtime texture atlas built with a skyline packer. Region indices returned
+ * by Stds_AtlasAddImage/Stds_AtlasAddSurface stay valid for the atlas' life.
+ */
+struct atlas_t {
+  int32_t page_width;
+  int32_t page_height;
+  int32_t padding;
+
+  struct atlas_page_t *pages;
+  int32_t              page_count;
+
+  struct atlas_region_t *regions;
+  int32_t                region_count;
+  int32_t                region_capacity;
+};
+
+/*
+ * Fixed set of worker threads that run batches of indexed jobs. The thread
+ * calling Stds_WorkerPoolRun takes part in the batch and returns once every
+ * job has finished.
+ */
+struct worker_pool_t {
+  SDL_Thread **threads;
+  int32_t      thread_count;
+
+  SDL_mutex *lock;
+  SDL_cond * work_cond;
+  SDL_cond * done_cond;
+
+  void ( *job )( void *data, int32_t index );
+  void *       job_data;
+  int32_t      job_count;
+  SDL_atomic_t next_job;
+  int32_t      pending_jobs;
+  int32_t      active_workers;
+  uint32_t     generation;
+  bool         is_running;
+};
+
+/*
+ * One unit of work for the job system: fn( data, i ) for every i in
+ * [begin, end). counter, when set, is decremented once the range is done.
+ */
+struct job_t {
+  void ( *fn )( void *data, int32_t index );
+  void *                data;
+  int32_t               begin;
+  int32_t               end;
+  struct job_counter_t *counter;
+};
+
+/*
+ * Dependency counter. pending counts the jobs still to finish; jobs queued
+ * with Stds_JobSubmitAfter wait in continuations until it reaches zero. A
+ * zeroed counter is ready to use.
+ */
+struct job_counter_t {
+  SDL_atomic_t pending;
+  SDL_SpinLock lock;
+  int32_t      continuation_count;
+  struct job_t continuations[STDS_JOB_MAX_CONTINUATIONS];
+};
+
+/*
+ * Per-thread work-stealing deque. The owner pushes and pops at bottom, idle
+ * threads steal from top. top and bottom only grow and wrap into the ring.
+ */
+struct job_deque_t {
+  SDL_SpinLock  lock;
+  uint32_t      top;
+  uint32_t      bottom;
+  struct job_t *jobs;
+};
+
+/*
+ * Job scheduler. Deque 0 belongs to the main thread (and any other thread
+ * that is not a job worker); deque i + 1 to worker thread i.
+ */
+struct job_system_t {
+  SDL_Thread **       threads;
+  int32_t             thread_count;
+  struct job_deque_t *deques;
+  int32_t             deque_count;
+
+  SDL_TLSID    thread_slot;
+  SDL_sem *    wake;
+  SDL_atomic_t queued;
+  SDL_atomic_t sleepers;
+  SDL_atomic_t is_running;
+};
+
+/*
+ * One request to the asset loader. A worker decodes it off the main thread
+ * (surface, chunk, music, or raw file data), then the main thread finishes
+ * it in Stds_UpdateAssetLoader. next links the pending and decoded queues.
+ */
+struct asset_request_t {
+  char         path[LARGE_TEXT_BUFFER];
+  int32_t      type;
+  int32_t      param; /* SFX id or font size. */
+  SDL_atomic_t state;
+
+  SDL_Surface *surface;
+  Mix_Chunk *  chunk;
+  Mix_Music *  music;
+  void *       data;
+  size_t       data_size;
+  int32_t      texture_handle;
+
+  int32_t next;
+};
+
+/*
+ * Background asset loader. Requests are referred to by their index, which
+ * is the handle returned to callers.
+ */
+struct asset_loader_t {
+  struct asset_request_t **requests;
+  int32_t                  count;
+  int32_t                  capacity;
+
+  int32_t pending_head, pending_tail;
+  int32_t decoded_head, decoded_tail;
+
+  SDL_mutex *  lock;
+  SDL_cond *   work_cond;
+  SDL_cond *   decoded_cond;
+  SDL_Thread **threads;
+  int32_t      thread_count;
+  bool         is_running;
+};
+
+/*
+ * One file inside a mounted asset pack. data points into the pack's single
+ * mapping or buffer; width and height are set for STDS_PACK_RGBA entries.
+ */
+struct pack_entry_t {
+  char           name[STDS_PACK_NAME_LEN];
+  const uint8_t *data;
+  uint32_t       size;
+  uint32_t       type;
+  uint16_t       width;
+  uint16_t       height;
+};
+
+/*
+ * A mounted asset pack: the whole file, mapped or read in one go, and its
+ * index sorted by name.
+ */
+struct pack_t {
+  void *               base;
+  size_t               size;
+  bool                 is_mapped;
+  struct pack_entry_t *entries;
+  uint32_t             count;
+};
+
+/*
+ * Structure-of-arrays storage used by particle systems created with
+ * Stds_CreateParticleSystemSoA. Every array has max_particles elements and
+ * lives in a single block owned by the system. Hot kinematic fields come
+ * first; color and texture are only read when drawing.
+ */
+struct particle_soa_t {
+  float *  x;
+  float *  y;
+  float *  vx;
+  float *  vy;
+  float *  ax;
+  float *  ay;
+  float *  w;
+  float *  h;
+  float *  dw;
+  float *  dh;
+  float *  alpha;
+  float *  delta_alpha;
+  int32_t *life;
+
+  SDL_Color *   color;
+  SDL_Texture **texture;
+
+  /* One bit per particle, set by the integrator when the particle dies. */
+  uint32_t *death_mask;
+
+  /* Stateless systems only: the frame each particle was spawned in. The
+     other arrays keep the spawn state and life holds the frame it dies in. */
+  int32_t *born;
 };
 
 /*
  *
  */
 struct particle_system_t {
-  int32_t alive_count;
-  int32_t dead_index;
-  int32_t max_particles;
+  int32_t  alive_count;
+  int32_t  dead_index;
+  int32_t  max_particles;
+  uint32_t flags;
+
+  /* Blend mode applied to textured particles in SoA mode. */
+  SDL_BlendMode blend_mode;
 
-  struct particle_t *particles;
+  /* Stateless mode: frames updated so far, and the earliest death frame of
+     the alive particles. */
+  int32_t frame;
+  int32_t next_death;
+
+  struct particle_t *   particles;
+  struct particle_soa_t soa;
+  void *                soa_block;
 };
 
 /*
@@ -185,32 +1011,106 @@ struct trail_t {
 };
 
 /*
- *
+ * One segment of a trail emitter: where it was drawn and when. Its alpha
+ * is derived from its age, so live segments are never written again.
+ */
+struct trail_segment_t {
+  float            x;
+  float            y;
+  float            w;
+  float            h;
+  uint32_t         born;
+  SDL_RendererFlip flip;
+  SDL_Texture *    texture;
+};
+
+/*
+ * A trail emitter owns a fixed-capacity ring of segments. Every segment
+ * loses the same alpha per update, so they die in the order they were
+ * emitted: the oldest sits at head and new ones go in at head + count.
+ * draw_rects, draw_circles and draw_colors are capacity-sized scratch for
+ * batched drawing.
+ */
+struct trail_emitter_t {
+  struct trail_segment_t *segments;
+  SDL_FRect *             draw_rects;
+  struct circle_t *       draw_circles;
+  SDL_Color *             draw_colors;
+  int32_t                 capacity;
+  int32_t                 head;
+  int32_t                 count;
+  uint32_t                tick;
+  int16_t                 alpha_decay_rate;
+  uint32_t                flags;
+  SDL_Color               color;
+  bool                    is_camera_offset_enabled;
+};
+
+/*
+ * Immutable frames of an animation, shared by every animation playing it.
+ * Frame i draws rects[i] of textures[i]; sheet clips point every entry at
+ * the one sheet texture. The arrays live in the same allocation as the clip.
+ */
+struct animation_clip_t {
+  SDL_Texture **textures;
+  SDL_Rect *    rects;
+  float         frame_delay; /* Seconds per frame. */
+  float         duration;    /* Seconds per cycle. */
+  int32_t       frame_count;
+  uint32_t      flags;
+};
+
+/*
+ * Playback of a clip by one animation. The frame follows from time alone.
+ */
+struct animation_state_t {
+  const struct animation_clip_t *clip;
+  float                          time;  /* Seconds into the current cycle. */
+  float                          speed; /* Playback rate; 1 is the clip's own. */
+  int32_t                        frame;
+  uint32_t                       flags;
+};
+
+/*
+ * Playback states owned by the animation system, packed so that one update
+ * runs down a single array. dsts and flips give where each instance draws.
+ * slots maps a handle to its dense index, or -1 once removed, and removing
+ * moves the last instance into the hole. Freed handles wait in free_handles.
+ */
+struct animation_system_t {
+  struct animation_state_t *states;
+  SDL_FRect *               dsts;
+  SDL_RendererFlip *        flips;
+  int32_t *                 handles; /* Handle of each dense index. */
+  int32_t                   count;
+  int32_t                   capacity;
+
+  int32_t *slots;
+  int32_t *free_handles;
+  int32_t  slot_count;
+  int32_t  free_count;
+
+  bool is_parallel;
+};
+
+/*
+ * A positioned animation. Its frames come from clip, which it owns when it
+ * was loaded by Stds_AddSpritesheet, Stds_AddAnimation or
+ * Stds_AddAnimationAtlas. frames, current_frame_id, current_texture and the
+ * sprite size mirror the clip and its playback for older callers.
  */
 struct animation_t {
   struct vec2_t pos;
   struct vec2_t scale;
-  struct vec2_t splice;
 
-  float    frame_delay;
-  float    frame_timer;
   uint32_t id_flags;
   uint32_t flags;
   uint16_t angle;
-  uint16_t start_x;
-  uint16_t start_y;
   int32_t  sprite_width;
   int32_t  sprite_height;
   int32_t  dest_width;
   int32_t  dest_height;
-  int32_t  sprite_sheet_width;
-  int32_t  sprite_sheet_height;
   uint8_t  current_frame_id;
-  uint8_t  current_frame_row_id;
-  uint8_t  current_frame_col_id;
-  size_t   number_of_frames;
-  size_t   rows_count;
-  size_t   cols_count;
 
   bool is_camera_offset_enabled;
   bool is_cycle_once;
@@ -219,9 +1119,10 @@ struct animation_t {
   SDL_FPoint *     rotate_point;
 
   SDL_Texture * current_texture;
-  SDL_Texture * default_texture;
   SDL_Texture **frames;
-  SDL_Texture * sprite_sheet;
+
+  struct animation_clip_t *clip;
+  struct animation_state_t state;
 
   struct polygon_t *  bounding_box;
   struct animation_t *next;
@@ -238,29 +1139,49 @@ struct background_t {
   int32_t       h;
 
   SDL_Texture *background_texture;
+
+  /* Cache handles of the layers composited into background_texture, back to
+     front, so it can be drawn again after render targets are reset. */
+  int32_t *composite_handles;
+  int32_t  composite_count;
+  uint32_t target_resets; /* g_app.target_resets the composite was drawn under. */
 };
 
 /*
- *
+ * Entry of the texture cache. Entries live in the dense g_app.textures
+ * array, and their index in it is the texture's handle. texture is NULL
+ * while the entry is evicted; it reloads from name when next resolved.
  */
 struct texture_t {
-  char name[MAX_FILE_NAME_LEN];
+  char *   name; /* Full file name, owned by the cache, to reload the texture from. */
+  uint32_t hash; /* Stds_HashString of the full file name. */
 
   SDL_Texture *texture;
-
-  struct texture_t *next;
+  size_t       bytes;     /* Estimated GPU size from the format and size. */
+  int32_t      refs;      /* Stds_LoadTexture references not yet released. */
+  uint32_t     last_used; /* Texture frame it was last resolved in. */
 };
 
 /*
  *
  */
+struct glyph_t {
+  int32_t region;  /* Region in the font's glyph atlas, -1 if not provided. */
+  int32_t advance; /* Horizontal pen advance in pixels. */
+};
+
 struct font_t {
   char     name[MAX_FILE_NAME_LEN];
   uint16_t size;
 
   TTF_Font *font;
 
-  struct font_t *next;
+  /* Glyph cache for printable ASCII, built on the first draw with this font. */
+  struct atlas_t *glyph_atlas;
+  struct glyph_t  glyphs[STDS_GLYPH_COUNT];
+
+  /* File contents the font reads from, if opened by Stds_AddFontFromMemory. */
+  void *file_data;
 };
 
 /*
@@ -271,6 +1192,38 @@ struct delegate_t {
   void ( *draw )( void );
 };
 
+/*
+ * A scene: the delegate that runs while it is on top of the scene stack,
+ * and the scope of textures it holds references to. preload queues the
+ * scene's assets, enter and leave run as it is pushed and popped, and data
+ * is left to the game. pending holds loader requests not yet finished.
+ */
+struct scene_t {
+  struct delegate_t delegate;
+  void ( *preload )( struct scene_t *scene );
+  void ( *enter )( struct scene_t *scene );
+  void ( *leave )( struct scene_t *scene );
+  void *data;
+
+  int32_t *textures;
+  int32_t  texture_count;
+  int32_t  texture_capacity;
+
+  int32_t *pending;
+  int32_t  pending_count;
+  int32_t  pending_capacity;
+
+  bool is_preloaded;
+};
+
+/*
+ * Stack of active scenes; the top one is g_app.delegate.
+ */
+struct scene_stack_t {
+  struct scene_t *scenes[STDS_SCENE_STACK_SIZE];
+  int32_t         count;
+};
+
 /*
  *
  */
@@ -282,6 +1235,214 @@ struct mouse_t {
   bool    is_moving;
 };
 
+/*
+ * A xoshiro128+ random number generator. s is the state of the scalar
+ * stream; lanes holds STDS_RNG_LANES more streams, word-major, that batch
+ * fills step side by side in vector registers.
+ */
+struct rng_t {
+  uint32_t s[4];
+  uint32_t lanes[4][STDS_RNG_LANES];
+};
+
+/*
+ * Generator owned by one thread. generation is the Stds_SeedRandom call it
+ * was seeded after, and index the order in which its thread first used one.
+ */
+struct thread_rng_t {
+  struct rng_t rng;
+  int32_t      index;
+  int32_t      generation;
+};
+
+/*
+ * State of the input recorder and player. While recording, the events of the
+ * current frame collect in events and are written when the frame ends. While
+ * replaying, rw reads frames from the loaded file in data.
+ */
+struct input_replay_t {
+  SDL_RWops *file;
+  SDL_Event *events;
+  int32_t    event_count;
+  int32_t    event_capacity;
+  double     frame_time;
+
+  uint8_t *  data;
+  SDL_RWops *rw;
+  Sint64     size;
+  uint32_t   events_left;
+  int32_t    mouse_x;
+  int32_t    mouse_y;
+  bool       is_frame_open;
+  bool       is_quit_at_end;
+};
+
+/*
+ * SDL event stamped with the performance counter when it was taken from SDL.
+ */
+struct input_event_t {
+  SDL_Event event;
+  uint64_t  time;
+};
+
+/*
+ * Single-producer, single-consumer event ring. The input thread writes head
+ * and the simulation writes tail; both only grow and wrap into events. They
+ * sit on separate cache lines so the two threads do not share one.
+ */
+struct input_ring_t {
+  SDL_atomic_t head;
+  char         head_pad[64 - sizeof( SDL_atomic_t )];
+  SDL_atomic_t tail;
+  char         tail_pad[64 - sizeof( SDL_atomic_t )];
+
+  struct input_event_t events[STDS_INPUT_RING_SIZE];
+};
+
+/*
+ * Input thread state. last_time is the time of the event polled last.
+ */
+struct input_thread_t {
+  SDL_Thread *        thread;
+  SDL_atomic_t        is_running;
+  uint64_t            last_time;
+  struct input_ring_t ring;
+};
+
+/*
+ * Input snapshot of one frame. Key sets are bitsets indexed by scancode, and
+ * bit n of a button set is mouse button n. pressed and released collect the
+ * edges of every event since the previous frame, so a tap that goes down and
+ * up within one frame shows in both. focus is the text field receiving text.
+ */
+struct input_t {
+  uint64_t             keys[STDS_KEY_WORDS];
+  uint64_t             previous[STDS_KEY_WORDS];
+  uint64_t             pressed[STDS_KEY_WORDS];
+  uint64_t             released[STDS_KEY_WORDS];
+  uint32_t             buttons;
+  uint32_t             buttons_pressed;
+  uint32_t             buttons_released;
+  int32_t              mouse_dx;
+  int32_t              mouse_dy;
+  struct text_field_t *focus;
+};
+
+/*
+ * One completed profiler scope, kept for trace export. Times are raw
+ * performance-counter ticks.
+ */
+struct profiler_event_t {
+  int32_t  scope;
+  int32_t  depth;
+  uint64_t start;
+  uint64_t end;
+  bool     is_job; /* Timed on a job thread and added with Stds_ProfilerAddJobScope. */
+};
+
+/*
+ * Frame profiler state. scope_ms holds, for each of the last
+ * STDS_PROFILER_FRAMES frames, the total milliseconds spent in every scope.
+ */
+struct profiler_t {
+  char    scope_names[STDS_PROFILER_MAX_SCOPES][SMALL_TEXT_BUFFER];
+  int32_t scope_count;
+
+  float   scope_ms[STDS_PROFILER_FRAMES][STDS_PROFILER_MAX_SCOPES];
+  int32_t frame_index;
+  int32_t frame_count;
+
+  int32_t  stack_scope[STDS_PROFILER_MAX_DEPTH];
+  uint64_t stack_start[STDS_PROFILER_MAX_DEPTH];
+  int32_t  depth;
+
+  struct profiler_event_t events[STDS_PROFILER_MAX_EVENTS];
+  int32_t                 event_head;
+  int32_t                 event_count;
+
+  uint64_t frequency;
+  uint64_t origin;
+
+  const char *font_path;
+  uint16_t    font_size;
+};
+
+/*
+ * Frame-time histogram with HDR-style buckets: exact below
+ * 2^STDS_TELEMETRY_SUB_BITS microseconds, then 2^STDS_TELEMETRY_SUB_BITS
+ * buckets per power of two, so every bucket is within 1/16 of its values.
+ */
+struct frame_histogram_t {
+  uint32_t counts[STDS_TELEMETRY_BUCKETS];
+  uint64_t count;
+  uint64_t sum_us;
+  uint32_t max_us;
+};
+
+/*
+ * Object whose live count telemetry reports; type is one of the
+ * STDS_TELEMETRY_PARTICLES, _ENTITIES or _ENTITY_POOL constants.
+ */
+struct telemetry_watch_t {
+  int32_t     type;
+  const void *object;
+};
+
+/*
+ * Telemetry state. session covers every frame since Stds_StartTelemetry and
+ * interval only those since the last export. Times are counter ticks.
+ */
+struct telemetry_t {
+  SDL_RWops *rw;
+  int32_t    format;
+
+  uint64_t frequency;
+  uint64_t start;
+  uint64_t previous;
+  uint64_t next_export;
+  uint64_t export_ticks;
+
+  struct frame_histogram_t session;
+  struct frame_histogram_t interval;
+
+  struct telemetry_watch_t watched[STDS_TELEMETRY_MAX_WATCHED];
+  int32_t                  watch_count;
+};
+
+/*
+ * State of the fixed-timestep loop. Times are in seconds and read from the
+ * high-resolution performance counter.
+ */
+struct game_clock_t {
+  uint64_t frequency;
+  uint64_t previous;
+  uint64_t fps_start;
+  uint32_t fps_frames;
+
+  double   fixed_dt;       /* Simulation step; 0 selects the legacy lockstep loop. */
+  double   accumulator;    /* Unsimulated time carried into the next frame. */
+  double   max_frame_time; /* Longer frames are clamped to avoid a spiral of death. */
+  uint32_t max_updates;    /* Most update steps run per rendered frame. */
+
+  /* How far the render is between the last two updates, in [0, 1). Draw
+     delegates interpolate with prev + ( curr - prev ) * alpha. */
+  float alpha;
+};
+
+/*
+ * Which subsystems Stds_InitGameWithConfig starts, and how. Fonts not started
+ * up front start at the first font added, image formats not in image_formats
+ * load on first use, and audio without STDS_INIT_AUDIO or STDS_INIT_LAZY_AUDIO
+ * stays off, so loading and playing sounds does nothing.
+ */
+struct init_config_t {
+  uint32_t subsystems;      /* STDS_INIT_* flags. */
+  int32_t  image_formats;   /* IMG_INIT_* flags passed to IMG_Init, or 0 to skip it. */
+  int32_t  audio_frequency; /* Output rate in Hz. */
+  int32_t  audio_channels;
+  int32_t  audio_buffer;
+};
+
 /**
  * The app_t structure has all the components and pieces of a game with
  * C-Standards. Input, status, bounds, the renderer, camera, and other 
@@ -298,28 +1459,106 @@ struct app_t {
 
   bool        is_debug_mode;
   bool        is_running;
+  bool        is_headless;
+  bool        is_redraw_on_demand; /* Only draw frames after Stds_RequestRedraw. */
+  bool        is_redraw_requested;
   const char *original_title;
 
+  struct init_config_t init_config;
+
   SDL_Renderer *renderer;
   SDL_Window *  window;
+  SDL_Surface * headless_target; /* Software render target when there is no window. */
+  uint32_t      target_resets;   /* Times render targets lost their contents. */
   SDL_FRect     screen_bounds;
   SDL_FRect     camera;
 
   struct mouse_t               mouse;
+  struct input_t               input;
   struct delegate_t            delegate;
   struct trail_t               trail_head, *trail_tail;
-  struct texture_t             texture_head, *texture_tail;
-  struct font_t                font_head, *font_tail;
   struct parallax_background_t parallax_head, *parallax_tail;
   struct button_t              button_head, *button_tail;
   struct text_field_t          text_field_head, *text_field_tail;
 
+  /* Loaded fonts, keyed by "path:size", holding struct font_t pointers. */
+  struct stds_hashmap_t *fonts;
+
+  /* Texture cache: a dense array of entries plus an open-addressing table of
+     indices into it (-1 marks an empty slot). The table size is a power of two.
+     texture_handles maps each resident SDL_Texture pointer back to its index. */
+  struct texture_t *     textures;
+  int32_t                texture_count;
+  int32_t                texture_capacity;
+  int32_t *              texture_table;
+  int32_t                texture_table_size;
+  struct stds_hashmap_t *texture_handles;
+  size_t            texture_bytes;  /* Estimated size of every resident texture. */
+  size_t            texture_budget; /* Resident size above which idle ones are evicted. */
+  uint32_t          texture_frame;  /* Presented frames, for texture_t.last_used. */
+
+  struct game_clock_t clock;
+
   enum GameState game_state;
 
   Mix_Chunk **sounds;
   Mix_Music * music;
 };
 
+/*
+ * Playback limits of one sound effect. last_frame is one past the frame it
+ * was last triggered in, so that zeroed entries count as never played.
+ */
+struct sfx_info_t {
+  int16_t  max_voices;
+  int16_t  priority;
+  uint32_t last_frame;
+};
+
+/*
+ * What a mixer channel was last asked to play. started orders voices by age.
+ */
+struct sfx_voice_t {
+  int16_t  id;
+  int16_t  priority;
+  uint32_t started;
+};
+
+/*
+ * Voice manager state: the limits of every sound effect and the voice on
+ * every mixer channel.
+ */
+struct voice_manager_t {
+  struct sfx_info_t  sounds[SND_MAX];
+  struct sfx_voice_t voices[MAX_SND_CHANNELS];
+  uint32_t           frame;
+  uint32_t           sequence;
+};
+
+/*
+ * A sound effect registered for lazy decoding. bytes keeps the encoded file;
+ * the chunk in g_app.sounds is decoded from it on first play, and may be
+ * freed again when it has not played for a while and audio is over budget.
+ */
+struct sfx_asset_t {
+  uint8_t *bytes;
+  size_t   size;
+  size_t   decoded_size;
+  uint32_t last_used;
+  bool     is_pinned;
+};
+
+/*
+ * Residency state of the lazily decoded sound effects. resident counts the
+ * decoded bytes of those sounds only; eagerly loaded ones are never evicted.
+ */
+struct sound_registry_t {
+  struct sfx_asset_t assets[SND_MAX];
+  size_t             resident;
+  size_t             budget;
+  uint32_t           clock;
+};
+
 /*
  *
  */
@@ -335,6 +1574,63 @@ struct fade_color_t {
 /*
  *
  */
+/*
+ * Position, scale and rotation of a registry entity. angle is in degrees.
+ */
+struct entity_transform_t {
+  struct vec2_t pos;
+  struct vec2_t scale;
+  float         angle;
+};
+
+/*
+ * Entity storage with packed component arrays. Element i of transforms,
+ * velocities, bounds, cold and ids all belong to the i-th live entity, and
+ * the live entities are always [0, count), so systems walk the arrays
+ * linearly. bounds are relative to the entity's position. cold holds
+ * cold_size bytes per entity for data that systems rarely touch.
+ *
+ * Entities are grouped by type: each type's entities form one contiguous
+ * range, and the ranges follow each other in type order. Type 0 is the
+ * default type, which has no kernels.
+ *
+ * Entities are referred to by ids: the low STDS_ENTITY_INDEX_BITS bits
+ * pick a slot in the sparse arrays and the rest is that slot's generation,
+ * so an id goes stale once its entity is destroyed.
+ */
+struct entity_registry_t {
+  struct entity_transform_t *transforms;
+  struct vec2_t *            velocities;
+  SDL_FRect *                bounds;
+  uint8_t *                  cold;
+  uint32_t *                 ids;
+  size_t                     cold_size;
+  uint32_t                   count;
+  uint32_t                   capacity;
+
+  uint32_t *dense_of;    /* Slot -> index into the packed arrays. */
+  uint16_t *generations; /* Slot -> current generation. */
+  uint32_t *free_slots;
+  uint32_t  free_count;
+  uint32_t  slot_count;
+
+  struct entity_type_t *types;
+  uint32_t              type_count;
+};
+
+/*
+ * An entity type in a registry: the packed range [first, first + count)
+ * holding its entities, and the kernels that update and draw the whole
+ * range in one call. Either kernel may be NULL.
+ */
+struct entity_type_t {
+  uint32_t first;
+  uint32_t count;
+
+  void ( *update_batch )( struct entity_registry_t *reg, uint32_t first, uint32_t count );
+  void ( *draw_batch )( struct entity_registry_t *reg, uint32_t first, uint32_t count );
+};
+
 struct entity_t {
   struct vec2_t pos;
 
@@ -386,4 +1682,17 @@ struct entity_t {
   void ( *die )( struct entity_t * );
 };
 
+/*
+ * Fixed set of entity_t slots that are acquired and released instead of
+ * allocated and freed. A released slot keeps its bounding box and animation
+ * for the next entity acquired from it.
+ */
+struct entity_pool_t {
+  struct entity_t *entities;
+  uint32_t *       free_slots;
+  bool *           is_acquired;
+  uint32_t         free_count;
+  uint32_t         capacity;
+};
+
 #endif // STRUCTS_H
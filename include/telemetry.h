@@ -0,0 +1,26 @@
+#ifndef TELEMETRY_H
+#define TELEMETRY_H
+
+#include "../lib/structures/include/stds_arena.h"
+#include "../lib/structures/include/stds_hashmap.h"
+#include "../lib/structures/include/stds_pool.h"
+#include "stds.h"
+
+extern struct app_t g_app;
+
+extern bool Stds_StartTelemetry( SDL_RWops *rw, const int32_t format,
+                                 const float interval_seconds );
+
+extern void Stds_StopTelemetry( void );
+
+extern void Stds_TelemetryFrame( void );
+
+extern void Stds_TelemetryExport( void );
+
+extern void Stds_TelemetryWatch( const int32_t type, const void *object );
+
+extern void Stds_TelemetryUnwatch( const void *object );
+
+extern float Stds_TelemetryPercentile( const float percentile );
+
+#endif // TELEMETRY_H
@@ -11,9 +11,25 @@ extern void Stds_FreeFonts( void );
 
 extern void Stds_AddFont( const char *f, const uint16_t s );
 
+extern void Stds_AddFontFromMemory( const char *font_file, const uint16_t size, void *data,
+                                    const size_t data_size );
+
 extern void Stds_DrawText( const float x, const float y, const char *font_directory,
                            const uint16_t font_size, const SDL_Color *c, const char *str, ... );
 
+extern struct text_t *Stds_TextCreate( const char *font_path, const uint16_t font_size,
+                                      const SDL_Color *c, const char *text );
+
+extern void Stds_TextSet( struct text_t *t, const char *text );
+
+extern void Stds_TextSetColor( struct text_t *t, const SDL_Color *c );
+
+extern void Stds_TextSetFont( struct text_t *t, const char *font_path, const uint16_t font_size );
+
+extern void Stds_TextDraw( struct text_t *t, const float x, const float y );
+
+extern void Stds_TextDie( struct text_t *t );
+
 extern void Stds_GetStringSize( const char *str, const char *font_name, const uint16_t font_size,
                                 int32_t *stored_width, int32_t *stored_height );
 
@@ -1,6 +1,7 @@
 #ifndef TEXT_FIELD_H
 #define TEXT_FIELD_H
 
+#include "../lib/structures/include/stds_pool.h"
 #include "draw.h"
 #include "stds.h"
 #include "text.h"
@@ -18,8 +19,12 @@ extern void Stds_AlterTextField( struct text_field_t *tf, float x, float y, char
 
 extern void Stds_ToggleTextField( struct text_field_t *tf, bool can_read_text );
 
+extern void Stds_FocusTextField( struct text_field_t *tf );
+
 extern void Stds_ReadTextField( struct text_field_t *tf, const SDL_Event *event );
 
 extern void Stds_DrawTextField( struct text_field_t *tf );
 
+extern void Stds_TextFieldDie( struct text_field_t *tf );
+
 #endif // TEXT_FIELD_H
\ No newline at end of file
@@ -0,0 +1,30 @@
+#ifndef TILEMAP_H
+#define TILEMAP_H
+
+#include "stds.h"
+
+extern struct app_t g_app;
+
+extern struct tilemap_t *Stds_LoadTilemap( const char *file_path );
+
+extern bool Stds_SaveTilemap( const char *file_path, const uint32_t cols, const uint32_t rows,
+                              const uint32_t tile_w, const uint32_t tile_h,
+                              const uint32_t chunk_size, const uint16_t *tiles,
+                              const uint8_t *flags );
+
+extern void Stds_SetTilemapSpriteSheet( struct tilemap_t *map, SDL_Texture *sprite_sheet,
+                                        const uint32_t sheet_cols );
+
+extern void Stds_StreamTilemap( struct tilemap_t *map, const uint32_t margin );
+
+extern void Stds_DrawTilemap( struct tilemap_t *map );
+
+extern uint16_t Stds_GetTilemapTile( struct tilemap_t *map, const uint32_t col,
+                                     const uint32_t row );
+
+extern uint8_t Stds_GetTilemapFlags( struct tilemap_t *map, const uint32_t col,
+                                     const uint32_t row );
+
+extern void Stds_FreeTilemap( struct tilemap_t *map );
+
+#endif // TILEMAP_H
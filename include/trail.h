@@ -1,6 +1,7 @@
 #ifndef TRAIL_H
 #define TRAIL_H
 
+#include "../lib/structures/include/stds_pool.h"
 #include "draw.h"
 #include "stds.h"
 #include "vec2.h"
@@ -19,4 +20,24 @@ extern void Stds_TrailUpdate( struct trail_t *t );
 
 extern void Stds_TrailDraw( struct trail_t *t );
 
+extern void Stds_TrailDie( struct trail_t *t );
+
+extern struct trail_emitter_t *Stds_CreateTrailEmitter( const int32_t capacity,
+                                                        const int16_t alpha_decay_rate,
+                                                        const uint32_t flags, const SDL_Color *color );
+
+extern void Stds_EmitTrail( struct trail_emitter_t *e, const float x, const float y, const float w,
+                            const float h, SDL_Texture *texture, const SDL_RendererFlip flip );
+
+extern void Stds_EmitEntityTrail( struct trail_emitter_t *e, const struct entity_t *parent,
+                                  const SDL_RendererFlip flip );
+
+extern void Stds_UpdateTrailEmitter( struct trail_emitter_t *e );
+
+extern void Stds_DrawTrailEmitter( const struct trail_emitter_t *e );
+
+extern void Stds_ClearTrailEmitter( struct trail_emitter_t *e );
+
+extern void Stds_TrailEmitterDie( struct trail_emitter_t *e );
+
 #endif // TRAIL_H
\ No newline at end of file
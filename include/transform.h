@@ -0,0 +1,44 @@
+#ifndef TRANSFORM_H
+#define TRANSFORM_H
+
+#include "stds.h"
+#include "vec2.h"
+
+extern struct app_t g_app;
+
+extern struct transform_t Stds_TransformIdentity( void );
+
+extern struct transform_t Stds_TransformTranslation( const float x, const float y );
+
+extern struct transform_t Stds_TransformFromTRS( const float x, const float y, const float angle,
+                                                 const float sx, const float sy );
+
+extern struct transform_t Stds_TransformCompose( const struct transform_t *parent,
+                                                 const struct transform_t *child );
+
+extern bool Stds_TransformInvert( const struct transform_t *m, struct transform_t *out );
+
+extern struct vec2_t Stds_TransformPoint( const struct transform_t *m, const struct vec2_t *p );
+
+extern struct transform_t Stds_CameraTransform( void );
+
+extern struct transform_node_t *Stds_CreateTransformNode( struct transform_node_t *parent );
+
+extern void Stds_SetTransformNodeParent( struct transform_node_t *node,
+                                         struct transform_node_t *parent );
+
+extern void Stds_SetTransformNodePosition( struct transform_node_t *node, const float x,
+                                           const float y );
+
+extern void Stds_SetTransformNodeAngle( struct transform_node_t *node, const float angle );
+
+extern void Stds_SetTransformNodeScale( struct transform_node_t *node, const float sx,
+                                        const float sy );
+
+extern const struct transform_t *Stds_GetWorldTransform( struct transform_node_t *node );
+
+extern struct vec2_t Stds_GetTransformNodeWorldPosition( struct transform_node_t *node );
+
+extern void Stds_TransformNodeDie( struct transform_node_t *node );
+
+#endif // TRANSFORM_H
@@ -0,0 +1,33 @@
+#ifndef UI_LAYER_H
+#define UI_LAYER_H
+
+#include "button.h"
+#include "command_buffer.h"
+#include "draw.h"
+#include "game.h"
+#include "stds.h"
+#include "text_field.h"
+
+extern struct app_t g_app;
+
+extern struct ui_layer_t *Stds_CreateUILayer( const int32_t w, const int32_t h,
+                                              const SDL_Color *background );
+
+extern void Stds_UILayerAddButton( struct ui_layer_t *layer, struct button_t *button );
+
+extern void Stds_UILayerAddTextField( struct ui_layer_t *layer, struct text_field_t *tf );
+
+extern void Stds_UILayerAddCustom( struct ui_layer_t *layer, const SDL_Rect *rect,
+                                   void ( *draw )( void * ), void *data );
+
+extern void Stds_UILayerRemove( struct ui_layer_t *layer, const void *widget );
+
+extern void Stds_UILayerInvalidate( struct ui_layer_t *layer, const SDL_Rect *rect );
+
+extern void Stds_UILayerUpdate( struct ui_layer_t *layer );
+
+extern bool Stds_UILayerDraw( struct ui_layer_t *layer );
+
+extern void Stds_UILayerDie( struct ui_layer_t *layer );
+
+#endif // UI_LAYER_H
@@ -29,4 +29,21 @@ extern void Stds_MultiplyToVec2( struct vec2_t *v, const float multiply );
 
 extern void Stds_DivideToVec2( struct vec2_t *v, const float divide );
 
+extern void Stds_AddVec2Array( struct vec2_t *out, const struct vec2_t *u, const struct vec2_t *v,
+                               const int32_t n );
+
+extern void Stds_ScaleVec2Array( struct vec2_t *out, const struct vec2_t *v, const float scale,
+                                 const int32_t n );
+
+extern void Stds_RotateVec2Array( struct vec2_t *out, const struct vec2_t *v, const float angle,
+                                  const int32_t n );
+
+extern void Stds_NormalizeVec2Array( struct vec2_t *out, const struct vec2_t *v, const int32_t n );
+
+extern void Stds_DotVec2Array( float *out, const struct vec2_t *u, const struct vec2_t *v,
+                               const int32_t n );
+
+extern void Stds_TransformVec2Array( struct vec2_t *out, const struct vec2_t *v,
+                                     const struct transform_t *m, const int32_t n );
+
 #endif
\ No newline at end of file
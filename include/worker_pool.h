@@ -0,0 +1,13 @@
+#ifndef WORKER_POOL_H
+#define WORKER_POOL_H
+
+#include "stds.h"
+
+extern struct worker_pool_t *Stds_CreateWorkerPool( int32_t thread_count );
+
+extern void Stds_WorkerPoolRun( struct worker_pool_t *pool, void ( *job )( void *, int32_t ),
+                                void *data, const int32_t job_count );
+
+extern void Stds_WorkerPoolDie( struct worker_pool_t *pool );
+
+#endif // WORKER_POOL_H
@@ -0,0 +1,22 @@
+#ifndef STDS_ARENA_H
+#define STDS_ARENA_H
+
+#include "../../../include/stds.h"
+
+#include "stds_data.h"
+
+typedef struct stds_arena_t stds_arena_t;
+
+extern struct stds_arena_t *Stds_ArenaCreate( size_t capacity );
+
+extern void *Stds_ArenaAlloc( struct stds_arena_t *arena, size_t size );
+
+extern void Stds_ArenaReset( struct stds_arena_t *arena );
+
+extern size_t Stds_ArenaUsed( const struct stds_arena_t *arena );
+
+extern size_t Stds_ArenaTotalBytes( void );
+
+extern void Stds_ArenaDestroy( struct stds_arena_t *arena );
+
+#endif // STDS_ARENA_H
@@ -4,6 +4,14 @@
 #include "../../../include/stds.h"
 
 #define STDS_STATIC_MIN_CAP 10
+#define STDS_ALLOC_ALIGNMENT 16
+#define STDS_QUEUE_MIN_CAP   16 /* Must be a power of two. */
+#define STDS_HEAP_BINARY     2
+#define STDS_HEAP_QUATERNARY 4  /* Shallower; a node's children share cache lines. */
+#define STDS_HASHMAP_STRING_KEYS 0
+#define STDS_HASHMAP_INT_KEYS    1
+#define STDS_HASHMAP_MIN_CAP     16 /* Must be a power of two. */
+#define STDS_HASHMAP_INLINE_MAX  32 /* Larger values live out of line so probing moves less. */
 
 enum SHIFT_DIRECTION { LEFT, RIGHT };
 
@@ -0,0 +1,35 @@
+#ifndef STDS_HASHMAP_H
+#define STDS_HASHMAP_H
+
+#include "../../../include/stds.h"
+
+#include "stds_data.h"
+
+typedef struct stds_hashmap_t stds_hashmap_t;
+
+extern struct stds_hashmap_t *Stds_HashMapCreate( size_t value_size, uint32_t key_type );
+
+extern void *Stds_HashMapPut( struct stds_hashmap_t *map, const char *key, const void *value );
+
+extern void *Stds_HashMapPutInt( struct stds_hashmap_t *map, uint64_t key, const void *value );
+
+extern void *Stds_HashMapGet( const struct stds_hashmap_t *map, const char *key );
+
+extern void *Stds_HashMapGetInt( const struct stds_hashmap_t *map, uint64_t key );
+
+extern bool Stds_HashMapRemove( struct stds_hashmap_t *map, const char *key );
+
+extern bool Stds_HashMapRemoveInt( struct stds_hashmap_t *map, uint64_t key );
+
+extern void Stds_HashMapReserve( struct stds_hashmap_t *map, size_t n );
+
+extern bool Stds_HashMapNext( const struct stds_hashmap_t *map, size_t *iterator,
+                              const void **key, void **value );
+
+extern size_t Stds_HashMapSize( const struct stds_hashmap_t *map );
+
+extern void Stds_HashMapClear( struct stds_hashmap_t *map );
+
+extern void Stds_HashMapDestroy( struct stds_hashmap_t *map );
+
+#endif // STDS_HASHMAP_H
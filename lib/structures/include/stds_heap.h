@@ -7,12 +7,33 @@
 
 typedef struct stds_heap_t stds_heap_t;
 
-extern void Stds_HeapCreate( struct stds_heap_t *s );
+/* Returns negative if a should come out of the heap before b, positive if
+   after, and zero if either order is fine (same contract as qsort). */
+typedef int ( *stds_heap_compare_t )( const void *a, const void *b );
 
-extern void Stds_HeapInsert( struct stds_heap_t *s, void *data );
+extern struct stds_heap_t *Stds_HeapCreate( size_t element_size, stds_heap_compare_t compare,
+                                            uint32_t arity );
 
-extern void *Stds_HeapExtractRoot( struct stds_heap_t *s );
+extern int32_t Stds_HeapInsert( struct stds_heap_t *h, const void *data );
 
-extern void Stds_HeapClear( struct stds_heap_t *s );
+extern void Stds_HeapExtractRoot( struct stds_heap_t *h, void *out );
 
-#endif // STDS_HEAP_H
\ No newline at end of file
+extern void *Stds_HeapPeek( struct stds_heap_t *h );
+
+extern void Stds_HeapDecreaseKey( struct stds_heap_t *h, int32_t handle, const void *data );
+
+extern bool Stds_HeapContains( const struct stds_heap_t *h, int32_t handle );
+
+extern void *Stds_HeapGet( struct stds_heap_t *h, int32_t handle );
+
+extern void Stds_HeapHeapify( struct stds_heap_t *h, const void *data, size_t n );
+
+extern size_t Stds_HeapSize( const struct stds_heap_t *h );
+
+extern bool Stds_HeapIsEmpty( const struct stds_heap_t *h );
+
+extern void Stds_HeapClear( struct stds_heap_t *h );
+
+extern void Stds_HeapDestroy( struct stds_heap_t *h );
+
+#endif // STDS_HEAP_H
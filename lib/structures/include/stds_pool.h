@@ -0,0 +1,24 @@
+#ifndef STDS_POOL_H
+#define STDS_POOL_H
+
+#include "../../../include/stds.h"
+
+#include "stds_data.h"
+
+typedef struct stds_pool_t stds_pool_t;
+
+extern struct stds_pool_t *Stds_PoolCreate( size_t element_size, size_t block_elements );
+
+extern void *Stds_PoolAlloc( struct stds_pool_t *pool );
+
+extern void Stds_PoolFree( struct stds_pool_t *pool, void *element );
+
+extern size_t Stds_PoolSize( const struct stds_pool_t *pool );
+
+extern size_t Stds_PoolTotalBytes( void );
+
+extern void Stds_PoolClear( struct stds_pool_t *pool );
+
+extern void Stds_PoolDestroy( struct stds_pool_t *pool );
+
+#endif // STDS_POOL_H
@@ -5,26 +5,19 @@
 
 #include "stds_data.h"
 
-typedef struct stds_queue_t      stds_queue_t;
-typedef struct stds_queue_node_t stds_queue_node_t;
-
-/**
- *
- */
-struct stds_queue_node_t {
-  void *data;
-  void *next;
-};
+typedef struct stds_queue_t stds_queue_t;
 
 extern struct stds_queue_t *Stds_QueueCreate( size_t element_size );
 
-extern void Stds_QueueAdd( struct stds_queue_t *q, void *data );
+extern void Stds_QueueAdd( struct stds_queue_t *q, const void *data );
+
+extern void Stds_QueueAddN( struct stds_queue_t *q, const void *data, size_t n );
 
-extern void *Stds_QueuePoll( struct stds_queue_t *q );
+extern void Stds_QueuePoll( struct stds_queue_t *q, void *out );
 
 extern void Stds_QueueClear( struct stds_queue_t *q );
 
-extern struct stds_queue_node_t *Stds_QueueIterator( struct stds_queue_t *q );
+extern void *Stds_QueueGet( struct stds_queue_t *q, size_t index );
 
 extern void *Stds_QueuePeek( struct stds_queue_t *q );
 
@@ -15,8 +15,14 @@ extern void Stds_VectorInsert( struct stds_vector_t *v, ssize_t index, void *dat
 
 extern void *Stds_VectorGet( const struct stds_vector_t *v, ssize_t index );
 
+extern void *Stds_VectorData( const struct stds_vector_t *v );
+
 extern void Stds_VectorRemove( struct stds_vector_t *v, ssize_t index );
 
+extern void Stds_VectorReserve( struct stds_vector_t *v, size_t capacity );
+
+extern void Stds_VectorShrinkToFit( struct stds_vector_t *v );
+
 extern void Stds_VectorSwap( struct stds_vector_t *v, size_t first, size_t second );
 
 extern bool Stds_VectorIsEmpty( const struct stds_vector_t *v );
@@ -0,0 +1,223 @@
+/**
+ * @file stds_arena.c
+ * @author Joshua Crotts
+ * @date October 14 2026
+ * @version 1.0
+ *
+ * @section LICENSE
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License as
+ * published by the Free Software Foundation; either version 2 of
+ * the License, or (at your option) any later version.
+ *
+ * @section DESCRIPTION
+ *
+ * This file defines the functions for a bump (arena) allocator. Allocations
+ * advance an offset into a block and are never freed individually; the whole
+ * arena is reset at once, which suits data that only lives for one frame.
+ */
+#include "../include/stds_arena.h"
+
+static struct stds_arena_block_t *Stds_ArenaNewBlock( size_t capacity );
+static void                       Stds_ArenaFreeBlock( struct stds_arena_block_t *b );
+
+/* Bytes held in blocks by every arena, for telemetry. Arenas may live on
+   different threads, so the total is guarded by a spinlock. */
+static size_t       arena_bytes;
+static SDL_SpinLock arena_bytes_lock;
+
+/**
+ * One block of arena memory. The bytes follow the header directly.
+ */
+struct stds_arena_block_t {
+  struct stds_arena_block_t *next;
+  size_t                     capacity;
+};
+
+/**
+ * Arena structure. Allocations come from the head block; when it runs out,
+ * a larger block is pushed in front of it. Resetting merges every block into
+ * one, so a steady per-frame workload settles on a single block.
+ */
+struct stds_arena_t {
+  size_t                     offset;
+  size_t                     total_capacity;
+  struct stds_arena_block_t *head;
+};
+
+/**
+ * Creates an arena with an initial block of the specified size in bytes.
+ *
+ * @param size_t initial capacity in bytes.
+ *
+ * @return stds_arena_t * pointer to the arena.
+ */
+stds_arena_t *
+Stds_ArenaCreate( size_t capacity ) {
+  stds_arena_t *arena;
+  arena = malloc( sizeof( stds_arena_t ) );
+
+  if ( arena == NULL ) {
+    fprintf( stderr, "Error: could not allocate memory for stds_arena_t!\n" );
+    exit( EXIT_FAILURE );
+  }
+
+  memset( arena, 0, sizeof( stds_arena_t ) );
+
+  if ( capacity < STDS_ALLOC_ALIGNMENT ) {
+    capacity = STDS_ALLOC_ALIGNMENT;
+  }
+
+  arena->head           = Stds_ArenaNewBlock( capacity );
+  arena->total_capacity = capacity;
+
+  return arena;
+}
+
+/**
+ * Allocates size bytes from the arena, aligned to STDS_ALLOC_ALIGNMENT. The
+ * memory is not zeroed, and stays valid until the next Stds_ArenaReset.
+ *
+ * @param stds_arena_t * pointer to the arena.
+ * @param size_t number of bytes.
+ *
+ * @return void * pointer to the memory.
+ */
+void *
+Stds_ArenaAlloc( struct stds_arena_t *arena, size_t size ) {
+  size = ( size + STDS_ALLOC_ALIGNMENT - 1 ) & ~( size_t )( STDS_ALLOC_ALIGNMENT - 1 );
+
+  if ( arena->offset + size > arena->head->capacity ) {
+    size_t capacity = arena->head->capacity * 2;
+
+    if ( capacity < size ) {
+      capacity = size;
+    }
+
+    struct stds_arena_block_t *b = Stds_ArenaNewBlock( capacity );
+    b->next                      = arena->head;
+    arena->head                  = b;
+    arena->offset                = 0;
+    arena->total_capacity += capacity;
+  }
+
+  void *p = ( uint8_t * ) ( arena->head + 1 ) + arena->offset;
+  arena->offset += size;
+
+  return p;
+}
+
+/**
+ * Releases every allocation at once. If the arena had to grow since the
+ * last reset, its blocks are replaced by one block as large as all of them.
+ *
+ * @param stds_arena_t * pointer to the arena.
+ *
+ * @return void.
+ */
+void
+Stds_ArenaReset( struct stds_arena_t *arena ) {
+  arena->offset = 0;
+
+  if ( arena->head->next == NULL ) {
+    return;
+  }
+
+  while ( arena->head != NULL ) {
+    struct stds_arena_block_t *next = arena->head->next;
+    Stds_ArenaFreeBlock( arena->head );
+    arena->head = next;
+  }
+
+  arena->head = Stds_ArenaNewBlock( arena->total_capacity );
+}
+
+/**
+ * Returns the number of bytes allocated from the head block since the last
+ * reset, including alignment padding.
+ *
+ * @param stds_arena_t * pointer to the arena.
+ *
+ * @return size_t bytes used.
+ */
+size_t
+Stds_ArenaUsed( const struct stds_arena_t *arena ) {
+  return arena->offset;
+}
+
+/**
+ * Returns the bytes held in blocks by every arena, allocated or not.
+ *
+ * @param void.
+ *
+ * @return size_t bytes reserved by arenas.
+ */
+size_t
+Stds_ArenaTotalBytes( void ) {
+  SDL_AtomicLock( &arena_bytes_lock );
+  const size_t bytes = arena_bytes;
+  SDL_AtomicUnlock( &arena_bytes_lock );
+
+  return bytes;
+}
+
+/**
+ * Frees the arena and all of its blocks.
+ *
+ * @param stds_arena_t * pointer to the arena.
+ *
+ * @return void.
+ */
+void
+Stds_ArenaDestroy( struct stds_arena_t *arena ) {
+  while ( arena->head != NULL ) {
+    struct stds_arena_block_t *next = arena->head->next;
+    Stds_ArenaFreeBlock( arena->head );
+    arena->head = next;
+  }
+
+  free( arena );
+}
+
+/**
+ * Allocates a block with room for capacity bytes after its header.
+ *
+ * @param size_t capacity in bytes.
+ *
+ * @return stds_arena_block_t * the block.
+ */
+static struct stds_arena_block_t *
+Stds_ArenaNewBlock( size_t capacity ) {
+  struct stds_arena_block_t *b = malloc( sizeof( struct stds_arena_block_t ) + capacity );
+
+  if ( b == NULL ) {
+    fprintf( stderr, "Error: could not allocate memory for stds_arena_t block!\n" );
+    exit( EXIT_FAILURE );
+  }
+
+  b->next     = NULL;
+  b->capacity = capacity;
+
+  SDL_AtomicLock( &arena_bytes_lock );
+  arena_bytes += capacity;
+  SDL_AtomicUnlock( &arena_bytes_lock );
+
+  return b;
+}
+
+/**
+ * Frees a block and takes it off the byte total.
+ *
+ * @param stds_arena_block_t * block to free.
+ *
+ * @return void.
+ */
+static void
+Stds_ArenaFreeBlock( struct stds_arena_block_t *b ) {
+  SDL_AtomicLock( &arena_bytes_lock );
+  arena_bytes -= b->capacity;
+  SDL_AtomicUnlock( &arena_bytes_lock );
+
+  free( b );
+}
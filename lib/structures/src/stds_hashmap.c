@@ -0,0 +1,596 @@
+/**
+ * @file stds_hashmap.c
+ * @author Joshua Crotts
+ * @date October 14 2026
+ * @version 1.0
+ *
+ * @section LICENSE
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License as
+ * published by the Free Software Foundation; either version 2 of
+ * the License, or (at your option) any later version.
+ *
+ * @section DESCRIPTION
+ *
+ * This file defines the functions for a hash map from string or integer keys
+ * to values stored by value. It uses open addressing with Robin Hood probing:
+ * an element being inserted takes the slot of any element closer to its home
+ * slot than itself, which keeps every probe sequence short and lets a failed
+ * lookup stop early. Removal shifts the following elements back instead of
+ * leaving tombstones.
+ */
+#include "../include/stds_hashmap.h"
+
+static uint32_t Stds_HashMapHashInt( uint64_t );
+static size_t   Stds_HashMapFind( const stds_hashmap_t *, uint32_t, uint64_t );
+static void *   Stds_HashMapInsert( stds_hashmap_t *, uint32_t, uint64_t, const void * );
+static size_t   Stds_HashMapPlace( stds_hashmap_t *, uint32_t, uint64_t );
+static void     Stds_HashMapRemoveAt( stds_hashmap_t *, size_t );
+static void     Stds_HashMapGrow( stds_hashmap_t *, size_t );
+static void *   Stds_HashMapValue( const stds_hashmap_t *, size_t );
+
+#define STDS_HASHMAP_NONE ( ( size_t ) -1 )
+
+/**
+ * Hash map structure. Slot i is empty when dists[i] is 0; otherwise
+ * dists[i] - 1 is how far the element sits past its home slot. keys hold
+ * the integer key, or for string maps a pointer to the map's copy of the
+ * key. Each values slot holds the value itself when it is small, or a
+ * pointer to it otherwise.
+ */
+struct stds_hashmap_t {
+  size_t    value_size;
+  size_t    value_stride;
+  size_t    logical_size;
+  size_t    capacity;
+  uint32_t  key_type;
+  bool      is_inline;
+  uint8_t * dists;
+  uint32_t *hashes;
+  uint64_t *keys;
+  uint8_t * values;
+  uint8_t * scratch;
+};
+
+/**
+ * Creates a hash map with the specified value type. To get the size, pass
+ * in sizeof(T). key_type is STDS_HASHMAP_STRING_KEYS or
+ * STDS_HASHMAP_INT_KEYS, and picks which of the Put/Get/Remove variants
+ * may be used with the map.
+ *
+ * @param size_t size of each value.
+ * @param uint32_t key type.
+ *
+ * @return stds_hashmap_t * pointer to the map.
+ */
+stds_hashmap_t *
+Stds_HashMapCreate( size_t value_size, uint32_t key_type ) {
+  stds_hashmap_t *map;
+  map = malloc( sizeof( stds_hashmap_t ) );
+
+  if ( map == NULL ) {
+    fprintf( stderr, "Error: could not allocate memory for stds_hashmap_t!\n" );
+    exit( EXIT_FAILURE );
+  }
+
+  memset( map, 0, sizeof( stds_hashmap_t ) );
+  map->value_size   = value_size;
+  map->key_type     = key_type;
+  map->is_inline    = value_size <= STDS_HASHMAP_INLINE_MAX;
+  map->value_stride = map->is_inline ? ( value_size + 7 ) & ~( size_t ) 7 : sizeof( void * );
+
+  if ( map->value_stride == 0 ) {
+    map->value_stride = sizeof( void * );
+  }
+
+  map->scratch = malloc( map->value_stride * 2 );
+
+  if ( map->scratch == NULL ) {
+    fprintf( stderr, "Error: could not allocate memory for stds_hashmap_t!\n" );
+    exit( EXIT_FAILURE );
+  }
+
+  Stds_HashMapGrow( map, STDS_HASHMAP_MIN_CAP );
+
+  return map;
+}
+
+/**
+ * Maps a string key to a copy of value, replacing any value it already
+ * had. The key is copied too.
+ *
+ * @param stds_hashmap_t * pointer to a string-keyed map.
+ * @param const char * key.
+ * @param void * pointer to the value to copy in.
+ *
+ * @return void * pointer to the stored value, valid until the next insert
+ *         or removal.
+ */
+void *
+Stds_HashMapPut( struct stds_hashmap_t *map, const char *key, const void *value ) {
+  if ( map->key_type != STDS_HASHMAP_STRING_KEYS ) {
+    fprintf( stderr, "Error! Cannot use a string key with an integer-keyed hash map.\n" );
+    exit( EXIT_FAILURE );
+  }
+
+  uint32_t hash = Stds_HashString( key );
+  size_t   i    = Stds_HashMapFind( map, hash, ( uint64_t )( uintptr_t ) key );
+
+  if ( i != STDS_HASHMAP_NONE ) {
+    memcpy( Stds_HashMapValue( map, i ), value, map->value_size );
+    return Stds_HashMapValue( map, i );
+  }
+
+  size_t length = strlen( key ) + 1;
+  char * copy   = malloc( length );
+
+  if ( copy == NULL ) {
+    fprintf( stderr, "Error: could not allocate memory for a stds_hashmap_t key!\n" );
+    exit( EXIT_FAILURE );
+  }
+
+  memcpy( copy, key, length );
+
+  return Stds_HashMapInsert( map, hash, ( uint64_t )( uintptr_t ) copy, value );
+}
+
+/**
+ * Maps an integer key to a copy of value, replacing any value it already
+ * had.
+ *
+ * @param stds_hashmap_t * pointer to an integer-keyed map.
+ * @param uint64_t key.
+ * @param void * pointer to the value to copy in.
+ *
+ * @return void * pointer to the stored value, valid until the next insert
+ *         or removal.
+ */
+void *
+Stds_HashMapPutInt( struct stds_hashmap_t *map, uint64_t key, const void *value ) {
+  if ( map->key_type != STDS_HASHMAP_INT_KEYS ) {
+    fprintf( stderr, "Error! Cannot use an integer key with a string-keyed hash map.\n" );
+    exit( EXIT_FAILURE );
+  }
+
+  uint32_t hash = Stds_HashMapHashInt( key );
+  size_t   i    = Stds_HashMapFind( map, hash, key );
+
+  if ( i != STDS_HASHMAP_NONE ) {
+    memcpy( Stds_HashMapValue( map, i ), value, map->value_size );
+    return Stds_HashMapValue( map, i );
+  }
+
+  return Stds_HashMapInsert( map, hash, key, value );
+}
+
+/**
+ * Looks up a string key.
+ *
+ * @param stds_hashmap_t * pointer to a string-keyed map.
+ * @param const char * key.
+ *
+ * @return void * pointer to the value, or NULL if the key is absent.
+ */
+void *
+Stds_HashMapGet( const struct stds_hashmap_t *map, const char *key ) {
+  size_t i = Stds_HashMapFind( map, Stds_HashString( key ), ( uint64_t )( uintptr_t ) key );
+  return i != STDS_HASHMAP_NONE ? Stds_HashMapValue( map, i ) : NULL;
+}
+
+/**
+ * Looks up an integer key.
+ *
+ * @param stds_hashmap_t * pointer to an integer-keyed map.
+ * @param uint64_t key.
+ *
+ * @return void * pointer to the value, or NULL if the key is absent.
+ */
+void *
+Stds_HashMapGetInt( const struct stds_hashmap_t *map, uint64_t key ) {
+  size_t i = Stds_HashMapFind( map, Stds_HashMapHashInt( key ), key );
+  return i != STDS_HASHMAP_NONE ? Stds_HashMapValue( map, i ) : NULL;
+}
+
+/**
+ * Removes a string key and its value.
+ *
+ * @param stds_hashmap_t * pointer to a string-keyed map.
+ * @param const char * key.
+ *
+ * @return bool true if the key was present.
+ */
+bool
+Stds_HashMapRemove( struct stds_hashmap_t *map, const char *key ) {
+  size_t i = Stds_HashMapFind( map, Stds_HashString( key ), ( uint64_t )( uintptr_t ) key );
+
+  if ( i == STDS_HASHMAP_NONE ) {
+    return false;
+  }
+
+  Stds_HashMapRemoveAt( map, i );
+  return true;
+}
+
+/**
+ * Removes an integer key and its value.
+ *
+ * @param stds_hashmap_t * pointer to an integer-keyed map.
+ * @param uint64_t key.
+ *
+ * @return bool true if the key was present.
+ */
+bool
+Stds_HashMapRemoveInt( struct stds_hashmap_t *map, uint64_t key ) {
+  size_t i = Stds_HashMapFind( map, Stds_HashMapHashInt( key ), key );
+
+  if ( i == STDS_HASHMAP_NONE ) {
+    return false;
+  }
+
+  Stds_HashMapRemoveAt( map, i );
+  return true;
+}
+
+/**
+ * Grows the table so that n elements fit without another resize.
+ *
+ * @param stds_hashmap_t * pointer to the map.
+ * @param size_t number of elements.
+ *
+ * @return void.
+ */
+void
+Stds_HashMapReserve( struct stds_hashmap_t *map, size_t n ) {
+  size_t capacity = map->capacity;
+
+  /* Keep the load factor at or below 4/5. */
+  while ( n * 5 > capacity * 4 ) {
+    capacity <<= 1;
+  }
+
+  if ( capacity != map->capacity ) {
+    Stds_HashMapGrow( map, capacity );
+  }
+}
+
+/**
+ * Steps through the elements in no particular order. Start with *iterator
+ * set to 0 and call until it returns false. The map must not be changed
+ * during iteration, except by overwriting the value.
+ *
+ * @param stds_hashmap_t * pointer to the map.
+ * @param size_t * iteration cursor.
+ * @param const void ** receives the key: the const char * for string maps,
+ *        or a pointer to the uint64_t for integer maps. May be NULL.
+ * @param void ** receives a pointer to the value. May be NULL.
+ *
+ * @return bool true if an element was returned.
+ */
+bool
+Stds_HashMapNext( const struct stds_hashmap_t *map, size_t *iterator, const void **key,
+                  void **value ) {
+  for ( size_t i = *iterator; i < map->capacity; i++ ) {
+    if ( map->dists[i] == 0 ) {
+      continue;
+    }
+
+    if ( key != NULL ) {
+      *key = map->key_type == STDS_HASHMAP_STRING_KEYS
+               ? ( const void * ) ( uintptr_t ) map->keys[i]
+               : ( const void * ) &map->keys[i];
+    }
+
+    if ( value != NULL ) {
+      *value = Stds_HashMapValue( map, i );
+    }
+
+    *iterator = i + 1;
+    return true;
+  }
+
+  *iterator = map->capacity;
+  return false;
+}
+
+/**
+ * Returns the number of elements in the map.
+ *
+ * @param stds_hashmap_t * pointer to the map.
+ *
+ * @return size_t logical size.
+ */
+size_t
+Stds_HashMapSize( const struct stds_hashmap_t *map ) {
+  return map->logical_size;
+}
+
+/**
+ * Removes every element. The table keeps its capacity.
+ *
+ * @param stds_hashmap_t * pointer to the map.
+ *
+ * @return void.
+ */
+void
+Stds_HashMapClear( struct stds_hashmap_t *map ) {
+  for ( size_t i = 0; i < map->capacity; i++ ) {
+    if ( map->dists[i] == 0 ) {
+      continue;
+    }
+
+    if ( map->key_type == STDS_HASHMAP_STRING_KEYS ) {
+      free( ( void * ) ( uintptr_t ) map->keys[i] );
+    }
+
+    if ( !map->is_inline ) {
+      free( *( void ** ) ( map->values + i * map->value_stride ) );
+    }
+  }
+
+  memset( map->dists, 0, map->capacity );
+  map->logical_size = 0;
+}
+
+/**
+ * Frees all associated memory with the map.
+ *
+ * @param stds_hashmap_t * pointer to the map.
+ *
+ * @return void.
+ */
+void
+Stds_HashMapDestroy( struct stds_hashmap_t *map ) {
+  Stds_HashMapClear( map );
+  free( map->dists );
+  free( map->hashes );
+  free( map->keys );
+  free( map->values );
+  free( map->scratch );
+  free( map );
+}
+
+/**
+ * Mixes an integer key into 32 bits (the splitmix64 finalizer), so keys
+ * that only differ in their high bits still spread over the table.
+ *
+ * @param uint64_t key.
+ *
+ * @return uint32_t hash.
+ */
+static uint32_t
+Stds_HashMapHashInt( uint64_t key ) {
+  key ^= key >> 30;
+  key *= 0xbf58476d1ce4e5b9ull;
+  key ^= key >> 27;
+  key *= 0x94d049bb133111ebull;
+  key ^= key >> 31;
+
+  return ( uint32_t ) key;
+}
+
+/**
+ * Finds the slot holding key. The probe stops as soon as it reaches an
+ * element closer to its home slot than the key would be, since Robin Hood
+ * insertion would have placed the key before it.
+ *
+ * @param stds_hashmap_t * pointer to the map.
+ * @param uint32_t hash of the key.
+ * @param uint64_t integer key, or pointer to the string key.
+ *
+ * @return size_t slot index, or STDS_HASHMAP_NONE.
+ */
+static size_t
+Stds_HashMapFind( const stds_hashmap_t *map, uint32_t hash, uint64_t key ) {
+  size_t mask = map->capacity - 1;
+  size_t i    = hash & mask;
+
+  for ( uint32_t dist = 1; map->dists[i] >= dist; dist++ ) {
+    if ( map->hashes[i] == hash ) {
+      if ( map->key_type == STDS_HASHMAP_INT_KEYS
+             ? map->keys[i] == key
+             : strcmp( ( const char * ) ( uintptr_t ) map->keys[i],
+                       ( const char * ) ( uintptr_t ) key ) == 0 ) {
+        return i;
+      }
+    }
+
+    i = ( i + 1 ) & mask;
+  }
+
+  return STDS_HASHMAP_NONE;
+}
+
+/**
+ * Inserts a key known to be absent, growing the table first if needed.
+ *
+ * @param stds_hashmap_t * pointer to the map.
+ * @param uint32_t hash of the key.
+ * @param uint64_t integer key, or pointer to the map's copy of the string.
+ * @param void * pointer to the value to copy in.
+ *
+ * @return void * pointer to the stored value.
+ */
+static void *
+Stds_HashMapInsert( stds_hashmap_t *map, uint32_t hash, uint64_t key, const void *value ) {
+  if ( ( map->logical_size + 1 ) * 5 > map->capacity * 4 ) {
+    Stds_HashMapGrow( map, map->capacity << 1 );
+  }
+
+  uint8_t *carry = map->scratch;
+
+  if ( map->is_inline ) {
+    memcpy( carry, value, map->value_size );
+  } else {
+    void *boxed = malloc( map->value_size );
+
+    if ( boxed == NULL ) {
+      fprintf( stderr, "Error: could not allocate memory for a stds_hashmap_t value!\n" );
+      exit( EXIT_FAILURE );
+    }
+
+    memcpy( boxed, value, map->value_size );
+    memcpy( carry, &boxed, sizeof( void * ) );
+  }
+
+  size_t i = Stds_HashMapPlace( map, hash, key );
+  map->logical_size++;
+
+  return Stds_HashMapValue( map, i );
+}
+
+/**
+ * Robin Hood placement of the element whose value slot is in scratch.
+ * Walking from the home slot, the element takes the first slot that is
+ * empty or whose element is closer to its own home; a displaced element
+ * carries on looking for a slot the same way. Does not touch logical_size.
+ *
+ * @param stds_hashmap_t * pointer to the map.
+ * @param uint32_t hash of the key.
+ * @param uint64_t integer key, or pointer to the map's copy of the string.
+ *
+ * @return size_t slot the element was placed in.
+ */
+static size_t
+Stds_HashMapPlace( stds_hashmap_t *map, uint32_t hash, uint64_t key ) {
+  /* The carried value lives in scratch, so swapping it with a resident is
+     three copies whatever the value size. */
+  uint8_t *carry  = map->scratch;
+  uint8_t *swap   = map->scratch + map->value_stride;
+  size_t   mask   = map->capacity - 1;
+  size_t   i      = hash & mask;
+  size_t   placed = STDS_HASHMAP_NONE;
+  uint32_t dist   = 1;
+
+  for ( ;; ) {
+    if ( map->dists[i] == 0 || map->dists[i] < dist ) {
+      uint8_t  d = map->dists[i];
+      uint32_t h = map->hashes[i];
+      uint64_t k = map->keys[i];
+      memcpy( swap, map->values + i * map->value_stride, map->value_stride );
+
+      map->dists[i]  = ( uint8_t ) dist;
+      map->hashes[i] = hash;
+      map->keys[i]   = key;
+      memcpy( map->values + i * map->value_stride, carry, map->value_stride );
+
+      if ( placed == STDS_HASHMAP_NONE ) {
+        placed = i;
+      }
+
+      if ( d == 0 ) {
+        return placed;
+      }
+
+      dist = d;
+      hash = h;
+      key  = k;
+      memcpy( carry, swap, map->value_stride );
+    }
+
+    i = ( i + 1 ) & mask;
+
+    /* Probe distances are stored in a byte. At a load factor of 4/5 they
+       stay far below that unless nearly every key hashes alike. */
+    if ( ++dist == UINT8_MAX ) {
+      fprintf( stderr, "Error! stds_hashmap_t probe sequence too long.\n" );
+      exit( EXIT_FAILURE );
+    }
+  }
+}
+
+/**
+ * Frees the element in slot i, then shifts each following element back one
+ * slot until reaching an empty slot or an element already at home.
+ *
+ * @param stds_hashmap_t * pointer to the map.
+ * @param size_t slot index.
+ *
+ * @return void.
+ */
+static void
+Stds_HashMapRemoveAt( stds_hashmap_t *map, size_t i ) {
+  size_t mask = map->capacity - 1;
+
+  if ( map->key_type == STDS_HASHMAP_STRING_KEYS ) {
+    free( ( void * ) ( uintptr_t ) map->keys[i] );
+  }
+
+  if ( !map->is_inline ) {
+    free( *( void ** ) ( map->values + i * map->value_stride ) );
+  }
+
+  size_t next = ( i + 1 ) & mask;
+
+  while ( map->dists[next] > 1 ) {
+    map->dists[i]  = ( uint8_t )( map->dists[next] - 1 );
+    map->hashes[i] = map->hashes[next];
+    map->keys[i]   = map->keys[next];
+    memcpy( map->values + i * map->value_stride, map->values + next * map->value_stride,
+            map->value_stride );
+
+    i    = next;
+    next = ( next + 1 ) & mask;
+  }
+
+  map->dists[i] = 0;
+  map->logical_size--;
+}
+
+/**
+ * Reallocates the table with capacity slots and reinserts every element.
+ * Keys and boxed values move as they are; nothing is copied deeply.
+ *
+ * @param stds_hashmap_t * pointer to the map.
+ * @param size_t new capacity, a power of two.
+ *
+ * @return void.
+ */
+static void
+Stds_HashMapGrow( stds_hashmap_t *map, size_t capacity ) {
+  uint8_t * old_dists    = map->dists;
+  uint32_t *old_hashes   = map->hashes;
+  uint64_t *old_keys     = map->keys;
+  uint8_t * old_values   = map->values;
+  size_t    old_capacity = map->capacity;
+
+  map->dists  = calloc( capacity, 1 );
+  map->hashes = malloc( sizeof( uint32_t ) * capacity );
+  map->keys   = malloc( sizeof( uint64_t ) * capacity );
+  map->values = malloc( map->value_stride * capacity );
+
+  if ( map->dists == NULL || map->hashes == NULL || map->keys == NULL || map->values == NULL ) {
+    fprintf( stderr, "Error: could not allocate memory for the stds_hashmap_t table!\n" );
+    exit( EXIT_FAILURE );
+  }
+
+  map->capacity = capacity;
+
+  for ( size_t j = 0; j < old_capacity; j++ ) {
+    if ( old_dists[j] == 0 ) {
+      continue;
+    }
+
+    memcpy( map->scratch, old_values + j * map->value_stride, map->value_stride );
+    Stds_HashMapPlace( map, old_hashes[j], old_keys[j] );
+  }
+
+  free( old_dists );
+  free( old_hashes );
+  free( old_keys );
+  free( old_values );
+}
+
+/**
+ * Returns the address of the value in slot i.
+ *
+ * @param stds_hashmap_t * pointer to the map.
+ * @param size_t slot index.
+ *
+ * @return void * pointer to the value.
+ */
+static void *
+Stds_HashMapValue( const stds_hashmap_t *map, size_t i ) {
+  uint8_t *slot = map->values + i * map->value_stride;
+  return map->is_inline ? ( void * ) slot : *( void ** ) slot;
+}
@@ -1,57 +1,436 @@
+/**
+ * @file stds_heap.c
+ * @author Joshua Crotts
+ * @date October 14 2026
+ * @version 1.0
+ *
+ * @section LICENSE
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License as
+ * published by the Free Software Foundation; either version 2 of
+ * the License, or (at your option) any later version.
+ *
+ * @section DESCRIPTION
+ *
+ * This file defines the functions for a priority queue. Elements are stored
+ * by value in an implicit d-ary heap (d = 2 or 4) ordered by a user
+ * comparator. Every element has a handle, stable while the element stays
+ * in the heap, so its priority can be improved in place with
+ * Stds_HeapDecreaseKey instead of pushing a duplicate.
+ */
 #include "../include/stds_heap.h"
 
-static int32_t Stds_GetLeft( stds_heap_t * );
-static int32_t Stds_GetRight( stds_heap_t * );
+static void  Stds_HeapSiftUp( stds_heap_t *, size_t );
+static void  Stds_HeapSiftDown( stds_heap_t *, size_t );
+static void  Stds_HeapReserve( stds_heap_t *, size_t );
+static void  Stds_HeapPlace( stds_heap_t *, size_t, const void *, int32_t );
+static void *Stds_HeapAt( const stds_heap_t *, size_t );
 
 /**
- *
+ * Heap structure. handles[i] is the handle of the element at slot i and
+ * positions[handle] is its slot, or -1 if the handle is free. Free handles
+ * are kept on a stack in free_handles. scratch holds the element being
+ * sifted.
  */
 struct stds_heap_t {
-  size_t element_size;
-  size_t logical_size;
-  size_t capacity;
-  void * current_element;
-  void **data;
+  size_t              element_size;
+  size_t              logical_size;
+  size_t              capacity;
+  uint32_t            arity;
+  stds_heap_compare_t compare;
+  uint8_t *           data;
+  int32_t *           handles;
+  int32_t *           positions;
+  int32_t *           free_handles;
+  size_t              free_count;
+  size_t              handle_count;
+  uint8_t *           scratch;
 };
 
 /**
+ * Creates a heap of elements of the specified size. To get the size, pass
+ * in sizeof(T). The root is the element the comparator orders first, so a
+ * comparator that returns a - b gives a min-heap.
+ *
+ * @param size_t size of each element.
+ * @param stds_heap_compare_t comparator.
+ * @param uint32_t STDS_HEAP_BINARY or STDS_HEAP_QUATERNARY.
+ *
+ * @return stds_heap_t * pointer to the heap.
+ */
+stds_heap_t *
+Stds_HeapCreate( size_t element_size, stds_heap_compare_t compare, uint32_t arity ) {
+  stds_heap_t *h;
+  h = malloc( sizeof( stds_heap_t ) );
+
+  if ( h == NULL ) {
+    fprintf( stderr, "Error: could not allocate memory for stds_heap_t!\n" );
+    exit( EXIT_FAILURE );
+  }
+
+  memset( h, 0, sizeof( stds_heap_t ) );
+  h->element_size = element_size;
+  h->compare      = compare;
+  h->arity        = arity == STDS_HEAP_QUATERNARY ? STDS_HEAP_QUATERNARY : STDS_HEAP_BINARY;
+  h->scratch      = malloc( element_size );
+
+  if ( h->scratch == NULL ) {
+    fprintf( stderr, "Error: could not allocate memory for stds_heap_t!\n" );
+    exit( EXIT_FAILURE );
+  }
+
+  Stds_HeapReserve( h, STDS_STATIC_MIN_CAP );
+
+  return h;
+}
+
+/**
+ * Inserts a copy of the element. O(log n).
+ *
+ * @param stds_heap_t * pointer to the heap.
+ * @param void * pointer to the element to copy in.
  *
+ * @return int32_t handle of the element, valid until it leaves the heap.
+ *         Handles of removed elements are reused by later inserts.
+ */
+int32_t
+Stds_HeapInsert( struct stds_heap_t *h, const void *data ) {
+  int32_t handle;
+
+  Stds_HeapReserve( h, h->logical_size + 1 );
+
+  if ( h->free_count > 0 ) {
+    handle = h->free_handles[--h->free_count];
+  } else {
+    handle = ( int32_t ) h->handle_count++;
+  }
+
+  Stds_HeapPlace( h, h->logical_size, data, handle );
+  h->logical_size++;
+  Stds_HeapSiftUp( h, h->logical_size - 1 );
+
+  return handle;
+}
+
+/**
+ * Removes the root, copying it to out. O(log n).
+ *
+ * @param stds_heap_t * pointer to the heap.
+ * @param void * receives the root; may be NULL to discard it.
+ *
+ * @return void.
  */
 void
-Stds_HeapCreate( struct stds_heap_t *h ) {}
+Stds_HeapExtractRoot( struct stds_heap_t *h, void *out ) {
+  if ( Stds_HeapIsEmpty( h ) ) {
+    fprintf( stderr, "Error! Cannot extract from an empty heap.\n" );
+    exit( EXIT_FAILURE );
+  }
+
+  if ( out != NULL ) {
+    memcpy( out, Stds_HeapAt( h, 0 ), h->element_size );
+  }
+
+  int32_t root                     = h->handles[0];
+  h->positions[root]               = -1;
+  h->free_handles[h->free_count++] = root;
+  h->logical_size--;
+
+  if ( h->logical_size > 0 ) {
+    Stds_HeapPlace( h, 0, Stds_HeapAt( h, h->logical_size ), h->handles[h->logical_size] );
+    Stds_HeapSiftDown( h, 0 );
+  }
+}
 
 /**
+ * Returns the root without removing it.
+ *
+ * @param stds_heap_t * pointer to the heap.
  *
+ * @return void * pointer to the root element.
+ */
+void *
+Stds_HeapPeek( struct stds_heap_t *h ) {
+  if ( Stds_HeapIsEmpty( h ) ) {
+    fprintf( stderr, "Error! Cannot peek on an empty heap.\n" );
+    exit( EXIT_FAILURE );
+  }
+
+  return Stds_HeapAt( h, 0 );
+}
+
+/**
+ * Replaces the element with the given handle by data, which must compare
+ * no later than the old value (e.g. a shorter path cost), and restores the
+ * heap order. O(log n).
+ *
+ * @param stds_heap_t * pointer to the heap.
+ * @param int32_t handle from Stds_HeapInsert.
+ * @param void * pointer to the new value.
+ *
+ * @return void.
  */
 void
-Stds_HeapInsert( struct stds_heap_t *h, void *data ) {}
+Stds_HeapDecreaseKey( struct stds_heap_t *h, int32_t handle, const void *data ) {
+  if ( !Stds_HeapContains( h, handle ) ) {
+    fprintf( stderr, "Failed to decrease key, handle %d is not in the heap.\n", handle );
+    exit( EXIT_FAILURE );
+  }
+
+  size_t slot = ( size_t ) h->positions[handle];
+  memcpy( Stds_HeapAt( h, slot ), data, h->element_size );
+  Stds_HeapSiftUp( h, slot );
+}
+
+/**
+ * Determines whether a handle refers to an element still in the heap.
+ *
+ * @param stds_heap_t * pointer to the heap.
+ * @param int32_t handle.
+ *
+ * @return bool true if the element has not been extracted.
+ */
+bool
+Stds_HeapContains( const struct stds_heap_t *h, int32_t handle ) {
+  return handle >= 0 && ( size_t ) handle < h->handle_count && h->positions[handle] >= 0;
+}
 
 /**
+ * Returns the element with the given handle. Do not change the fields the
+ * comparator reads through this pointer; use Stds_HeapDecreaseKey.
+ *
+ * @param stds_heap_t * pointer to the heap.
+ * @param int32_t handle of an element in the heap.
  *
+ * @return void * pointer to the element.
  */
 void *
-Stds_HeapExtractRoot( struct stds_heap_t *h ) {
-  return NULL;
+Stds_HeapGet( struct stds_heap_t *h, int32_t handle ) {
+  if ( !Stds_HeapContains( h, handle ) ) {
+    fprintf( stderr, "Failed to get element, handle %d is not in the heap.\n", handle );
+    exit( EXIT_FAILURE );
+  }
+
+  return Stds_HeapAt( h, ( size_t ) h->positions[handle] );
+}
+
+/**
+ * Replaces the heap's contents with n elements stored back to back at data
+ * and orders them bottom-up in O(n). The element at data[i] gets handle i.
+ *
+ * @param stds_heap_t * pointer to the heap.
+ * @param void * pointer to the first of n elements.
+ * @param size_t number of elements.
+ *
+ * @return void.
+ */
+void
+Stds_HeapHeapify( struct stds_heap_t *h, const void *data, size_t n ) {
+  Stds_HeapClear( h );
+  Stds_HeapReserve( h, n );
+
+  memcpy( h->data, data, n * h->element_size );
+
+  for ( size_t i = 0; i < n; i++ ) {
+    h->handles[i]   = ( int32_t ) i;
+    h->positions[i] = ( int32_t ) i;
+  }
+
+  h->logical_size = n;
+  h->handle_count = n;
+
+  /* Sift down every internal node, last first. */
+  for ( size_t i = n > 1 ? ( n - 2 ) / h->arity + 1 : 0; i > 0; i-- ) {
+    Stds_HeapSiftDown( h, i - 1 );
+  }
+}
+
+/**
+ * Returns the number of elements in the heap.
+ *
+ * @param stds_heap_t * pointer to the heap.
+ *
+ * @return size_t logical size.
+ */
+size_t
+Stds_HeapSize( const struct stds_heap_t *h ) {
+  return h->logical_size;
+}
+
+/**
+ * Determines if the heap is empty or not.
+ *
+ * @param stds_heap_t * pointer to the heap.
+ *
+ * @return true if logical size is 0, false otherwise.
+ */
+bool
+Stds_HeapIsEmpty( const struct stds_heap_t *h ) {
+  return h->logical_size == 0;
 }
 
 /**
+ * Removes every element and releases every handle. The buffers are kept.
  *
+ * @param stds_heap_t * pointer to the heap.
+ *
+ * @return void.
+ */
+void
+Stds_HeapClear( struct stds_heap_t *h ) {
+  h->logical_size = 0;
+  h->handle_count = 0;
+  h->free_count   = 0;
+}
+
+/**
+ * Frees all associated memory with the heap.
+ *
+ * @param stds_heap_t * pointer to the heap.
+ *
+ * @return void.
  */
 void
-Stds_HeapClear( struct stds_heap_t *h ) {}
+Stds_HeapDestroy( struct stds_heap_t *h ) {
+  free( h->data );
+  free( h->handles );
+  free( h->positions );
+  free( h->free_handles );
+  free( h->scratch );
+  free( h );
+}
+
+/**
+ * Moves the element at slot up until its parent orders before it. The
+ * element is held in scratch and parents are moved down into the hole, so
+ * each level costs one copy rather than a swap.
+ *
+ * @param stds_heap_t * pointer to the heap.
+ * @param size_t slot.
+ *
+ * @return void.
+ */
+static void
+Stds_HeapSiftUp( stds_heap_t *h, size_t slot ) {
+  int32_t handle = h->handles[slot];
+  memcpy( h->scratch, Stds_HeapAt( h, slot ), h->element_size );
+
+  while ( slot > 0 ) {
+    size_t parent = ( slot - 1 ) / h->arity;
+
+    if ( h->compare( h->scratch, Stds_HeapAt( h, parent ) ) >= 0 ) {
+      break;
+    }
+
+    Stds_HeapPlace( h, slot, Stds_HeapAt( h, parent ), h->handles[parent] );
+    slot = parent;
+  }
+
+  Stds_HeapPlace( h, slot, h->scratch, handle );
+}
+
+/**
+ * Moves the element at slot down until no child orders before it.
+ *
+ * @param stds_heap_t * pointer to the heap.
+ * @param size_t slot.
+ *
+ * @return void.
+ */
+static void
+Stds_HeapSiftDown( stds_heap_t *h, size_t slot ) {
+  int32_t handle = h->handles[slot];
+  memcpy( h->scratch, Stds_HeapAt( h, slot ), h->element_size );
+
+  for ( ;; ) {
+    size_t first = slot * h->arity + 1;
+
+    if ( first >= h->logical_size ) {
+      break;
+    }
+
+    size_t last = first + h->arity < h->logical_size ? first + h->arity : h->logical_size;
+    size_t best = first;
+
+    for ( size_t c = first + 1; c < last; c++ ) {
+      if ( h->compare( Stds_HeapAt( h, c ), Stds_HeapAt( h, best ) ) < 0 ) {
+        best = c;
+      }
+    }
+
+    if ( h->compare( Stds_HeapAt( h, best ), h->scratch ) >= 0 ) {
+      break;
+    }
+
+    Stds_HeapPlace( h, slot, Stds_HeapAt( h, best ), h->handles[best] );
+    slot = best;
+  }
+
+  Stds_HeapPlace( h, slot, h->scratch, handle );
+}
 
 /**
+ * Grows the element, handle and position arrays to hold at least n.
  *
+ * @param stds_heap_t * pointer to the heap.
+ * @param size_t number of elements.
+ *
+ * @return void.
  */
-static int32_t
-Stds_HeapGetLeft( stds_heap_t *h ) {
-  return -1;
+static void
+Stds_HeapReserve( stds_heap_t *h, size_t n ) {
+  if ( n <= h->capacity ) {
+    return;
+  }
+
+  size_t capacity = h->capacity > 0 ? h->capacity : STDS_STATIC_MIN_CAP;
+  while ( capacity < n ) {
+    capacity <<= 1;
+  }
+
+  /* There are never more live handles than elements, so the handle arrays
+     share the element capacity. */
+  h->data         = realloc( h->data, capacity * h->element_size );
+  h->handles      = realloc( h->handles, capacity * sizeof( int32_t ) );
+  h->positions    = realloc( h->positions, capacity * sizeof( int32_t ) );
+  h->free_handles = realloc( h->free_handles, capacity * sizeof( int32_t ) );
+
+  if ( h->data == NULL || h->handles == NULL || h->positions == NULL ||
+       h->free_handles == NULL ) {
+    fprintf( stderr, "Error: could not allocate memory for the stds_heap_t buffers!\n" );
+    exit( EXIT_FAILURE );
+  }
+
+  h->capacity = capacity;
 }
 
 /**
+ * Writes an element and its handle into a slot and records the slot.
+ *
+ * @param stds_heap_t * pointer to the heap.
+ * @param size_t slot.
+ * @param void * element to copy in.
+ * @param int32_t its handle.
  *
+ * @return void.
  */
-static int32_t
-Stds_HeapGetRight( stds_heap_t *h ) {
-  return -1;
-}
\ No newline at end of file
+static void
+Stds_HeapPlace( stds_heap_t *h, size_t slot, const void *data, int32_t handle ) {
+  memcpy( Stds_HeapAt( h, slot ), data, h->element_size );
+  h->handles[slot]     = handle;
+  h->positions[handle] = ( int32_t ) slot;
+}
+
+/**
+ * Returns the address of a slot.
+ *
+ * @param stds_heap_t * pointer to the heap.
+ * @param size_t slot.
+ *
+ * @return void * pointer to the slot.
+ */
+static void *
+Stds_HeapAt( const stds_heap_t *h, size_t slot ) {
+  return h->data + slot * h->element_size;
+}
@@ -0,0 +1,233 @@
+/**
+ * @file stds_pool.c
+ * @author Joshua Crotts
+ * @date October 14 2026
+ * @version 1.0
+ *
+ * @section LICENSE
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License as
+ * published by the Free Software Foundation; either version 2 of
+ * the License, or (at your option) any later version.
+ *
+ * @section DESCRIPTION
+ *
+ * This file defines the functions for a fixed-size object pool. Elements are
+ * carved out of blocks of block_elements slots each, and freed slots go on an
+ * intrusive free list, so allocating and freeing are a couple of pointer moves
+ * and same-type objects stay packed together in memory.
+ */
+#include "../include/stds_pool.h"
+
+static void Stds_PoolAddBlock( stds_pool_t * );
+
+/* Bytes held in blocks by every pool, for telemetry. */
+static size_t       pool_bytes;
+static SDL_SpinLock pool_bytes_lock;
+
+/**
+ * One slab of slots. The slots follow the header directly.
+ */
+struct stds_pool_block_t {
+  struct stds_pool_block_t *next;
+  size_t                    padding;
+};
+
+/**
+ * Pool structure. free_list threads through the unused slots; the first
+ * pointer-sized bytes of a free slot hold the next free slot.
+ */
+struct stds_pool_t {
+  size_t                    element_size;
+  size_t                    block_elements;
+  size_t                    logical_size;
+  void *                    free_list;
+  struct stds_pool_block_t *blocks;
+};
+
+/**
+ * Creates a pool of elements of the specified size. To get the size, pass
+ * in sizeof(T). The pool grows one block of block_elements slots at a time.
+ *
+ * @param size_t size of each element.
+ * @param size_t number of elements per block.
+ *
+ * @return stds_pool_t * pointer to the pool.
+ */
+stds_pool_t *
+Stds_PoolCreate( size_t element_size, size_t block_elements ) {
+  stds_pool_t *pool;
+  pool = malloc( sizeof( stds_pool_t ) );
+
+  if ( pool == NULL ) {
+    fprintf( stderr, "Error: could not allocate memory for stds_pool_t!\n" );
+    exit( EXIT_FAILURE );
+  }
+
+  memset( pool, 0, sizeof( stds_pool_t ) );
+
+  /* Every slot must fit the free-list link and keep the next slot aligned. */
+  if ( element_size < sizeof( void * ) ) {
+    element_size = sizeof( void * );
+  }
+
+  pool->element_size =
+    ( element_size + STDS_ALLOC_ALIGNMENT - 1 ) & ~( size_t )( STDS_ALLOC_ALIGNMENT - 1 );
+  pool->block_elements = block_elements > 0 ? block_elements : STDS_STATIC_MIN_CAP;
+
+  return pool;
+}
+
+/**
+ * Takes an element from the pool. The memory is zeroed, like calloc.
+ *
+ * @param stds_pool_t * pointer to the pool.
+ *
+ * @return void * pointer to the element.
+ */
+void *
+Stds_PoolAlloc( struct stds_pool_t *pool ) {
+  if ( pool->free_list == NULL ) {
+    Stds_PoolAddBlock( pool );
+  }
+
+  void *element   = pool->free_list;
+  pool->free_list = *( void ** ) element;
+  memset( element, 0, pool->element_size );
+  pool->logical_size++;
+
+  return element;
+}
+
+/**
+ * Returns an element to the pool. The element must have come from
+ * Stds_PoolAlloc on the same pool. Passing NULL does nothing.
+ *
+ * @param stds_pool_t * pointer to the pool.
+ * @param void * element to free.
+ *
+ * @return void.
+ */
+void
+Stds_PoolFree( struct stds_pool_t *pool, void *element ) {
+  if ( element == NULL ) {
+    return;
+  }
+
+  *( void ** ) element = pool->free_list;
+  pool->free_list      = element;
+  pool->logical_size--;
+}
+
+/**
+ * Returns the number of elements currently allocated from the pool.
+ *
+ * @param stds_pool_t * pointer to the pool.
+ *
+ * @return size_t number of live elements.
+ */
+size_t
+Stds_PoolSize( const struct stds_pool_t *pool ) {
+  return pool->logical_size;
+}
+
+/**
+ * Frees every element at once, keeping the blocks for reuse. Pointers to
+ * elements from before the clear must not be used afterwards.
+ *
+ * @param stds_pool_t * pointer to the pool.
+ *
+ * @return void.
+ */
+void
+Stds_PoolClear( struct stds_pool_t *pool ) {
+  pool->free_list    = NULL;
+  pool->logical_size = 0;
+
+  for ( struct stds_pool_block_t *b = pool->blocks; b != NULL; b = b->next ) {
+    uint8_t *slots = ( uint8_t * ) ( b + 1 );
+
+    for ( size_t i = pool->block_elements; i > 0; i-- ) {
+      void *element        = slots + ( i - 1 ) * pool->element_size;
+      *( void ** ) element = pool->free_list;
+      pool->free_list      = element;
+    }
+  }
+}
+
+/**
+ * Returns the bytes held in blocks by every pool, including free slots.
+ *
+ * @param void.
+ *
+ * @return size_t bytes reserved by pools.
+ */
+size_t
+Stds_PoolTotalBytes( void ) {
+  SDL_AtomicLock( &pool_bytes_lock );
+  const size_t bytes = pool_bytes;
+  SDL_AtomicUnlock( &pool_bytes_lock );
+
+  return bytes;
+}
+
+/**
+ * Frees the pool and every block it allocated.
+ *
+ * @param stds_pool_t * pointer to the pool.
+ *
+ * @return void.
+ */
+void
+Stds_PoolDestroy( struct stds_pool_t *pool ) {
+  const size_t block_bytes
+    = sizeof( struct stds_pool_block_t ) + pool->element_size * pool->block_elements;
+
+  while ( pool->blocks != NULL ) {
+    struct stds_pool_block_t *next = pool->blocks->next;
+    free( pool->blocks );
+    pool->blocks = next;
+
+    SDL_AtomicLock( &pool_bytes_lock );
+    pool_bytes -= block_bytes;
+    SDL_AtomicUnlock( &pool_bytes_lock );
+  }
+
+  free( pool );
+}
+
+/**
+ * Allocates another block and threads its slots onto the free list, lowest
+ * address first so consecutive allocations are adjacent.
+ *
+ * @param stds_pool_t * pointer to the pool.
+ *
+ * @return void.
+ */
+static void
+Stds_PoolAddBlock( stds_pool_t *pool ) {
+  const size_t block_bytes
+    = sizeof( struct stds_pool_block_t ) + pool->element_size * pool->block_elements;
+  struct stds_pool_block_t *b = malloc( block_bytes );
+
+  if ( b == NULL ) {
+    fprintf( stderr, "Error: could not allocate memory for stds_pool_t block!\n" );
+    exit( EXIT_FAILURE );
+  }
+
+  SDL_AtomicLock( &pool_bytes_lock );
+  pool_bytes += block_bytes;
+  SDL_AtomicUnlock( &pool_bytes_lock );
+
+  b->next      = pool->blocks;
+  pool->blocks = b;
+
+  uint8_t *slots = ( uint8_t * ) ( b + 1 );
+
+  for ( size_t i = pool->block_elements; i > 0; i-- ) {
+    void *element        = slots + ( i - 1 ) * pool->element_size;
+    *( void ** ) element = pool->free_list;
+    pool->free_list      = element;
+  }
+}
@@ -13,19 +13,26 @@
  *
  * @section DESCRIPTION
  *
- * This file defines the functions for a queue data structure.
+ * This file defines the functions for a queue data structure. Elements are
+ * stored by value in a circular buffer that doubles when full, so adding and
+ * polling are O(1) with no allocation per element.
  */
 #include "../include/stds_queue.h"
 
+static void  Stds_QueueGrow( stds_queue_t *, size_t );
+static void *Stds_QueueSlot( const stds_queue_t *, size_t );
+
 /**
- * Queue structure. Based on a FIFO (first-in-first-out) priority. The 
- * list is linked-list-based, not array-based.
+ * Queue structure. Based on a FIFO (first-in-first-out) priority. The
+ * front element is at slot head; capacity is always a power of two so
+ * slot indices wrap with a mask.
  */
 struct stds_queue_t {
-  size_t             element_size;
-  size_t             logical_size;
-  stds_queue_node_t *head;
-  stds_queue_node_t *tail;
+  size_t   element_size;
+  size_t   logical_size;
+  size_t   capacity;
+  size_t   head;
+  uint8_t *data;
 };
 
 /**
@@ -34,83 +41,123 @@ struct stds_queue_t {
  *
  * @param size_t size of each individual element.
  *
- * @return void.
+ * @return stds_queue_t * pointer to the queue.
  */
 stds_queue_t *
 Stds_QueueCreate( size_t element_size ) {
   stds_queue_t *q;
   q = malloc( sizeof( stds_queue_t ) );
+
+  if ( q == NULL ) {
+    fprintf( stderr, "Error: could not allocate memory for stds_queue_t!\n" );
+    exit( EXIT_FAILURE );
+  }
+
   memset( q, 0, sizeof( stds_queue_t ) );
   q->element_size = element_size;
-
-  Stds_QueueClear( q );
+  Stds_QueueGrow( q, STDS_QUEUE_MIN_CAP );
 
   return q;
 }
 
 /**
- * Adds an element into the queue. This datatype should match the associated
- * type in the supplied stds_queue_t. Also, when calling this function,
- * make sure to ( void * ) cast your data.
- * 
+ * Adds an element to the back of the queue. element_size bytes are copied
+ * from the pointer, so pass the address of the value.
+ *
  * @param struct stds_queue_t * pointer to queue structure.
- * @param void * data to add into queue.
- * 
- * @return void. 
+ * @param void * pointer to the element to copy in.
+ *
+ * @return void.
  */
 void
-Stds_QueueAdd( struct stds_queue_t *q, void *data ) {
-  stds_queue_node_t *n;
-  n = malloc( sizeof( stds_queue_node_t ) );
-  memset( n, 0, sizeof( stds_queue_node_t ) );
-  n->data = data;
-  n->next = NULL;
-
-  /* If there is no head, then we assign it to the head. */
-  if ( Stds_QueueIsEmpty( q ) ) {
-    q->head = n;
+Stds_QueueAdd( struct stds_queue_t *q, const void *data ) {
+  if ( q->logical_size == q->capacity ) {
+    Stds_QueueGrow( q, q->capacity << 1 );
   }
 
-  q->tail->next = n;
-  q->tail       = n;
+  memcpy( Stds_QueueSlot( q, q->logical_size ), data, q->element_size );
   q->logical_size++;
 }
 
 /**
- * Removes the first element in the queue.
+ * Adds n elements, stored back to back at data, to the back of the queue.
+ * The buffer grows at most once and the elements go in with at most two
+ * copies.
+ *
+ * @param struct stds_queue_t * pointer to queue structure.
+ * @param void * pointer to the first of n elements.
+ * @param size_t number of elements.
+ *
+ * @return void.
+ */
+void
+Stds_QueueAddN( struct stds_queue_t *q, const void *data, size_t n ) {
+  size_t capacity = q->capacity;
+
+  while ( q->logical_size + n > capacity ) {
+    capacity <<= 1;
+  }
+
+  if ( capacity != q->capacity ) {
+    Stds_QueueGrow( q, capacity );
+  }
+
+  /* The free slots are at most two runs: up to the end of the buffer, then
+     from its start. */
+  size_t tail  = ( q->head + q->logical_size ) & ( q->capacity - 1 );
+  size_t first = q->capacity - tail < n ? q->capacity - tail : n;
+
+  memcpy( q->data + tail * q->element_size, data, first * q->element_size );
+  memcpy( q->data, ( const uint8_t * ) data + first * q->element_size,
+          ( n - first ) * q->element_size );
+  q->logical_size += n;
+}
+
+/**
+ * Removes the first element in the queue, copying it to out.
  *
  * @param stds_queue_t * pointer to queue.
+ * @param void * receives the element; may be NULL to discard it.
  *
- * @return first element in queue.
+ * @return void.
  */
-void *
-Stds_QueuePoll( struct stds_queue_t *q ) {
+void
+Stds_QueuePoll( struct stds_queue_t *q, void *out ) {
   if ( Stds_QueueIsEmpty( q ) ) {
     fprintf( stderr, "Error! Cannot poll on an empty queue.\n" );
     exit( EXIT_FAILURE );
   }
 
-  stds_queue_node_t *n = q->head;
-  q->head              = q->head->next;
-  return n->data;
+  if ( out != NULL ) {
+    memcpy( out, Stds_QueueSlot( q, 0 ), q->element_size );
+  }
+
+  q->head = ( q->head + 1 ) & ( q->capacity - 1 );
+  q->logical_size--;
 }
 
 /**
- * Returns an iterator for the queue. That is, it returns the head so the user
- * can iterate over the elements without dequeueing them.
- * 
+ * Returns the element index places from the front without dequeueing it,
+ * so the user can iterate over the elements in order. The pointer is
+ * invalidated by the next add.
+ *
  * @param struct stds_queue_t * pointer to queue structure.
- * 
- * @return pointer to queue node at the front (i.e. the head of the queue).
+ * @param size_t position from the front, 0 being the front.
+ *
+ * @return void * pointer to the element.
  */
-inline stds_queue_node_t *
-Stds_QueueIterator( struct stds_queue_t *q ) {
-  return q->head;
+void *
+Stds_QueueGet( struct stds_queue_t *q, size_t index ) {
+  if ( index >= q->logical_size ) {
+    fprintf( stderr, "Failed to get element, index out of bounds error: %zu.\n", index );
+    exit( EXIT_FAILURE );
+  }
+
+  return Stds_QueueSlot( q, index );
 }
 
 /**
- * Clears all associated data with the queue. All pointers
- * are reset and memory is re-allocated.
+ * Removes every element. The buffer is kept for reuse.
  *
  * @param stds_queue_t * pointer to queue to clear.
  *
@@ -118,27 +165,8 @@ Stds_QueueIterator( struct stds_queue_t *q ) {
  */
 void
 Stds_QueueClear( struct stds_queue_t *q ) {
-  /* First, go through the pointers and clear them out. */
-  stds_queue_node_t *n = q->head;
-  stds_queue_node_t *next;
-
-  /* Then, free the memory associated with the list. */
-  while ( n != NULL ) {
-    next = n->next;
-    free( n );
-    n = next;
-  }
-
-  /* Now, reset the actual associated data. */
+  q->head         = 0;
   q->logical_size = 0;
-  q->head         = malloc( sizeof( stds_queue_node_t ) );
-  q->tail         = malloc( sizeof( stds_queue_node_t ) );
-
-  q->tail = q->head;
-  q->head = q->tail;
-
-  q->head->next = NULL;
-  q->tail->next = NULL;
 }
 
 /**
@@ -146,16 +174,16 @@ Stds_QueueClear( struct stds_queue_t *q ) {
  *
  * @param stds_queue_t * pointer to queue.
  *
- * @return first element in queue.
+ * @return void * pointer to the first element.
  */
-inline void *
+void *
 Stds_QueuePeek( struct stds_queue_t *q ) {
   if ( Stds_QueueIsEmpty( q ) ) {
     fprintf( stderr, "Error! Cannot peek on an empty queue.\n" );
     exit( EXIT_FAILURE );
   }
 
-  return q->head->data;
+  return Stds_QueueSlot( q, 0 );
 }
 
 /**
@@ -165,7 +193,7 @@ Stds_QueuePeek( struct stds_queue_t *q ) {
  *
  * @return logical size.
  */
-inline size_t
+size_t
 Stds_QueueSize( struct stds_queue_t *q ) {
   return q->logical_size;
 }
@@ -177,7 +205,7 @@ Stds_QueueSize( struct stds_queue_t *q ) {
  *
  * @return true if logical size is 0, false otherwise.
  */
-inline bool
+bool
 Stds_QueueIsEmpty( struct stds_queue_t *q ) {
   return q->logical_size == 0;
 }
@@ -191,10 +219,49 @@ Stds_QueueIsEmpty( struct stds_queue_t *q ) {
  */
 void
 Stds_QueueDestroy( struct stds_queue_t *q ) {
-  stds_queue_node_t *n = q->head;
-  while ( n != NULL ) {
-    n = q->head->next;
-    free( q->head );
-  }
+  free( q->data );
   free( q );
-}
\ No newline at end of file
+}
+
+/**
+ * Reallocates the buffer to capacity slots. If the elements wrapped around
+ * the end of the old buffer, the wrapped part is moved to just past the old
+ * end so they are in order again.
+ *
+ * @param stds_queue_t * pointer to queue.
+ * @param size_t new capacity, a power of two no smaller than the old one.
+ *
+ * @return void.
+ */
+static void
+Stds_QueueGrow( stds_queue_t *q, size_t capacity ) {
+  size_t   old_capacity = q->capacity;
+  uint8_t *data         = realloc( q->data, capacity * q->element_size );
+
+  if ( data == NULL ) {
+    fprintf( stderr, "Error: could not allocate memory for the data buffer in stds_queue_t!\n" );
+    exit( EXIT_FAILURE );
+  }
+
+  q->data     = data;
+  q->capacity = capacity;
+
+  if ( q->head + q->logical_size > old_capacity ) {
+    size_t wrapped = q->head + q->logical_size - old_capacity;
+    memcpy( q->data + old_capacity * q->element_size, q->data, wrapped * q->element_size );
+  }
+}
+
+/**
+ * Returns the address of the element index places from the front, without
+ * bounds checking.
+ *
+ * @param stds_queue_t * pointer to queue.
+ * @param size_t position from the front.
+ *
+ * @return void * pointer to the slot.
+ */
+static void *
+Stds_QueueSlot( const stds_queue_t *q, size_t index ) {
+  return q->data + ( ( q->head + index ) & ( q->capacity - 1 ) ) * q->element_size;
+}
@@ -108,6 +108,20 @@ Stds_StackClear( struct stds_stack_t *s ) {
   s->data         = malloc( sizeof( s->element_size ) * s->capacity );
 }
 
+/**
+ * Frees the memory allocated by the stack. The pushed data itself
+ * belongs to the caller and is not freed.
+ *
+ * @param stds_stack_t * pointer to stack.
+ *
+ * @return void.
+ */
+void
+Stds_StackDestroy( struct stds_stack_t *s ) {
+  free( s->data );
+  free( s );
+}
+
 /**
  * Peeks at the head of the stack.
  *
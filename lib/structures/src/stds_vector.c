@@ -14,21 +14,24 @@
  * @section DESCRIPTION
  *
  * This file defines the functions for a vector/ArrayList/dynamically-expanding
- * array.
+ * array. Elements are stored by value, back to back in one buffer of
+ * element_size-byte slots, so iterating over Stds_VectorData is a linear walk.
  */
 #include "../include/stds_vector.h"
 
-static void Stds_VectorCheckResize( stds_vector_t *, enum SHIFT_DIRECTION );
-static void Stds_VectorShift( stds_vector_t *, size_t, enum SHIFT_DIRECTION );
+static void  Stds_VectorCheckResize( stds_vector_t *, enum SHIFT_DIRECTION );
+static void  Stds_VectorShift( stds_vector_t *, size_t, enum SHIFT_DIRECTION );
+static void  Stds_VectorSetCapacity( stds_vector_t *, size_t );
+static void *Stds_VectorAt( const stds_vector_t *, size_t );
 
 /**
  * Vector structure. Acts the same as a vector in C++ or an ArrayList in Java.
  */
 struct stds_vector_t {
-  size_t element_size;
-  size_t logical_size;
-  size_t capacity;
-  void **data;
+  size_t   element_size;
+  size_t   logical_size;
+  size_t   capacity;
+  uint8_t *data;
 };
 
 /**
@@ -50,84 +53,106 @@ Stds_VectorCreate( size_t element_size ) {
   }
 
   memset( v, 0, sizeof( stds_vector_t ) );
+  v->element_size = element_size;
   Stds_VectorClear( v );
 
   return v;
 }
 
 /**
- * Adds an element to the end of a vector. The data must be casted
- * to a void pointer prior to addition. Example:
+ * Adds an element to the end of a vector. element_size bytes are copied
+ * from the pointer, so pass the address of the value. Example:
  *
- * Stds_VectorAppend( v, (void *) 5 );
+ * int32_t x = 5;
+ * Stds_VectorAppend( v, &x );
  *
  * @param stds_vector_t * pointer to vector.
- * @param void * pointer to data (should be casted).
+ * @param void * pointer to the element to copy in.
  *
  * @return void.
  */
 void
 Stds_VectorAppend( stds_vector_t *v, void *data ) {
   Stds_VectorCheckResize( v, RIGHT );
-  v->data[v->logical_size] = data;
+  memcpy( Stds_VectorAt( v, v->logical_size ), data, v->element_size );
   v->logical_size++;
 }
 
 /**
- * Inserts an element at a specified index.
+ * Inserts an element at a specified index, shifting the elements at and
+ * after it up by one. Inserting at index Stds_VectorSize appends.
  *
  * @param stds_vector_t * pointer to vector.
  * @param size_t index of to-be-inserted element.
- * @param void * pointer to data (should be casted).
+ * @param void * pointer to the element to copy in.
  *
  * @return void.
  */
 void
 Stds_VectorInsert( stds_vector_t *v, ssize_t index, void *data ) {
-  if ( index < 0 || index >= v->logical_size ) {
-    fprintf( stderr, "Failed to insert, index out of bounds error: %zu.\n", index );
+  if ( index < 0 || ( size_t ) index > v->logical_size ) {
+    fprintf( stderr, "Failed to insert, index out of bounds error: %zd.\n", index );
     exit( EXIT_FAILURE );
   }
-  v->logical_size++;
 
   /* Check size, then up-shift the elements. */
   Stds_VectorCheckResize( v, RIGHT );
-  Stds_VectorShift( v, index, RIGHT );
-  v->data[index] = data;
+  Stds_VectorShift( v, ( size_t ) index, RIGHT );
+  memcpy( Stds_VectorAt( v, ( size_t ) index ), data, v->element_size );
+  v->logical_size++;
 }
 
 /**
- * Returns the data at a specified index.
+ * Returns a pointer to the element at a specified index. The pointer is
+ * invalidated by any call that adds, removes or reallocates elements.
  *
  * @param const stds_vector_t * pointer to vector.
  * @param size_t index of to-be-received element.
  *
- * @return void.
+ * @return void * pointer to the element.
  */
 void *
 Stds_VectorGet( const stds_vector_t *v, ssize_t index ) {
-  if ( index < 0 || index >= v->logical_size || Stds_VectorIsEmpty( v ) ) {
-    fprintf( stderr, "Failed to get element, index out of bounds error: %zu.\n", index );
+  if ( index < 0 || ( size_t ) index >= v->logical_size ) {
+    fprintf( stderr, "Failed to get element, index out of bounds error: %zd.\n", index );
     exit( EXIT_FAILURE );
   }
-  return v->data[index];
+  return Stds_VectorAt( v, ( size_t ) index );
+}
+
+/**
+ * Returns the element buffer: Stds_VectorSize elements of element_size
+ * bytes each, back to back. Cast it to T * for tight loops. The pointer is
+ * invalidated by any call that adds, removes or reallocates elements.
+ *
+ * @param const stds_vector_t * pointer to vector.
+ *
+ * @return void * pointer to the first element.
+ */
+void *
+Stds_VectorData( const stds_vector_t *v ) {
+  return v->data;
 }
 
 /**
  * Swaps two elements in a vector.
- * 
+ *
  * @param size_t first index to swap.
  * @param size_t second index to swap.
- * 
+ *
  * @return void.
  */
-inline void 
+void
 Stds_VectorSwap( stds_vector_t *v, size_t first, size_t second ) {
-  void *tmp = v->data[first];
-  v->data[first] = v->data[second];
-  v->data[second] = tmp;
-}
+  uint8_t *a = Stds_VectorAt( v, first );
+  uint8_t *b = Stds_VectorAt( v, second );
 
+  for ( size_t i = 0; i < v->element_size; i++ ) {
+    uint8_t tmp = a[i];
+    a[i]        = b[i];
+    b[i]        = tmp;
+  }
+}
 
 /**
  * Removes an element from a vector.
@@ -139,18 +164,45 @@ Stds_VectorSwap( stds_vector_t *v, size_t first, size_t second ) {
  */
 void
 Stds_VectorRemove( stds_vector_t *v, ssize_t index ) {
-  if ( index < 0 || index >= v->logical_size || Stds_VectorIsEmpty( v ) ) {
-    fprintf( stderr, "Failed to remove, index out of bounds error: %zu.\n", index );
+  if ( index < 0 || ( size_t ) index >= v->logical_size ) {
+    fprintf( stderr, "Failed to remove, index out of bounds error: %zd.\n", index );
     exit( EXIT_FAILURE );
   }
-  void *removed_data = Stds_VectorGet( v, index );
-  v->logical_size--;
 
   /* Down-shift the elements, then check for capacity problems. */
-  Stds_VectorShift( v, index, LEFT );
+  Stds_VectorShift( v, ( size_t ) index, LEFT );
+  v->logical_size--;
   Stds_VectorCheckResize( v, LEFT );
 }
 
+/**
+ * Makes room for at least capacity elements, so that many can be added
+ * without reallocating. Never shrinks the vector.
+ *
+ * @param stds_vector_t * pointer to vector.
+ * @param size_t number of elements.
+ *
+ * @return void.
+ */
+void
+Stds_VectorReserve( stds_vector_t *v, size_t capacity ) {
+  if ( capacity > v->capacity ) {
+    Stds_VectorSetCapacity( v, capacity );
+  }
+}
+
+/**
+ * Reallocates the buffer down to the current number of elements.
+ *
+ * @param stds_vector_t * pointer to vector.
+ *
+ * @return void.
+ */
+void
+Stds_VectorShrinkToFit( stds_vector_t *v ) {
+  Stds_VectorSetCapacity( v, v->logical_size > 0 ? v->logical_size : 1 );
+}
+
 /**
  * Checks to see if the vector is empty.
  *
@@ -176,8 +228,8 @@ Stds_VectorSize( const stds_vector_t *v ) {
 }
 
 /**
- * Clears the vector data. The data pointer is reallocated after
- * being freed.
+ * Clears the vector data. The buffer is reallocated at the minimum
+ * capacity after being freed.
  *
  * @param stds_vector_t * pointer to vector.
  *
@@ -187,14 +239,10 @@ void
 Stds_VectorClear( stds_vector_t *v ) {
   free( v->data );
 
-  v->capacity     = STDS_STATIC_MIN_CAP;
+  v->data         = NULL;
+  v->capacity     = 0;
   v->logical_size = 0;
-  v->data         = malloc( sizeof( v->element_size ) * v->capacity );
-
-  if ( v->data == NULL ) {
-    fprintf( stderr, "Error: could not allocate memory for the data void** in stds_vector_t!\n" );
-    exit( EXIT_FAILURE );
-  }
+  Stds_VectorSetCapacity( v, STDS_STATIC_MIN_CAP );
 }
 
 /**
@@ -215,8 +263,8 @@ Stds_VectorDestroy( stds_vector_t *v ) {
  * handled here (upsizing and downsizing).
  *
  * @param stds_vector_t * pointer to vector.
- * @param enum SHIFT_DIRECTION refers to the last action just performed.
- *        insertions and appends are RIGHT, removals are LEFT.
+ * @param enum SHIFT_DIRECTION refers to the action about to be or just
+ *        performed. Insertions and appends are RIGHT, removals are LEFT.
  *
  * @return void.
  */
@@ -224,19 +272,20 @@ static void
 Stds_VectorCheckResize( stds_vector_t *v, enum SHIFT_DIRECTION direction ) {
   /* If we need to grow, then the logical size is the same as the capacity. */
   if ( v->logical_size == v->capacity && direction == RIGHT ) {
-    v->capacity <<= 1;
-    v->data = realloc( v->data, sizeof( v->element_size ) * v->capacity );
+    Stds_VectorSetCapacity( v, v->capacity << 1 );
   }
 
-  /* If we need to shrink, then the logical size is the same as the capacity / 2. */
-  else if ( v->logical_size == ( v->capacity >> 1 ) && direction == LEFT ) {
-    v->capacity >>= 1;
-    v->data = realloc( v->data, sizeof( v->element_size ) * v->capacity );
+  /* Shrink once only a quarter is in use, so a remove right after a
+     grow does not reallocate straight back. */
+  else if ( v->logical_size <= ( v->capacity >> 2 ) && v->capacity > STDS_STATIC_MIN_CAP &&
+            direction == LEFT ) {
+    Stds_VectorSetCapacity( v, v->capacity >> 1 );
   }
 }
 
 /**
- * Shifts the vector elements to the right or left by 1.
+ * Moves the elements from offset_index to the end up or down by one slot
+ * with a single memmove. For RIGHT the slot at logical_size must exist.
  *
  * @param stds_vector_t * pointer to vector.
  * @param size_t index to offset to or from.
@@ -246,16 +295,50 @@ Stds_VectorCheckResize( stds_vector_t *v, enum SHIFT_DIRECTION direction ) {
  */
 static void
 Stds_VectorShift( stds_vector_t *v, size_t offset_index, enum SHIFT_DIRECTION direction ) {
+  size_t count = v->logical_size - offset_index;
+
   switch ( direction ) {
   case LEFT:
-    for ( uint32_t i = offset_index; i < v->logical_size; i++ ) {
-      v->data[i] = v->data[i + 1];
-    }
+    memmove( Stds_VectorAt( v, offset_index ), Stds_VectorAt( v, offset_index + 1 ),
+             ( count - 1 ) * v->element_size );
     break;
   case RIGHT:
-    for ( uint32_t i = v->logical_size; i >= offset_index; i-- ) {
-      v->data[i] = v->data[i - 1];
-    }
+    memmove( Stds_VectorAt( v, offset_index + 1 ), Stds_VectorAt( v, offset_index ),
+             count * v->element_size );
     break;
   }
-}
\ No newline at end of file
+}
+
+/**
+ * Reallocates the buffer to hold exactly capacity elements.
+ *
+ * @param stds_vector_t * pointer to vector.
+ * @param size_t new capacity in elements.
+ *
+ * @return void.
+ */
+static void
+Stds_VectorSetCapacity( stds_vector_t *v, size_t capacity ) {
+  uint8_t *data = realloc( v->data, v->element_size * capacity );
+
+  if ( data == NULL ) {
+    fprintf( stderr, "Error: could not allocate memory for the data buffer in stds_vector_t!\n" );
+    exit( EXIT_FAILURE );
+  }
+
+  v->data     = data;
+  v->capacity = capacity;
+}
+
+/**
+ * Returns the address of slot index without bounds checking.
+ *
+ * @param stds_vector_t * pointer to vector.
+ * @param size_t slot index.
+ *
+ * @return void * pointer to the slot.
+ */
+static void *
+Stds_VectorAt( const stds_vector_t *v, size_t index ) {
+  return v->data + index * v->element_size;
+}
@@ -0,0 +1,830 @@
+/**
+ * @file aabb_tree.c
+ * @author Joshua Crotts
+ * @date October 14 2026
+ * @version 1.0
+ *
+ * @section LICENSE
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License as
+ * published by the Free Software Foundation; either version 2 of
+ * the License, or (at your option) any later version.
+ *
+ * @section DESCRIPTION
+ *
+ * This file defines a dynamic AABB tree for the collision broad phase. Leaves
+ * store fattened boxes so small movements do not touch the tree, insertion
+ * picks siblings by surface-area cost, and rotations keep the tree balanced.
+ * Unlike the spatial hash, it handles long terrain and tiny projectiles in
+ * the same world without tuning a cell size. The sweep functions give fast
+ * movers continuous collision: the earliest time of impact is found along
+ * the whole frame's movement instead of sub-stepping it.
+ */
+#include "../include/aabb_tree.h"
+
+static int32_t   Stds_AllocateNode( struct aabb_tree_t *tree );
+static void      Stds_FreeNode( struct aabb_tree_t *tree, const int32_t node );
+static void      Stds_InsertLeaf( struct aabb_tree_t *tree, const int32_t leaf );
+static void      Stds_RemoveLeaf( struct aabb_tree_t *tree, const int32_t leaf );
+static int32_t   Stds_Balance( struct aabb_tree_t *tree, const int32_t a );
+static void      Stds_PushNode( struct aabb_tree_t *tree, int32_t *count, const int32_t node );
+static SDL_FRect Stds_UnionRect( const SDL_FRect *a, const SDL_FRect *b );
+static float     Stds_Perimeter( const SDL_FRect *r );
+static bool      Stds_Contains( const SDL_FRect *outer, const SDL_FRect *inner );
+static bool      Stds_SegmentVsRect( const struct vec2_t *p, const struct vec2_t *d,
+                                     const SDL_FRect *r, const float max_t );
+
+/**
+ * Creates an empty AABB tree. Every leaf box is grown by margin on each side,
+ * so objects that move less than that between frames are never re-inserted.
+ *
+ * @param float fat AABB margin in pixels.
+ *
+ * @return aabb_tree_t * pointer to tree.
+ */
+struct aabb_tree_t *
+Stds_CreateAABBTree( const float margin ) {
+  struct aabb_tree_t *tree;
+  tree = malloc( sizeof( struct aabb_tree_t ) );
+
+  if ( tree == NULL ) {
+    SDL_LogInfo( SDL_LOG_CATEGORY_APPLICATION, "Could not allocate memory for aabb_tree_t. %s.\n",
+                 SDL_GetError() );
+    exit( EXIT_FAILURE );
+  }
+
+  memset( tree, 0, sizeof( struct aabb_tree_t ) );
+  tree->root      = -1;
+  tree->free_list = -1;
+  tree->margin    = margin;
+
+  return tree;
+}
+
+/**
+ * Inserts a box into the tree.
+ *
+ * @param aabb_tree_t * pointer to tree.
+ * @param SDL_FRect * pointer to the object's tight bounds.
+ * @param void * user data returned by queries (e.g. an entity_t *).
+ *
+ * @return int32_t proxy id identifying the object in the tree.
+ */
+int32_t
+Stds_AABBTreeInsert( struct aabb_tree_t *tree, const SDL_FRect *aabb, void *data ) {
+  int32_t             proxy = Stds_AllocateNode( tree );
+  struct aabb_node_t *n     = &tree->nodes[proxy];
+
+  n->tight  = *aabb;
+  n->aabb   = ( SDL_FRect ){ aabb->x - tree->margin, aabb->y - tree->margin,
+                           aabb->w + 2 * tree->margin, aabb->h + 2 * tree->margin };
+  n->data   = data;
+  n->height = 0;
+
+  Stds_InsertLeaf( tree, proxy );
+
+  return proxy;
+}
+
+/**
+ * Removes an object from the tree. The proxy id may be reused afterwards.
+ *
+ * @param aabb_tree_t * pointer to tree.
+ * @param int32_t proxy id.
+ *
+ * @return void.
+ */
+void
+Stds_AABBTreeRemove( struct aabb_tree_t *tree, const int32_t proxy ) {
+  Stds_RemoveLeaf( tree, proxy );
+  Stds_FreeNode( tree, proxy );
+}
+
+/**
+ * Updates an object's bounds. The tree is only restructured when the new box
+ * leaves the fat box; the fat box is then extended along displacement so
+ * objects moving steadily in one direction are re-inserted less often.
+ *
+ * @param aabb_tree_t * pointer to tree.
+ * @param int32_t proxy id.
+ * @param SDL_FRect * pointer to the object's new tight bounds.
+ * @param vec2_t * expected movement until the next update, or NULL.
+ *
+ * @return bool true if the object was re-inserted.
+ */
+bool
+Stds_AABBTreeMove( struct aabb_tree_t *tree, const int32_t proxy, const SDL_FRect *aabb,
+                   const struct vec2_t *displacement ) {
+  struct aabb_node_t *n = &tree->nodes[proxy];
+  n->tight              = *aabb;
+
+  if ( Stds_Contains( &n->aabb, aabb ) ) {
+    return false;
+  }
+
+  Stds_RemoveLeaf( tree, proxy );
+
+  SDL_FRect fat = { aabb->x - tree->margin, aabb->y - tree->margin, aabb->w + 2 * tree->margin,
+                    aabb->h + 2 * tree->margin };
+
+  if ( displacement != NULL ) {
+    float dx = 2 * displacement->x;
+    float dy = 2 * displacement->y;
+
+    if ( dx < 0 ) {
+      fat.x += dx;
+    }
+    fat.w += fabsf( dx );
+
+    if ( dy < 0 ) {
+      fat.y += dy;
+    }
+    fat.h += fabsf( dy );
+  }
+
+  tree->nodes[proxy].aabb = fat;
+  Stds_InsertLeaf( tree, proxy );
+
+  return true;
+}
+
+/**
+ * Returns the user data stored with a proxy.
+ *
+ * @param aabb_tree_t * pointer to tree.
+ * @param int32_t proxy id.
+ *
+ * @return void * user data.
+ */
+void *
+Stds_AABBTreeGetData( const struct aabb_tree_t *tree, const int32_t proxy ) {
+  return tree->nodes[proxy].data;
+}
+
+/**
+ * Calls callback( proxy, data, user ) for every object whose fat box overlaps
+ * rect. The callback returns false to stop the query early. Fat boxes are
+ * conservative, so narrow-phase tests should use the object's real bounds.
+ *
+ * @param aabb_tree_t * pointer to tree.
+ * @param SDL_FRect * pointer to query rectangle.
+ * @param bool (*)(int32_t, void *, void *) function called per candidate.
+ * @param void * user data passed to the callback.
+ *
+ * @return void.
+ */
+void
+Stds_AABBTreeQueryRect( struct aabb_tree_t *tree, const SDL_FRect *rect,
+                        bool ( *callback )( int32_t, void *, void * ), void *user ) {
+  int32_t count = 0;
+  Stds_PushNode( tree, &count, tree->root );
+
+  while ( count > 0 ) {
+    int32_t node = tree->stack[--count];
+    if ( node == -1 ) {
+      continue;
+    }
+
+    const struct aabb_node_t *n = &tree->nodes[node];
+    if ( !Stds_RectVsRect( &n->aabb, rect ) ) {
+      continue;
+    }
+
+    if ( n->height == 0 ) {
+      if ( !callback( node, n->data, user ) ) {
+        return;
+      }
+    } else {
+      Stds_PushNode( tree, &count, n->left );
+      Stds_PushNode( tree, &count, n->right );
+    }
+  }
+}
+
+/**
+ * Casts the segment ray + t * ray_direction, t in [0, 1], against the tight
+ * boxes in the tree with Stds_RayVsRect and reports the nearest hit. Subtrees
+ * whose fat box the segment misses, or only reaches beyond the best hit so
+ * far, are skipped.
+ *
+ * @param aabb_tree_t * pointer to tree.
+ * @param vec2_t * ray origin.
+ * @param vec2_t * ray direction; its length is the maximum distance.
+ * @param vec2_t * receives the contact point.
+ * @param vec2_t * receives the contact normal.
+ * @param float * receives the time of impact in [0, 1].
+ *
+ * @return int32_t proxy id of the nearest hit, or -1 if nothing was hit.
+ */
+int32_t
+Stds_AABBTreeRayCast( struct aabb_tree_t *tree, const struct vec2_t *ray,
+                      const struct vec2_t *ray_direction, struct vec2_t *contact_point,
+                      struct vec2_t *contact_norm, float *hit_near ) {
+  int32_t best   = -1;
+  float   best_t = 1.0f;
+  int32_t count  = 0;
+
+  Stds_PushNode( tree, &count, tree->root );
+
+  while ( count > 0 ) {
+    int32_t node = tree->stack[--count];
+    if ( node == -1 ) {
+      continue;
+    }
+
+    const struct aabb_node_t *n = &tree->nodes[node];
+    if ( !Stds_SegmentVsRect( ray, ray_direction, &n->aabb, best_t ) ) {
+      continue;
+    }
+
+    if ( n->height == 0 ) {
+      struct vec2_t cp, cn = { 0, 0 };
+      float         t;
+
+      if ( Stds_RayVsRect( ray, ray_direction, &n->tight, &cp, &cn, &t ) && t >= 0 &&
+           t <= best_t ) {
+        best           = node;
+        best_t         = t;
+        *contact_point = cp;
+        *contact_norm  = cn;
+      }
+    } else {
+      Stds_PushNode( tree, &count, n->left );
+      Stds_PushNode( tree, &count, n->right );
+    }
+  }
+
+  *hit_near = best_t;
+  return best;
+}
+
+/**
+ * Sweeps rect along velocity and reports the earliest object it would hit,
+ * using Stds_AdvRectVsRect on every tight box overlapping the swept bounds.
+ *
+ * @param aabb_tree_t * pointer to tree.
+ * @param SDL_FRect * moving rectangle.
+ * @param vec2_t * movement this step.
+ * @param int32_t proxy to skip (usually the mover itself), or -1.
+ * @param vec2_t * receives the contact point.
+ * @param vec2_t * receives the contact normal.
+ * @param float * receives the time of impact in [0, 1].
+ *
+ * @return int32_t proxy id of the earliest hit, or -1 if nothing was hit.
+ */
+int32_t
+Stds_AABBTreeSweepRect( struct aabb_tree_t *tree, const SDL_FRect *rect,
+                        const struct vec2_t *velocity, const int32_t ignore,
+                        struct vec2_t *contact_point, struct vec2_t *contact_norm,
+                        float *hit_near ) {
+  SDL_FRect moved = { rect->x + velocity->x, rect->y + velocity->y, rect->w, rect->h };
+  SDL_FRect swept = Stds_UnionRect( rect, &moved );
+
+  int32_t best   = -1;
+  float   best_t = 1.0f;
+  int32_t count  = 0;
+
+  Stds_PushNode( tree, &count, tree->root );
+
+  while ( count > 0 ) {
+    int32_t node = tree->stack[--count];
+    if ( node == -1 ) {
+      continue;
+    }
+
+    const struct aabb_node_t *n = &tree->nodes[node];
+    if ( !Stds_RectVsRect( &n->aabb, &swept ) ) {
+      continue;
+    }
+
+    if ( n->height == 0 ) {
+      struct vec2_t cp, cn = { 0, 0 };
+      float         t;
+
+      if ( node != ignore &&
+           Stds_AdvRectVsRect( rect, &n->tight, &cp, &cn, &t, velocity ) && t >= 0 &&
+           t <= best_t ) {
+        best           = node;
+        best_t         = t;
+        *contact_point = cp;
+        *contact_norm  = cn;
+      }
+    } else {
+      Stds_PushNode( tree, &count, n->left );
+      Stds_PushNode( tree, &count, n->right );
+    }
+  }
+
+  *hit_near = best_t;
+  return best;
+}
+
+/**
+ * Moves an entity by its velocity with continuous collision against the tree.
+ * Each iteration sweeps the entity's box along the remaining movement, stops
+ * it at the earliest time of impact and slides the rest of the movement along
+ * the contact surface, up to max_iterations contacts. Movement still left
+ * after the last iteration is dropped rather than applied unswept, so the
+ * entity stays at its last contact. The velocity component into every
+ * contact normal is removed, and the entity's proxy is moved to its final
+ * box. Call this in place of adding the velocity to the position.
+ *
+ * @param aabb_tree_t * pointer to tree.
+ * @param int32_t the entity's own proxy, skipped by the sweep (or -1).
+ * @param entity_t * entity to move.
+ * @param int32_t maximum number of contacts to resolve this frame.
+ * @param sweep_contact_t * receives the contacts in time order, or NULL.
+ * @param int32_t capacity of contacts.
+ *
+ * @return int32_t number of contacts resolved; only the first max_contacts
+ *         are written.
+ */
+int32_t
+Stds_AABBTreeSweepEntity( struct aabb_tree_t *tree, const int32_t proxy, struct entity_t *e,
+                          const int32_t max_iterations, struct sweep_contact_t *contacts,
+                          const int32_t max_contacts ) {
+  struct vec2_t move     = e->velocity;
+  float         elapsed  = 0.0f;
+  int32_t       resolved = 0;
+
+  for ( int32_t it = 0; it < max_iterations; it++ ) {
+    if ( move.x == 0.0f && move.y == 0.0f ) {
+      break;
+    }
+
+    SDL_FRect     box = { e->pos.x, e->pos.y, ( float ) e->w, ( float ) e->h };
+    struct vec2_t point, normal = { 0, 0 };
+    float         t;
+
+    int32_t hit = Stds_AABBTreeSweepRect( tree, &box, &move, proxy, &point, &normal, &t );
+    if ( hit == -1 ) {
+      e->pos.x += move.x;
+      e->pos.y += move.y;
+      break;
+    }
+
+    e->pos.x += move.x * t;
+    e->pos.y += move.y * t;
+    elapsed += ( 1.0f - elapsed ) * t;
+
+    if ( contacts != NULL && resolved < max_contacts ) {
+      struct sweep_contact_t *c = &contacts[resolved];
+      c->proxy                  = hit;
+      c->data                   = tree->nodes[hit].data;
+      c->point                  = point;
+      c->normal                 = normal;
+      c->time                   = elapsed;
+    }
+    resolved++;
+
+    /* Slide the remaining movement along the surface that was hit. */
+    float remaining = 1.0f - t;
+    move.x *= remaining;
+    move.y *= remaining;
+
+    float into = move.x * normal.x + move.y * normal.y;
+    move.x -= normal.x * into;
+    move.y -= normal.y * into;
+
+    float into_velocity = e->velocity.x * normal.x + e->velocity.y * normal.y;
+    if ( into_velocity < 0 ) {
+      e->velocity.x -= normal.x * into_velocity;
+      e->velocity.y -= normal.y * into_velocity;
+    }
+
+    if ( normal.x == 0.0f && normal.y == 0.0f ) {
+      move.x = move.y = 0.0f; /* Corner hit with no usable normal: stop at contact. */
+    }
+  }
+
+  if ( proxy != -1 ) {
+    SDL_FRect box = { e->pos.x, e->pos.y, ( float ) e->w, ( float ) e->h };
+    Stds_AABBTreeMove( tree, proxy, &box, &e->velocity );
+  }
+
+  return resolved;
+}
+
+/**
+ * Runs Stds_AABBTreeSweepEntity over every moving entity, calling on_contact
+ * for each contact in time order. Entities are swept one after another, so
+ * later movers see the already-resolved positions of earlier ones.
+ *
+ * @param aabb_tree_t * pointer to tree.
+ * @param entity_t ** entities to move.
+ * @param int32_t * each entity's proxy in the tree (or -1).
+ * @param int32_t number of entities.
+ * @param int32_t maximum number of contacts resolved per entity.
+ * @param void (*)(entity_t *, const sweep_contact_t *, void *) contact callback.
+ * @param void * user data passed to the callback.
+ *
+ * @return void.
+ */
+void
+Stds_AABBTreeSweepPass( struct aabb_tree_t *tree, struct entity_t **entities,
+                        const int32_t *proxies, const int32_t n, const int32_t max_iterations,
+                        void ( *on_contact )( struct entity_t *, const struct sweep_contact_t *,
+                                              void * ),
+                        void *data ) {
+  struct sweep_contact_t contacts[STDS_SWEEP_MAX_CONTACTS];
+
+  for ( int32_t i = 0; i < n; i++ ) {
+    int32_t count = Stds_AABBTreeSweepEntity( tree, proxies[i], entities[i], max_iterations,
+                                              contacts, STDS_SWEEP_MAX_CONTACTS );
+    count         = count < STDS_SWEEP_MAX_CONTACTS ? count : STDS_SWEEP_MAX_CONTACTS;
+
+    for ( int32_t c = 0; on_contact != NULL && c < count; c++ ) {
+      on_contact( entities[i], &contacts[c], data );
+    }
+  }
+}
+
+/**
+ * Frees the tree. The user data is not touched.
+ *
+ * @param aabb_tree_t * pointer to tree.
+ *
+ * @return void.
+ */
+void
+Stds_AABBTreeDie( struct aabb_tree_t *tree ) {
+  free( tree->nodes );
+  free( tree->stack );
+  free( tree );
+}
+
+/**
+ * Takes a node from the free list, growing the node pool when it is empty.
+ *
+ * @param aabb_tree_t * pointer to tree.
+ *
+ * @return int32_t index of the node.
+ */
+static int32_t
+Stds_AllocateNode( struct aabb_tree_t *tree ) {
+  if ( tree->free_list == -1 ) {
+    int32_t old_capacity = tree->node_capacity;
+    tree->node_capacity  = old_capacity == 0 ? 64 : old_capacity * 2;
+    tree->nodes =
+      realloc( tree->nodes, sizeof( struct aabb_node_t ) * ( size_t ) tree->node_capacity );
+
+    if ( tree->nodes == NULL ) {
+      SDL_LogInfo( SDL_LOG_CATEGORY_APPLICATION,
+                   "Could not allocate memory for aabb_node_t. %s.\n", SDL_GetError() );
+      exit( EXIT_FAILURE );
+    }
+
+    for ( int32_t i = tree->node_capacity - 1; i >= old_capacity; i-- ) {
+      tree->nodes[i].parent = tree->free_list;
+      tree->nodes[i].height = -1;
+      tree->free_list       = i;
+    }
+  }
+
+  int32_t node    = tree->free_list;
+  tree->free_list = tree->nodes[node].parent;
+
+  struct aabb_node_t *n = &tree->nodes[node];
+  memset( n, 0, sizeof( struct aabb_node_t ) );
+  n->parent = -1;
+  n->left   = -1;
+  n->right  = -1;
+
+  return node;
+}
+
+/**
+ * Returns a node to the free list.
+ *
+ * @param aabb_tree_t * pointer to tree.
+ * @param int32_t index of the node.
+ *
+ * @return void.
+ */
+static void
+Stds_FreeNode( struct aabb_tree_t *tree, const int32_t node ) {
+  tree->nodes[node].parent = tree->free_list;
+  tree->nodes[node].height = -1;
+  tree->free_list          = node;
+}
+
+/**
+ * Inserts a leaf next to the sibling that grows the tree's total perimeter
+ * the least, then refits and rebalances its ancestors.
+ *
+ * @param aabb_tree_t * pointer to tree.
+ * @param int32_t index of the leaf.
+ *
+ * @return void.
+ */
+static void
+Stds_InsertLeaf( struct aabb_tree_t *tree, const int32_t leaf ) {
+  if ( tree->root == -1 ) {
+    tree->root               = leaf;
+    tree->nodes[leaf].parent = -1;
+    return;
+  }
+
+  SDL_FRect box   = tree->nodes[leaf].aabb;
+  int32_t   index = tree->root;
+
+  while ( tree->nodes[index].height > 0 ) {
+    const struct aabb_node_t *n = &tree->nodes[index];
+
+    SDL_FRect combined = Stds_UnionRect( &n->aabb, &box );
+    float     area     = Stds_Perimeter( &n->aabb );
+    float     cost     = 2 * Stds_Perimeter( &combined );
+    float     inherit  = 2 * ( Stds_Perimeter( &combined ) - area );
+
+    float child_cost[2];
+    for ( int32_t c = 0; c < 2; c++ ) {
+      const struct aabb_node_t *child = &tree->nodes[c == 0 ? n->left : n->right];
+      SDL_FRect                 u     = Stds_UnionRect( &child->aabb, &box );
+
+      child_cost[c] = child->height == 0
+                        ? Stds_Perimeter( &u ) + inherit
+                        : Stds_Perimeter( &u ) - Stds_Perimeter( &child->aabb ) + inherit;
+    }
+
+    if ( cost < child_cost[0] && cost < child_cost[1] ) {
+      break;
+    }
+
+    index = child_cost[0] < child_cost[1] ? n->left : n->right;
+  }
+
+  int32_t sibling    = index;
+  int32_t old_parent = tree->nodes[sibling].parent;
+  int32_t new_parent = Stds_AllocateNode( tree );
+
+  struct aabb_node_t *np = &tree->nodes[new_parent];
+  np->parent             = old_parent;
+  np->aabb               = Stds_UnionRect( &box, &tree->nodes[sibling].aabb );
+  np->height             = tree->nodes[sibling].height + 1;
+  np->left               = sibling;
+  np->right              = leaf;
+
+  if ( old_parent != -1 ) {
+    if ( tree->nodes[old_parent].left == sibling ) {
+      tree->nodes[old_parent].left = new_parent;
+    } else {
+      tree->nodes[old_parent].right = new_parent;
+    }
+  } else {
+    tree->root = new_parent;
+  }
+
+  tree->nodes[sibling].parent = new_parent;
+  tree->nodes[leaf].parent    = new_parent;
+
+  /* Walk back up, rebalancing and refitting every ancestor. */
+  for ( index = tree->nodes[leaf].parent; index != -1; index = tree->nodes[index].parent ) {
+    index = Stds_Balance( tree, index );
+
+    struct aabb_node_t *n = &tree->nodes[index];
+    struct aabb_node_t *l = &tree->nodes[n->left];
+    struct aabb_node_t *r = &tree->nodes[n->right];
+
+    n->height = 1 + ( l->height > r->height ? l->height : r->height );
+    n->aabb   = Stds_UnionRect( &l->aabb, &r->aabb );
+  }
+}
+
+/**
+ * Detaches a leaf, replacing its parent with its sibling, and refits the
+ * ancestors.
+ *
+ * @param aabb_tree_t * pointer to tree.
+ * @param int32_t index of the leaf.
+ *
+ * @return void.
+ */
+static void
+Stds_RemoveLeaf( struct aabb_tree_t *tree, const int32_t leaf ) {
+  if ( leaf == tree->root ) {
+    tree->root = -1;
+    return;
+  }
+
+  int32_t parent       = tree->nodes[leaf].parent;
+  int32_t grand_parent = tree->nodes[parent].parent;
+  int32_t sibling =
+    tree->nodes[parent].left == leaf ? tree->nodes[parent].right : tree->nodes[parent].left;
+
+  if ( grand_parent != -1 ) {
+    if ( tree->nodes[grand_parent].left == parent ) {
+      tree->nodes[grand_parent].left = sibling;
+    } else {
+      tree->nodes[grand_parent].right = sibling;
+    }
+    tree->nodes[sibling].parent = grand_parent;
+    Stds_FreeNode( tree, parent );
+
+    for ( int32_t index = grand_parent; index != -1; index = tree->nodes[index].parent ) {
+      index = Stds_Balance( tree, index );
+
+      struct aabb_node_t *n = &tree->nodes[index];
+      struct aabb_node_t *l = &tree->nodes[n->left];
+      struct aabb_node_t *r = &tree->nodes[n->right];
+
+      n->aabb   = Stds_UnionRect( &l->aabb, &r->aabb );
+      n->height = 1 + ( l->height > r->height ? l->height : r->height );
+    }
+  } else {
+    tree->root                  = sibling;
+    tree->nodes[sibling].parent = -1;
+    Stds_FreeNode( tree, parent );
+  }
+}
+
+/**
+ * Performs a left or right rotation if node a is imbalanced by more than one
+ * level.
+ *
+ * @param aabb_tree_t * pointer to tree.
+ * @param int32_t index of the node to balance.
+ *
+ * @return int32_t index of the node now at a's position.
+ */
+static int32_t
+Stds_Balance( struct aabb_tree_t *tree, const int32_t a ) {
+  struct aabb_node_t *na = &tree->nodes[a];
+  if ( na->height < 2 ) {
+    return a;
+  }
+
+  int32_t b       = na->left;
+  int32_t c       = na->right;
+  int32_t balance = tree->nodes[c].height - tree->nodes[b].height;
+
+  if ( balance > 1 || balance < -1 ) {
+    /* Rotate the taller child (up) into a's place. */
+    int32_t up       = balance > 1 ? c : b;
+    int32_t other    = balance > 1 ? b : c;
+    int32_t f        = tree->nodes[up].left;
+    int32_t g        = tree->nodes[up].right;
+    struct aabb_node_t *nu = &tree->nodes[up];
+
+    nu->left   = a;
+    nu->parent = na->parent;
+    na->parent = up;
+
+    if ( nu->parent != -1 ) {
+      if ( tree->nodes[nu->parent].left == a ) {
+        tree->nodes[nu->parent].left = up;
+      } else {
+        tree->nodes[nu->parent].right = up;
+      }
+    } else {
+      tree->root = up;
+    }
+
+    /* The taller grandchild stays under up; the shorter one moves under a. */
+    int32_t keep = tree->nodes[f].height > tree->nodes[g].height ? f : g;
+    int32_t move = keep == f ? g : f;
+
+    nu->right                = keep;
+    tree->nodes[move].parent = a;
+
+    if ( balance > 1 ) {
+      na->left  = other;
+      na->right = move;
+    } else {
+      na->left  = move;
+      na->right = other;
+    }
+
+    struct aabb_node_t *nl = &tree->nodes[na->left];
+    struct aabb_node_t *nr = &tree->nodes[na->right];
+    na->aabb               = Stds_UnionRect( &nl->aabb, &nr->aabb );
+    na->height             = 1 + ( nl->height > nr->height ? nl->height : nr->height );
+
+    struct aabb_node_t *nk = &tree->nodes[keep];
+    nu->aabb               = Stds_UnionRect( &na->aabb, &nk->aabb );
+    nu->height             = 1 + ( na->height > nk->height ? na->height : nk->height );
+
+    return up;
+  }
+
+  return a;
+}
+
+/**
+ * Pushes a node onto the tree's traversal stack, growing it when full.
+ *
+ * @param aabb_tree_t * pointer to tree.
+ * @param int32_t * current stack size.
+ * @param int32_t node to push.
+ *
+ * @return void.
+ */
+static void
+Stds_PushNode( struct aabb_tree_t *tree, int32_t *count, const int32_t node ) {
+  if ( *count == tree->stack_capacity ) {
+    tree->stack_capacity = tree->stack_capacity == 0 ? 64 : tree->stack_capacity * 2;
+    tree->stack = realloc( tree->stack, sizeof( int32_t ) * ( size_t ) tree->stack_capacity );
+
+    if ( tree->stack == NULL ) {
+      SDL_LogInfo( SDL_LOG_CATEGORY_APPLICATION,
+                   "Could not allocate memory for the aabb tree stack. %s.\n", SDL_GetError() );
+      exit( EXIT_FAILURE );
+    }
+  }
+
+  tree->stack[( *count )++] = node;
+}
+
+/**
+ * Returns the smallest rectangle containing both a and b.
+ *
+ * @param SDL_FRect * first rectangle.
+ * @param SDL_FRect * second rectangle.
+ *
+ * @return SDL_FRect union.
+ */
+static SDL_FRect
+Stds_UnionRect( const SDL_FRect *a, const SDL_FRect *b ) {
+  float x0 = fminf( a->x, b->x );
+  float y0 = fminf( a->y, b->y );
+  float x1 = fmaxf( a->x + a->w, b->x + b->w );
+  float y1 = fmaxf( a->y + a->h, b->y + b->h );
+
+  return ( SDL_FRect ){ x0, y0, x1 - x0, y1 - y0 };
+}
+
+/**
+ * Returns the perimeter of a rectangle, the 2D analogue of surface area used
+ * by the insertion cost.
+ *
+ * @param SDL_FRect * rectangle.
+ *
+ * @return float perimeter.
+ */
+static float
+Stds_Perimeter( const SDL_FRect *r ) {
+  return 2 * ( r->w + r->h );
+}
+
+/**
+ * Checks whether inner lies entirely inside outer.
+ *
+ * @param SDL_FRect * outer rectangle.
+ * @param SDL_FRect * inner rectangle.
+ *
+ * @return bool true if contained.
+ */
+static bool
+Stds_Contains( const SDL_FRect *outer, const SDL_FRect *inner ) {
+  return inner->x >= outer->x && inner->y >= outer->y &&
+         inner->x + inner->w <= outer->x + outer->w && inner->y + inner->h <= outer->y + outer->h;
+}
+
+/**
+ * Slab test of the segment p + t * d, t in [0, max_t], against a rectangle.
+ *
+ * @param vec2_t * segment start.
+ * @param vec2_t * segment direction.
+ * @param SDL_FRect * rectangle.
+ * @param float largest t of interest.
+ *
+ * @return bool true if the segment touches the rectangle.
+ */
+static bool
+Stds_SegmentVsRect( const struct vec2_t *p, const struct vec2_t *d, const SDL_FRect *r,
+                    const float max_t ) {
+  float t0 = 0.0f;
+  float t1 = max_t;
+
+  float origin[2] = { p->x, p->y };
+  float dir[2]    = { d->x, d->y };
+  float lo[2]     = { r->x, r->y };
+  float hi[2]     = { r->x + r->w, r->y + r->h };
+
+  for ( int32_t axis = 0; axis < 2; axis++ ) {
+    if ( fabsf( dir[axis] ) < 1e-8f ) {
+      if ( origin[axis] < lo[axis] || origin[axis] > hi[axis] ) {
+        return false;
+      }
+    } else {
+      float inv  = 1.0f / dir[axis];
+      float near = ( lo[axis] - origin[axis] ) * inv;
+      float far  = ( hi[axis] - origin[axis] ) * inv;
+
+      if ( near > far ) {
+        float tmp = near;
+        near      = far;
+        far       = tmp;
+      }
+
+      t0 = fmaxf( t0, near );
+      t1 = fminf( t1, far );
+
+      if ( t0 > t1 ) {
+        return false;
+      }
+    }
+  }
+
+  return true;
+}
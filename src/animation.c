@@ -17,41 +17,48 @@
  * struct. A note about this is to make sure to define the position, angle, and
  * flip variables accordingly per the entity using the animation. If not, the
  * animation will not move, rotate, etc.
+ *
+ * The frames themselves live in an animation_clip_t, built once with the
+ * source rect of every frame, and many animations can play the same clip.
+ * Playback is an animation_state_t that keeps time in seconds, so the frame
+ * is a division away and does not depend on how often it is updated.
+ * The animation system owns a packed array of such states, advances them
+ * all with one call, optionally across the job threads, and draws them as
+ * one sprite batch.
  */
 #include "../include/animation.h"
 
+static struct stds_pool_t *       animation_pool;
+static struct animation_system_t animation_system;
+
 static char input_buffer[MAX_BUFFER_SIZE];
 
+static struct animation_t *     Stds_AllocAnimation( void );
+static struct animation_clip_t *Stds_AllocClip( const int32_t, const float, const uint32_t );
+static void                     Stds_SyncAnimation( struct animation_t * );
+static void Stds_AdvanceStates( struct animation_state_t *, const int32_t, const float );
+static void Stds_AdvanceChunk( void *, int32_t );
+static void Stds_GrowAnimationSystem( void );
+
 /**
- * Defines a sprite sheet object. Note that a->current_texture is only
- * applicable with sprite sheets! Do note that dest_width and dest_height are
- * used for scaling purposes. Do NOT modify sprite_width and sprite_height as
- * these are the variables used for splicing.
+ * Builds a clip from a sprite sheet of rows x cols equally sized frames,
+ * read left to right, top to bottom, starting at (x, y) in the sheet.
+ * The clip owns the sheet texture.
  *
  * @param const char* file directory of sprite sheet.
  * @param uint8_t number of frames.
- * @param float time spent on an individual frame per second.
+ * @param float time spent on an individual frame in seconds.
  * @param uint16_t starting top-left x pos of the sprite sheet.
  * @param uint16_t starting top-left y pos of the sprite sheet.
  * @param size_t number of rows.
  * @param size_t number of columns.
- * @param bool true if we offset the sprite based on camera, false otherwise.
  *
- * @return animation_t* struct.
+ * @return animation_clip_t* clip.
  */
-struct animation_t *
-Stds_AddSpritesheet( const char *directory, const uint8_t no_of_frames, const float frame_delay,
-                     const uint16_t x, const uint16_t y, const size_t no_rows,
-                     const size_t no_cols ) {
-  struct animation_t *a;
-  a = malloc( sizeof( struct animation_t ) );
-
-  if ( a == NULL ) {
-    SDL_LogInfo( SDL_LOG_CATEGORY_APPLICATION, "Could not allocate memory for animation_t. %s.\n",
-                 SDL_GetError() );
-    exit( EXIT_FAILURE );
-  }
-
+struct animation_clip_t *
+Stds_CreateSpritesheetClip( const char *directory, const uint8_t no_of_frames,
+                            const float frame_delay, const uint16_t x, const uint16_t y,
+                            const size_t no_rows, const size_t no_cols ) {
   /* If our rows x cols is not the same as the number of frames specified, that means we miscounted.
    */
   if ( no_rows * no_cols != no_of_frames ) {
@@ -61,107 +68,482 @@ Stds_AddSpritesheet( const char *directory, const uint8_t no_of_frames, const fl
     exit( EXIT_FAILURE );
   }
 
-  memset( a, 0, sizeof( struct animation_t ) );
+  struct animation_clip_t *clip
+      = Stds_AllocClip( no_of_frames, frame_delay, STDS_CLIP_OWNS_TEXTURES | STDS_CLIP_SHEET );
+  SDL_Texture *sheet = Stds_LoadTexture( directory );
+  int32_t      sheet_width, sheet_height;
 
-  a->number_of_frames = no_of_frames;
-  a->current_texture  = Stds_LoadTexture( directory );
-  a->frame_delay      = frame_delay;
-  a->frame_timer      = frame_delay * FPS;
-  a->start_x          = x;
-  a->start_y          = y;
-  a->rows_count       = no_rows;
-  a->cols_count       = no_cols;
+  SDL_QueryTexture( sheet, NULL, NULL, &sheet_width, &sheet_height );
 
-  SDL_QueryTexture( a->current_texture, NULL, NULL, &a->sprite_sheet_width,
-                    &a->sprite_sheet_height );
+  const int32_t w = ( sheet_width - x ) / ( int32_t ) no_cols;
+  const int32_t h = ( sheet_height - y ) / ( int32_t ) no_rows;
 
-  a->sprite_width  = a->sprite_sheet_width / a->cols_count;
-  a->sprite_height = a->sprite_sheet_height / a->rows_count;
-  a->dest_width    = a->sprite_width;
-  a->dest_height   = a->sprite_height;
+  for ( int32_t i = 0; i < clip->frame_count; i++ ) {
+    const int32_t col = i % ( int32_t ) no_cols;
+    const int32_t row = i / ( int32_t ) no_cols;
 
-  a->current_frame_id     = 0;
-  a->current_frame_col_id = 0;
-  a->current_frame_row_id = 0;
+    clip->textures[i] = sheet;
+    clip->rects[i]    = ( SDL_Rect ){ x + col * w, y + row * h, w, h };
+  }
 
-  a->id_flags |= STDS_SPRITE_SHEET_MASK;
-  a->flags |= STDS_ANIMATION_ACTIVE_MASK;
+  return clip;
+}
 
-  return a;
+/**
+ * Builds a clip from one image per frame, named with the directory prefix
+ * followed by the frame index and ".png". The clip owns the textures.
+ *
+ * @param const char* directory to files with file prefix.
+ * @param uint8_t number of frames.
+ * @param float time to spend on a individual frame in seconds.
+ *
+ * @return animation_clip_t* clip.
+ */
+struct animation_clip_t *
+Stds_CreateAnimationClip( const char *directory, const uint8_t no_of_frames,
+                          const float frame_delay ) {
+  struct animation_clip_t *clip
+      = Stds_AllocClip( no_of_frames, frame_delay, STDS_CLIP_OWNS_TEXTURES );
+
+  for ( int32_t i = 0; i < clip->frame_count; i++ ) {
+    snprintf( input_buffer, MAX_BUFFER_SIZE, "%s%d.png", directory, i );
+    clip->textures[i] = Stds_LoadTexture( input_buffer );
+    clip->rects[i]    = ( SDL_Rect ){ 0, 0, 0, 0 };
+    SDL_QueryTexture( clip->textures[i], NULL, NULL, &clip->rects[i].w, &clip->rects[i].h );
+  }
+
+  return clip;
 }
 
 /**
- * The other way to use animations is to specify the
- * directory of the animation files and the program
- * will load them in. All sprites must have the same
- * leading prefix, with a number at the end indicating
- * their index in the sequence (ex. spr_0, spr_1, spr_2,
- *, etc.). Note that a->current_texture is only
- * applicable with sprite sheets, so do not use it! To refer
- * to the current frame,
+ * Builds a clip like Stds_CreateAnimationClip, but packs the frames into an
+ * atlas instead of loading one texture per frame. Every frame then shares
+ * the atlas page texture and is drawn with its sub-rect. The atlas keeps
+ * ownership of its pages. Call Stds_AtlasUpload after adding the clips and
+ * before drawing them.
  *
+ * @param atlas_t * atlas to pack the frames into.
  * @param const char* directory to files with file prefix.
  * @param uint8_t number of frames.
- * @param float time to spend on a individual frame per second.
- * @param bool true if we offset the sprite based on camera, false otherwise.
+ * @param float time to spend on a individual frame in seconds.
+ *
+ * @return animation_clip_t* clip.
+ */
+struct animation_clip_t *
+Stds_CreateAtlasClip( struct atlas_t *atlas, const char *directory, const uint8_t no_of_frames,
+                      const float frame_delay ) {
+  struct animation_clip_t *clip = Stds_AllocClip( no_of_frames, frame_delay, 0 );
+
+  for ( int32_t i = 0; i < clip->frame_count; i++ ) {
+    snprintf( input_buffer, MAX_BUFFER_SIZE, "%s%d.png", directory, i );
+
+    const struct atlas_region_t *r =
+      Stds_AtlasGetRegion( atlas, Stds_AtlasAddImage( atlas, input_buffer ) );
+
+    if ( r == NULL ) {
+      SDL_LogInfo( SDL_LOG_CATEGORY_APPLICATION, "Could not pack %s into the atlas.\n",
+                   input_buffer );
+      exit( EXIT_FAILURE );
+    }
+
+    clip->textures[i] = r->texture;
+    clip->rects[i]    = r->rect;
+  }
+
+  return clip;
+}
+
+/**
+ * Destroys a clip, and its textures if it owns them. Nothing may still be
+ * playing it.
+ *
+ * @param animation_clip_t* clip to free.
+ *
+ * @return void.
+ */
+void
+Stds_ClipDie( struct animation_clip_t *clip ) {
+  if ( clip->flags & STDS_CLIP_OWNS_TEXTURES ) {
+    const int32_t count = clip->flags & STDS_CLIP_SHEET ? 1 : clip->frame_count;
+
+    for ( int32_t i = 0; i < count; i++ ) {
+      Stds_ReleaseTexture( clip->textures[i] );
+    }
+  }
+
+  free( clip );
+}
+
+/**
+ * Starts playing a clip from its first frame.
+ *
+ * @param animation_state_t* playback to start.
+ * @param animation_clip_t* clip to play.
+ * @param uint32_t STDS_ANIMATION_ONCE_MASK to stop on the last frame, or 0 to
+ *        loop.
+ *
+ * @return void.
+ */
+void
+Stds_PlayClip( struct animation_state_t *state, const struct animation_clip_t *clip,
+               const uint32_t flags ) {
+  state->clip  = clip;
+  state->time  = 0;
+  state->speed = 1.0f;
+  state->frame = 0;
+  state->flags = flags | STDS_ANIMATION_ACTIVE_MASK;
+}
+
+/**
+ * Advances a playback by dt seconds. A looping playback wraps around the
+ * clip; a playback started with STDS_ANIMATION_ONCE_MASK holds the last
+ * frame and goes inactive once it reaches the end.
+ *
+ * @param animation_state_t* playback to advance.
+ * @param float seconds since the last update.
+ *
+ * @return void.
+ */
+void
+Stds_AnimationStateUpdate( struct animation_state_t *state, const float dt ) {
+  Stds_AdvanceStates( state, 1, dt );
+}
+
+/**
+ * Draws the current frame of a playback. A width or height of 0 draws the
+ * frame at its own size.
+ *
+ * @param animation_state_t* playback to draw.
+ * @param float x
+ * @param float y
+ * @param float w
+ * @param float h
+ * @param uint16_t angle of rotation.
+ * @param SDL_RendererFlip flip.
+ * @param SDL_FPoint * rotation point, or NULL for the center.
+ * @param bool applies the camera offset or not.
+ *
+ * @return void.
+ */
+void
+Stds_AnimationStateDraw( const struct animation_state_t *state, const float x, const float y,
+                         const float w, const float h, const uint16_t angle,
+                         const SDL_RendererFlip flip, const SDL_FPoint *rotate_point,
+                         const bool camera_offset ) {
+  const SDL_Rect *rect = &state->clip->rects[state->frame];
+
+  Stds_BlitTexture( state->clip->textures[state->frame], rect, x, y, w > 0 ? w : rect->w,
+                    h > 0 ? h : rect->h, angle, flip, rotate_point, camera_offset );
+}
+
+/**
+ * Creates an animation that plays a shared clip. The clip is not copied and
+ * must outlive the animation.
+ *
+ * @param animation_clip_t* clip to play.
  *
  * @return animation_t* struct.
  */
 struct animation_t *
-Stds_AddAnimation( const char *directory, const uint8_t no_of_frames, const float frame_delay ) {
+Stds_AddAnimationFromClip( struct animation_clip_t *clip ) {
   struct animation_t *a;
-  a = malloc( sizeof( struct animation_t ) );
+  a = Stds_AllocAnimation();
 
-  if ( a == NULL ) {
-    SDL_LogInfo( SDL_LOG_CATEGORY_APPLICATION, "Could not allocate memory for animation_t. %s.\n",
-                 SDL_GetError() );
-    exit( EXIT_FAILURE );
+  a->clip   = clip;
+  a->frames = clip->textures;
+
+  if ( clip->flags & STDS_CLIP_SHEET ) {
+    a->id_flags |= STDS_SPRITE_SHEET_MASK;
+  } else if ( clip->flags & STDS_CLIP_OWNS_TEXTURES ) {
+    a->id_flags |= STDS_ANIMATION_MASK;
+  } else {
+    a->id_flags |= STDS_ATLAS_ANIMATION_MASK;
   }
 
-  memset( a, 0, sizeof( struct animation_t ) );
-  a->frames = malloc( sizeof( SDL_Texture * ) * no_of_frames );
+  a->flags |= STDS_ANIMATION_ACTIVE_MASK;
+  Stds_PlayClip( &a->state, clip, 0 );
+  Stds_SyncAnimation( a );
 
-  if ( a->frames == NULL ) {
-    SDL_LogInfo( SDL_LOG_CATEGORY_APPLICATION, "Could not allocate memory for a->frames. %s.\n",
-                 SDL_GetError() );
-    exit( EXIT_FAILURE );
+  a->dest_width  = a->sprite_width;
+  a->dest_height = a->sprite_height;
+
+  return a;
+}
+
+/**
+ * Adds a playback of clip to the animation system and returns its handle.
+ * The clip must outlive the instance. It draws nowhere until given a
+ * destination with Stds_SetAnimationInstanceDest.
+ *
+ * @param animation_clip_t* clip to play.
+ * @param uint32_t STDS_ANIMATION_ONCE_MASK to stop on the last frame, or 0 to
+ *        loop.
+ *
+ * @return int32_t handle of the instance.
+ */
+int32_t
+Stds_AddAnimationInstance( const struct animation_clip_t *clip, const uint32_t flags ) {
+  struct animation_system_t *sys = &animation_system;
+
+  Stds_GrowAnimationSystem();
+
+  int32_t handle = sys->free_count > 0 ? sys->free_handles[--sys->free_count] : sys->slot_count++;
+  int32_t index  = sys->count++;
+
+  Stds_PlayClip( &sys->states[index], clip, flags );
+  sys->dsts[index]    = ( SDL_FRect ){ 0, 0, -1, -1 };
+  sys->flips[index]   = SDL_FLIP_NONE;
+  sys->handles[index] = handle;
+  sys->slots[handle]  = index;
+
+  return handle;
+}
+
+/**
+ * Removes an instance from the animation system. The last instance takes
+ * its place, so pointers from Stds_GetAnimationInstance go stale.
+ *
+ * @param int32_t handle of the instance.
+ *
+ * @return void.
+ */
+void
+Stds_RemoveAnimationInstance( const int32_t handle ) {
+  struct animation_system_t *sys = &animation_system;
+
+  if ( Stds_GetAnimationInstance( handle ) == NULL ) {
+    return;
   }
 
-  a->number_of_frames = no_of_frames;
-  a->frame_delay      = frame_delay;
-  a->frame_timer      = frame_delay * FPS;
-  a->current_frame_id = 0;
+  int32_t index = sys->slots[handle];
+  int32_t last  = --sys->count;
 
-  SDL_QueryTexture( a->current_texture, NULL, NULL, &a->sprite_width, &a->sprite_height );
-  a->id_flags |= STDS_ANIMATION_MASK;
-  a->flags |= STDS_ANIMATION_ACTIVE_MASK;
+  sys->states[index]              = sys->states[last];
+  sys->dsts[index]                = sys->dsts[last];
+  sys->flips[index]               = sys->flips[last];
+  sys->handles[index]             = sys->handles[last];
+  sys->slots[sys->handles[index]] = index;
+
+  sys->slots[handle]                   = -1;
+  sys->free_handles[sys->free_count++] = handle;
+}
+
+/**
+ * Returns the playback state of an instance, to seek, pause (by clearing
+ * STDS_ANIMATION_ACTIVE_MASK) or change its speed. The pointer is valid
+ * until the next instance is added or removed.
+ *
+ * @param int32_t handle of the instance.
+ *
+ * @return animation_state_t * state, or NULL if the handle is not live.
+ */
+struct animation_state_t *
+Stds_GetAnimationInstance( const int32_t handle ) {
+  struct animation_system_t *sys = &animation_system;
+
+  if ( handle < 0 || handle >= sys->slot_count || sys->slots[handle] < 0 ) {
+    return NULL;
+  }
+
+  return &sys->states[sys->slots[handle]];
+}
+
+/**
+ * Sets where an instance draws. A width or height of 0 uses the frame's own
+ * size.
+ *
+ * @param int32_t handle of the instance.
+ * @param SDL_FRect * destination rectangle.
+ * @param SDL_RendererFlip flip.
+ *
+ * @return void.
+ */
+void
+Stds_SetAnimationInstanceDest( const int32_t handle, const SDL_FRect *dst,
+                               const SDL_RendererFlip flip ) {
+  struct animation_system_t *sys = &animation_system;
+
+  if ( Stds_GetAnimationInstance( handle ) != NULL ) {
+    sys->dsts[sys->slots[handle]]  = *dst;
+    sys->flips[sys->slots[handle]] = flip;
+  }
+}
+
+/**
+ * Chooses whether Stds_AnimationSystemUpdate splits its work across the job
+ * threads. It only does so when there is more than one chunk of
+ * STDS_ANIMATION_CHUNK instances.
+ *
+ * @param bool true to use the job system.
+ *
+ * @return void.
+ */
+void
+Stds_SetAnimationSystemParallel( const bool is_parallel ) {
+  animation_system.is_parallel = is_parallel;
+}
+
+/**
+ * Advances every instance of the animation system by dt seconds. Instances
+ * without STDS_ANIMATION_ACTIVE_MASK hold their frame, and those played
+ * with STDS_ANIMATION_ONCE_MASK stop on their last frame. When parallel,
+ * chunks run on the job threads and this returns once all of them are done.
+ *
+ * @param float seconds since the last update.
+ *
+ * @return void.
+ */
+void
+Stds_AnimationSystemUpdate( const float dt ) {
+  struct animation_system_t *sys = &animation_system;
+
+  if ( sys->is_parallel && sys->count > STDS_ANIMATION_CHUNK ) {
+    struct job_counter_t counter;
+    float                step = dt;
+
+    memset( &counter, 0, sizeof( struct job_counter_t ) );
+    Stds_JobParallelFor( Stds_AdvanceChunk, &step,
+                         ( sys->count + STDS_ANIMATION_CHUNK - 1 ) / STDS_ANIMATION_CHUNK, 1,
+                         &counter );
+    Stds_JobWait( &counter );
+  } else {
+    Stds_AdvanceStates( sys->states, sys->count, dt );
+  }
+}
+
+/**
+ * Draws every instance of the animation system that has a destination, all
+ * in one sprite batch on the given layer. Call this outside of any other
+ * batch.
+ *
+ * @param int32_t batch layer of the instances.
+ * @param bool applies the camera offset or not.
+ *
+ * @return void.
+ */
+void
+Stds_AnimationSystemDraw( const int32_t layer, const bool camera_offset ) {
+  const struct animation_system_t *sys = &animation_system;
+  const float                      cx  = camera_offset ? g_app.camera.x : 0;
+  const float                      cy  = camera_offset ? g_app.camera.y : 0;
+
+  Stds_BatchBegin();
+  for ( int32_t i = 0; i < sys->count; i++ ) {
+    const struct animation_state_t *s   = &sys->states[i];
+    const SDL_Rect *                src = &s->clip->rects[s->frame];
+    const SDL_FRect *               d   = &sys->dsts[i];
+
+    if ( d->w < 0 || d->h < 0 ) {
+      continue;
+    }
 
-  /* Iterate through the files in the directory and store them in
-     the buffer.  There is a lot of seemingly ugly C concatenation here,
-     but that's because it is :D*/
-  char        number_buffer[MAX_FILE_NUM_DIGITS];
-  const char *file_extsn = ".png";
-
-  for ( uint32_t i = 0; i < a->number_of_frames; i++ ) {
-    snprintf( number_buffer, MAX_FILE_NUM_DIGITS, "%d", i );
-    strncpy( input_buffer, directory, strlen( directory ) + 1 );
-    char *file_name     = strncat( input_buffer, number_buffer, strlen( number_buffer ) + 1 );
-    char *file_name_ext = strncat( input_buffer, file_extsn, strlen( file_extsn ) + 1 );
-    a->frames[i]        = Stds_LoadTexture( file_name_ext );
-    memset( input_buffer, '\0', sizeof( input_buffer ) );
+    SDL_FRect dst = { d->x - cx, d->y - cy, d->w > 0 ? d->w : ( float ) src->w,
+                      d->h > 0 ? d->h : ( float ) src->h };
+    Stds_BatchPush( s->clip->textures[s->frame], src, &dst, 0, NULL, sys->flips[i], NULL, layer );
   }
-  a->current_texture = a->frames[0];
-  a->default_texture = a->frames[0];
+  Stds_BatchEnd();
+}
+
+/**
+ * Frees the animation system and every instance in it. The clips are left
+ * to their owners.
+ *
+ * @param void.
+ *
+ * @return void.
+ */
+void
+Stds_AnimationSystemDie( void ) {
+  struct animation_system_t *sys = &animation_system;
+
+  free( sys->states );
+  free( sys->dsts );
+  free( sys->flips );
+  free( sys->handles );
+  free( sys->slots );
+  free( sys->free_handles );
+  memset( sys, 0, sizeof( struct animation_system_t ) );
+}
 
+/**
+ * Defines a sprite sheet object. Do note that dest_width and dest_height are
+ * used for scaling purposes. Do NOT modify sprite_width and sprite_height as
+ * these are the variables used for splicing.
+ *
+ * @param const char* file directory of sprite sheet.
+ * @param uint8_t number of frames.
+ * @param float time spent on an individual frame in seconds.
+ * @param uint16_t starting top-left x pos of the sprite sheet.
+ * @param uint16_t starting top-left y pos of the sprite sheet.
+ * @param size_t number of rows.
+ * @param size_t number of columns.
+ *
+ * @return animation_t* struct.
+ */
+struct animation_t *
+Stds_AddSpritesheet( const char *directory, const uint8_t no_of_frames, const float frame_delay,
+                     const uint16_t x, const uint16_t y, const size_t no_rows,
+                     const size_t no_cols ) {
+  struct animation_t *a = Stds_AddAnimationFromClip(
+      Stds_CreateSpritesheetClip( directory, no_of_frames, frame_delay, x, y, no_rows, no_cols ) );
+
+  a->flags |= STDS_ANIMATION_OWNS_CLIP_MASK;
   return a;
 }
 
 /**
- * Updates the animation type. If it is a sprite sheet, it
- * advances the coordinates used to keep track of the current
- * sprite in the sheet. Oppositely, if it is a series of images,
- * we just advance the pointer keeping track of each image. Once
- * the cycle ends, the pointer or coordinate is reset back to 0.
+ * The other way to use animations is to specify the
+ * directory of the animation files and the program
+ * will load them in. All sprites must have the same
+ * leading prefix, with a number at the end indicating
+ * their index in the sequence (ex. spr_0, spr_1, spr_2,
+ *, etc.). To refer to the current frame, use
+ * a->current_texture.
+ *
+ * @param const char* directory to files with file prefix.
+ * @param uint8_t number of frames.
+ * @param float time to spend on a individual frame in seconds.
+ *
+ * @return animation_t* struct.
+ */
+struct animation_t *
+Stds_AddAnimation( const char *directory, const uint8_t no_of_frames, const float frame_delay ) {
+  struct animation_t *a = Stds_AddAnimationFromClip(
+      Stds_CreateAnimationClip( directory, no_of_frames, frame_delay ) );
+
+  a->flags |= STDS_ANIMATION_OWNS_CLIP_MASK;
+  return a;
+}
+
+/**
+ * Loads the frames of an animation like Stds_AddAnimation, but packs them
+ * into an atlas instead of loading one texture per frame. Every frame then
+ * shares the atlas page texture and is drawn with its sub-rect, so many
+ * animations can be drawn without switching textures. Call Stds_AtlasUpload
+ * after adding the animations and before drawing them.
+ *
+ * @param atlas_t * atlas to pack the frames into.
+ * @param const char* directory to files with file prefix.
+ * @param uint8_t number of frames.
+ * @param float time to spend on a individual frame in seconds.
+ *
+ * @return animation_t* struct.
+ */
+struct animation_t *
+Stds_AddAnimationAtlas( struct atlas_t *atlas, const char *directory, const uint8_t no_of_frames,
+                        const float frame_delay ) {
+  struct animation_t *a = Stds_AddAnimationFromClip(
+      Stds_CreateAtlasClip( atlas, directory, no_of_frames, frame_delay ) );
+
+  a->flags |= STDS_ANIMATION_OWNS_CLIP_MASK;
+  return a;
+}
+
+/**
+ * Advances the animation by one update step: the fixed timestep when the
+ * game loop runs one, otherwise 1 / FPS. Once the cycle ends, it starts
+ * over, unless is_cycle_once is set, in which case the animation stops and
+ * goes back to its first frame.
  *
  * @param animation_t* animation to update.
  *
@@ -169,61 +551,33 @@ Stds_AddAnimation( const char *directory, const uint8_t no_of_frames, const floa
  */
 void
 Stds_AnimationUpdate( struct animation_t *a ) {
-  if ( a->flags & STDS_ANIMATION_ACTIVE_MASK )
-    a->frame_timer--;
-
-  if ( a->frame_timer < 0 ) {
-    /* Resets the frame countdown. */
-    a->frame_timer = a->frame_delay * FPS;
-
-    /* Increment the frame pointer. */
-    a->current_frame_id++;
-
-    /* If we reach the end of the animation sequence,
-       return to the start. */
-    if ( a->current_frame_id >= a->number_of_frames ) {
-      a->current_frame_id     = 0;
-      a->current_frame_col_id = 0;
-      a->current_frame_row_id = 0;
-    }
+  const float dt = g_app.clock.fixed_dt > 0 ? ( float ) g_app.clock.fixed_dt : 1.0f / FPS;
 
-    /* If we have a spritesheet, we advance x coordinate
-       of the sprite. Otherwise, we advance the pointer
-       referencing which sprite to render in the array. */
-    if ( a->id_flags & STDS_SPRITE_SHEET_MASK ) {
-      a->splice.x = a->current_frame_col_id * a->sprite_width;
-      a->splice.y = a->current_frame_row_id * a->sprite_height;
+  if ( !( a->flags & STDS_ANIMATION_ACTIVE_MASK ) ) {
+    return;
+  }
 
-      a->current_frame_col_id++;
+  if ( a->is_cycle_once ) {
+    a->state.flags |= STDS_ANIMATION_ONCE_MASK;
+  }
 
-      /* If we reach the end of the row in the sheet, we need
-         to go down a row and reset the column id. */
-      if ( a->current_frame_col_id == a->cols_count ) {
-        a->current_frame_col_id = 0;
-        a->current_frame_row_id++;
-      }
-    } else {
-      /* Get the sprite and make sure its dimensions haven't changed! */
-      a->current_texture = a->frames[a->current_frame_id];
-      SDL_QueryTexture( a->current_texture, NULL, NULL, &a->sprite_width, &a->sprite_height );
-    }
+  Stds_AnimationStateUpdate( &a->state, dt );
 
-    /* If we have the flag enabled to cycle through the animation
-       only once (and we just finished), deactivate the flag to
-       continue and quit. */
-    if ( a->is_cycle_once ) {
-      a->flags ^= STDS_ANIMATION_ACTIVE_MASK;
-      a->is_cycle_once        = false;
-      a->current_frame_id     = 0;
-      a->current_frame_col_id = 0;
-      a->current_frame_row_id = 0;
-      return;
-    }
+  /* If we have the flag enabled to cycle through the animation
+     only once (and we just finished), deactivate the flag to
+     continue and quit. */
+  if ( !( a->state.flags & STDS_ANIMATION_ACTIVE_MASK ) ) {
+    a->flags &= ~( uint32_t ) STDS_ANIMATION_ACTIVE_MASK;
+    a->is_cycle_once = false;
+    Stds_PlayClip( &a->state, a->clip, 0 );
   }
+
+  Stds_SyncAnimation( a );
 }
 
 /**
- * Draws the animation.
+ * Draws the animation. Sprite sheets are drawn at dest_width x dest_height,
+ * other animations at the size of their current frame.
  *
  * @param animation_t* animation to draw.
  *
@@ -232,25 +586,35 @@ Stds_AnimationUpdate( struct animation_t *a ) {
 void
 Stds_AnimationDraw( const struct animation_t *a ) {
   if ( a->flags & STDS_ANIMATION_ACTIVE_MASK ) {
-    if ( a->id_flags & STDS_ANIMATION_MASK ) {
-
-      Stds_DrawTexture( a->frames[a->current_frame_id], a->pos.x, a->pos.y, a->sprite_width,
-                        a->sprite_height, a->angle, a->flip, a->rotate_point,
-                        a->is_camera_offset_enabled );
-    } else if ( a->id_flags & STDS_SPRITE_SHEET_MASK ) {
-      /* This rectangle splices the correct frame
-         from the sprite sheet. */
-      SDL_Rect curr_rect = { ( int32_t ) a->splice.x, ( int32_t ) a->splice.y, a->sprite_width,
-                             a->sprite_height };
-
-      Stds_BlitTexture( a->current_texture, &curr_rect, a->pos.x, a->pos.y, a->dest_width,
-                        a->dest_height, a->angle, a->flip, a->rotate_point, false );
+    if ( a->id_flags & STDS_SPRITE_SHEET_MASK ) {
+      Stds_AnimationStateDraw( &a->state, a->pos.x, a->pos.y, a->dest_width, a->dest_height,
+                               a->angle, a->flip, a->rotate_point, false );
+    } else {
+      Stds_AnimationStateDraw( &a->state, a->pos.x, a->pos.y, a->sprite_width,
+                               a->sprite_height, a->angle, a->flip, a->rotate_point,
+                               a->is_camera_offset_enabled );
     }
   }
 }
 
 /**
- * Destroys and frees the animation passed by the entity.
+ * Starts an animation over from its first frame and makes it active again.
+ *
+ * @param animation_t* animation to restart.
+ *
+ * @return void.
+ */
+void
+Stds_RestartAnimation( struct animation_t *a ) {
+  a->flags |= STDS_ANIMATION_ACTIVE_MASK;
+  a->is_cycle_once = false;
+  Stds_PlayClip( &a->state, a->clip, 0 );
+  Stds_SyncAnimation( a );
+}
+
+/**
+ * Destroys and frees the animation passed by the entity, along with its
+ * clip if the animation loaded it.
  *
  * @param animation_t* animation to free from memory.
  *
@@ -258,11 +622,165 @@ Stds_AnimationDraw( const struct animation_t *a ) {
  */
 void
 Stds_AnimationDie( struct animation_t *a ) {
-  for ( uint32_t i = 0; i < a->number_of_frames; i++ ) {
-    SDL_DestroyTexture( a->frames[i] );
+  if ( a->flags & STDS_ANIMATION_OWNS_CLIP_MASK ) {
+    Stds_ClipDie( a->clip );
+  }
+
+  Stds_PoolFree( animation_pool, a );
+}
+
+/**
+ * Takes a zeroed animation_t from its pool.
+ *
+ * @param void.
+ *
+ * @return animation_t * new animation.
+ */
+static struct animation_t *
+Stds_AllocAnimation( void ) {
+  if ( animation_pool == NULL ) {
+    animation_pool = Stds_PoolCreate( sizeof( struct animation_t ), STDS_OBJECT_POOL_BLOCK );
+  }
+
+  return Stds_PoolAlloc( animation_pool );
+}
+
+/**
+ * Allocates a clip with room for count frames right behind it.
+ *
+ * @param int32_t number of frames.
+ * @param float seconds per frame.
+ * @param uint32_t STDS_CLIP_ flags.
+ *
+ * @return animation_clip_t * new clip with unset frames.
+ */
+static struct animation_clip_t *
+Stds_AllocClip( const int32_t count, const float frame_delay, const uint32_t flags ) {
+  struct animation_clip_t *clip
+      = malloc( sizeof( struct animation_clip_t )
+                + ( sizeof( SDL_Texture * ) + sizeof( SDL_Rect ) ) * ( size_t ) count );
+
+  if ( clip == NULL ) {
+    SDL_LogInfo( SDL_LOG_CATEGORY_APPLICATION,
+                 "Could not allocate memory for animation_clip_t. %s.\n", SDL_GetError() );
+    exit( EXIT_FAILURE );
   }
 
-  SDL_DestroyTexture( a->current_texture );
-  free( a->frames );
-  free( a );
+  clip->textures    = ( SDL_Texture ** ) ( clip + 1 );
+  clip->rects       = ( SDL_Rect * ) ( clip->textures + count );
+  clip->frame_delay = frame_delay;
+  clip->duration    = frame_delay * ( float ) count;
+  clip->frame_count = count;
+  clip->flags       = flags;
+
+  return clip;
+}
+
+/**
+ * Advances count playback states by dt seconds. The loop has no branches
+ * on the state itself: inactive states step by zero, and once states clamp
+ * where looping ones wrap, so it compiles to selects.
+ *
+ * @param animation_state_t * states to advance.
+ * @param int32_t number of states.
+ * @param float seconds since the last update.
+ *
+ * @return void.
+ */
+static void
+Stds_AdvanceStates( struct animation_state_t *states, const int32_t count, const float dt ) {
+  for ( int32_t i = 0; i < count; i++ ) {
+    struct animation_state_t *     s    = &states[i];
+    const struct animation_clip_t *clip = s->clip;
+
+    const float active    = ( s->flags & STDS_ANIMATION_ACTIVE_MASK ) ? 1.0f : 0.0f;
+    const bool  is_once   = ( s->flags & STDS_ANIMATION_ONCE_MASK ) != 0;
+    const float duration  = clip->duration;
+    const float inv_cycle = duration > 0 ? 1.0f / duration : 0;
+    const float inv_frame = clip->frame_delay > 0 ? 1.0f / clip->frame_delay : 0;
+
+    float      t       = s->time + dt * s->speed * active;
+    const bool is_done = is_once && t >= duration;
+
+    t = is_once ? fminf( t, duration ) : t - duration * floorf( t * inv_cycle );
+
+    /* The end of a once clip (and rounding) lands past the last frame. */
+    int32_t frame = ( int32_t ) ( t * inv_frame );
+    frame         = frame < clip->frame_count ? frame : clip->frame_count - 1;
+
+    s->time  = t;
+    s->frame = frame;
+    s->flags &= ~( is_done ? ( uint32_t ) STDS_ANIMATION_ACTIVE_MASK : 0u );
+  }
+}
+
+/**
+ * Job that advances one chunk of the animation system.
+ *
+ * @param void * pointer to the float step in seconds.
+ * @param int32_t chunk index.
+ *
+ * @return void.
+ */
+static void
+Stds_AdvanceChunk( void *data, int32_t chunk ) {
+  struct animation_system_t *sys   = &animation_system;
+  const int32_t              first = chunk * STDS_ANIMATION_CHUNK;
+  const int32_t              left  = sys->count - first;
+
+  Stds_AdvanceStates( &sys->states[first],
+                      left < STDS_ANIMATION_CHUNK ? left : STDS_ANIMATION_CHUNK,
+                      *( const float * ) data );
+}
+
+/**
+ * Makes room for one more instance in the animation system.
+ *
+ * @param void.
+ *
+ * @return void.
+ */
+static void
+Stds_GrowAnimationSystem( void ) {
+  struct animation_system_t *sys = &animation_system;
+
+  if ( sys->count < sys->capacity ) {
+    return;
+  }
+
+  size_t n      = sys->capacity > 0 ? ( size_t ) sys->capacity * 2 : STDS_ANIMATION_CHUNK;
+  sys->states   = realloc( sys->states, sizeof( struct animation_state_t ) * n );
+  sys->dsts     = realloc( sys->dsts, sizeof( SDL_FRect ) * n );
+  sys->flips    = realloc( sys->flips, sizeof( SDL_RendererFlip ) * n );
+  sys->handles  = realloc( sys->handles, sizeof( int32_t ) * n );
+  sys->capacity = ( int32_t ) n;
+
+  /* Every live or freed handle is below count + free_count <= capacity. */
+  sys->slots        = realloc( sys->slots, sizeof( int32_t ) * n );
+  sys->free_handles = realloc( sys->free_handles, sizeof( int32_t ) * n );
+
+  if ( sys->states == NULL || sys->dsts == NULL || sys->flips == NULL || sys->handles == NULL
+       || sys->slots == NULL || sys->free_handles == NULL ) {
+    SDL_LogInfo( SDL_LOG_CATEGORY_APPLICATION,
+                 "Could not allocate memory for animation_system_t. %s.\n", SDL_GetError() );
+    exit( EXIT_FAILURE );
+  }
+}
+
+/**
+ * Copies the current frame of an animation's playback into the fields that
+ * older callers read.
+ *
+ * @param animation_t * animation.
+ *
+ * @return void.
+ */
+static void
+Stds_SyncAnimation( struct animation_t *a ) {
+  const int32_t frame = a->state.frame;
+
+  a->current_frame_id = ( uint8_t ) frame;
+  a->current_texture  = a->clip->textures[frame];
+  a->sprite_width     = a->clip->rects[frame].w;
+  a->sprite_height    = a->clip->rects[frame].h;
 }
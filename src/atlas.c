@@ -0,0 +1,401 @@
+/**
+ * @file atlas.c
+ * @author Joshua Crotts
+ * @date October 14 2026
+ * @version 1.0
+ *
+ * @section LICENSE
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License as
+ * published by the Free Software Foundation; either version 2 of
+ * the License, or (at your option) any later version.
+ *
+ * @section DESCRIPTION
+ *
+ * This file defines a runtime texture atlas. Images are packed into large
+ * RGBA pages with a skyline (bottom-left) packer, so sprites that would
+ * otherwise each own an SDL_Texture share one and can be drawn in a single
+ * batch. Packing happens on CPU-side surfaces; Stds_AtlasUpload copies the
+ * changed pages into their textures.
+ */
+#include "../include/atlas.h"
+
+static int32_t Stds_AtlasAddPage( struct atlas_t *atlas );
+static bool    Stds_AtlasPackOnPage( struct atlas_page_t *page, const int32_t page_width,
+                                     const int32_t page_height, const int32_t w, const int32_t h,
+                                     SDL_Rect *out );
+static int32_t Stds_SkylineFit( const struct atlas_page_t *page, const int32_t index,
+                                const int32_t page_width, const int32_t page_height,
+                                const int32_t w, const int32_t h );
+static void    Stds_SkylineInsert( struct atlas_page_t *page, const int32_t index,
+                                   const SDL_Rect *rect );
+
+/**
+ * Creates an empty atlas whose pages are page_width x page_height pixels.
+ * Pass 0 for either dimension to use STDS_ATLAS_PAGE_SIZE. Images are
+ * separated by one pixel of padding so linear filtering does not bleed
+ * neighbours into each other.
+ *
+ * @param int32_t width of each page.
+ * @param int32_t height of each page.
+ *
+ * @return atlas_t * pointer to atlas.
+ */
+struct atlas_t *
+Stds_AtlasCreate( const int32_t page_width, const int32_t page_height ) {
+  struct atlas_t *atlas;
+  atlas = malloc( sizeof( struct atlas_t ) );
+
+  if ( atlas == NULL ) {
+    SDL_LogInfo( SDL_LOG_CATEGORY_APPLICATION, "Could not allocate memory for atlas_t. %s.\n",
+                 SDL_GetError() );
+    exit( EXIT_FAILURE );
+  }
+
+  memset( atlas, 0, sizeof( struct atlas_t ) );
+
+  atlas->page_width  = page_width > 0 ? page_width : STDS_ATLAS_PAGE_SIZE;
+  atlas->page_height = page_height > 0 ? page_height : STDS_ATLAS_PAGE_SIZE;
+  atlas->padding     = 1;
+
+  return atlas;
+}
+
+/**
+ * Loads an image from disk and packs it into the atlas.
+ *
+ * @param atlas_t * pointer to atlas.
+ * @param const char * path to image.
+ *
+ * @return int32_t region index, or -1 if the image does not fit on a page.
+ */
+int32_t
+Stds_AtlasAddImage( struct atlas_t *atlas, const char *file_name ) {
+  SDL_Surface *surface = IMG_Load( file_name );
+
+  if ( surface == NULL ) {
+    SDL_LogInfo( SDL_LOG_CATEGORY_APPLICATION, "Error: %s", SDL_GetError() );
+    exit( EXIT_FAILURE );
+  }
+
+  int32_t region = Stds_AtlasAddSurface( atlas, surface );
+  SDL_FreeSurface( surface );
+
+  return region;
+}
+
+/**
+ * Packs a copy of the surface into the atlas. The caller keeps ownership of
+ * the surface. The region's texture is usable right away, but its pixels
+ * only reach the GPU on the next Stds_AtlasUpload.
+ *
+ * @param atlas_t * pointer to atlas.
+ * @param SDL_Surface * surface to copy in.
+ *
+ * @return int32_t region index, or -1 if the surface does not fit on a page.
+ */
+int32_t
+Stds_AtlasAddSurface( struct atlas_t *atlas, SDL_Surface *surface ) {
+  int32_t w = surface->w + atlas->padding;
+  int32_t h = surface->h + atlas->padding;
+
+  if ( w > atlas->page_width || h > atlas->page_height ) {
+    SDL_LogInfo( SDL_LOG_CATEGORY_APPLICATION,
+                 "Error: image of %dx%d does not fit on an atlas page of %dx%d.\n", surface->w,
+                 surface->h, atlas->page_width, atlas->page_height );
+    return -1;
+  }
+
+  SDL_Rect rect;
+  int32_t  page = 0;
+
+  /* Earlier pages may still have holes, so try them all before adding one. */
+  while ( page < atlas->page_count && !Stds_AtlasPackOnPage( &atlas->pages[page], atlas->page_width,
+                                                             atlas->page_height, w, h, &rect ) ) {
+    page++;
+  }
+
+  if ( page == atlas->page_count ) {
+    page = Stds_AtlasAddPage( atlas );
+    Stds_AtlasPackOnPage( &atlas->pages[page], atlas->page_width, atlas->page_height, w, h, &rect );
+  }
+
+  rect.w = surface->w;
+  rect.h = surface->h;
+
+  struct atlas_page_t *p = &atlas->pages[page];
+  SDL_BlendMode        mode;
+  SDL_GetSurfaceBlendMode( surface, &mode );
+  SDL_SetSurfaceBlendMode( surface, SDL_BLENDMODE_NONE );
+  SDL_BlitSurface( surface, NULL, p->surface, &rect );
+  SDL_SetSurfaceBlendMode( surface, mode );
+  p->is_dirty = true;
+
+  if ( atlas->region_count == atlas->region_capacity ) {
+    atlas->region_capacity = atlas->region_capacity == 0 ? 64 : atlas->region_capacity * 2;
+    atlas->regions         = realloc( atlas->regions,
+                              sizeof( struct atlas_region_t ) * ( size_t ) atlas->region_capacity );
+
+    if ( atlas->regions == NULL ) {
+      SDL_LogInfo( SDL_LOG_CATEGORY_APPLICATION,
+                   "Could not allocate memory for atlas_region_t. %s.\n", SDL_GetError() );
+      exit( EXIT_FAILURE );
+    }
+  }
+
+  struct atlas_region_t *r = &atlas->regions[atlas->region_count];
+  r->texture               = p->texture;
+  r->rect                  = rect;
+  r->page                  = page;
+
+  return atlas->region_count++;
+}
+
+/**
+ * Copies every page changed since the last upload into its texture. Call
+ * this once after adding a batch of images, before drawing from them.
+ *
+ * @param atlas_t * pointer to atlas.
+ *
+ * @return void.
+ */
+void
+Stds_AtlasUpload( struct atlas_t *atlas ) {
+  for ( int32_t i = 0; i < atlas->page_count; i++ ) {
+    struct atlas_page_t *page = &atlas->pages[i];
+    if ( page->is_dirty ) {
+      SDL_UpdateTexture( page->texture, NULL, page->surface->pixels, page->surface->pitch );
+      page->is_dirty = false;
+    }
+  }
+}
+
+/**
+ * Returns a packed region. Its texture and rect can be passed straight to
+ * Stds_BlitTexture or Stds_DrawQuads.
+ *
+ * @param atlas_t * pointer to atlas.
+ * @param int32_t region index.
+ *
+ * @return atlas_region_t * pointer to region, or NULL if the index is invalid.
+ */
+const struct atlas_region_t *
+Stds_AtlasGetRegion( const struct atlas_t *atlas, const int32_t region ) {
+  if ( region < 0 || region >= atlas->region_count ) {
+    return NULL;
+  }
+
+  return &atlas->regions[region];
+}
+
+/**
+ * Frees the atlas. This destroys every page texture, so any animation or
+ * region that still refers to them must not be drawn afterwards.
+ *
+ * @param atlas_t * pointer to atlas.
+ *
+ * @return void.
+ */
+void
+Stds_AtlasDie( struct atlas_t *atlas ) {
+  for ( int32_t i = 0; i < atlas->page_count; i++ ) {
+    SDL_FreeSurface( atlas->pages[i].surface );
+    Stds_ForgetTextureState( atlas->pages[i].texture );
+    SDL_DestroyTexture( atlas->pages[i].texture );
+    free( atlas->pages[i].nodes );
+  }
+
+  free( atlas->pages );
+  free( atlas->regions );
+  free( atlas );
+}
+
+/**
+ * Appends an empty page with a flat skyline.
+ *
+ * @param atlas_t * pointer to atlas.
+ *
+ * @return int32_t index of the new page.
+ */
+static int32_t
+Stds_AtlasAddPage( struct atlas_t *atlas ) {
+  atlas->pages =
+    realloc( atlas->pages, sizeof( struct atlas_page_t ) * ( size_t )( atlas->page_count + 1 ) );
+
+  if ( atlas->pages == NULL ) {
+    SDL_LogInfo( SDL_LOG_CATEGORY_APPLICATION, "Could not allocate memory for atlas_page_t. %s.\n",
+                 SDL_GetError() );
+    exit( EXIT_FAILURE );
+  }
+
+  struct atlas_page_t *page = &atlas->pages[atlas->page_count];
+  memset( page, 0, sizeof( struct atlas_page_t ) );
+
+  page->surface = SDL_CreateRGBSurfaceWithFormat( 0, atlas->page_width, atlas->page_height, 32,
+                                                  SDL_PIXELFORMAT_RGBA32 );
+  page->texture = SDL_CreateTexture( g_app.renderer, SDL_PIXELFORMAT_RGBA32,
+                                     SDL_TEXTUREACCESS_STATIC, atlas->page_width,
+                                     atlas->page_height );
+
+  if ( page->surface == NULL || page->texture == NULL ) {
+    SDL_LogInfo( SDL_LOG_CATEGORY_APPLICATION, "Could not create atlas page. %s.\n",
+                 SDL_GetError() );
+    exit( EXIT_FAILURE );
+  }
+
+  memset( page->surface->pixels, 0, ( size_t ) page->surface->pitch * ( size_t ) page->surface->h );
+  Stds_SetTextureBlendMode( page->texture, SDL_BLENDMODE_BLEND );
+
+  page->node_capacity = 16;
+  page->nodes         = malloc( sizeof( struct atlas_node_t ) * ( size_t ) page->node_capacity );
+
+  if ( page->nodes == NULL ) {
+    SDL_LogInfo( SDL_LOG_CATEGORY_APPLICATION, "Could not allocate memory for atlas_node_t. %s.\n",
+                 SDL_GetError() );
+    exit( EXIT_FAILURE );
+  }
+
+  page->nodes[0]   = ( struct atlas_node_t ){ 0, 0, atlas->page_width };
+  page->node_count = 1;
+
+  return atlas->page_count++;
+}
+
+/**
+ * Finds the skyline position where a w x h rectangle ends up lowest, and
+ * claims it. Ties go to the leftmost position.
+ *
+ * @param atlas_page_t * pointer to page.
+ * @param int32_t page width.
+ * @param int32_t page height.
+ * @param int32_t width to pack, including padding.
+ * @param int32_t height to pack, including padding.
+ * @param SDL_Rect * receives the top-left corner of the packed rectangle.
+ *
+ * @return bool true if the rectangle fit on the page.
+ */
+static bool
+Stds_AtlasPackOnPage( struct atlas_page_t *page, const int32_t page_width,
+                      const int32_t page_height, const int32_t w, const int32_t h, SDL_Rect *out ) {
+  int32_t best_index = -1;
+  int32_t best_top   = INT32_MAX;
+  int32_t best_y     = 0;
+
+  for ( int32_t i = 0; i < page->node_count; i++ ) {
+    int32_t y = Stds_SkylineFit( page, i, page_width, page_height, w, h );
+    if ( y >= 0 && y + h < best_top ) {
+      best_index = i;
+      best_top   = y + h;
+      best_y     = y;
+    }
+  }
+
+  if ( best_index == -1 ) {
+    return false;
+  }
+
+  *out = ( SDL_Rect ){ page->nodes[best_index].x, best_y, w, h };
+  Stds_SkylineInsert( page, best_index, out );
+
+  return true;
+}
+
+/**
+ * Returns the y at which a w x h rectangle whose left edge sits on skyline
+ * node index would rest, or -1 if it would leave the page.
+ *
+ * @param atlas_page_t * pointer to page.
+ * @param int32_t skyline node index.
+ * @param int32_t page width.
+ * @param int32_t page height.
+ * @param int32_t width to pack.
+ * @param int32_t height to pack.
+ *
+ * @return int32_t resting y, or -1.
+ */
+static int32_t
+Stds_SkylineFit( const struct atlas_page_t *page, const int32_t index, const int32_t page_width,
+                 const int32_t page_height, const int32_t w, const int32_t h ) {
+  int32_t x = page->nodes[index].x;
+  if ( x + w > page_width ) {
+    return -1;
+  }
+
+  int32_t y          = 0;
+  int32_t width_left = w;
+
+  for ( int32_t i = index; width_left > 0 && i < page->node_count; i++ ) {
+    if ( page->nodes[i].y > y ) {
+      y = page->nodes[i].y;
+    }
+
+    if ( y + h > page_height ) {
+      return -1;
+    }
+
+    width_left -= page->nodes[i].w;
+  }
+
+  return y;
+}
+
+/**
+ * Raises the skyline over the packed rectangle: a new node is inserted at
+ * index, the nodes it covers are trimmed or removed, and neighbours at the
+ * same height are merged.
+ *
+ * @param atlas_page_t * pointer to page.
+ * @param int32_t skyline node index the rectangle starts on.
+ * @param SDL_Rect * packed rectangle, including padding.
+ *
+ * @return void.
+ */
+static void
+Stds_SkylineInsert( struct atlas_page_t *page, const int32_t index, const SDL_Rect *rect ) {
+  if ( page->node_count == page->node_capacity ) {
+    page->node_capacity *= 2;
+    page->nodes =
+      realloc( page->nodes, sizeof( struct atlas_node_t ) * ( size_t ) page->node_capacity );
+
+    if ( page->nodes == NULL ) {
+      SDL_LogInfo( SDL_LOG_CATEGORY_APPLICATION,
+                   "Could not allocate memory for atlas_node_t. %s.\n", SDL_GetError() );
+      exit( EXIT_FAILURE );
+    }
+  }
+
+  memmove( &page->nodes[index + 1], &page->nodes[index],
+           sizeof( struct atlas_node_t ) * ( size_t )( page->node_count - index ) );
+  page->nodes[index] = ( struct atlas_node_t ){ rect->x, rect->y + rect->h, rect->w };
+  page->node_count++;
+
+  /* Trim the nodes now hidden under the new one. */
+  int32_t right = rect->x + rect->w;
+  int32_t i     = index + 1;
+  while ( i < page->node_count && page->nodes[i].x < right ) {
+    int32_t shrink = right - page->nodes[i].x;
+
+    if ( shrink >= page->nodes[i].w ) {
+      memmove( &page->nodes[i], &page->nodes[i + 1],
+               sizeof( struct atlas_node_t ) * ( size_t )( page->node_count - i - 1 ) );
+      page->node_count--;
+    } else {
+      page->nodes[i].x += shrink;
+      page->nodes[i].w -= shrink;
+      break;
+    }
+  }
+
+  /* Merge neighbours at the same height. */
+  for ( i = 0; i < page->node_count - 1; ) {
+    if ( page->nodes[i].y == page->nodes[i + 1].y ) {
+      page->nodes[i].w += page->nodes[i + 1].w;
+      memmove( &page->nodes[i + 1], &page->nodes[i + 2],
+               sizeof( struct atlas_node_t ) * ( size_t )( page->node_count - i - 2 ) );
+      page->node_count--;
+    } else {
+      i++;
+    }
+  }
+}
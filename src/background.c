@@ -14,11 +14,23 @@
  * @section DESCRIPTION
  *
  * This file defines the background functionality, both regular and parallax.
+ * Parallax layers tile across the screen with one quad per visible copy, all
+ * submitted in one call, and neighbouring layers that always move together
+ * can be flattened into a single render-target texture. A flattened layer keeps
+ * the cache handles of its sources, and draws them into its texture again after
+ * the renderer reports that render targets were reset.
  */
 #include "../include/background.h"
 
+#define STDS_PARALLAX_TILES 16
+
 static char input_buffer[MAX_BUFFER_SIZE];
 
+static bool Stds_CanCompositeLayers( const struct parallax_background_t *,
+                                     const struct parallax_background_t * );
+static void Stds_CompositeLayers( struct parallax_background_t *, const int32_t );
+static void Stds_DrawComposite( struct background_t * );
+
 /**
  * Loads in the parallax images specified by the directory.
  * These images should be labeled in back-to-front order.
@@ -102,9 +114,11 @@ Stds_ParallaxBackgroundUpdate( struct parallax_background_t *p ) {
 }
 
 /**
- * Draws the parallax background frame. Two copies of the image
- * are drawn to provide the illusion of infinite scrolling if
- * specified by the boolean in the struct.
+ * Draws the parallax background frame, repeated horizontally so that it
+ * covers the screen wherever it has scrolled to. Only the visible part of
+ * each copy is drawn: the copies are cut at the screen edges through their
+ * source rectangles and go out together through Stds_DrawQuads, so a layer
+ * costs one SDL_RenderGeometry call and one screen of fill.
  *
  * @param parallax_background_t pointer to struct.
  *
@@ -112,12 +126,198 @@ Stds_ParallaxBackgroundUpdate( struct parallax_background_t *p ) {
  */
 void
 Stds_ParallaxBackgroundDraw( const struct parallax_background_t *p ) {
-  /* Two copies of the image are drawn to give the illusion of depth and parallax. */
-  Stds_DrawTexture( p->background->background_texture, p->background->pos.x, p->background->pos.y,
-                    p->background->w, p->background->h, 0, SDL_FLIP_NONE, NULL, false );
-  Stds_DrawTexture( p->background->background_texture, p->background->pos.x + p->background->w,
-                    p->background->pos.y, p->background->w, p->background->h, 0, SDL_FLIP_NONE,
-                    NULL, false );
+  struct background_t *bg = p->background;
+  SDL_FRect            dst[STDS_PARALLAX_TILES];
+  SDL_Rect             src[STDS_PARALLAX_TILES];
+  int32_t              tiles = 0;
+
+  if ( bg->w <= 0 ) {
+    return;
+  }
+
+  if ( bg->composite_handles != NULL && bg->target_resets != g_app.target_resets
+       && !Stds_IsRecordingCommands() ) {
+    Stds_DrawComposite( bg );
+  }
+
+  /* Left edge of the copy that covers the left of the screen, in (-w, 0]. */
+  float x = fmodf( bg->pos.x, ( float ) bg->w );
+  if ( x > 0 ) {
+    x -= ( float ) bg->w;
+  }
+
+  while ( x < ( float ) g_app.SCREEN_WIDTH ) {
+    int32_t first = x < 0 ? ( int32_t ) -x : 0;
+    int32_t last  = ( int32_t ) ceilf( ( float ) g_app.SCREEN_WIDTH - x );
+
+    if ( last > bg->w ) {
+      last = bg->w;
+    }
+
+    src[tiles] = ( SDL_Rect ){ first, 0, last - first, bg->h };
+    dst[tiles] = ( SDL_FRect ){ x + ( float ) first, bg->pos.y, ( float ) ( last - first ),
+                                ( float ) bg->h };
+    x += ( float ) bg->w;
+
+    if ( ++tiles == STDS_PARALLAX_TILES ) {
+      Stds_DrawQuads( bg->background_texture, dst, src, NULL, tiles, false );
+      tiles = 0;
+    }
+  }
+
+  if ( tiles > 0 ) {
+    Stds_DrawQuads( bg->background_texture, dst, src, NULL, tiles, false );
+  }
+}
+
+/**
+ * Flattens every run of neighbouring parallax layers whose offset from one
+ * another can never change into one render-target texture. Layers move
+ * together when they share their scroll speed, scroll mode, position and
+ * size. Each such run is drawn once, back to front, into a new texture that
+ * replaces the first layer's, and the rest of the run is unlinked and freed.
+ * Their source textures are released to the texture cache. Call this on the main
+ * thread after the last Stds_AddParallaxBackground and outside of command
+ * recording. Nothing happens if the renderer has no render targets.
+ *
+ * @param void.
+ *
+ * @return void.
+ */
+void
+Stds_CompositeParallaxBackgrounds( void ) {
+  if ( !SDL_RenderTargetSupported( g_app.renderer ) ) {
+    return;
+  }
+
+  for ( struct parallax_background_t *p = g_app.parallax_head.next; p != NULL; p = p->next ) {
+    int32_t                       run = 1;
+    struct parallax_background_t *q   = p->next;
+
+    for ( ; q != NULL && Stds_CanCompositeLayers( p, q ); q = q->next ) {
+      run++;
+    }
+
+    if ( run > 1 ) {
+      Stds_CompositeLayers( p, run );
+    }
+  }
+}
+
+/**
+ * Determines whether two parallax layers always keep the same offset from
+ * one another.
+ *
+ * @param parallax_background_t * first layer.
+ * @param parallax_background_t * second layer.
+ *
+ * @return bool true if the layers move together.
+ */
+static bool
+Stds_CanCompositeLayers( const struct parallax_background_t *a,
+                         const struct parallax_background_t *b ) {
+  return a->normal_scroll_speed * a->parallax_scroll_speed
+             == b->normal_scroll_speed * b->parallax_scroll_speed
+         && a->infinite_scroll == b->infinite_scroll && a->background->w == b->background->w
+         && a->background->h == b->background->h && a->background->pos.x == b->background->pos.x
+         && a->background->pos.y == b->background->pos.y;
+}
+
+/**
+ * Draws count layers starting at first into one target texture, gives it to
+ * first and frees the layers after it. Runs with a layer whose texture is not
+ * from the texture cache are left alone, since they could not be drawn again.
+ *
+ * @param parallax_background_t * first layer of the run.
+ * @param int32_t number of layers in the run.
+ *
+ * @return void.
+ */
+static void
+Stds_CompositeLayers( struct parallax_background_t *first, const int32_t count ) {
+  int32_t *handles = malloc( sizeof( int32_t ) * ( size_t ) count );
+
+  if ( handles == NULL ) {
+    SDL_LogInfo( SDL_LOG_CATEGORY_APPLICATION,
+                 "Could not allocate memory for composite handles. %s.\n", SDL_GetError() );
+    exit( EXIT_FAILURE );
+  }
+
+  struct parallax_background_t *p = first;
+  for ( int32_t i = 0; i < count; i++, p = p->next ) {
+    handles[i] = Stds_FindTextureHandle( p->background->background_texture );
+
+    if ( handles[i] == -1 ) {
+      SDL_LogDebug( SDL_LOG_CATEGORY_APPLICATION,
+                    "Parallax layer texture is not cached, not compositing its run.\n" );
+      free( handles );
+      return;
+    }
+  }
+
+  SDL_Texture *target = SDL_CreateTexture( g_app.renderer, SDL_PIXELFORMAT_RGBA8888,
+                                           SDL_TEXTUREACCESS_TARGET, first->background->w,
+                                           first->background->h );
+
+  if ( target == NULL ) {
+    SDL_LogInfo( SDL_LOG_CATEGORY_APPLICATION,
+                 "Could not create parallax composite texture. %s.\n", SDL_GetError() );
+    free( handles );
+    return;
+  }
+
+  SDL_Texture *source = first->background->background_texture;
+  Stds_SetTextureBlendMode( target, SDL_BLENDMODE_BLEND );
+  first->background->background_texture = target;
+  first->background->composite_handles  = handles;
+  first->background->composite_count    = count;
+  Stds_DrawComposite( first->background );
+  Stds_ReleaseTexture( source );
+
+  /* The merged layers give back their textures, which the cache may now evict. */
+  for ( int32_t i = 1; i < count; i++ ) {
+    struct parallax_background_t *merged = first->next;
+
+    first->next = merged->next;
+    if ( g_app.parallax_tail == merged ) {
+      g_app.parallax_tail = first;
+    }
+
+    Stds_BackgroundDie( merged->background );
+    free( merged );
+  }
+}
+
+/**
+ * Draws the source layers of a composited background into its texture. The
+ * first layer is copied with no blending so the target takes its alpha as
+ * is; the rest blend over it. Sources the cache evicted are read back in.
+ *
+ * @param background_t * composited background.
+ *
+ * @return void.
+ */
+static void
+Stds_DrawComposite( struct background_t *bg ) {
+  const SDL_Color clear    = { 0, 0, 0, 0 };
+  SDL_Texture *   previous = SDL_GetRenderTarget( g_app.renderer );
+
+  SDL_SetRenderTarget( g_app.renderer, bg->background_texture );
+  Stds_SetDrawColor( &clear );
+  SDL_RenderClear( g_app.renderer );
+
+  for ( int32_t i = 0; i < bg->composite_count; i++ ) {
+    SDL_Texture *texture = Stds_TextureFromHandle( bg->composite_handles[i] );
+
+    if ( texture != NULL ) {
+      Stds_SetTextureBlendMode( texture, i == 0 ? SDL_BLENDMODE_NONE : SDL_BLENDMODE_BLEND );
+      SDL_RenderCopy( g_app.renderer, texture, NULL, NULL );
+      Stds_SetTextureBlendMode( texture, SDL_BLENDMODE_BLEND );
+    }
+  }
+
+  SDL_SetRenderTarget( g_app.renderer, previous );
+  bg->target_resets = g_app.target_resets;
 }
 
 /**
@@ -187,6 +387,7 @@ Stds_BackgroundDraw( const struct background_t *background ) {
  */
 void
 Stds_BackgroundDie( struct background_t *background ) {
-  SDL_DestroyTexture( background->background_texture );
+  Stds_ReleaseTexture( background->background_texture );
+  free( background->composite_handles );
   free( background );
 }
@@ -15,11 +15,29 @@
  *
  * Defines the functions associated with buttons and detecting button events like clicking
  * and movement.
+ *
+ * Buttons linked into g_app.button_head are indexed in a grid of
+ * STDS_BUTTON_CELL_SIZE cells, so finding the button under the mouse only
+ * tests the buttons of one cell, and only after the mouse moved. The grid is
+ * rebuilt lazily after buttons are added or freed; call
+ * Stds_InvalidateButtonGrid after moving or resizing one.
  */
 #include "../include/button.h"
 
+static struct stds_pool_t * button_pool;
+static struct button_grid_t button_grid = { .is_dirty = true };
+
+static struct button_t *Stds_AllocButton( void );
+static void             Stds_RefreshButtonHover( void );
+static void             Stds_RebuildButtonGrid( void );
+static bool             Stds_GetButtonCells( const struct button_t *b, int32_t *c0, int32_t *r0,
+                                             int32_t *c1, int32_t *r1 );
+static void             Stds_DrawButtonBackground( struct button_t *b );
+static void             Stds_DrawButtonCaption( struct button_t *b );
+
 /**
- * Updates all buttons in the app struct.
+ * Updates all buttons in the app struct. Hover state is only re-evaluated
+ * when the mouse moved or the button grid changed.
  *
  * @param void.
  *
@@ -27,6 +45,8 @@
  */
 void
 Stds_UpdateButtons( void ) {
+  Stds_RefreshButtonHover();
+
   struct button_t *b;
   for ( b = g_app.button_head.next; b != NULL; b = b->next ) {
     Stds_ButtonUpdate( b );
@@ -34,7 +54,10 @@ Stds_UpdateButtons( void ) {
 }
 
 /**
- * Draws all buttons in the app struct.
+ * Draws all buttons in the app struct as one sprite batch: textured
+ * backgrounds at depth 0, then every caption at depth 1, so buttons sharing
+ * a texture are drawn together. Untextured buttons are primitives and draw
+ * immediately, underneath. Must not be called inside another sprite batch.
  *
  * @param void.
  *
@@ -43,9 +66,32 @@ Stds_UpdateButtons( void ) {
 void
 Stds_DrawButtons( void ) {
   struct button_t *b;
+
+  Stds_BatchBegin();
+  Stds_BatchSetDepth( 0 );
   for ( b = g_app.button_head.next; b != NULL; b = b->next ) {
-    Stds_ButtonDraw( b );
+    Stds_DrawButtonBackground( b );
   }
+
+  Stds_BatchSetDepth( 1 );
+  for ( b = g_app.button_head.next; b != NULL; b = b->next ) {
+    Stds_DrawButtonCaption( b );
+  }
+  Stds_BatchEnd();
+}
+
+/**
+ * Marks the button grid for a rebuild before the next hover query. Adding
+ * and freeing buttons does this already; call it after moving or resizing
+ * a button, or after changing the screen size.
+ *
+ * @param void.
+ *
+ * @return void.
+ */
+void
+Stds_InvalidateButtonGrid( void ) {
+  button_grid.is_dirty = true;
 }
 
 /**
@@ -69,15 +115,8 @@ Stds_AddButton( const float x, float y, const uint32_t w, const uint32_t h, cons
                 const char *font_path, const uint16_t size, const SDL_Color *fc,
                 const char *text ) {
   struct button_t *button;
-  button = malloc( sizeof( struct button_t ) );
-
-  if ( button == NULL ) {
-    SDL_LogInfo( SDL_LOG_CATEGORY_APPLICATION,
-                 "Error: could not allocate memory for button_t, %s.\n", SDL_GetError() );
-    exit( EXIT_FAILURE );
-  }
+  button = Stds_AllocButton();
 
-  memset( button, 0, sizeof( struct button_t ) );
   SDL_Color black    = { 0, 0, 0 };
   button->rect.x     = ( int32_t ) x;
   button->rect.y     = ( int32_t ) y;
@@ -86,6 +125,7 @@ Stds_AddButton( const float x, float y, const uint32_t w, const uint32_t h, cons
   button->font_path  = font_path;
   button->font_size  = size;
   button->color      = black;
+  button->text       = text;
   button->text_color = *fc;
   button->is_filled  = is_filled;
 
@@ -115,15 +155,7 @@ struct button_t *
 Stds_AddButtonTexture( const float x, const float y, const char *file_path, const char *font_path,
                        const uint16_t size, const SDL_Color *fc, const char *text ) {
   struct button_t *button;
-  button = malloc( sizeof( struct button_t ) );
-
-  if ( button == NULL ) {
-    SDL_LogInfo( SDL_LOG_CATEGORY_APPLICATION,
-                 "Error: could not allocate memory for button_t, %s.\n", SDL_GetError() );
-    exit( EXIT_FAILURE );
-  }
-
-  memset( button, 0, sizeof( struct button_t ) );
+  button = Stds_AllocButton();
 
   button->texture_id                  = 0;
   button->texture[button->texture_id] = Stds_LoadTexture( file_path );
@@ -166,25 +198,28 @@ Stds_ButtonUpdate( struct button_t *b ) {}
  */
 void
 Stds_ButtonDraw( struct button_t *b ) {
-  if ( b->texture[b->texture_id] != NULL ) {
-    Stds_DrawTexture( b->texture[b->texture_id], b->rect.x, b->rect.y, b->rect.w, b->rect.h, 0,
-                      SDL_FLIP_NONE, NULL, true );
-  } else {
-    Stds_DrawRect( &b->rect, &b->color, b->is_filled, true );
-  }
-  Stds_DrawText( b->text_x, b->text_y, b->font_path, b->font_size, &b->text_color, b->text );
+  Stds_DrawButtonBackground( b );
+  Stds_DrawButtonCaption( b );
 }
 
 /**
  * Determines if the mouse cursor is over the rectangle
- * box associated with the button_t struct.
+ * box associated with the button_t struct. For buttons in the button grid
+ * this is cached, and only the topmost (last linked) of overlapping buttons
+ * counts as hovered. Other buttons are tested directly.
  *
  * @param button_t* pointer to button struct.
  *
  * @return bool true if mouse is over, false otherwise.
  */
-inline bool
+bool
 Stds_IsMouseOverButton( struct button_t *b ) {
+  Stds_RefreshButtonHover();
+
+  if ( b->is_indexed ) {
+    return b->is_hovered;
+  }
+
   return Stds_IsMouseOverRect( g_app.mouse.x, g_app.mouse.y, &b->rect );
 }
 
@@ -205,3 +240,256 @@ Stds_IsButtonClicked( struct button_t *b, int32_t mouse_code ) {
   }
   return false;
 }
+
+/**
+ * Frees a button and its text object.
+ *
+ * @param button_t * button to free.
+ *
+ * @return void.
+ */
+void
+Stds_ButtonDie( struct button_t *button ) {
+  if ( button_grid.hovered == button ) {
+    button_grid.hovered = NULL;
+  }
+
+  button_grid.is_dirty = true;
+  Stds_TextDie( button->text_object );
+  Stds_PoolFree( button_pool, button );
+}
+
+/**
+ * Takes a zeroed button_t from its pool.
+ *
+ * @param void.
+ *
+ * @return button_t * new button.
+ */
+static struct button_t *
+Stds_AllocButton( void ) {
+  if ( button_pool == NULL ) {
+    button_pool = Stds_PoolCreate( sizeof( struct button_t ), STDS_OBJECT_POOL_BLOCK );
+  }
+
+  button_grid.is_dirty = true;
+
+  return Stds_PoolAlloc( button_pool );
+}
+
+/**
+ * Brings the hover state of indexed buttons up to date: rebuilds the grid
+ * if it is dirty, then, if anything moved, tests the buttons of the cell
+ * under the mouse from the topmost down.
+ *
+ * @param void.
+ *
+ * @return void.
+ */
+static void
+Stds_RefreshButtonHover( void ) {
+  bool is_rebuilt = button_grid.is_dirty;
+
+  if ( is_rebuilt ) {
+    Stds_RebuildButtonGrid();
+  }
+
+  const int32_t x = g_app.mouse.x;
+  const int32_t y = g_app.mouse.y;
+
+  if ( !is_rebuilt && x == button_grid.mouse_x && y == button_grid.mouse_y ) {
+    return;
+  }
+
+  button_grid.mouse_x = x;
+  button_grid.mouse_y = y;
+
+  if ( button_grid.hovered != NULL ) {
+    button_grid.hovered->is_hovered = false;
+    button_grid.hovered             = NULL;
+  }
+
+  if ( x < 0 || y < 0 ) {
+    return;
+  }
+
+  const int32_t col = x / STDS_BUTTON_CELL_SIZE;
+  const int32_t row = y / STDS_BUTTON_CELL_SIZE;
+
+  if ( col >= button_grid.cols || row >= button_grid.rows ) {
+    return;
+  }
+
+  const int32_t cell  = row * button_grid.cols + col;
+  const int32_t first = button_grid.cell_start[cell];
+
+  for ( int32_t i = button_grid.cell_start[cell + 1] - 1; i >= first; i-- ) {
+    struct button_t *b = button_grid.entries[i];
+
+    if ( Stds_IsMouseOverRect( x, y, &b->rect ) ) {
+      b->is_hovered       = true;
+      button_grid.hovered = b;
+      return;
+    }
+  }
+}
+
+/**
+ * Rebuilds the button grid from g_app.button_head with a counting sort:
+ * one pass counts the buttons per cell, one pass writes them.
+ *
+ * @param void.
+ *
+ * @return void.
+ */
+static void
+Stds_RebuildButtonGrid( void ) {
+  const int32_t cols  = ( ( int32_t ) g_app.SCREEN_WIDTH + STDS_BUTTON_CELL_SIZE - 1 ) /
+                       STDS_BUTTON_CELL_SIZE;
+  const int32_t rows  = ( ( int32_t ) g_app.SCREEN_HEIGHT + STDS_BUTTON_CELL_SIZE - 1 ) /
+                       STDS_BUTTON_CELL_SIZE;
+  const int32_t cells = cols * rows;
+
+  if ( cells + 1 > button_grid.cell_capacity ) {
+    size_t   bytes = sizeof( int32_t ) * ( size_t ) ( cells + 1 );
+    int32_t *start = realloc( button_grid.cell_start, bytes );
+    int32_t *fill  = realloc( button_grid.cell_fill, bytes );
+
+    if ( start == NULL || fill == NULL ) {
+      SDL_LogInfo( SDL_LOG_CATEGORY_APPLICATION,
+                   "Could not allocate memory for button grid cells. %s.\n", SDL_GetError() );
+      exit( EXIT_FAILURE );
+    }
+
+    button_grid.cell_start    = start;
+    button_grid.cell_fill     = fill;
+    button_grid.cell_capacity = cells + 1;
+  }
+
+  button_grid.cols     = cols;
+  button_grid.rows     = rows;
+  button_grid.hovered  = NULL;
+  button_grid.is_dirty = false;
+  memset( button_grid.cell_start, 0, sizeof( int32_t ) * ( size_t ) ( cells + 1 ) );
+  memset( button_grid.cell_fill, 0, sizeof( int32_t ) * ( size_t ) cells );
+
+  struct button_t *b;
+  int32_t          c0, r0, c1, r1;
+  int32_t          total = 0;
+
+  for ( b = g_app.button_head.next; b != NULL; b = b->next ) {
+    b->is_hovered = false;
+    b->is_indexed = false;
+
+    if ( Stds_GetButtonCells( b, &c0, &r0, &c1, &r1 ) ) {
+      for ( int32_t r = r0; r <= r1; r++ ) {
+        for ( int32_t c = c0; c <= c1; c++ ) {
+          button_grid.cell_start[r * cols + c + 1]++;
+        }
+      }
+      total += ( c1 - c0 + 1 ) * ( r1 - r0 + 1 );
+    }
+  }
+
+  for ( int32_t i = 0; i < cells; i++ ) {
+    button_grid.cell_start[i + 1] += button_grid.cell_start[i];
+  }
+
+  if ( total > button_grid.entry_capacity ) {
+    struct button_t **entries =
+      realloc( button_grid.entries, sizeof( struct button_t * ) * ( size_t ) total );
+
+    if ( entries == NULL ) {
+      SDL_LogInfo( SDL_LOG_CATEGORY_APPLICATION,
+                   "Could not allocate memory for button grid entries. %s.\n", SDL_GetError() );
+      exit( EXIT_FAILURE );
+    }
+
+    button_grid.entries        = entries;
+    button_grid.entry_capacity = total;
+  }
+
+  for ( b = g_app.button_head.next; b != NULL; b = b->next ) {
+    if ( Stds_GetButtonCells( b, &c0, &r0, &c1, &r1 ) ) {
+      for ( int32_t r = r0; r <= r1; r++ ) {
+        for ( int32_t c = c0; c <= c1; c++ ) {
+          int32_t cell = r * cols + c;
+          button_grid.entries[button_grid.cell_start[cell] + button_grid.cell_fill[cell]++] = b;
+        }
+      }
+      b->is_indexed = true;
+    }
+  }
+}
+
+/**
+ * Finds the range of grid cells a button overlaps, clamped to the screen.
+ *
+ * @param button_t * pointer to the button.
+ * @param int32_t * first column.
+ * @param int32_t * first row.
+ * @param int32_t * last column.
+ * @param int32_t * last row.
+ *
+ * @return bool false if the button is entirely off the screen or empty.
+ */
+static bool
+Stds_GetButtonCells( const struct button_t *b, int32_t *c0, int32_t *r0, int32_t *c1,
+                     int32_t *r1 ) {
+  const SDL_Rect *r = &b->rect;
+
+  if ( r->w <= 0 || r->h <= 0 || r->x + r->w <= 0 || r->y + r->h <= 0 ) {
+    return false;
+  }
+
+  *c0 = ( r->x > 0 ? r->x : 0 ) / STDS_BUTTON_CELL_SIZE;
+  *r0 = ( r->y > 0 ? r->y : 0 ) / STDS_BUTTON_CELL_SIZE;
+  *c1 = ( r->x + r->w - 1 ) / STDS_BUTTON_CELL_SIZE;
+  *r1 = ( r->y + r->h - 1 ) / STDS_BUTTON_CELL_SIZE;
+
+  if ( *c1 >= button_grid.cols ) {
+    *c1 = button_grid.cols - 1;
+  }
+
+  if ( *r1 >= button_grid.rows ) {
+    *r1 = button_grid.rows - 1;
+  }
+
+  return *c0 <= *c1 && *r0 <= *r1;
+}
+
+/**
+ * Draws a button's texture, or its rectangle if it has none.
+ *
+ * @param button_t * pointer to the button.
+ *
+ * @return void.
+ */
+static void
+Stds_DrawButtonBackground( struct button_t *b ) {
+  if ( b->texture[b->texture_id] != NULL ) {
+    Stds_DrawTexture( b->texture[b->texture_id], b->rect.x, b->rect.y, b->rect.w, b->rect.h, 0,
+                      SDL_FLIP_NONE, NULL, true );
+  } else {
+    Stds_DrawRect( &b->rect, &b->color, b->is_filled, true );
+  }
+}
+
+/**
+ * Draws a button's caption.
+ *
+ * @param button_t * pointer to the button.
+ *
+ * @return void.
+ */
+static void
+Stds_DrawButtonCaption( struct button_t *b ) {
+  /* The caption is retained, so it is only re-rasterized when b->text changes. */
+  if ( b->text_object == NULL ) {
+    b->text_object = Stds_TextCreate( b->font_path, b->font_size, &b->text_color, b->text );
+  }
+
+  Stds_TextSet( b->text_object, b->text );
+  Stds_TextSetColor( b->text_object, &b->text_color );
+  Stds_TextDraw( b->text_object, ( float ) b->text_x, ( float ) b->text_y );
+}
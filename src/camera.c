@@ -17,9 +17,24 @@
  * this should be the player. All offsets are pre-applied to the draw functions. To keep
  * something from being updated, just re-add the valuesx + g_app.camera.x, y +
  * g_app.camera.y.
+ * The visibility helpers test rectangles, entities and cell ranges against the
+ * view at g_app.camera so that off-screen work can be skipped. The view is
+ * g_app.camera.w by g_app.camera.h, or the screen if those are unset.
+ *
+ * Camera objects follow a point through a damped spring, with a dead zone,
+ * look-ahead and screen shake. Between Stds_CameraBegin and Stds_CameraEnd a
+ * camera becomes g_app.camera and its viewport the renderer's, so everything
+ * drawn scrolls with it, is clipped to its part of the screen and is culled
+ * against its own view. Drawing the scene once per camera gives split-screen.
  */
 #include "../include/camera.h"
 
+static void Stds_GetViewSize( float *w, float *h );
+static void Stds_FollowAxis( float *position, float *velocity, const float target,
+                             const float stiffness, const float damping, const float dt );
+static void Stds_ClampCameraAxis( float *position, float *velocity, const float size,
+                                  const uint32_t level_size );
+
 /**
  * Applies an offset from the supplied entity, and stores
  * the coordinates in the App struct. Typically, in an overhead
@@ -55,3 +70,466 @@ Stds_CameraUpdate( const struct entity_t *focus_point ) {
     exit( EXIT_FAILURE );
   }
 }
+
+/**
+ * Determines whether a rectangle overlaps the view. With the camera offset,
+ * the rectangle is in world coordinates and the view is the rectangle at
+ * g_app.camera; without it, both are in screen coordinates.
+ *
+ * @param SDL_FRect * rectangle to test.
+ * @param bool true if the rectangle scrolls with the camera, false otherwise.
+ *
+ * @return bool true if any part of the rectangle is on screen.
+ */
+bool
+Stds_IsRectVisible( const SDL_FRect *rect, const bool camera_offset ) {
+  const float vx = camera_offset ? g_app.camera.x : 0;
+  const float vy = camera_offset ? g_app.camera.y : 0;
+  float       vw, vh;
+
+  Stds_GetViewSize( &vw, &vh );
+  return rect->x < vx + vw && rect->x + rect->w > vx && rect->y < vy + vh && rect->y + rect->h > vy;
+}
+
+/**
+ * Determines whether an entity's bounding rectangle, in world coordinates,
+ * overlaps the camera's view.
+ *
+ * @param entity_t * entity to test.
+ *
+ * @return bool true if any part of the entity is on screen.
+ */
+bool
+Stds_IsEntityVisible( const struct entity_t *e ) {
+  SDL_FRect bounds = { e->pos.x, e->pos.y, ( float ) e->w, ( float ) e->h };
+  return Stds_IsRectVisible( &bounds, true );
+}
+
+/**
+ * Computes the range of cells of a uniform grid that overlap the view. The
+ * range is inclusive and clamped to the grid, so callers can iterate
+ * first_col..last_col and first_row..last_row directly.
+ *
+ * @param float x position of the grid's top-left corner.
+ * @param float y position of the grid's top-left corner.
+ * @param float width of one cell.
+ * @param float height of one cell.
+ * @param uint32_t number of columns.
+ * @param uint32_t number of rows.
+ * @param bool true if the grid scrolls with the camera, false otherwise.
+ * @param uint32_t * receives the first visible column.
+ * @param uint32_t * receives the first visible row.
+ * @param uint32_t * receives the last visible column.
+ * @param uint32_t * receives the last visible row.
+ *
+ * @return bool false if no cell is visible, in which case the range is unset.
+ */
+bool
+Stds_GetVisibleCellRange( const float x, const float y, const float cell_w, const float cell_h,
+                          const uint32_t cols, const uint32_t rows, const bool camera_offset,
+                          uint32_t *first_col, uint32_t *first_row, uint32_t *last_col,
+                          uint32_t *last_row ) {
+  if ( cols == 0 || rows == 0 || cell_w <= 0 || cell_h <= 0 ) {
+    return false;
+  }
+
+  const float vx = camera_offset ? g_app.camera.x : 0;
+  const float vy = camera_offset ? g_app.camera.y : 0;
+  float       vw, vh;
+
+  Stds_GetViewSize( &vw, &vh );
+
+  /* Cell c spans [x + c * w, x + (c + 1) * w), so it is visible when its right
+     edge is past the view's left edge and its left edge is before the right. */
+  int64_t c0 = ( int64_t ) floorf( ( vx - x ) / cell_w );
+  int64_t r0 = ( int64_t ) floorf( ( vy - y ) / cell_h );
+  int64_t c1 = ( int64_t ) ceilf( ( vx + vw - x ) / cell_w ) - 1;
+  int64_t r1 = ( int64_t ) ceilf( ( vy + vh - y ) / cell_h ) - 1;
+
+  c0 = c0 < 0 ? 0 : c0;
+  r0 = r0 < 0 ? 0 : r0;
+  c1 = c1 > ( int64_t ) cols - 1 ? ( int64_t ) cols - 1 : c1;
+  r1 = r1 > ( int64_t ) rows - 1 ? ( int64_t ) rows - 1 : r1;
+
+  if ( c0 > c1 || r0 > r1 ) {
+    return false;
+  }
+
+  *first_col = ( uint32_t ) c0;
+  *first_row = ( uint32_t ) r0;
+  *last_col  = ( uint32_t ) c1;
+  *last_row  = ( uint32_t ) r1;
+  return true;
+}
+
+/**
+ * Creates a camera drawing into viewport. It snaps to its target until given
+ * a spring, stays inside the level and has no dead zone, look-ahead or shake.
+ *
+ * @param SDL_Rect * screen rectangle to draw into, or NULL for the whole
+ *        screen.
+ *
+ * @return camera_t * pointer to the camera.
+ */
+struct camera_t *
+Stds_CreateCamera( const SDL_Rect *viewport ) {
+  struct camera_t *camera;
+  camera = malloc( sizeof( struct camera_t ) );
+
+  if ( camera == NULL ) {
+    SDL_LogInfo( SDL_LOG_CATEGORY_APPLICATION, "Could not allocate memory for camera_t. %s.\n",
+                 SDL_GetError() );
+    exit( EXIT_FAILURE );
+  }
+
+  memset( camera, 0, sizeof( struct camera_t ) );
+  camera->is_clamped = true;
+  Stds_SetCameraViewport( camera, viewport );
+
+  return camera;
+}
+
+/**
+ * Moves a camera to another part of the screen. The view takes the size of
+ * the viewport and keeps its center.
+ *
+ * @param camera_t * pointer to the camera.
+ * @param SDL_Rect * screen rectangle to draw into, or NULL for the whole
+ *        screen.
+ *
+ * @return void.
+ */
+void
+Stds_SetCameraViewport( struct camera_t *camera, const SDL_Rect *viewport ) {
+  const SDL_Rect screen = { 0, 0, ( int32_t ) g_app.SCREEN_WIDTH, ( int32_t ) g_app.SCREEN_HEIGHT };
+  const float    cx     = camera->view.x + camera->view.w / 2;
+  const float    cy     = camera->view.y + camera->view.h / 2;
+
+  camera->viewport = viewport != NULL ? *viewport : screen;
+  camera->view.w   = ( float ) camera->viewport.w;
+  camera->view.h   = ( float ) camera->viewport.h;
+  camera->view.x   = cx - camera->view.w / 2;
+  camera->view.y   = cy - camera->view.h / 2;
+}
+
+/**
+ * Makes the camera follow its target through a damped spring.
+ *
+ * @param camera_t * pointer to the camera.
+ * @param float spring constant, in 1 / second^2; 0 snaps to the target.
+ * @param float damping, in 1 / second; 2 * sqrt( stiffness ) settles fastest
+ *        without overshooting, less than that bounces.
+ *
+ * @return void.
+ */
+void
+Stds_SetCameraSpring( struct camera_t *camera, const float stiffness, const float damping ) {
+  camera->stiffness = stiffness > 0 ? stiffness : 0;
+  camera->damping   = damping > 0 ? damping : 0;
+}
+
+/**
+ * Makes the camera follow its target through a critically damped spring
+ * that closes most of the distance within about seconds.
+ *
+ * @param camera_t * pointer to the camera.
+ * @param float smoothing time in seconds; 0 snaps to the target.
+ *
+ * @return void.
+ */
+void
+Stds_SetCameraSmoothTime( struct camera_t *camera, const float seconds ) {
+  if ( seconds <= 0 ) {
+    Stds_SetCameraSpring( camera, 0, 0 );
+    return;
+  }
+
+  const float omega = 2.0f / seconds;
+  Stds_SetCameraSpring( camera, omega * omega, 2.0f * omega );
+}
+
+/**
+ * Lets the focus move inside a w by h box around the center of the view
+ * without moving the camera.
+ *
+ * @param camera_t * pointer to the camera.
+ * @param float width of the dead zone.
+ * @param float height of the dead zone.
+ *
+ * @return void.
+ */
+void
+Stds_SetCameraDeadZone( struct camera_t *camera, const float w, const float h ) {
+  camera->dead_zone = Stds_CreateVec2( w > 0 ? w / 2 : 0, h > 0 ? h / 2 : 0 );
+}
+
+/**
+ * Leads the focus by its velocity, so more of the world shows in the
+ * direction it is moving.
+ *
+ * @param camera_t * pointer to the camera.
+ * @param float number of updates of the focus velocity to lead by.
+ *
+ * @return void.
+ */
+void
+Stds_SetCameraLookAhead( struct camera_t *camera, const float updates ) {
+  camera->look_ahead = updates;
+}
+
+/**
+ * Shakes the camera by up to magnitude pixels, fading out over seconds. A
+ * new shake replaces a weaker one still running.
+ *
+ * @param camera_t * pointer to the camera.
+ * @param float largest offset, in pixels.
+ * @param float duration in seconds.
+ *
+ * @return void.
+ */
+void
+Stds_ShakeCamera( struct camera_t *camera, const float magnitude, const float seconds ) {
+  const float remaining = camera->shake_duration > 0
+                              ? camera->shake_time / camera->shake_duration : 0;
+
+  if ( seconds > 0 && magnitude >= camera->shake_magnitude * remaining * remaining ) {
+    camera->shake_magnitude = magnitude;
+    camera->shake_duration  = seconds;
+    camera->shake_time      = seconds;
+  }
+}
+
+/**
+ * Centers the view on a point right away and stops the spring.
+ *
+ * @param camera_t * pointer to the camera.
+ * @param float x coordinate in the world.
+ * @param float y coordinate in the world.
+ *
+ * @return void.
+ */
+void
+Stds_CameraCenterOn( struct camera_t *camera, const float x, const float y ) {
+  camera->view.x   = x - camera->view.w / 2;
+  camera->view.y   = y - camera->view.h / 2;
+  camera->velocity = Stds_CreateVec2( 0, 0 );
+
+  if ( camera->is_clamped ) {
+    Stds_ClampCameraAxis( &camera->view.x, &camera->velocity.x, camera->view.w,
+                          g_app.LEVEL_WIDTH );
+    Stds_ClampCameraAxis( &camera->view.y, &camera->velocity.y, camera->view.h,
+                          g_app.LEVEL_HEIGHT );
+  }
+}
+
+/**
+ * Moves the camera towards a point for one update and advances its shake.
+ * The target is the point led by its velocity, and the view only moves once
+ * the target leaves the dead zone, just far enough to bring it back to the
+ * edge.
+ *
+ * @param camera_t * pointer to the camera.
+ * @param vec2_t * point to follow, in world coordinates.
+ * @param vec2_t * velocity of the point per update, or NULL.
+ * @param float seconds since the last update.
+ *
+ * @return void.
+ */
+void
+Stds_CameraFollowPoint( struct camera_t *camera, const struct vec2_t *point,
+                        const struct vec2_t *velocity, const float dt ) {
+  const float half_w = camera->view.w / 2;
+  const float half_h = camera->view.h / 2;
+  float       fx     = point->x;
+  float       fy     = point->y;
+
+  if ( velocity != NULL ) {
+    fx += velocity->x * camera->look_ahead;
+    fy += velocity->y * camera->look_ahead;
+  }
+
+  /* The center the view needs to keep the focus inside the dead zone. */
+  float       cx = camera->view.x + half_w;
+  float       cy = camera->view.y + half_h;
+  const float dx = fx - cx;
+  const float dy = fy - cy;
+
+  if ( dx > camera->dead_zone.x ) {
+    cx = fx - camera->dead_zone.x;
+  } else if ( dx < -camera->dead_zone.x ) {
+    cx = fx + camera->dead_zone.x;
+  }
+
+  if ( dy > camera->dead_zone.y ) {
+    cy = fy - camera->dead_zone.y;
+  } else if ( dy < -camera->dead_zone.y ) {
+    cy = fy + camera->dead_zone.y;
+  }
+
+  Stds_FollowAxis( &camera->view.x, &camera->velocity.x, cx - half_w, camera->stiffness,
+                   camera->damping, dt );
+  Stds_FollowAxis( &camera->view.y, &camera->velocity.y, cy - half_h, camera->stiffness,
+                   camera->damping, dt );
+
+  if ( camera->is_clamped ) {
+    Stds_ClampCameraAxis( &camera->view.x, &camera->velocity.x, camera->view.w,
+                          g_app.LEVEL_WIDTH );
+    Stds_ClampCameraAxis( &camera->view.y, &camera->velocity.y, camera->view.h,
+                          g_app.LEVEL_HEIGHT );
+  }
+
+  camera->shake_offset = Stds_CreateVec2( 0, 0 );
+  if ( camera->shake_time > 0 ) {
+    camera->shake_time = camera->shake_time > dt ? camera->shake_time - dt : 0;
+
+    /* Squaring the remaining fraction makes the shake die off smoothly. */
+    const float fraction = camera->shake_time / camera->shake_duration;
+    const float amount   = camera->shake_magnitude * fraction * fraction;
+    camera->shake_offset = Stds_CreateVec2( Stds_RandomFloat( -amount, amount ),
+                                            Stds_RandomFloat( -amount, amount ) );
+  }
+}
+
+/**
+ * Moves the camera towards the center of an entity for one update, leading
+ * it by the entity's velocity. See Stds_CameraFollowPoint.
+ *
+ * @param camera_t * pointer to the camera.
+ * @param entity_t * entity to follow.
+ * @param float seconds since the last update.
+ *
+ * @return void.
+ */
+void
+Stds_CameraFollow( struct camera_t *camera, const struct entity_t *focus, const float dt ) {
+  const struct vec2_t center = { focus->pos.x + ( float ) focus->w / 2,
+                                 focus->pos.y + ( float ) focus->h / 2 };
+  Stds_CameraFollowPoint( camera, &center, &focus->velocity, dt );
+}
+
+/**
+ * Makes the camera the one everything is drawn through, until
+ * Stds_CameraEnd: g_app.camera becomes its shaken view and the renderer's
+ * viewport its viewport. Calls cannot be nested.
+ *
+ * Viewports are set on the renderer right away, so while the draw delegate
+ * is recorded into a command buffer only g_app.camera changes. Use command
+ * buffering with one full-screen camera only.
+ *
+ * @param camera_t * pointer to the camera.
+ *
+ * @return void.
+ */
+void
+Stds_CameraBegin( struct camera_t *camera ) {
+  camera->saved_camera = g_app.camera;
+  g_app.camera         = ( SDL_FRect ){ camera->view.x + camera->shake_offset.x,
+                                camera->view.y + camera->shake_offset.y, camera->view.w,
+                                camera->view.h };
+
+  if ( !Stds_IsRecordingCommands() ) {
+    SDL_RenderGetViewport( g_app.renderer, &camera->saved_viewport );
+    SDL_RenderSetViewport( g_app.renderer, &camera->viewport );
+  }
+}
+
+/**
+ * Restores the camera and viewport that were in use before
+ * Stds_CameraBegin.
+ *
+ * @param camera_t * pointer to the camera.
+ *
+ * @return void.
+ */
+void
+Stds_CameraEnd( struct camera_t *camera ) {
+  g_app.camera = camera->saved_camera;
+
+  if ( !Stds_IsRecordingCommands() ) {
+    SDL_RenderSetViewport( g_app.renderer, &camera->saved_viewport );
+  }
+}
+
+/**
+ * Frees a camera.
+ *
+ * @param camera_t * pointer to the camera.
+ *
+ * @return void.
+ */
+void
+Stds_CameraDie( struct camera_t *camera ) {
+  free( camera );
+}
+
+/**
+ * Returns the size of the view at g_app.camera, or of the screen if the
+ * camera has no size.
+ *
+ * @param float * receives the width.
+ * @param float * receives the height.
+ *
+ * @return void.
+ */
+static void
+Stds_GetViewSize( float *w, float *h ) {
+  *w = g_app.camera.w > 0 ? g_app.camera.w : ( float ) g_app.SCREEN_WIDTH;
+  *h = g_app.camera.h > 0 ? g_app.camera.h : ( float ) g_app.SCREEN_HEIGHT;
+}
+
+/**
+ * Moves one axis of the view towards target through a damped spring,
+ * integrated semi-implicitly in steps of at most STDS_CAMERA_STEP so stiff
+ * springs stay stable at low frame rates.
+ *
+ * @param float * position on the axis.
+ * @param float * velocity on the axis.
+ * @param float target position.
+ * @param float spring constant; 0 snaps to the target.
+ * @param float damping.
+ * @param float seconds to advance.
+ *
+ * @return void.
+ */
+static void
+Stds_FollowAxis( float *position, float *velocity, const float target, const float stiffness,
+                 const float damping, const float dt ) {
+  if ( stiffness <= 0 ) {
+    *position = target;
+    *velocity = 0;
+    return;
+  }
+
+  for ( float left = dt; left > 0; left -= STDS_CAMERA_STEP ) {
+    const float step = left < STDS_CAMERA_STEP ? left : STDS_CAMERA_STEP;
+
+    *velocity += ( stiffness * ( target - *position ) - damping * *velocity ) * step;
+    *position += *velocity * step;
+  }
+}
+
+/**
+ * Keeps one axis of the view inside the level, stopping the spring against
+ * the edge. A level smaller than the view pins the view at 0.
+ *
+ * @param float * position on the axis.
+ * @param float * velocity on the axis.
+ * @param float size of the view on the axis.
+ * @param uint32_t size of the level on the axis, or 0 for no limit.
+ *
+ * @return void.
+ */
+static void
+Stds_ClampCameraAxis( float *position, float *velocity, const float size,
+                      const uint32_t level_size ) {
+  if ( level_size == 0 ) {
+    return;
+  }
+
+  const float max = ( float ) level_size - size > 0 ? ( float ) level_size - size : 0;
+
+  if ( *position < 0 || *position > max ) {
+    *position = *position < 0 ? 0 : max;
+    *velocity = 0;
+  }
+}
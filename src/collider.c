@@ -0,0 +1,672 @@
+/**
+ * @file collider.c
+ * @author Joshua Crotts
+ * @date October 14 2026
+ * @version 1.0
+ *
+ * @section LICENSE
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License as
+ * published by the Free Software Foundation; either version 2 of
+ * the License, or (at your option) any later version.
+ *
+ * @section DESCRIPTION
+ *
+ * This file defines the collider pool, which packs rectangles, circles and
+ * convex polygons into contiguous arrays, and the batch tests that check one
+ * shape against every collider of a kind at once. The rectangle and circle
+ * kernels are vectorized with the instruction set selected in simd.h; each
+ * writes one bit per collider into a hit mask.
+ */
+#include "../include/collider.h"
+
+#define STDS_COLLIDER_WIDTH 8
+
+static void    Stds_GrowFloats( float **array, const int32_t capacity );
+static void    Stds_GrowColliderRects( struct collider_pool_t *pool );
+static void    Stds_GrowColliderCircles( struct collider_pool_t *pool );
+static void    Stds_GrowColliderPolygons( struct collider_pool_t *pool, const int32_t sides );
+static int32_t Stds_FinishMask( uint32_t *hit_mask, const int32_t count );
+static bool    Stds_SeparatedOnAxis( const struct vec2_t *axis, const struct vec2_t *a,
+                                     const int32_t a_count, const struct vec2_t *b,
+                                     const int32_t b_count );
+
+#if defined( STDS_SIMD_NEON )
+static inline uint32_t Stds_NeonMovemask( const uint32x4_t mask );
+#endif
+
+/**
+ * Creates an empty collider pool.
+ *
+ * @param void.
+ *
+ * @return collider_pool_t * pointer to pool.
+ */
+struct collider_pool_t *
+Stds_CreateColliderPool( void ) {
+  struct collider_pool_t *pool;
+  pool = malloc( sizeof( struct collider_pool_t ) );
+
+  if ( pool == NULL ) {
+    SDL_LogInfo( SDL_LOG_CATEGORY_APPLICATION,
+                 "Could not allocate memory for collider_pool_t. %s.\n", SDL_GetError() );
+    exit( EXIT_FAILURE );
+  }
+
+  memset( pool, 0, sizeof( struct collider_pool_t ) );
+  return pool;
+}
+
+/**
+ * Removes every collider but keeps the storage, so pools rebuilt every frame
+ * (e.g. from a list of bullets) do not reallocate.
+ *
+ * @param collider_pool_t * pointer to pool.
+ *
+ * @return void.
+ */
+void
+Stds_ColliderClear( struct collider_pool_t *pool ) {
+  pool->rect_count       = 0;
+  pool->circle_count     = 0;
+  pool->poly_point_count = 0;
+  pool->poly_count       = 0;
+}
+
+/**
+ * Appends a rectangle collider.
+ *
+ * @param collider_pool_t * pointer to pool.
+ * @param SDL_FRect * rectangle in world coordinates.
+ *
+ * @return int32_t index of the rectangle, used as its bit in hit masks.
+ */
+int32_t
+Stds_ColliderAddRect( struct collider_pool_t *pool, const SDL_FRect *rect ) {
+  if ( pool->rect_count == pool->rect_capacity ) {
+    Stds_GrowColliderRects( pool );
+  }
+
+  int32_t index = pool->rect_count++;
+  Stds_ColliderSetRect( pool, index, rect );
+  return index;
+}
+
+/**
+ * Appends a circle collider.
+ *
+ * @param collider_pool_t * pointer to pool.
+ * @param circle_t * circle in world coordinates.
+ *
+ * @return int32_t index of the circle, used as its bit in hit masks.
+ */
+int32_t
+Stds_ColliderAddCircle( struct collider_pool_t *pool, const struct circle_t *circle ) {
+  if ( pool->circle_count == pool->circle_capacity ) {
+    Stds_GrowColliderCircles( pool );
+  }
+
+  int32_t index = pool->circle_count++;
+  Stds_ColliderSetCircle( pool, index, circle );
+  return index;
+}
+
+/**
+ * Appends a copy of a polygon's current world points. Call
+ * Stds_UpdatePolygon first so the points match its position and angle.
+ *
+ * @param collider_pool_t * pointer to pool.
+ * @param polygon_t * convex polygon to copy.
+ *
+ * @return int32_t index of the polygon, used as its bit in hit masks.
+ */
+int32_t
+Stds_ColliderAddPolygon( struct collider_pool_t *pool, const struct polygon_t *polygon ) {
+  Stds_GrowColliderPolygons( pool, polygon->sides );
+
+  int32_t index            = pool->poly_count++;
+  pool->poly_offset[index] = pool->poly_point_count;
+  pool->poly_sides[index]  = polygon->sides;
+  pool->poly_aabb[index]   = polygon->aabb;
+  memcpy( pool->poly_points + pool->poly_point_count, polygon->points,
+          sizeof( struct vec2_t ) * ( size_t ) polygon->sides );
+  pool->poly_point_count += polygon->sides;
+
+  return index;
+}
+
+/**
+ * Moves an existing rectangle collider.
+ *
+ * @param collider_pool_t * pointer to pool.
+ * @param int32_t index returned by Stds_ColliderAddRect.
+ * @param SDL_FRect * new rectangle.
+ *
+ * @return void.
+ */
+void
+Stds_ColliderSetRect( struct collider_pool_t *pool, const int32_t index, const SDL_FRect *rect ) {
+  pool->rect_x[index] = rect->x;
+  pool->rect_y[index] = rect->y;
+  pool->rect_w[index] = rect->w;
+  pool->rect_h[index] = rect->h;
+}
+
+/**
+ * Moves an existing circle collider.
+ *
+ * @param collider_pool_t * pointer to pool.
+ * @param int32_t index returned by Stds_ColliderAddCircle.
+ * @param circle_t * new circle.
+ *
+ * @return void.
+ */
+void
+Stds_ColliderSetCircle( struct collider_pool_t *pool, const int32_t index,
+                        const struct circle_t *circle ) {
+  pool->circle_x[index] = circle->center_x;
+  pool->circle_y[index] = circle->center_y;
+  pool->circle_r[index] = circle->radius;
+}
+
+/**
+ * Tests rect against every rectangle in the pool, with the same strict
+ * overlap rule as Stds_RectVsRect.
+ *
+ * @param collider_pool_t * pointer to pool.
+ * @param SDL_FRect * query rectangle.
+ * @param uint32_t * receives bit i set when rectangle i overlaps; must hold
+ *        ( rect_count + 31 ) / 32 words.
+ *
+ * @return int32_t number of hits.
+ */
+int32_t
+Stds_ColliderRectVsRects( const struct collider_pool_t *pool, const SDL_FRect *rect,
+                          uint32_t *hit_mask ) {
+  const int32_t count = pool->rect_count;
+  const float   x0 = rect->x, y0 = rect->y, x1 = rect->x + rect->w, y1 = rect->y + rect->h;
+  int32_t       i     = 0;
+
+  memset( hit_mask, 0, sizeof( uint32_t ) * ( size_t )( ( count + 31 ) >> 5 ) );
+
+#if defined( STDS_SIMD_AVX2 )
+  const __m256 qx0 = _mm256_set1_ps( x0 ), qy0 = _mm256_set1_ps( y0 );
+  const __m256 qx1 = _mm256_set1_ps( x1 ), qy1 = _mm256_set1_ps( y1 );
+
+  for ( ; i < count; i += 8 ) {
+    __m256 x = _mm256_loadu_ps( pool->rect_x + i );
+    __m256 y = _mm256_loadu_ps( pool->rect_y + i );
+    __m256 r = _mm256_add_ps( x, _mm256_loadu_ps( pool->rect_w + i ) );
+    __m256 b = _mm256_add_ps( y, _mm256_loadu_ps( pool->rect_h + i ) );
+
+    __m256 hit = _mm256_and_ps( _mm256_cmp_ps( qx0, r, _CMP_LT_OQ ),
+                                _mm256_cmp_ps( qx1, x, _CMP_GT_OQ ) );
+    hit        = _mm256_and_ps( hit, _mm256_cmp_ps( qy0, b, _CMP_LT_OQ ) );
+    hit        = _mm256_and_ps( hit, _mm256_cmp_ps( qy1, y, _CMP_GT_OQ ) );
+
+    hit_mask[i >> 5] |= ( uint32_t ) _mm256_movemask_ps( hit ) << ( i & 31 );
+  }
+#elif defined( STDS_SIMD_SSE2 )
+  const __m128 qx0 = _mm_set1_ps( x0 ), qy0 = _mm_set1_ps( y0 );
+  const __m128 qx1 = _mm_set1_ps( x1 ), qy1 = _mm_set1_ps( y1 );
+
+  for ( ; i < count; i += 4 ) {
+    __m128 x = _mm_loadu_ps( pool->rect_x + i );
+    __m128 y = _mm_loadu_ps( pool->rect_y + i );
+    __m128 r = _mm_add_ps( x, _mm_loadu_ps( pool->rect_w + i ) );
+    __m128 b = _mm_add_ps( y, _mm_loadu_ps( pool->rect_h + i ) );
+
+    __m128 hit = _mm_and_ps( _mm_cmplt_ps( qx0, r ), _mm_cmpgt_ps( qx1, x ) );
+    hit        = _mm_and_ps( hit, _mm_cmplt_ps( qy0, b ) );
+    hit        = _mm_and_ps( hit, _mm_cmpgt_ps( qy1, y ) );
+
+    hit_mask[i >> 5] |= ( uint32_t ) _mm_movemask_ps( hit ) << ( i & 31 );
+  }
+#elif defined( STDS_SIMD_NEON )
+  const float32x4_t qx0 = vdupq_n_f32( x0 ), qy0 = vdupq_n_f32( y0 );
+  const float32x4_t qx1 = vdupq_n_f32( x1 ), qy1 = vdupq_n_f32( y1 );
+
+  for ( ; i < count; i += 4 ) {
+    float32x4_t x = vld1q_f32( pool->rect_x + i );
+    float32x4_t y = vld1q_f32( pool->rect_y + i );
+    float32x4_t r = vaddq_f32( x, vld1q_f32( pool->rect_w + i ) );
+    float32x4_t b = vaddq_f32( y, vld1q_f32( pool->rect_h + i ) );
+
+    uint32x4_t hit = vandq_u32( vcltq_f32( qx0, r ), vcgtq_f32( qx1, x ) );
+    hit            = vandq_u32( hit, vcltq_f32( qy0, b ) );
+    hit            = vandq_u32( hit, vcgtq_f32( qy1, y ) );
+
+    hit_mask[i >> 5] |= Stds_NeonMovemask( hit ) << ( i & 31 );
+  }
+#else
+  for ( ; i < count; i++ ) {
+    if ( x0 < pool->rect_x[i] + pool->rect_w[i] && x1 > pool->rect_x[i] &&
+         y0 < pool->rect_y[i] + pool->rect_h[i] && y1 > pool->rect_y[i] ) {
+      hit_mask[i >> 5] |= 1u << ( i & 31 );
+    }
+  }
+#endif
+
+  return Stds_FinishMask( hit_mask, count );
+}
+
+/**
+ * Tests circle against every circle in the pool, with the same rule as
+ * Stds_CheckCircularCollision (touching counts as a hit).
+ *
+ * @param collider_pool_t * pointer to pool.
+ * @param circle_t * query circle.
+ * @param uint32_t * receives bit i set when circle i overlaps; must hold
+ *        ( circle_count + 31 ) / 32 words.
+ *
+ * @return int32_t number of hits.
+ */
+int32_t
+Stds_ColliderCircleVsCircles( const struct collider_pool_t *pool, const struct circle_t *circle,
+                              uint32_t *hit_mask ) {
+  const int32_t count = pool->circle_count;
+  const float   cx = circle->center_x, cy = circle->center_y, cr = circle->radius;
+  int32_t       i  = 0;
+
+  memset( hit_mask, 0, sizeof( uint32_t ) * ( size_t )( ( count + 31 ) >> 5 ) );
+
+#if defined( STDS_SIMD_AVX2 )
+  const __m256 qx = _mm256_set1_ps( cx ), qy = _mm256_set1_ps( cy ), qr = _mm256_set1_ps( cr );
+
+  for ( ; i < count; i += 8 ) {
+    __m256 dx = _mm256_sub_ps( _mm256_loadu_ps( pool->circle_x + i ), qx );
+    __m256 dy = _mm256_sub_ps( _mm256_loadu_ps( pool->circle_y + i ), qy );
+    __m256 rs = _mm256_add_ps( _mm256_loadu_ps( pool->circle_r + i ), qr );
+    __m256 d2 = _mm256_add_ps( _mm256_mul_ps( dx, dx ), _mm256_mul_ps( dy, dy ) );
+
+    __m256 hit = _mm256_cmp_ps( d2, _mm256_mul_ps( rs, rs ), _CMP_LE_OQ );
+    hit_mask[i >> 5] |= ( uint32_t ) _mm256_movemask_ps( hit ) << ( i & 31 );
+  }
+#elif defined( STDS_SIMD_SSE2 )
+  const __m128 qx = _mm_set1_ps( cx ), qy = _mm_set1_ps( cy ), qr = _mm_set1_ps( cr );
+
+  for ( ; i < count; i += 4 ) {
+    __m128 dx = _mm_sub_ps( _mm_loadu_ps( pool->circle_x + i ), qx );
+    __m128 dy = _mm_sub_ps( _mm_loadu_ps( pool->circle_y + i ), qy );
+    __m128 rs = _mm_add_ps( _mm_loadu_ps( pool->circle_r + i ), qr );
+    __m128 d2 = _mm_add_ps( _mm_mul_ps( dx, dx ), _mm_mul_ps( dy, dy ) );
+
+    __m128 hit = _mm_cmple_ps( d2, _mm_mul_ps( rs, rs ) );
+    hit_mask[i >> 5] |= ( uint32_t ) _mm_movemask_ps( hit ) << ( i & 31 );
+  }
+#elif defined( STDS_SIMD_NEON )
+  const float32x4_t qx = vdupq_n_f32( cx ), qy = vdupq_n_f32( cy ), qr = vdupq_n_f32( cr );
+
+  for ( ; i < count; i += 4 ) {
+    float32x4_t dx = vsubq_f32( vld1q_f32( pool->circle_x + i ), qx );
+    float32x4_t dy = vsubq_f32( vld1q_f32( pool->circle_y + i ), qy );
+    float32x4_t rs = vaddq_f32( vld1q_f32( pool->circle_r + i ), qr );
+    float32x4_t d2 = vaddq_f32( vmulq_f32( dx, dx ), vmulq_f32( dy, dy ) );
+
+    uint32x4_t hit = vcleq_f32( d2, vmulq_f32( rs, rs ) );
+    hit_mask[i >> 5] |= Stds_NeonMovemask( hit ) << ( i & 31 );
+  }
+#else
+  for ( ; i < count; i++ ) {
+    float dx = pool->circle_x[i] - cx;
+    float dy = pool->circle_y[i] - cy;
+    float rs = pool->circle_r[i] + cr;
+
+    if ( dx * dx + dy * dy <= rs * rs ) {
+      hit_mask[i >> 5] |= 1u << ( i & 31 );
+    }
+  }
+#endif
+
+  return Stds_FinishMask( hit_mask, count );
+}
+
+/**
+ * Tests rect against every circle in the pool, e.g. a player hitbox against
+ * all bullets. A circle hits when the point of rect closest to its center is
+ * within its radius.
+ *
+ * @param collider_pool_t * pointer to pool.
+ * @param SDL_FRect * query rectangle.
+ * @param uint32_t * receives bit i set when circle i overlaps; must hold
+ *        ( circle_count + 31 ) / 32 words.
+ *
+ * @return int32_t number of hits.
+ */
+int32_t
+Stds_ColliderRectVsCircles( const struct collider_pool_t *pool, const SDL_FRect *rect,
+                            uint32_t *hit_mask ) {
+  const int32_t count = pool->circle_count;
+  const float   x0 = rect->x, y0 = rect->y, x1 = rect->x + rect->w, y1 = rect->y + rect->h;
+  int32_t       i     = 0;
+
+  memset( hit_mask, 0, sizeof( uint32_t ) * ( size_t )( ( count + 31 ) >> 5 ) );
+
+#if defined( STDS_SIMD_AVX2 )
+  const __m256 qx0 = _mm256_set1_ps( x0 ), qy0 = _mm256_set1_ps( y0 );
+  const __m256 qx1 = _mm256_set1_ps( x1 ), qy1 = _mm256_set1_ps( y1 );
+
+  for ( ; i < count; i += 8 ) {
+    __m256 x  = _mm256_loadu_ps( pool->circle_x + i );
+    __m256 y  = _mm256_loadu_ps( pool->circle_y + i );
+    __m256 r  = _mm256_loadu_ps( pool->circle_r + i );
+    __m256 dx = _mm256_sub_ps( x, _mm256_min_ps( _mm256_max_ps( x, qx0 ), qx1 ) );
+    __m256 dy = _mm256_sub_ps( y, _mm256_min_ps( _mm256_max_ps( y, qy0 ), qy1 ) );
+    __m256 d2 = _mm256_add_ps( _mm256_mul_ps( dx, dx ), _mm256_mul_ps( dy, dy ) );
+
+    __m256 hit = _mm256_cmp_ps( d2, _mm256_mul_ps( r, r ), _CMP_LE_OQ );
+    hit_mask[i >> 5] |= ( uint32_t ) _mm256_movemask_ps( hit ) << ( i & 31 );
+  }
+#elif defined( STDS_SIMD_SSE2 )
+  const __m128 qx0 = _mm_set1_ps( x0 ), qy0 = _mm_set1_ps( y0 );
+  const __m128 qx1 = _mm_set1_ps( x1 ), qy1 = _mm_set1_ps( y1 );
+
+  for ( ; i < count; i += 4 ) {
+    __m128 x  = _mm_loadu_ps( pool->circle_x + i );
+    __m128 y  = _mm_loadu_ps( pool->circle_y + i );
+    __m128 r  = _mm_loadu_ps( pool->circle_r + i );
+    __m128 dx = _mm_sub_ps( x, _mm_min_ps( _mm_max_ps( x, qx0 ), qx1 ) );
+    __m128 dy = _mm_sub_ps( y, _mm_min_ps( _mm_max_ps( y, qy0 ), qy1 ) );
+    __m128 d2 = _mm_add_ps( _mm_mul_ps( dx, dx ), _mm_mul_ps( dy, dy ) );
+
+    __m128 hit = _mm_cmple_ps( d2, _mm_mul_ps( r, r ) );
+    hit_mask[i >> 5] |= ( uint32_t ) _mm_movemask_ps( hit ) << ( i & 31 );
+  }
+#elif defined( STDS_SIMD_NEON )
+  const float32x4_t qx0 = vdupq_n_f32( x0 ), qy0 = vdupq_n_f32( y0 );
+  const float32x4_t qx1 = vdupq_n_f32( x1 ), qy1 = vdupq_n_f32( y1 );
+
+  for ( ; i < count; i += 4 ) {
+    float32x4_t x  = vld1q_f32( pool->circle_x + i );
+    float32x4_t y  = vld1q_f32( pool->circle_y + i );
+    float32x4_t r  = vld1q_f32( pool->circle_r + i );
+    float32x4_t dx = vsubq_f32( x, vminq_f32( vmaxq_f32( x, qx0 ), qx1 ) );
+    float32x4_t dy = vsubq_f32( y, vminq_f32( vmaxq_f32( y, qy0 ), qy1 ) );
+    float32x4_t d2 = vaddq_f32( vmulq_f32( dx, dx ), vmulq_f32( dy, dy ) );
+
+    uint32x4_t hit = vcleq_f32( d2, vmulq_f32( r, r ) );
+    hit_mask[i >> 5] |= Stds_NeonMovemask( hit ) << ( i & 31 );
+  }
+#else
+  for ( ; i < count; i++ ) {
+    float dx = pool->circle_x[i] - fminf( fmaxf( pool->circle_x[i], x0 ), x1 );
+    float dy = pool->circle_y[i] - fminf( fmaxf( pool->circle_y[i], y0 ), y1 );
+
+    if ( dx * dx + dy * dy <= pool->circle_r[i] * pool->circle_r[i] ) {
+      hit_mask[i >> 5] |= 1u << ( i & 31 );
+    }
+  }
+#endif
+
+  return Stds_FinishMask( hit_mask, count );
+}
+
+/**
+ * Tests a convex polygon against every polygon in the pool. Each candidate's
+ * stored AABB is checked first; survivors run the separating axis test over
+ * the query's cached normals and the candidate's edges.
+ *
+ * @param collider_pool_t * pointer to pool.
+ * @param polygon_t * query polygon, updated with Stds_UpdatePolygon.
+ * @param uint32_t * receives bit i set when polygon i overlaps; must hold
+ *        ( poly_count + 31 ) / 32 words.
+ *
+ * @return int32_t number of hits.
+ */
+int32_t
+Stds_ColliderPolygonVsPolygons( const struct collider_pool_t *pool,
+                                const struct polygon_t *polygon, uint32_t *hit_mask ) {
+  const SDL_FRect *q    = &polygon->aabb;
+  int32_t          hits = 0;
+
+  memset( hit_mask, 0, sizeof( uint32_t ) * ( size_t )( ( pool->poly_count + 31 ) >> 5 ) );
+
+  for ( int32_t i = 0; i < pool->poly_count; i++ ) {
+    const SDL_FRect *c = &pool->poly_aabb[i];
+    if ( q->x > c->x + c->w || c->x > q->x + q->w || q->y > c->y + c->h || c->y > q->y + q->h ) {
+      continue;
+    }
+
+    const struct vec2_t *points = pool->poly_points + pool->poly_offset[i];
+    const int32_t        sides  = pool->poly_sides[i];
+    bool                 is_hit = true;
+
+    for ( int32_t a = 0; a < polygon->normal_count && is_hit; a++ ) {
+      is_hit = !Stds_SeparatedOnAxis( &polygon->normals[a], polygon->points, polygon->sides,
+                                      points, sides );
+    }
+
+    for ( int32_t a = 0; a < sides && is_hit; a++ ) {
+      int32_t       b    = ( a + 1 ) % sides;
+      struct vec2_t axis = { -( points[b].y - points[a].y ), points[b].x - points[a].x };
+      is_hit = !Stds_SeparatedOnAxis( &axis, polygon->points, polygon->sides, points, sides );
+    }
+
+    if ( is_hit ) {
+      hit_mask[i >> 5] |= 1u << ( i & 31 );
+      hits++;
+    }
+  }
+
+  return hits;
+}
+
+/**
+ * Converts a hit mask into a list of collider indices in increasing order.
+ *
+ * @param uint32_t * hit mask written by one of the batch tests.
+ * @param int32_t number of colliders the mask covers.
+ * @param int32_t * receives the indices.
+ * @param int32_t capacity of out.
+ *
+ * @return int32_t number of indices written.
+ */
+int32_t
+Stds_ColliderMaskToIndices( const uint32_t *hit_mask, const int32_t count, int32_t *out,
+                            const int32_t max_out ) {
+  int32_t written = 0;
+  int32_t words   = ( count + 31 ) >> 5;
+
+  for ( int32_t w = 0; w < words && written < max_out; w++ ) {
+    uint32_t bits = hit_mask[w];
+
+    while ( bits != 0 && written < max_out ) {
+      out[written++] = ( w << 5 ) + Stds_LowestBit( bits );
+      bits &= bits - 1;
+    }
+  }
+
+  return written;
+}
+
+/**
+ * Frees the collider pool.
+ *
+ * @param collider_pool_t * pointer to pool.
+ *
+ * @return void.
+ */
+void
+Stds_ColliderPoolDie( struct collider_pool_t *pool ) {
+  free( pool->rect_x );
+  free( pool->rect_y );
+  free( pool->rect_w );
+  free( pool->rect_h );
+  free( pool->circle_x );
+  free( pool->circle_y );
+  free( pool->circle_r );
+  free( pool->poly_points );
+  free( pool->poly_offset );
+  free( pool->poly_sides );
+  free( pool->poly_aabb );
+  free( pool );
+}
+
+/**
+ * Reallocates a float array to capacity elements.
+ *
+ * @param float ** pointer to the array.
+ * @param int32_t new capacity.
+ *
+ * @return void.
+ */
+static void
+Stds_GrowFloats( float **array, const int32_t capacity ) {
+  *array = realloc( *array, sizeof( float ) * ( size_t ) capacity );
+
+  if ( *array == NULL ) {
+    SDL_LogInfo( SDL_LOG_CATEGORY_APPLICATION, "Could not allocate memory for collider arrays. %s.\n",
+                 SDL_GetError() );
+    exit( EXIT_FAILURE );
+  }
+}
+
+/**
+ * Doubles the rectangle arrays. The capacity stays a multiple of
+ * STDS_COLLIDER_WIDTH so the kernels may read a whole vector past the count.
+ *
+ * @param collider_pool_t * pointer to pool.
+ *
+ * @return void.
+ */
+static void
+Stds_GrowColliderRects( struct collider_pool_t *pool ) {
+  pool->rect_capacity = pool->rect_capacity == 0 ? 64 : pool->rect_capacity * 2;
+  Stds_GrowFloats( &pool->rect_x, pool->rect_capacity );
+  Stds_GrowFloats( &pool->rect_y, pool->rect_capacity );
+  Stds_GrowFloats( &pool->rect_w, pool->rect_capacity );
+  Stds_GrowFloats( &pool->rect_h, pool->rect_capacity );
+}
+
+/**
+ * Doubles the circle arrays. The capacity stays a multiple of
+ * STDS_COLLIDER_WIDTH so the kernels may read a whole vector past the count.
+ *
+ * @param collider_pool_t * pointer to pool.
+ *
+ * @return void.
+ */
+static void
+Stds_GrowColliderCircles( struct collider_pool_t *pool ) {
+  pool->circle_capacity = pool->circle_capacity == 0 ? 64 : pool->circle_capacity * 2;
+  Stds_GrowFloats( &pool->circle_x, pool->circle_capacity );
+  Stds_GrowFloats( &pool->circle_y, pool->circle_capacity );
+  Stds_GrowFloats( &pool->circle_r, pool->circle_capacity );
+}
+
+/**
+ * Makes room for one more polygon with the given number of sides.
+ *
+ * @param collider_pool_t * pointer to pool.
+ * @param int32_t sides of the polygon being added.
+ *
+ * @return void.
+ */
+static void
+Stds_GrowColliderPolygons( struct collider_pool_t *pool, const int32_t sides ) {
+  if ( pool->poly_count == pool->poly_capacity ) {
+    pool->poly_capacity = pool->poly_capacity == 0 ? 32 : pool->poly_capacity * 2;
+    pool->poly_offset =
+      realloc( pool->poly_offset, sizeof( int32_t ) * ( size_t ) pool->poly_capacity );
+    pool->poly_sides =
+      realloc( pool->poly_sides, sizeof( int32_t ) * ( size_t ) pool->poly_capacity );
+    pool->poly_aabb =
+      realloc( pool->poly_aabb, sizeof( SDL_FRect ) * ( size_t ) pool->poly_capacity );
+
+    if ( pool->poly_offset == NULL || pool->poly_sides == NULL || pool->poly_aabb == NULL ) {
+      SDL_LogInfo( SDL_LOG_CATEGORY_APPLICATION,
+                   "Could not allocate memory for collider polygons. %s.\n", SDL_GetError() );
+      exit( EXIT_FAILURE );
+    }
+  }
+
+  if ( pool->poly_point_count + sides > pool->poly_point_capacity ) {
+    while ( pool->poly_point_count + sides > pool->poly_point_capacity ) {
+      pool->poly_point_capacity =
+        pool->poly_point_capacity == 0 ? 128 : pool->poly_point_capacity * 2;
+    }
+
+    pool->poly_points = realloc( pool->poly_points, sizeof( struct vec2_t ) *
+                                                      ( size_t ) pool->poly_point_capacity );
+
+    if ( pool->poly_points == NULL ) {
+      SDL_LogInfo( SDL_LOG_CATEGORY_APPLICATION,
+                   "Could not allocate memory for collider polygon points. %s.\n",
+                   SDL_GetError() );
+      exit( EXIT_FAILURE );
+    }
+  }
+}
+
+/**
+ * Clears the bits of the padding lanes past count, which the vector kernels
+ * compute from stale data, and counts the remaining hits.
+ *
+ * @param uint32_t * hit mask.
+ * @param int32_t number of valid colliders.
+ *
+ * @return int32_t number of set bits.
+ */
+static int32_t
+Stds_FinishMask( uint32_t *hit_mask, const int32_t count ) {
+  int32_t words = ( count + 31 ) >> 5;
+  int32_t hits  = 0;
+
+  if ( count & 31 ) {
+    hit_mask[words - 1] &= ( 1u << ( count & 31 ) ) - 1;
+  }
+
+  for ( int32_t w = 0; w < words; w++ ) {
+    hits += Stds_PopCount( hit_mask[w] );
+  }
+
+  return hits;
+}
+
+#if defined( STDS_SIMD_NEON )
+/**
+ * Packs the top bit of each lane into a 4-bit mask, like _mm_movemask_ps.
+ *
+ * @param uint32x4_t comparison result.
+ *
+ * @return uint32_t lane mask.
+ */
+static inline uint32_t
+Stds_NeonMovemask( const uint32x4_t mask ) {
+  return ( vgetq_lane_u32( mask, 0 ) & 1 ) | ( vgetq_lane_u32( mask, 1 ) & 2 ) |
+         ( vgetq_lane_u32( mask, 2 ) & 4 ) | ( vgetq_lane_u32( mask, 3 ) & 8 );
+}
+#endif
+
+/**
+ * Projects two point sets onto axis and checks whether the intervals are
+ * disjoint.
+ *
+ * @param vec2_t * axis to project onto.
+ * @param vec2_t * first point set.
+ * @param int32_t number of points in the first set.
+ * @param vec2_t * second point set.
+ * @param int32_t number of points in the second set.
+ *
+ * @return bool true if the axis separates the sets.
+ */
+static bool
+Stds_SeparatedOnAxis( const struct vec2_t *axis, const struct vec2_t *a, const int32_t a_count,
+                      const struct vec2_t *b, const int32_t b_count ) {
+  float min_a = ( float ) INT32_MAX, max_a = ( float ) -INT32_MAX;
+  for ( int32_t i = 0; i < a_count; i++ ) {
+    float dot = a[i].x * axis->x + a[i].y * axis->y;
+    min_a     = fminf( min_a, dot );
+    max_a     = fmaxf( max_a, dot );
+  }
+
+  float min_b = ( float ) INT32_MAX, max_b = ( float ) -INT32_MAX;
+  for ( int32_t i = 0; i < b_count; i++ ) {
+    float dot = b[i].x * axis->x + b[i].y * axis->y;
+    min_b     = fminf( min_b, dot );
+    max_b     = fmaxf( max_b, dot );
+  }
+
+  return !( max_b >= min_a && max_a >= min_b );
+}
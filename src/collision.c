@@ -16,10 +16,15 @@
  * This file defines the primary collision detectin functions. As of 7/9/2020, we have
  * an AABB collision-response function (returning an enum of the collision side), and a
  * primitive rectangle-overlap test. As of 7/15/2020, circular collision is added along with
- * a primitive response function.
+ * a primitive response function. A uniform-grid spatial hash provides the
+ * broad phase, so only nearby entity pairs reach the narrow-phase tests. For
+ * scenes that mostly scroll along x, a sweep-and-prune list is cheaper still.
  */
 #include "../include/collision.h"
 
+static inline int32_t Stds_SpatialBucket( const struct spatial_hash_t *hash, const int32_t cx,
+                                          const int32_t cy );
+
 /**
  * Determines which side entity_t a collided onto entity_t b. This also resolves
  * the collision, and returns the side of collision.
@@ -31,10 +36,25 @@
  */
 enum CollisionSide
 Stds_CheckAABBCollision( struct entity_t *a, struct entity_t *b ) {
+  SDL_FRect r = { b->pos.x, b->pos.y, ( float ) b->w, ( float ) b->h };
+  return Stds_CheckAABBCollisionRect( a, &r );
+}
+
+/**
+ * Same as Stds_CheckAABBCollision, against a rectangle instead of a second
+ * entity_t, e.g. the world bounds of an entity in an entity_registry_t.
+ *
+ * @param entity_t* entity to resolve.
+ * @param SDL_FRect* rectangle it may overlap.
+ *
+ * @return enum side that a collided onto b with (the side of b).
+ */
+enum CollisionSide
+Stds_CheckAABBCollisionRect( struct entity_t *a, const SDL_FRect *b ) {
   float w  = 0.5f * ( b->w + a->w );
   float h  = 0.5f * ( b->h + a->h );
-  float dx = ( b->pos.x + b->w / 2.0f ) - ( a->pos.x + a->w / 2.0f );
-  float dy = ( b->pos.y + b->h / 2.0f ) - ( a->pos.y + a->h / 2.0f );
+  float dx = ( b->x + b->w / 2.0f ) - ( a->pos.x + a->w / 2.0f );
+  float dy = ( b->y + b->h / 2.0f ) - ( a->pos.y + a->h / 2.0f );
 
   if ( fabs( dx ) < w && fabs( dy ) < h ) {
     float wy = w * dy;
@@ -42,18 +62,18 @@ Stds_CheckAABBCollision( struct entity_t *a, struct entity_t *b ) {
 
     if ( wy >= hx ) {
       if ( wy > -hx ) { // top
-        a->pos.y = b->pos.y - a->h;
+        a->pos.y = b->y - a->h;
         return SIDE_TOP;
       } else { // right
-        a->pos.x = b->pos.x + b->w;
+        a->pos.x = b->x + b->w;
         return SIDE_RIGHT;
       }
     } else {
       if ( wy > -hx ) { // left
-        a->pos.x = b->pos.x - a->w;
+        a->pos.x = b->x - a->w;
         return SIDE_LEFT;
       } else { // bottom
-        a->pos.y = b->pos.y + b->h;
+        a->pos.y = b->y + b->h;
         return SIDE_BOTTOM;
       }
     }
@@ -176,7 +196,7 @@ Stds_RayVsRect( const struct vec2_t *ray, const struct vec2_t *ray_direction, co
   near.y = ( rect->y - ray->y ) / ray_direction->y;
   struct vec2_t far;
   far.x = ( rect->x + rect->w - ray->x ) / ray_direction->x;
-  far.y = ( rect->y + rect->h - ray->x ) / ray_direction->y;
+  far.y = ( rect->y + rect->h - ray->y ) / ray_direction->y;
 
   if ( near.x > far.x ) {
     float temp = near.x;
@@ -264,7 +284,9 @@ Stds_AdvRectVsRect( const SDL_FRect *r1, const SDL_FRect *r2, struct vec2_t *con
 }
 
 /**
- * Checks for a collision between 2 polygons.
+ * Checks for a collision between 2 polygons. The polygons' AABBs are compared
+ * first; only overlapping boxes go on to the separating axis test, which uses
+ * the normals cached by Stds_UpdatePolygon.
  * 
  * @param polygon_t pointer to one polygon.
  * @param polygon_t pointer to second polygon.
@@ -273,38 +295,34 @@ Stds_AdvRectVsRect( const SDL_FRect *r1, const SDL_FRect *r2, struct vec2_t *con
  */
 bool
 Stds_CheckSATOverlap( struct polygon_t *p1, struct polygon_t *p2 ) {
-  struct polygon_t *poly1 = p1;
-  struct polygon_t *poly2 = p2;
+  if ( p1->aabb.x > p2->aabb.x + p2->aabb.w || p2->aabb.x > p1->aabb.x + p1->aabb.w ||
+       p1->aabb.y > p2->aabb.y + p2->aabb.h || p2->aabb.y > p1->aabb.y + p1->aabb.h ) {
+    return false;
+  }
 
-#ifndef TESTS
-#define TESTS 2
-#endif // TESTS
+  struct polygon_t *poly1 = p1;
 
-  for ( int32_t i = 0; i < TESTS; i++ ) {
-    if ( i == 1 ) { // Flips so it tests one against the other.
+  for ( int32_t i = 0; i < 2; i++ ) {
+    if ( i == 1 ) { // Flips so it tests the other polygon's axes.
       poly1 = p2;
-      poly2 = p1;
     }
 
-    for ( int32_t a = 0; a < poly1->sides; a++ ) {
-      int32_t       b               = ( a + 1 ) % poly1->sides;
-      struct vec2_t axis_projection = {-( poly1->points[b].y - poly1->points[a].y ),
-                                       poly1->points[b].x -
-                                           poly1->points[a].x}; // Give normal to edge.
+    for ( int32_t a = 0; a < poly1->normal_count; a++ ) {
+      const struct vec2_t axis_projection = poly1->normals[a];
 
       float min_p1 = ( float ) INT32_MAX, max_p1 = ( float ) -INT32_MAX;
-      for ( int32_t points = 0; points < poly1->sides; points++ ) {
-        float dot = ( poly1->points[points].x * axis_projection.x +
-                      poly1->points[points].y * axis_projection.y );
+      for ( int32_t points = 0; points < p1->sides; points++ ) {
+        float dot =
+          ( p1->points[points].x * axis_projection.x + p1->points[points].y * axis_projection.y );
 
         min_p1 = ( min_p1 < dot ) ? min_p1 : dot;
         max_p1 = ( max_p1 > dot ) ? max_p1 : dot;
       }
 
       float min_p2 = ( float ) INT32_MAX, max_p2 = ( float ) -INT32_MAX;
-      for ( int32_t points = 0; points < poly2->sides; points++ ) {
-        float dot = ( poly2->points[points].x * axis_projection.x +
-                      poly2->points[points].y * axis_projection.y );
+      for ( int32_t points = 0; points < p2->sides; points++ ) {
+        float dot =
+          ( p2->points[points].x * axis_projection.x + p2->points[points].y * axis_projection.y );
 
         min_p2 = ( min_p2 < dot ) ? min_p2 : dot;
         max_p2 = ( max_p2 > dot ) ? max_p2 : dot;
@@ -319,4 +337,376 @@ Stds_CheckSATOverlap( struct polygon_t *p1, struct polygon_t *p2 ) {
   p1->has_overlap = true;
   p2->has_overlap = true;
   return true;
-}
\ No newline at end of file
+}
+
+/**
+ * Creates an empty spatial hash. cell_size should be around the size of a
+ * typical entity; entities larger than a cell are stored in every cell they
+ * touch. bucket_count is rounded up to a power of two.
+ *
+ * @param float width and height of a grid cell.
+ * @param int32_t number of hash buckets.
+ *
+ * @return spatial_hash_t * pointer to spatial hash.
+ */
+struct spatial_hash_t *
+Stds_CreateSpatialHash( const float cell_size, const int32_t bucket_count ) {
+  struct spatial_hash_t *hash;
+  hash = malloc( sizeof( struct spatial_hash_t ) );
+
+  if ( hash == NULL ) {
+    SDL_LogInfo( SDL_LOG_CATEGORY_APPLICATION,
+                 "Could not allocate memory for spatial_hash_t. %s.\n", SDL_GetError() );
+    exit( EXIT_FAILURE );
+  }
+
+  memset( hash, 0, sizeof( struct spatial_hash_t ) );
+
+  int32_t buckets = 16;
+  while ( buckets < bucket_count ) {
+    buckets <<= 1;
+  }
+
+  hash->cell_size     = cell_size;
+  hash->inv_cell_size = 1.0f / cell_size;
+  hash->bucket_count  = buckets;
+  hash->buckets       = malloc( sizeof( int32_t ) * ( size_t ) buckets );
+
+  if ( hash->buckets == NULL ) {
+    SDL_LogInfo( SDL_LOG_CATEGORY_APPLICATION,
+                 "Could not allocate memory for spatial hash buckets. %s.\n", SDL_GetError() );
+    exit( EXIT_FAILURE );
+  }
+
+  Stds_SpatialClear( hash );
+
+  return hash;
+}
+
+/**
+ * Removes every entity from the spatial hash, keeping its memory for the
+ * next rebuild.
+ *
+ * @param spatial_hash_t * pointer to spatial hash.
+ *
+ * @return void.
+ */
+void
+Stds_SpatialClear( struct spatial_hash_t *hash ) {
+  memset( hash->buckets, 0xff, sizeof( int32_t ) * ( size_t ) hash->bucket_count );
+  hash->item_count  = 0;
+  hash->entry_count = 0;
+}
+
+/**
+ * Inserts an entity with its current AABB (pos, w, h) into the spatial hash.
+ * The hash does not follow the entity afterwards, so rebuild it (clear and
+ * re-insert, or Stds_SpatialBuild) once per frame after entities move.
+ *
+ * @param spatial_hash_t * pointer to spatial hash.
+ * @param entity_t * pointer to entity.
+ *
+ * @return void.
+ */
+void
+Stds_SpatialInsert( struct spatial_hash_t *hash, struct entity_t *e ) {
+  if ( hash->item_count == hash->item_capacity ) {
+    hash->item_capacity = hash->item_capacity == 0 ? 256 : hash->item_capacity * 2;
+    hash->items =
+      realloc( hash->items, sizeof( struct spatial_item_t ) * ( size_t ) hash->item_capacity );
+
+    if ( hash->items == NULL ) {
+      SDL_LogInfo( SDL_LOG_CATEGORY_APPLICATION,
+                   "Could not allocate memory for spatial_item_t. %s.\n", SDL_GetError() );
+      exit( EXIT_FAILURE );
+    }
+  }
+
+  int32_t                item = hash->item_count++;
+  struct spatial_item_t *it   = &hash->items[item];
+  it->entity                  = e;
+  it->aabb                    = ( SDL_FRect ){ e->pos.x, e->pos.y, ( float ) e->w, ( float ) e->h };
+  it->stamp                   = 0;
+
+  int32_t x0 = ( int32_t ) floorf( it->aabb.x * hash->inv_cell_size );
+  int32_t y0 = ( int32_t ) floorf( it->aabb.y * hash->inv_cell_size );
+  int32_t x1 = ( int32_t ) floorf( ( it->aabb.x + it->aabb.w ) * hash->inv_cell_size );
+  int32_t y1 = ( int32_t ) floorf( ( it->aabb.y + it->aabb.h ) * hash->inv_cell_size );
+
+  for ( int32_t cy = y0; cy <= y1; cy++ ) {
+    for ( int32_t cx = x0; cx <= x1; cx++ ) {
+      if ( hash->entry_count == hash->entry_capacity ) {
+        hash->entry_capacity = hash->entry_capacity == 0 ? 512 : hash->entry_capacity * 2;
+        hash->entries        = realloc( hash->entries, sizeof( struct spatial_cell_entry_t ) *
+                                                  ( size_t ) hash->entry_capacity );
+
+        if ( hash->entries == NULL ) {
+          SDL_LogInfo( SDL_LOG_CATEGORY_APPLICATION,
+                       "Could not allocate memory for spatial_cell_entry_t. %s.\n",
+                       SDL_GetError() );
+          exit( EXIT_FAILURE );
+        }
+      }
+
+      int32_t bucket = Stds_SpatialBucket( hash, cx, cy );
+      int32_t entry  = hash->entry_count++;
+
+      hash->entries[entry]  = ( struct spatial_cell_entry_t ){ item, cx, cy, hash->buckets[bucket] };
+      hash->buckets[bucket] = entry;
+    }
+  }
+}
+
+/**
+ * Rebuilds the spatial hash from a linked list of entities, such as the
+ * enemy list in the scroller test.
+ *
+ * @param spatial_hash_t * pointer to spatial hash.
+ * @param entity_t * first entity of the list (follows e->next).
+ *
+ * @return void.
+ */
+void
+Stds_SpatialBuild( struct spatial_hash_t *hash, struct entity_t *head ) {
+  Stds_SpatialClear( hash );
+
+  for ( struct entity_t *e = head; e != NULL; e = e->next ) {
+    Stds_SpatialInsert( hash, e );
+  }
+}
+
+/**
+ * Collects every entity whose AABB overlaps rect. Each entity is reported
+ * once even if it spans several cells.
+ *
+ * @param spatial_hash_t * pointer to spatial hash.
+ * @param SDL_FRect * pointer to query rectangle.
+ * @param entity_t ** array receiving the entities.
+ * @param int32_t capacity of the array.
+ *
+ * @return int32_t number of overlapping entities, which may exceed max_out;
+ *         only the first max_out are stored.
+ */
+int32_t
+Stds_SpatialQueryRect( struct spatial_hash_t *hash, const SDL_FRect *rect, struct entity_t **out,
+                       const int32_t max_out ) {
+  int32_t count = 0;
+  int32_t stamp = ++hash->stamp;
+
+  int32_t x0 = ( int32_t ) floorf( rect->x * hash->inv_cell_size );
+  int32_t y0 = ( int32_t ) floorf( rect->y * hash->inv_cell_size );
+  int32_t x1 = ( int32_t ) floorf( ( rect->x + rect->w ) * hash->inv_cell_size );
+  int32_t y1 = ( int32_t ) floorf( ( rect->y + rect->h ) * hash->inv_cell_size );
+
+  for ( int32_t cy = y0; cy <= y1; cy++ ) {
+    for ( int32_t cx = x0; cx <= x1; cx++ ) {
+      int32_t entry = hash->buckets[Stds_SpatialBucket( hash, cx, cy )];
+
+      for ( ; entry != -1; entry = hash->entries[entry].next ) {
+        const struct spatial_cell_entry_t *ce = &hash->entries[entry];
+        struct spatial_item_t *            it = &hash->items[ce->item];
+
+        if ( ce->cx != cx || ce->cy != cy || it->stamp == stamp ) {
+          continue;
+        }
+
+        it->stamp = stamp;
+        if ( Stds_RectVsRect( &it->aabb, rect ) ) {
+          if ( count < max_out ) {
+            out[count] = it->entity;
+          }
+          count++;
+        }
+      }
+    }
+  }
+
+  return count;
+}
+
+/**
+ * Calls callback once for every pair of entities whose AABBs overlap. Only
+ * entities sharing a cell are compared, so the narrow-phase callback (e.g.
+ * Stds_CheckAABBCollision or Stds_CheckSATOverlap) only sees nearby pairs.
+ *
+ * @param spatial_hash_t * pointer to spatial hash.
+ * @param void (*)(entity_t *, entity_t *, void *) function called per pair.
+ * @param void * user data passed to the callback.
+ *
+ * @return void.
+ */
+void
+Stds_SpatialForEachPair( struct spatial_hash_t *hash,
+                         void ( *callback )( struct entity_t *, struct entity_t *, void * ),
+                         void *data ) {
+  for ( int32_t i = 0; i < hash->item_count; i++ ) {
+    struct spatial_item_t *a     = &hash->items[i];
+    int32_t                stamp = ++hash->stamp;
+
+    int32_t x0 = ( int32_t ) floorf( a->aabb.x * hash->inv_cell_size );
+    int32_t y0 = ( int32_t ) floorf( a->aabb.y * hash->inv_cell_size );
+    int32_t x1 = ( int32_t ) floorf( ( a->aabb.x + a->aabb.w ) * hash->inv_cell_size );
+    int32_t y1 = ( int32_t ) floorf( ( a->aabb.y + a->aabb.h ) * hash->inv_cell_size );
+
+    for ( int32_t cy = y0; cy <= y1; cy++ ) {
+      for ( int32_t cx = x0; cx <= x1; cx++ ) {
+        int32_t entry = hash->buckets[Stds_SpatialBucket( hash, cx, cy )];
+
+        for ( ; entry != -1; entry = hash->entries[entry].next ) {
+          const struct spatial_cell_entry_t *ce = &hash->entries[entry];
+
+          /* Only pair with later items so each pair is reported once. */
+          if ( ce->item <= i || ce->cx != cx || ce->cy != cy ) {
+            continue;
+          }
+
+          struct spatial_item_t *b = &hash->items[ce->item];
+          if ( b->stamp == stamp ) {
+            continue;
+          }
+
+          b->stamp = stamp;
+          if ( Stds_RectVsRect( &a->aabb, &b->aabb ) ) {
+            callback( a->entity, b->entity, data );
+          }
+        }
+      }
+    }
+  }
+}
+
+/**
+ * Frees the spatial hash. The indexed entities are not touched.
+ *
+ * @param spatial_hash_t * pointer to spatial hash.
+ *
+ * @return void.
+ */
+void
+Stds_SpatialHashDie( struct spatial_hash_t *hash ) {
+  free( hash->buckets );
+  free( hash->items );
+  free( hash->entries );
+  free( hash );
+}
+
+/**
+ * Creates an empty sweep-and-prune list.
+ *
+ * @param void.
+ *
+ * @return sweep_and_prune_t * pointer to the list.
+ */
+struct sweep_and_prune_t *
+Stds_CreateSweepAndPrune( void ) {
+  struct sweep_and_prune_t *sap;
+  sap = malloc( sizeof( struct sweep_and_prune_t ) );
+
+  if ( sap == NULL ) {
+    SDL_LogInfo( SDL_LOG_CATEGORY_APPLICATION,
+                 "Could not allocate memory for sweep_and_prune_t. %s.\n", SDL_GetError() );
+    exit( EXIT_FAILURE );
+  }
+
+  memset( sap, 0, sizeof( struct sweep_and_prune_t ) );
+  return sap;
+}
+
+/**
+ * Sorts the entities' x intervals and calls callback for every pair whose
+ * AABBs overlap. The callback should run the narrow phase, e.g.
+ * Stds_CheckAABBCollision or Stds_CheckSATOverlap.
+ *
+ * The sorted order is kept in sap between calls and re-sorted with insertion
+ * sort, so passing the same array each frame costs close to O(n) when
+ * entities move only a little. If n changes, the order is rebuilt.
+ *
+ * @param sweep_and_prune_t * pointer to the list.
+ * @param entity_t ** array of entities to test.
+ * @param int32_t number of entities.
+ * @param void (*)(entity_t *, entity_t *, void *) function called per pair.
+ * @param void * user data passed to the callback.
+ *
+ * @return void.
+ */
+void
+Stds_SweepAndPrune( struct sweep_and_prune_t *sap, struct entity_t **entities, const int32_t n,
+                    void ( *callback )( struct entity_t *, struct entity_t *, void * ),
+                    void *data ) {
+  if ( n != sap->count ) {
+    if ( n > sap->capacity ) {
+      sap->capacity  = n;
+      sap->intervals = realloc( sap->intervals, sizeof( struct sap_interval_t ) * ( size_t ) n );
+
+      if ( sap->intervals == NULL ) {
+        SDL_LogInfo( SDL_LOG_CATEGORY_APPLICATION,
+                     "Could not allocate memory for sap_interval_t. %s.\n", SDL_GetError() );
+        exit( EXIT_FAILURE );
+      }
+    }
+
+    for ( int32_t i = 0; i < n; i++ ) {
+      sap->intervals[i].index = i;
+    }
+    sap->count = n;
+  }
+
+  /* Refresh the bounds in the previous frame's order, then insertion sort. */
+  struct sap_interval_t *list = sap->intervals;
+  for ( int32_t i = 0; i < n; i++ ) {
+    const struct entity_t *e = entities[list[i].index];
+    list[i].min_x            = e->pos.x;
+    list[i].max_x            = e->pos.x + e->w;
+  }
+
+  for ( int32_t i = 1; i < n; i++ ) {
+    struct sap_interval_t key = list[i];
+    int32_t               j   = i - 1;
+
+    while ( j >= 0 && list[j].min_x > key.min_x ) {
+      list[j + 1] = list[j];
+      j--;
+    }
+    list[j + 1] = key;
+  }
+
+  for ( int32_t i = 0; i < n; i++ ) {
+    struct entity_t *a = entities[list[i].index];
+
+    for ( int32_t j = i + 1; j < n && list[j].min_x < list[i].max_x; j++ ) {
+      struct entity_t *b = entities[list[j].index];
+
+      if ( a->pos.y < b->pos.y + b->h && b->pos.y < a->pos.y + a->h ) {
+        callback( a, b, data );
+      }
+    }
+  }
+}
+
+/**
+ * Frees the sweep-and-prune list. The entities are not touched.
+ *
+ * @param sweep_and_prune_t * pointer to the list.
+ *
+ * @return void.
+ */
+void
+Stds_SweepAndPruneDie( struct sweep_and_prune_t *sap ) {
+  free( sap->intervals );
+  free( sap );
+}
+
+/**
+ * Maps a cell coordinate to its bucket.
+ *
+ * @param spatial_hash_t * pointer to spatial hash.
+ * @param int32_t cell column.
+ * @param int32_t cell row.
+ *
+ * @return int32_t bucket index.
+ */
+static inline int32_t
+Stds_SpatialBucket( const struct spatial_hash_t *hash, const int32_t cx, const int32_t cy ) {
+  uint32_t h = ( ( uint32_t ) cx * 73856093u ) ^ ( ( uint32_t ) cy * 19349663u );
+  return ( int32_t )( h & ( uint32_t )( hash->bucket_count - 1 ) );
+}
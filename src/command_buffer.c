@@ -0,0 +1,591 @@
+/**
+ * @file command_buffer.c
+ * @author Joshua Crotts
+ * @date October 14 2026
+ * @version 1.0
+ *
+ * @section LICENSE
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License as
+ * published by the Free Software Foundation; either version 2 of
+ * the License, or (at your option) any later version.
+ *
+ * @section DESCRIPTION
+ *
+ * This file defines the double-buffered render command list. While a thread
+ * records, the draw.c functions it calls append commands to the back buffer
+ * instead of talking to SDL; Stds_SubmitCommands later replays the front
+ * buffer on the main thread. Stds_SetCommandBuffering turns this on for the
+ * game loop. With STDS_COMMANDS_BATCH, consecutive textured draws are replayed
+ * through a sprite batch, so they are sorted by layer and texture and drawn
+ * with one call per texture. With STDS_COMMANDS_SORT, the whole frame is
+ * replayed in the order of each draw's sort key (layer, depth, blend mode,
+ * texture), so draws may be reordered freely within those bounds. With
+ * STDS_COMMANDS_OVERLAP, the loop runs the
+ * update delegate and records the draw delegate for the next frame on a job
+ * thread while the main thread replays and presents the current one, at the
+ * cost of one frame of latency. The delegates then must not call SDL render
+ * functions themselves, nor create textures (text whose string changes, chunk
+ * caches of grids and tilemaps that are not built yet), since those are only
+ * safe on the main thread. Profiler markers inside the delegates are ignored
+ * there too; the loop only reports the delegates' total update and draw times.
+ */
+#include "../include/command_buffer.h"
+#include "../lib/structures/include/stds_hashmap.h"
+
+static struct command_buffer_t buffers[2];
+static int32_t                 front_buffer;
+static uint32_t                command_flags;
+static SDL_TLSID               recording_slot;
+static struct command_sort_t   command_sort;
+
+static void Stds_ResetCommandBuffer( struct command_buffer_t *buffer );
+static void Stds_SubmitSortedCommands( const struct command_buffer_t *buffer );
+static void Stds_GrowCommandSort( const int32_t count );
+static void Stds_ReplayCommand( const struct command_buffer_t *buffer,
+                                const struct render_command_t *cmd );
+
+/**
+ * Sets how the game loop records and submits draw calls. 0 draws directly, as
+ * without a command buffer; otherwise flags is STDS_COMMANDS_ON, optionally
+ * or-ed with STDS_COMMANDS_BATCH and STDS_COMMANDS_OVERLAP. Call this outside
+ * of the delegates, e.g. before starting the game loop.
+ *
+ * @param uint32_t STDS_COMMANDS_* flags.
+ *
+ * @return void.
+ */
+void
+Stds_SetCommandBuffering( const uint32_t flags ) {
+  if ( recording_slot == 0 ) {
+    recording_slot = SDL_TLSCreate();
+  }
+
+  command_flags = flags != 0 ? flags | STDS_COMMANDS_ON : 0;
+  Stds_ResetCommandBuffer( &buffers[0] );
+  Stds_ResetCommandBuffer( &buffers[1] );
+}
+
+/**
+ * Returns the flags given to Stds_SetCommandBuffering.
+ *
+ * @param void.
+ *
+ * @return uint32_t STDS_COMMANDS_* flags, 0 when off.
+ */
+uint32_t
+Stds_GetCommandFlags( void ) {
+  return command_flags;
+}
+
+/**
+ * Clears the back buffer and starts recording into it on the calling thread.
+ * Only draws issued from this thread are recorded.
+ *
+ * @param void.
+ *
+ * @return void.
+ */
+void
+Stds_BeginCommands( void ) {
+  if ( recording_slot == 0 ) {
+    recording_slot = SDL_TLSCreate();
+  }
+
+  struct command_buffer_t *back = &buffers[1 - front_buffer];
+  Stds_ResetCommandBuffer( back );
+  SDL_TLSSet( recording_slot, back, NULL );
+}
+
+/**
+ * Stops recording on the calling thread; draws go to SDL directly again.
+ *
+ * @param void.
+ *
+ * @return void.
+ */
+void
+Stds_EndCommands( void ) {
+  SDL_TLSSet( recording_slot, NULL, NULL );
+}
+
+/**
+ * Makes the last recorded buffer the one Stds_SubmitCommands replays. Neither
+ * buffer may be in use by a recording or submitting thread.
+ *
+ * @param void.
+ *
+ * @return void.
+ */
+void
+Stds_SwapCommands( void ) {
+  front_buffer = 1 - front_buffer;
+}
+
+/**
+ * Replays the front buffer through the draw.c functions, in recording order.
+ * With STDS_COMMANDS_BATCH, every run of textured draws outside an explicit
+ * batch becomes a sprite batch. Color and alpha mods do not break a run,
+ * since sprites capture them; primitives and texture blend mode changes do.
+ * With STDS_COMMANDS_SORT, draws are replayed in sort-key order instead.
+ * Must be called on the main thread.
+ *
+ * @param void.
+ *
+ * @return void.
+ */
+void
+Stds_SubmitCommands( void ) {
+  const struct command_buffer_t *buffer      = &buffers[front_buffer];
+  const bool                     is_batched  = ( command_flags & STDS_COMMANDS_BATCH ) != 0;
+  bool                           is_implicit = false;
+  bool                           is_explicit = false;
+  int32_t                        layer       = 0;
+  uint16_t                       depth       = 0;
+
+  if ( command_flags & STDS_COMMANDS_SORT ) {
+    Stds_SubmitSortedCommands( buffer );
+    return;
+  }
+
+  for ( int32_t i = 0; i < buffer->count; i++ ) {
+    const struct render_command_t *cmd = &buffer->commands[i];
+
+    switch ( cmd->type ) {
+    case STDS_COMMAND_TEXTURE:
+    case STDS_COMMAND_SPRITE:
+      if ( is_batched && !is_explicit && !is_implicit ) {
+        Stds_BatchBegin();
+        Stds_BatchSetLayer( layer );
+        Stds_BatchSetDepth( depth );
+        is_implicit = true;
+      }
+      break;
+    case STDS_COMMAND_BATCH_LAYER:
+      layer = cmd->layer;
+      break;
+    case STDS_COMMAND_BATCH_DEPTH:
+      depth = ( uint16_t ) cmd->layer;
+      break;
+    case STDS_COMMAND_DRAW_COLOR:
+    case STDS_COMMAND_DRAW_BLEND:
+    case STDS_COMMAND_TEXTURE_COLOR:
+    case STDS_COMMAND_TEXTURE_ALPHA:
+      break;
+    default:
+      if ( is_implicit ) {
+        Stds_BatchEnd();
+        is_implicit = false;
+      }
+
+      if ( cmd->type == STDS_COMMAND_BATCH_BEGIN ) {
+        is_explicit = true;
+        layer       = 0;
+        depth       = 0;
+      } else if ( cmd->type == STDS_COMMAND_BATCH_END ) {
+        is_explicit = false;
+      }
+      break;
+    }
+
+    Stds_ReplayCommand( buffer, cmd );
+  }
+
+  if ( is_implicit ) {
+    Stds_BatchEnd();
+  }
+}
+
+/**
+ * Returns whether draws on the calling thread are being recorded.
+ *
+ * @param void.
+ *
+ * @return bool true between Stds_BeginCommands and Stds_EndCommands.
+ */
+bool
+Stds_IsRecordingCommands( void ) {
+  return recording_slot != 0 && SDL_TLSGet( recording_slot ) != NULL;
+}
+
+/**
+ * Appends a zeroed command of the given type to the buffer recording on the
+ * calling thread. Only valid while Stds_IsRecordingCommands is true.
+ *
+ * @param uint8_t STDS_COMMAND_* type.
+ *
+ * @return render_command_t * pointer to the command, valid until the next push.
+ */
+struct render_command_t *
+Stds_PushCommand( const uint8_t type ) {
+  struct command_buffer_t *buffer = SDL_TLSGet( recording_slot );
+
+  if ( buffer->count == buffer->capacity ) {
+    buffer->capacity = buffer->capacity == 0 ? 256 : buffer->capacity * 2;
+    buffer->commands = realloc( buffer->commands,
+                                sizeof( struct render_command_t ) * ( size_t ) buffer->capacity );
+
+    if ( buffer->commands == NULL ) {
+      SDL_LogInfo( SDL_LOG_CATEGORY_APPLICATION,
+                   "Could not allocate memory for render_command_t. %s.\n", SDL_GetError() );
+      exit( EXIT_FAILURE );
+    }
+  }
+
+  struct render_command_t *cmd = &buffer->commands[buffer->count++];
+  memset( cmd, 0, sizeof( struct render_command_t ) );
+  cmd->type = type;
+  return cmd;
+}
+
+/**
+ * Copies data into the payload of the buffer recording on the calling thread.
+ * Each copy starts on a 4-byte boundary, so copies of arrays of 4-byte
+ * multiples follow each other without gaps.
+ *
+ * @param void * bytes to copy.
+ * @param size_t number of bytes.
+ * @param uint32_t * receives the offset of the copy within the payload, or NULL.
+ *
+ * @return void * pointer to the copy, valid until the next payload push.
+ */
+void *
+Stds_PushCommandPayload( const void *data, const size_t size, uint32_t *offset ) {
+  struct command_buffer_t *buffer = SDL_TLSGet( recording_slot );
+  size_t                   start  = buffer->payload_size;
+  size_t                   needed = start + ( ( size + 3 ) & ~( size_t ) 3 );
+
+  if ( needed > buffer->payload_capacity ) {
+    size_t capacity = buffer->payload_capacity == 0 ? 4096 : buffer->payload_capacity;
+    while ( capacity < needed ) {
+      capacity *= 2;
+    }
+
+    buffer->payload = realloc( buffer->payload, capacity );
+
+    if ( buffer->payload == NULL ) {
+      SDL_LogInfo( SDL_LOG_CATEGORY_APPLICATION,
+                   "Could not allocate memory for command payload. %s.\n", SDL_GetError() );
+      exit( EXIT_FAILURE );
+    }
+
+    buffer->payload_capacity = capacity;
+  }
+
+  memcpy( buffer->payload + start, data, size );
+  buffer->payload_size = needed;
+
+  if ( offset != NULL ) {
+    *offset = ( uint32_t ) start;
+  }
+
+  return buffer->payload + start;
+}
+
+/**
+ * Frees both command buffers and turns command buffering off.
+ *
+ * @param void.
+ *
+ * @return void.
+ */
+void
+Stds_CommandBufferDie( void ) {
+  for ( int32_t i = 0; i < 2; i++ ) {
+    free( buffers[i].commands );
+    free( buffers[i].payload );
+    memset( &buffers[i], 0, sizeof( struct command_buffer_t ) );
+  }
+
+  free( command_sort.keys );
+  free( command_sort.order );
+  free( command_sort.scratch );
+  free( command_sort.commands );
+  free( command_sort.colors );
+  if ( command_sort.mods != NULL ) {
+    Stds_HashMapDestroy( command_sort.mods );
+  }
+  memset( &command_sort, 0, sizeof( struct command_sort_t ) );
+
+  command_flags = 0;
+}
+
+/**
+ * Empties a buffer, keeping its memory for the next frame.
+ *
+ * @param command_buffer_t * buffer.
+ *
+ * @return void.
+ */
+static void
+Stds_ResetCommandBuffer( struct command_buffer_t *buffer ) {
+  buffer->count        = 0;
+  buffer->payload_size = 0;
+}
+
+/**
+ * Replays a buffer in sort-key order. A first pass in recording order applies
+ * every state command and gives each draw its key and, for textured draws,
+ * the color and alpha mods in effect when it was recorded. The draws are then
+ * radix sorted and issued, textured ones through one sprite batch per run.
+ * Explicit batches are ignored, since the whole frame is sorted anyway. A
+ * texture whose blend mode changes during the frame draws with the last one,
+ * and quads use the draw state left at the end of the frame.
+ *
+ * @param command_buffer_t * buffer to replay.
+ *
+ * @return void.
+ */
+static void
+Stds_SubmitSortedCommands( const struct command_buffer_t *buffer ) {
+  int32_t  draws = 0;
+  int32_t  layer = 0;
+  uint16_t depth = 0;
+
+  Stds_GrowCommandSort( buffer->count );
+  Stds_HashMapClear( command_sort.mods );
+
+  for ( int32_t i = 0; i < buffer->count; i++ ) {
+    const struct render_command_t *cmd = &buffer->commands[i];
+    SDL_BlendMode                  blend;
+    SDL_Color                      mod;
+    SDL_Color *                    known;
+
+    switch ( cmd->type ) {
+    case STDS_COMMAND_BATCH_BEGIN:
+      layer = 0;
+      depth = 0;
+      break;
+    case STDS_COMMAND_BATCH_LAYER:
+      layer = cmd->layer;
+      break;
+    case STDS_COMMAND_BATCH_DEPTH:
+      depth = ( uint16_t ) cmd->layer;
+      break;
+    case STDS_COMMAND_BATCH_END:
+      break;
+    case STDS_COMMAND_TEXTURE_COLOR:
+    case STDS_COMMAND_TEXTURE_ALPHA:
+      known = Stds_HashMapGetInt( command_sort.mods, ( uint64_t ) ( uintptr_t ) cmd->texture );
+      if ( known == NULL ) {
+        Stds_GetTextureMods( cmd->texture, &mod, NULL );
+        known = Stds_HashMapPutInt( command_sort.mods, ( uint64_t ) ( uintptr_t ) cmd->texture,
+                                    &mod );
+      }
+
+      if ( cmd->type == STDS_COMMAND_TEXTURE_COLOR ) {
+        known->r = cmd->color.r;
+        known->g = cmd->color.g;
+        known->b = cmd->color.b;
+      } else {
+        known->a = cmd->color.a;
+      }
+
+      Stds_ReplayCommand( buffer, cmd );
+      break;
+    case STDS_COMMAND_DRAW_COLOR:
+    case STDS_COMMAND_DRAW_BLEND:
+    case STDS_COMMAND_TEXTURE_BLEND:
+      Stds_ReplayCommand( buffer, cmd );
+      break;
+    case STDS_COMMAND_TEXTURE:
+    case STDS_COMMAND_SPRITE:
+      Stds_GetTextureMods( cmd->texture, &mod, &blend );
+      known = Stds_HashMapGetInt( command_sort.mods, ( uint64_t ) ( uintptr_t ) cmd->texture );
+
+      if ( cmd->type == STDS_COMMAND_SPRITE ) {
+        command_sort.colors[draws] = cmd->color;
+        command_sort.keys[draws]   = Stds_MakeSortKey( cmd->layer, depth, blend, cmd->texture );
+      } else {
+        command_sort.colors[draws] = known != NULL ? *known : mod;
+        command_sort.keys[draws]   = Stds_MakeSortKey( layer, depth, blend, cmd->texture );
+      }
+
+      command_sort.commands[draws++] = i;
+      break;
+    default:
+      command_sort.keys[draws]
+          = Stds_MakeSortKey( layer, depth, SDL_BLENDMODE_BLEND, cmd->texture );
+      command_sort.commands[draws++] = i;
+      break;
+    }
+  }
+
+  Stds_RadixSortKeys( command_sort.keys, command_sort.order, command_sort.scratch, draws );
+
+  bool is_batch = false;
+  for ( int32_t i = 0; i < draws; i++ ) {
+    const uint32_t                 d   = command_sort.order[i];
+    const struct render_command_t *cmd = &buffer->commands[command_sort.commands[d]];
+
+    if ( cmd->type != STDS_COMMAND_TEXTURE && cmd->type != STDS_COMMAND_SPRITE ) {
+      if ( is_batch ) {
+        Stds_BatchEnd();
+        is_batch = false;
+      }
+
+      Stds_ReplayCommand( buffer, cmd );
+      continue;
+    }
+
+    if ( !is_batch ) {
+      Stds_BatchBegin();
+      is_batch = true;
+    }
+
+    /* The key holds the layer and depth the draw was recorded with. */
+    const uint64_t    key    = command_sort.keys[d];
+    const SDL_Rect *  src    = cmd->flags & STDS_COMMAND_HAS_SRC ? &cmd->src : NULL;
+    const SDL_FPoint *center = cmd->flags & STDS_COMMAND_HAS_CENTER ? &cmd->center : NULL;
+
+    Stds_BatchSetDepth( ( uint16_t ) ( key >> 32 ) );
+    Stds_BatchPush( cmd->texture, src, &cmd->dst, cmd->angle, center, cmd->flip,
+                    &command_sort.colors[d], ( int32_t ) ( key >> 48 ) - 0x8000 );
+  }
+
+  if ( is_batch ) {
+    Stds_BatchEnd();
+  }
+}
+
+/**
+ * Grows the sort scratch to hold count commands.
+ *
+ * @param int32_t number of commands.
+ *
+ * @return void.
+ */
+static void
+Stds_GrowCommandSort( const int32_t count ) {
+  if ( command_sort.mods == NULL ) {
+    command_sort.mods = Stds_HashMapCreate( sizeof( SDL_Color ), STDS_HASHMAP_INT_KEYS );
+  }
+
+  if ( count <= command_sort.capacity ) {
+    return;
+  }
+
+  size_t n              = ( size_t ) count;
+  command_sort.keys     = realloc( command_sort.keys, sizeof( uint64_t ) * n );
+  command_sort.order    = realloc( command_sort.order, sizeof( uint32_t ) * n );
+  command_sort.scratch  = realloc( command_sort.scratch, sizeof( uint32_t ) * n );
+  command_sort.commands = realloc( command_sort.commands, sizeof( int32_t ) * n );
+  command_sort.colors   = realloc( command_sort.colors, sizeof( SDL_Color ) * n );
+  command_sort.capacity = count;
+
+  if ( command_sort.keys == NULL || command_sort.order == NULL || command_sort.scratch == NULL
+       || command_sort.commands == NULL || command_sort.colors == NULL ) {
+    SDL_LogInfo( SDL_LOG_CATEGORY_APPLICATION, "Could not allocate memory for command sort. %s.\n",
+                 SDL_GetError() );
+    exit( EXIT_FAILURE );
+  }
+}
+
+/**
+ * Issues one command through the matching draw.c function.
+ *
+ * @param command_buffer_t * buffer holding the command's payload.
+ * @param render_command_t * command.
+ *
+ * @return void.
+ */
+static void
+Stds_ReplayCommand( const struct command_buffer_t *buffer, const struct render_command_t *cmd ) {
+  const SDL_Rect *  src    = cmd->flags & STDS_COMMAND_HAS_SRC ? &cmd->src : NULL;
+  const SDL_FPoint *center = cmd->flags & STDS_COMMAND_HAS_CENTER ? &cmd->center : NULL;
+  SDL_FRect         dst    = cmd->dst;
+
+  switch ( cmd->type ) {
+  case STDS_COMMAND_TEXTURE:
+    Stds_BlitTexture( cmd->texture, src, dst.x, dst.y, dst.w, dst.h, ( uint16_t ) cmd->angle,
+                      cmd->flip, center, false );
+    break;
+  case STDS_COMMAND_SPRITE:
+    Stds_BatchPush( cmd->texture, src, &dst, cmd->angle, center, cmd->flip, &cmd->color,
+                    cmd->layer );
+    break;
+  case STDS_COMMAND_RECT:
+    Stds_DrawRectF( &dst, &cmd->color, ( cmd->flags & STDS_COMMAND_IS_FILLED ) != 0, false );
+    break;
+  case STDS_COMMAND_LINE:
+    Stds_DrawLine( dst.x, dst.y, dst.w, dst.h, &cmd->color );
+    break;
+  case STDS_COMMAND_CIRCLE: {
+    struct circle_t circle;
+    circle.center_x = dst.x;
+    circle.center_y = dst.y;
+    circle.radius   = dst.w;
+    Stds_DrawCircle( &circle, &cmd->color, ( cmd->flags & STDS_COMMAND_IS_FILLED ) != 0 );
+    break;
+  }
+  case STDS_COMMAND_QUADS: {
+    const uint8_t *  p      = buffer->payload + cmd->offset;
+    const SDL_FRect *dsts   = ( const SDL_FRect * ) p;
+    const SDL_Rect * srcs   = NULL;
+    const SDL_Color *colors = NULL;
+
+    p += sizeof( SDL_FRect ) * ( size_t ) cmd->count;
+    if ( cmd->flags & STDS_COMMAND_HAS_SRC ) {
+      srcs = ( const SDL_Rect * ) p;
+      p += sizeof( SDL_Rect ) * ( size_t ) cmd->count;
+    }
+
+    if ( cmd->flags & STDS_COMMAND_HAS_COLORS ) {
+      colors = ( const SDL_Color * ) p;
+    }
+
+    Stds_DrawQuads( cmd->texture, dsts, srcs, colors, cmd->count, false );
+    break;
+  }
+  case STDS_COMMAND_CIRCLES: {
+    const uint8_t *        p       = buffer->payload + cmd->offset;
+    const struct circle_t *circles = ( const struct circle_t * ) p;
+    const SDL_Color *      colors  = NULL;
+
+    if ( cmd->flags & STDS_COMMAND_HAS_COLORS ) {
+      colors = ( const SDL_Color * ) ( p + sizeof( struct circle_t ) * ( size_t ) cmd->count );
+    }
+
+    Stds_DrawCircles( circles, colors, cmd->count, ( cmd->flags & STDS_COMMAND_IS_FILLED ) != 0 );
+    break;
+  }
+  case STDS_COMMAND_RECTS:
+    Stds_DrawRects( ( const SDL_FRect * ) ( buffer->payload + cmd->offset ), cmd->count,
+                    &cmd->color, ( cmd->flags & STDS_COMMAND_IS_FILLED ) != 0, false );
+    break;
+  case STDS_COMMAND_LINES:
+    Stds_DrawLines( ( const SDL_FPoint * ) ( buffer->payload + cmd->offset ), cmd->count,
+                    &cmd->color );
+    break;
+  case STDS_COMMAND_BATCH_BEGIN:
+    Stds_BatchBegin();
+    break;
+  case STDS_COMMAND_BATCH_LAYER:
+    Stds_BatchSetLayer( cmd->layer );
+    break;
+  case STDS_COMMAND_BATCH_DEPTH:
+    Stds_BatchSetDepth( ( uint16_t ) cmd->layer );
+    break;
+  case STDS_COMMAND_BATCH_END:
+    Stds_BatchEnd();
+    break;
+  case STDS_COMMAND_DRAW_COLOR:
+    Stds_SetDrawColor( &cmd->color );
+    break;
+  case STDS_COMMAND_DRAW_BLEND:
+    Stds_SetDrawBlendMode( cmd->blend_mode );
+    break;
+  case STDS_COMMAND_TEXTURE_BLEND:
+    Stds_SetTextureBlendMode( cmd->texture, cmd->blend_mode );
+    break;
+  case STDS_COMMAND_TEXTURE_COLOR:
+    Stds_SetTextureColorMod( cmd->texture, cmd->color.r, cmd->color.g, cmd->color.b );
+    break;
+  case STDS_COMMAND_TEXTURE_ALPHA:
+    Stds_SetTextureAlphaMod( cmd->texture, cmd->color.a );
+    break;
+  default:
+    break;
+  }
+}
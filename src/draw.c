@@ -18,13 +18,67 @@
  * as of 7/25/2020, there IS a distinction between blitting and drawing! Blitting refers
  * to COPYING and altering a texture, whereas drawing simply means drawning with no crops
  * or cuts. Alterations may exist, but there's no splicing like a sprite sheet would have.
+ * Draw color, blend mode and texture mods go through a shadow-state cache that skips
+ * SDL calls which would not change anything. Primitives draw with alpha blending.
+ * Between Stds_BatchBegin and Stds_BatchEnd, textured draws are queued in a sprite
+ * batch and flushed sorted by a 64-bit key of layer, depth, blend mode and texture,
+ * one SDL_RenderGeometry call per run.
+ * Textures whose destination lies entirely off screen are culled before submission.
+ * Circles are drawn from meshes built once per radius bucket, and arrays of circles,
+ * rectangles or line points drawn together cost one render call per array.
+ * While a command buffer records on the calling thread, every draw and state call
+ * here is appended to it instead, with the camera offset already applied.
+ * Cached textures are counted against a memory budget. Once it is exceeded, textures
+ * with no Stds_LoadTexture reference left that were not drawn in the last two frames
+ * are destroyed least recently used first, and reload from their file when resolved.
  */
 #include "../include/draw.h"
+#include "../include/camera.h"
+#include "../include/command_buffer.h"
+#include "../include/pack.h"
+#include "../lib/structures/include/stds_hashmap.h"
 
-static SDL_Texture *Stds_GetTexture( const char * );
-static void         Stds_CacheTexture( const char *, SDL_Texture * );
-static void         Stds_FillCircleHelper( const struct circle_t *, const SDL_Color * );
-static void         Stds_DrawCircleHelper( const struct circle_t *, const SDL_Color * );
+static int32_t      Stds_GetTexture( const char *, const uint32_t );
+static int32_t      Stds_CacheTexture( const char *, const uint32_t, SDL_Texture * );
+static void         Stds_GrowTextureTable( void );
+static SDL_Texture *Stds_ReadTexture( const char *, const bool );
+static SDL_Texture *Stds_ResidentTexture( const int32_t );
+static void         Stds_MapTextureHandle( const int32_t );
+static size_t       Stds_TextureBytes( SDL_Texture * );
+static void         Stds_EvictTextures( void );
+static struct texture_state_t *Stds_GetTextureState( SDL_Texture * );
+static void         Stds_BatchQueue( SDL_Texture *, const SDL_Rect *, const SDL_FRect *,
+                                     const float, const SDL_FPoint *, const SDL_RendererFlip,
+                                     const SDL_Color *, const int32_t );
+static void         Stds_SortSprites( void );
+static void         Stds_FlushSprites( const struct sprite_t *, const int32_t );
+static bool         Stds_IsDestVisible( const SDL_FRect *, const uint16_t, const SDL_FPoint * );
+static struct render_command_t *Stds_RecordTexture( const uint8_t, SDL_Texture *, const SDL_Rect *,
+                                                    const SDL_FRect *, const float,
+                                                    const SDL_RendererFlip, const SDL_FPoint * );
+
+#define STDS_TEXTURE_KNOWN_BLEND 1
+#define STDS_TEXTURE_KNOWN_COLOR 2
+#define STDS_TEXTURE_KNOWN_ALPHA 4
+
+static struct render_state_t render_state;
+static struct sprite_batch_t sprite_batch;
+static SDL_FRect             shape_rects[STDS_QUAD_BATCH_SIZE];
+
+/* Circle meshes share the quad vertex buffer but bring their own indices. */
+#if SDL_VERSION_ATLEAST( 2, 0, 18 )
+static SDL_Vertex           quad_vertices[STDS_QUAD_BATCH_SIZE * 4];
+static int32_t              quad_indices[STDS_QUAD_BATCH_SIZE * 6];
+static bool                 quad_indices_ready = false;
+static int32_t              shape_indices[STDS_QUAD_BATCH_SIZE * 6];
+static struct shape_cache_t shape_cache;
+
+static void Stds_InitQuadIndices( void );
+static void Stds_InitShapeCache( void );
+#else
+static void Stds_FillCircleHelper( const struct circle_t *, const SDL_Color * );
+static void Stds_DrawCircleHelper( const struct circle_t *, const SDL_Color * );
+#endif
 
 /**
  * Clears the screen with a black color.
@@ -35,12 +89,14 @@ static void         Stds_DrawCircleHelper( const struct circle_t *, const SDL_Co
  */
 void
 Stds_PrepareScene( void ) {
-  SDL_SetRenderDrawColor( g_app.renderer, 0, 0, 0, 0 );
+  const SDL_Color black = { 0, 0, 0, 0 };
+  Stds_SetDrawColor( &black );
   SDL_RenderClear( g_app.renderer );
 }
 
 /**
- * Presents the current scene from the application.
+ * Presents the current scene from the application, then evicts idle
+ * cached textures if they are over the memory budget.
  *
  * @param void.
  *
@@ -49,6 +105,8 @@ Stds_PrepareScene( void ) {
 void
 Stds_PresentScene( void ) {
   SDL_RenderPresent( g_app.renderer );
+  g_app.texture_frame++;
+  Stds_EvictTextures();
 }
 
 /**
@@ -78,9 +136,67 @@ Stds_DrawTexture( SDL_Texture *texture, const float x, const float y, const floa
   dest_rect.w = w;
   dest_rect.h = h;
 
+  if ( !Stds_IsDestVisible( &dest_rect, angle, rotate_point ) ) {
+    return;
+  }
+
+  if ( Stds_IsRecordingCommands() ) {
+    Stds_RecordTexture( STDS_COMMAND_TEXTURE, texture, NULL, &dest_rect, angle, flip,
+                        rotate_point );
+    return;
+  }
+
+  if ( sprite_batch.is_active ) {
+    Stds_BatchQueue( texture, NULL, &dest_rect, angle, rotate_point, flip, NULL,
+                     sprite_batch.layer );
+    return;
+  }
+
   SDL_RenderCopyExF( g_app.renderer, texture, NULL, &dest_rect, angle, rotate_point, flip );
 }
 
+/**
+ * Draws a texture of size w by h centered on the origin of a transform
+ * matrix, rotated and scaled by it. The matrix is decomposed into
+ * translation, rotation and scale; a mirrored matrix flips the texture
+ * horizontally. Shear cannot be drawn and is ignored.
+ *
+ * @param SDL_Texture * pointer to texture object.
+ * @param float width of the texture in the matrix's local space.
+ * @param float height of the texture in the matrix's local space.
+ * @param transform_t * pointer to the matrix, e.g. from Stds_GetWorldTransform.
+ * @param SDL_RendererFlip flip status (SDL_FLIP_HORIZONTAL/VERTICAL).
+ * @param bool applies camera offset or not.
+ *
+ * @return void.
+ */
+void
+Stds_DrawTextureTransformed( SDL_Texture *texture, const float w, const float h,
+                             const struct transform_t *m, SDL_RendererFlip flip,
+                             const bool camera_offset ) {
+  float sx = sqrtf( m->a * m->a + m->b * m->b );
+  float sy = sqrtf( m->c * m->c + m->d * m->d );
+
+  if ( sx == 0 || sy == 0 ) {
+    return;
+  }
+
+  if ( m->a * m->d - m->b * m->c < 0 ) {
+    flip = ( SDL_RendererFlip )( flip ^ SDL_FLIP_HORIZONTAL );
+    sx   = -sx;
+  }
+
+  float degrees = Stds_ToDegrees( atan2f( m->b / sx, m->a / sx ) );
+  if ( degrees < 0 ) {
+    degrees += 360.f;
+  }
+
+  const float dw = w * fabsf( sx );
+  const float dh = h * sy;
+  Stds_DrawTexture( texture, m->tx - dw / 2.f, m->ty - dh / 2.f, dw, dh,
+                    ( uint16_t ) ( degrees + 0.5f ) % 360, flip, NULL, camera_offset );
+}
+
 /**
  * Blits (i.e. crops) a section of a texture specified by the src pointer to
  * the SDL_Rect object. This is mainly useful for sprite sheet blits.
@@ -109,6 +225,20 @@ Stds_BlitTexture( SDL_Texture *texture, const SDL_Rect *src, const float x, cons
   dest.w = w;
   dest.h = h;
 
+  if ( !Stds_IsDestVisible( &dest, angle, rotate_point ) ) {
+    return;
+  }
+
+  if ( Stds_IsRecordingCommands() ) {
+    Stds_RecordTexture( STDS_COMMAND_TEXTURE, texture, src, &dest, angle, flip, rotate_point );
+    return;
+  }
+
+  if ( sprite_batch.is_active ) {
+    Stds_BatchQueue( texture, src, &dest, angle, rotate_point, flip, NULL, sprite_batch.layer );
+    return;
+  }
+
   SDL_RenderCopyExF( g_app.renderer, texture, src, &dest, angle, rotate_point, flip );
 }
 
@@ -127,21 +257,26 @@ Stds_BlitTexture( SDL_Texture *texture, const SDL_Rect *src, const float x, cons
 void
 Stds_DrawRect( SDL_Rect *rect, const SDL_Color *c, const bool is_filled,
                const bool camera_offset ) {
-  SDL_SetRenderDrawBlendMode( g_app.renderer, SDL_BLENDMODE_BLEND );
-  SDL_SetRenderDrawColor( g_app.renderer, c->r, c->g, c->b, c->a );
-
   if ( camera_offset ) {
     rect->x -= ( int32_t ) g_app.camera.x;
     rect->y -= ( int32_t ) g_app.camera.y;
   }
 
+  if ( Stds_IsRecordingCommands() ) {
+    SDL_FRect frect
+        = { ( float ) rect->x, ( float ) rect->y, ( float ) rect->w, ( float ) rect->h };
+    Stds_DrawRectF( &frect, c, is_filled, false );
+    return;
+  }
+
+  Stds_SetDrawBlendMode( SDL_BLENDMODE_BLEND );
+  Stds_SetDrawColor( c );
+
   if ( is_filled ) {
     SDL_RenderFillRect( g_app.renderer, rect );
   } else {
     SDL_RenderDrawRect( g_app.renderer, rect );
   }
-
-  SDL_SetRenderDrawBlendMode( g_app.renderer, SDL_BLENDMODE_NONE );
 }
 
 /**
@@ -159,21 +294,27 @@ Stds_DrawRect( SDL_Rect *rect, const SDL_Color *c, const bool is_filled,
 void
 Stds_DrawRectF( SDL_FRect *frect, const SDL_Color *c, const bool is_filled,
                 const bool camera_offset ) {
-  SDL_SetRenderDrawBlendMode( g_app.renderer, SDL_BLENDMODE_BLEND );
-  SDL_SetRenderDrawColor( g_app.renderer, c->r, c->g, c->b, c->a );
-
   if ( camera_offset ) {
     frect->x -= g_app.camera.x;
     frect->y -= g_app.camera.y;
   }
 
+  if ( Stds_IsRecordingCommands() ) {
+    struct render_command_t *cmd = Stds_PushCommand( STDS_COMMAND_RECT );
+    cmd->dst                     = *frect;
+    cmd->color                   = *c;
+    cmd->flags                   = is_filled ? STDS_COMMAND_IS_FILLED : 0;
+    return;
+  }
+
+  Stds_SetDrawBlendMode( SDL_BLENDMODE_BLEND );
+  Stds_SetDrawColor( c );
+
   if ( is_filled ) {
     SDL_RenderFillRectF( g_app.renderer, frect );
   } else {
     SDL_RenderDrawRectF( g_app.renderer, frect );
   }
-
-  SDL_SetRenderDrawBlendMode( g_app.renderer, SDL_BLENDMODE_NONE );
 }
 
 /**
@@ -225,247 +366,1690 @@ Stds_DrawRectStroke( float x, float y, uint32_t w, uint32_t h, const uint32_t st
 }
 
 /**
- * Draws a line with the specified color to the screen.
+ * Draws count axis-aligned quads with as few render calls as possible. When
+ * SDL 2.0.18 or newer is available, the quads are submitted through
+ * SDL_RenderGeometry in batches of STDS_QUAD_BATCH_SIZE; otherwise each quad
+ * falls back to its own SDL_RenderCopyF (or SDL_RenderFillRectF when there
+ * is no texture) with the color applied as a color/alpha mod.
  *
- * @param float x1
- * @param float y1
- * @param float x2
- * @param float y2
- * @param SDL_Color * pointer to color.
+ * Textured quads use the texture's blend mode and untextured quads use the
+ * renderer's draw blend mode, so set whichever applies before calling this.
+ *
+ * @param SDL_Texture * pointer to texture, or NULL for solid quads.
+ * @param SDL_FRect * array of count destination rectangles.
+ * @param SDL_Rect * array of count source rectangles in pixels, or NULL to
+ *        draw the whole texture.
+ * @param SDL_Color * array of count colors, or NULL for opaque white.
+ * @param int32_t number of quads.
+ * @param bool applies the camera offset or not.
  *
  * @return void.
  */
 void
-Stds_DrawLine( const float x1, const float y1, const float x2, const float y2,
-               const SDL_Color *c ) {
-  SDL_SetRenderDrawColor( g_app.renderer, c->r, c->g, c->b, c->a );
-  SDL_RenderDrawLineF( g_app.renderer, x1, y1, x2, y2 );
+Stds_DrawQuads( SDL_Texture *texture, const SDL_FRect *dst, const SDL_Rect *src,
+                const SDL_Color *colors, const int32_t count, const bool camera_offset ) {
+  const SDL_Color white = { 0xff, 0xff, 0xff, 0xff };
+  const float     cx    = camera_offset ? g_app.camera.x : 0;
+  const float     cy    = camera_offset ? g_app.camera.y : 0;
+
+  /* The arrays are copied in order, so replay finds them back to back. */
+  if ( Stds_IsRecordingCommands() ) {
+    struct render_command_t *cmd = Stds_PushCommand( STDS_COMMAND_QUADS );
+    SDL_FRect *copy = Stds_PushCommandPayload( dst, sizeof( SDL_FRect ) * ( size_t ) count,
+                                               &cmd->offset );
+    for ( int32_t i = 0; i < count; i++ ) {
+      copy[i].x -= cx;
+      copy[i].y -= cy;
+    }
+
+    if ( src != NULL ) {
+      Stds_PushCommandPayload( src, sizeof( SDL_Rect ) * ( size_t ) count, NULL );
+      cmd->flags |= STDS_COMMAND_HAS_SRC;
+    }
+
+    if ( colors != NULL ) {
+      Stds_PushCommandPayload( colors, sizeof( SDL_Color ) * ( size_t ) count, NULL );
+      cmd->flags |= STDS_COMMAND_HAS_COLORS;
+    }
+
+    cmd->texture = texture;
+    cmd->count   = count;
+    return;
+  }
+
+#if SDL_VERSION_ATLEAST( 2, 0, 18 )
+  float inv_w = 1.0f;
+  float inv_h = 1.0f;
+
+  if ( texture != NULL && src != NULL ) {
+    int32_t tw, th;
+    SDL_QueryTexture( texture, NULL, NULL, &tw, &th );
+    inv_w = 1.0f / ( float ) tw;
+    inv_h = 1.0f / ( float ) th;
+  }
+
+  Stds_InitQuadIndices();
+
+  for ( int32_t first = 0; first < count; first += STDS_QUAD_BATCH_SIZE ) {
+    int32_t batch = count - first < STDS_QUAD_BATCH_SIZE ? count - first : STDS_QUAD_BATCH_SIZE;
+
+    for ( int32_t q = 0; q < batch; q++ ) {
+      const SDL_FRect *d = &dst[first + q];
+      const SDL_Color  c = colors != NULL ? colors[first + q] : white;
+      SDL_Vertex *     v = &quad_vertices[q * 4];
+
+      float u0 = 0, v0 = 0, u1 = 1, v1 = 1;
+      if ( src != NULL ) {
+        const SDL_Rect *s = &src[first + q];
+        u0                = ( float ) s->x * inv_w;
+        v0                = ( float ) s->y * inv_h;
+        u1                = ( float ) ( s->x + s->w ) * inv_w;
+        v1                = ( float ) ( s->y + s->h ) * inv_h;
+      }
+
+      float x0 = d->x - cx;
+      float y0 = d->y - cy;
+      float x1 = x0 + d->w;
+      float y1 = y0 + d->h;
+
+      v[0] = ( SDL_Vertex ){ { x0, y0 }, c, { u0, v0 } };
+      v[1] = ( SDL_Vertex ){ { x1, y0 }, c, { u1, v0 } };
+      v[2] = ( SDL_Vertex ){ { x1, y1 }, c, { u1, v1 } };
+      v[3] = ( SDL_Vertex ){ { x0, y1 }, c, { u0, v1 } };
+    }
+
+    SDL_RenderGeometry( g_app.renderer, texture, quad_vertices, batch * 4, quad_indices,
+                        batch * 6 );
+  }
+#else
+  for ( int32_t i = 0; i < count; i++ ) {
+    const SDL_Color c = colors != NULL ? colors[i] : white;
+    SDL_FRect       d = { dst[i].x - cx, dst[i].y - cy, dst[i].w, dst[i].h };
+
+    if ( texture != NULL ) {
+      Stds_SetTextureColorMod( texture, c.r, c.g, c.b );
+      Stds_SetTextureAlphaMod( texture, c.a );
+      SDL_RenderCopyF( g_app.renderer, texture, src != NULL ? &src[i] : NULL, &d );
+    } else {
+      Stds_SetDrawColor( &c );
+      SDL_RenderFillRectF( g_app.renderer, &d );
+    }
+  }
+
+  if ( texture != NULL ) {
+    Stds_SetTextureColorMod( texture, 0xff, 0xff, 0xff );
+    Stds_SetTextureAlphaMod( texture, 0xff );
+  }
+#endif
 }
 
 /**
- * Draws a circle. Simple as that. Takes in the circle's center coordinates,
- * the radius, and RGBA.
+ * Starts collecting a sprite batch. Until Stds_BatchEnd, Stds_DrawTexture and
+ * Stds_BlitTexture (and so animations, trails, grids and backgrounds) queue
+ * their sprites instead of drawing, tagged with the layer from
+ * Stds_BatchSetLayer, the depth from Stds_BatchSetDepth and the texture's
+ * current color and alpha mods. Primitives are not batched and still draw
+ * immediately.
  *
- * @param struct circle_t * pointer to circle
- * @param SDL_Color *c color to draw.
+ * @param void.
  *
  * @return void.
  */
 void
-Stds_DrawCircle( const struct circle_t *circle, const SDL_Color *color, const bool is_filled ) {
-  if ( is_filled ) {
-    Stds_FillCircleHelper( circle, color );
-  } else {
-    Stds_DrawCircleHelper( circle, color );
+Stds_BatchBegin( void ) {
+  if ( Stds_IsRecordingCommands() ) {
+    Stds_PushCommand( STDS_COMMAND_BATCH_BEGIN );
+    return;
   }
+
+  sprite_batch.count     = 0;
+  sprite_batch.layer     = 0;
+  sprite_batch.depth     = 0;
+  sprite_batch.is_active = true;
 }
 
 /**
- * Completes one iteration of the color-merge procedure.
- * The speed is dependent on the fade_color_t struct passed.
+ * Sets the layer for sprites queued by Stds_DrawTexture and Stds_BlitTexture.
+ * Lower layers are drawn first.
  *
- * @param fade_color_t pointer to color for transition.
+ * @param int32_t layer.
  *
- * @return SDL_Color copy of the new color struct.
+ * @return void.
  */
-SDL_Color
-Stds_CombineFadeColor( struct fade_color_t *f ) {
-  if ( f->time <= 1.0f && f->is_first_color ) {
-    f->time = ( float ) ( f->time + f->alpha );
-  } else {
-    f->is_first_color = false;
+void
+Stds_BatchSetLayer( const int32_t layer ) {
+  if ( Stds_IsRecordingCommands() ) {
+    Stds_PushCommand( STDS_COMMAND_BATCH_LAYER )->layer = layer;
+    return;
   }
 
-  if ( f->time >= 0.0f && !f->is_first_color ) {
-    f->time = ( float ) ( f->time - f->alpha );
-  } else {
-    f->is_first_color = true;
+  sprite_batch.layer = layer;
+}
+
+/**
+ * Sets the depth for sprites queued by Stds_DrawTexture and Stds_BlitTexture.
+ * Within a layer, lower depths are drawn first, so e.g. passing the bottom y
+ * coordinate gives top-down scenes their overlap. Stds_BatchBegin resets it
+ * to 0.
+ *
+ * @param uint16_t depth.
+ *
+ * @return void.
+ */
+void
+Stds_BatchSetDepth( const uint16_t depth ) {
+  if ( Stds_IsRecordingCommands() ) {
+    Stds_PushCommand( STDS_COMMAND_BATCH_DEPTH )->layer = depth;
+    return;
   }
 
-  int32_t r = ( int32_t )( f->time * f->c2.r + ( 1.0f - f->time ) * f->c1.r );
-  int32_t g = ( int32_t )( f->time * f->c2.g + ( 1.0f - f->time ) * f->c1.g );
-  int32_t b = ( int32_t )( f->time * f->c2.b + ( 1.0f - f->time ) * f->c1.b );
+  sprite_batch.depth = depth;
+}
 
-  Stds_ClampInt( &r, 0, 0xff );
-  Stds_ClampInt( &g, 0, 0xff );
-  Stds_ClampInt( &b, 0, 0xff );
+/**
+ * Builds the sort key that orders batched draws. From the most significant
+ * bits down it holds the layer (16 bits), the depth (16), the blend mode (4)
+ * and a hash of the texture (28), so sorting keeps layering intact and then
+ * groups draws that share render state. Equal keys keep their push order.
+ *
+ * @param int32_t layer, clamped to the int16_t range.
+ * @param uint16_t depth within the layer.
+ * @param SDL_BlendMode blend mode of the draw.
+ * @param SDL_Texture * texture, or NULL for primitives.
+ *
+ * @return uint64_t sort key.
+ */
+uint64_t
+Stds_MakeSortKey( int32_t layer, const uint16_t depth, const SDL_BlendMode blend,
+                  const SDL_Texture *texture ) {
+  uint64_t p = ( uint64_t ) ( uintptr_t ) texture;
 
-  SDL_Color c = { r, g, b, 0xff };
+  Stds_ClampInt( &layer, INT16_MIN, INT16_MAX );
 
-  return c;
+  /* Custom blend modes are large values; they all share the last slot. */
+  uint64_t mode = ( uint32_t ) blend < 0xf ? ( uint32_t ) blend : 0xf;
+  uint64_t hash = ( uint64_t ) ( ( p >> 4 ) ^ ( p >> 32 ) ) & 0x0fffffff;
+
+  return ( uint64_t ) ( layer + 0x8000 ) << 48 | ( uint64_t ) depth << 32 | mode << 28 | hash;
 }
 
 /**
- * Loads an image from the specified path. An error is
- * displayed if the file cannot be found or is not
- * loadable.
+ * Returns the color and alpha mods and the blend mode the render state cache
+ * holds for a texture, with white and alpha blending for whatever it does not
+ * know.
  *
- * @param
+ * @param SDL_Texture * texture.
+ * @param SDL_Color * receives the color and alpha mods.
+ * @param SDL_BlendMode * receives the blend mode, or NULL.
  *
- * @return SDL_Texture * pointer to the texture loaded from the buffer.
+ * @return void.
  */
-SDL_Texture *
-Stds_LoadTexture( const char *fileName ) {
-  SDL_Texture *texture;
-
-  texture = Stds_GetTexture( fileName );
+void
+Stds_GetTextureMods( SDL_Texture *texture, SDL_Color *mod, SDL_BlendMode *blend ) {
+  const struct texture_state_t *ts = Stds_GetTextureState( texture );
+  *mod                             = ( SDL_Color ){ 0xff, 0xff, 0xff, 0xff };
 
-  if ( texture == NULL ) {
-    texture = IMG_LoadTexture( g_app.renderer, fileName );
-    if ( texture == NULL ) {
-      SDL_LogInfo( SDL_LOG_CATEGORY_APPLICATION, "Error: %s", SDL_GetError() );
-      exit( EXIT_FAILURE );
-    }
+  if ( ts->known & STDS_TEXTURE_KNOWN_COLOR ) {
+    mod->r = ts->mod.r;
+    mod->g = ts->mod.g;
+    mod->b = ts->mod.b;
+  }
 
-    Stds_CacheTexture( fileName, texture );
+  if ( ts->known & STDS_TEXTURE_KNOWN_ALPHA ) {
+    mod->a = ts->mod.a;
   }
 
-  return texture;
+  if ( blend != NULL ) {
+    *blend = ts->known & STDS_TEXTURE_KNOWN_BLEND ? ts->blend_mode : SDL_BLENDMODE_BLEND;
+  }
 }
 
 /**
- * Searches through the SDL_Texture list to see if we have previously
- * loaded in this texture. If so, it is returned. Otherwise, NULL.
+ * Queues one sprite. Outside of a batch, it is drawn right away.
+ *
+ * @param SDL_Texture * texture.
+ * @param SDL_Rect * source rectangle in pixels, or NULL for the whole texture.
+ * @param SDL_FRect * destination rectangle in screen coordinates.
+ * @param float rotation in degrees, clockwise.
+ * @param SDL_FPoint * rotation point relative to dst, or NULL for its center.
+ * @param SDL_RendererFlip flip (SDL_FLIP_NONE/HORIZONTAL/VERTICAL).
+ * @param SDL_Color * color and alpha to modulate with, or NULL for white.
+ * @param int32_t layer; lower layers are drawn first.
  *
- * @param file name of SDL_Texture.
- * @return SDL_Texture pointer - either NULL or object.
+ * @return void.
  */
-static SDL_Texture *
-Stds_GetTexture( const char *file_name ) {
-  struct texture_t *t;
+void
+Stds_BatchPush( SDL_Texture *texture, const SDL_Rect *src, const SDL_FRect *dst,
+                const float angle, const SDL_FPoint *center, const SDL_RendererFlip flip,
+                const SDL_Color *color, const int32_t layer ) {
+  const SDL_Color white = { 0xff, 0xff, 0xff, 0xff };
 
-  for ( t = g_app.texture_head.next; t != NULL; t = t->next ) {
-    if ( strcmp( t->name, file_name ) == 0 ) {
-      return t->texture;
-    }
+  if ( Stds_IsRecordingCommands() ) {
+    struct render_command_t *cmd
+        = Stds_RecordTexture( STDS_COMMAND_SPRITE, texture, src, dst, angle, flip, center );
+    cmd->color = color != NULL ? *color : white;
+    cmd->layer = layer;
+    return;
   }
 
-  return NULL;
+  Stds_BatchQueue( texture, src, dst, angle, center, flip, color != NULL ? color : &white, layer );
+
+  if ( !sprite_batch.is_active ) {
+    Stds_FlushSprites( sprite_batch.sprites, 1 );
+    sprite_batch.count = 0;
+  }
 }
 
 /**
- * If a SDL_Texture has not been previously loaded in, we add it to
- * the cache here. The cache is a linked-list of SDL_Texture pointers
- * that store references to each texture so we do not waste resources
- * opening the input stream and loading the data back in.
+ * Sorts the queued sprites by their keys (layer, depth, blend mode, texture),
+ * keeping push order among equal keys, and draws every run of one texture
+ * with a single SDL_RenderGeometry call (SDL 2.0.18+). Sprites of different
+ * textures at the same layer and depth therefore do not keep their relative
+ * order; give sprites that must overlap in a set order different layers or
+ * depths.
  *
- * @param const char* name
- * @param SDL_Texture * pointer to the texture.
+ * @param void.
  *
  * @return void.
  */
-static void
-Stds_CacheTexture( const char *file_name, SDL_Texture *sdl_texture ) {
-  struct texture_t *texture;
-  texture = malloc( sizeof( struct texture_t ) );
-
-  if ( texture == NULL ) {
-    SDL_LogInfo( SDL_LOG_CATEGORY_APPLICATION, "Could not allocate memory for texture_t. %s.\n",
-                 SDL_GetError() );
-    exit( EXIT_FAILURE );
+void
+Stds_BatchEnd( void ) {
+  if ( Stds_IsRecordingCommands() ) {
+    Stds_PushCommand( STDS_COMMAND_BATCH_END );
+    return;
   }
 
-  memset( texture, 0, sizeof( struct texture_t ) );
-  g_app.texture_tail->next = texture;
-  g_app.texture_tail       = texture;
+  sprite_batch.is_active = false;
 
-  strncpy( texture->name, file_name, MAX_FILE_NAME_LEN );
-  texture->texture = sdl_texture;
+  if ( sprite_batch.count == 0 ) {
+    return;
+  }
+
+  Stds_SortSprites();
+  Stds_FlushSprites( sprite_batch.sorted, sprite_batch.count );
+  sprite_batch.count = 0;
 }
 
 /**
- * Draws a circle outline with the specified color. This function
- * actually describes the algorithm.
+ * Draws a line with the specified color to the screen.
  *
- * @param circle_t * pointer to circle structure.
+ * @param float x1
+ * @param float y1
+ * @param float x2
+ * @param float y2
  * @param SDL_Color * pointer to color.
  *
  * @return void.
  */
-static void
-Stds_DrawCircleHelper( const struct circle_t *circle, const SDL_Color *c ) {
-  const float diameter = ( circle->radius * 2 );
-
-  float x     = ( circle->radius - 1 );
-  float y     = 0;
-  float tx    = 1;
-  float ty    = 1;
-  float error = ( tx - diameter );
-
-  SDL_SetRenderDrawColor( g_app.renderer, c->r, c->g, c->b, c->a );
-  while ( x >= y ) {
-    //  Each of the following renders an octant of the circle
-    SDL_RenderDrawPointF( g_app.renderer, circle->center_x + x, circle->center_y - y );
-    SDL_RenderDrawPointF( g_app.renderer, circle->center_x + x, circle->center_y + y );
-    SDL_RenderDrawPointF( g_app.renderer, circle->center_x - x, circle->center_y - y );
-    SDL_RenderDrawPointF( g_app.renderer, circle->center_x - x, circle->center_y + y );
-    SDL_RenderDrawPointF( g_app.renderer, circle->center_x + y, circle->center_y - x );
-    SDL_RenderDrawPointF( g_app.renderer, circle->center_x + y, circle->center_y + x );
-    SDL_RenderDrawPointF( g_app.renderer, circle->center_x - y, circle->center_y - x );
-    SDL_RenderDrawPointF( g_app.renderer, circle->center_x - y, circle->center_y + x );
+void
+Stds_DrawLine( const float x1, const float y1, const float x2, const float y2,
+               const SDL_Color *c ) {
+  if ( Stds_IsRecordingCommands() ) {
+    struct render_command_t *cmd = Stds_PushCommand( STDS_COMMAND_LINE );
+    cmd->dst                     = ( SDL_FRect ){ x1, y1, x2, y2 };
+    cmd->color                   = *c;
+    return;
+  }
 
-    if ( error <= 0 ) {
-      ++y;
-      error += ty;
-      ty += 2;
-    }
+  Stds_SetDrawBlendMode( SDL_BLENDMODE_BLEND );
+  Stds_SetDrawColor( c );
+  SDL_RenderDrawLineF( g_app.renderer, x1, y1, x2, y2 );
+}
 
-    if ( error > 0 ) {
-      --x;
-      tx += 2;
-      error += ( tx - diameter );
-    }
+/**
+ * Draws a connected run of line segments through count points with one
+ * render call.
+ *
+ * @param SDL_FPoint * array of count points.
+ * @param int32_t number of points.
+ * @param SDL_Color * pointer to color.
+ *
+ * @return void.
+ */
+void
+Stds_DrawLines( const SDL_FPoint *points, const int32_t count, const SDL_Color *c ) {
+  if ( Stds_IsRecordingCommands() ) {
+    struct render_command_t *cmd = Stds_PushCommand( STDS_COMMAND_LINES );
+    Stds_PushCommandPayload( points, sizeof( SDL_FPoint ) * ( size_t ) count, &cmd->offset );
+    cmd->color = *c;
+    cmd->count = count;
+    return;
   }
+
+  Stds_SetDrawBlendMode( SDL_BLENDMODE_BLEND );
+  Stds_SetDrawColor( c );
+  SDL_RenderDrawLinesF( g_app.renderer, points, count );
 }
 
 /**
- * Fills a circle with the specified color. This function actually
- * describes the algorithm.
+ * Draws count rectangles of one color with one render call per
+ * STDS_QUAD_BATCH_SIZE of them. Unlike Stds_DrawRectF, the rectangles are
+ * not modified by the camera offset.
  *
- * @param circle_t * pointer to circle structure.
+ * @param SDL_FRect * array of count rectangles.
+ * @param int32_t number of rectangles.
  * @param SDL_Color * pointer to color.
+ * @param bool are the rects filled or not.
+ * @param bool applies the camera offset or not.
  *
  * @return void.
  */
-static void
-Stds_FillCircleHelper( const struct circle_t *circle, const SDL_Color *c ) {
-  float   offsetx, offsety, d;
-  int32_t status;
+void
+Stds_DrawRects( const SDL_FRect *rects, const int32_t count, const SDL_Color *c,
+                const bool is_filled, const bool camera_offset ) {
+  const float cx = camera_offset ? g_app.camera.x : 0;
+  const float cy = camera_offset ? g_app.camera.y : 0;
 
-  offsetx = 0;
-  offsety = circle->radius;
-  d       = circle->radius - 1;
-  status  = 0;
-  SDL_SetRenderDrawColor( g_app.renderer, c->r, c->g, c->b, c->a );
+  if ( Stds_IsRecordingCommands() ) {
+    struct render_command_t *cmd = Stds_PushCommand( STDS_COMMAND_RECTS );
+    SDL_FRect *copy = Stds_PushCommandPayload( rects, sizeof( SDL_FRect ) * ( size_t ) count,
+                                               &cmd->offset );
+    for ( int32_t i = 0; i < count; i++ ) {
+      copy[i].x -= cx;
+      copy[i].y -= cy;
+    }
 
-  while ( offsety >= offsetx ) {
-    float x = circle->center_x;
-    float y = circle->center_y;
+    cmd->color = *c;
+    cmd->count = count;
+    cmd->flags = is_filled ? STDS_COMMAND_IS_FILLED : 0;
+    return;
+  }
 
-    status +=
-        SDL_RenderDrawLineF( g_app.renderer, x - offsety, y + offsetx, x + offsety, y + offsetx );
-    status +=
-        SDL_RenderDrawLineF( g_app.renderer, x - offsetx, y + offsety, x + offsetx, y + offsety );
-    status +=
-        SDL_RenderDrawLineF( g_app.renderer, x - offsetx, y - offsety, x + offsetx, y - offsety );
-    status +=
-        SDL_RenderDrawLineF( g_app.renderer, x - offsety, y - offsetx, x + offsety, y - offsetx );
+  Stds_SetDrawBlendMode( SDL_BLENDMODE_BLEND );
+  Stds_SetDrawColor( c );
 
-    if ( status < 0 ) {
-      status = -1;
-      break;
+  for ( int32_t first = 0; first < count; first += STDS_QUAD_BATCH_SIZE ) {
+    int32_t          batch = count - first < STDS_QUAD_BATCH_SIZE ? count - first
+                                                                   : STDS_QUAD_BATCH_SIZE;
+    const SDL_FRect *r     = &rects[first];
+
+    if ( camera_offset ) {
+      for ( int32_t i = 0; i < batch; i++ ) {
+        shape_rects[i] = ( SDL_FRect ){ r[i].x - cx, r[i].y - cy, r[i].w, r[i].h };
+      }
+      r = shape_rects;
     }
 
-    if ( d >= 2 * offsetx ) {
-      d -= 2 * offsetx + 1;
-      offsetx += 1;
-    } else if ( d < 2 * ( circle->radius - offsety ) ) {
-      d += 2 * offsety - 1;
-      offsety -= 1;
+    if ( is_filled ) {
+      SDL_RenderFillRectsF( g_app.renderer, r, batch );
     } else {
-      d += 2 * ( offsety - offsetx - 1 );
-      offsety -= 1;
-      offsetx += 1;
+      SDL_RenderDrawRectsF( g_app.renderer, r, batch );
     }
   }
-}
\ No newline at end of file
+}
+
+/**
+ * Draws a circle. Simple as that. Takes in the circle's center coordinates,
+ * the radius, and RGBA.
+ *
+ * @param struct circle_t * pointer to circle
+ * @param SDL_Color *c color to draw.
+ *
+ * @return void.
+ */
+void
+Stds_DrawCircle( const struct circle_t *circle, const SDL_Color *color, const bool is_filled ) {
+  if ( Stds_IsRecordingCommands() ) {
+    struct render_command_t *cmd = Stds_PushCommand( STDS_COMMAND_CIRCLE );
+    cmd->dst   = ( SDL_FRect ){ circle->center_x, circle->center_y, circle->radius, 0 };
+    cmd->color = *color;
+    cmd->flags = is_filled ? STDS_COMMAND_IS_FILLED : 0;
+    return;
+  }
+
+  Stds_DrawCircles( circle, color, 1, is_filled );
+}
+
+/**
+ * Draws count circles, filled or as one-pixel outlines. When SDL 2.0.18 or
+ * newer is available, each circle is placed from the cached mesh of its
+ * radius bucket and they all go out through one SDL_RenderGeometry call per
+ * STDS_QUAD_BATCH_SIZE * 4 vertices; otherwise each is rasterized with
+ * points or lines as before.
+ *
+ * @param circle_t * array of count circles.
+ * @param SDL_Color * array of count colors, or NULL for opaque white.
+ * @param int32_t number of circles.
+ * @param bool are the circles filled or not.
+ *
+ * @return void.
+ */
+void
+Stds_DrawCircles( const struct circle_t *circles, const SDL_Color *colors, const int32_t count,
+                  const bool is_filled ) {
+  const SDL_Color white = { 0xff, 0xff, 0xff, 0xff };
+
+  if ( Stds_IsRecordingCommands() ) {
+    struct render_command_t *cmd = Stds_PushCommand( STDS_COMMAND_CIRCLES );
+    Stds_PushCommandPayload( circles, sizeof( struct circle_t ) * ( size_t ) count,
+                             &cmd->offset );
+
+    if ( colors != NULL ) {
+      Stds_PushCommandPayload( colors, sizeof( SDL_Color ) * ( size_t ) count, NULL );
+      cmd->flags |= STDS_COMMAND_HAS_COLORS;
+    }
+
+    cmd->flags |= is_filled ? STDS_COMMAND_IS_FILLED : 0;
+    cmd->count = count;
+    return;
+  }
+
+#if SDL_VERSION_ATLEAST( 2, 0, 18 )
+  int32_t vertices = 0;
+  int32_t indices  = 0;
+
+  Stds_InitShapeCache();
+  Stds_SetDrawBlendMode( SDL_BLENDMODE_BLEND );
+
+  for ( int32_t i = 0; i < count; i++ ) {
+    const struct circle_t *circle = &circles[i];
+    const SDL_Color        c      = colors != NULL ? colors[i] : white;
+    int32_t                b      = 0;
+
+    while ( b < STDS_CIRCLE_BUCKETS - 1 && circle->radius > shape_cache.max_radius[b] ) {
+      b++;
+    }
+
+    const int32_t  n      = 8 << b;
+    const int32_t  stride = STDS_CIRCLE_MAX_SEGMENTS / n;
+    const int32_t  nv     = is_filled ? n + 1 : n * 2;
+    const int32_t  ni     = is_filled ? n * 3 : n * 6;
+    const int32_t *mesh   = is_filled ? shape_cache.fan[b] : shape_cache.ring[b];
+
+    if ( vertices + nv > STDS_QUAD_BATCH_SIZE * 4 || indices + ni > STDS_QUAD_BATCH_SIZE * 6 ) {
+      SDL_RenderGeometry( g_app.renderer, NULL, quad_vertices, vertices, shape_indices, indices );
+      vertices = 0;
+      indices  = 0;
+    }
+
+    SDL_Vertex *v     = &quad_vertices[vertices];
+    const float outer = circle->radius;
+    const float inner = circle->radius > 1 ? circle->radius - 1 : 0;
+
+    if ( is_filled ) {
+      v[0] = ( SDL_Vertex ){ { circle->center_x, circle->center_y }, c, { 0, 0 } };
+    }
+
+    for ( int32_t k = 0; k < n; k++ ) {
+      const SDL_FPoint *p = &shape_cache.rim[k * stride];
+
+      if ( is_filled ) {
+        v[1 + k] = ( SDL_Vertex ){
+            { circle->center_x + p->x * outer, circle->center_y + p->y * outer }, c, { 0, 0 } };
+      } else {
+        v[k * 2] = ( SDL_Vertex ){
+            { circle->center_x + p->x * outer, circle->center_y + p->y * outer }, c, { 0, 0 } };
+        v[k * 2 + 1] = ( SDL_Vertex ){
+            { circle->center_x + p->x * inner, circle->center_y + p->y * inner }, c, { 0, 0 } };
+      }
+    }
+
+    for ( int32_t k = 0; k < ni; k++ ) {
+      shape_indices[indices + k] = mesh[k] + vertices;
+    }
+
+    vertices += nv;
+    indices += ni;
+  }
+
+  if ( vertices > 0 ) {
+    SDL_RenderGeometry( g_app.renderer, NULL, quad_vertices, vertices, shape_indices, indices );
+  }
+#else
+  for ( int32_t i = 0; i < count; i++ ) {
+    const SDL_Color c = colors != NULL ? colors[i] : white;
+
+    if ( is_filled ) {
+      Stds_FillCircleHelper( &circles[i], &c );
+    } else {
+      Stds_DrawCircleHelper( &circles[i], &c );
+    }
+  }
+#endif
+}
+
+/**
+ * Sets the renderer's draw color, skipping the SDL call if it is unchanged.
+ *
+ * @param SDL_Color * pointer to color.
+ *
+ * @return void.
+ */
+void
+Stds_SetDrawColor( const SDL_Color *c ) {
+  if ( Stds_IsRecordingCommands() ) {
+    Stds_PushCommand( STDS_COMMAND_DRAW_COLOR )->color = *c;
+    return;
+  }
+
+  SDL_Color *cur = &render_state.draw_color;
+
+  if ( render_state.is_valid && cur->r == c->r && cur->g == c->g && cur->b == c->b &&
+       cur->a == c->a ) {
+    return;
+  }
+
+  SDL_SetRenderDrawColor( g_app.renderer, c->r, c->g, c->b, c->a );
+  *cur = *c;
+
+  if ( !render_state.is_valid ) {
+    SDL_SetRenderDrawBlendMode( g_app.renderer, render_state.draw_blend_mode );
+    render_state.is_valid = true;
+  }
+}
+
+/**
+ * Sets the renderer's draw blend mode, skipping the SDL call if it is
+ * unchanged.
+ *
+ * @param SDL_BlendMode blend mode for primitives.
+ *
+ * @return void.
+ */
+void
+Stds_SetDrawBlendMode( const SDL_BlendMode mode ) {
+  if ( Stds_IsRecordingCommands() ) {
+    Stds_PushCommand( STDS_COMMAND_DRAW_BLEND )->blend_mode = mode;
+    return;
+  }
+
+  if ( render_state.is_valid && render_state.draw_blend_mode == mode ) {
+    return;
+  }
+
+  SDL_SetRenderDrawBlendMode( g_app.renderer, mode );
+  render_state.draw_blend_mode = mode;
+
+  if ( !render_state.is_valid ) {
+    SDL_Color *c = &render_state.draw_color;
+    SDL_SetRenderDrawColor( g_app.renderer, c->r, c->g, c->b, c->a );
+    render_state.is_valid = true;
+  }
+}
+
+/**
+ * Sets a texture's blend mode, skipping the SDL call if the cache knows it
+ * is already set.
+ *
+ * @param SDL_Texture * texture.
+ * @param SDL_BlendMode blend mode.
+ *
+ * @return void.
+ */
+void
+Stds_SetTextureBlendMode( SDL_Texture *texture, const SDL_BlendMode mode ) {
+  if ( Stds_IsRecordingCommands() ) {
+    struct render_command_t *cmd = Stds_PushCommand( STDS_COMMAND_TEXTURE_BLEND );
+    cmd->texture                 = texture;
+    cmd->blend_mode              = mode;
+    return;
+  }
+
+  struct texture_state_t *ts = Stds_GetTextureState( texture );
+
+  if ( ( ts->known & STDS_TEXTURE_KNOWN_BLEND ) && ts->blend_mode == mode ) {
+    return;
+  }
+
+  SDL_SetTextureBlendMode( texture, mode );
+  ts->blend_mode = mode;
+  ts->known |= STDS_TEXTURE_KNOWN_BLEND;
+}
+
+/**
+ * Sets a texture's color mod, skipping the SDL call if the cache knows it
+ * is already set.
+ *
+ * @param SDL_Texture * texture.
+ * @param uint8_t red.
+ * @param uint8_t green.
+ * @param uint8_t blue.
+ *
+ * @return void.
+ */
+void
+Stds_SetTextureColorMod( SDL_Texture *texture, const uint8_t r, const uint8_t g,
+                         const uint8_t b ) {
+  if ( Stds_IsRecordingCommands() ) {
+    struct render_command_t *cmd = Stds_PushCommand( STDS_COMMAND_TEXTURE_COLOR );
+    cmd->texture                 = texture;
+    cmd->color                   = ( SDL_Color ){ r, g, b, 0xff };
+    return;
+  }
+
+  struct texture_state_t *ts = Stds_GetTextureState( texture );
+
+  if ( ( ts->known & STDS_TEXTURE_KNOWN_COLOR ) && ts->mod.r == r && ts->mod.g == g &&
+       ts->mod.b == b ) {
+    return;
+  }
+
+  SDL_SetTextureColorMod( texture, r, g, b );
+  ts->mod.r = r;
+  ts->mod.g = g;
+  ts->mod.b = b;
+  ts->known |= STDS_TEXTURE_KNOWN_COLOR;
+}
+
+/**
+ * Sets a texture's alpha mod, skipping the SDL call if the cache knows it
+ * is already set.
+ *
+ * @param SDL_Texture * texture.
+ * @param uint8_t alpha.
+ *
+ * @return void.
+ */
+void
+Stds_SetTextureAlphaMod( SDL_Texture *texture, const uint8_t a ) {
+  if ( Stds_IsRecordingCommands() ) {
+    struct render_command_t *cmd = Stds_PushCommand( STDS_COMMAND_TEXTURE_ALPHA );
+    cmd->texture                 = texture;
+    cmd->color.a                 = a;
+    return;
+  }
+
+  struct texture_state_t *ts = Stds_GetTextureState( texture );
+
+  if ( ( ts->known & STDS_TEXTURE_KNOWN_ALPHA ) && ts->mod.a == a ) {
+    return;
+  }
+
+  SDL_SetTextureAlphaMod( texture, a );
+  ts->mod.a = a;
+  ts->known |= STDS_TEXTURE_KNOWN_ALPHA;
+}
+
+/**
+ * Drops the cached state of a texture. Call this before destroying a texture,
+ * so a new texture created at the same address does not inherit it.
+ *
+ * @param SDL_Texture * texture.
+ *
+ * @return void.
+ */
+void
+Stds_ForgetTextureState( SDL_Texture *texture ) {
+  struct texture_state_t *ts = Stds_GetTextureState( texture );
+  ts->known                  = 0;
+}
+
+/**
+ * Forgets all cached render state. Call this after changing renderer or
+ * texture state with SDL directly, or after recreating the renderer.
+ *
+ * @param void.
+ *
+ * @return void.
+ */
+void
+Stds_InvalidateRenderState( void ) {
+  memset( &render_state, 0, sizeof( struct render_state_t ) );
+}
+
+/**
+ * Completes one iteration of the color-merge procedure.
+ * The speed is dependent on the fade_color_t struct passed.
+ *
+ * @param fade_color_t pointer to color for transition.
+ *
+ * @return SDL_Color copy of the new color struct.
+ */
+SDL_Color
+Stds_CombineFadeColor( struct fade_color_t *f ) {
+  if ( f->time <= 1.0f && f->is_first_color ) {
+    f->time = ( float ) ( f->time + f->alpha );
+  } else {
+    f->is_first_color = false;
+  }
+
+  if ( f->time >= 0.0f && !f->is_first_color ) {
+    f->time = ( float ) ( f->time - f->alpha );
+  } else {
+    f->is_first_color = true;
+  }
+
+  int32_t r = ( int32_t )( f->time * f->c2.r + ( 1.0f - f->time ) * f->c1.r );
+  int32_t g = ( int32_t )( f->time * f->c2.g + ( 1.0f - f->time ) * f->c1.g );
+  int32_t b = ( int32_t )( f->time * f->c2.b + ( 1.0f - f->time ) * f->c1.b );
+
+  Stds_ClampInt( &r, 0, 0xff );
+  Stds_ClampInt( &g, 0, 0xff );
+  Stds_ClampInt( &b, 0, 0xff );
+
+  SDL_Color c = { r, g, b, 0xff };
+
+  return c;
+}
+
+/**
+ * Loads an image from the specified path. An error is
+ * displayed if the file cannot be found or is not
+ * loadable. Previously loaded files are returned from
+ * the texture cache. Files in a mounted pack are read
+ * from the pack instead of the filesystem.
+ *
+ * Each call takes a reference that keeps the texture from
+ * being evicted, so the pointer stays valid until it is
+ * given back with Stds_ReleaseTexture. Never destroy it.
+ *
+ * @param const char * path to image.
+ *
+ * @return SDL_Texture * pointer to the texture loaded from the buffer.
+ */
+SDL_Texture *
+Stds_LoadTexture( const char *file_name ) {
+  int32_t handle = Stds_TextureHandle( file_name );
+
+  g_app.textures[handle].refs++;
+  return Stds_ResidentTexture( handle );
+}
+
+/**
+ * Loads an image like Stds_LoadTexture, but returns its handle in the
+ * texture cache. Resolving a handle with Stds_TextureFromHandle is a
+ * single array access, so code that draws the same texture every frame
+ * can hash the path once and keep the handle. Handles stay valid until
+ * the application closes, and take no reference: the texture may be
+ * evicted when it goes undrawn, so resolve the handle every frame rather
+ * than keeping the pointer.
+ *
+ * @param const char * path to image.
+ *
+ * @return int32_t handle of the texture.
+ */
+int32_t
+Stds_TextureHandle( const char *file_name ) {
+  uint32_t hash   = Stds_HashString( file_name );
+  int32_t  handle = Stds_GetTexture( file_name, hash );
+
+  if ( handle == -1 ) {
+    handle = Stds_CacheTexture( file_name, hash, Stds_ReadTexture( file_name, true ) );
+  }
+
+  return handle;
+}
+
+/**
+ * Uploads an already decoded image as a texture and adds it to the texture
+ * cache under file_name, so later Stds_LoadTexture calls for the same path
+ * are cache hits. If the path is already cached, the surface is ignored.
+ * The caller keeps ownership of the surface.
+ *
+ * @param const char * path the image was decoded from.
+ * @param SDL_Surface * decoded image.
+ *
+ * @return int32_t handle of the texture, or -1 if the upload failed.
+ */
+int32_t
+Stds_TextureHandleFromSurface( const char *file_name, SDL_Surface *surface ) {
+  uint32_t hash   = Stds_HashString( file_name );
+  int32_t  handle = Stds_GetTexture( file_name, hash );
+
+  if ( handle == -1 || g_app.textures[handle].texture == NULL ) {
+    SDL_Texture *texture = SDL_CreateTextureFromSurface( g_app.renderer, surface );
+    if ( texture == NULL ) {
+      SDL_LogInfo( SDL_LOG_CATEGORY_APPLICATION, "Could not upload %s. %s.\n", file_name,
+                   SDL_GetError() );
+      return -1;
+    }
+
+    if ( handle == -1 ) {
+      handle = Stds_CacheTexture( file_name, hash, texture );
+    } else {
+      struct texture_t *t = &g_app.textures[handle];
+      t->texture          = texture;
+      t->bytes            = Stds_TextureBytes( texture );
+      t->last_used        = g_app.texture_frame;
+      g_app.texture_bytes += t->bytes;
+      Stds_MapTextureHandle( handle );
+    }
+  }
+
+  return handle;
+}
+
+/**
+ * Returns the texture referred to by a handle from Stds_TextureHandle.
+ *
+ * @param int32_t handle of the texture.
+ *
+ * @return SDL_Texture * pointer to the texture, or NULL if the handle is invalid.
+ */
+SDL_Texture *
+Stds_TextureFromHandle( const int32_t handle ) {
+  if ( handle < 0 || handle >= g_app.texture_count ) {
+    return NULL;
+  }
+
+  return Stds_ResidentTexture( handle );
+}
+
+/**
+ * Gives back a reference taken by Stds_LoadTexture. A texture without
+ * references stays cached, and is destroyed only when the cache is over
+ * its memory budget and the texture has gone undrawn. Textures that did
+ * not come from the cache are destroyed right away.
+ *
+ * @param SDL_Texture * texture from Stds_LoadTexture.
+ *
+ * @return void.
+ */
+void
+Stds_ReleaseTexture( SDL_Texture *texture ) {
+  if ( texture == NULL ) {
+    return;
+  }
+
+  const int32_t handle = Stds_FindTextureHandle( texture );
+
+  if ( handle != -1 ) {
+    Stds_ReleaseTextureHandle( handle );
+    return;
+  }
+
+  Stds_ForgetTextureState( texture );
+  SDL_DestroyTexture( texture );
+}
+
+/**
+ * Returns the handle of a texture that is resident in the texture cache.
+ *
+ * @param SDL_Texture * texture, e.g. from Stds_LoadTexture.
+ *
+ * @return int32_t handle of the texture, or -1 if the cache does not own it.
+ */
+int32_t
+Stds_FindTextureHandle( SDL_Texture *texture ) {
+  const int32_t *handle = g_app.texture_handles != NULL && texture != NULL
+                            ? Stds_HashMapGetInt( g_app.texture_handles, ( uintptr_t ) texture )
+                            : NULL;
+
+  return handle != NULL ? *handle : -1;
+}
+
+/**
+ * Takes a reference to a cached texture by handle, like Stds_LoadTexture,
+ * so it cannot be evicted. An evicted texture is read back in first.
+ *
+ * @param int32_t handle of the texture.
+ *
+ * @return void.
+ */
+void
+Stds_RetainTextureHandle( const int32_t handle ) {
+  if ( handle < 0 || handle >= g_app.texture_count ) {
+    return;
+  }
+
+  g_app.textures[handle].refs++;
+  Stds_ResidentTexture( handle );
+}
+
+/**
+ * Gives back a reference taken by Stds_RetainTextureHandle. See
+ * Stds_ReleaseTexture.
+ *
+ * @param int32_t handle of the texture.
+ *
+ * @return void.
+ */
+void
+Stds_ReleaseTextureHandle( const int32_t handle ) {
+  if ( handle >= 0 && handle < g_app.texture_count && g_app.textures[handle].refs > 0 ) {
+    g_app.textures[handle].refs--;
+  }
+}
+
+/**
+ * Sets how many bytes of cached textures may stay resident. The estimate
+ * counts the pixel format and size of each texture.
+ *
+ * @param size_t budget in bytes.
+ *
+ * @return void.
+ */
+void
+Stds_SetTextureMemoryBudget( const size_t bytes ) {
+  g_app.texture_budget = bytes;
+}
+
+/**
+ * Returns the estimated size of every resident cached texture.
+ *
+ * @param void.
+ *
+ * @return size_t bytes.
+ */
+size_t
+Stds_GetTextureMemoryUsage( void ) {
+  return g_app.texture_bytes;
+}
+
+/**
+ * Probes the texture cache for the file name. The hash is compared first
+ * so a full string compare only happens on a likely match.
+ *
+ * @param const char * file name of SDL_Texture.
+ * @param uint32_t Stds_HashString of the file name.
+ *
+ * @return int32_t handle of the texture, or -1 if it has not been loaded.
+ */
+static int32_t
+Stds_GetTexture( const char *file_name, const uint32_t hash ) {
+  if ( g_app.texture_table_size == 0 ) {
+    return -1;
+  }
+
+  uint32_t mask = ( uint32_t ) g_app.texture_table_size - 1;
+
+  for ( uint32_t slot = hash & mask;; slot = ( slot + 1 ) & mask ) {
+    int32_t index = g_app.texture_table[slot];
+    if ( index == -1 ) {
+      return -1;
+    }
+
+    struct texture_t *t = &g_app.textures[index];
+    if ( t->hash == hash && strcmp( t->name, file_name ) == 0 ) {
+      return index;
+    }
+  }
+}
+
+/**
+ * If a SDL_Texture has not been previously loaded in, we add it to
+ * the cache here. The entry is appended to the dense texture array and
+ * its index is inserted into the hash table, which is kept at most half
+ * full so probe sequences stay short.
+ *
+ * @param const char* name
+ * @param uint32_t Stds_HashString of the name.
+ * @param SDL_Texture * pointer to the texture.
+ *
+ * @return int32_t handle of the new entry.
+ */
+static int32_t
+Stds_CacheTexture( const char *file_name, const uint32_t hash, SDL_Texture *sdl_texture ) {
+  if ( g_app.texture_count == g_app.texture_capacity ) {
+    int32_t capacity = g_app.texture_capacity == 0 ? 64 : g_app.texture_capacity * 2;
+    struct texture_t *textures =
+      realloc( g_app.textures, sizeof( struct texture_t ) * ( size_t ) capacity );
+
+    if ( textures == NULL ) {
+      SDL_LogInfo( SDL_LOG_CATEGORY_APPLICATION, "Could not allocate memory for texture_t. %s.\n",
+                   SDL_GetError() );
+      exit( EXIT_FAILURE );
+    }
+
+    g_app.textures         = textures;
+    g_app.texture_capacity = capacity;
+  }
+
+  if ( ( g_app.texture_count + 1 ) * 2 > g_app.texture_table_size ) {
+    Stds_GrowTextureTable();
+  }
+
+  int32_t           index = g_app.texture_count++;
+  struct texture_t *t     = &g_app.textures[index];
+  memset( t, 0, sizeof( struct texture_t ) );
+
+  const size_t length = strlen( file_name ) + 1;
+  t->name             = malloc( length );
+
+  if ( t->name == NULL ) {
+    SDL_LogInfo( SDL_LOG_CATEGORY_APPLICATION, "Could not allocate memory for texture name. %s.\n",
+                 SDL_GetError() );
+    exit( EXIT_FAILURE );
+  }
+
+  memcpy( t->name, file_name, length );
+  t->hash      = hash;
+  t->texture   = sdl_texture;
+  t->bytes     = Stds_TextureBytes( sdl_texture );
+  t->last_used = g_app.texture_frame;
+  g_app.texture_bytes += t->bytes;
+  Stds_MapTextureHandle( index );
+
+  uint32_t mask = ( uint32_t ) g_app.texture_table_size - 1;
+  uint32_t slot = hash & mask;
+  while ( g_app.texture_table[slot] != -1 ) {
+    slot = ( slot + 1 ) & mask;
+  }
+  g_app.texture_table[slot] = index;
+
+  return index;
+}
+
+/**
+ * Doubles the size of the texture hash table and reinserts every cached
+ * texture.
+ *
+ * @param void.
+ *
+ * @return void.
+ */
+static void
+Stds_GrowTextureTable( void ) {
+  int32_t  size  = g_app.texture_table_size == 0 ? 128 : g_app.texture_table_size * 2;
+  int32_t *table = malloc( sizeof( int32_t ) * ( size_t ) size );
+
+  if ( table == NULL ) {
+    SDL_LogInfo( SDL_LOG_CATEGORY_APPLICATION,
+                 "Could not allocate memory for the texture table. %s.\n", SDL_GetError() );
+    exit( EXIT_FAILURE );
+  }
+
+  memset( table, 0xff, sizeof( int32_t ) * ( size_t ) size );
+
+  uint32_t mask = ( uint32_t ) size - 1;
+  for ( int32_t i = 0; i < g_app.texture_count; i++ ) {
+    uint32_t slot = g_app.textures[i].hash & mask;
+    while ( table[slot] != -1 ) {
+      slot = ( slot + 1 ) & mask;
+    }
+    table[slot] = i;
+  }
+
+  free( g_app.texture_table );
+  g_app.texture_table      = table;
+  g_app.texture_table_size = size;
+}
+
+/**
+ * Loads an image from a mounted pack or the filesystem as a texture. If
+ * neither has it, the error is logged, and the program exits when the
+ * texture is required.
+ *
+ * @param const char * path to image.
+ * @param bool true to exit if the image cannot be loaded.
+ *
+ * @return SDL_Texture * the texture, or NULL if it could not be loaded.
+ */
+static SDL_Texture *
+Stds_ReadTexture( const char *file_name, const bool is_required ) {
+  SDL_Texture *texture = Stds_LoadPackTexture( file_name );
+  if ( texture == NULL ) {
+    texture = IMG_LoadTexture( g_app.renderer, file_name );
+  }
+
+  if ( texture == NULL ) {
+    SDL_LogInfo( SDL_LOG_CATEGORY_APPLICATION, "Error: %s", SDL_GetError() );
+    if ( is_required ) {
+      exit( EXIT_FAILURE );
+    }
+  }
+
+  return texture;
+}
+
+/**
+ * Returns the texture of a cache entry, reloading it first if it was
+ * evicted, and marks it as used this frame. A reload that fails, e.g.
+ * because the file went away, is logged and retried on the next use.
+ *
+ * @param int32_t handle of the texture.
+ *
+ * @return SDL_Texture * the texture, or NULL if it could not be reloaded.
+ */
+static SDL_Texture *
+Stds_ResidentTexture( const int32_t handle ) {
+  struct texture_t *t = &g_app.textures[handle];
+
+  if ( t->texture == NULL ) {
+    t->texture = Stds_ReadTexture( t->name, false );
+    if ( t->texture == NULL ) {
+      SDL_LogInfo( SDL_LOG_CATEGORY_APPLICATION, "Could not reload evicted texture %s.\n",
+                   t->name );
+      return NULL;
+    }
+
+    t->bytes = Stds_TextureBytes( t->texture );
+    g_app.texture_bytes += t->bytes;
+    Stds_MapTextureHandle( handle );
+  }
+
+  t->last_used = g_app.texture_frame;
+  return t->texture;
+}
+
+/**
+ * Records which cache entry a resident texture belongs to, so that
+ * Stds_ReleaseTexture finds it without scanning the cache.
+ *
+ * @param int32_t handle of the texture.
+ *
+ * @return void.
+ */
+static void
+Stds_MapTextureHandle( const int32_t handle ) {
+  SDL_Texture *texture = g_app.textures[handle].texture;
+
+  if ( texture == NULL ) {
+    return;
+  }
+
+  if ( g_app.texture_handles == NULL ) {
+    g_app.texture_handles = Stds_HashMapCreate( sizeof( int32_t ), STDS_HASHMAP_INT_KEYS );
+  }
+
+  Stds_HashMapPutInt( g_app.texture_handles, ( uintptr_t ) texture, &handle );
+}
+
+/**
+ * Estimates the GPU memory of a texture from its pixel format and size.
+ * Formats without a per-pixel size count as four bytes a pixel.
+ *
+ * @param SDL_Texture * texture.
+ *
+ * @return size_t bytes.
+ */
+static size_t
+Stds_TextureBytes( SDL_Texture *texture ) {
+  uint32_t format;
+  int32_t  w;
+  int32_t  h;
+
+  if ( SDL_QueryTexture( texture, &format, NULL, &w, &h ) != 0 ) {
+    return 0;
+  }
+
+  size_t bpp = SDL_BYTESPERPIXEL( format );
+  return ( bpp == 0 ? 4 : bpp ) * ( size_t ) w * ( size_t ) h;
+}
+
+/**
+ * Destroys least recently used textures until the cache fits its budget.
+ * Only textures with no references that were drawn neither in the frame
+ * just presented nor in the one before are candidates, since a swapped
+ * command buffer may still replay the previous frame's draws.
+ *
+ * @param void.
+ *
+ * @return void.
+ */
+static void
+Stds_EvictTextures( void ) {
+  while ( g_app.texture_bytes > g_app.texture_budget ) {
+    int32_t lru = -1;
+
+    for ( int32_t i = 0; i < g_app.texture_count; i++ ) {
+      const struct texture_t *t = &g_app.textures[i];
+      if ( t->texture == NULL || t->refs > 0 || t->last_used + 2 > g_app.texture_frame ) {
+        continue;
+      }
+
+      if ( lru < 0 || t->last_used < g_app.textures[lru].last_used ) {
+        lru = i;
+      }
+    }
+
+    if ( lru < 0 ) {
+      return;
+    }
+
+    struct texture_t *t = &g_app.textures[lru];
+    Stds_HashMapRemoveInt( g_app.texture_handles, ( uintptr_t ) t->texture );
+    Stds_ForgetTextureState( t->texture );
+    SDL_DestroyTexture( t->texture );
+    g_app.texture_bytes -= t->bytes;
+    t->texture = NULL;
+    t->bytes   = 0;
+  }
+}
+
+#if !SDL_VERSION_ATLEAST( 2, 0, 18 )
+/**
+ * Draws a circle outline with the specified color. This function
+ * actually describes the algorithm.
+ *
+ * @param circle_t * pointer to circle structure.
+ * @param SDL_Color * pointer to color.
+ *
+ * @return void.
+ */
+static void
+Stds_DrawCircleHelper( const struct circle_t *circle, const SDL_Color *c ) {
+  const float diameter = ( circle->radius * 2 );
+
+  float x     = ( circle->radius - 1 );
+  float y     = 0;
+  float tx    = 1;
+  float ty    = 1;
+  float error = ( tx - diameter );
+
+  Stds_SetDrawBlendMode( SDL_BLENDMODE_BLEND );
+  Stds_SetDrawColor( c );
+  while ( x >= y ) {
+    //  Each of the following renders an octant of the circle
+    SDL_RenderDrawPointF( g_app.renderer, circle->center_x + x, circle->center_y - y );
+    SDL_RenderDrawPointF( g_app.renderer, circle->center_x + x, circle->center_y + y );
+    SDL_RenderDrawPointF( g_app.renderer, circle->center_x - x, circle->center_y - y );
+    SDL_RenderDrawPointF( g_app.renderer, circle->center_x - x, circle->center_y + y );
+    SDL_RenderDrawPointF( g_app.renderer, circle->center_x + y, circle->center_y - x );
+    SDL_RenderDrawPointF( g_app.renderer, circle->center_x + y, circle->center_y + x );
+    SDL_RenderDrawPointF( g_app.renderer, circle->center_x - y, circle->center_y - x );
+    SDL_RenderDrawPointF( g_app.renderer, circle->center_x - y, circle->center_y + x );
+
+    if ( error <= 0 ) {
+      ++y;
+      error += ty;
+      ty += 2;
+    }
+
+    if ( error > 0 ) {
+      --x;
+      tx += 2;
+      error += ( tx - diameter );
+    }
+  }
+}
+
+/**
+ * Fills a circle with the specified color. This function actually
+ * describes the algorithm.
+ *
+ * @param circle_t * pointer to circle structure.
+ * @param SDL_Color * pointer to color.
+ *
+ * @return void.
+ */
+static void
+Stds_FillCircleHelper( const struct circle_t *circle, const SDL_Color *c ) {
+  float   offsetx, offsety, d;
+  int32_t status;
+
+  offsetx = 0;
+  offsety = circle->radius;
+  d       = circle->radius - 1;
+  status  = 0;
+  Stds_SetDrawBlendMode( SDL_BLENDMODE_BLEND );
+  Stds_SetDrawColor( c );
+
+  while ( offsety >= offsetx ) {
+    float x = circle->center_x;
+    float y = circle->center_y;
+
+    status +=
+        SDL_RenderDrawLineF( g_app.renderer, x - offsety, y + offsetx, x + offsety, y + offsetx );
+    status +=
+        SDL_RenderDrawLineF( g_app.renderer, x - offsetx, y + offsety, x + offsetx, y + offsety );
+    status +=
+        SDL_RenderDrawLineF( g_app.renderer, x - offsetx, y - offsety, x + offsetx, y - offsety );
+    status +=
+        SDL_RenderDrawLineF( g_app.renderer, x - offsety, y - offsetx, x + offsety, y - offsetx );
+
+    if ( status < 0 ) {
+      status = -1;
+      break;
+    }
+
+    if ( d >= 2 * offsetx ) {
+      d -= 2 * offsetx + 1;
+      offsetx += 1;
+    } else if ( d < 2 * ( circle->radius - offsety ) ) {
+      d += 2 * offsety - 1;
+      offsety -= 1;
+    } else {
+      d += 2 * ( offsety - offsetx - 1 );
+      offsety -= 1;
+      offsetx += 1;
+    }
+  }
+}
+
+#endif
+
+/**
+ * Returns the cache slot for a texture. Slots are direct-mapped by address;
+ * when another texture owns the slot it is taken over with nothing known.
+ *
+ * @param SDL_Texture * texture.
+ *
+ * @return texture_state_t * pointer to the slot.
+ */
+static struct texture_state_t *
+Stds_GetTextureState( SDL_Texture *texture ) {
+  uintptr_t               p  = ( uintptr_t ) texture;
+  struct texture_state_t *ts = &render_state.textures[( ( p >> 4 ) ^ ( p >> 12 ) ) &
+                                                      ( STDS_TEXTURE_STATE_SLOTS - 1 )];
+
+  if ( ts->texture != texture ) {
+    ts->texture = texture;
+    ts->known   = 0;
+  }
+
+  return ts;
+}
+
+/**
+ * Appends a sprite to the batch, growing it as needed. A NULL color takes
+ * the texture's cached color and alpha mods.
+ *
+ * @param SDL_Texture * texture.
+ * @param SDL_Rect * source rectangle, or NULL.
+ * @param SDL_FRect * destination rectangle in screen coordinates.
+ * @param float rotation in degrees.
+ * @param SDL_FPoint * rotation point relative to dst, or NULL.
+ * @param SDL_RendererFlip flip.
+ * @param SDL_Color * color, or NULL.
+ * @param int32_t layer.
+ *
+ * @return void.
+ */
+static void
+Stds_BatchQueue( SDL_Texture *texture, const SDL_Rect *src, const SDL_FRect *dst,
+                 const float angle, const SDL_FPoint *center, const SDL_RendererFlip flip,
+                 const SDL_Color *color, const int32_t layer ) {
+  if ( sprite_batch.count == sprite_batch.capacity ) {
+    sprite_batch.capacity = sprite_batch.capacity == 0 ? 256 : sprite_batch.capacity * 2;
+    sprite_batch.sprites  = realloc( sprite_batch.sprites,
+                                    sizeof( struct sprite_t ) * ( size_t ) sprite_batch.capacity );
+
+    if ( sprite_batch.sprites == NULL ) {
+      SDL_LogInfo( SDL_LOG_CATEGORY_APPLICATION, "Could not allocate memory for sprite_t. %s.\n",
+                   SDL_GetError() );
+      exit( EXIT_FAILURE );
+    }
+  }
+
+  const SDL_FPoint mid = { dst->w / 2.0f, dst->h / 2.0f };
+  struct sprite_t *sp  = &sprite_batch.sprites[sprite_batch.count];
+
+  sp->texture = texture;
+  sp->src     = src != NULL ? *src : ( SDL_Rect ){ 0, 0, 0, 0 };
+  sp->dst     = *dst;
+  sp->center  = center != NULL ? *center : mid;
+  sp->angle   = angle;
+  sp->flip    = flip;
+
+  SDL_BlendMode blend;
+  Stds_GetTextureMods( texture, &sp->color, &blend );
+  sp->key = Stds_MakeSortKey( layer, sprite_batch.depth, blend, texture );
+
+  if ( color != NULL ) {
+    sp->color = *color;
+  }
+
+  sprite_batch.count++;
+}
+
+/**
+ * Radix sorts the queued sprites by key into sprite_batch.sorted, growing the
+ * sort scratch as needed.
+ *
+ * @param void.
+ *
+ * @return void.
+ */
+static void
+Stds_SortSprites( void ) {
+  const int32_t count = sprite_batch.count;
+
+  if ( count > sprite_batch.sort_capacity ) {
+    size_t n                   = ( size_t ) sprite_batch.capacity;
+    sprite_batch.sorted        = realloc( sprite_batch.sorted, sizeof( struct sprite_t ) * n );
+    sprite_batch.keys          = realloc( sprite_batch.keys, sizeof( uint64_t ) * n );
+    sprite_batch.order         = realloc( sprite_batch.order, sizeof( uint32_t ) * n );
+    sprite_batch.scratch       = realloc( sprite_batch.scratch, sizeof( uint32_t ) * n );
+    sprite_batch.sort_capacity = sprite_batch.capacity;
+
+    if ( sprite_batch.sorted == NULL || sprite_batch.keys == NULL || sprite_batch.order == NULL
+         || sprite_batch.scratch == NULL ) {
+      SDL_LogInfo( SDL_LOG_CATEGORY_APPLICATION,
+                   "Could not allocate memory for sprite sort. %s.\n", SDL_GetError() );
+      exit( EXIT_FAILURE );
+    }
+  }
+
+  for ( int32_t i = 0; i < count; i++ ) {
+    sprite_batch.keys[i] = sprite_batch.sprites[i].key;
+  }
+
+  Stds_RadixSortKeys( sprite_batch.keys, sprite_batch.order, sprite_batch.scratch, count );
+
+  for ( int32_t i = 0; i < count; i++ ) {
+    sprite_batch.sorted[i] = sprite_batch.sprites[sprite_batch.order[i]];
+  }
+}
+
+/**
+ * Draws sprites in the given order, one render call per run of the same
+ * texture. The texture's color and alpha mods are reset to white first,
+ * since the sprite colors already carry them, and restored afterwards so
+ * later draws of the texture still see them.
+ *
+ * @param sprite_t * sprites to draw.
+ * @param int32_t number of sprites.
+ *
+ * @return void.
+ */
+static void
+Stds_FlushSprites( const struct sprite_t *sprites, const int32_t count ) {
+#if SDL_VERSION_ATLEAST( 2, 0, 18 )
+  Stds_InitQuadIndices();
+
+  for ( int32_t first = 0; first < count; ) {
+    SDL_Texture *texture = sprites[first].texture;
+    int32_t      tw, th;
+
+    SDL_QueryTexture( texture, NULL, NULL, &tw, &th );
+    const struct texture_state_t saved = *Stds_GetTextureState( texture );
+    Stds_SetTextureColorMod( texture, 0xff, 0xff, 0xff );
+    Stds_SetTextureAlphaMod( texture, 0xff );
+
+    float   inv_w = 1.0f / ( float ) tw;
+    float   inv_h = 1.0f / ( float ) th;
+    int32_t quads = 0;
+
+    for ( ; first < count && sprites[first].texture == texture; first++ ) {
+      const struct sprite_t *sp = &sprites[first];
+      SDL_Vertex *           v  = &quad_vertices[quads * 4];
+
+      float u0 = 0, v0 = 0, u1 = 1, v1 = 1;
+      if ( sp->src.w > 0 ) {
+        u0 = ( float ) sp->src.x * inv_w;
+        v0 = ( float ) sp->src.y * inv_h;
+        u1 = ( float ) ( sp->src.x + sp->src.w ) * inv_w;
+        v1 = ( float ) ( sp->src.y + sp->src.h ) * inv_h;
+      }
+
+      if ( sp->flip & SDL_FLIP_HORIZONTAL ) {
+        float t = u0;
+        u0      = u1;
+        u1      = t;
+      }
+
+      if ( sp->flip & SDL_FLIP_VERTICAL ) {
+        float t = v0;
+        v0      = v1;
+        v1      = t;
+      }
+
+      /* Corners relative to the rotation point, rotated, then moved back. */
+      float lx[4] = { -sp->center.x, sp->dst.w - sp->center.x, sp->dst.w - sp->center.x,
+                      -sp->center.x };
+      float ly[4] = { -sp->center.y, -sp->center.y, sp->dst.h - sp->center.y,
+                      sp->dst.h - sp->center.y };
+      float ox     = sp->dst.x + sp->center.x;
+      float oy     = sp->dst.y + sp->center.y;
+      float uvx[4] = { u0, u1, u1, u0 };
+      float uvy[4] = { v0, v0, v1, v1 };
+
+      float ca = 1.0f, sa = 0.0f;
+      if ( sp->angle != 0.0f ) {
+        Stds_SinCosDegrees( sp->angle, &sa, &ca );
+      }
+
+      for ( int32_t k = 0; k < 4; k++ ) {
+        v[k].position.x  = ox + lx[k] * ca - ly[k] * sa;
+        v[k].position.y  = oy + lx[k] * sa + ly[k] * ca;
+        v[k].color       = sp->color;
+        v[k].tex_coord.x = uvx[k];
+        v[k].tex_coord.y = uvy[k];
+      }
+
+      if ( ++quads == STDS_QUAD_BATCH_SIZE ) {
+        SDL_RenderGeometry( g_app.renderer, texture, quad_vertices, quads * 4, quad_indices,
+                            quads * 6 );
+        quads = 0;
+      }
+    }
+
+    if ( quads > 0 ) {
+      SDL_RenderGeometry( g_app.renderer, texture, quad_vertices, quads * 4, quad_indices,
+                          quads * 6 );
+    }
+
+    if ( saved.known & STDS_TEXTURE_KNOWN_COLOR ) {
+      Stds_SetTextureColorMod( texture, saved.mod.r, saved.mod.g, saved.mod.b );
+    }
+
+    if ( saved.known & STDS_TEXTURE_KNOWN_ALPHA ) {
+      Stds_SetTextureAlphaMod( texture, saved.mod.a );
+    }
+  }
+#else
+  for ( int32_t i = 0; i < count; i++ ) {
+    const struct sprite_t *sp = &sprites[i];
+
+    Stds_SetTextureColorMod( sp->texture, sp->color.r, sp->color.g, sp->color.b );
+    Stds_SetTextureAlphaMod( sp->texture, sp->color.a );
+    SDL_RenderCopyExF( g_app.renderer, sp->texture, sp->src.w > 0 ? &sp->src : NULL, &sp->dst,
+                       sp->angle, &sp->center, sp->flip );
+  }
+#endif
+}
+
+/**
+ * Records a textured draw into the command buffer of the calling thread.
+ *
+ * @param uint8_t STDS_COMMAND_TEXTURE or STDS_COMMAND_SPRITE.
+ * @param SDL_Texture * texture.
+ * @param SDL_Rect * source rectangle, or NULL.
+ * @param SDL_FRect * destination rectangle in screen coordinates.
+ * @param float rotation in degrees.
+ * @param SDL_RendererFlip flip.
+ * @param SDL_FPoint * rotation point relative to dst, or NULL.
+ *
+ * @return render_command_t * pointer to the command.
+ */
+static struct render_command_t *
+Stds_RecordTexture( const uint8_t type, SDL_Texture *texture, const SDL_Rect *src,
+                    const SDL_FRect *dst, const float angle, const SDL_RendererFlip flip,
+                    const SDL_FPoint *center ) {
+  struct render_command_t *cmd = Stds_PushCommand( type );
+
+  cmd->texture = texture;
+  cmd->dst     = *dst;
+  cmd->angle   = angle;
+  cmd->flip    = flip;
+
+  if ( src != NULL ) {
+    cmd->src = *src;
+    cmd->flags |= STDS_COMMAND_HAS_SRC;
+  }
+
+  if ( center != NULL ) {
+    cmd->center = *center;
+    cmd->flags |= STDS_COMMAND_HAS_CENTER;
+  }
+
+  return cmd;
+}
+
+/**
+ * Determines whether a screen-space destination rectangle, rotated by angle
+ * degrees about rotate_point (or its center), can touch the screen. Rotated
+ * rectangles are tested by the square that bounds every rotation about the
+ * pivot, which is cheap and never culls anything visible.
+ *
+ * @param SDL_FRect * destination rectangle in screen coordinates.
+ * @param uint16_t angle of rotation.
+ * @param SDL_FPoint * rotation point relative to the rectangle, or NULL.
+ *
+ * @return bool true if the rectangle may be visible.
+ */
+static bool
+Stds_IsDestVisible( const SDL_FRect *dest, const uint16_t angle, const SDL_FPoint *rotate_point ) {
+  if ( angle % 360 == 0 ) {
+    return Stds_IsRectVisible( dest, false );
+  }
+
+  const float px = rotate_point != NULL ? rotate_point->x : dest->w * 0.5f;
+  const float py = rotate_point != NULL ? rotate_point->y : dest->h * 0.5f;
+  const float dx = fmaxf( fabsf( px ), fabsf( dest->w - px ) );
+  const float dy = fmaxf( fabsf( py ), fabsf( dest->h - py ) );
+  const float r  = sqrtf( dx * dx + dy * dy );
+
+  SDL_FRect bounds = { dest->x + px - r, dest->y + py - r, 2.0f * r, 2.0f * r };
+  return Stds_IsRectVisible( &bounds, false );
+}
+
+#if SDL_VERSION_ATLEAST( 2, 0, 18 )
+/**
+ * Fills the shared quad index buffer the first time it is needed.
+ *
+ * @param void.
+ *
+ * @return void.
+ */
+static void
+Stds_InitQuadIndices( void ) {
+  if ( quad_indices_ready ) {
+    return;
+  }
+
+  for ( int32_t q = 0; q < STDS_QUAD_BATCH_SIZE; q++ ) {
+    quad_indices[q * 6 + 0] = q * 4 + 0;
+    quad_indices[q * 6 + 1] = q * 4 + 1;
+    quad_indices[q * 6 + 2] = q * 4 + 2;
+    quad_indices[q * 6 + 3] = q * 4 + 2;
+    quad_indices[q * 6 + 4] = q * 4 + 3;
+    quad_indices[q * 6 + 5] = q * 4 + 0;
+  }
+  quad_indices_ready = true;
+}
+
+/**
+ * Builds the unit rim and the per-bucket index meshes the first time a
+ * circle is drawn.
+ *
+ * @param void.
+ *
+ * @return void.
+ */
+static void
+Stds_InitShapeCache( void ) {
+  if ( shape_cache.is_ready ) {
+    return;
+  }
+
+  for ( int32_t k = 0; k < STDS_CIRCLE_MAX_SEGMENTS; k++ ) {
+    float radians      = ( float ) PI * 2.f * ( float ) k / STDS_CIRCLE_MAX_SEGMENTS;
+    shape_cache.rim[k] = ( SDL_FPoint ){ cosf( radians ), sinf( radians ) };
+  }
+
+  for ( int32_t b = 0; b < STDS_CIRCLE_BUCKETS; b++ ) {
+    const int32_t n = 8 << b;
+
+    /* A chord strays r * (1 - cos(pi / n)) from its arc. */
+    shape_cache.max_radius[b] = 0.25f / ( 1.0f - cosf( ( float ) PI / ( float ) n ) );
+
+    for ( int32_t k = 0; k < n; k++ ) {
+      const int32_t j = ( k + 1 ) % n;
+
+      shape_cache.fan[b][k * 3 + 0] = 0;
+      shape_cache.fan[b][k * 3 + 1] = 1 + k;
+      shape_cache.fan[b][k * 3 + 2] = 1 + j;
+
+      shape_cache.ring[b][k * 6 + 0] = k * 2;
+      shape_cache.ring[b][k * 6 + 1] = j * 2;
+      shape_cache.ring[b][k * 6 + 2] = k * 2 + 1;
+      shape_cache.ring[b][k * 6 + 3] = k * 2 + 1;
+      shape_cache.ring[b][k * 6 + 4] = j * 2;
+      shape_cache.ring[b][k * 6 + 5] = j * 2 + 1;
+    }
+  }
+  shape_cache.is_ready = true;
+}
+#endif
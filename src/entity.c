@@ -0,0 +1,651 @@
+/**
+ * @file entity.c
+ * @author Joshua Crotts
+ * @date October 14 2026
+ * @version 1.0
+ *
+ * @section LICENSE
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License as
+ * published by the Free Software Foundation; either version 2 of
+ * the License, or (at your option) any later version.
+ *
+ * @section DESCRIPTION
+ *
+ * This file defines the entity registry: entities stored as packed,
+ * parallel component arrays instead of linked entity_t structures. Hot
+ * components (transform, velocity, bounds) sit in their own arrays so a
+ * system reads only what it uses, and destroying an entity moves the last
+ * one into its place so the arrays never have holes. Generational ids stay
+ * valid across those moves and detect references to destroyed entities.
+ *
+ * Entities can also be registered under a type whose update and draw
+ * kernels each run once over the type's contiguous range, instead of
+ * through per-entity function pointers.
+ *
+ * For games that keep using entity_t, an entity pool hands out entity_t
+ * slots from one preallocated block. Releasing a slot keeps its bounding box
+ * and animation, so respawning bullets or pickups allocates nothing.
+ */
+#include "../include/entity.h"
+
+static void Stds_GrowEntityArrays( struct entity_registry_t *reg, const uint32_t capacity );
+static void Stds_GrowEntitySlots( struct entity_registry_t *reg );
+static void Stds_MoveEntity( struct entity_registry_t *reg, const uint32_t from,
+                             const uint32_t to );
+
+/**
+ * Creates an empty entity registry.
+ *
+ * @param uint32_t number of entities to allocate room for up front.
+ * @param size_t bytes of cold data per entity, or 0 for none.
+ *
+ * @return entity_registry_t * pointer to the registry.
+ */
+struct entity_registry_t *
+Stds_CreateEntityRegistry( const uint32_t capacity, const size_t cold_size ) {
+  struct entity_registry_t *reg;
+  reg = malloc( sizeof( struct entity_registry_t ) );
+
+  if ( reg == NULL ) {
+    SDL_LogInfo( SDL_LOG_CATEGORY_APPLICATION,
+                 "Could not allocate memory for entity_registry_t. %s.\n", SDL_GetError() );
+    exit( EXIT_FAILURE );
+  }
+
+  memset( reg, 0, sizeof( struct entity_registry_t ) );
+  reg->cold_size = cold_size;
+  Stds_GrowEntityArrays( reg, capacity > 0 ? capacity : STDS_OBJECT_POOL_BLOCK );
+  Stds_RegisterEntityType( reg, NULL, NULL );
+
+  return reg;
+}
+
+/**
+ * Registers an entity type. Its kernels receive the registry and the
+ * packed range of the type's entities, e.g. reg->transforms[first] through
+ * reg->transforms[first + count - 1]. A kernel must not create or destroy
+ * entities, since that moves other types' ranges; collect ids and destroy
+ * them after the batch instead.
+ *
+ * @param entity_registry_t * pointer to the registry.
+ * @param void (*)(entity_registry_t *, uint32_t, uint32_t) update kernel, or NULL.
+ * @param void (*)(entity_registry_t *, uint32_t, uint32_t) draw kernel, or NULL.
+ *
+ * @return uint32_t type id.
+ */
+uint32_t
+Stds_RegisterEntityType( struct entity_registry_t *reg,
+                         void ( *update_batch )( struct entity_registry_t *, uint32_t, uint32_t ),
+                         void ( *draw_batch )( struct entity_registry_t *, uint32_t, uint32_t ) ) {
+  struct entity_type_t *types =
+    realloc( reg->types, sizeof( struct entity_type_t ) * ( reg->type_count + 1 ) );
+
+  if ( types == NULL ) {
+    SDL_LogInfo( SDL_LOG_CATEGORY_APPLICATION,
+                 "Could not allocate memory for entity_type_t. %s.\n", SDL_GetError() );
+    exit( EXIT_FAILURE );
+  }
+
+  struct entity_type_t *t = &types[reg->type_count];
+  t->first                = reg->count;
+  t->count                = 0;
+  t->update_batch         = update_batch;
+  t->draw_batch           = draw_batch;
+  reg->types              = types;
+
+  return reg->type_count++;
+}
+
+/**
+ * Adds an entity of the default type. Its components are zeroed, except
+ * for a scale of 1.
+ *
+ * @param entity_registry_t * pointer to the registry.
+ *
+ * @return uint32_t id of the new entity.
+ */
+uint32_t
+Stds_CreateEntity( struct entity_registry_t *reg ) {
+  return Stds_CreateEntityOfType( reg, 0 );
+}
+
+/**
+ * Adds an entity at the end of its type's range. Every later type gives up
+ * its first entity to its own end to make room, so this costs one move per
+ * later type. Its components are zeroed, except for a scale of 1.
+ *
+ * @param entity_registry_t * pointer to the registry.
+ * @param uint32_t type id from Stds_RegisterEntityType.
+ *
+ * @return uint32_t id of the new entity, or STDS_ENTITY_NONE for an unknown
+ *         type.
+ */
+uint32_t
+Stds_CreateEntityOfType( struct entity_registry_t *reg, const uint32_t type ) {
+  if ( type >= reg->type_count ) {
+    SDL_LogInfo( SDL_LOG_CATEGORY_APPLICATION, "Entity type %u is not registered.\n", type );
+    return STDS_ENTITY_NONE;
+  }
+
+  if ( reg->count == reg->capacity ) {
+    Stds_GrowEntityArrays( reg, reg->capacity * 2 );
+  }
+
+  if ( reg->free_count == 0 ) {
+    Stds_GrowEntitySlots( reg );
+  }
+
+  uint32_t index = reg->count++;
+
+  for ( uint32_t k = reg->type_count - 1; k > type; k-- ) {
+    struct entity_type_t *t = &reg->types[k];
+
+    if ( t->count > 0 ) {
+      Stds_MoveEntity( reg, t->first, index );
+    }
+
+    index = t->first++;
+  }
+
+  reg->types[type].count++;
+
+  uint32_t slot = reg->free_slots[--reg->free_count];
+  uint32_t id   = ( ( uint32_t ) reg->generations[slot] << STDS_ENTITY_INDEX_BITS ) | slot;
+
+  reg->dense_of[slot] = index;
+  reg->ids[index]     = id;
+
+  memset( &reg->transforms[index], 0, sizeof( struct entity_transform_t ) );
+  reg->transforms[index].scale.x = 1.0f;
+  reg->transforms[index].scale.y = 1.0f;
+  memset( &reg->velocities[index], 0, sizeof( struct vec2_t ) );
+  memset( &reg->bounds[index], 0, sizeof( SDL_FRect ) );
+
+  if ( reg->cold_size > 0 ) {
+    memset( reg->cold + ( size_t ) index * reg->cold_size, 0, reg->cold_size );
+  }
+
+  return id;
+}
+
+/**
+ * Returns the type of an entity.
+ *
+ * @param entity_registry_t * pointer to the registry.
+ * @param uint32_t id.
+ *
+ * @return int32_t type id, or -1 for a stale id.
+ */
+int32_t
+Stds_GetEntityType( const struct entity_registry_t *reg, const uint32_t id ) {
+  int32_t index = Stds_GetEntityIndex( reg, id );
+
+  if ( index < 0 ) {
+    return -1;
+  }
+
+  uint32_t k = 0;
+  while ( ( uint32_t ) index >= reg->types[k].first + reg->types[k].count ) {
+    k++;
+  }
+
+  return ( int32_t ) k;
+}
+
+/**
+ * Calls each type's update kernel once over its range, in type order.
+ *
+ * @param entity_registry_t * pointer to the registry.
+ *
+ * @return void.
+ */
+void
+Stds_UpdateEntityTypes( struct entity_registry_t *reg ) {
+  for ( uint32_t k = 0; k < reg->type_count; k++ ) {
+    const struct entity_type_t *t = &reg->types[k];
+
+    if ( t->update_batch != NULL && t->count > 0 ) {
+      t->update_batch( reg, t->first, t->count );
+    }
+  }
+}
+
+/**
+ * Calls each type's draw kernel once over its range, in type order.
+ *
+ * @param entity_registry_t * pointer to the registry.
+ *
+ * @return void.
+ */
+void
+Stds_DrawEntityTypes( struct entity_registry_t *reg ) {
+  for ( uint32_t k = 0; k < reg->type_count; k++ ) {
+    const struct entity_type_t *t = &reg->types[k];
+
+    if ( t->draw_batch != NULL && t->count > 0 ) {
+      t->draw_batch( reg, t->first, t->count );
+    }
+  }
+}
+
+/**
+ * Destroys an entity. The last entity of its type moves into its place,
+ * and each later type moves one entity, so indices from before the call
+ * are invalid afterwards; ids are not. Stale ids are ignored.
+ *
+ * @param entity_registry_t * pointer to the registry.
+ * @param uint32_t id of the entity.
+ *
+ * @return void.
+ */
+void
+Stds_DestroyEntity( struct entity_registry_t *reg, const uint32_t id ) {
+  int32_t type = Stds_GetEntityType( reg, id );
+
+  if ( type < 0 ) {
+    return;
+  }
+
+  uint32_t              slot = id & STDS_ENTITY_INDEX_MASK;
+  struct entity_type_t *t    = &reg->types[type];
+  uint32_t              hole = t->first + --t->count;
+
+  Stds_MoveEntity( reg, hole, reg->dense_of[slot] );
+
+  /* Each later type slides down one place by moving its last entity into
+     the hole left just before its range. */
+  for ( uint32_t k = ( uint32_t ) type + 1; k < reg->type_count; k++ ) {
+    t = &reg->types[k];
+
+    if ( t->count > 0 ) {
+      Stds_MoveEntity( reg, t->first + t->count - 1, hole );
+      hole = t->first + t->count - 1;
+    }
+
+    t->first--;
+  }
+
+  reg->count--;
+  reg->generations[slot] =
+    ( uint16_t )( ( reg->generations[slot] + 1 ) & STDS_ENTITY_GENERATION_MASK );
+  reg->free_slots[reg->free_count++] = slot;
+}
+
+/**
+ * Determines whether an id still refers to a live entity.
+ *
+ * @param entity_registry_t * pointer to the registry.
+ * @param uint32_t id.
+ *
+ * @return bool true if the entity has not been destroyed.
+ */
+bool
+Stds_IsEntityAlive( const struct entity_registry_t *reg, const uint32_t id ) {
+  return Stds_GetEntityIndex( reg, id ) >= 0;
+}
+
+/**
+ * Returns where an entity currently sits in the packed arrays, e.g. to read
+ * reg->transforms[index]. The index is valid until the next destroy.
+ *
+ * @param entity_registry_t * pointer to the registry.
+ * @param uint32_t id.
+ *
+ * @return int32_t index into the packed arrays, or -1 for a stale id.
+ */
+int32_t
+Stds_GetEntityIndex( const struct entity_registry_t *reg, const uint32_t id ) {
+  uint32_t slot = id & STDS_ENTITY_INDEX_MASK;
+
+  if ( slot >= reg->slot_count || reg->generations[slot] != ( id >> STDS_ENTITY_INDEX_BITS ) ) {
+    return -1;
+  }
+
+  /* A freed slot's generation was bumped, so a live match is always in range. */
+  return ( int32_t ) reg->dense_of[slot];
+}
+
+/**
+ * Returns an entity's cold data.
+ *
+ * @param entity_registry_t * pointer to the registry.
+ * @param uint32_t id.
+ *
+ * @return void * pointer to cold_size bytes, or NULL for a stale id or a
+ *         registry without cold data.
+ */
+void *
+Stds_GetEntityColdData( struct entity_registry_t *reg, const uint32_t id ) {
+  int32_t index = Stds_GetEntityIndex( reg, id );
+
+  if ( index < 0 || reg->cold_size == 0 ) {
+    return NULL;
+  }
+
+  return reg->cold + ( size_t ) index * reg->cold_size;
+}
+
+/**
+ * Returns the bounds of the entity at a packed index in world space.
+ *
+ * @param entity_registry_t * pointer to the registry.
+ * @param uint32_t index into the packed arrays.
+ *
+ * @return SDL_FRect bounds offset by the entity's position.
+ */
+SDL_FRect
+Stds_GetEntityWorldBounds( const struct entity_registry_t *reg, const uint32_t index ) {
+  SDL_FRect r = reg->bounds[index];
+  r.x += reg->transforms[index].pos.x;
+  r.y += reg->transforms[index].pos.y;
+
+  return r;
+}
+
+/**
+ * Moves every entity by its velocity, scaled by dt. One linear pass over
+ * the transform and velocity arrays.
+ *
+ * @param entity_registry_t * pointer to the registry.
+ * @param float time step; pass 1 for per-frame velocities.
+ *
+ * @return void.
+ */
+void
+Stds_IntegrateEntities( struct entity_registry_t *reg, const float dt ) {
+  struct entity_transform_t *t = reg->transforms;
+  const struct vec2_t *      v = reg->velocities;
+
+  for ( uint32_t i = 0; i < reg->count; i++ ) {
+    t[i].pos.x += v[i].x * dt;
+    t[i].pos.y += v[i].y * dt;
+  }
+}
+
+/**
+ * Destroys every entity at once. All outstanding ids become stale.
+ *
+ * @param entity_registry_t * pointer to the registry.
+ *
+ * @return void.
+ */
+void
+Stds_ClearEntityRegistry( struct entity_registry_t *reg ) {
+  for ( uint32_t i = 0; i < reg->count; i++ ) {
+    uint32_t slot          = reg->ids[i] & STDS_ENTITY_INDEX_MASK;
+    reg->generations[slot] =
+      ( uint16_t )( ( reg->generations[slot] + 1 ) & STDS_ENTITY_GENERATION_MASK );
+    reg->free_slots[reg->free_count++] = slot;
+  }
+
+  for ( uint32_t k = 0; k < reg->type_count; k++ ) {
+    reg->types[k].first = 0;
+    reg->types[k].count = 0;
+  }
+
+  reg->count = 0;
+}
+
+/**
+ * Frees the registry and all of its arrays.
+ *
+ * @param entity_registry_t * pointer to the registry.
+ *
+ * @return void.
+ */
+void
+Stds_EntityRegistryDie( struct entity_registry_t *reg ) {
+  free( reg->transforms );
+  free( reg->velocities );
+  free( reg->bounds );
+  free( reg->cold );
+  free( reg->ids );
+  free( reg->dense_of );
+  free( reg->generations );
+  free( reg->free_slots );
+  free( reg->types );
+  free( reg );
+}
+
+/**
+ * Creates a pool of capacity entities, allocated up front.
+ *
+ * @param uint32_t number of entities the pool holds.
+ *
+ * @return entity_pool_t * pointer to the pool.
+ */
+struct entity_pool_t *
+Stds_CreateEntityPool( const uint32_t capacity ) {
+  struct entity_pool_t *pool;
+  pool = malloc( sizeof( struct entity_pool_t ) );
+
+  if ( pool == NULL ) {
+    SDL_LogInfo( SDL_LOG_CATEGORY_APPLICATION, "Could not allocate memory for entity_pool_t. %s.\n",
+                 SDL_GetError() );
+    exit( EXIT_FAILURE );
+  }
+
+  pool->entities    = calloc( capacity, sizeof( struct entity_t ) );
+  pool->free_slots  = malloc( sizeof( uint32_t ) * capacity );
+  pool->is_acquired = calloc( capacity, sizeof( bool ) );
+  pool->capacity    = capacity;
+  pool->free_count  = capacity;
+
+  if ( capacity > 0
+       && ( pool->entities == NULL || pool->free_slots == NULL || pool->is_acquired == NULL ) ) {
+    SDL_LogInfo( SDL_LOG_CATEGORY_APPLICATION, "Could not allocate memory for entity pool. %s.\n",
+                 SDL_GetError() );
+    exit( EXIT_FAILURE );
+  }
+
+  /* Hands out the lowest slots first, so live entities stay packed. */
+  for ( uint32_t i = 0; i < capacity; i++ ) {
+    pool->free_slots[i] = capacity - 1 - i;
+  }
+
+  return pool;
+}
+
+/**
+ * Takes an entity from the pool. Every field is reset to zero, with a scale
+ * of 1, except bounding_box and animation: a slot that had them keeps them,
+ * and its animation restarts from the first frame. Move the bounding box to
+ * the new position before using it.
+ *
+ * @param entity_pool_t * pointer to the pool.
+ *
+ * @return entity_t * pointer to the entity, or NULL if the pool is empty.
+ */
+struct entity_t *
+Stds_EntityPoolAcquire( struct entity_pool_t *pool ) {
+  if ( pool->free_count == 0 ) {
+    return NULL;
+  }
+
+  const uint32_t      slot         = pool->free_slots[--pool->free_count];
+  struct entity_t *   e            = &pool->entities[slot];
+  struct polygon_t *  bounding_box = e->bounding_box;
+  struct animation_t *animation    = e->animation;
+
+  memset( e, 0, sizeof( struct entity_t ) );
+  e->scale        = Stds_CreateVec2( 1.0f, 1.0f );
+  e->bounding_box = bounding_box;
+  e->animation    = animation;
+
+  if ( animation != NULL ) {
+    Stds_RestartAnimation( animation );
+  }
+
+  pool->is_acquired[slot] = true;
+  return e;
+}
+
+/**
+ * Gives an entity back to the pool. It must have come from this pool, and
+ * must be unlinked from any list it was added to. Releasing an entity twice
+ * is ignored.
+ *
+ * @param entity_pool_t * pointer to the pool.
+ * @param entity_t * entity to release.
+ *
+ * @return void.
+ */
+void
+Stds_EntityPoolRelease( struct entity_pool_t *pool, struct entity_t *e ) {
+  if ( e < pool->entities || e >= pool->entities + pool->capacity ) {
+    SDL_LogDebug( SDL_LOG_CATEGORY_APPLICATION, "Entity was not acquired from this pool.\n" );
+    return;
+  }
+
+  const uint32_t slot = ( uint32_t ) ( e - pool->entities );
+
+  if ( pool->is_acquired[slot] ) {
+    pool->is_acquired[slot]              = false;
+    pool->free_slots[pool->free_count++] = slot;
+  }
+}
+
+/**
+ * Returns the number of entities currently acquired from the pool.
+ *
+ * @param entity_pool_t * pointer to the pool.
+ *
+ * @return uint32_t number of acquired entities.
+ */
+uint32_t
+Stds_EntityPoolActiveCount( const struct entity_pool_t *pool ) {
+  return pool->capacity - pool->free_count;
+}
+
+/**
+ * Frees the pool, its entities, and the bounding boxes and animations they
+ * kept.
+ *
+ * @param entity_pool_t * pointer to the pool.
+ *
+ * @return void.
+ */
+void
+Stds_EntityPoolDie( struct entity_pool_t *pool ) {
+  for ( uint32_t i = 0; i < pool->capacity; i++ ) {
+    if ( pool->entities[i].bounding_box != NULL ) {
+      Stds_CleanUpPolygon( pool->entities[i].bounding_box );
+    }
+
+    if ( pool->entities[i].animation != NULL ) {
+      Stds_AnimationDie( pool->entities[i].animation );
+    }
+  }
+
+  free( pool->entities );
+  free( pool->free_slots );
+  free( pool->is_acquired );
+  free( pool );
+}
+
+/**
+ * Reallocates the packed arrays to hold capacity entities.
+ *
+ * @param entity_registry_t * pointer to the registry.
+ * @param uint32_t new capacity.
+ *
+ * @return void.
+ */
+static void
+Stds_GrowEntityArrays( struct entity_registry_t *reg, const uint32_t capacity ) {
+  reg->transforms = realloc( reg->transforms, sizeof( struct entity_transform_t ) * capacity );
+  reg->velocities = realloc( reg->velocities, sizeof( struct vec2_t ) * capacity );
+  reg->bounds     = realloc( reg->bounds, sizeof( SDL_FRect ) * capacity );
+  reg->ids        = realloc( reg->ids, sizeof( uint32_t ) * capacity );
+
+  if ( reg->transforms == NULL || reg->velocities == NULL || reg->bounds == NULL ||
+       reg->ids == NULL ) {
+    SDL_LogInfo( SDL_LOG_CATEGORY_APPLICATION,
+                 "Could not allocate memory for entity_registry_t arrays. %s.\n", SDL_GetError() );
+    exit( EXIT_FAILURE );
+  }
+
+  if ( reg->cold_size > 0 ) {
+    reg->cold = realloc( reg->cold, reg->cold_size * capacity );
+
+    if ( reg->cold == NULL ) {
+      SDL_LogInfo( SDL_LOG_CATEGORY_APPLICATION,
+                   "Could not allocate memory for entity_registry_t cold data. %s.\n",
+                   SDL_GetError() );
+      exit( EXIT_FAILURE );
+    }
+  }
+
+  reg->capacity = capacity;
+}
+
+/**
+ * Adds more slots to the sparse arrays and pushes them onto the free list,
+ * lowest slot on top.
+ *
+ * @param entity_registry_t * pointer to the registry.
+ *
+ * @return void.
+ */
+static void
+Stds_GrowEntitySlots( struct entity_registry_t *reg ) {
+  uint32_t capacity = reg->slot_count > 0 ? reg->slot_count * 2 : reg->capacity;
+
+  /* The all-ones slot is reserved so STDS_ENTITY_NONE never resolves. */
+  if ( capacity > STDS_ENTITY_INDEX_MASK ) {
+    capacity = STDS_ENTITY_INDEX_MASK;
+  }
+
+  if ( capacity <= reg->slot_count ) {
+    SDL_LogInfo( SDL_LOG_CATEGORY_APPLICATION, "Entity registry is out of ids.\n" );
+    exit( EXIT_FAILURE );
+  }
+
+  reg->dense_of    = realloc( reg->dense_of, sizeof( uint32_t ) * capacity );
+  reg->generations = realloc( reg->generations, sizeof( uint16_t ) * capacity );
+  reg->free_slots  = realloc( reg->free_slots, sizeof( uint32_t ) * capacity );
+
+  if ( reg->dense_of == NULL || reg->generations == NULL || reg->free_slots == NULL ) {
+    SDL_LogInfo( SDL_LOG_CATEGORY_APPLICATION,
+                 "Could not allocate memory for entity_registry_t ids. %s.\n", SDL_GetError() );
+    exit( EXIT_FAILURE );
+  }
+
+  for ( uint32_t slot = capacity; slot > reg->slot_count; slot-- ) {
+    reg->generations[slot - 1]         = 0;
+    reg->free_slots[reg->free_count++] = slot - 1;
+  }
+
+  reg->slot_count = capacity;
+}
+
+/**
+ * Moves the entity at packed index from to index to, overwriting whatever
+ * is there, and points its slot at the new index.
+ *
+ * @param entity_registry_t * pointer to the registry.
+ * @param uint32_t source index.
+ * @param uint32_t destination index.
+ *
+ * @return void.
+ */
+static void
+Stds_MoveEntity( struct entity_registry_t *reg, const uint32_t from, const uint32_t to ) {
+  if ( from == to ) {
+    return;
+  }
+
+  reg->transforms[to] = reg->transforms[from];
+  reg->velocities[to] = reg->velocities[from];
+  reg->bounds[to]     = reg->bounds[from];
+  reg->ids[to]        = reg->ids[from];
+
+  if ( reg->cold_size > 0 ) {
+    memcpy( reg->cold + ( size_t ) to * reg->cold_size,
+            reg->cold + ( size_t ) from * reg->cold_size, reg->cold_size );
+  }
+
+  reg->dense_of[reg->ids[to] & STDS_ENTITY_INDEX_MASK] = to;
+}
@@ -14,16 +14,40 @@
  * @section DESCRIPTION
  *
  * Initializes the game structures and pointers for the linked list
- * structures. The game loop is also initialized here.
+ * structures. The game loop is also initialized here. By default update and
+ * draw run in lockstep at FPS; Stds_SetFixedTimestep switches the loop to a
+ * fixed-dt accumulator on the performance counter, which renders as often
+ * as the display allows and interpolates between updates. Both loops finish
+ * asynchronously loaded assets before each update, and reset the frame arena
+ * that backs Stds_FrameAlloc at the start of every frame. Jobs the update
+ * delegate submits without a counter are joined before anything is drawn.
+ * With Stds_SetCommandBuffering, the draw delegate is recorded into a command
+ * buffer and replayed; in overlap mode, update and recording of the next frame
+ * run on a job thread while the main thread submits and presents this one.
  */
 #include "../include/game.h"
+#include "../include/command_buffer.h"
 
 static const char *FPS_STR = " | FPS: ";
 static uint16_t    current_fps;
 
+static struct stds_arena_t *frame_arena;
+
+static void ( *frame_update )( void );
+static struct job_counter_t simulate_counter;
+static uint64_t             simulate_ticks[4]; /* Update start and end, draw start and end. */
+
 static void     Stds_InitWindowFPS( void );
 static void     Stds_CapFramerate( long *, float * );
+static void     Stds_FixedGameLoop( void );
+static bool     Stds_RunFrame( void ( *update )( void ) );
+static void     Stds_SimulateFrame( void *, int32_t );
+static void     Stds_LockstepUpdate( void );
+static void     Stds_FixedUpdate( void );
+static void     Stds_DrawProfilerOverlay( void );
+static void     Stds_ProfileSimulatedFrame( void );
 static uint32_t Stds_UpdateWindowTitle( uint32_t, void * );
+static void     Stds_ResetFrameArena( void );
 
 /**
  * Initializes the app linked list data structures.
@@ -36,14 +60,30 @@ void
 Stds_InitAppStructures( void ) {
   g_app.text_field_tail = &g_app.text_field_head;
   g_app.parallax_tail   = &g_app.parallax_head;
-  g_app.texture_tail    = &g_app.texture_head;
   g_app.button_tail     = &g_app.button_head;
   g_app.trail_tail      = &g_app.trail_head;
-  g_app.font_tail       = &g_app.font_head;
 
   Stds_InitWindowFPS();
 }
 
+/**
+ * Allocates scratch memory that lives until the end of the current frame.
+ * There is nothing to free: the game loop resets the whole arena before the
+ * next frame starts, so the pointer must not be kept across frames.
+ *
+ * @param size_t number of bytes.
+ *
+ * @return void * pointer to the memory, aligned to 16 bytes and not zeroed.
+ */
+void *
+Stds_FrameAlloc( const size_t size ) {
+  if ( frame_arena == NULL ) {
+    frame_arena = Stds_ArenaCreate( STDS_FRAME_ARENA_SIZE );
+  }
+
+  return Stds_ArenaAlloc( frame_arena, size );
+}
+
 /**
  * Runs the game loop, processing input and SDL events as close
  * to the target framerate as possible.
@@ -58,17 +98,365 @@ Stds_GameLoop( void ) {
   long  then;
   float remainder;
 
+  if ( g_app.clock.fixed_dt > 0 ) {
+    Stds_FixedGameLoop();
+    return;
+  }
+
   then = SDL_GetTicks();
 
   /* Main game loop. */
   while ( g_app.is_running ) {
-    Stds_PrepareScene();
+    STDS_PROFILE_FRAME_BEGIN();
+    Stds_ResetFrameArena();
+
+    STDS_PROFILE_BEGIN( input );
     Stds_ProcessInput();
-    g_app.delegate.update();
-    g_app.delegate.draw();
+    STDS_PROFILE_END( input );
+
+    Stds_UpdateAssetLoader( STDS_LOADER_BUDGET_MS );
+    Stds_RunFrame( Stds_LockstepUpdate );
+
+    STDS_PROFILE_FRAME_END();
+    Stds_TelemetryFrame();
+    if ( !g_app.is_headless ) {
+      Stds_CapFramerate( &then, &remainder );
+    }
+  }
+}
+
+/**
+ * Switches Stds_GameLoop to the fixed-timestep mode. The update delegate then
+ * runs exactly updates_per_second times per simulated second, independent of
+ * the refresh rate, while draw runs once per displayed frame with
+ * g_app.clock.alpha set for interpolation. Frames longer than
+ * STDS_MAX_FRAME_TIME are clamped, and at most max_updates steps run per
+ * frame, so a slow update cannot snowball. Passing 0 updates_per_second
+ * restores the lockstep loop.
+ *
+ * @param uint32_t simulation steps per second, e.g. 60 or 120.
+ * @param uint32_t most steps per frame, or 0 for STDS_MAX_UPDATES_PER_FRAME.
+ *
+ * @return void.
+ */
+void
+Stds_SetFixedTimestep( const uint32_t updates_per_second, const uint32_t max_updates ) {
+  g_app.clock.fixed_dt       = updates_per_second > 0 ? 1.0 / updates_per_second : 0;
+  g_app.clock.max_updates    = max_updates > 0 ? max_updates : STDS_MAX_UPDATES_PER_FRAME;
+  g_app.clock.max_frame_time = STDS_MAX_FRAME_TIME;
+  g_app.clock.accumulator    = 0;
+}
+
+/**
+ * Turns vertical sync on or off. With SDL 2.0.18 or newer this applies to
+ * the current renderer; older versions only honor the hint, so the renderer
+ * must be created after this call.
+ *
+ * @param bool true to wait for the display's refresh.
+ *
+ * @return void.
+ */
+void
+Stds_SetVSync( const bool is_enabled ) {
+  SDL_SetHint( SDL_HINT_RENDER_VSYNC, is_enabled ? "1" : "0" );
+
+#if SDL_VERSION_ATLEAST( 2, 0, 18 )
+  if ( g_app.renderer != NULL && SDL_RenderSetVSync( g_app.renderer, is_enabled ) != 0 ) {
+    SDL_LogInfo( SDL_LOG_CATEGORY_APPLICATION, "Could not change vsync. %s.\n", SDL_GetError() );
+  }
+#endif
+}
+
+/**
+ * Turns on-demand drawing on or off. While it is on, the game loop keeps
+ * running updates every frame but only draws and presents frames after
+ * Stds_RequestRedraw was called, so a screen that is not changing (an idle
+ * menu) costs almost no CPU or GPU time. UI layers and window events request
+ * redraws on their own; anything else that changes the picture must call
+ * Stds_RequestRedraw itself.
+ *
+ * @param bool true to only draw requested frames.
+ *
+ * @return void.
+ */
+void
+Stds_SetRedrawOnDemand( const bool is_enabled ) {
+  g_app.is_redraw_on_demand = is_enabled;
+  g_app.is_redraw_requested = true;
+}
+
+/**
+ * Asks for the next frame to be drawn when on-demand drawing is on.
+ *
+ * @param void.
+ *
+ * @return void.
+ */
+void
+Stds_RequestRedraw( void ) {
+  g_app.is_redraw_requested = true;
+}
+
+/**
+ * Returns the render interpolation factor of the fixed-timestep loop.
+ *
+ * @param void.
+ *
+ * @return float fraction of a step between the last update and now, in [0, 1).
+ */
+float
+Stds_GetInterpolationAlpha( void ) {
+  return g_app.clock.alpha;
+}
+
+/**
+ * Runs the fixed-timestep loop selected by Stds_SetFixedTimestep. Real time
+ * is accumulated and consumed in fixed_dt steps; the remainder becomes the
+ * interpolation alpha for the draw delegate.
+ *
+ * @param void.
+ *
+ * @return void.
+ */
+static void
+Stds_FixedGameLoop( void ) {
+  struct game_clock_t *clock = &g_app.clock;
+
+  clock->frequency  = SDL_GetPerformanceFrequency();
+  clock->previous   = SDL_GetPerformanceCounter();
+  clock->fps_start  = clock->previous;
+  clock->fps_frames = 0;
+
+  while ( g_app.is_running ) {
+    uint64_t now        = SDL_GetPerformanceCounter();
+    double   frame_time = ( double ) ( now - clock->previous ) / ( double ) clock->frequency;
+    clock->previous     = now;
+
+    if ( frame_time > clock->max_frame_time ) {
+      frame_time = clock->max_frame_time;
+    }
+
+    /* Headless runs simulate one step per frame, as fast as the steps run. */
+    if ( g_app.is_headless ) {
+      frame_time = clock->fixed_dt;
+    }
+
+    /* A replay takes the recorded time instead, to step the same number of updates. */
+    frame_time = Stds_ReplayFrameTime( frame_time );
+
+    clock->accumulator += frame_time;
+    STDS_PROFILE_FRAME_BEGIN();
+    Stds_ResetFrameArena();
+
+    STDS_PROFILE_BEGIN( input );
+    Stds_ProcessInput();
+    STDS_PROFILE_END( input );
+
+    Stds_UpdateAssetLoader( STDS_LOADER_BUDGET_MS );
+    bool is_drawn = Stds_RunFrame( Stds_FixedUpdate );
+
+    STDS_PROFILE_FRAME_END();
+    Stds_TelemetryFrame();
+
+    /* Without a present, nothing waits for vsync, so sleep for one step instead. */
+    if ( !is_drawn && !g_app.is_headless ) {
+      SDL_Delay( ( uint32_t ) ( clock->fixed_dt * 1000 ) );
+    }
+
+    clock->fps_frames++;
+    if ( now - clock->fps_start >= clock->frequency ) {
+      current_fps       = ( uint16_t ) clock->fps_frames;
+      clock->fps_frames = 0;
+      clock->fps_start  = now;
+    }
+  }
+}
+
+/**
+ * Runs the update half of a frame, then draws and presents it. Without a
+ * command buffer the draw delegate talks to SDL directly. With one, it is
+ * recorded and then replayed. In overlap mode, update and recording run as a
+ * job while this thread submits the previously recorded frame, so what is
+ * presented lags the simulation by one frame.
+ *
+ * With Stds_SetRedrawOnDemand, frames after which nobody called
+ * Stds_RequestRedraw only run the update; the window keeps showing the last
+ * presented frame. Overlap mode always draws.
+ *
+ * @param void (*)( void ) update step of the running loop.
+ *
+ * @return bool true if the frame was drawn and presented.
+ */
+static bool
+Stds_RunFrame( void ( *update )( void ) ) {
+  const uint32_t flags = Stds_GetCommandFlags();
+
+  Stds_UpdateAudio();
+
+  if ( flags & STDS_COMMANDS_OVERLAP ) {
+    frame_update = update;
+    Stds_JobSubmit( Stds_SimulateFrame, NULL, &simulate_counter );
+
+    Stds_PrepareScene();
+
+    STDS_PROFILE_BEGIN( submit );
+    Stds_SubmitCommands();
+    STDS_PROFILE_END( submit );
+
+    Stds_DrawProfilerOverlay();
+
+    STDS_PROFILE_BEGIN( present );
     Stds_PresentScene();
-    Stds_CapFramerate( &then, &remainder );
+    STDS_PROFILE_END( present );
+
+    /* Time spent here is simulation that did not fit behind the present. */
+    STDS_PROFILE_BEGIN( simulate );
+    Stds_JobWait( &simulate_counter );
+    STDS_PROFILE_END( simulate );
+    Stds_ProfileSimulatedFrame();
+
+    Stds_SwapCommands();
+    return true;
+  }
+
+  STDS_PROFILE_BEGIN( update );
+  update();
+  STDS_PROFILE_END( update );
+
+  if ( g_app.is_redraw_on_demand && !g_app.is_redraw_requested ) {
+    return false;
+  }
+
+  g_app.is_redraw_requested = false;
+  Stds_PrepareScene();
+
+  STDS_PROFILE_BEGIN( draw );
+  if ( flags & STDS_COMMANDS_ON ) {
+    Stds_BeginCommands();
+    g_app.delegate.draw();
+    Stds_EndCommands();
+    Stds_SwapCommands();
+    Stds_SubmitCommands();
+  } else {
+    g_app.delegate.draw();
+  }
+  STDS_PROFILE_END( draw );
+
+  Stds_DrawProfilerOverlay();
+
+  STDS_PROFILE_BEGIN( present );
+  Stds_PresentScene();
+  STDS_PROFILE_END( present );
+  return true;
+}
+
+/**
+ * Job body of an overlapped frame: updates, then records the draw delegate
+ * into the back command buffer.
+ *
+ * @param void * unused.
+ * @param int32_t unused.
+ *
+ * @return void.
+ */
+static void
+Stds_SimulateFrame( void *data, int32_t index ) {
+  ( void ) data;
+  ( void ) index;
+
+  simulate_ticks[0] = SDL_GetPerformanceCounter();
+  frame_update();
+  simulate_ticks[1] = SDL_GetPerformanceCounter();
+
+  simulate_ticks[2] = SDL_GetPerformanceCounter();
+  Stds_BeginCommands();
+  g_app.delegate.draw();
+  Stds_EndCommands();
+  simulate_ticks[3] = SDL_GetPerformanceCounter();
+}
+
+/**
+ * Update step of the lockstep loop: one call of the update delegate, joined
+ * with the jobs it submitted.
+ *
+ * @param void.
+ *
+ * @return void.
+ */
+static void
+Stds_LockstepUpdate( void ) {
+  g_app.delegate.update();
+  Stds_JobWait( NULL );
+}
+
+/**
+ * Update step of the fixed-timestep loop: consumes the accumulator in fixed_dt
+ * steps, then sets the interpolation alpha from what is left.
+ *
+ * @param void.
+ *
+ * @return void.
+ */
+static void
+Stds_FixedUpdate( void ) {
+  struct game_clock_t *clock   = &g_app.clock;
+  uint32_t             updates = 0;
+
+  while ( clock->accumulator >= clock->fixed_dt && updates < clock->max_updates ) {
+    g_app.delegate.update();
+    Stds_JobWait( NULL );
+    clock->accumulator -= clock->fixed_dt;
+    updates++;
+  }
+
+  /* Still behind after the step limit: drop the backlog instead of
+     trying to catch up next frame. */
+  if ( clock->accumulator >= clock->fixed_dt ) {
+    clock->accumulator = fmod( clock->accumulator, clock->fixed_dt );
   }
+
+  clock->alpha = ( float ) ( clock->accumulator / clock->fixed_dt );
+}
+
+/**
+ * Draws the profiler overlay in the top-left corner while debug mode is on.
+ *
+ * @param void.
+ *
+ * @return void.
+ */
+static void
+Stds_DrawProfilerOverlay( void ) {
+#ifndef STDS_NO_PROFILER
+  if ( g_app.is_debug_mode ) {
+    Stds_ProfilerDrawOverlay( 4.0f, 4.0f );
+  }
+#endif
+}
+
+/**
+ * Adds the update and draw times of the overlapped frame job to the profiler.
+ * Profiler markers are ignored on the job thread, so the job only reads the
+ * counter and the loop hands the times over once it is joined.
+ *
+ * @param void.
+ *
+ * @return void.
+ */
+static void
+Stds_ProfileSimulatedFrame( void ) {
+#ifndef STDS_NO_PROFILER
+  static int32_t update_scope = -1;
+  static int32_t draw_scope   = -1;
+
+  if ( update_scope < 0 || draw_scope < 0 ) {
+    update_scope = Stds_ProfilerRegisterScope( "update" );
+    draw_scope   = Stds_ProfilerRegisterScope( "draw" );
+  }
+
+  Stds_ProfilerAddJobScope( update_scope, simulate_ticks[0], simulate_ticks[1] );
+  Stds_ProfilerAddJobScope( draw_scope, simulate_ticks[2], simulate_ticks[3] );
+#endif
 }
 
 /**
@@ -141,7 +529,23 @@ Stds_UpdateWindowTitle( uint32_t interval, void *args ) {
   /* Concatenate number to title variable. */
   char *title;
   title = Stds_StrCatIntArray( window_buffer, fps );
-  SDL_SetWindowTitle( g_app.window, title );
+  if ( g_app.window != NULL ) {
+    SDL_SetWindowTitle( g_app.window, title );
+  }
 
   return interval;
 }
+
+/**
+ * Releases everything handed out by Stds_FrameAlloc during the last frame.
+ *
+ * @param void.
+ *
+ * @return void.
+ */
+static void
+Stds_ResetFrameArena( void ) {
+  if ( frame_arena != NULL ) {
+    Stds_ArenaReset( frame_arena );
+  }
+}
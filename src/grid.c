@@ -14,14 +14,26 @@
  * @section DESCRIPTION
  *
  * This file defines the functions associated with grids, and is able to treat each 'box'
- * as a button and deals with events like clicking.
+ * as a button and deals with events like clicking. Drawing only visits the rows and
+ * columns that overlap the camera's view. In tilemap mode, placed textures and sprites
+ * are stored per cell and baked into chunk textures, which are redrawn only when one
+ * of their cells changes. Grids can also keep a compact tile index per cell, which
+ * Stds_DrawGridTiles submits as batched quads every frame without any baking.
  */
 #include "../include/grid.h"
 #include "../include/animation.h"
+#include "../include/camera.h"
 #include "../include/draw.h"
+#include "../include/game.h"
 #include "../include/collision.h"
+#include "../include/pathfinding.h"
 
 static bool Stds_AssertGrid( const struct grid_t *grid );
+static void Stds_SetGridTile( const struct grid_t *grid, const uint32_t col, const uint32_t row,
+                              const struct grid_tile_t *tile );
+static void Stds_BakeGridChunk( const struct grid_t *grid, const uint32_t chunk_col,
+                                const uint32_t chunk_row );
+static void Stds_AllocGridTileIndices( struct grid_t *grid );
 
 /**
  * Created grid with no texture, no collision, etc. This is useful for grids that have to change
@@ -78,9 +90,30 @@ Stds_CreateGrid( const float x, const float y, const int32_t square_width,
 }
 
 /**
- * Draws lines for where the box's of the grid would be.
+ * Computes the range of the grid's cells that overlap the view, honoring
+ * the grid's camera offset setting. The range is inclusive and clamped to
+ * the grid's columns and rows.
  *
- * @TODO: apply grid offset pos with camera.
+ * @param grid_t* pointer to grid_t.
+ * @param uint32_t * receives the first visible column.
+ * @param uint32_t * receives the first visible row.
+ * @param uint32_t * receives the last visible column.
+ * @param uint32_t * receives the last visible row.
+ *
+ * @return bool false if no cell is visible.
+ */
+bool
+Stds_GetGridVisibleRange( const struct grid_t *grid, uint32_t *first_col, uint32_t *first_row,
+                          uint32_t *last_col, uint32_t *last_row ) {
+  return Stds_AssertGrid( grid ) &&
+         Stds_GetVisibleCellRange( grid->sx, grid->sy, ( float ) grid->sw, ( float ) grid->sh,
+                                   grid->cols, grid->rows, grid->is_camera_offset_enabled,
+                                   first_col, first_row, last_col, last_row );
+}
+
+/**
+ * Draws lines for where the box's of the grid would be. Only the lines
+ * bordering visible cells are drawn.
  *
  * @param grid_t* pointer to grid_t.
  *
@@ -89,36 +122,35 @@ Stds_CreateGrid( const float x, const float y, const int32_t square_width,
 void
 Stds_DrawLineGrid( struct grid_t *grid ) {
   if ( Stds_AssertGrid( grid ) ) {
+    uint32_t c0, r0, c1, r1;
+
     grid->x = grid->is_camera_offset_enabled ? grid->sx - g_app.camera.x : grid->sx;
     grid->y = grid->is_camera_offset_enabled ? grid->sy - g_app.camera.y : grid->sy;
 
-    for ( uint32_t r = 0; r < grid->rows; r++ ) {
-      Stds_DrawLine( grid->x, grid->y, grid->x + ( float ) ( grid->sw * grid->cols ), grid->y,
-                     &grid->line_color );
-      grid->y += ( float ) grid->sh;
+    if ( !Stds_GetGridVisibleRange( grid, &c0, &r0, &c1, &r1 ) ) {
+      return;
     }
 
-    grid->y = grid->is_camera_offset_enabled ? grid->sy - g_app.camera.y : grid->sy;
+    const float left   = grid->x + ( float ) ( c0 * grid->sw );
+    const float right  = grid->x + ( float ) ( ( c1 + 1 ) * grid->sw );
+    const float top    = grid->y + ( float ) ( r0 * grid->sh );
+    const float bottom = grid->y + ( float ) ( ( r1 + 1 ) * grid->sh );
 
-    for ( uint32_t c = 0; c < grid->cols; c++ ) {
-      Stds_DrawLine( grid->x, grid->y, grid->x, grid->y + ( float ) ( grid->sh * grid->rows ),
-                     &grid->line_color );
-      grid->x += ( float ) grid->sw;
+    for ( uint32_t r = r0; r <= r1 + 1; r++ ) {
+      const float line_y = grid->y + ( float ) ( r * grid->sh );
+      Stds_DrawLine( left, line_y, right, line_y, &grid->line_color );
     }
 
-    grid->x = grid->is_camera_offset_enabled ? grid->sx - g_app.camera.x : grid->sx;
-
-    Stds_DrawLine( grid->x, grid->y + ( float ) ( grid->sh * grid->rows ),
-                   grid->x + ( float ) ( grid->sw * grid->cols ),
-                   grid->y + ( float ) ( grid->sh * grid->rows ), &grid->line_color );
-    Stds_DrawLine( grid->x + ( float ) ( grid->sw * grid->cols ), grid->y,
-                   grid->x + ( float ) ( grid->sw * grid->cols ),
-                   grid->y + ( float ) ( grid->sh * grid->rows ), &grid->line_color );
+    for ( uint32_t c = c0; c <= c1 + 1; c++ ) {
+      const float line_x = grid->x + ( float ) ( c * grid->sw );
+      Stds_DrawLine( line_x, top, line_x, bottom, &grid->line_color );
+    }
   }
 }
 
 /**
- * Fills the area of the grid with rectangles.
+ * Fills the area of the grid with rectangles. Like before, the fill is not
+ * offset by the camera, so only the cells inside the screen are drawn.
  *
  * @param grid_t* pointer to grid_t.
  *
@@ -127,20 +159,24 @@ Stds_DrawLineGrid( struct grid_t *grid ) {
 void
 Stds_FillWholeGrid( struct grid_t *grid ) {
   if ( Stds_AssertGrid( grid ) ) {
+    uint32_t c0, r0, c1, r1;
+
     grid->x = grid->sx;
     grid->y = grid->sy;
 
-    SDL_FRect fill_rect = { grid->x, grid->y, ( float ) grid->sw, ( float ) grid->sh };
+    if ( !Stds_GetVisibleCellRange( grid->sx, grid->sy, ( float ) grid->sw, ( float ) grid->sh,
+                                    grid->cols, grid->rows, false, &c0, &r0, &c1, &r1 ) ) {
+      return;
+    }
 
-    for ( uint32_t r = 0; r < grid->rows; r++ ) {
-      for ( uint32_t c = 0; c < grid->cols; c++ ) {
+    SDL_FRect fill_rect = { 0, 0, ( float ) grid->sw, ( float ) grid->sh };
 
+    for ( uint32_t r = r0; r <= r1; r++ ) {
+      fill_rect.y = grid->sy + ( float ) ( r * grid->sh );
+      for ( uint32_t c = c0; c <= c1; c++ ) {
+        fill_rect.x = grid->sx + ( float ) ( c * grid->sw );
         Stds_DrawRectF( &fill_rect, &grid->fill_color, true, 0 );
-
-        fill_rect.x += ( float ) grid->sw;
       }
-      fill_rect.y += ( float ) grid->sh;
-      fill_rect.x = grid->sx;
     }
   }
 }
@@ -156,18 +192,32 @@ void
 Stds_FreeGrid( struct grid_t *grid ) {
   if ( grid->textures != NULL ) {
     for ( uint32_t textureIndex = 0; textureIndex < grid->texture_buffer; textureIndex++ ) {
-      SDL_DestroyTexture( grid->textures[textureIndex] );
+      Stds_ReleaseTexture( grid->textures[textureIndex] );
       SDL_LogDebug( SDL_LOG_CATEGORY_APPLICATION, "Freeing texture %d.\n", textureIndex );
     }
     free( grid->textures );
   }
 
   if ( grid->sprite_sheet != NULL ) {
-    SDL_DestroyTexture( grid->sprite_sheet );
+    Stds_ReleaseTexture( grid->sprite_sheet );
     SDL_LogDebug( SDL_LOG_CATEGORY_APPLICATION, "Freeing sprite_sheet.\n" );
   }
 
+  if ( grid->chunks != NULL ) {
+    for ( uint32_t i = 0; i < grid->chunk_cols * grid->chunk_rows; i++ ) {
+      if ( grid->chunks[i].texture != NULL ) {
+        Stds_ForgetTextureState( grid->chunks[i].texture );
+        SDL_DestroyTexture( grid->chunks[i].texture );
+      }
+    }
+    free( grid->chunks );
+    free( grid->tiles );
+  }
+
+  free( grid->tile_indices );
+
   Stds_VectorDestroy( grid->animation );
+  Stds_FreeGridPathData( grid );
 
   memset( grid, 0, sizeof( struct grid_t ) ); /* Makes the grid be equal to NULL. */
   free( grid );
@@ -314,7 +364,8 @@ Stds_AddGridTexture( struct grid_t *grid, const char *filePath ) {
 }
 
 /**
- * Renders the specified texture id onto the grid.
+ * Renders the specified texture id onto the grid. In tilemap mode, the texture is
+ * stored in the cell instead and shows up with the next Stds_DrawGridTilemap.
  *
  * @param grid_t* pointer to grid_t.
  * @param uint32_t which column texture will be put.
@@ -329,7 +380,11 @@ void
 Stds_PutGridTexture( struct grid_t *grid, const uint32_t col, const uint32_t row,
                      const int32_t index, const SDL_RendererFlip flip, const uint16_t angle ) {
   if ( Stds_AssertGrid( grid ) ) {
-    if ( index < grid->texture_buffer && index > -1 ) {
+    if ( index < grid->texture_buffer && index > -1 && grid->is_tilemap_enabled ) {
+      struct grid_tile_t tile = { { 0, 0, 0, 0 }, index, angle, ( uint8_t ) flip,
+                                  STDS_GRID_TILE_TEXTURE };
+      Stds_SetGridTile( grid, col, row, &tile );
+    } else if ( index < grid->texture_buffer && index > -1 ) {
       SDL_FRect texture_position = { grid->x + ( float ) ( col * grid->sw ),
                                      grid->y + ( float ) ( row * grid->sh ), ( float ) grid->sw,
                                      ( float ) grid->sh };
@@ -390,7 +445,9 @@ Stds_SelectSpriteForGrid( struct grid_t *grid, const uint32_t sheetCol, const ui
 }
 
 /**
- * Will render the specified sprite selected from Stds_SelectSpriteForGrid.
+ * Will render the specified sprite selected from Stds_SelectSpriteForGrid. In tilemap
+ * mode, the sprite is stored in the cell instead and shows up with the next
+ * Stds_DrawGridTilemap.
  *
  * @param grid_t* pointer to grid_t.
  * @param uint32_t which column to render the specified sprite onto the grid.
@@ -404,7 +461,11 @@ void
 Stds_DrawSelectedSpriteOnGrid( const struct grid_t *grid, const uint32_t gridCol,
                                const uint32_t gridRow, const SDL_RendererFlip flip,
                                const uint16_t angle ) {
-  if ( Stds_AssertGrid( grid ) && gridCol < grid->cols && gridRow < grid->rows ) {
+  if ( Stds_AssertGrid( grid ) && gridCol < grid->cols && gridRow < grid->rows &&
+       grid->is_tilemap_enabled ) {
+    struct grid_tile_t tile = { grid->clip, -1, angle, ( uint8_t ) flip, STDS_GRID_TILE_SPRITE };
+    Stds_SetGridTile( grid, gridCol, gridRow, &tile );
+  } else if ( Stds_AssertGrid( grid ) && gridCol < grid->cols && gridRow < grid->rows ) {
     SDL_FRect position = { grid->x + ( float ) ( gridCol * grid->sw ),
                            grid->y + ( float ) ( gridRow * grid->sh ), ( float ) grid->sw,
                            ( float ) grid->sh };
@@ -427,7 +488,7 @@ Stds_AddAnimationToGrid( struct grid_t *grid, struct animation_t *animate ) {
     return -1;
   } else if ( Stds_AssertGrid( grid ) ) {
     grid->animation_buffer++;
-    Stds_VectorAppend( grid->animation, animate );
+    Stds_VectorAppend( grid->animation, &animate );
     return grid->animation_buffer;
   }
   return -1;
@@ -450,7 +511,8 @@ Stds_RenderAnimationToGrid( const struct grid_t *grid, const uint32_t col, const
                             const uint16_t angle ) {
   if ( Stds_AssertGrid( grid ) && grid->animation != NULL && col < grid->cols &&
        row < grid->rows ) {
-    struct animation_t *editAnim = Stds_VectorGet( grid->animation, index );
+    struct animation_t *editAnim =
+      *( struct animation_t ** ) Stds_VectorGet( grid->animation, index );
     editAnim->pos.x              = grid->x + ( float ) ( col * grid->sw );
     editAnim->pos.y              = grid->y + ( float ) ( row * grid->sh );
     editAnim->dest_width         = grid->sw;
@@ -466,16 +528,282 @@ Stds_RenderAnimationToGrid( const struct grid_t *grid, const uint32_t col, const
 }
 
 /**
- * Renders the spriteSheet from the grid.
+ * Switches the grid to tilemap mode. From then on, Stds_PutGridTexture and
+ * Stds_DrawSelectedSpriteOnGrid store their tile in the cell, and
+ * Stds_DrawGridTilemap draws the stored tiles from textures baked per chunk.
+ *
+ * @param grid_t* pointer to grid_t.
+ * @param uint32_t tiles per side of a chunk, or 0 for STDS_GRID_CHUNK_SIZE.
+ *
+ * @return void.
+ */
+void
+Stds_EnableGridTilemap( struct grid_t *grid, const uint32_t chunk_size ) {
+  if ( !Stds_AssertGrid( grid ) || grid->is_tilemap_enabled ) {
+    return;
+  }
+
+  grid->chunk_size = chunk_size > 0 ? chunk_size : STDS_GRID_CHUNK_SIZE;
+  grid->chunk_cols = ( grid->cols + grid->chunk_size - 1 ) / grid->chunk_size;
+  grid->chunk_rows = ( grid->rows + grid->chunk_size - 1 ) / grid->chunk_size;
+
+  grid->tiles  = calloc( ( size_t ) grid->cols * grid->rows, sizeof( struct grid_tile_t ) );
+  grid->chunks = calloc( ( size_t ) grid->chunk_cols * grid->chunk_rows,
+                         sizeof( struct grid_chunk_t ) );
+
+  if ( grid->tiles == NULL || grid->chunks == NULL ) {
+    SDL_LogInfo( SDL_LOG_CATEGORY_APPLICATION, "Could not allocate memory for grid tilemap. %s.\n",
+                 SDL_GetError() );
+    exit( EXIT_FAILURE );
+  }
+
+  grid->is_tilemap_enabled = true;
+}
+
+/**
+ * Empties a cell of a tilemap grid.
+ *
+ * @param grid_t* pointer to grid_t.
+ * @param uint32_t column of the cell.
+ * @param uint32_t row of the cell.
+ *
+ * @return void.
+ */
+void
+Stds_ClearGridTile( struct grid_t *grid, const uint32_t col, const uint32_t row ) {
+  if ( Stds_AssertGrid( grid ) && grid->is_tilemap_enabled ) {
+    struct grid_tile_t tile = { { 0, 0, 0, 0 }, -1, 0, SDL_FLIP_NONE, STDS_GRID_TILE_EMPTY };
+    Stds_SetGridTile( grid, col, row, &tile );
+  }
+}
+
+/**
+ * Marks every chunk of a tilemap grid for rebaking. Call this after replacing
+ * one of the grid's textures; Stds_DrawGridTilemap does it by itself after
+ * the renderer reports that render targets were reset.
+ *
+ * @param grid_t* pointer to grid_t.
+ *
+ * @return void.
+ */
+void
+Stds_InvalidateGridTilemap( struct grid_t *grid ) {
+  if ( Stds_AssertGrid( grid ) && grid->is_tilemap_enabled ) {
+    for ( uint32_t i = 0; i < grid->chunk_cols * grid->chunk_rows; i++ ) {
+      grid->chunks[i].is_dirty = true;
+    }
+  }
+}
+
+/**
+ * Draws the stored tiles of a tilemap grid. Only chunks that overlap the
+ * camera's view are drawn, one texture each, and a chunk is baked again only
+ * if one of its cells changed since it was last drawn.
+ *
+ * @param grid_t* pointer to grid_t.
+ *
+ * @return void.
+ */
+void
+Stds_DrawGridTilemap( struct grid_t *grid ) {
+  uint32_t c0, r0, c1, r1;
+
+  if ( !Stds_AssertGrid( grid ) || !grid->is_tilemap_enabled ) {
+    return;
+  }
+
+  const float chunk_w = ( float ) ( grid->chunk_size * grid->sw );
+  const float chunk_h = ( float ) ( grid->chunk_size * grid->sh );
+
+  if ( !Stds_GetVisibleCellRange( grid->sx, grid->sy, chunk_w, chunk_h, grid->chunk_cols,
+                                  grid->chunk_rows, grid->is_camera_offset_enabled, &c0, &r0, &c1,
+                                  &r1 ) ) {
+    return;
+  }
+
+  if ( grid->target_resets != g_app.target_resets ) {
+    grid->target_resets = g_app.target_resets;
+    Stds_InvalidateGridTilemap( grid );
+  }
+
+  for ( uint32_t cr = r0; cr <= r1; cr++ ) {
+    for ( uint32_t cc = c0; cc <= c1; cc++ ) {
+      struct grid_chunk_t *chunk = &grid->chunks[cr * grid->chunk_cols + cc];
+
+      if ( chunk->is_dirty ) {
+        Stds_BakeGridChunk( grid, cc, cr );
+      }
+
+      if ( chunk->texture != NULL ) {
+        int32_t w, h;
+        SDL_QueryTexture( chunk->texture, NULL, NULL, &w, &h );
+        Stds_DrawTexture( chunk->texture, grid->sx + ( float ) cc * chunk_w,
+                          grid->sy + ( float ) cr * chunk_h, ( float ) w, ( float ) h, 0,
+                          SDL_FLIP_NONE, NULL, grid->is_camera_offset_enabled );
+      }
+    }
+  }
+}
+
+/**
+ * Sets the tile index of a cell, as drawn by Stds_DrawGridTiles. Index 0
+ * empties the cell; index k draws sprite sheet cell k - 1, counted row by
+ * row, or the texture added by the k-th Stds_AddGridTexture if the grid has
+ * no sprite sheet.
+ *
+ * @param grid_t* pointer to grid_t.
+ * @param uint32_t column of the cell.
+ * @param uint32_t row of the cell.
+ * @param uint16_t tile index.
+ *
+ * @return void.
+ */
+void
+Stds_SetGridTileIndex( struct grid_t *grid, const uint32_t col, const uint32_t row,
+                       const uint16_t index ) {
+  if ( Stds_AssertGrid( grid ) && col < grid->cols && row < grid->rows ) {
+    if ( grid->tile_indices == NULL ) {
+      Stds_AllocGridTileIndices( grid );
+    }
+    grid->tile_indices[row * grid->cols + col] = index;
+  }
+}
+
+/**
+ * Returns the tile index of a cell, see Stds_SetGridTileIndex.
+ *
+ * @param grid_t* pointer to grid_t.
+ * @param uint32_t column of the cell.
+ * @param uint32_t row of the cell.
+ *
+ * @return uint16_t tile index, or 0 if the cell is empty or out of range.
+ */
+uint16_t
+Stds_GetGridTileIndex( const struct grid_t *grid, const uint32_t col, const uint32_t row ) {
+  if ( Stds_AssertGrid( grid ) && grid->tile_indices != NULL && col < grid->cols &&
+       row < grid->rows ) {
+    return grid->tile_indices[row * grid->cols + col];
+  }
+
+  return 0;
+}
+
+/**
+ * Replaces the tile index of every cell at once.
+ *
+ * @param grid_t* pointer to grid_t.
+ * @param uint16_t * cols * rows indices in row-major order, or NULL to empty
+ *        every cell.
+ *
+ * @return void.
+ */
+void
+Stds_SetGridTileIndices( struct grid_t *grid, const uint16_t *indices ) {
+  if ( !Stds_AssertGrid( grid ) ) {
+    return;
+  }
+
+  if ( grid->tile_indices == NULL ) {
+    Stds_AllocGridTileIndices( grid );
+  }
+
+  const size_t size = ( size_t ) grid->cols * grid->rows * sizeof( uint16_t );
+  if ( indices != NULL ) {
+    memcpy( grid->tile_indices, indices, size );
+  } else {
+    memset( grid->tile_indices, 0, size );
+  }
+}
+
+/**
+ * Draws the tile index of every visible cell. The quads are built straight
+ * from the index array and submitted through Stds_DrawQuads: a sprite sheet
+ * grid costs one submit for the whole view, and a grid of separate textures
+ * one submit per texture in use. Nothing is cached, so changing indices
+ * between frames is free.
+ *
+ * @param grid_t* pointer to grid_t.
+ *
+ * @return void.
+ */
+void
+Stds_DrawGridTiles( const struct grid_t *grid ) {
+  uint32_t c0, r0, c1, r1;
+
+  if ( !Stds_AssertGrid( grid ) || grid->tile_indices == NULL ||
+       !Stds_GetGridVisibleRange( grid, &c0, &r0, &c1, &r1 ) ) {
+    return;
+  }
+
+  const size_t visible = ( size_t ) ( c1 - c0 + 1 ) * ( r1 - r0 + 1 );
+  SDL_FRect *  dst     = Stds_FrameAlloc( visible * sizeof( SDL_FRect ) );
+
+  if ( grid->sprite_sheet != NULL ) {
+    const uint32_t sprites = grid->sprite_sheet_cols * grid->sprite_sheet_rows;
+    SDL_Rect *     src     = Stds_FrameAlloc( visible * sizeof( SDL_Rect ) );
+    int32_t        count   = 0;
+
+    for ( uint32_t r = r0; r <= r1; r++ ) {
+      const uint16_t *row = &grid->tile_indices[r * grid->cols];
+
+      for ( uint32_t c = c0; c <= c1; c++ ) {
+        if ( row[c] == 0 || row[c] > sprites ) {
+          continue;
+        }
+
+        const uint32_t sprite = row[c] - 1u;
+        dst[count] = ( SDL_FRect ){ grid->sx + ( float ) ( c * grid->sw ),
+                                    grid->sy + ( float ) ( r * grid->sh ), ( float ) grid->sw,
+                                    ( float ) grid->sh };
+        src[count] = ( SDL_Rect ){ ( int32_t ) ( sprite % grid->sprite_sheet_cols ) * grid->clip.w,
+                                   ( int32_t ) ( sprite / grid->sprite_sheet_cols ) * grid->clip.h,
+                                   grid->clip.w, grid->clip.h };
+        count++;
+      }
+    }
+
+    Stds_DrawQuads( grid->sprite_sheet, dst, src, NULL, count, grid->is_camera_offset_enabled );
+    return;
+  }
+
+  for ( int32_t t = 0; t < grid->texture_buffer; t++ ) {
+    const uint16_t index = ( uint16_t ) ( t + 1 );
+    int32_t        count = 0;
+
+    for ( uint32_t r = r0; r <= r1; r++ ) {
+      const uint16_t *row = &grid->tile_indices[r * grid->cols];
+
+      for ( uint32_t c = c0; c <= c1; c++ ) {
+        if ( row[c] == index ) {
+          dst[count++] = ( SDL_FRect ){ grid->sx + ( float ) ( c * grid->sw ),
+                                        grid->sy + ( float ) ( r * grid->sh ),
+                                        ( float ) grid->sw, ( float ) grid->sh };
+        }
+      }
+    }
+
+    if ( count > 0 ) {
+      Stds_DrawQuads( grid->textures[t], dst, NULL, NULL, count, grid->is_camera_offset_enabled );
+    }
+  }
+}
+
+/**
+ * Renders the spriteSheet from the grid, skipping the sprites outside the view.
  * @param grid_t* pointer to grid_t.
  *
  * @return void.
  */
 void
 Stds_RenderPreMadeSpriteSheet( struct grid_t *grid ) {
-  if ( Stds_AssertGrid( grid ) ) {
-    for ( uint32_t i = 0; i < grid->sprite_sheet_cols; i++ ) {
-      for ( uint32_t j = 0; j < grid->sprite_sheet_rows; j++ ) {
+  uint32_t c0, r0, c1, r1;
+
+  if ( Stds_AssertGrid( grid ) &&
+       Stds_GetVisibleCellRange( grid->sx, grid->sy, ( float ) grid->sw, ( float ) grid->sh,
+                                 grid->sprite_sheet_cols, grid->sprite_sheet_rows,
+                                 grid->is_camera_offset_enabled, &c0, &r0, &c1, &r1 ) ) {
+    for ( uint32_t i = c0; i <= c1; i++ ) {
+      for ( uint32_t j = r0; j <= r1; j++ ) {
         Stds_SelectSpriteForGrid( grid, i, j );
 
         SDL_Rect position = { ( int ) ( grid->sx + ( i * grid->sw ) ),
@@ -499,4 +827,106 @@ Stds_RenderPreMadeSpriteSheet( struct grid_t *grid ) {
 static bool
 Stds_AssertGrid( const struct grid_t *grid ) {
   return !( grid == NULL );
-}
\ No newline at end of file
+}
+
+/**
+ * Stores a tile in a cell of a tilemap grid and marks its chunk dirty.
+ *
+ * @param grid_t* pointer to grid_t.
+ * @param uint32_t column of the cell.
+ * @param uint32_t row of the cell.
+ * @param grid_tile_t* tile to store.
+ *
+ * @return void.
+ */
+static void
+Stds_SetGridTile( const struct grid_t *grid, const uint32_t col, const uint32_t row,
+                  const struct grid_tile_t *tile ) {
+  if ( col >= grid->cols || row >= grid->rows ) {
+    return;
+  }
+
+  grid->tiles[row * grid->cols + col] = *tile;
+  grid->chunks[( row / grid->chunk_size ) * grid->chunk_cols + col / grid->chunk_size].is_dirty =
+      true;
+}
+
+/**
+ * Redraws one chunk's tiles into its render-target texture, creating the
+ * texture on first use. Edge chunks are only as large as the cells they
+ * cover. The previous render target is restored afterwards.
+ *
+ * @param grid_t* pointer to grid_t.
+ * @param uint32_t column of the chunk.
+ * @param uint32_t row of the chunk.
+ *
+ * @return void.
+ */
+static void
+Stds_BakeGridChunk( const struct grid_t *grid, const uint32_t chunk_col,
+                    const uint32_t chunk_row ) {
+  struct grid_chunk_t *chunk       = &grid->chunks[chunk_row * grid->chunk_cols + chunk_col];
+  const uint32_t       first_col   = chunk_col * grid->chunk_size;
+  const uint32_t       first_row   = chunk_row * grid->chunk_size;
+  const uint32_t       cols        = grid->cols - first_col < grid->chunk_size
+                                         ? grid->cols - first_col
+                                         : grid->chunk_size;
+  const uint32_t       rows        = grid->rows - first_row < grid->chunk_size
+                                         ? grid->rows - first_row
+                                         : grid->chunk_size;
+  const SDL_Color      transparent = { 0, 0, 0, 0 };
+
+  if ( chunk->texture == NULL ) {
+    chunk->texture = SDL_CreateTexture( g_app.renderer, SDL_PIXELFORMAT_RGBA8888,
+                                        SDL_TEXTUREACCESS_TARGET, ( int ) cols * grid->sw,
+                                        ( int ) rows * grid->sh );
+    if ( chunk->texture == NULL ) {
+      SDL_LogDebug( SDL_LOG_CATEGORY_APPLICATION, "Could not create grid chunk texture. %s.\n",
+                    SDL_GetError() );
+      return;
+    }
+    Stds_SetTextureBlendMode( chunk->texture, SDL_BLENDMODE_BLEND );
+  }
+
+  SDL_Texture *previous_target = SDL_GetRenderTarget( g_app.renderer );
+  SDL_SetRenderTarget( g_app.renderer, chunk->texture );
+  Stds_SetDrawColor( &transparent );
+  SDL_RenderClear( g_app.renderer );
+
+  for ( uint32_t r = 0; r < rows; r++ ) {
+    for ( uint32_t c = 0; c < cols; c++ ) {
+      const struct grid_tile_t *tile = &grid->tiles[( first_row + r ) * grid->cols + first_col + c];
+      SDL_FRect dest = { ( float ) ( c * grid->sw ), ( float ) ( r * grid->sh ), ( float ) grid->sw,
+                         ( float ) grid->sh };
+
+      if ( tile->kind == STDS_GRID_TILE_TEXTURE ) {
+        SDL_RenderCopyExF( g_app.renderer, grid->textures[tile->texture_index], NULL, &dest,
+                           tile->angle, NULL, ( SDL_RendererFlip ) tile->flip );
+      } else if ( tile->kind == STDS_GRID_TILE_SPRITE ) {
+        SDL_RenderCopyExF( g_app.renderer, grid->sprite_sheet, &tile->clip, &dest, tile->angle,
+                           NULL, ( SDL_RendererFlip ) tile->flip );
+      }
+    }
+  }
+
+  SDL_SetRenderTarget( g_app.renderer, previous_target );
+  chunk->is_dirty = false;
+}
+
+/**
+ * Allocates the tile index array of a grid with every cell empty.
+ *
+ * @param grid_t* pointer to grid_t.
+ *
+ * @return void.
+ */
+static void
+Stds_AllocGridTileIndices( struct grid_t *grid ) {
+  grid->tile_indices = calloc( ( size_t ) grid->cols * grid->rows, sizeof( uint16_t ) );
+
+  if ( grid->tile_indices == NULL ) {
+    SDL_LogInfo( SDL_LOG_CATEGORY_APPLICATION,
+                 "Could not allocate memory for grid tile indices. %s.\n", SDL_GetError() );
+    exit( EXIT_FAILURE );
+  }
+}
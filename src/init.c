@@ -14,15 +14,24 @@
  * @section DESCRIPTION
  *
  * This file defines the procedures and functions for instantiating the SDL context.
+ * A headless context has no window and no audio device: it renders in software
+ * into an off-screen surface, so games run where there is no display, and the
+ * game loop runs uncapped.
+ *
+ * Stds_InitGameWithConfig picks the subsystems to start. Starting the mixer can take a
+ * noticeable part of a second on some platforms, so tools and simulations that never
+ * play a sound can leave it off, or open it on the first sound used.
  */
 #include "../include/init.h"
+#include "../include/animation.h"
+#include "../include/command_buffer.h"
+#include "../include/replay.h"
 
 struct app_t g_app;
 
 static struct app_t Stds_CreateApp( void );
 static void Stds_InitSDL( const char *, const uint32_t ww, const uint32_t wh, const uint32_t lw,
                           const uint32_t lh );
-static void Stds_InitAudioContext( void );
 static void Stds_Cleanup( void );
 
 /**
@@ -40,13 +49,88 @@ static void Stds_Cleanup( void );
 void
 Stds_InitGame( const char *window_name, const uint32_t window_width, const uint32_t window_height,
                const uint32_t level_width, const uint32_t level_height ) {
+  struct init_config_t config = Stds_CreateInitConfig( STDS_INIT_EVERYTHING );
+  Stds_InitGameWithConfig( window_name, window_width, window_height, level_width, level_height,
+                           &config );
+}
+
+/**
+ * Initializes the game like Stds_InitGame, but without a window or audio.
+ * Drawing goes to an off-screen software renderer of the given size, sound
+ * effects are ignored, and Stds_GameLoop runs as fast as it can: the
+ * lockstep loop no longer waits out each frame, and the fixed-timestep loop
+ * simulates exactly one step per frame. This is meant for benchmarks and for
+ * running game logic on servers.
+ *
+ * @param uint32_t width of the off-screen target.
+ * @param uint32_t height of the off-screen target.
+ * @param uint32_t level or width that the camera cannot exceed.
+ * @param uint32_t level or height that the camera cannot exceed.
+ *
+ * @return void.
+ */
+void
+Stds_InitGameHeadless( const uint32_t width, const uint32_t height, const uint32_t level_width,
+                       const uint32_t level_height ) {
+  struct init_config_t config = Stds_CreateInitConfig( 0 );
+  Stds_InitGameWithConfig( "Standards (headless)", width, height, level_width, level_height,
+                           &config );
+}
+
+/**
+ * Returns the configuration Stds_InitGame uses, but starting only the given
+ * subsystems: PNG and JPG decoders, and 44.1 kHz stereo audio with a 1024
+ * sample buffer.
+ *
+ * @param uint32_t STDS_INIT_* flags of the subsystems to start.
+ *
+ * @return init_config_t configuration to adjust and pass to Stds_InitGameWithConfig.
+ */
+struct init_config_t
+Stds_CreateInitConfig( const uint32_t subsystems ) {
+  struct init_config_t config;
+
+  config.subsystems      = subsystems;
+  config.image_formats   = IMG_INIT_PNG | IMG_INIT_JPG;
+  config.audio_frequency = STDS_AUDIO_FREQUENCY;
+  config.audio_channels  = STDS_AUDIO_CHANNELS;
+  config.audio_buffer    = STDS_AUDIO_BUFFER;
+
+  return config;
+}
+
+/**
+ * Initializes the game with only the subsystems in the configuration. Without
+ * STDS_INIT_VIDEO the game runs headless, as with Stds_InitGameHeadless.
+ * Unless STDS_INIT_AUDIO or STDS_INIT_LAZY_AUDIO is set there is no audio, and
+ * unless STDS_INIT_FONTS is set SDL_ttf starts with the first font added.
+ *
+ * @param const char *window title.
+ * @param uint32_t window width, or width of the off-screen target when headless.
+ * @param uint32_t window height, or height of the off-screen target when headless.
+ * @param uint32_t level or width that the camera cannot exceed.
+ * @param uint32_t level or height that the camera cannot exceed.
+ * @param const init_config_t * subsystems to start, and their settings.
+ *
+ * @return void.
+ */
+void
+Stds_InitGameWithConfig( const char *window_name, const uint32_t window_width,
+                         const uint32_t window_height, const uint32_t level_width,
+                         const uint32_t level_height, const struct init_config_t *config ) {
 
   /* First, we create an app structure to ensure the function pointers are NULL. */
-  g_app = Stds_CreateApp();
+  g_app             = Stds_CreateApp();
+  g_app.init_config = *config;
+  g_app.is_headless = ( config->subsystems & STDS_INIT_VIDEO ) == 0;
+  Stds_InitSinTable();
 
   Stds_InitSDL( window_name, window_width, window_height, level_width, level_height );
   Stds_InitAudio();
-  Stds_InitFonts();
+
+  if ( config->subsystems & STDS_INIT_FONTS ) {
+    Stds_InitFonts();
+  }
 
   g_app.original_title = window_name;
   g_app.is_running     = true;
@@ -95,18 +179,48 @@ Stds_InitSDL( const char *window_name, const uint32_t window_width, const uint32
 
   SDL_LogDebug( SDL_LOG_CATEGORY_APPLICATION, "Initialization of SDL started." );
 
-  memset( &g_app, 0, sizeof( struct app_t ) );
   g_app.SCREEN_WIDTH  = window_width;
   g_app.SCREEN_HEIGHT = window_height;
   g_app.LEVEL_WIDTH   = level_width;
   g_app.LEVEL_HEIGHT  = level_height;
 
-  /* Initialize SDL and exit if we fail. */
-  if ( SDL_Init( SDL_INIT_EVERYTHING ) < 0 ) {
+  /* Initialize SDL and exit if we fail. Audio starts with the mixer, when it is opened. */
+  const uint32_t flags      = g_app.init_config.subsystems;
+  uint32_t       subsystems = SDL_INIT_TIMER | SDL_INIT_EVENTS;
+
+  if ( flags & STDS_INIT_VIDEO ) {
+    subsystems |= SDL_INIT_VIDEO;
+  }
+
+  if ( flags & STDS_INIT_CONTROLLERS ) {
+    subsystems |= SDL_INIT_JOYSTICK | SDL_INIT_HAPTIC | SDL_INIT_GAMECONTROLLER;
+  }
+
+  if ( SDL_Init( subsystems ) < 0 ) {
     printf( "Could not initialize SDL: %s.\n", SDL_GetError() );
     exit( EXIT_FAILURE );
   }
 
+  if ( g_app.is_headless ) {
+    SDL_LogDebug( SDL_LOG_CATEGORY_APPLICATION, "Creating headless software renderer." );
+
+    g_app.headless_target = SDL_CreateRGBSurfaceWithFormat( 0, ( int32_t ) window_width,
+                                                            ( int32_t ) window_height, 32,
+                                                            SDL_PIXELFORMAT_RGBA8888 );
+    g_app.renderer =
+      g_app.headless_target != NULL ? SDL_CreateSoftwareRenderer( g_app.headless_target ) : NULL;
+    if ( !g_app.renderer ) {
+      printf( "Failed to initialize headless renderer: %s.\n", SDL_GetError() );
+      exit( EXIT_FAILURE );
+    }
+
+    if ( g_app.init_config.image_formats != 0 ) {
+      IMG_Init( g_app.init_config.image_formats );
+    }
+    Stds_SetRandomSeed();
+    return;
+  }
+
   SDL_LogDebug( SDL_LOG_CATEGORY_APPLICATION, "Initializing window." );
 
   /* Initialize the SDL window. */
@@ -130,13 +244,14 @@ Stds_InitSDL( const char *window_name, const uint32_t window_width, const uint32
 
   SDL_LogDebug( SDL_LOG_CATEGORY_APPLICATION, "Initialization Completed." );
 
-  /* Initialize SDL to accept both JPG and PNGs. */
-  IMG_Init( IMG_INIT_PNG | IMG_INIT_JPG );
+  /* Load the image decoders up front; any others load with their first image. */
+  if ( g_app.init_config.image_formats != 0 ) {
+    IMG_Init( g_app.init_config.image_formats );
+  }
 
   /*  Remove cursor. */
   SDL_ShowCursor( true );
 
-  Stds_InitAudioContext();
   Stds_SetRandomSeed();
 }
 
@@ -167,35 +282,15 @@ Stds_Quit( void ) {
 static struct app_t
 Stds_CreateApp( void ) {
   struct app_t app;
-  g_app.texture_tail    = NULL;
+  memset( &app, 0, sizeof( struct app_t ) );
+  app.texture_budget    = STDS_TEXTURE_BUDGET;
   g_app.trail_tail      = NULL;
   g_app.button_tail     = NULL;
-  g_app.font_tail       = NULL;
   g_app.parallax_tail   = NULL;
 
   return app;
 }
 
-/**
- * Initializes the SDL audio context, and allocates the necessary
- * memory for the number of channels allowed by Standards.
- *
- * @param void.
- *
- * @return void.
- */
-static void
-Stds_InitAudioContext( void ) {
-  SDL_LogDebug( SDL_LOG_CATEGORY_APPLICATION, "Initializing audio context and SDL Mixer." );
-
-  if ( Mix_OpenAudio( 44100, AUDIO_S16SYS, 2, 1024 ) == -1 ) {
-    SDL_LogInfo( SDL_LOG_CATEGORY_APPLICATION, "Could not initialize SDL Mixer.\n" );
-    exit( EXIT_FAILURE );
-  }
-
-  Mix_AllocateChannels( MAX_SND_CHANNELS );
-}
-
 /**
  * Cleans up the SDL context and game upon closing the application.
  *
@@ -208,15 +303,30 @@ Stds_Cleanup( void ) {
   g_app.is_running = false;
 
   SDL_LogDebug( SDL_LOG_CATEGORY_APPLICATION, "Cleaning up." );
-  SDL_DestroyRenderer( g_app.renderer );
-  SDL_DestroyWindow( g_app.window );
+
+  /* Stop the input thread, the job workers and the loader first, so no
+     thread is still touching the data freed below. The last telemetry sample
+     goes out while everything it counts is still alive. */
+  Stds_StopInputThread();
+  Stds_StopTelemetry();
+  Stds_JobsDie();
+  Stds_AssetLoaderDie();
+  Stds_AnimationSystemDie();
+  Stds_AudioDie();
+
+  /* Flush the frame a quit event interrupted into the recording. */
+  Stds_StopInputRecording();
+  Stds_StopInputReplay();
+
+  /* Scenes give their texture references back before the cache is freed. */
+  Stds_ClearScenes();
 
   /* Free the memory of the linked lists defined by
      the app struct. */
   struct parallax_background_t *pbg;
-  struct texture_t *            t;
   struct button_t *             b;
   struct trail_t *              tr;
+  struct text_field_t *         tf;
 
   SDL_LogDebug( SDL_LOG_CATEGORY_APPLICATION, "Freeing parallax backgrounds." );
   /* Frees the parallax background linked list. */
@@ -228,19 +338,26 @@ Stds_Cleanup( void ) {
   }
 
   SDL_LogDebug( SDL_LOG_CATEGORY_APPLICATION, "Freeing textures." );
-  /* Frees the texture linked list. */
-  while ( g_app.texture_head.next ) {
-    t                       = g_app.texture_head.next;
-    g_app.texture_head.next = t->next;
-    free( t );
+  /* Frees the texture cache. The textures themselves went with the renderer. */
+  for ( int32_t i = 0; i < g_app.texture_count; i++ ) {
+    free( g_app.textures[i].name );
+  }
+  free( g_app.textures );
+  free( g_app.texture_table );
+  if ( g_app.texture_handles != NULL ) {
+    Stds_HashMapDestroy( g_app.texture_handles );
   }
+  g_app.textures        = NULL;
+  g_app.texture_table   = NULL;
+  g_app.texture_handles = NULL;
+  g_app.texture_count   = 0;
 
   SDL_LogDebug( SDL_LOG_CATEGORY_APPLICATION, "Freeing trails." );
   /* Frees the trail linked list. */
   while ( g_app.trail_head.next ) {
     tr                    = g_app.trail_head.next;
     g_app.trail_head.next = tr->next;
-    free( tr );
+    Stds_TrailDie( tr );
   }
 
   SDL_LogDebug( SDL_LOG_CATEGORY_APPLICATION, "Freeing buttons." );
@@ -248,8 +365,27 @@ Stds_Cleanup( void ) {
   while ( g_app.button_head.next ) {
     b                      = g_app.button_head.next;
     g_app.button_head.next = b->next;
-    free( b );
+    Stds_ButtonDie( b );
+  }
+
+  SDL_LogDebug( SDL_LOG_CATEGORY_APPLICATION, "Freeing text fields." );
+  /* Frees the text field linked list. */
+  while ( g_app.text_field_head.next ) {
+    tf                         = g_app.text_field_head.next;
+    g_app.text_field_head.next = tf->next;
+    Stds_TextFieldDie( tf );
   }
 
+  Stds_CommandBufferDie();
   Stds_FreeFonts();
+
+  /* Fonts open from pack memory, so the packs go after them. */
+  Stds_UnmountPacks();
+
+  /* The renderer goes last: destroying it frees every texture it owns, and the
+     frees above still destroy some of those textures themselves. */
+  SDL_DestroyRenderer( g_app.renderer );
+  Stds_InvalidateRenderState();
+  SDL_DestroyWindow( g_app.window );
+  SDL_FreeSurface( g_app.headless_target );
 }
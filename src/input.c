@@ -15,18 +15,22 @@
  *
  * This file defines input handling events. As of now, it only supports mouse and keyboard,
  * but controller support may come at a later date.
+ *
+ * Events update a per-frame snapshot in g_app.input: key and mouse button bitsets with
+ * the pressed and released edges since the previous frame, and the mouse motion delta.
+ * Polling it costs a bit test. Typed text goes straight to the focused text field, and
+ * the mouse position is read once per frame, so processing is linear in the events.
+ * Events are polled through the input recorder, which may record or replay them.
  */
 #include "../include/input.h"
 
-static int16_t previous_frame_key = -1;
-
-static inline void Stds_UpdateMouseState( void );
+static inline void Stds_BeginInputFrame( void );
 static inline void Stds_KeyPressed( const SDL_Event *event );
 static inline void Stds_KeyReleased( const SDL_KeyboardEvent *event );
 static inline void Stds_MousePressed( const SDL_MouseButtonEvent *event );
 static inline void Stds_MouseReleased( const SDL_MouseButtonEvent *event );
 static inline void Stds_MouseMoved( const SDL_MouseMotionEvent *event );
-static void        Stds_UpdateTextFields( const SDL_Event *event );
+static inline bool Stds_TestKey( const uint64_t *set, const SDL_Scancode key );
 
 /**
  * Starts the SDL event loop.
@@ -38,11 +42,9 @@ static void        Stds_UpdateTextFields( const SDL_Event *event );
 void
 Stds_ProcessInput( void ) {
   SDL_Event event;
-  SDL_StartTextInput();
-
-  while ( SDL_PollEvent( &event ) ) {
-    Stds_UpdateMouseState();
+  Stds_BeginInputFrame();
 
+  while ( Stds_PollInputEvent( &event ) ) {
     switch ( event.type ) {
     case SDL_QUIT:
       SDL_LogDebug( SDL_LOG_CATEGORY_APPLICATION, "Quit event." );
@@ -68,103 +70,236 @@ Stds_ProcessInput( void ) {
       Stds_MouseMoved( &event.motion );
       break;
     case SDL_TEXTINPUT:
-      Stds_UpdateTextFields( &event );
+      if ( g_app.input.focus != NULL ) {
+        Stds_ReadTextField( g_app.input.focus, &event );
+      }
+      break;
+    case SDL_WINDOWEVENT:
+      /* Exposed, resized or restored windows must be drawn again. */
+      g_app.is_redraw_requested = true;
+      break;
+    case SDL_RENDER_TARGETS_RESET:
+    case SDL_RENDER_DEVICE_RESET:
+      /* Cached render targets are blank now; each one rebuilds when it sees
+         the count change. */
+      g_app.target_resets++;
+      g_app.is_redraw_requested = true;
+      Stds_InvalidateRenderState();
       break;
     default:
       break;
     }
   }
+
+  SDL_GetMouseState( &g_app.mouse.x, &g_app.mouse.y );
+  Stds_EndInputFrame();
 }
 
 /**
+ * Returns whether a key is held down.
  *
+ * @param SDL_Scancode key.
  *
- * @param
+ * @return bool true if the key is down.
+ */
+bool
+Stds_IsKeyDown( const SDL_Scancode key ) {
+  return Stds_TestKey( g_app.input.keys, key );
+}
+
+/**
+ * Returns whether a key went down since the previous frame.
  *
- * @param void.
+ * @param SDL_Scancode key.
+ *
+ * @return bool true if the key was pressed this frame.
  */
-static void
-Stds_UpdateTextFields( const SDL_Event *event ) {
-  for ( struct text_field_t *tf = &g_app.text_field_head; tf != NULL; tf = tf->next ) {
-    if ( tf->toggle_text_input ) {
-      SDL_StartTextInput();
-      Stds_ReadTextField( tf, event );
-    } else {
-      SDL_StopTextInput();
-    }
-  }
+bool
+Stds_IsKeyPressed( const SDL_Scancode key ) {
+  return Stds_TestKey( g_app.input.pressed, key );
+}
+
+/**
+ * Returns whether a key came up since the previous frame.
+ *
+ * @param SDL_Scancode key.
+ *
+ * @return bool true if the key was released this frame.
+ */
+bool
+Stds_IsKeyReleased( const SDL_Scancode key ) {
+  return Stds_TestKey( g_app.input.released, key );
 }
 
 /**
+ * Returns whether a mouse button is held down.
+ *
+ * @param uint8_t button, such as SDL_BUTTON_LEFT.
  *
+ * @return bool true if the button is down.
+ */
+bool
+Stds_IsMouseButtonDown( const uint8_t button ) {
+  return button < 32 && ( g_app.input.buttons >> button ) & 1;
+}
+
+/**
+ * Returns whether a mouse button went down since the previous frame.
+ *
+ * @param uint8_t button, such as SDL_BUTTON_LEFT.
+ *
+ * @return bool true if the button was pressed this frame.
+ */
+bool
+Stds_IsMouseButtonPressed( const uint8_t button ) {
+  return button < 32 && ( g_app.input.buttons_pressed >> button ) & 1;
+}
+
+/**
+ * Returns whether a mouse button came up since the previous frame.
+ *
+ * @param uint8_t button, such as SDL_BUTTON_LEFT.
+ *
+ * @return bool true if the button was released this frame.
+ */
+bool
+Stds_IsMouseButtonReleased( const uint8_t button ) {
+  return button < 32 && ( g_app.input.buttons_released >> button ) & 1;
+}
+
+/**
+ * Returns how far the mouse moved since the previous frame.
+ *
+ * @param int32_t * horizontal motion in pixels.
+ * @param int32_t * vertical motion in pixels.
+ *
+ * @return void.
+ */
+void
+Stds_GetMouseDelta( int32_t *dx, int32_t *dy ) {
+  *dx = g_app.input.mouse_dx;
+  *dy = g_app.input.mouse_dy;
+}
+
+/**
+ * Moves the current key set into the previous one and clears the edges
+ * and motion of the last frame.
  *
  * @param void.
  *
  * @return void.
  */
 static inline void
-Stds_UpdateMouseState( void ) {
-  SDL_GetMouseState( &g_app.mouse.x, &g_app.mouse.y );
+Stds_BeginInputFrame( void ) {
+  struct input_t *in = &g_app.input;
+
+  memcpy( in->previous, in->keys, sizeof( in->keys ) );
+  memset( in->pressed, 0, sizeof( in->pressed ) );
+  memset( in->released, 0, sizeof( in->released ) );
+  in->buttons_pressed   = 0;
+  in->buttons_released  = 0;
+  in->mouse_dx          = 0;
+  in->mouse_dy          = 0;
   g_app.mouse.is_moving = false;
 }
 
 /**
+ * Records a key going down. Backspace also erases from the focused text
+ * field, since it produces no text event.
  *
- *
- * @param
+ * @param SDL_Event * keyboard event.
  *
  * @return void.
  */
 static inline void
 Stds_KeyPressed( const SDL_Event *event ) {
-  if ( event->key.repeat == 0 && event->key.keysym.scancode < MAX_KEYBOARD_KEYS ) {
-    g_app.keyboard[event->key.keysym.scancode] = 1;
+  const SDL_Scancode key = event->key.keysym.scancode;
+
+  if ( event->key.repeat == 0 && key < MAX_KEYBOARD_KEYS ) {
+    g_app.keyboard[key] = 1;
+    g_app.input.keys[key >> 6] |= 1ull << ( key & 63 );
+    g_app.input.pressed[key >> 6] |= 1ull << ( key & 63 );
   }
 
   /* Special case for backspace. */
-  if ( g_app.keyboard[SDL_SCANCODE_BACKSPACE] ) {
-    Stds_UpdateTextFields( event );
+  if ( g_app.input.focus != NULL && g_app.keyboard[SDL_SCANCODE_BACKSPACE] ) {
+    Stds_ReadTextField( g_app.input.focus, event );
   }
 }
 
 /**
+ * Records a key coming up.
  *
- *
- * @param
+ * @param SDL_KeyboardEvent * keyboard event.
  *
  * @return void.
  */
 static inline void
 Stds_KeyReleased( const SDL_KeyboardEvent *event ) {
-  if ( event->repeat == 0 && event->keysym.scancode < MAX_KEYBOARD_KEYS ) {
-    g_app.keyboard[event->keysym.scancode] = 0;
+  const SDL_Scancode key = event->keysym.scancode;
+
+  if ( event->repeat == 0 && key < MAX_KEYBOARD_KEYS ) {
+    g_app.keyboard[key] = 0;
+    g_app.input.keys[key >> 6] &= ~( 1ull << ( key & 63 ) );
+    g_app.input.released[key >> 6] |= 1ull << ( key & 63 );
   }
 }
 
 /**
+ * Records a mouse button going down.
  *
- *
- * @param
+ * @param SDL_MouseButtonEvent * mouse button event.
  *
  * @return void.
  */
 static inline void
 Stds_MousePressed( const SDL_MouseButtonEvent *event ) {
   g_app.mouse.button[event->button] = 1;
+  if ( event->button < 32 ) {
+    g_app.input.buttons |= 1u << event->button;
+    g_app.input.buttons_pressed |= 1u << event->button;
+  }
 }
 
 /**
+ * Records a mouse button coming up.
+ *
+ * @param SDL_MouseButtonEvent * mouse button event.
  *
+ * @return void.
  */
 static inline void
 Stds_MouseReleased( const SDL_MouseButtonEvent *event ) {
   g_app.mouse.button[event->button] = 0;
+  if ( event->button < 32 ) {
+    g_app.input.buttons &= ~( 1u << event->button );
+    g_app.input.buttons_released |= 1u << event->button;
+  }
 }
 
 /**
- * @TODO: Fix this, it does NOT work.
+ * Adds mouse motion to this frame's delta.
+ *
+ * @param SDL_MouseMotionEvent * mouse motion event.
+ *
+ * @return void.
  */
 static inline void
 Stds_MouseMoved( const SDL_MouseMotionEvent *e ) {
   g_app.mouse.is_moving = true;
-}
\ No newline at end of file
+  g_app.input.mouse_dx += e->xrel;
+  g_app.input.mouse_dy += e->yrel;
+}
+
+/**
+ * Tests the bit of a key in a key bitset.
+ *
+ * @param uint64_t * key bitset.
+ * @param SDL_Scancode key.
+ *
+ * @return bool true if the bit is set.
+ */
+static inline bool
+Stds_TestKey( const uint64_t *set, const SDL_Scancode key ) {
+  return key < MAX_KEYBOARD_KEYS && ( set[key >> 6] >> ( key & 63 ) ) & 1;
+}
@@ -0,0 +1,204 @@
+/**
+ * @file input_thread.c
+ * @author Joshua Crotts
+ * @date October 14 2026
+ * @version 1.0
+ *
+ * @section LICENSE
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License as
+ * published by the Free Software Foundation; either version 2 of
+ * the License, or (at your option) any later version.
+ *
+ * @section DESCRIPTION
+ *
+ * This file defines the input thread. While it runs, a high-priority thread pumps
+ * SDL events every STDS_INPUT_POLL_MS, stamps each with the performance counter and
+ * pushes it into a lock-free single-producer, single-consumer ring. The simulation
+ * drains the ring through Stds_PollQueuedEvent each tick, so a main thread blocked
+ * on present or vsync no longer delays when input is read, and
+ * Stds_GetInputEventTime tells when each event actually arrived.
+ *
+ * SDL only lets the thread that created the window pump events on most platforms,
+ * so the thread only starts on the X11, Wayland and KMSDRM video drivers. Elsewhere
+ * Stds_StartInputThread returns false and events are polled on the main thread as
+ * before. When the ring is full, events wait in SDL's own queue; none are dropped.
+ */
+#include "../include/input_thread.h"
+
+static struct input_thread_t input;
+
+static bool    Stds_CanPumpOffThread( void );
+static int32_t Stds_InputThread( void *data );
+
+/**
+ * Starts pumping SDL events on the input thread. Call it after the window
+ * exists and before the game loop starts.
+ *
+ * @param void.
+ *
+ * @return bool true if the thread runs, false if the video driver only
+ *         allows events to be pumped on the main thread.
+ */
+bool
+Stds_StartInputThread( void ) {
+  if ( SDL_AtomicGet( &input.is_running ) ) {
+    return true;
+  }
+
+  if ( !Stds_CanPumpOffThread() ) {
+    SDL_LogInfo( SDL_LOG_CATEGORY_APPLICATION,
+                 "Events cannot be pumped off the main thread; not starting the input thread.\n" );
+    return false;
+  }
+
+  SDL_AtomicSet( &input.is_running, 1 );
+  input.thread = SDL_CreateThread( Stds_InputThread, "stds_input", NULL );
+
+  if ( input.thread == NULL ) {
+    SDL_LogInfo( SDL_LOG_CATEGORY_APPLICATION, "Could not create the input thread. %s.\n",
+                 SDL_GetError() );
+    SDL_AtomicSet( &input.is_running, 0 );
+    return false;
+  }
+
+  return true;
+}
+
+/**
+ * Stops the input thread and waits for it. Events still in the ring are
+ * polled before any new ones from SDL.
+ *
+ * @param void.
+ *
+ * @return void.
+ */
+void
+Stds_StopInputThread( void ) {
+  if ( input.thread == NULL ) {
+    return;
+  }
+
+  SDL_AtomicSet( &input.is_running, 0 );
+  SDL_WaitThread( input.thread, NULL );
+  input.thread = NULL;
+}
+
+/**
+ * Returns whether events are pumped on the input thread.
+ *
+ * @param void.
+ *
+ * @return bool true if the input thread runs.
+ */
+bool
+Stds_IsInputThreadRunning( void ) {
+  return SDL_AtomicGet( &input.is_running ) != 0;
+}
+
+/**
+ * Takes the next event, from the input thread's ring if it has any, or
+ * else straight from SDL while the thread is not running. Only the
+ * simulation thread may call this.
+ *
+ * @param SDL_Event * receives the event.
+ *
+ * @return int32_t 1 if an event was taken, 0 if there are none.
+ */
+int32_t
+Stds_PollQueuedEvent( SDL_Event *event ) {
+  struct input_ring_t *ring = &input.ring;
+  const uint32_t       tail = ( uint32_t ) SDL_AtomicGet( &ring->tail );
+  const uint32_t       head = ( uint32_t ) SDL_AtomicGet( &ring->head );
+
+  if ( tail != head ) {
+    /* Read the slot only after seeing the head that published it. */
+    SDL_MemoryBarrierAcquire();
+    const struct input_event_t *slot = &ring->events[tail & ( STDS_INPUT_RING_SIZE - 1 )];
+    *event                           = slot->event;
+    input.last_time                  = slot->time;
+
+    /* Finish the read before the producer may reuse the slot. */
+    SDL_MemoryBarrierRelease();
+    SDL_AtomicSet( &ring->tail, ( int32_t ) ( tail + 1 ) );
+    return 1;
+  }
+
+  if ( SDL_AtomicGet( &input.is_running ) || SDL_PollEvent( event ) == 0 ) {
+    return 0;
+  }
+
+  input.last_time = SDL_GetPerformanceCounter();
+  return 1;
+}
+
+/**
+ * Returns when the event polled last reached the game, in performance
+ * counter ticks. With the input thread this is when the thread took it
+ * from SDL, not when the simulation polled it.
+ *
+ * @param void.
+ *
+ * @return uint64_t performance counter value.
+ */
+uint64_t
+Stds_GetInputEventTime( void ) {
+  return input.last_time;
+}
+
+/**
+ * Returns whether the video driver lets a thread other than the one that
+ * created the window pump events.
+ *
+ * @param void.
+ *
+ * @return bool true if the input thread may pump events.
+ */
+static bool
+Stds_CanPumpOffThread( void ) {
+  const char *driver = SDL_GetCurrentVideoDriver();
+
+  return driver != NULL
+         && ( strcmp( driver, "x11" ) == 0 || strcmp( driver, "wayland" ) == 0
+              || strcmp( driver, "KMSDRM" ) == 0 );
+}
+
+/**
+ * Input thread. Pumps SDL events and moves them into the ring while there
+ * is room, publishing each one as soon as it is stamped.
+ *
+ * @param void * unused.
+ *
+ * @return int32_t 0.
+ */
+static int32_t
+Stds_InputThread( void *data ) {
+  struct input_ring_t *ring = &input.ring;
+  uint32_t             head = ( uint32_t ) SDL_AtomicGet( &ring->head );
+  ( void ) data;
+
+  SDL_SetThreadPriority( SDL_THREAD_PRIORITY_HIGH );
+
+  while ( SDL_AtomicGet( &input.is_running ) ) {
+    SDL_PumpEvents();
+
+    while ( head - ( uint32_t ) SDL_AtomicGet( &ring->tail ) < STDS_INPUT_RING_SIZE ) {
+      struct input_event_t *slot = &ring->events[head & ( STDS_INPUT_RING_SIZE - 1 )];
+
+      /* The acquire pairs with the consumer's release of this slot. */
+      SDL_MemoryBarrierAcquire();
+      if ( SDL_PeepEvents( &slot->event, 1, SDL_GETEVENT, SDL_FIRSTEVENT, SDL_LASTEVENT ) < 1 ) {
+        break;
+      }
+
+      slot->time = SDL_GetPerformanceCounter();
+      SDL_MemoryBarrierRelease();
+      SDL_AtomicSet( &ring->head, ( int32_t ) ++head );
+    }
+
+    SDL_Delay( STDS_INPUT_POLL_MS );
+  }
+
+  return 0;
+}
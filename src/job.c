@@ -0,0 +1,496 @@
+/**
+ * @file job.c
+ * @author Joshua Crotts
+ * @date October 14 2026
+ * @version 1.0
+ *
+ * @section LICENSE
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License as
+ * published by the Free Software Foundation; either version 2 of
+ * the License, or (at your option) any later version.
+ *
+ * @section DESCRIPTION
+ *
+ * This file defines the library's job scheduler. Every thread owns a deque;
+ * submitting pushes onto the caller's own deque, and a thread that runs dry
+ * steals the oldest job from another one, so work spreads out without a
+ * shared queue. Completion is tracked with job_counter_t dependency counters,
+ * which can also hold jobs that start once the counter reaches zero. Jobs
+ * submitted without a counter belong to the frame: the game loop waits for
+ * all of them after the update delegate returns, so update may fan work out
+ * while draw only ever sees finished results. Waiting threads run jobs
+ * instead of blocking. Jobs must not touch the renderer.
+ */
+#include "../include/job.h"
+
+static struct job_system_t  jobs;
+static struct job_counter_t frame_counter;
+
+static int32_t Stds_JobThread( void *data );
+static int32_t Stds_JobThreadSlot( void );
+static void    Stds_JobPush( const struct job_t *job );
+static bool    Stds_JobPop( const int32_t slot, struct job_t *job );
+static bool    Stds_JobSteal( const int32_t slot, struct job_t *job );
+static bool    Stds_JobRunOne( const int32_t slot );
+static void    Stds_JobRun( const struct job_t *job );
+static void    Stds_JobFinish( struct job_counter_t *counter );
+
+/**
+ * Starts the job workers. Calling this is optional; the first submit starts
+ * the scheduler with one worker per CPU core minus one, since the main thread
+ * also runs jobs while it waits. With no workers at all, jobs run on whichever
+ * thread waits for them.
+ *
+ * @param int32_t number of worker threads, or 0 for the default.
+ *
+ * @return void.
+ */
+void
+Stds_InitJobs( int32_t thread_count ) {
+  if ( SDL_AtomicGet( &jobs.is_running ) ) {
+    return;
+  }
+
+  if ( thread_count <= 0 ) {
+    thread_count = SDL_GetCPUCount() - 1;
+    thread_count = thread_count > 0 ? thread_count : 0;
+  }
+
+  jobs.deque_count = thread_count + 1;
+  jobs.deques      = calloc( ( size_t ) jobs.deque_count, sizeof( struct job_deque_t ) );
+
+  if ( jobs.deques == NULL ) {
+    SDL_LogInfo( SDL_LOG_CATEGORY_APPLICATION, "Could not allocate memory for job deques. %s.\n",
+                 SDL_GetError() );
+    exit( EXIT_FAILURE );
+  }
+
+  for ( int32_t i = 0; i < jobs.deque_count; i++ ) {
+    jobs.deques[i].jobs = malloc( sizeof( struct job_t ) * STDS_JOB_DEQUE_SIZE );
+
+    if ( jobs.deques[i].jobs == NULL ) {
+      SDL_LogInfo( SDL_LOG_CATEGORY_APPLICATION, "Could not allocate memory for job deque. %s.\n",
+                   SDL_GetError() );
+      exit( EXIT_FAILURE );
+    }
+  }
+
+  jobs.thread_slot = SDL_TLSCreate();
+  jobs.wake        = SDL_CreateSemaphore( 0 );
+  SDL_AtomicSet( &jobs.queued, 0 );
+  SDL_AtomicSet( &jobs.sleepers, 0 );
+  SDL_AtomicSet( &jobs.is_running, 1 );
+
+  if ( thread_count > 0 ) {
+    jobs.threads = malloc( sizeof( SDL_Thread * ) * ( size_t ) thread_count );
+
+    if ( jobs.threads == NULL ) {
+      SDL_LogInfo( SDL_LOG_CATEGORY_APPLICATION, "Could not allocate memory for job threads. %s.\n",
+                   SDL_GetError() );
+      exit( EXIT_FAILURE );
+    }
+
+    /* Worker i owns deque i + 1; the slot is passed as the thread data. */
+    for ( int32_t i = 0; i < thread_count; i++ ) {
+      jobs.threads[i]
+          = SDL_CreateThread( Stds_JobThread, "stds_job", ( void * ) ( intptr_t )( i + 1 ) );
+
+      if ( jobs.threads[i] == NULL ) {
+        SDL_LogInfo( SDL_LOG_CATEGORY_APPLICATION, "Could not create job thread. %s.\n",
+                     SDL_GetError() );
+        break;
+      }
+
+      jobs.thread_count++;
+    }
+  }
+}
+
+/**
+ * Queues fn( data, 0 ) to run on any thread.
+ *
+ * @param void (*)(void *, int32_t) job function.
+ * @param void * data passed to the job.
+ * @param job_counter_t * counter to signal when done, or NULL for the frame.
+ *
+ * @return void.
+ */
+void
+Stds_JobSubmit( void ( *fn )( void *, int32_t ), void *data, struct job_counter_t *counter ) {
+  Stds_JobParallelFor( fn, data, 1, 1, counter );
+}
+
+/**
+ * Queues fn( data, 0 ) to run once every job of dependency has finished. The
+ * job already counts towards counter while it waits, so waiting on counter
+ * also covers the dependency, which therefore must be a different counter. If
+ * dependency is NULL or already done, this is the same as Stds_JobSubmit.
+ *
+ * @param job_counter_t * counter that must reach zero first.
+ * @param void (*)(void *, int32_t) job function.
+ * @param void * data passed to the job.
+ * @param job_counter_t * counter to signal when done, or NULL for the frame.
+ *
+ * @return void.
+ */
+void
+Stds_JobSubmitAfter( struct job_counter_t *dependency, void ( *fn )( void *, int32_t ), void *data,
+                     struct job_counter_t *counter ) {
+  struct job_t job;
+
+  Stds_InitJobs( 0 );
+
+  job.fn      = fn;
+  job.data    = data;
+  job.begin   = 0;
+  job.end     = 1;
+  job.counter = counter != NULL ? counter : &frame_counter;
+  SDL_AtomicIncRef( &job.counter->pending );
+
+  if ( dependency == NULL ) {
+    Stds_JobPush( &job );
+    return;
+  }
+
+  SDL_AtomicLock( &dependency->lock );
+  if ( SDL_AtomicGet( &dependency->pending ) > 0
+       && dependency->continuation_count < STDS_JOB_MAX_CONTINUATIONS ) {
+    dependency->continuations[dependency->continuation_count++] = job;
+    SDL_AtomicUnlock( &dependency->lock );
+    return;
+  }
+  SDL_AtomicUnlock( &dependency->lock );
+
+  /* Either nothing left to wait for, or no room to park the job: finish the
+     dependency here and push the job directly. */
+  Stds_JobWait( dependency );
+  Stds_JobPush( &job );
+}
+
+/**
+ * Runs fn( data, i ) for every i in [0, count), split into chunks of grain
+ * indices that run on any thread. Returns immediately; wait on counter for
+ * the results. A grain of 0 or less picks one that gives every thread a few
+ * chunks.
+ *
+ * @param void (*)(void *, int32_t) job function.
+ * @param void * data passed to every call.
+ * @param int32_t number of indices.
+ * @param int32_t indices per chunk, or 0 to choose.
+ * @param job_counter_t * counter to signal when done, or NULL for the frame.
+ *
+ * @return void.
+ */
+void
+Stds_JobParallelFor( void ( *fn )( void *, int32_t ), void *data, const int32_t count,
+                     int32_t grain, struct job_counter_t *counter ) {
+  struct job_t job;
+
+  if ( count <= 0 ) {
+    return;
+  }
+
+  Stds_InitJobs( 0 );
+
+  if ( grain <= 0 ) {
+    grain = count / ( STDS_JOB_SPLIT * jobs.deque_count );
+    grain = grain > 0 ? grain : 1;
+  }
+
+  job.fn      = fn;
+  job.data    = data;
+  job.counter = counter != NULL ? counter : &frame_counter;
+  SDL_AtomicAdd( &job.counter->pending, ( count + grain - 1 ) / grain );
+
+  for ( int32_t begin = 0; begin < count; begin += grain ) {
+    job.begin = begin;
+    job.end   = count - begin > grain ? begin + grain : count;
+    Stds_JobPush( &job );
+  }
+}
+
+/**
+ * Returns whether every job counted by counter has finished.
+ *
+ * @param job_counter_t * counter, or NULL for the frame.
+ *
+ * @return bool true when nothing is pending.
+ */
+bool
+Stds_IsJobDone( struct job_counter_t *counter ) {
+  return SDL_AtomicGet( counter != NULL ? &counter->pending : &frame_counter.pending ) == 0;
+}
+
+/**
+ * Blocks until every job counted by counter has finished, running queued jobs
+ * on the calling thread in the meantime. Safe to call from inside a job.
+ *
+ * @param job_counter_t * counter, or NULL for every job of the frame.
+ *
+ * @return void.
+ */
+void
+Stds_JobWait( struct job_counter_t *counter ) {
+  if ( counter == NULL ) {
+    counter = &frame_counter;
+  }
+
+  if ( !SDL_AtomicGet( &jobs.is_running ) ) {
+    return;
+  }
+
+  int32_t slot = Stds_JobThreadSlot();
+  while ( SDL_AtomicGet( &counter->pending ) > 0 ) {
+    if ( !Stds_JobRunOne( slot ) ) {
+      SDL_Delay( 0 );
+    }
+  }
+
+  /* The last job may still hold the lock it dropped pending under; take it
+     once so the counter is free to reuse, or to leave scope, on return. */
+  SDL_AtomicLock( &counter->lock );
+  SDL_AtomicUnlock( &counter->lock );
+}
+
+/**
+ * Returns the number of job worker threads, not counting the main thread.
+ *
+ * @param void.
+ *
+ * @return int32_t worker count, 0 if the scheduler has not started.
+ */
+int32_t
+Stds_GetJobThreadCount( void ) {
+  return jobs.thread_count;
+}
+
+/**
+ * Stops and joins the job workers, runs whatever is still queued on the
+ * calling thread, and frees the scheduler.
+ *
+ * @param void.
+ *
+ * @return void.
+ */
+void
+Stds_JobsDie( void ) {
+  if ( !SDL_AtomicGet( &jobs.is_running ) ) {
+    return;
+  }
+
+  SDL_AtomicSet( &jobs.is_running, 0 );
+  for ( int32_t i = 0; i < jobs.thread_count; i++ ) {
+    SDL_SemPost( jobs.wake );
+  }
+
+  for ( int32_t i = 0; i < jobs.thread_count; i++ ) {
+    SDL_WaitThread( jobs.threads[i], NULL );
+  }
+
+  /* Drain what is left so no counter stays pending forever. */
+  while ( Stds_JobRunOne( 0 ) ) {
+  }
+
+  for ( int32_t i = 0; i < jobs.deque_count; i++ ) {
+    free( jobs.deques[i].jobs );
+  }
+
+  SDL_DestroySemaphore( jobs.wake );
+  free( jobs.deques );
+  free( jobs.threads );
+  memset( &jobs, 0, sizeof( struct job_system_t ) );
+  memset( &frame_counter, 0, sizeof( struct job_counter_t ) );
+}
+
+/**
+ * Body of every job worker: runs jobs from its own deque, steals when that is
+ * empty, and sleeps on the wake semaphore once there is nothing left anywhere.
+ *
+ * @param void * deque slot of this worker.
+ *
+ * @return int32_t 0.
+ */
+static int32_t
+Stds_JobThread( void *data ) {
+  int32_t slot = ( int32_t ) ( intptr_t ) data;
+  SDL_TLSSet( jobs.thread_slot, data, NULL );
+
+  while ( SDL_AtomicGet( &jobs.is_running ) ) {
+    if ( Stds_JobRunOne( slot ) ) {
+      continue;
+    }
+
+    /* Announce the sleep before the last look at the queue, so a push that
+       lands in between sees the sleeper and posts. */
+    SDL_AtomicIncRef( &jobs.sleepers );
+    if ( SDL_AtomicGet( &jobs.queued ) <= 0 && SDL_AtomicGet( &jobs.is_running ) ) {
+      SDL_SemWaitTimeout( jobs.wake, STDS_JOB_IDLE_MS );
+    }
+    SDL_AtomicDecRef( &jobs.sleepers );
+  }
+
+  return 0;
+}
+
+/**
+ * Returns the deque slot of the calling thread: its worker slot for job
+ * threads, 0 for the main thread and any other thread.
+ *
+ * @param void.
+ *
+ * @return int32_t slot.
+ */
+static int32_t
+Stds_JobThreadSlot( void ) {
+  return ( int32_t ) ( intptr_t ) SDL_TLSGet( jobs.thread_slot );
+}
+
+/**
+ * Pushes a job onto the calling thread's deque and wakes a sleeping worker.
+ * A full deque runs the job right away instead.
+ *
+ * @param const job_t * job to copy in.
+ *
+ * @return void.
+ */
+static void
+Stds_JobPush( const struct job_t *job ) {
+  struct job_deque_t *deque = &jobs.deques[Stds_JobThreadSlot()];
+
+  SDL_AtomicLock( &deque->lock );
+  if ( deque->bottom - deque->top >= STDS_JOB_DEQUE_SIZE ) {
+    SDL_AtomicUnlock( &deque->lock );
+    Stds_JobRun( job );
+    return;
+  }
+
+  deque->jobs[deque->bottom & ( STDS_JOB_DEQUE_SIZE - 1 )] = *job;
+  deque->bottom++;
+  SDL_AtomicUnlock( &deque->lock );
+
+  SDL_AtomicIncRef( &jobs.queued );
+  if ( SDL_AtomicGet( &jobs.sleepers ) > 0 ) {
+    SDL_SemPost( jobs.wake );
+  }
+}
+
+/**
+ * Takes the newest job from a thread's own deque.
+ *
+ * @param int32_t slot of the owning thread.
+ * @param job_t * receives the job.
+ *
+ * @return bool true if a job was taken.
+ */
+static bool
+Stds_JobPop( const int32_t slot, struct job_t *job ) {
+  struct job_deque_t *deque = &jobs.deques[slot];
+  bool                found = false;
+
+  SDL_AtomicLock( &deque->lock );
+  if ( deque->bottom != deque->top ) {
+    deque->bottom--;
+    *job  = deque->jobs[deque->bottom & ( STDS_JOB_DEQUE_SIZE - 1 )];
+    found = true;
+  }
+  SDL_AtomicUnlock( &deque->lock );
+
+  return found;
+}
+
+/**
+ * Takes the oldest job from some other thread's deque, trying each in turn
+ * starting after slot. Old jobs tend to be the big unsplit ones, and taking
+ * from the far end keeps thieves away from the owner.
+ *
+ * @param int32_t slot of the stealing thread.
+ * @param job_t * receives the job.
+ *
+ * @return bool true if a job was stolen.
+ */
+static bool
+Stds_JobSteal( const int32_t slot, struct job_t *job ) {
+  for ( int32_t i = 1; i < jobs.deque_count; i++ ) {
+    struct job_deque_t *deque = &jobs.deques[( slot + i ) % jobs.deque_count];
+
+    /* A busy deque is skipped rather than waited on; its owner is active. */
+    if ( !SDL_AtomicTryLock( &deque->lock ) ) {
+      continue;
+    }
+
+    if ( deque->bottom != deque->top ) {
+      *job = deque->jobs[deque->top & ( STDS_JOB_DEQUE_SIZE - 1 )];
+      deque->top++;
+      SDL_AtomicUnlock( &deque->lock );
+      return true;
+    }
+    SDL_AtomicUnlock( &deque->lock );
+  }
+
+  return false;
+}
+
+/**
+ * Runs one job from the thread's own deque, or a stolen one.
+ *
+ * @param int32_t slot of the calling thread.
+ *
+ * @return bool true if a job ran.
+ */
+static bool
+Stds_JobRunOne( const int32_t slot ) {
+  struct job_t job;
+
+  if ( !Stds_JobPop( slot, &job ) && !Stds_JobSteal( slot, &job ) ) {
+    return false;
+  }
+
+  SDL_AtomicAdd( &jobs.queued, -1 );
+  Stds_JobRun( &job );
+  return true;
+}
+
+/**
+ * Calls the job function over its index range and signals its counter.
+ *
+ * @param const job_t * job.
+ *
+ * @return void.
+ */
+static void
+Stds_JobRun( const struct job_t *job ) {
+  for ( int32_t i = job->begin; i < job->end; i++ ) {
+    job->fn( job->data, i );
+  }
+
+  Stds_JobFinish( job->counter );
+}
+
+/**
+ * Decrements a counter and, when it reaches zero, queues the jobs that were
+ * waiting on it.
+ *
+ * @param job_counter_t * counter.
+ *
+ * @return void.
+ */
+static void
+Stds_JobFinish( struct job_counter_t *counter ) {
+  struct job_t continuations[STDS_JOB_MAX_CONTINUATIONS];
+  int32_t      continuation_count = 0;
+
+  SDL_AtomicLock( &counter->lock );
+  if ( SDL_AtomicDecRef( &counter->pending ) ) {
+    continuation_count = counter->continuation_count;
+    memcpy( continuations, counter->continuations,
+            sizeof( struct job_t ) * ( size_t ) continuation_count );
+    counter->continuation_count = 0;
+  }
+  SDL_AtomicUnlock( &counter->lock );
+
+  for ( int32_t i = 0; i < continuation_count; i++ ) {
+    Stds_JobPush( &continuations[i] );
+  }
+}
@@ -0,0 +1,540 @@
+/**
+ * @file loader.c
+ * @author Joshua Crotts
+ * @date October 14 2026
+ * @version 1.0
+ *
+ * @section LICENSE
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License as
+ * published by the Free Software Foundation; either version 2 of
+ * the License, or (at your option) any later version.
+ *
+ * @section DESCRIPTION
+ *
+ * This file defines the asynchronous asset loader. Worker threads do the disk I/O
+ * and decoding: images with IMG_Load to surfaces, sound effects with Mix_LoadWAV_RW
+ * from memory, music with Mix_LoadMUS, and fonts as raw file contents. The parts
+ * that must happen on the main thread, the texture upload and the font open, run in
+ * Stds_UpdateAssetLoader within a time budget; the game loop calls it once per frame
+ * with STDS_LOADER_BUDGET_MS. Every request returns a handle that can be polled with
+ * Stds_GetAssetState or waited on with Stds_WaitForAsset. Files in a mounted pack
+ * are read from the pack.
+ */
+#include "../include/loader.h"
+#include "../include/draw.h"
+#include "../include/pack.h"
+#include "../include/sound.h"
+#include "../include/text.h"
+
+static struct asset_loader_t loader;
+
+static int32_t Stds_QueueAsset( const char *path, const int32_t type, const int32_t param );
+static void    Stds_DecodeAsset( struct asset_request_t *request );
+static void    Stds_PushDecoded( const int32_t index );
+static void    Stds_FinishAsset( struct asset_request_t *request );
+static int32_t Stds_LoaderThread( void *data );
+
+/**
+ * Starts the loader's worker threads. Calling this is optional; the first
+ * asynchronous load starts the loader with STDS_LOADER_THREADS threads.
+ *
+ * @param int32_t number of worker threads, or 0 for STDS_LOADER_THREADS.
+ *
+ * @return void.
+ */
+void
+Stds_InitAssetLoader( int32_t thread_count ) {
+  if ( loader.is_running ) {
+    return;
+  }
+
+  if ( thread_count <= 0 ) {
+    thread_count = STDS_LOADER_THREADS;
+  }
+
+  loader.lock         = SDL_CreateMutex();
+  loader.work_cond    = SDL_CreateCond();
+  loader.decoded_cond = SDL_CreateCond();
+  loader.pending_head = loader.pending_tail = -1;
+  loader.decoded_head = loader.decoded_tail = -1;
+  loader.is_running                         = true;
+  loader.threads = malloc( sizeof( SDL_Thread * ) * ( size_t ) thread_count );
+
+  if ( loader.threads == NULL ) {
+    SDL_LogInfo( SDL_LOG_CATEGORY_APPLICATION,
+                 "Could not allocate memory for loader threads. %s.\n", SDL_GetError() );
+    exit( EXIT_FAILURE );
+  }
+
+  for ( int32_t i = 0; i < thread_count; i++ ) {
+    loader.threads[i] = SDL_CreateThread( Stds_LoaderThread, "stds_loader", NULL );
+
+    if ( loader.threads[i] == NULL ) {
+      SDL_LogInfo( SDL_LOG_CATEGORY_APPLICATION, "Could not create loader thread. %s.\n",
+                   SDL_GetError() );
+      break;
+    }
+
+    loader.thread_count++;
+  }
+}
+
+/**
+ * Queues an image to be decoded in the background and uploaded into the
+ * texture cache. Once ready, Stds_LoadTexture with the same path returns it
+ * without touching the disk.
+ *
+ * @param const char * path to image.
+ *
+ * @return int32_t handle of the request.
+ */
+int32_t
+Stds_LoadTextureAsync( const char *file_name ) {
+  return Stds_QueueAsset( file_name, STDS_ASSET_TEXTURE, 0 );
+}
+
+/**
+ * Queues a sound effect to be decoded in the background and stored under id,
+ * like Stds_LoadSFX. The mixer opens first, since decoding needs its format;
+ * without audio, the request fails.
+ *
+ * @param const char * sound effect path.
+ * @param int16_t sound effect ID.
+ *
+ * @return int32_t handle of the request.
+ */
+int32_t
+Stds_LoadSFXAsync( const char *path, const int16_t id ) {
+  Stds_OpenAudio();
+  return Stds_QueueAsset( path, STDS_ASSET_SFX, id );
+}
+
+/**
+ * Queues a music file to be opened in the background. When ready, it
+ * replaces the current music, like Stds_LoadMusic.
+ *
+ * @param const char * path of music file.
+ *
+ * @return int32_t handle of the request.
+ */
+int32_t
+Stds_LoadMusicAsync( const char *file_name ) {
+  Stds_OpenAudio();
+  return Stds_QueueAsset( file_name, STDS_ASSET_MUSIC, 0 );
+}
+
+/**
+ * Queues a font file to be read in the background. When ready, the font is
+ * added like Stds_AddFont.
+ *
+ * @param const char * font path.
+ * @param uint16_t font size.
+ *
+ * @return int32_t handle of the request.
+ */
+int32_t
+Stds_AddFontAsync( const char *font_file, const uint16_t size ) {
+  return Stds_QueueAsset( font_file, STDS_ASSET_FONT, size );
+}
+
+/**
+ * Returns the state of a request: STDS_ASSET_PENDING or STDS_ASSET_DECODED
+ * while in flight, then STDS_ASSET_READY or STDS_ASSET_FAILED.
+ *
+ * @param int32_t handle of the request.
+ *
+ * @return int32_t state, or STDS_ASSET_FAILED for an invalid handle.
+ */
+int32_t
+Stds_GetAssetState( const int32_t handle ) {
+  if ( handle < 0 || handle >= loader.count ) {
+    return STDS_ASSET_FAILED;
+  }
+
+  return SDL_AtomicGet( &loader.requests[handle]->state );
+}
+
+/**
+ * Blocks until a request is ready or has failed, finishing decoded assets
+ * on the way. Must be called from the main thread.
+ *
+ * @param int32_t handle of the request.
+ *
+ * @return int32_t STDS_ASSET_READY or STDS_ASSET_FAILED.
+ */
+int32_t
+Stds_WaitForAsset( const int32_t handle ) {
+  int32_t state;
+
+  while ( ( state = Stds_GetAssetState( handle ) ) < STDS_ASSET_READY ) {
+    SDL_LockMutex( loader.lock );
+    while ( loader.decoded_head == -1 ) {
+      SDL_CondWait( loader.decoded_cond, loader.lock );
+    }
+    SDL_UnlockMutex( loader.lock );
+
+    Stds_UpdateAssetLoader( 0 );
+  }
+
+  return state;
+}
+
+/**
+ * Returns the texture loaded by a Stds_LoadTextureAsync request.
+ *
+ * @param int32_t handle of the request.
+ *
+ * @return SDL_Texture * the texture, or NULL if it is not ready.
+ */
+SDL_Texture *
+Stds_GetAssetTexture( const int32_t handle ) {
+  if ( Stds_GetAssetState( handle ) != STDS_ASSET_READY ||
+       loader.requests[handle]->type != STDS_ASSET_TEXTURE ) {
+    return NULL;
+  }
+
+  return Stds_TextureFromHandle( loader.requests[handle]->texture_handle );
+}
+
+/**
+ * Returns the texture cache handle of a finished Stds_LoadTextureAsync
+ * request, for Stds_RetainTextureHandle and Stds_TextureFromHandle.
+ *
+ * @param int32_t handle of the request.
+ *
+ * @return int32_t texture handle, or -1 if the request is not a ready texture.
+ */
+int32_t
+Stds_GetAssetTextureHandle( const int32_t handle ) {
+  if ( Stds_GetAssetState( handle ) != STDS_ASSET_READY ||
+       loader.requests[handle]->type != STDS_ASSET_TEXTURE ) {
+    return -1;
+  }
+
+  return loader.requests[handle]->texture_handle;
+}
+
+/**
+ * Finishes decoded requests on the main thread until budget_ms milliseconds
+ * have passed. At least one request is finished per call, so a budget of 0
+ * still makes progress.
+ *
+ * @param float time budget in milliseconds.
+ *
+ * @return void.
+ */
+void
+Stds_UpdateAssetLoader( const float budget_ms ) {
+  if ( !loader.is_running ) {
+    return;
+  }
+
+  const uint64_t start  = SDL_GetPerformanceCounter();
+  const uint64_t budget = ( uint64_t ) ( budget_ms * SDL_GetPerformanceFrequency() / 1000.0 );
+
+  do {
+    SDL_LockMutex( loader.lock );
+    int32_t index = loader.decoded_head;
+    if ( index != -1 ) {
+      loader.decoded_head = loader.requests[index]->next;
+      if ( loader.decoded_head == -1 ) {
+        loader.decoded_tail = -1;
+      }
+    }
+    struct asset_request_t *request = index != -1 ? loader.requests[index] : NULL;
+    SDL_UnlockMutex( loader.lock );
+
+    if ( request == NULL ) {
+      return;
+    }
+
+    Stds_FinishAsset( request );
+  } while ( SDL_GetPerformanceCounter() - start < budget );
+}
+
+/**
+ * Stops and joins the worker threads and frees every request. Decoded
+ * assets that were never finished are released.
+ *
+ * @param void.
+ *
+ * @return void.
+ */
+void
+Stds_AssetLoaderDie( void ) {
+  if ( !loader.is_running ) {
+    return;
+  }
+
+  SDL_LockMutex( loader.lock );
+  loader.is_running = false;
+  SDL_CondBroadcast( loader.work_cond );
+  SDL_UnlockMutex( loader.lock );
+
+  for ( int32_t i = 0; i < loader.thread_count; i++ ) {
+    SDL_WaitThread( loader.threads[i], NULL );
+  }
+
+  for ( int32_t i = 0; i < loader.count; i++ ) {
+    struct asset_request_t *r = loader.requests[i];
+
+    if ( SDL_AtomicGet( &r->state ) == STDS_ASSET_DECODED ) {
+      SDL_FreeSurface( r->surface );
+      if ( r->chunk != NULL ) {
+        Mix_FreeChunk( r->chunk );
+      }
+      if ( r->music != NULL ) {
+        Mix_FreeMusic( r->music );
+      }
+      SDL_free( r->data );
+    }
+
+    free( r );
+  }
+
+  SDL_DestroyCond( loader.work_cond );
+  SDL_DestroyCond( loader.decoded_cond );
+  SDL_DestroyMutex( loader.lock );
+  free( loader.threads );
+  free( loader.requests );
+  memset( &loader, 0, sizeof( struct asset_loader_t ) );
+}
+
+/**
+ * Creates a request and appends it to the pending queue.
+ *
+ * @param const char * path of the asset.
+ * @param int32_t STDS_ASSET_TEXTURE, _SFX, _MUSIC or _FONT.
+ * @param int32_t SFX id or font size.
+ *
+ * @return int32_t handle of the request.
+ */
+static int32_t
+Stds_QueueAsset( const char *path, const int32_t type, const int32_t param ) {
+  struct asset_request_t *request;
+
+  Stds_InitAssetLoader( 0 );
+  request = malloc( sizeof( struct asset_request_t ) );
+
+  if ( request == NULL ) {
+    SDL_LogInfo( SDL_LOG_CATEGORY_APPLICATION,
+                 "Could not allocate memory for asset_request_t. %s.\n", SDL_GetError() );
+    exit( EXIT_FAILURE );
+  }
+
+  memset( request, 0, sizeof( struct asset_request_t ) );
+  strncpy( request->path, path, LARGE_TEXT_BUFFER - 1 );
+  request->type           = type;
+  request->param          = param;
+  request->texture_handle = -1;
+  request->next           = -1;
+  SDL_AtomicSet( &request->state, STDS_ASSET_PENDING );
+
+  SDL_LockMutex( loader.lock );
+  if ( loader.count == loader.capacity ) {
+    int32_t                  capacity = loader.capacity == 0 ? 32 : loader.capacity * 2;
+    struct asset_request_t **requests =
+      realloc( loader.requests, sizeof( struct asset_request_t * ) * ( size_t ) capacity );
+
+    if ( requests == NULL ) {
+      SDL_LogInfo( SDL_LOG_CATEGORY_APPLICATION,
+                   "Could not allocate memory for asset requests. %s.\n", SDL_GetError() );
+      exit( EXIT_FAILURE );
+    }
+
+    loader.requests = requests;
+    loader.capacity = capacity;
+  }
+
+  int32_t handle          = loader.count++;
+  loader.requests[handle] = request;
+
+  /* No worker could be started: decode here so waiting still works. */
+  if ( loader.thread_count == 0 ) {
+    SDL_UnlockMutex( loader.lock );
+    Stds_DecodeAsset( request );
+    Stds_PushDecoded( handle );
+    return handle;
+  }
+
+  if ( loader.pending_tail == -1 ) {
+    loader.pending_head = handle;
+  } else {
+    loader.requests[loader.pending_tail]->next = handle;
+  }
+  loader.pending_tail = handle;
+
+  SDL_CondSignal( loader.work_cond );
+  SDL_UnlockMutex( loader.lock );
+
+  return handle;
+}
+
+/**
+ * Does the main-thread part of a decoded request: uploads textures, installs
+ * sounds and music, and opens fonts.
+ *
+ * @param asset_request_t * decoded request.
+ *
+ * @return void.
+ */
+static void
+Stds_FinishAsset( struct asset_request_t *request ) {
+  bool is_ready = false;
+
+  switch ( request->type ) {
+  case STDS_ASSET_TEXTURE:
+    if ( request->surface != NULL ) {
+      request->texture_handle = Stds_TextureHandleFromSurface( request->path, request->surface );
+      is_ready                = request->texture_handle != -1;
+      SDL_FreeSurface( request->surface );
+      request->surface = NULL;
+    }
+    break;
+  case STDS_ASSET_SFX:
+    if ( request->chunk != NULL && g_app.sounds[request->param] != NULL ) {
+      SDL_LogInfo( SDL_LOG_CATEGORY_APPLICATION,
+                   "Could not add %s audio file to id %d. This id already exists!\n", request->path,
+                   request->param );
+      Mix_FreeChunk( request->chunk );
+    } else if ( request->chunk != NULL ) {
+      g_app.sounds[request->param] = request->chunk;
+      is_ready                     = true;
+    }
+    request->chunk = NULL;
+    break;
+  case STDS_ASSET_MUSIC:
+    if ( request->music != NULL ) {
+      if ( g_app.music != NULL ) {
+        Mix_HaltMusic();
+        Mix_FreeMusic( g_app.music );
+      }
+      g_app.music    = request->music;
+      request->music = NULL;
+      is_ready       = true;
+    }
+    break;
+  case STDS_ASSET_FONT:
+    if ( request->data != NULL ) {
+      Stds_AddFontFromMemory( request->path, ( uint16_t ) request->param, request->data,
+                              request->data_size );
+      request->data = NULL;
+      is_ready      = true;
+    }
+    break;
+  }
+
+  if ( !is_ready ) {
+    SDL_LogInfo( SDL_LOG_CATEGORY_APPLICATION, "Could not load %s asynchronously.\n",
+                 request->path );
+  }
+
+  SDL_AtomicSet( &request->state, is_ready ? STDS_ASSET_READY : STDS_ASSET_FAILED );
+}
+
+/**
+ * Body of every loader thread: takes pending requests, decodes them, and
+ * moves them to the decoded queue.
+ *
+ * @param void * unused.
+ *
+ * @return int32_t 0.
+ */
+static int32_t
+Stds_LoaderThread( void *data ) {
+  ( void ) data;
+
+  SDL_LockMutex( loader.lock );
+  while ( true ) {
+    while ( loader.is_running && loader.pending_head == -1 ) {
+      SDL_CondWait( loader.work_cond, loader.lock );
+    }
+
+    if ( !loader.is_running ) {
+      break;
+    }
+
+    int32_t                 index   = loader.pending_head;
+    struct asset_request_t *request = loader.requests[index];
+    loader.pending_head             = request->next;
+    if ( loader.pending_head == -1 ) {
+      loader.pending_tail = -1;
+    }
+    request->next = -1;
+    SDL_UnlockMutex( loader.lock );
+
+    Stds_DecodeAsset( request );
+    Stds_PushDecoded( index );
+
+    SDL_LockMutex( loader.lock );
+  }
+  SDL_UnlockMutex( loader.lock );
+
+  return 0;
+}
+
+/**
+ * Does the off-thread part of a request: reads and decodes the file without
+ * touching the renderer.
+ *
+ * @param asset_request_t * pending request.
+ *
+ * @return void.
+ */
+static void
+Stds_DecodeAsset( struct asset_request_t *request ) {
+  SDL_RWops *rw = request->type != STDS_ASSET_TEXTURE ? Stds_OpenPackRW( request->path ) : NULL;
+
+  switch ( request->type ) {
+  case STDS_ASSET_TEXTURE:
+    request->surface = Stds_LoadPackSurface( request->path );
+    if ( request->surface == NULL ) {
+      request->surface = IMG_Load( request->path );
+    }
+    break;
+  case STDS_ASSET_SFX:
+    if ( rw != NULL ) {
+      request->chunk = Mix_LoadWAV_RW( rw, 1 );
+      break;
+    }
+    request->data = SDL_LoadFile( request->path, &request->data_size );
+    if ( request->data != NULL ) {
+      request->chunk =
+        Mix_LoadWAV_RW( SDL_RWFromConstMem( request->data, ( int ) request->data_size ), 1 );
+      SDL_free( request->data );
+      request->data = NULL;
+    }
+    break;
+  case STDS_ASSET_MUSIC:
+    request->music = rw != NULL ? Mix_LoadMUS_RW( rw, 1 ) : Mix_LoadMUS( request->path );
+    break;
+  case STDS_ASSET_FONT:
+    request->data = rw != NULL ? SDL_LoadFile_RW( rw, &request->data_size, 1 )
+                               : SDL_LoadFile( request->path, &request->data_size );
+    break;
+  }
+}
+
+/**
+ * Appends a decoded request to the decoded queue and wakes any thread in
+ * Stds_WaitForAsset.
+ *
+ * @param int32_t handle of the request.
+ *
+ * @return void.
+ */
+static void
+Stds_PushDecoded( const int32_t index ) {
+  SDL_LockMutex( loader.lock );
+  if ( loader.decoded_tail == -1 ) {
+    loader.decoded_head = index;
+  } else {
+    loader.requests[loader.decoded_tail]->next = index;
+  }
+  loader.decoded_tail = index;
+  SDL_AtomicSet( &loader.requests[index]->state, STDS_ASSET_DECODED );
+  SDL_CondBroadcast( loader.decoded_cond );
+  SDL_UnlockMutex( loader.lock );
+}
@@ -0,0 +1,342 @@
+/**
+ * @file pack.c
+ * @author Joshua Crotts
+ * @date October 14 2026
+ * @version 1.0
+ *
+ * @section LICENSE
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License as
+ * published by the Free Software Foundation; either version 2 of
+ * the License, or (at your option) any later version.
+ *
+ * @section DESCRIPTION
+ *
+ * This file defines asset packs: one archive holding many resource files, built
+ * offline by tools/pack. A pack is a header, an index of fixed-size entries sorted
+ * by name, and the concatenated blobs; all integers are little-endian.
+ *
+ *   header  "SPAK", version, entry count, reserved                       (16 bytes)
+ *   entry   char name[STDS_PACK_NAME_LEN], offset, size, uint16_t width,
+ *           uint16_t height, type                                       (136 bytes)
+ *
+ * Blobs are either the original file (STDS_PACK_RAW) or, for images packed with
+ * -rgba, decoded RGBA32 pixels (STDS_PACK_RGBA) that skip decoding at runtime.
+ * A mounted pack is memory-mapped on POSIX systems and read with one SDL_LoadFile
+ * elsewhere. Stds_LoadTexture, Stds_LoadSFX, Stds_LoadMusic, Stds_AddFont and the
+ * asset loader look names up in the mounted packs first, newest first, and fall
+ * back to the filesystem.
+ */
+#include "../include/pack.h"
+
+#if defined( __unix__ ) || defined( __APPLE__ )
+#define STDS_PACK_MMAP
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+static struct pack_t packs[STDS_MAX_PACKS];
+static int32_t       pack_count = 0;
+
+static const char pack_magic[4] = { 'S', 'P', 'A', 'K' };
+
+static uint32_t Stds_ReadPackLE32( const uint8_t *p );
+static int      Stds_ComparePackEntries( const void *a, const void *b );
+static void     Stds_ReleasePack( struct pack_t *pack );
+
+/**
+ * Mounts an asset pack. The file is mapped (or read) once, its index is
+ * parsed, and its entries become visible to the load functions.
+ *
+ * @param const char * path to the pack file.
+ *
+ * @return bool true if the pack was mounted.
+ */
+bool
+Stds_MountPack( const char *file_path ) {
+  struct pack_t pack;
+  memset( &pack, 0, sizeof( struct pack_t ) );
+
+  if ( pack_count == STDS_MAX_PACKS ) {
+    SDL_LogInfo( SDL_LOG_CATEGORY_APPLICATION, "Could not mount %s; STDS_MAX_PACKS are mounted.\n",
+                 file_path );
+    return false;
+  }
+
+#ifdef STDS_PACK_MMAP
+  int fd = open( file_path, O_RDONLY );
+
+  if ( fd != -1 ) {
+    struct stat st;
+
+    if ( fstat( fd, &st ) == 0 && st.st_size > 0 ) {
+      void *addr = mmap( NULL, ( size_t ) st.st_size, PROT_READ, MAP_PRIVATE, fd, 0 );
+
+      if ( addr != MAP_FAILED ) {
+        pack.base      = addr;
+        pack.size      = ( size_t ) st.st_size;
+        pack.is_mapped = true;
+      }
+    }
+    close( fd );
+  }
+#endif
+
+  if ( pack.base == NULL ) {
+    pack.base = SDL_LoadFile( file_path, &pack.size );
+  }
+
+  if ( pack.base == NULL ) {
+    SDL_LogInfo( SDL_LOG_CATEGORY_APPLICATION, "Could not open pack %s. %s.\n", file_path,
+                 SDL_GetError() );
+    return false;
+  }
+
+  const uint8_t *bytes = pack.base;
+
+  if ( pack.size < STDS_PACK_HEADER_SIZE || memcmp( bytes, pack_magic, 4 ) != 0 ||
+       Stds_ReadPackLE32( bytes + 4 ) != STDS_PACK_VERSION ) {
+    SDL_LogInfo( SDL_LOG_CATEGORY_APPLICATION, "%s is not a valid pack.\n", file_path );
+    Stds_ReleasePack( &pack );
+    return false;
+  }
+
+  pack.count = Stds_ReadPackLE32( bytes + 8 );
+
+  if ( ( uint64_t ) pack.count * STDS_PACK_ENTRY_SIZE > pack.size - STDS_PACK_HEADER_SIZE ) {
+    SDL_LogInfo( SDL_LOG_CATEGORY_APPLICATION, "%s has a truncated index.\n", file_path );
+    Stds_ReleasePack( &pack );
+    return false;
+  }
+
+  pack.entries = malloc( sizeof( struct pack_entry_t ) * ( pack.count > 0 ? pack.count : 1 ) );
+
+  if ( pack.entries == NULL ) {
+    SDL_LogInfo( SDL_LOG_CATEGORY_APPLICATION, "Could not allocate memory for pack_entry_t. %s.\n",
+                 SDL_GetError() );
+    exit( EXIT_FAILURE );
+  }
+
+  for ( uint32_t i = 0; i < pack.count; i++ ) {
+    const uint8_t *e = bytes + STDS_PACK_HEADER_SIZE + ( size_t ) i * STDS_PACK_ENTRY_SIZE;
+    struct pack_entry_t *entry  = &pack.entries[i];
+    uint32_t             offset = Stds_ReadPackLE32( e + STDS_PACK_NAME_LEN );
+
+    memcpy( entry->name, e, STDS_PACK_NAME_LEN );
+    entry->name[STDS_PACK_NAME_LEN - 1] = '\0';
+    entry->size                         = Stds_ReadPackLE32( e + STDS_PACK_NAME_LEN + 4 );
+    entry->width  = ( uint16_t ) ( e[STDS_PACK_NAME_LEN + 8] | e[STDS_PACK_NAME_LEN + 9] << 8 );
+    entry->height = ( uint16_t ) ( e[STDS_PACK_NAME_LEN + 10] | e[STDS_PACK_NAME_LEN + 11] << 8 );
+    entry->type   = Stds_ReadPackLE32( e + STDS_PACK_NAME_LEN + 12 );
+    entry->data   = bytes + offset;
+
+    if ( ( uint64_t ) offset + entry->size > pack.size ) {
+      SDL_LogInfo( SDL_LOG_CATEGORY_APPLICATION, "%s: entry %s is out of bounds.\n", file_path,
+                   entry->name );
+      Stds_ReleasePack( &pack );
+      return false;
+    }
+
+    /* Surfaces and textures read width * height pixels straight from the pack. */
+    if ( entry->type == STDS_PACK_RGBA
+         && entry->size < ( uint64_t ) entry->width * entry->height * 4 ) {
+      SDL_LogInfo( SDL_LOG_CATEGORY_APPLICATION, "%s: image %s is truncated.\n", file_path,
+                   entry->name );
+      Stds_ReleasePack( &pack );
+      return false;
+    }
+  }
+
+  /* The packer writes the index sorted, but do not rely on it for bsearch. */
+  qsort( pack.entries, pack.count, sizeof( struct pack_entry_t ), Stds_ComparePackEntries );
+
+  packs[pack_count++] = pack;
+  SDL_LogDebug( SDL_LOG_CATEGORY_APPLICATION, "Mounted pack %s with %u entries.\n", file_path,
+                pack.count );
+  return true;
+}
+
+/**
+ * Unmounts every pack. Anything still reading from a pack through a
+ * SDL_RWops, such as streamed music, must be closed first.
+ *
+ * @param void.
+ *
+ * @return void.
+ */
+void
+Stds_UnmountPacks( void ) {
+  for ( int32_t i = 0; i < pack_count; i++ ) {
+    Stds_ReleasePack( &packs[i] );
+  }
+  pack_count = 0;
+}
+
+/**
+ * Finds a file in the mounted packs, searching the most recently mounted
+ * pack first.
+ *
+ * @param const char * name the file was packed under.
+ *
+ * @return pack_entry_t * the entry, or NULL if no pack has it.
+ */
+const struct pack_entry_t *
+Stds_FindPackEntry( const char *name ) {
+  struct pack_entry_t key;
+
+  if ( pack_count == 0 || strlen( name ) >= STDS_PACK_NAME_LEN ) {
+    return NULL;
+  }
+
+  strncpy( key.name, name, STDS_PACK_NAME_LEN );
+
+  for ( int32_t i = pack_count - 1; i >= 0; i-- ) {
+    const struct pack_entry_t *entry =
+      bsearch( &key, packs[i].entries, packs[i].count, sizeof( struct pack_entry_t ),
+               Stds_ComparePackEntries );
+    if ( entry != NULL ) {
+      return entry;
+    }
+  }
+
+  return NULL;
+}
+
+/**
+ * Opens a packed raw file as a read-only SDL_RWops over the pack's memory.
+ * No copy is made; the stream stays valid while the pack is mounted.
+ *
+ * @param const char * name the file was packed under.
+ *
+ * @return SDL_RWops * the stream, or NULL if no pack has a raw entry for it.
+ */
+SDL_RWops *
+Stds_OpenPackRW( const char *name ) {
+  const struct pack_entry_t *entry = Stds_FindPackEntry( name );
+
+  if ( entry == NULL || entry->type != STDS_PACK_RAW ) {
+    return NULL;
+  }
+
+  return SDL_RWFromConstMem( entry->data, ( int ) entry->size );
+}
+
+/**
+ * Loads a packed image as a surface. Pre-decoded RGBA entries are copied
+ * into a new surface without decoding; raw entries go through IMG_Load_RW.
+ * Safe to call from loader threads.
+ *
+ * @param const char * name the image was packed under.
+ *
+ * @return SDL_Surface * the surface, to be freed by the caller, or NULL if no
+ *         pack has the image.
+ */
+SDL_Surface *
+Stds_LoadPackSurface( const char *name ) {
+  const struct pack_entry_t *entry = Stds_FindPackEntry( name );
+
+  if ( entry == NULL ) {
+    return NULL;
+  }
+
+  if ( entry->type == STDS_PACK_RAW ) {
+    return IMG_Load_RW( SDL_RWFromConstMem( entry->data, ( int ) entry->size ), 1 );
+  }
+
+  SDL_Surface *surface =
+    SDL_CreateRGBSurfaceWithFormat( 0, entry->width, entry->height, 32, SDL_PIXELFORMAT_RGBA32 );
+
+  if ( surface != NULL ) {
+    for ( int32_t y = 0; y < entry->height; y++ ) {
+      memcpy( ( uint8_t * ) surface->pixels + y * surface->pitch,
+              entry->data + ( size_t ) y * entry->width * 4, ( size_t ) entry->width * 4 );
+    }
+  }
+
+  return surface;
+}
+
+/**
+ * Loads a packed image straight into a texture. Pre-decoded RGBA entries
+ * are uploaded from the pack's memory without any intermediate copy.
+ *
+ * @param const char * name the image was packed under.
+ *
+ * @return SDL_Texture * the texture, or NULL if no pack has the image.
+ */
+SDL_Texture *
+Stds_LoadPackTexture( const char *name ) {
+  const struct pack_entry_t *entry = Stds_FindPackEntry( name );
+
+  if ( entry == NULL ) {
+    return NULL;
+  }
+
+  if ( entry->type == STDS_PACK_RAW ) {
+    return IMG_LoadTexture_RW( g_app.renderer,
+                               SDL_RWFromConstMem( entry->data, ( int ) entry->size ), 1 );
+  }
+
+  SDL_Texture *texture = SDL_CreateTexture( g_app.renderer, SDL_PIXELFORMAT_RGBA32,
+                                            SDL_TEXTUREACCESS_STATIC, entry->width, entry->height );
+
+  if ( texture != NULL ) {
+    SDL_UpdateTexture( texture, NULL, entry->data, entry->width * 4 );
+    SDL_SetTextureBlendMode( texture, SDL_BLENDMODE_BLEND );
+  }
+
+  return texture;
+}
+
+/**
+ * Reads a little-endian 32-bit value from a possibly unaligned address.
+ *
+ * @param uint8_t * first byte.
+ *
+ * @return uint32_t value.
+ */
+static uint32_t
+Stds_ReadPackLE32( const uint8_t *p ) {
+  return ( uint32_t ) p[0] | ( uint32_t ) p[1] << 8 | ( uint32_t ) p[2] << 16 |
+         ( uint32_t ) p[3] << 24;
+}
+
+/**
+ * qsort/bsearch comparator ordering pack entries by name.
+ *
+ * @param void * first entry.
+ * @param void * second entry.
+ *
+ * @return int negative, zero or positive.
+ */
+static int
+Stds_ComparePackEntries( const void *a, const void *b ) {
+  return strcmp( ( ( const struct pack_entry_t * ) a )->name,
+                 ( ( const struct pack_entry_t * ) b )->name );
+}
+
+/**
+ * Unmaps or frees a pack's memory and its index.
+ *
+ * @param pack_t * pack.
+ *
+ * @return void.
+ */
+static void
+Stds_ReleasePack( struct pack_t *pack ) {
+#ifdef STDS_PACK_MMAP
+  if ( pack->is_mapped ) {
+    munmap( pack->base, pack->size );
+  } else {
+    SDL_free( pack->base );
+  }
+#else
+  SDL_free( pack->base );
+#endif
+
+  free( pack->entries );
+  memset( pack, 0, sizeof( struct pack_t ) );
+}
@@ -0,0 +1,212 @@
+/**
+ * @file particle_simd.c
+ * @author Joshua Crotts
+ * @date October 14 2026
+ * @version 1.0
+ *
+ * @section LICENSE
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License as
+ * published by the Free Software Foundation; either version 2 of
+ * the License, or (at your option) any later version.
+ *
+ * @section DESCRIPTION
+ *
+ * This file defines the vectorized integrator used by particle systems in
+ * structure-of-arrays mode. One kernel is compiled per instruction set (AVX2,
+ * SSE2, NEON or scalar), selected by the macros in simd.h.
+ */
+#include "../include/particle_simd.h"
+
+static int32_t Stds_ParticleIntegrateScalar( struct particle_soa_t *soa, int32_t i,
+                                             const int32_t start, const int32_t end,
+                                             uint32_t *death_mask );
+
+/**
+ * Integrates count particles beginning at start: velocity += delta_accel,
+ * pos += velocity, w/h += dw/dh, alpha += delta_alpha and life--. Bit
+ * (i - start) of death_mask is set for every particle whose life or alpha
+ * reached zero, or whose width or height did.
+ *
+ * start must be a multiple of 8 so the vector loads stay aligned. The kernel
+ * may process up to 7 slots past start + count, which is safe because SoA
+ * systems round their capacity up to a multiple of 8; the bits for those
+ * slots are cleared before returning. death_mask must hold at least
+ * ( count + 31 ) / 32 words.
+ *
+ * @param particle_soa_t * pointer to particle arrays.
+ * @param int32_t index of the first particle to integrate.
+ * @param int32_t number of particles to integrate.
+ * @param uint32_t * death bitmask, relative to start.
+ *
+ * @return void.
+ */
+void
+Stds_ParticleIntegrateSoA( struct particle_soa_t *soa, const int32_t start, const int32_t count,
+                           uint32_t *death_mask ) {
+  if ( count <= 0 ) {
+    return;
+  }
+
+  int32_t words = ( count + 31 ) >> 5;
+  memset( death_mask, 0, sizeof( uint32_t ) * ( size_t ) words );
+
+  int32_t i   = start;
+  int32_t end = start + ( ( count + STDS_SIMD_WIDTH - 1 ) & ~( STDS_SIMD_WIDTH - 1 ) );
+
+#if defined( STDS_SIMD_AVX2 )
+  const __m256  zero = _mm256_setzero_ps();
+  const __m256i one  = _mm256_set1_epi32( 1 );
+
+  for ( ; i < end; i += 8 ) {
+    __m256 vx    = _mm256_add_ps( _mm256_load_ps( soa->vx + i ), _mm256_load_ps( soa->ax + i ) );
+    __m256 vy    = _mm256_add_ps( _mm256_load_ps( soa->vy + i ), _mm256_load_ps( soa->ay + i ) );
+    __m256 x     = _mm256_add_ps( _mm256_load_ps( soa->x + i ), vx );
+    __m256 y     = _mm256_add_ps( _mm256_load_ps( soa->y + i ), vy );
+    __m256 w     = _mm256_add_ps( _mm256_load_ps( soa->w + i ), _mm256_load_ps( soa->dw + i ) );
+    __m256 h     = _mm256_add_ps( _mm256_load_ps( soa->h + i ), _mm256_load_ps( soa->dh + i ) );
+    __m256 alpha = _mm256_add_ps( _mm256_load_ps( soa->alpha + i ),
+                                  _mm256_load_ps( soa->delta_alpha + i ) );
+    __m256i life = _mm256_sub_epi32( _mm256_load_si256( ( __m256i * ) ( soa->life + i ) ), one );
+
+    _mm256_store_ps( soa->vx + i, vx );
+    _mm256_store_ps( soa->vy + i, vy );
+    _mm256_store_ps( soa->x + i, x );
+    _mm256_store_ps( soa->y + i, y );
+    _mm256_store_ps( soa->w + i, w );
+    _mm256_store_ps( soa->h + i, h );
+    _mm256_store_ps( soa->alpha + i, alpha );
+    _mm256_store_si256( ( __m256i * ) ( soa->life + i ), life );
+
+    __m256 dead = _mm256_or_ps( _mm256_cmp_ps( alpha, zero, _CMP_LE_OQ ),
+                                _mm256_cmp_ps( w, zero, _CMP_LE_OQ ) );
+    dead        = _mm256_or_ps( dead, _mm256_cmp_ps( h, zero, _CMP_LE_OQ ) );
+    dead        = _mm256_or_ps( dead, _mm256_castsi256_ps( _mm256_cmpgt_epi32( one, life ) ) );
+
+    uint32_t bits = ( uint32_t ) _mm256_movemask_ps( dead );
+    death_mask[( i - start ) >> 5] |= bits << ( ( i - start ) & 31 );
+  }
+#elif defined( STDS_SIMD_SSE2 )
+  const __m128  zero = _mm_setzero_ps();
+  const __m128i one  = _mm_set1_epi32( 1 );
+
+  for ( ; i < end; i += 4 ) {
+    __m128  vx    = _mm_add_ps( _mm_load_ps( soa->vx + i ), _mm_load_ps( soa->ax + i ) );
+    __m128  vy    = _mm_add_ps( _mm_load_ps( soa->vy + i ), _mm_load_ps( soa->ay + i ) );
+    __m128  x     = _mm_add_ps( _mm_load_ps( soa->x + i ), vx );
+    __m128  y     = _mm_add_ps( _mm_load_ps( soa->y + i ), vy );
+    __m128  w     = _mm_add_ps( _mm_load_ps( soa->w + i ), _mm_load_ps( soa->dw + i ) );
+    __m128  h     = _mm_add_ps( _mm_load_ps( soa->h + i ), _mm_load_ps( soa->dh + i ) );
+    __m128  alpha = _mm_add_ps( _mm_load_ps( soa->alpha + i ), _mm_load_ps( soa->delta_alpha + i ) );
+    __m128i life  = _mm_sub_epi32( _mm_load_si128( ( __m128i * ) ( soa->life + i ) ), one );
+
+    _mm_store_ps( soa->vx + i, vx );
+    _mm_store_ps( soa->vy + i, vy );
+    _mm_store_ps( soa->x + i, x );
+    _mm_store_ps( soa->y + i, y );
+    _mm_store_ps( soa->w + i, w );
+    _mm_store_ps( soa->h + i, h );
+    _mm_store_ps( soa->alpha + i, alpha );
+    _mm_store_si128( ( __m128i * ) ( soa->life + i ), life );
+
+    __m128 dead = _mm_or_ps( _mm_cmple_ps( alpha, zero ), _mm_cmple_ps( w, zero ) );
+    dead        = _mm_or_ps( dead, _mm_cmple_ps( h, zero ) );
+    dead        = _mm_or_ps( dead, _mm_castsi128_ps( _mm_cmplt_epi32( life, one ) ) );
+
+    uint32_t bits = ( uint32_t ) _mm_movemask_ps( dead );
+    death_mask[( i - start ) >> 5] |= bits << ( ( i - start ) & 31 );
+  }
+#elif defined( STDS_SIMD_NEON )
+  const float32x4_t zero = vdupq_n_f32( 0 );
+  const int32x4_t   one  = vdupq_n_s32( 1 );
+
+  for ( ; i < end; i += 4 ) {
+    float32x4_t vx    = vaddq_f32( vld1q_f32( soa->vx + i ), vld1q_f32( soa->ax + i ) );
+    float32x4_t vy    = vaddq_f32( vld1q_f32( soa->vy + i ), vld1q_f32( soa->ay + i ) );
+    float32x4_t x     = vaddq_f32( vld1q_f32( soa->x + i ), vx );
+    float32x4_t y     = vaddq_f32( vld1q_f32( soa->y + i ), vy );
+    float32x4_t w     = vaddq_f32( vld1q_f32( soa->w + i ), vld1q_f32( soa->dw + i ) );
+    float32x4_t h     = vaddq_f32( vld1q_f32( soa->h + i ), vld1q_f32( soa->dh + i ) );
+    float32x4_t alpha = vaddq_f32( vld1q_f32( soa->alpha + i ), vld1q_f32( soa->delta_alpha + i ) );
+    int32x4_t   life  = vsubq_s32( vld1q_s32( soa->life + i ), one );
+
+    vst1q_f32( soa->vx + i, vx );
+    vst1q_f32( soa->vy + i, vy );
+    vst1q_f32( soa->x + i, x );
+    vst1q_f32( soa->y + i, y );
+    vst1q_f32( soa->w + i, w );
+    vst1q_f32( soa->h + i, h );
+    vst1q_f32( soa->alpha + i, alpha );
+    vst1q_s32( soa->life + i, life );
+
+    uint32x4_t dead = vorrq_u32( vcleq_f32( alpha, zero ), vcleq_f32( w, zero ) );
+    dead            = vorrq_u32( dead, vcleq_f32( h, zero ) );
+    dead            = vorrq_u32( dead, vcltq_s32( life, one ) );
+
+    uint32_t bits = ( vgetq_lane_u32( dead, 0 ) & 1 ) | ( vgetq_lane_u32( dead, 1 ) & 2 ) |
+                    ( vgetq_lane_u32( dead, 2 ) & 4 ) | ( vgetq_lane_u32( dead, 3 ) & 8 );
+    death_mask[( i - start ) >> 5] |= bits << ( ( i - start ) & 31 );
+  }
+#endif
+
+  Stds_ParticleIntegrateScalar( soa, i, start, start + count, death_mask );
+
+  /* Clear the bits of the padding slots integrated past start + count. */
+  if ( count & 31 ) {
+    death_mask[words - 1] &= ( 1u << ( count & 31 ) ) - 1;
+  }
+}
+
+/**
+ * Returns the name of the instruction set the particle kernel was built for.
+ *
+ * @param void.
+ *
+ * @return const char * "AVX2", "SSE2", "NEON" or "scalar".
+ */
+const char *
+Stds_ParticleSimdName( void ) {
+#if defined( STDS_SIMD_AVX2 )
+  return "AVX2";
+#elif defined( STDS_SIMD_SSE2 )
+  return "SSE2";
+#elif defined( STDS_SIMD_NEON )
+  return "NEON";
+#else
+  return "scalar";
+#endif
+}
+
+/**
+ * Scalar fallback of the integrator. Handles every particle from i up to end,
+ * which is the whole range when no vector path is compiled in.
+ *
+ * @param particle_soa_t * pointer to particle arrays.
+ * @param int32_t first index to integrate.
+ * @param int32_t index the death mask is relative to.
+ * @param int32_t one past the last index to integrate.
+ * @param uint32_t * death bitmask.
+ *
+ * @return int32_t index after the last integrated particle.
+ */
+static int32_t
+Stds_ParticleIntegrateScalar( struct particle_soa_t *soa, int32_t i, const int32_t start,
+                              const int32_t end, uint32_t *death_mask ) {
+  for ( ; i < end; i++ ) {
+    soa->vx[i] += soa->ax[i];
+    soa->vy[i] += soa->ay[i];
+    soa->x[i] += soa->vx[i];
+    soa->y[i] += soa->vy[i];
+    soa->w[i] += soa->dw[i];
+    soa->h[i] += soa->dh[i];
+    soa->alpha[i] += soa->delta_alpha[i];
+    soa->life[i]--;
+
+    if ( soa->life[i] <= 0 || soa->alpha[i] <= 0 || soa->w[i] <= 0 || soa->h[i] <= 0 ) {
+      death_mask[( i - start ) >> 5] |= 1u << ( ( i - start ) & 31 );
+    }
+  }
+
+  return i;
+}
@@ -14,8 +14,60 @@
  * @section DESCRIPTION
  *
  * This file defines the particle system backed in static memory.
+ *
+ * Three backends sit behind the same functions. Callback systems update and
+ * draw every particle through its function pointers. SoA systems run a
+ * vectorized integrator over structure-of-arrays storage. Stateless systems
+ * keep only the spawn state of each particle: an update just advances the
+ * system's frame and drops the particles whose death frame has passed, and
+ * drawing evaluates each particle's position, size and alpha in closed form
+ * from its age. No particle state is written back per frame.
  */
 #include "../include/particle_system.h"
+#include "../include/particle_simd.h"
+
+#define STDS_PARTICLE_SOA_ALIGN 32
+#define STDS_PARTICLE_SOA_WIDTH 8
+
+/* Particles per job in a parallel update. Must stay a multiple of 32 so every
+   job owns whole words of the death mask. */
+#define STDS_PARTICLE_CHUNK_SIZE 4096
+
+/* Work shared by every job of one parallel update. */
+struct particle_job_t {
+  struct particle_system_t *ps;
+  uint32_t *                death_mask;
+  int32_t                   count;
+};
+
+static struct particle_system_t *Stds_CreateParticleSystemArrays( const int32_t max_particles,
+                                                                  const uint32_t flags );
+static int32_t Stds_InsertParticleSoA( struct particle_system_t *ps, const struct particle_t *p );
+static int32_t Stds_InsertParticleStateless( struct particle_system_t *ps,
+                                             const struct particle_t *p );
+static int32_t Stds_GetParticleLifetime( const struct particle_t *p );
+static void    Stds_ParticleSystemUpdateStateless( struct particle_system_t *ps );
+static void    Stds_ParticleSystemUpdateSoA( struct particle_system_t *ps );
+static void    Stds_ParticleSystemDrawSoA( const struct particle_system_t *ps );
+static void    Stds_SwapParticleSoA( struct particle_soa_t *soa, const int32_t i, const int32_t j );
+static void    Stds_ReserveDrawScratch( const int32_t n );
+static void    Stds_ReserveDrawGroups( const int32_t n );
+static void    Stds_ParticleUpdateChunk( void *data, int32_t chunk );
+static void    Stds_CompactDeadParticles( struct particle_system_t *ps, const uint32_t *death_mask,
+                                          const int32_t count );
+
+/* Death mask for parallel updates of callback particles, shared by every system. */
+static uint32_t *parallel_death_mask;
+static int32_t   parallel_death_words;
+
+/* Scratch buffers for batching SoA particle draws, shared by every system. */
+static SDL_FRect *   draw_rects;
+static SDL_Color *   draw_colors;
+static int32_t *     draw_group_ids;
+static int32_t       draw_capacity;
+static SDL_Texture **draw_groups;
+static int32_t *     draw_group_counts;
+static int32_t       draw_group_capacity;
 
 /**
  * Initializes a particle system with a size of max particles.
@@ -47,10 +99,59 @@ Stds_CreateParticleSystem( const int32_t max_particles ) {
   return ps;
 }
 
+/**
+ * Initializes a particle system that stores its particles as a structure of
+ * arrays. Particles in this system are not updated or drawn through the
+ * particle_update and particle_draw function pointers; instead, a built-in
+ * integrator applies velocity += delta_accel, pos += velocity, w/h += dw/dh,
+ * alpha += delta_alpha and life-- every frame. A particle dies when its life
+ * or alpha reaches zero, or when it shrinks to nothing.
+ *
+ * All arrays are carved out of one allocation. The capacity is rounded up to
+ * a multiple of eight so every array starts on a 32-byte boundary.
+ *
+ * @param int32_t max number of particles that can be spawned in the system at
+ *        any given time.
+ *
+ * @return particle_system_t * pointer to emitter.
+ */
+struct particle_system_t *
+Stds_CreateParticleSystemSoA( const int32_t max_particles ) {
+  return Stds_CreateParticleSystemArrays( max_particles, STDS_PARTICLE_SOA_MASK );
+}
+
+/**
+ * Initializes a particle system that stores only the spawn state of its
+ * particles, in the same arrays as an SoA system, and follows the same
+ * motion: velocity += delta_accel, pos += velocity, w/h += dw/dh and alpha
+ * += delta_alpha every frame. Instead of integrating, the system computes at
+ * insertion the frame each particle dies in, and drawing evaluates every
+ * particle from its age. Updates only advance the frame and reclaim dead
+ * particles, so their cost no longer grows with the particle count.
+ *
+ * Positions follow the closed form of the per-frame sums, so they can differ
+ * from an SoA system by float rounding.
+ *
+ * @param int32_t max number of particles that can be spawned in the system at
+ *        any given time.
+ *
+ * @return particle_system_t * pointer to emitter.
+ */
+struct particle_system_t *
+Stds_CreateParticleSystemStateless( const int32_t max_particles ) {
+  struct particle_system_t *ps = Stds_CreateParticleSystemArrays(
+    max_particles, STDS_PARTICLE_SOA_MASK | STDS_PARTICLE_STATELESS_MASK );
+
+  ps->next_death = INT32_MAX;
+  return ps;
+}
+
 /**
  * Adds a particle to the particle system. Returns 0 (PS_SUCCESS) if a successful insertion
  * occurred, 1 (PS_FULL) if the system is full, and 2 (PS_INVALID_FP) if the particle has
  * invalid (most likely undefined) function pointers for particle_update and particle_draw.
+ * Systems in SoA mode ignore the function pointers and copy the particle's kinematic
+ * fields, color and texture into their arrays.
  *
  * @param particle_system_t * pointer to particle system to insert particle into.
  * @param particle_t * pointer to particle to insert.
@@ -59,6 +160,12 @@ Stds_CreateParticleSystem( const int32_t max_particles ) {
  */
 int32_t
 Stds_InsertParticle( struct particle_system_t *ps, const struct particle_t *p ) {
+  if ( ps->flags & STDS_PARTICLE_STATELESS_MASK ) {
+    return Stds_InsertParticleStateless( ps, p );
+  } else if ( ps->flags & STDS_PARTICLE_SOA_MASK ) {
+    return Stds_InsertParticleSoA( ps, p );
+  }
+
   if ( ps->alive_count >= ps->max_particles - 1 ) {
     return PS_FULL;
   }
@@ -81,12 +188,24 @@ Stds_InsertParticle( struct particle_system_t *ps, const struct particle_t *p )
  * won't be updated any further. In summary, dead particles are at the right-side
  * of the system, and alive particles are on the left.
  *
+ * Systems created with Stds_CreateParticleSystemSoA run the built-in integrator
+ * instead of the particle_update function pointers, and stateless systems
+ * only advance their frame.
+ *
  * @param particle_system * pointer to system.
  *
  * @return void.
  */
 void
 Stds_ParticleSystemUpdate( struct particle_system_t *ps ) {
+  if ( ps->flags & STDS_PARTICLE_STATELESS_MASK ) {
+    Stds_ParticleSystemUpdateStateless( ps );
+    return;
+  } else if ( ps->flags & STDS_PARTICLE_SOA_MASK ) {
+    Stds_ParticleSystemUpdateSoA( ps );
+    return;
+  }
+
   for ( uint32_t i = 0; i < ps->alive_count; i++ ) {
     struct particle_t *p = &ps->particles[i];
     if ( p->particle_update ) {
@@ -109,6 +228,63 @@ Stds_ParticleSystemUpdate( struct particle_system_t *ps ) {
   }
 }
 
+/**
+ * Updates the particle system like Stds_ParticleSystemUpdate, but splits the
+ * alive particles into chunks of STDS_PARTICLE_CHUNK_SIZE that are updated
+ * concurrently on the worker pool. Each chunk records its deaths in its own
+ * words of a shared bitmask; once every chunk is done the main thread merges
+ * them by swap-removing the dead particles from the highest index down.
+ *
+ * For systems in callback mode, particle_update runs on worker threads, so it
+ * must not draw, play sounds or touch shared state without synchronization.
+ * Stateless systems have no per-particle work and update on this thread.
+ *
+ * @param particle_system_t * pointer to system.
+ * @param worker_pool_t * pointer to pool, or NULL to update on this thread.
+ *
+ * @return void.
+ */
+void
+Stds_ParticleSystemUpdateParallel( struct particle_system_t *ps, struct worker_pool_t *pool ) {
+  struct particle_job_t job;
+  int32_t               count = ps->alive_count;
+
+  if ( ps->flags & STDS_PARTICLE_STATELESS_MASK ) {
+    Stds_ParticleSystemUpdateStateless( ps );
+    return;
+  }
+
+  if ( count <= 0 ) {
+    return;
+  }
+
+  job.ps    = ps;
+  job.count = count;
+
+  if ( ps->flags & STDS_PARTICLE_SOA_MASK ) {
+    job.death_mask = ps->soa.death_mask;
+  } else {
+    int32_t words = ( count + 31 ) >> 5;
+    if ( words > parallel_death_words ) {
+      parallel_death_mask = realloc( parallel_death_mask, sizeof( uint32_t ) * ( size_t ) words );
+
+      if ( parallel_death_mask == NULL ) {
+        SDL_LogInfo( SDL_LOG_CATEGORY_APPLICATION,
+                     "Error: could not allocate memory for particle death mask: %s.\n",
+                     SDL_GetError() );
+        exit( EXIT_FAILURE );
+      }
+
+      parallel_death_words = words;
+    }
+    job.death_mask = parallel_death_mask;
+  }
+
+  int32_t chunks = ( count + STDS_PARTICLE_CHUNK_SIZE - 1 ) / STDS_PARTICLE_CHUNK_SIZE;
+  Stds_WorkerPoolRun( pool, Stds_ParticleUpdateChunk, &job, chunks );
+  Stds_CompactDeadParticles( ps, job.death_mask, count );
+}
+
 /**
  * Renders all particles in the system. Make sure your particles have
  * the function pointer particle_draw defined!
@@ -119,6 +295,11 @@ Stds_ParticleSystemUpdate( struct particle_system_t *ps ) {
  */
 void
 Stds_ParticleSystemDraw( const struct particle_system_t *ps ) {
+  if ( ps->flags & STDS_PARTICLE_SOA_MASK ) {
+    Stds_ParticleSystemDrawSoA( ps );
+    return;
+  }
+
   for ( uint32_t i = 0; i < ps->alive_count; i++ ) {
     struct particle_t *p = &ps->particles[i];
     if ( p->particle_draw ) {
@@ -128,4 +309,504 @@ Stds_ParticleSystemDraw( const struct particle_system_t *ps ) {
       exit( EXIT_FAILURE );
     }
   }
-}
\ No newline at end of file
+}
+/**
+ * Frees the particle system along with the storage for its particles.
+ *
+ * @param particle_system_t * pointer to particle system.
+ *
+ * @return void.
+ */
+void
+Stds_ParticleSystemDie( struct particle_system_t *ps ) {
+  if ( ps == NULL ) {
+    return;
+  }
+
+  free( ps->particles );
+  free( ps->soa_block );
+  free( ps );
+}
+
+/**
+ * Allocates a particle system and carves its particle arrays out of one
+ * block, see Stds_CreateParticleSystemSoA.
+ *
+ * @param int32_t max number of particles.
+ * @param uint32_t STDS_PARTICLE_SOA_MASK, optionally with
+ *        STDS_PARTICLE_STATELESS_MASK.
+ *
+ * @return particle_system_t * pointer to emitter.
+ */
+static struct particle_system_t *
+Stds_CreateParticleSystemArrays( const int32_t max_particles, const uint32_t flags ) {
+  struct particle_system_t *ps;
+  ps = malloc( sizeof( struct particle_system_t ) );
+
+  if ( ps == NULL ) {
+    SDL_LogInfo( SDL_LOG_CATEGORY_APPLICATION,
+                 "Error: could not allocate memory for particle_system_t struct: %s.\n",
+                 SDL_GetError() );
+    exit( EXIT_FAILURE );
+  }
+
+  memset( ps, 0, sizeof( struct particle_system_t ) );
+
+  size_t capacity = ( size_t )( max_particles + STDS_PARTICLE_SOA_WIDTH - 1 ) &
+                    ~( size_t )( STDS_PARTICLE_SOA_WIDTH - 1 );
+
+  /* 12 float arrays, the life array, the colors, the texture pointers, the
+     death mask and, for stateless systems, the spawn frames. Each array is
+     padded to the alignment so the next one starts aligned too. */
+  size_t float_bytes   = capacity * sizeof( float );
+  size_t life_bytes    = capacity * sizeof( int32_t );
+  size_t color_bytes   = ( capacity * sizeof( SDL_Color ) + STDS_PARTICLE_SOA_ALIGN - 1 ) &
+                       ~( size_t )( STDS_PARTICLE_SOA_ALIGN - 1 );
+  size_t texture_bytes = capacity * sizeof( SDL_Texture * );
+  size_t mask_bytes    = ( capacity + 31 ) / 32 * sizeof( uint32_t );
+  size_t born_bytes    = flags & STDS_PARTICLE_STATELESS_MASK ? life_bytes : 0;
+  size_t total         = float_bytes * 12 + life_bytes + color_bytes + texture_bytes + mask_bytes
+                 + born_bytes;
+
+  ps->soa_block = malloc( total + STDS_PARTICLE_SOA_ALIGN );
+
+  if ( ps->soa_block == NULL ) {
+    SDL_LogInfo( SDL_LOG_CATEGORY_APPLICATION,
+                 "Error: could not allocate memory for particle_soa_t arrays: %s.\n",
+                 SDL_GetError() );
+    exit( EXIT_FAILURE );
+  }
+
+  memset( ps->soa_block, 0, total + STDS_PARTICLE_SOA_ALIGN );
+
+  uintptr_t base = ( ( uintptr_t ) ps->soa_block + STDS_PARTICLE_SOA_ALIGN - 1 ) &
+                   ~( uintptr_t )( STDS_PARTICLE_SOA_ALIGN - 1 );
+  uint8_t *cursor = ( uint8_t * ) base;
+
+  float **floats[] = { &ps->soa.x,  &ps->soa.y,  &ps->soa.vx,    &ps->soa.vy,
+                       &ps->soa.ax, &ps->soa.ay, &ps->soa.w,     &ps->soa.h,
+                       &ps->soa.dw, &ps->soa.dh, &ps->soa.alpha, &ps->soa.delta_alpha };
+
+  for ( uint32_t i = 0; i < sizeof( floats ) / sizeof( floats[0] ); i++ ) {
+    *floats[i] = ( float * ) cursor;
+    cursor += float_bytes;
+  }
+
+  ps->soa.life = ( int32_t * ) cursor;
+  cursor += life_bytes;
+  ps->soa.color = ( SDL_Color * ) cursor;
+  cursor += color_bytes;
+  ps->soa.texture = ( SDL_Texture ** ) cursor;
+  cursor += texture_bytes;
+  ps->soa.death_mask = ( uint32_t * ) cursor;
+  cursor += mask_bytes;
+  ps->soa.born = born_bytes > 0 ? ( int32_t * ) cursor : NULL;
+
+  ps->max_particles = ( int32_t ) capacity;
+  ps->alive_count   = 0;
+  ps->dead_index    = 0;
+  ps->flags         = flags;
+  ps->blend_mode    = SDL_BLENDMODE_BLEND;
+
+  return ps;
+}
+
+/**
+ * Copies the fields of p used by the built-in integrator into the SoA arrays.
+ *
+ * @param particle_system_t * pointer to particle system in SoA mode.
+ * @param particle_t * pointer to particle to insert.
+ *
+ * @return PS_SUCCESS or PS_FULL.
+ */
+static int32_t
+Stds_InsertParticleSoA( struct particle_system_t *ps, const struct particle_t *p ) {
+  if ( ps->alive_count >= ps->max_particles ) {
+    return PS_FULL;
+  }
+
+  struct particle_soa_t *soa = &ps->soa;
+  int32_t                i   = ( ps->alive_count )++;
+
+  soa->x[i]           = p->pos.x;
+  soa->y[i]           = p->pos.y;
+  soa->vx[i]          = p->velocity.x;
+  soa->vy[i]          = p->velocity.y;
+  soa->ax[i]          = p->delta_accel.x;
+  soa->ay[i]          = p->delta_accel.y;
+  soa->w[i]           = p->w;
+  soa->h[i]           = p->h;
+  soa->dw[i]          = p->dw;
+  soa->dh[i]          = p->dh;
+  soa->alpha[i]       = ( float ) p->color.a;
+  soa->delta_alpha[i] = p->delta_alpha;
+  soa->life[i]        = p->life;
+  soa->color[i]       = p->color;
+  soa->texture[i]     = p->current_texture;
+
+  return PS_SUCCESS;
+}
+
+/**
+ * Stores the spawn state of p, stamped with the current frame, and records
+ * the frame it dies in.
+ *
+ * @param particle_system_t * pointer to particle system in stateless mode.
+ * @param particle_t * pointer to particle to insert.
+ *
+ * @return PS_SUCCESS or PS_FULL.
+ */
+static int32_t
+Stds_InsertParticleStateless( struct particle_system_t *ps, const struct particle_t *p ) {
+  const int32_t i = ps->alive_count;
+
+  if ( Stds_InsertParticleSoA( ps, p ) != PS_SUCCESS ) {
+    return PS_FULL;
+  }
+
+  const int32_t lifetime = Stds_GetParticleLifetime( p );
+
+  ps->soa.born[i] = ps->frame;
+  ps->soa.life[i] = lifetime < INT32_MAX - ps->frame ? ps->frame + lifetime : INT32_MAX;
+
+  if ( ps->soa.life[i] < ps->next_death ) {
+    ps->next_death = ps->soa.life[i];
+  }
+
+  return PS_SUCCESS;
+}
+
+/**
+ * Counts the updates an SoA system would integrate p for before it dies:
+ * the first frame its life, alpha, width or height reaches zero.
+ *
+ * @param particle_t * pointer to particle.
+ *
+ * @return int32_t number of frames, at least 1, or INT32_MAX if it never
+ *         dies.
+ */
+static int32_t
+Stds_GetParticleLifetime( const struct particle_t *p ) {
+  const float start[] = { ( float ) p->color.a, p->w, p->h };
+  const float delta[] = { p->delta_alpha, p->dw, p->dh };
+  int32_t     frames  = p->life > 1 ? p->life : 1;
+
+  for ( uint32_t k = 0; k < sizeof( start ) / sizeof( start[0] ); k++ ) {
+    if ( start[k] + delta[k] <= 0 ) {
+      return 1;
+    }
+
+    if ( delta[k] < 0 ) {
+      const float reach = ceilf( start[k] / -delta[k] );
+      if ( reach < ( float ) frames ) {
+        frames = ( int32_t ) reach;
+      }
+    }
+  }
+
+  return frames;
+}
+
+/**
+ * Advances a stateless system by one frame. Once the earliest death frame is
+ * reached, the life array is scanned to swap-remove every particle that died
+ * and to find the next death frame; no other array is read.
+ *
+ * @param particle_system_t * pointer to particle system in stateless mode.
+ *
+ * @return void.
+ */
+static void
+Stds_ParticleSystemUpdateStateless( struct particle_system_t *ps ) {
+  ps->frame++;
+
+  if ( ps->frame < ps->next_death ) {
+    return;
+  }
+
+  ps->next_death = INT32_MAX;
+
+  for ( int32_t i = ps->alive_count - 1; i >= 0; i-- ) {
+    if ( ps->soa.life[i] <= ps->frame ) {
+      ps->dead_index = --( ps->alive_count );
+      Stds_SwapParticleSoA( &ps->soa, i, ps->dead_index );
+    } else if ( ps->soa.life[i] < ps->next_death ) {
+      ps->next_death = ps->soa.life[i];
+    }
+  }
+}
+
+/**
+ * Integrates every alive particle of an SoA system with the vectorized kernel,
+ * then swap-removes the particles flagged in the death mask.
+ *
+ * @param particle_system_t * pointer to particle system in SoA mode.
+ *
+ * @return void.
+ */
+static void
+Stds_ParticleSystemUpdateSoA( struct particle_system_t *ps ) {
+  Stds_ParticleIntegrateSoA( &ps->soa, 0, ps->alive_count, ps->soa.death_mask );
+  Stds_CompactDeadParticles( ps, ps->soa.death_mask, ps->alive_count );
+}
+
+/**
+ * Draws every alive particle of an SoA or stateless system. Particles are
+ * grouped by texture with a counting sort, and each group is submitted as one
+ * quad batch in the system's blend mode. Untextured particles form their own
+ * group and are drawn as solid quads.
+ *
+ * @param particle_system_t * pointer to particle system in SoA mode.
+ *
+ * @return void.
+ */
+static void
+Stds_ParticleSystemDrawSoA( const struct particle_system_t *ps ) {
+  const struct particle_soa_t *soa   = &ps->soa;
+  const int32_t                count = ps->alive_count;
+
+  if ( count <= 0 ) {
+    return;
+  }
+
+  Stds_ReserveDrawScratch( count );
+
+  /* Assign every particle to a texture group. Systems rarely use more than a
+     handful of textures, so a linear search over the groups is enough. */
+  int32_t groups = 0;
+  for ( int32_t i = 0; i < count; i++ ) {
+    int32_t g = 0;
+    while ( g < groups && draw_groups[g] != soa->texture[i] ) {
+      g++;
+    }
+
+    if ( g == groups ) {
+      Stds_ReserveDrawGroups( groups + 1 );
+      draw_groups[g]       = soa->texture[i];
+      draw_group_counts[g] = 0;
+      groups++;
+    }
+
+    draw_group_ids[i] = g;
+    draw_group_counts[g]++;
+  }
+
+  /* Turn the counts into starting offsets, then scatter the quads. */
+  for ( int32_t g = 0, offset = 0; g < groups; g++ ) {
+    int32_t n            = draw_group_counts[g];
+    draw_group_counts[g] = offset;
+    offset += n;
+  }
+
+  for ( int32_t i = 0; i < count; i++ ) {
+    int32_t   slot = draw_group_counts[draw_group_ids[i]]++;
+    SDL_Color c    = soa->color[i];
+    float     a    = soa->alpha[i];
+
+    if ( soa->born != NULL ) {
+      /* After t frames, velocity has gained t accelerations and position the
+         sum of the velocities of frames 1 through t. */
+      const float t    = ( float ) ( ps->frame - soa->born[i] );
+      const float tt   = t * ( t + 1 ) * 0.5f;
+      a                = soa->alpha[i] + soa->delta_alpha[i] * t;
+      draw_rects[slot] = ( SDL_FRect ){ soa->x[i] + soa->vx[i] * t + soa->ax[i] * tt,
+                                        soa->y[i] + soa->vy[i] * t + soa->ay[i] * tt,
+                                        soa->w[i] + soa->dw[i] * t, soa->h[i] + soa->dh[i] * t };
+    } else {
+      draw_rects[slot] = ( SDL_FRect ){ soa->x[i], soa->y[i], soa->w[i], soa->h[i] };
+    }
+
+    Stds_ClampFloat( &a, 0, 255 );
+    c.a               = ( uint8_t ) a;
+    draw_colors[slot] = c;
+  }
+
+  /* After the scatter, draw_group_counts[g] is the end of group g. */
+  for ( int32_t g = 0, first = 0; g < groups; g++ ) {
+    int32_t end = draw_group_counts[g];
+
+    if ( draw_groups[g] != NULL ) {
+      Stds_SetTextureBlendMode( draw_groups[g], ps->blend_mode );
+      Stds_DrawQuads( draw_groups[g], &draw_rects[first], NULL, &draw_colors[first], end - first,
+                      true );
+    } else {
+      Stds_SetDrawBlendMode( ps->blend_mode );
+      Stds_DrawQuads( NULL, &draw_rects[first], NULL, &draw_colors[first], end - first, true );
+    }
+
+    first = end;
+  }
+}
+
+/**
+ * Grows the scratch buffers used to build quad batches so they hold at
+ * least n particles.
+ *
+ * @param int32_t number of particles.
+ *
+ * @return void.
+ */
+static void
+Stds_ReserveDrawScratch( const int32_t n ) {
+  if ( n <= draw_capacity ) {
+    return;
+  }
+
+  draw_rects     = realloc( draw_rects, sizeof( SDL_FRect ) * ( size_t ) n );
+  draw_colors    = realloc( draw_colors, sizeof( SDL_Color ) * ( size_t ) n );
+  draw_group_ids = realloc( draw_group_ids, sizeof( int32_t ) * ( size_t ) n );
+
+  if ( draw_rects == NULL || draw_colors == NULL || draw_group_ids == NULL ) {
+    SDL_LogInfo( SDL_LOG_CATEGORY_APPLICATION,
+                 "Error: could not allocate memory for particle draw buffers: %s.\n",
+                 SDL_GetError() );
+    exit( EXIT_FAILURE );
+  }
+
+  draw_capacity = n;
+}
+
+/**
+ * Grows the texture group table so it holds at least n groups.
+ *
+ * @param int32_t number of groups.
+ *
+ * @return void.
+ */
+static void
+Stds_ReserveDrawGroups( const int32_t n ) {
+  if ( n <= draw_group_capacity ) {
+    return;
+  }
+
+  int32_t capacity  = draw_group_capacity == 0 ? 8 : draw_group_capacity * 2;
+  draw_groups       = realloc( draw_groups, sizeof( SDL_Texture * ) * ( size_t ) capacity );
+  draw_group_counts = realloc( draw_group_counts, sizeof( int32_t ) * ( size_t ) capacity );
+
+  if ( draw_groups == NULL || draw_group_counts == NULL ) {
+    SDL_LogInfo( SDL_LOG_CATEGORY_APPLICATION,
+                 "Error: could not allocate memory for particle draw groups: %s.\n",
+                 SDL_GetError() );
+    exit( EXIT_FAILURE );
+  }
+
+  draw_group_capacity = capacity;
+}
+
+/**
+ * Swaps the particles at indices i and j in every SoA array.
+ *
+ * @param particle_soa_t * pointer to arrays.
+ * @param int32_t first index.
+ * @param int32_t second index.
+ *
+ * @return void.
+ */
+static void
+Stds_SwapParticleSoA( struct particle_soa_t *soa, const int32_t i, const int32_t j ) {
+#define STDS_SOA_SWAP( type, arr )                                                                 \
+  do {                                                                                             \
+    type tmp = soa->arr[i];                                                                        \
+    soa->arr[i] = soa->arr[j];                                                                     \
+    soa->arr[j] = tmp;                                                                             \
+  } while ( 0 )
+
+  STDS_SOA_SWAP( float, x );
+  STDS_SOA_SWAP( float, y );
+  STDS_SOA_SWAP( float, vx );
+  STDS_SOA_SWAP( float, vy );
+  STDS_SOA_SWAP( float, ax );
+  STDS_SOA_SWAP( float, ay );
+  STDS_SOA_SWAP( float, w );
+  STDS_SOA_SWAP( float, h );
+  STDS_SOA_SWAP( float, dw );
+  STDS_SOA_SWAP( float, dh );
+  STDS_SOA_SWAP( float, alpha );
+  STDS_SOA_SWAP( float, delta_alpha );
+  STDS_SOA_SWAP( int32_t, life );
+  STDS_SOA_SWAP( SDL_Color, color );
+  STDS_SOA_SWAP( SDL_Texture *, texture );
+
+  if ( soa->born != NULL ) {
+    STDS_SOA_SWAP( int32_t, born );
+  }
+
+#undef STDS_SOA_SWAP
+}
+
+/**
+ * Updates one chunk of a parallel update and records its deaths. Chunks start
+ * on multiples of 32, so no two chunks write the same death mask word.
+ *
+ * @param void * pointer to the particle_job_t of this update.
+ * @param int32_t index of the chunk.
+ *
+ * @return void.
+ */
+static void
+Stds_ParticleUpdateChunk( void *data, int32_t chunk ) {
+  struct particle_job_t *   job   = data;
+  struct particle_system_t *ps    = job->ps;
+  int32_t                   start = chunk * STDS_PARTICLE_CHUNK_SIZE;
+  int32_t                   end   = start + STDS_PARTICLE_CHUNK_SIZE;
+  uint32_t *                mask  = &job->death_mask[start >> 5];
+
+  if ( end > job->count ) {
+    end = job->count;
+  }
+
+  if ( ps->flags & STDS_PARTICLE_SOA_MASK ) {
+    Stds_ParticleIntegrateSoA( &ps->soa, start, end - start, mask );
+    return;
+  }
+
+  memset( mask, 0, sizeof( uint32_t ) * ( size_t ) ( ( end - start + 31 ) >> 5 ) );
+
+  for ( int32_t i = start; i < end; i++ ) {
+    struct particle_t *p = &ps->particles[i];
+    if ( p->particle_update ) {
+      p->particle_update( p );
+    } else {
+      fprintf( stderr, "Error! p->particle_update function pointer is undefined.\n" );
+      exit( EXIT_FAILURE );
+    }
+
+    if ( p->flags & STDS_DEATH_MASK ) {
+      mask[( i - start ) >> 5] |= 1u << ( ( i - start ) & 31 );
+    }
+  }
+}
+
+/**
+ * Swap-removes every particle flagged in the death mask. Dead indices are
+ * visited from highest to lowest, so the particle swapped in from the back is
+ * always one that survived this frame.
+ *
+ * @param particle_system_t * pointer to system.
+ * @param uint32_t * death bitmask covering the first count particles.
+ * @param int32_t number of particles the mask covers.
+ *
+ * @return void.
+ */
+static void
+Stds_CompactDeadParticles( struct particle_system_t *ps, const uint32_t *death_mask,
+                           const int32_t count ) {
+  for ( int32_t word = ( count - 1 ) >> 5; word >= 0; word-- ) {
+    uint32_t bits = death_mask[word];
+
+    while ( bits != 0 ) {
+      int32_t bit = Stds_HighestBit( bits );
+      int32_t i   = ( word << 5 ) + bit;
+      bits &= ~( 1u << bit );
+
+      ps->dead_index = --( ps->alive_count );
+      if ( ps->flags & STDS_PARTICLE_SOA_MASK ) {
+        Stds_SwapParticleSoA( &ps->soa, i, ps->dead_index );
+      } else {
+        struct particle_t tmp         = ps->particles[ps->dead_index];
+        ps->particles[ps->dead_index] = ps->particles[i];
+        ps->particles[i]              = tmp;
+      }
+    }
+  }
+}
@@ -0,0 +1,952 @@
+/**
+ * @file pathfinding.c
+ * @author Joshua Crotts
+ * @date October 14 2026
+ * @version 1.0
+ *
+ * @section LICENSE
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License as
+ * published by the Free Software Foundation; either version 2 of
+ * the License, or (at your option) any later version.
+ *
+ * @section DESCRIPTION
+ *
+ * This file defines path queries over a grid_t's cells. Movement is in eight
+ * directions, diagonals cost sqrt(2), and a diagonal step is only allowed when
+ * both cells beside it are walkable, so paths never cut corners. Grids with
+ * uniform cost use Jump Point Search, which expands only the cells where the
+ * optimal path can turn; grids with per-cell costs use plain A*. Both return
+ * the same optimal cost. Every query reuses the grid's search buffers, so
+ * after the first one on a grid no memory is allocated; in turn, queries on
+ * one grid must not run concurrently.
+ *
+ * For many agents sharing one goal, a flow field runs a single Dijkstra pass
+ * outward from the goal instead, storing at every cell the step toward it.
+ */
+#include "../include/pathfinding.h"
+
+#define STDS_SQRT2 1.41421356f
+
+/* Neighbor offsets, ordered so that the opposite of direction i is 7 - i. */
+static const int8_t flow_offsets[8][2] = { { -1, -1 }, { 0, -1 }, { 1, -1 }, { -1, 0 },
+                                           { 1, 0 },   { -1, 1 }, { 0, 1 },  { 1, 1 } };
+
+struct grid_open_entry_t {
+  float   f;
+  float   g;
+  int32_t cell;
+};
+
+static bool    Stds_IsWalkable( const struct grid_t *grid, const int32_t col, const int32_t row );
+static float   Stds_Octile( const int32_t dx, const int32_t dy );
+static int     Stds_CompareOpenEntries( const void *a, const void *b );
+static void    Stds_PreparePathScratch( struct grid_t *grid );
+static void    Stds_OpenCell( struct grid_t *grid, const int32_t cell, const int32_t parent,
+                              const float g, const float h );
+static int32_t Stds_Jump( const struct grid_t *grid, int32_t col, int32_t row, const int32_t dx,
+                          const int32_t dy, const int32_t goal );
+static int32_t Stds_PrunedNeighbors( const struct grid_t *grid, const int32_t cell,
+                                     const int32_t parent, int32_t dirs[8][2] );
+static void    Stds_BuildPath( const struct grid_t *grid, const int32_t goal,
+                               struct grid_path_t *out_path );
+static void    Stds_BuildFlowFieldBuffers( struct grid_flow_field_t *field );
+static void    Stds_SwapFlowFieldBuffers( struct grid_flow_field_t *field );
+static int32_t Stds_FlowFieldThread( void *data );
+
+/**
+ * Marks a cell as walkable or blocked. Every cell starts walkable.
+ *
+ * @param grid_t * pointer to grid_t.
+ * @param uint32_t column.
+ * @param uint32_t row.
+ * @param bool true if agents may enter the cell.
+ *
+ * @return void.
+ */
+void
+Stds_SetGridCellWalkable( struct grid_t *grid, const uint32_t col, const uint32_t row,
+                          const bool is_walkable ) {
+  if ( col >= grid->cols || row >= grid->rows ) {
+    return;
+  }
+
+  if ( grid->walkable == NULL ) {
+    size_t words   = ( ( size_t ) grid->cols * grid->rows + 31 ) / 32;
+    grid->walkable = malloc( sizeof( uint32_t ) * words );
+
+    if ( grid->walkable == NULL ) {
+      SDL_LogInfo( SDL_LOG_CATEGORY_APPLICATION,
+                   "Could not allocate memory for the grid walkability bitset. %s.\n",
+                   SDL_GetError() );
+      exit( EXIT_FAILURE );
+    }
+
+    memset( grid->walkable, 0xff, sizeof( uint32_t ) * words );
+  }
+
+  uint32_t cell = row * grid->cols + col;
+
+  if ( is_walkable ) {
+    grid->walkable[cell >> 5] |= 1u << ( cell & 31 );
+  } else {
+    grid->walkable[cell >> 5] &= ~( 1u << ( cell & 31 ) );
+  }
+}
+
+/**
+ * Determines whether a cell is walkable. Cells outside the grid are not.
+ *
+ * @param grid_t * pointer to grid_t.
+ * @param int32_t column.
+ * @param int32_t row.
+ *
+ * @return bool true if the cell is inside the grid and walkable.
+ */
+bool
+Stds_IsGridCellWalkable( const struct grid_t *grid, const int32_t col, const int32_t row ) {
+  return Stds_IsWalkable( grid, col, row );
+}
+
+/**
+ * Sets the cost of stepping into a cell, as a multiple of the base step
+ * cost. Setting any cost switches the grid from Jump Point Search to A*.
+ *
+ * @param grid_t * pointer to grid_t.
+ * @param uint32_t column.
+ * @param uint32_t row.
+ * @param uint8_t cost from 1 (the default) to 255.
+ *
+ * @return void.
+ */
+void
+Stds_SetGridCellCost( struct grid_t *grid, const uint32_t col, const uint32_t row,
+                      const uint8_t cost ) {
+  if ( col >= grid->cols || row >= grid->rows ) {
+    return;
+  }
+
+  if ( grid->path_costs == NULL ) {
+    grid->path_costs = malloc( ( size_t ) grid->cols * grid->rows );
+
+    if ( grid->path_costs == NULL ) {
+      SDL_LogInfo( SDL_LOG_CATEGORY_APPLICATION,
+                   "Could not allocate memory for the grid path costs. %s.\n", SDL_GetError() );
+      exit( EXIT_FAILURE );
+    }
+
+    memset( grid->path_costs, 1, ( size_t ) grid->cols * grid->rows );
+  }
+
+  grid->path_costs[row * grid->cols + col] = cost > 0 ? cost : 1;
+}
+
+/**
+ * Finds the cheapest path between two cells.
+ *
+ * @param grid_t * pointer to grid_t.
+ * @param grid_pair_t * start cell (c and r are used).
+ * @param grid_pair_t * goal cell (c and r are used).
+ * @param grid_path_t * receives the path; zero it before the first use.
+ *
+ * @return bool true if a path exists. On false, out_path->count is 0.
+ */
+bool
+Stds_GridFindPath( struct grid_t *grid, const struct grid_pair_t *start,
+                   const struct grid_pair_t *goal, struct grid_path_t *out_path ) {
+  out_path->count = 0;
+  out_path->cost  = 0;
+
+  if ( !Stds_IsWalkable( grid, start->c, start->r ) ||
+       !Stds_IsWalkable( grid, goal->c, goal->r ) ) {
+    return false;
+  }
+
+  Stds_PreparePathScratch( grid );
+
+  struct grid_path_scratch_t *scratch    = grid->path_scratch;
+  const int32_t               cols       = ( int32_t ) grid->cols;
+  const int32_t               start_cell = start->r * cols + start->c;
+  const int32_t               goal_cell  = goal->r * cols + goal->c;
+  const bool                  is_uniform = grid->path_costs == NULL;
+
+  Stds_OpenCell( grid, start_cell, -1, 0,
+                 Stds_Octile( goal->c - start->c, goal->r - start->r ) );
+
+  while ( !Stds_HeapIsEmpty( scratch->open ) ) {
+    struct grid_open_entry_t entry;
+    Stds_HeapExtractRoot( scratch->open, &entry );
+
+    struct grid_path_node_t *node = &scratch->nodes[entry.cell];
+    node->is_closed               = true;
+
+    if ( entry.cell == goal_cell ) {
+      Stds_BuildPath( grid, goal_cell, out_path );
+      out_path->cost = node->g;
+      return true;
+    }
+
+    const int32_t col = entry.cell % cols;
+    const int32_t row = entry.cell / cols;
+    int32_t       dirs[8][2];
+    int32_t       n =
+      Stds_PrunedNeighbors( grid, entry.cell, is_uniform ? node->parent : -1, dirs );
+
+    for ( int32_t i = 0; i < n; i++ ) {
+      int32_t next;
+      float   step;
+
+      if ( is_uniform ) {
+        next = Stds_Jump( grid, col + dirs[i][0], row + dirs[i][1], dirs[i][0], dirs[i][1],
+                          goal_cell );
+        if ( next < 0 ) {
+          continue;
+        }
+        step = Stds_Octile( next % cols - col, next / cols - row );
+      } else {
+        next = ( row + dirs[i][1] ) * cols + col + dirs[i][0];
+        step = ( dirs[i][0] != 0 && dirs[i][1] != 0 ? STDS_SQRT2 : 1.0f ) *
+               ( float ) grid->path_costs[next];
+      }
+
+      Stds_OpenCell( grid, next, entry.cell, node->g + step,
+                     Stds_Octile( goal->c - next % cols, goal->r - next / cols ) );
+    }
+  }
+
+  return false;
+}
+
+/**
+ * Frees a path's point buffer.
+ *
+ * @param grid_path_t * path.
+ *
+ * @return void.
+ */
+void
+Stds_FreeGridPath( struct grid_path_t *path ) {
+  free( path->points );
+  memset( path, 0, sizeof( struct grid_path_t ) );
+}
+
+/**
+ * Frees the grid's walkability, cost and search buffers. Stds_FreeGrid
+ * calls this.
+ *
+ * @param grid_t * pointer to grid_t.
+ *
+ * @return void.
+ */
+void
+Stds_FreeGridPathData( struct grid_t *grid ) {
+  if ( grid->path_scratch != NULL ) {
+    free( grid->path_scratch->nodes );
+    Stds_HeapDestroy( grid->path_scratch->open );
+    free( grid->path_scratch );
+  }
+
+  free( grid->walkable );
+  free( grid->path_costs );
+  grid->walkable     = NULL;
+  grid->path_costs   = NULL;
+  grid->path_scratch = NULL;
+}
+
+/**
+ * Creates a flow field over a grid. The field holds no goal until the first
+ * Stds_GridBuildFlowField, and must be freed before the grid.
+ *
+ * @param grid_t * pointer to grid_t.
+ *
+ * @return grid_flow_field_t * pointer to the flow field.
+ */
+struct grid_flow_field_t *
+Stds_CreateFlowField( struct grid_t *grid ) {
+  struct grid_flow_field_t *field;
+  field = malloc( sizeof( struct grid_flow_field_t ) );
+
+  if ( field == NULL ) {
+    SDL_LogInfo( SDL_LOG_CATEGORY_APPLICATION,
+                 "Could not allocate memory for grid_flow_field_t. %s.\n", SDL_GetError() );
+    exit( EXIT_FAILURE );
+  }
+
+  memset( field, 0, sizeof( struct grid_flow_field_t ) );
+
+  size_t cells           = ( size_t ) grid->cols * grid->rows;
+  field->grid            = grid;
+  field->distances       = malloc( sizeof( float ) * cells );
+  field->back_distances  = malloc( sizeof( float ) * cells );
+  field->directions      = malloc( cells );
+  field->back_directions = malloc( cells );
+  field->handles         = malloc( sizeof( int32_t ) * cells );
+
+  if ( field->distances == NULL || field->back_distances == NULL || field->directions == NULL ||
+       field->back_directions == NULL || field->handles == NULL ) {
+    SDL_LogInfo( SDL_LOG_CATEGORY_APPLICATION,
+                 "Could not allocate memory for the flow field buffers. %s.\n", SDL_GetError() );
+    exit( EXIT_FAILURE );
+  }
+
+  for ( size_t i = 0; i < cells; i++ ) {
+    field->distances[i] = -1.0f;
+  }
+
+  memset( field->directions, STDS_FLOW_NONE, cells );
+  field->open = Stds_HeapCreate( sizeof( struct grid_open_entry_t ), Stds_CompareOpenEntries,
+                                 STDS_HEAP_QUATERNARY );
+  field->goal_cell          = -1;
+  field->building_goal_cell = -1;
+
+  return field;
+}
+
+/**
+ * Points the field at a new goal cell. Nothing happens if the goal is the
+ * one already built (or being built) and the field was not invalidated, so
+ * it is cheap to call every frame with the player's cell; the O(cells)
+ * rebuild only runs when the goal cell changes.
+ *
+ * With is_async, the rebuild runs on its own thread and agents keep sampling
+ * the previous field until Stds_UpdateFlowField swaps the new one in. The
+ * grid's walkability and costs must not change while a build is running. If
+ * a previous asynchronous build is still running, this waits for it first.
+ *
+ * @param grid_flow_field_t * pointer to the flow field.
+ * @param grid_pair_t * goal cell (c and r are used).
+ * @param bool true to build on a worker thread.
+ *
+ * @return bool true if a rebuild was started.
+ */
+bool
+Stds_GridBuildFlowField( struct grid_flow_field_t *field, const struct grid_pair_t *goal,
+                         const bool is_async ) {
+  if ( !Stds_IsWalkable( field->grid, goal->c, goal->r ) ) {
+    return false;
+  }
+
+  int32_t goal_cell = goal->r * ( int32_t ) field->grid->cols + goal->c;
+  int32_t latest    = field->thread != NULL ? field->building_goal_cell : field->goal_cell;
+
+  if ( goal_cell == latest && !field->is_dirty ) {
+    return false;
+  }
+
+  if ( field->thread != NULL ) {
+    SDL_WaitThread( field->thread, NULL );
+    field->thread = NULL;
+    Stds_SwapFlowFieldBuffers( field );
+  }
+
+  field->building_goal_cell = goal_cell;
+  field->is_dirty           = false;
+
+  if ( is_async ) {
+    SDL_AtomicSet( &field->is_build_done, 0 );
+    field->thread = SDL_CreateThread( Stds_FlowFieldThread, "stds_flow_field", field );
+
+    if ( field->thread != NULL ) {
+      return true;
+    }
+
+    SDL_LogInfo( SDL_LOG_CATEGORY_APPLICATION,
+                 "Could not create flow field thread, building in place. %s.\n",
+                 SDL_GetError() );
+  }
+
+  Stds_BuildFlowFieldBuffers( field );
+  Stds_SwapFlowFieldBuffers( field );
+
+  return true;
+}
+
+/**
+ * Swaps in the result of a finished asynchronous build. Call once per frame
+ * before agents sample the field.
+ *
+ * @param grid_flow_field_t * pointer to the flow field.
+ *
+ * @return bool true if a new field was swapped in.
+ */
+bool
+Stds_UpdateFlowField( struct grid_flow_field_t *field ) {
+  if ( field->thread == NULL || SDL_AtomicGet( &field->is_build_done ) == 0 ) {
+    return false;
+  }
+
+  SDL_WaitThread( field->thread, NULL );
+  field->thread = NULL;
+  Stds_SwapFlowFieldBuffers( field );
+
+  return true;
+}
+
+/**
+ * Forces the next Stds_GridBuildFlowField to rebuild even if the goal is
+ * unchanged. Call after editing the grid's walkability or costs.
+ *
+ * @param grid_flow_field_t * pointer to the flow field.
+ *
+ * @return void.
+ */
+void
+Stds_InvalidateFlowField( struct grid_flow_field_t *field ) {
+  field->is_dirty = true;
+}
+
+/**
+ * Looks up the direction an agent at world position (x, y) should move in
+ * to reach the goal along the cheapest path.
+ *
+ * @param grid_flow_field_t * pointer to the flow field.
+ * @param float world x-coordinate.
+ * @param float world y-coordinate.
+ * @param vec2_t * receives a unit direction.
+ *
+ * @return bool false if the position is off the grid, blocked, cut off from
+ *         the goal, or in the goal cell itself.
+ */
+bool
+Stds_SampleFlowField( const struct grid_flow_field_t *field, const float x, const float y,
+                      struct vec2_t *out_direction ) {
+  const struct grid_t *grid = field->grid;
+  float                fc   = ( x - grid->x ) / ( float ) grid->sw;
+  float                fr   = ( y - grid->y ) / ( float ) grid->sh;
+
+  if ( fc < 0 || fr < 0 || fc >= ( float ) grid->cols || fr >= ( float ) grid->rows ) {
+    return false;
+  }
+
+  uint8_t d = field->directions[( uint32_t ) fr * grid->cols + ( uint32_t ) fc];
+
+  if ( d == STDS_FLOW_NONE ) {
+    return false;
+  }
+
+  float scale      = flow_offsets[d][0] != 0 && flow_offsets[d][1] != 0 ? 0.70710678f : 1.0f;
+  out_direction->x = flow_offsets[d][0] * scale;
+  out_direction->y = flow_offsets[d][1] * scale;
+
+  return true;
+}
+
+/**
+ * Returns the path cost from a cell to the goal.
+ *
+ * @param grid_flow_field_t * pointer to the flow field.
+ * @param uint32_t column.
+ * @param uint32_t row.
+ *
+ * @return float cost, or -1 if the cell cannot reach the goal.
+ */
+float
+Stds_GetFlowFieldDistance( const struct grid_flow_field_t *field, const uint32_t col,
+                           const uint32_t row ) {
+  if ( col >= field->grid->cols || row >= field->grid->rows ) {
+    return -1.0f;
+  }
+
+  return field->distances[row * field->grid->cols + col];
+}
+
+/**
+ * Waits for any running build, then frees the flow field.
+ *
+ * @param grid_flow_field_t * pointer to the flow field.
+ *
+ * @return void.
+ */
+void
+Stds_FlowFieldDie( struct grid_flow_field_t *field ) {
+  if ( field->thread != NULL ) {
+    SDL_WaitThread( field->thread, NULL );
+  }
+
+  Stds_HeapDestroy( field->open );
+  free( field->distances );
+  free( field->back_distances );
+  free( field->directions );
+  free( field->back_directions );
+  free( field->handles );
+  free( field );
+}
+
+/**
+ * Walkability test without the public function's call overhead.
+ *
+ * @param grid_t * pointer to grid_t.
+ * @param int32_t column.
+ * @param int32_t row.
+ *
+ * @return bool true if the cell is inside the grid and walkable.
+ */
+static bool
+Stds_IsWalkable( const struct grid_t *grid, const int32_t col, const int32_t row ) {
+  if ( col < 0 || row < 0 || col >= ( int32_t ) grid->cols || row >= ( int32_t ) grid->rows ) {
+    return false;
+  }
+
+  if ( grid->walkable == NULL ) {
+    return true;
+  }
+
+  uint32_t cell = ( uint32_t ) row * grid->cols + ( uint32_t ) col;
+  return ( grid->walkable[cell >> 5] >> ( cell & 31 ) ) & 1;
+}
+
+/**
+ * Octile distance: the cost of the cheapest obstacle-free eight-way path
+ * covering dx columns and dy rows.
+ *
+ * @param int32_t column delta.
+ * @param int32_t row delta.
+ *
+ * @return float distance.
+ */
+static float
+Stds_Octile( const int32_t dx, const int32_t dy ) {
+  int32_t ax = dx < 0 ? -dx : dx;
+  int32_t ay = dy < 0 ? -dy : dy;
+
+  return ax < ay ? ( STDS_SQRT2 - 1.0f ) * ( float ) ax + ( float ) ay
+                 : ( STDS_SQRT2 - 1.0f ) * ( float ) ay + ( float ) ax;
+}
+
+/**
+ * Orders open entries by f, breaking ties toward larger g (entries closer
+ * to the goal), which cuts down the cells expanded on open ground.
+ *
+ * @param void * first entry.
+ * @param void * second entry.
+ *
+ * @return int negative, zero or positive.
+ */
+static int
+Stds_CompareOpenEntries( const void *a, const void *b ) {
+  const struct grid_open_entry_t *ea = a;
+  const struct grid_open_entry_t *eb = b;
+
+  if ( ea->f != eb->f ) {
+    return ea->f < eb->f ? -1 : 1;
+  }
+
+  return ( ea->g < eb->g ) - ( ea->g > eb->g );
+}
+
+/**
+ * Allocates the search buffers on the first query and starts a new query
+ * generation, so last query's node states read as untouched.
+ *
+ * @param grid_t * pointer to grid_t.
+ *
+ * @return void.
+ */
+static void
+Stds_PreparePathScratch( struct grid_t *grid ) {
+  struct grid_path_scratch_t *scratch = grid->path_scratch;
+
+  if ( scratch == NULL ) {
+    scratch = malloc( sizeof( struct grid_path_scratch_t ) );
+
+    if ( scratch != NULL ) {
+      scratch->nodes =
+        calloc( ( size_t ) grid->cols * grid->rows, sizeof( struct grid_path_node_t ) );
+    }
+
+    if ( scratch == NULL || scratch->nodes == NULL ) {
+      SDL_LogInfo( SDL_LOG_CATEGORY_APPLICATION,
+                   "Could not allocate memory for grid_path_scratch_t. %s.\n", SDL_GetError() );
+      exit( EXIT_FAILURE );
+    }
+
+    scratch->open =
+      Stds_HeapCreate( sizeof( struct grid_open_entry_t ), Stds_CompareOpenEntries,
+                       STDS_HEAP_QUATERNARY );
+    scratch->stamp     = 0;
+    grid->path_scratch = scratch;
+  }
+
+  Stds_HeapClear( scratch->open );
+
+  /* On wrap-around, old stamps could match again; clear them once. */
+  if ( ++scratch->stamp == 0 ) {
+    memset( scratch->nodes, 0, sizeof( struct grid_path_node_t ) * grid->cols * grid->rows );
+    scratch->stamp = 1;
+  }
+}
+
+/**
+ * Relaxes a cell: records it if this query has not reached it yet, or
+ * lowers its cost if the new route is cheaper. Closed cells are skipped;
+ * the octile heuristic is consistent, so their cost is already optimal.
+ *
+ * @param grid_t * pointer to grid_t.
+ * @param int32_t cell index.
+ * @param int32_t cell it is reached from, or -1.
+ * @param float cost from the start.
+ * @param float heuristic cost to the goal.
+ *
+ * @return void.
+ */
+static void
+Stds_OpenCell( struct grid_t *grid, const int32_t cell, const int32_t parent, const float g,
+               const float h ) {
+  struct grid_path_scratch_t *scratch = grid->path_scratch;
+  struct grid_path_node_t *   node    = &scratch->nodes[cell];
+  struct grid_open_entry_t    entry   = { g + h, g, cell };
+
+  if ( node->stamp != scratch->stamp ) {
+    node->stamp     = scratch->stamp;
+    node->is_closed = false;
+    node->g         = g;
+    node->parent    = parent;
+    node->handle    = Stds_HeapInsert( scratch->open, &entry );
+  } else if ( !node->is_closed && g < node->g ) {
+    node->g      = g;
+    node->parent = parent;
+    Stds_HeapDecreaseKey( scratch->open, node->handle, &entry );
+  }
+}
+
+/**
+ * Walks from (col, row) in direction (dx, dy) until it reaches a jump
+ * point: the goal, or a cell with a forced neighbor, i.e. one whose optimal
+ * path has to turn here because of an obstacle. Diagonal walks also stop
+ * where a straight walk from them finds a jump point.
+ *
+ * @param grid_t * pointer to grid_t.
+ * @param int32_t first column to test.
+ * @param int32_t first row to test.
+ * @param int32_t column step, -1, 0 or 1.
+ * @param int32_t row step, -1, 0 or 1.
+ * @param int32_t goal cell index.
+ *
+ * @return int32_t jump point cell index, or -1 if the walk hits a wall.
+ */
+static int32_t
+Stds_Jump( const struct grid_t *grid, int32_t col, int32_t row, const int32_t dx, const int32_t dy,
+           const int32_t goal ) {
+  const int32_t cols = ( int32_t ) grid->cols;
+
+  for ( ;; ) {
+    if ( !Stds_IsWalkable( grid, col, row ) ) {
+      return -1;
+    }
+
+    int32_t cell = row * cols + col;
+
+    if ( cell == goal ) {
+      return cell;
+    }
+
+    if ( dx != 0 && dy != 0 ) {
+      if ( Stds_Jump( grid, col + dx, row, dx, 0, goal ) >= 0 ||
+           Stds_Jump( grid, col, row + dy, 0, dy, goal ) >= 0 ) {
+        return cell;
+      }
+
+      /* No corner cutting: the next diagonal step needs both sides open. */
+      if ( !Stds_IsWalkable( grid, col + dx, row ) || !Stds_IsWalkable( grid, col, row + dy ) ) {
+        return -1;
+      }
+    } else if ( dx != 0 ) {
+      if ( ( Stds_IsWalkable( grid, col, row - 1 ) &&
+             !Stds_IsWalkable( grid, col - dx, row - 1 ) ) ||
+           ( Stds_IsWalkable( grid, col, row + 1 ) &&
+             !Stds_IsWalkable( grid, col - dx, row + 1 ) ) ) {
+        return cell;
+      }
+    } else {
+      if ( ( Stds_IsWalkable( grid, col - 1, row ) &&
+             !Stds_IsWalkable( grid, col - 1, row - dy ) ) ||
+           ( Stds_IsWalkable( grid, col + 1, row ) &&
+             !Stds_IsWalkable( grid, col + 1, row - dy ) ) ) {
+        return cell;
+      }
+    }
+
+    col += dx;
+    row += dy;
+  }
+}
+
+/**
+ * Lists the directions to explore from a cell. Without a parent (the start
+ * cell, or any cell under A*), that is every walkable neighbor; with one,
+ * Jump Point Search keeps only the natural and forced neighbors of the
+ * direction of travel.
+ *
+ * @param grid_t * pointer to grid_t.
+ * @param int32_t cell index.
+ * @param int32_t parent cell index, or -1.
+ * @param int32_t[8][2] receives (dx, dy) directions.
+ *
+ * @return int32_t number of directions.
+ */
+static int32_t
+Stds_PrunedNeighbors( const struct grid_t *grid, const int32_t cell, const int32_t parent,
+                      int32_t dirs[8][2] ) {
+  const int32_t cols = ( int32_t ) grid->cols;
+  const int32_t col  = cell % cols;
+  const int32_t row  = cell / cols;
+  int32_t       n    = 0;
+
+#define STDS_ADD_DIR( ddx, ddy )                                                                   \
+  do {                                                                                             \
+    dirs[n][0] = ( ddx );                                                                          \
+    dirs[n][1] = ( ddy );                                                                          \
+    n++;                                                                                           \
+  } while ( 0 )
+
+  if ( parent < 0 ) {
+    for ( int32_t dy = -1; dy <= 1; dy++ ) {
+      for ( int32_t dx = -1; dx <= 1; dx++ ) {
+        if ( ( dx == 0 && dy == 0 ) || !Stds_IsWalkable( grid, col + dx, row + dy ) ) {
+          continue;
+        }
+        if ( dx != 0 && dy != 0 &&
+             ( !Stds_IsWalkable( grid, col + dx, row ) ||
+               !Stds_IsWalkable( grid, col, row + dy ) ) ) {
+          continue;
+        }
+        STDS_ADD_DIR( dx, dy );
+      }
+    }
+    return n;
+  }
+
+  int32_t pc = parent % cols;
+  int32_t pr = parent / cols;
+  int32_t dx = ( col > pc ) - ( col < pc );
+  int32_t dy = ( row > pr ) - ( row < pr );
+
+  if ( dx != 0 && dy != 0 ) {
+    bool is_x_open = Stds_IsWalkable( grid, col + dx, row );
+    bool is_y_open = Stds_IsWalkable( grid, col, row + dy );
+
+    if ( is_y_open ) {
+      STDS_ADD_DIR( 0, dy );
+    }
+    if ( is_x_open ) {
+      STDS_ADD_DIR( dx, 0 );
+    }
+    if ( is_x_open && is_y_open && Stds_IsWalkable( grid, col + dx, row + dy ) ) {
+      STDS_ADD_DIR( dx, dy );
+    }
+  } else if ( dx != 0 ) {
+    bool is_next_open = Stds_IsWalkable( grid, col + dx, row );
+    bool is_up_open   = Stds_IsWalkable( grid, col, row - 1 );
+    bool is_down_open = Stds_IsWalkable( grid, col, row + 1 );
+
+    if ( is_next_open ) {
+      STDS_ADD_DIR( dx, 0 );
+      if ( is_up_open && Stds_IsWalkable( grid, col + dx, row - 1 ) ) {
+        STDS_ADD_DIR( dx, -1 );
+      }
+      if ( is_down_open && Stds_IsWalkable( grid, col + dx, row + 1 ) ) {
+        STDS_ADD_DIR( dx, 1 );
+      }
+    }
+    if ( is_up_open ) {
+      STDS_ADD_DIR( 0, -1 );
+    }
+    if ( is_down_open ) {
+      STDS_ADD_DIR( 0, 1 );
+    }
+  } else {
+    bool is_next_open  = Stds_IsWalkable( grid, col, row + dy );
+    bool is_left_open  = Stds_IsWalkable( grid, col - 1, row );
+    bool is_right_open = Stds_IsWalkable( grid, col + 1, row );
+
+    if ( is_next_open ) {
+      STDS_ADD_DIR( 0, dy );
+      if ( is_left_open && Stds_IsWalkable( grid, col - 1, row + dy ) ) {
+        STDS_ADD_DIR( -1, dy );
+      }
+      if ( is_right_open && Stds_IsWalkable( grid, col + 1, row + dy ) ) {
+        STDS_ADD_DIR( 1, dy );
+      }
+    }
+    if ( is_left_open ) {
+      STDS_ADD_DIR( -1, 0 );
+    }
+    if ( is_right_open ) {
+      STDS_ADD_DIR( 1, 0 );
+    }
+  }
+
+#undef STDS_ADD_DIR
+  return n;
+}
+
+/**
+ * Follows parent links back from the goal and writes every cell of the
+ * path, start first. Jump point links span straight runs, which are filled
+ * in cell by cell.
+ *
+ * @param grid_t * pointer to grid_t.
+ * @param int32_t goal cell index.
+ * @param grid_path_t * receives the path.
+ *
+ * @return void.
+ */
+static void
+Stds_BuildPath( const struct grid_t *grid, const int32_t goal, struct grid_path_t *out_path ) {
+  const struct grid_path_node_t *nodes = grid->path_scratch->nodes;
+  const int32_t                  cols  = ( int32_t ) grid->cols;
+  int32_t                        count = 1;
+
+  for ( int32_t c = goal; nodes[c].parent >= 0; c = nodes[c].parent ) {
+    int32_t p  = nodes[c].parent;
+    int32_t dx = c % cols - p % cols;
+    int32_t dy = c / cols - p / cols;
+    dx         = dx < 0 ? -dx : dx;
+    dy         = dy < 0 ? -dy : dy;
+    count += dx > dy ? dx : dy;
+  }
+
+  if ( count > out_path->capacity ) {
+    SDL_Point *points = realloc( out_path->points, sizeof( SDL_Point ) * ( size_t ) count );
+
+    if ( points == NULL ) {
+      SDL_LogInfo( SDL_LOG_CATEGORY_APPLICATION,
+                   "Could not allocate memory for grid_path_t points. %s.\n", SDL_GetError() );
+      exit( EXIT_FAILURE );
+    }
+
+    out_path->points   = points;
+    out_path->capacity = count;
+  }
+
+  int32_t i = count - 1;
+  int32_t c = goal;
+
+  out_path->points[i] = ( SDL_Point ){ c % cols, c / cols };
+
+  for ( ; nodes[c].parent >= 0; c = nodes[c].parent ) {
+    int32_t p  = nodes[c].parent;
+    int32_t x  = c % cols;
+    int32_t y  = c / cols;
+    int32_t px = p % cols;
+    int32_t py = p / cols;
+    int32_t sx = ( px > x ) - ( px < x );
+    int32_t sy = ( py > y ) - ( py < y );
+
+    while ( x != px || y != py ) {
+      x += sx;
+      y += sy;
+      out_path->points[--i] = ( SDL_Point ){ x, y };
+    }
+  }
+
+  out_path->count = count;
+}
+
+/**
+ * Runs Dijkstra outward from the building goal into the back buffers. A
+ * cell's direction points at the neighbor it was reached from, which is its
+ * next step on a cheapest path. Moves follow the same rules as
+ * Stds_GridFindPath, and a step costs the cost of the cell stepped into.
+ *
+ * @param grid_flow_field_t * pointer to the flow field.
+ *
+ * @return void.
+ */
+static void
+Stds_BuildFlowFieldBuffers( struct grid_flow_field_t *field ) {
+  const struct grid_t *grid  = field->grid;
+  const int32_t        cols  = ( int32_t ) grid->cols;
+  const size_t         cells = ( size_t ) grid->cols * grid->rows;
+  float *              dist  = field->back_distances;
+  uint8_t *            dirs  = field->back_directions;
+
+  for ( size_t i = 0; i < cells; i++ ) {
+    dist[i] = -1.0f;
+  }
+
+  /* -1 marks cells not reached yet, -2 cells already settled. */
+  memset( field->handles, 0xff, sizeof( int32_t ) * cells );
+  memset( dirs, STDS_FLOW_NONE, cells );
+  Stds_HeapClear( field->open );
+
+  struct grid_open_entry_t entry = { 0, 0, field->building_goal_cell };
+  dist[entry.cell]               = 0;
+  field->handles[entry.cell]     = Stds_HeapInsert( field->open, &entry );
+
+  while ( !Stds_HeapIsEmpty( field->open ) ) {
+    Stds_HeapExtractRoot( field->open, &entry );
+    field->handles[entry.cell] = -2;
+
+    const int32_t col = entry.cell % cols;
+    const int32_t row = entry.cell / cols;
+    const float   enter = grid->path_costs != NULL ? ( float ) grid->path_costs[entry.cell] : 1.0f;
+
+    for ( int32_t i = 0; i < 8; i++ ) {
+      int32_t dx = flow_offsets[i][0];
+      int32_t dy = flow_offsets[i][1];
+
+      if ( !Stds_IsWalkable( grid, col + dx, row + dy ) ) {
+        continue;
+      }
+
+      if ( dx != 0 && dy != 0 && ( !Stds_IsWalkable( grid, col + dx, row ) ||
+                                   !Stds_IsWalkable( grid, col, row + dy ) ) ) {
+        continue;
+      }
+
+      int32_t next = ( row + dy ) * cols + col + dx;
+      float   d    = entry.g + ( dx != 0 && dy != 0 ? STDS_SQRT2 : 1.0f ) * enter;
+
+      if ( field->handles[next] == -2 || ( dist[next] >= 0 && d >= dist[next] ) ) {
+        continue;
+      }
+
+      struct grid_open_entry_t open = { d, d, next };
+      dist[next]                    = d;
+      dirs[next]                    = ( uint8_t )( 7 - i );
+
+      if ( field->handles[next] == -1 ) {
+        field->handles[next] = Stds_HeapInsert( field->open, &open );
+      } else {
+        Stds_HeapDecreaseKey( field->open, field->handles[next], &open );
+      }
+    }
+  }
+}
+
+/**
+ * Makes the freshly built back buffers the ones agents sample.
+ *
+ * @param grid_flow_field_t * pointer to the flow field.
+ *
+ * @return void.
+ */
+static void
+Stds_SwapFlowFieldBuffers( struct grid_flow_field_t *field ) {
+  float *  distances     = field->distances;
+  uint8_t *directions    = field->directions;
+  field->distances       = field->back_distances;
+  field->directions      = field->back_directions;
+  field->back_distances  = distances;
+  field->back_directions = directions;
+  field->goal_cell       = field->building_goal_cell;
+}
+
+/**
+ * Body of an asynchronous flow field build.
+ *
+ * @param void * pointer to the grid_flow_field_t.
+ *
+ * @return int32_t 0.
+ */
+static int32_t
+Stds_FlowFieldThread( void *data ) {
+  struct grid_flow_field_t *field = data;
+
+  Stds_BuildFlowFieldBuffers( field );
+  SDL_AtomicSet( &field->is_build_done, 1 );
+
+  return 0;
+}
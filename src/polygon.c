@@ -14,10 +14,18 @@
  * @section DESCRIPTION
  *
  * Defines the functions associated with the polygon struct like drawing,
- * updating, and collision detecting.
+ * updating, and collision detecting. Small polygons store their vertices and
+ * normals inside the struct, so creating one costs a single pool allocation.
  */
 #include "../include/polygon.h"
 
+static struct stds_pool_t *polygon_pool;
+
+static void              Stds_InitPolygonVertices( struct polygon_t *polygon, const int32_t sides );
+static void              Stds_InitPolygonAxes( struct polygon_t *polygon );
+static void              Stds_UpdatePolygonBounds( struct polygon_t *polygon );
+static struct polygon_t *Stds_AllocPolygon( void );
+
 /**
  * Creates a polygon with any number of sides.
  * 
@@ -32,21 +40,10 @@ struct polygon_t *
 Stds_CreatePolygon( const int32_t sides, const float size, const struct vec2_t position,
                     const float angle ) {
   struct polygon_t *polygon;
-  polygon = malloc( sizeof( struct polygon_t ) );
-
-  if ( polygon == NULL ) {
-    SDL_LogDebug( SDL_LOG_CATEGORY_APPLICATION,
-                  "Error: could not allocate memory for polygon_t, %s.\n", SDL_GetError() );
-    exit( EXIT_FAILURE );
-  } else {
-    SDL_LogDebug( SDL_LOG_CATEGORY_APPLICATION, "Created polygon_t.\n" );
-  }
+  polygon = Stds_AllocPolygon();
 
-  memset( polygon, 0, sizeof( struct polygon_t ) );
-  polygon->sides       = sides;
+  Stds_InitPolygonVertices( polygon, sides );
   polygon->has_overlap = false;
-  polygon->model       = malloc( sizeof( struct vec2_t ) * sides );
-  polygon->points      = malloc( sizeof( struct vec2_t ) * sides );
 
   float f_theta     = ( ( float ) PI * 2.f ) / polygon->sides;
   polygon->position = position;
@@ -58,6 +55,7 @@ Stds_CreatePolygon( const int32_t sides, const float size, const struct vec2_t p
     polygon->points[i] = polygon->model[i];
   }
 
+  Stds_InitPolygonAxes( polygon );
   return polygon;
 }
 
@@ -70,16 +68,32 @@ Stds_CreatePolygon( const int32_t sides, const float size, const struct vec2_t p
  */
 void
 Stds_UpdatePolygon( struct polygon_t *polygon ) {
-  for ( int32_t i = 0; i < polygon->sides; i++ ) {
+  polygon->has_overlap = false;
+
+  bool angle_changed = polygon->angle != polygon->cached_angle;
+  if ( !polygon->is_dirty && !angle_changed && polygon->position.x == polygon->cached_position.x &&
+       polygon->position.y == polygon->cached_position.y ) {
+    return;
+  }
+
+  if ( polygon->is_dirty || angle_changed ) {
+    Stds_SinCosDegrees( polygon->angle, &polygon->sin_angle, &polygon->cos_angle );
+    polygon->cached_angle = polygon->angle;
 
-    polygon->points[i].x = ( polygon->model[i].x * cosf( Stds_ToRadians( polygon->angle ) ) ) -
-                           ( polygon->model[i].y * sinf( Stds_ToRadians( polygon->angle ) ) ) +
-                           polygon->position.x;
-    polygon->points[i].y = ( polygon->model[i].x * sinf( Stds_ToRadians( polygon->angle ) ) ) +
-                           ( polygon->model[i].y * cosf( Stds_ToRadians( polygon->angle ) ) ) +
-                           polygon->position.y;
-    polygon->has_overlap = false;
+    const struct transform_t rotation = { polygon->cos_angle, polygon->sin_angle,
+                                          -polygon->sin_angle, polygon->cos_angle, 0, 0 };
+    Stds_TransformVec2Array( polygon->normals, polygon->model_normals, &rotation,
+                             polygon->normal_count );
   }
+
+  const struct transform_t placement = { polygon->cos_angle,  polygon->sin_angle,
+                                         -polygon->sin_angle, polygon->cos_angle,
+                                         polygon->position.x, polygon->position.y };
+  Stds_TransformVec2Array( polygon->points, polygon->model, &placement, polygon->sides );
+
+  polygon->cached_position = polygon->position;
+  polygon->is_dirty        = false;
+  Stds_UpdatePolygonBounds( polygon );
 }
 
 /**
@@ -95,15 +109,14 @@ Stds_DrawPolygon( const struct polygon_t *polygon ) {
   SDL_Color red   = {255, 0, 0};
 
   SDL_Color color = ( polygon->has_overlap ) ? white : red;
+  color.a         = 255;
   for ( int32_t i = 0; i < polygon->sides; i++ ) {
-    SDL_SetRenderDrawColor( g_app.renderer, color.r, color.g, color.b, 255 );
-    SDL_RenderDrawLineF( g_app.renderer, polygon->points[i].x, polygon->points[i].y,
-                         polygon->points[( ( i + 1 ) % polygon->sides )].x,
-                         polygon->points[( ( i + 1 ) % polygon->sides )].y );
+    Stds_DrawLine( polygon->points[i].x, polygon->points[i].y,
+                   polygon->points[( ( i + 1 ) % polygon->sides )].x,
+                   polygon->points[( ( i + 1 ) % polygon->sides )].y, &color );
   }
-  SDL_SetRenderDrawColor( g_app.renderer, color.r, color.g, color.b, 255 );
-  SDL_RenderDrawLineF( g_app.renderer, polygon->points[0].x, polygon->points[0].y,
-                       polygon->position.x, polygon->position.y );
+  Stds_DrawLine( polygon->points[0].x, polygon->points[0].y, polygon->position.x,
+                 polygon->position.y, &color );
 }
 
 /**
@@ -115,10 +128,8 @@ Stds_DrawPolygon( const struct polygon_t *polygon ) {
  */
 void
 Stds_CleanUpPolygon( struct polygon_t *polygon ) {
-  free( polygon->model );
-  free( polygon->points );
-
-  free( polygon );
+  free( polygon->heap_vertices );
+  Stds_PoolFree( polygon_pool, polygon );
 }
 
 /**
@@ -134,21 +145,10 @@ Stds_CleanUpPolygon( struct polygon_t *polygon ) {
 struct polygon_t *
 Stds_BoundingBox( float x, float y, float w, float h, float angle ) {
   struct polygon_t *polygon;
-  polygon = malloc( sizeof( struct polygon_t ) );
-
-  if ( polygon == NULL ) {
-    SDL_LogDebug( SDL_LOG_CATEGORY_APPLICATION,
-                  "Error: could not allocate memory for polygon_t, %s.\n", SDL_GetError() );
-    exit( EXIT_FAILURE );
-  } else {
-    SDL_LogDebug( SDL_LOG_CATEGORY_APPLICATION, "Created polygon_t.\n" );
-  }
+  polygon = Stds_AllocPolygon();
 
-  memset( polygon, 0, sizeof( struct polygon_t ) );
-  polygon->sides   = 4;
+  Stds_InitPolygonVertices( polygon, 4 );
   polygon->has_overlap = false;
-  polygon->model   = malloc( sizeof( struct vec2_t ) * 4 );
-  polygon->points  = malloc( sizeof( struct vec2_t ) * 4 );
 
   float f_theta     = ( ( float ) PI * 2.f ) / polygon->sides;
   polygon->position = Stds_CreateVec2( x, y );
@@ -168,5 +168,124 @@ Stds_BoundingBox( float x, float y, float w, float h, float angle ) {
     polygon->model[i].y += h / 2;
   }
 
+  Stds_InitPolygonAxes( polygon );
   return polygon;
-}
\ No newline at end of file
+}
+
+/**
+ * Sets the polygon's side count and points model, points, model_normals and
+ * normals at its vertex storage: the inline array for small polygons, or one
+ * heap block for the rest.
+ *
+ * @param polygon_t pointer to a polygon.
+ * @param int32_t number of sides.
+ *
+ * @return void.
+ */
+static void
+Stds_InitPolygonVertices( struct polygon_t *polygon, const int32_t sides ) {
+  struct vec2_t *storage = polygon->inline_vertices;
+
+  if ( sides > STDS_POLYGON_INLINE_SIDES ) {
+    polygon->heap_vertices = malloc( sizeof( struct vec2_t ) * ( size_t ) sides * 4 );
+
+    if ( polygon->heap_vertices == NULL ) {
+      SDL_LogDebug( SDL_LOG_CATEGORY_APPLICATION,
+                    "Error: could not allocate memory for polygon vertices, %s.\n",
+                    SDL_GetError() );
+      exit( EXIT_FAILURE );
+    }
+
+    storage = polygon->heap_vertices;
+  }
+
+  polygon->sides         = sides;
+  polygon->model         = storage;
+  polygon->points        = storage + sides;
+  polygon->model_normals = storage + sides * 2;
+  polygon->normals       = storage + sides * 3;
+}
+
+/**
+ * Computes the polygon's unique edge normals and initial bounds. Edges
+ * parallel to an earlier edge share its axis, so a box tests two axes
+ * instead of four. is_dirty is set so the first update applies the angle.
+ *
+ * @param polygon_t pointer to a polygon.
+ *
+ * @return void.
+ */
+static void
+Stds_InitPolygonAxes( struct polygon_t *polygon ) {
+  polygon->normal_count = 0;
+  for ( int32_t a = 0; a < polygon->sides; a++ ) {
+    int32_t       b = ( a + 1 ) % polygon->sides;
+    struct vec2_t n = { -( polygon->model[b].y - polygon->model[a].y ),
+                        polygon->model[b].x - polygon->model[a].x };
+    float         length = sqrtf( n.x * n.x + n.y * n.y );
+
+    if ( length == 0 ) {
+      continue;
+    }
+
+    n.x /= length;
+    n.y /= length;
+
+    bool is_parallel = false;
+    for ( int32_t i = 0; i < polygon->normal_count; i++ ) {
+      const struct vec2_t *m = &polygon->model_normals[i];
+      if ( fabsf( n.x * m->y - n.y * m->x ) < 1e-5f ) {
+        is_parallel = true;
+        break;
+      }
+    }
+
+    if ( !is_parallel ) {
+      polygon->model_normals[polygon->normal_count] = n;
+      polygon->normals[polygon->normal_count]       = n;
+      polygon->normal_count++;
+    }
+  }
+
+  polygon->cos_angle = 1.0f;
+  polygon->is_dirty  = true;
+  Stds_UpdatePolygonBounds( polygon );
+}
+
+/**
+ * Recomputes the polygon's world AABB from its points.
+ *
+ * @param polygon_t pointer to a polygon.
+ *
+ * @return void.
+ */
+static void
+Stds_UpdatePolygonBounds( struct polygon_t *polygon ) {
+  float min_x = polygon->points[0].x, max_x = polygon->points[0].x;
+  float min_y = polygon->points[0].y, max_y = polygon->points[0].y;
+
+  for ( int32_t i = 1; i < polygon->sides; i++ ) {
+    min_x = fminf( min_x, polygon->points[i].x );
+    max_x = fmaxf( max_x, polygon->points[i].x );
+    min_y = fminf( min_y, polygon->points[i].y );
+    max_y = fmaxf( max_y, polygon->points[i].y );
+  }
+
+  polygon->aabb = ( SDL_FRect ){ min_x, min_y, max_x - min_x, max_y - min_y };
+}
+
+/**
+ * Takes a zeroed polygon_t from its pool.
+ *
+ * @param void.
+ *
+ * @return polygon_t * new polygon.
+ */
+static struct polygon_t *
+Stds_AllocPolygon( void ) {
+  if ( polygon_pool == NULL ) {
+    polygon_pool = Stds_PoolCreate( sizeof( struct polygon_t ), STDS_OBJECT_POOL_BLOCK );
+  }
+
+  return Stds_PoolAlloc( polygon_pool );
+}
@@ -0,0 +1,459 @@
+/**
+ * @file postfx.c
+ * @author Joshua Crotts
+ * @date October 14 2026
+ * @version 1.0
+ *
+ * @section LICENSE
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License as
+ * published by the Free Software Foundation; either version 2 of
+ * the License, or (at your option) any later version.
+ *
+ * @section DESCRIPTION
+ *
+ * This file defines render-target post-processing for lighting and bloom.
+ *
+ * A lightmap is cleared to an ambient color, light sprites are added into it
+ * in one batched submit, and the finished map multiplies the scene once.
+ * Lighting then costs one quad per light plus one screen of fill, rather
+ * than darkening every object with its own alpha or color mod. Its contents
+ * persist, so a scene whose lights did not change can apply it again without
+ * redrawing it.
+ *
+ * A bloom draws glowing things into a downsampled target, filters it down a
+ * short chain of smaller targets and adds every level back onto the screen.
+ * One soft additive layer replaces stacks of overlapping transparent quads
+ * such as glows and trail fades.
+ *
+ * Both draw with the usual Stds_ functions in screen or world coordinates:
+ * the renderer scale is set to match the target while it is bound. Targets
+ * cannot be switched while the draw delegate is recorded into a command
+ * buffer, or on renderers without render targets, so Stds_LightmapBegin and
+ * Stds_BloomBegin return false there and the effect is skipped.
+ */
+#include "../include/postfx.h"
+
+static SDL_Texture *Stds_CreatePostFXTarget( const int32_t w, const int32_t h,
+                                             const SDL_BlendMode mode );
+static void         Stds_BindPostFXTarget( SDL_Texture *target, SDL_Texture **previous,
+                                           const int32_t scale, const SDL_Color *clear );
+
+/**
+ * Creates a round light sprite: white, with an alpha that falls off
+ * smoothly from the center to the edge.
+ *
+ * @param int32_t radius of the light in pixels.
+ *
+ * @return SDL_Texture * pointer to the texture, or NULL if it could not be
+ *         created.
+ */
+SDL_Texture *
+Stds_CreateLightTexture( const int32_t radius ) {
+  const int32_t size    = radius * 2;
+  SDL_Surface * surface = SDL_CreateRGBSurfaceWithFormat( 0, size, size, 32,
+                                                         SDL_PIXELFORMAT_RGBA8888 );
+
+  if ( surface == NULL ) {
+    SDL_LogDebug( SDL_LOG_CATEGORY_APPLICATION, "Could not create light surface. %s.\n",
+                  SDL_GetError() );
+    return NULL;
+  }
+
+  for ( int32_t y = 0; y < size; y++ ) {
+    uint32_t *row = ( uint32_t * ) ( ( uint8_t * ) surface->pixels + y * surface->pitch );
+
+    for ( int32_t x = 0; x < size; x++ ) {
+      const float dx      = ( ( float ) x + 0.5f - ( float ) radius ) / ( float ) radius;
+      const float dy      = ( ( float ) y + 0.5f - ( float ) radius ) / ( float ) radius;
+      const float falloff = 1.0f - sqrtf( dx * dx + dy * dy );
+      const float alpha   = falloff > 0 ? falloff * falloff * 255.0f : 0;
+
+      row[x] = SDL_MapRGBA( surface->format, 0xff, 0xff, 0xff, ( uint8_t ) alpha );
+    }
+  }
+
+  SDL_Texture *texture = SDL_CreateTextureFromSurface( g_app.renderer, surface );
+  SDL_FreeSurface( surface );
+  return texture;
+}
+
+/**
+ * Creates a lightmap covering the screen. Smaller lightmaps are cheaper to
+ * fill and come out softer when stretched over the scene.
+ *
+ * @param int32_t the lightmap is 1 / scale of the screen on each side, 1 or
+ *        more.
+ * @param SDL_Color * color of the unlit scene; white leaves it unchanged and
+ *        black hides everything outside the lights.
+ *
+ * @return lightmap_t * pointer to the lightmap.
+ */
+struct lightmap_t *
+Stds_CreateLightmap( const int32_t scale, const SDL_Color *ambient ) {
+  struct lightmap_t *lightmap;
+  lightmap = malloc( sizeof( struct lightmap_t ) );
+
+  if ( lightmap == NULL ) {
+    SDL_LogInfo( SDL_LOG_CATEGORY_APPLICATION, "Could not allocate memory for lightmap_t. %s.\n",
+                 SDL_GetError() );
+    exit( EXIT_FAILURE );
+  }
+
+  memset( lightmap, 0, sizeof( struct lightmap_t ) );
+
+  lightmap->scale   = scale > 1 ? scale : 1;
+  lightmap->ambient = *ambient;
+  lightmap->texture = Stds_CreatePostFXTarget( g_app.SCREEN_WIDTH / lightmap->scale,
+                                               g_app.SCREEN_HEIGHT / lightmap->scale,
+                                               SDL_BLENDMODE_MOD );
+  lightmap->light_texture = Stds_CreateLightTexture( STDS_LIGHT_TEXTURE_RADIUS );
+
+  if ( lightmap->light_texture != NULL ) {
+    Stds_SetTextureBlendMode( lightmap->light_texture, SDL_BLENDMODE_ADD );
+  }
+
+  return lightmap;
+}
+
+/**
+ * Changes the color of the unlit scene. It takes effect with the next
+ * Stds_LightmapBegin.
+ *
+ * @param lightmap_t * pointer to the lightmap.
+ * @param SDL_Color * ambient color.
+ *
+ * @return void.
+ */
+void
+Stds_SetLightmapAmbient( struct lightmap_t *lightmap, const SDL_Color *ambient ) {
+  lightmap->ambient = *ambient;
+}
+
+/**
+ * Binds the lightmap as the render target and clears it to the ambient
+ * color. Draw the lights, then call Stds_LightmapEnd.
+ *
+ * @param lightmap_t * pointer to the lightmap.
+ *
+ * @return bool false if the lightmap cannot be drawn into right now, in which
+ *         case nothing must be drawn for it and Stds_LightmapEnd must not be
+ *         called.
+ */
+bool
+Stds_LightmapBegin( struct lightmap_t *lightmap ) {
+  if ( lightmap->texture == NULL || Stds_IsRecordingCommands() ) {
+    return false;
+  }
+
+  Stds_BindPostFXTarget( lightmap->texture, &lightmap->previous_target, lightmap->scale,
+                         &lightmap->ambient );
+  return true;
+}
+
+/**
+ * Adds lights into the bound lightmap with one batched submit. Lights
+ * entirely outside the screen are skipped.
+ *
+ * @param lightmap_t * pointer to the lightmap.
+ * @param SDL_Texture * light sprite, drawn additively, or NULL for the
+ *        lightmap's default round light.
+ * @param light_t * array of count lights.
+ * @param int32_t number of lights.
+ * @param bool applies the camera offset or not.
+ *
+ * @return void.
+ */
+void
+Stds_DrawLights( struct lightmap_t *lightmap, SDL_Texture *texture, const struct light_t *lights,
+                 const int32_t count, const bool camera_offset ) {
+  SDL_Texture *sprite = texture != NULL ? texture : lightmap->light_texture;
+  const float  cx     = camera_offset ? g_app.camera.x : 0;
+  const float  cy     = camera_offset ? g_app.camera.y : 0;
+
+  if ( sprite == NULL || count <= 0 ) {
+    return;
+  }
+
+  SDL_FRect *dst    = Stds_FrameAlloc( sizeof( SDL_FRect ) * ( size_t ) count );
+  SDL_Color *colors = Stds_FrameAlloc( sizeof( SDL_Color ) * ( size_t ) count );
+  int32_t    drawn  = 0;
+
+  for ( int32_t i = 0; i < count; i++ ) {
+    const struct light_t *l = &lights[i];
+
+    if ( l->x + l->radius < cx || l->y + l->radius < cy
+         || l->x - l->radius > cx + ( float ) g_app.SCREEN_WIDTH
+         || l->y - l->radius > cy + ( float ) g_app.SCREEN_HEIGHT ) {
+      continue;
+    }
+
+    dst[drawn] = ( SDL_FRect ){ l->x - l->radius, l->y - l->radius, l->radius * 2, l->radius * 2 };
+    colors[drawn] = l->color;
+    drawn++;
+  }
+
+  if ( texture != NULL ) {
+    Stds_SetTextureBlendMode( texture, SDL_BLENDMODE_ADD );
+  }
+
+  if ( drawn > 0 ) {
+    Stds_DrawQuads( sprite, dst, NULL, colors, drawn, camera_offset );
+  }
+}
+
+/**
+ * Restores the render target that was bound before Stds_LightmapBegin. The
+ * lightmap keeps its contents until the next Stds_LightmapBegin, so static
+ * lighting only needs to be drawn again when Stds_IsLightmapDrawn says the
+ * renderer lost them.
+ *
+ * @param lightmap_t * pointer to the lightmap.
+ *
+ * @return void.
+ */
+void
+Stds_LightmapEnd( struct lightmap_t *lightmap ) {
+  SDL_SetRenderTarget( g_app.renderer, lightmap->previous_target );
+  lightmap->is_drawn      = true;
+  lightmap->target_resets = g_app.target_resets;
+}
+
+/**
+ * Returns whether the lightmap holds lights drawn since the last time the
+ * renderer reset its render targets. Static lighting is drawn again when
+ * this is false.
+ *
+ * @param lightmap_t * pointer to the lightmap.
+ *
+ * @return bool true if the lightmap can be applied as it is.
+ */
+bool
+Stds_IsLightmapDrawn( struct lightmap_t *lightmap ) {
+  if ( lightmap->target_resets != g_app.target_resets ) {
+    lightmap->is_drawn = false;
+  }
+
+  return lightmap->is_drawn;
+}
+
+/**
+ * Multiplies everything drawn so far by the lightmap. Call it after the lit
+ * part of the scene and before anything that should stay unlit, like the UI.
+ *
+ * @param lightmap_t * pointer to the lightmap.
+ *
+ * @return void.
+ */
+void
+Stds_LightmapApply( struct lightmap_t *lightmap ) {
+  if ( Stds_IsLightmapDrawn( lightmap ) ) {
+    Stds_DrawTexture( lightmap->texture, 0, 0, ( float ) g_app.SCREEN_WIDTH,
+                      ( float ) g_app.SCREEN_HEIGHT, 0, SDL_FLIP_NONE, NULL, false );
+  }
+}
+
+/**
+ * Frees a lightmap and its textures.
+ *
+ * @param lightmap_t * pointer to the lightmap.
+ *
+ * @return void.
+ */
+void
+Stds_LightmapDie( struct lightmap_t *lightmap ) {
+  if ( lightmap->texture != NULL ) {
+    Stds_ForgetTextureState( lightmap->texture );
+    SDL_DestroyTexture( lightmap->texture );
+  }
+
+  if ( lightmap->light_texture != NULL ) {
+    Stds_ForgetTextureState( lightmap->light_texture );
+    SDL_DestroyTexture( lightmap->light_texture );
+  }
+
+  free( lightmap );
+}
+
+/**
+ * Creates a bloom covering the screen. Each level of the chain is half the
+ * size of the one before, so later levels spread the glow further.
+ *
+ * @param int32_t the first level is 1 / downsample of the screen on each
+ *        side, 1 or more.
+ * @param uint8_t alpha the levels are added onto the screen with.
+ *
+ * @return bloom_t * pointer to the bloom.
+ */
+struct bloom_t *
+Stds_CreateBloom( const int32_t downsample, const uint8_t intensity ) {
+  struct bloom_t *bloom;
+  bloom = malloc( sizeof( struct bloom_t ) );
+
+  if ( bloom == NULL ) {
+    SDL_LogInfo( SDL_LOG_CATEGORY_APPLICATION, "Could not allocate memory for bloom_t. %s.\n",
+                 SDL_GetError() );
+    exit( EXIT_FAILURE );
+  }
+
+  memset( bloom, 0, sizeof( struct bloom_t ) );
+
+  bloom->downsample = downsample > 1 ? downsample : 1;
+  bloom->intensity  = intensity;
+
+  for ( int32_t i = 0; i < STDS_BLOOM_LEVELS; i++ ) {
+    const int32_t divisor = bloom->downsample << i;
+    const int32_t w       = g_app.SCREEN_WIDTH / divisor;
+    const int32_t h       = g_app.SCREEN_HEIGHT / divisor;
+
+    bloom->levels[i] = Stds_CreatePostFXTarget( w > 0 ? w : 1, h > 0 ? h : 1, SDL_BLENDMODE_ADD );
+  }
+
+  return bloom;
+}
+
+/**
+ * Binds the first level of the bloom as the render target and clears it.
+ * Draw whatever should glow, then call Stds_BloomEnd.
+ *
+ * @param bloom_t * pointer to the bloom.
+ *
+ * @return bool false if the bloom cannot be drawn into right now, in which
+ *         case nothing must be drawn for it and Stds_BloomEnd must not be
+ *         called.
+ */
+bool
+Stds_BloomBegin( struct bloom_t *bloom ) {
+  const SDL_Color black = { 0, 0, 0, 0xff };
+
+  for ( int32_t i = 0; i < STDS_BLOOM_LEVELS; i++ ) {
+    if ( bloom->levels[i] == NULL ) {
+      return false;
+    }
+  }
+
+  if ( Stds_IsRecordingCommands() ) {
+    return false;
+  }
+
+  Stds_BindPostFXTarget( bloom->levels[0], &bloom->previous_target, bloom->downsample, &black );
+  return true;
+}
+
+/**
+ * Filters the first level down the rest of the chain, then restores the
+ * render target that was bound before Stds_BloomBegin.
+ *
+ * @param bloom_t * pointer to the bloom.
+ *
+ * @return void.
+ */
+void
+Stds_BloomEnd( struct bloom_t *bloom ) {
+  const SDL_Color black = { 0, 0, 0, 0xff };
+  SDL_Texture *   previous;
+
+  for ( int32_t i = 1; i < STDS_BLOOM_LEVELS; i++ ) {
+    Stds_BindPostFXTarget( bloom->levels[i], &previous, 1, &black );
+    Stds_SetTextureAlphaMod( bloom->levels[i - 1], 0xff );
+    SDL_RenderCopy( g_app.renderer, bloom->levels[i - 1], NULL, NULL );
+  }
+
+  SDL_SetRenderTarget( g_app.renderer, bloom->previous_target );
+  bloom->is_drawn = true;
+}
+
+/**
+ * Adds every level of the bloom onto the screen.
+ *
+ * @param bloom_t * pointer to the bloom.
+ *
+ * @return void.
+ */
+void
+Stds_BloomApply( struct bloom_t *bloom ) {
+  if ( !bloom->is_drawn ) {
+    return;
+  }
+
+  for ( int32_t i = 0; i < STDS_BLOOM_LEVELS; i++ ) {
+    Stds_SetTextureAlphaMod( bloom->levels[i], bloom->intensity );
+    Stds_DrawTexture( bloom->levels[i], 0, 0, ( float ) g_app.SCREEN_WIDTH,
+                      ( float ) g_app.SCREEN_HEIGHT, 0, SDL_FLIP_NONE, NULL, false );
+  }
+}
+
+/**
+ * Frees a bloom and its textures.
+ *
+ * @param bloom_t * pointer to the bloom.
+ *
+ * @return void.
+ */
+void
+Stds_BloomDie( struct bloom_t *bloom ) {
+  for ( int32_t i = 0; i < STDS_BLOOM_LEVELS; i++ ) {
+    if ( bloom->levels[i] != NULL ) {
+      Stds_ForgetTextureState( bloom->levels[i] );
+      SDL_DestroyTexture( bloom->levels[i] );
+    }
+  }
+
+  free( bloom );
+}
+
+/**
+ * Creates a render target for a post-processing pass. It is filtered
+ * linearly when the SDL version allows it, so stretching it stays smooth.
+ *
+ * @param int32_t width of the target.
+ * @param int32_t height of the target.
+ * @param SDL_BlendMode mode the target is drawn onto the screen with.
+ *
+ * @return SDL_Texture * pointer to the target, or NULL if the renderer has no
+ *         render targets.
+ */
+static SDL_Texture *
+Stds_CreatePostFXTarget( const int32_t w, const int32_t h, const SDL_BlendMode mode ) {
+  SDL_Texture *target = NULL;
+
+  if ( SDL_RenderTargetSupported( g_app.renderer ) ) {
+    target = SDL_CreateTexture( g_app.renderer, SDL_PIXELFORMAT_RGBA8888,
+                                SDL_TEXTUREACCESS_TARGET, w, h );
+  }
+
+  if ( target == NULL ) {
+    SDL_LogDebug( SDL_LOG_CATEGORY_APPLICATION,
+                  "Could not create post-processing target, skipping it. %s.\n",
+                  SDL_GetError() );
+    return NULL;
+  }
+
+#if SDL_VERSION_ATLEAST( 2, 0, 12 )
+  SDL_SetTextureScaleMode( target, SDL_ScaleModeLinear );
+#endif
+  Stds_SetTextureBlendMode( target, mode );
+  return target;
+}
+
+/**
+ * Binds a post-processing target, scales the renderer so screen coordinates
+ * cover it, and clears it.
+ *
+ * @param SDL_Texture * target to bind.
+ * @param SDL_Texture ** receives the target bound before it.
+ * @param int32_t the target is 1 / scale of the screen on each side.
+ * @param SDL_Color * clear color.
+ *
+ * @return void.
+ */
+static void
+Stds_BindPostFXTarget( SDL_Texture *target, SDL_Texture **previous, const int32_t scale,
+                       const SDL_Color *clear ) {
+  *previous = SDL_GetRenderTarget( g_app.renderer );
+  SDL_SetRenderTarget( g_app.renderer, target );
+  SDL_RenderSetScale( g_app.renderer, 1.0f / ( float ) scale, 1.0f / ( float ) scale );
+  Stds_SetDrawColor( clear );
+  SDL_RenderClear( g_app.renderer );
+}
@@ -0,0 +1,390 @@
+/**
+ * @file profiler.c
+ * @author Joshua Crotts
+ * @date October 14 2026
+ * @version 1.0
+ *
+ * @section LICENSE
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License as
+ * published by the Free Software Foundation; either version 2 of
+ * the License, or (at your option) any later version.
+ *
+ * @section DESCRIPTION
+ *
+ * This file defines the frame profiler. Named scopes are timed with the
+ * performance counter; each frame's totals go into a ring buffer of the last
+ * STDS_PROFILER_FRAMES frames, from which the debug overlay draws min, average
+ * and 99th percentile times. Individual scope events are kept as well, and
+ * can be exported as a Chrome trace (chrome://tracing or Perfetto).
+ *
+ * The profiler belongs to the thread that runs the frames. Markers hit on any
+ * other thread, e.g. in delegates run as a job in overlap mode, are ignored;
+ * time measured there is handed over with Stds_ProfilerAddJobScope.
+ */
+#include "../include/profiler.h"
+
+static struct profiler_t profiler;
+static SDL_threadID      profiler_thread;
+
+static void  Stds_ProfilerInit( void );
+static bool  Stds_IsProfilerThread( void );
+static void  Stds_ProfilerRecord( const int32_t scope, const uint64_t start, const uint64_t end,
+                                  const bool is_job );
+static float Stds_TicksToMs( const uint64_t ticks );
+static int   Stds_CompareFloats( const void *a, const void *b );
+
+/**
+ * Returns the id of the scope with the given name, registering it first if
+ * needed. The STDS_PROFILE_BEGIN macro caches the id per call site.
+ *
+ * @param const char * scope name.
+ *
+ * @return int32_t scope id, or -1 if STDS_PROFILER_MAX_SCOPES are in use or
+ * this is not the profiler's thread.
+ */
+int32_t
+Stds_ProfilerRegisterScope( const char *name ) {
+  if ( !Stds_IsProfilerThread() ) {
+    return -1;
+  }
+
+  Stds_ProfilerInit();
+
+  for ( int32_t i = 0; i < profiler.scope_count; i++ ) {
+    if ( strcmp( profiler.scope_names[i], name ) == 0 ) {
+      return i;
+    }
+  }
+
+  if ( profiler.scope_count == STDS_PROFILER_MAX_SCOPES ) {
+    SDL_LogDebug( SDL_LOG_CATEGORY_APPLICATION, "Profiler scope limit reached; ignoring %s.\n",
+                  name );
+    return -1;
+  }
+
+  int32_t id = profiler.scope_count++;
+  strncpy( profiler.scope_names[id], name, SMALL_TEXT_BUFFER - 1 );
+  return id;
+}
+
+/**
+ * Opens a timing scope. Scopes may nest up to STDS_PROFILER_MAX_DEPTH deep.
+ * Does nothing off the profiler's thread.
+ *
+ * @param int32_t scope id from Stds_ProfilerRegisterScope.
+ *
+ * @return void.
+ */
+void
+Stds_ProfilerBegin( const int32_t scope ) {
+  if ( scope < 0 || profiler.depth == STDS_PROFILER_MAX_DEPTH || !Stds_IsProfilerThread() ) {
+    return;
+  }
+
+  profiler.stack_scope[profiler.depth] = scope;
+  profiler.stack_start[profiler.depth] = SDL_GetPerformanceCounter();
+  profiler.depth++;
+}
+
+/**
+ * Closes the innermost timing scope, adding its time to the current frame
+ * and recording an event for trace export.
+ *
+ * @param int32_t scope id passed to the matching Stds_ProfilerBegin.
+ *
+ * @return void.
+ */
+void
+Stds_ProfilerEnd( const int32_t scope ) {
+  if ( scope < 0 || profiler.depth == 0 || profiler.stack_scope[profiler.depth - 1] != scope
+       || !Stds_IsProfilerThread() ) {
+    return;
+  }
+
+  uint64_t end   = SDL_GetPerformanceCounter();
+  uint64_t start = profiler.stack_start[--profiler.depth];
+
+  Stds_ProfilerRecord( scope, start, end, false );
+}
+
+/**
+ * Adds a scope that was timed on a job thread to the current frame, e.g. the
+ * update and draw delegates in overlap mode. Call it from the profiler's
+ * thread once the job is joined. The event is exported on its own trace row,
+ * since it overlaps the scopes of the frame's thread.
+ *
+ * @param int32_t scope id from Stds_ProfilerRegisterScope.
+ * @param uint64_t performance counter when the job's work started.
+ * @param uint64_t performance counter when the job's work ended.
+ *
+ * @return void.
+ */
+void
+Stds_ProfilerAddJobScope( const int32_t scope, const uint64_t start, const uint64_t end ) {
+  if ( scope < 0 || end < start || !Stds_IsProfilerThread() ) {
+    return;
+  }
+
+  Stds_ProfilerRecord( scope, start, end, true );
+}
+
+/**
+ * Starts a frame. Opens the built-in "frame" scope, which encloses every
+ * other scope of the frame.
+ *
+ * @param void.
+ *
+ * @return void.
+ */
+void
+Stds_ProfilerBeginFrame( void ) {
+  profiler_thread = SDL_ThreadID();
+  Stds_ProfilerInit();
+  profiler.depth = 0;
+  Stds_ProfilerBegin( 0 );
+}
+
+/**
+ * Ends a frame: closes the "frame" scope and moves to the next row of the
+ * ring buffer.
+ *
+ * @param void.
+ *
+ * @return void.
+ */
+void
+Stds_ProfilerEndFrame( void ) {
+  while ( profiler.depth > 1 ) {
+    Stds_ProfilerEnd( profiler.stack_scope[profiler.depth - 1] );
+  }
+  Stds_ProfilerEnd( 0 );
+
+  profiler.frame_index = ( profiler.frame_index + 1 ) % STDS_PROFILER_FRAMES;
+  memset( profiler.scope_ms[profiler.frame_index], 0, sizeof( profiler.scope_ms[0] ) );
+
+  if ( profiler.frame_count < STDS_PROFILER_FRAMES - 1 ) {
+    profiler.frame_count++;
+  }
+}
+
+/**
+ * Computes a scope's statistics over the completed frames in the ring buffer.
+ * Frames in which the scope did not run count as zero.
+ *
+ * @param int32_t scope id.
+ * @param float * receives the minimum milliseconds per frame.
+ * @param float * receives the average milliseconds per frame.
+ * @param float * receives the 99th percentile milliseconds per frame.
+ *
+ * @return void.
+ */
+void
+Stds_ProfilerGetStats( const int32_t scope, float *min_ms, float *avg_ms, float *p99_ms ) {
+  float samples[STDS_PROFILER_FRAMES];
+  float sum = 0;
+
+  *min_ms = *avg_ms = *p99_ms = 0;
+  if ( scope < 0 || scope >= profiler.scope_count || profiler.frame_count == 0 ) {
+    return;
+  }
+
+  for ( int32_t i = 0; i < profiler.frame_count; i++ ) {
+    int32_t row = ( profiler.frame_index - 1 - i + STDS_PROFILER_FRAMES ) % STDS_PROFILER_FRAMES;
+    samples[i]  = profiler.scope_ms[row][scope];
+    sum += samples[i];
+  }
+
+  qsort( samples, ( size_t ) profiler.frame_count, sizeof( float ), Stds_CompareFloats );
+
+  *min_ms = samples[0];
+  *avg_ms = sum / ( float ) profiler.frame_count;
+  *p99_ms = samples[( profiler.frame_count - 1 ) * 99 / 100];
+}
+
+/**
+ * Sets the font used for the overlay's labels. Without one, the overlay only
+ * draws bars.
+ *
+ * @param const char * path to a TTF font.
+ * @param uint16_t font size.
+ *
+ * @return void.
+ */
+void
+Stds_ProfilerSetFont( const char *font_path, const uint16_t font_size ) {
+  profiler.font_path = font_path;
+  profiler.font_size = font_size;
+}
+
+/**
+ * Draws one row per scope: a bar for the average time, a tick at the 99th
+ * percentile, and the min/avg/p99 milliseconds as text when a font is set.
+ * The bar scale is one 60 Hz frame (16.7 ms) per 200 pixels. The game loop
+ * calls this automatically while g_app.is_debug_mode is set.
+ *
+ * @param float x position of the overlay on the screen.
+ * @param float y position of the overlay on the screen.
+ *
+ * @return void.
+ */
+void
+Stds_ProfilerDrawOverlay( const float x, const float y ) {
+  const float     row_height = profiler.font_size > 0 ? profiler.font_size + 4.0f : 10.0f;
+  const float     bar_x      = profiler.font_path != NULL ? x + 360.0f : x + 8.0f;
+  const float     px_per_ms  = 200.0f / ( 1000.0f / 60.0f );
+  const SDL_Color background = { 0, 0, 0, 160 };
+  const SDL_Color bar_color  = { 80, 200, 120, 255 };
+  const SDL_Color p99_color  = { 230, 80, 60, 255 };
+  const SDL_Color text_color = { 255, 255, 255, 255 };
+
+  SDL_FRect panel = { x, y, bar_x - x + 216.0f, row_height * profiler.scope_count + 8.0f };
+  Stds_DrawRectF( &panel, &background, true, false );
+
+  for ( int32_t i = 0; i < profiler.scope_count; i++ ) {
+    float min_ms, avg_ms, p99_ms;
+    float row_y = y + 4.0f + row_height * i;
+
+    Stds_ProfilerGetStats( i, &min_ms, &avg_ms, &p99_ms );
+
+    if ( profiler.font_path != NULL ) {
+      Stds_DrawText( x + 4.0f, row_y, profiler.font_path, profiler.font_size, &text_color,
+                     "%-10.10s %6.2f %6.2f %6.2f", profiler.scope_names[i], min_ms, avg_ms,
+                     p99_ms );
+    }
+
+    SDL_FRect bar = { bar_x, row_y + 1.0f, fminf( avg_ms * px_per_ms, 200.0f ), row_height - 4.0f };
+    Stds_DrawRectF( &bar, &bar_color, true, false );
+
+    SDL_FRect tick = { bar_x + fminf( p99_ms * px_per_ms, 200.0f ), row_y, 2.0f, row_height - 2.0f };
+    Stds_DrawRectF( &tick, &p99_color, true, false );
+  }
+}
+
+/**
+ * Writes the recorded scope events, oldest first, as Chrome trace JSON.
+ *
+ * @param const char * path of the file to write.
+ *
+ * @return bool true on success.
+ */
+bool
+Stds_ProfilerExportChromeTrace( const char *file_path ) {
+  FILE *fptr = fopen( file_path, "w" );
+
+  if ( fptr == NULL ) {
+    SDL_LogInfo( SDL_LOG_CATEGORY_APPLICATION, "Could not open %s for the profiler trace.\n",
+                 file_path );
+    return false;
+  }
+
+  fprintf( fptr, "{\"traceEvents\":[\n" );
+
+  int32_t first = ( profiler.event_head - profiler.event_count + STDS_PROFILER_MAX_EVENTS ) %
+                  STDS_PROFILER_MAX_EVENTS;
+
+  for ( int32_t i = 0; i < profiler.event_count; i++ ) {
+    const struct profiler_event_t *e = &profiler.events[( first + i ) % STDS_PROFILER_MAX_EVENTS];
+
+    double ts  = ( double ) ( e->start - profiler.origin ) * 1e6 / ( double ) profiler.frequency;
+    double dur = ( double ) ( e->end - e->start ) * 1e6 / ( double ) profiler.frequency;
+
+    fprintf( fptr,
+             "%s{\"name\":\"%s\",\"ph\":\"X\",\"ts\":%.3f,\"dur\":%.3f,\"pid\":1,\"tid\":%d}",
+             i == 0 ? "" : ",\n", profiler.scope_names[e->scope], ts, dur, e->is_job ? 2 : 1 );
+  }
+
+  fprintf( fptr, "\n],\"displayTimeUnit\":\"ms\"}\n" );
+  fclose( fptr );
+
+  return true;
+}
+
+/**
+ * Reads the counter frequency and registers the built-in "frame" scope the
+ * first time the profiler is used.
+ *
+ * @param void.
+ *
+ * @return void.
+ */
+static void
+Stds_ProfilerInit( void ) {
+  if ( profiler.frequency != 0 ) {
+    return;
+  }
+
+  profiler.frequency = SDL_GetPerformanceFrequency();
+  profiler.origin    = SDL_GetPerformanceCounter();
+  Stds_ProfilerRegisterScope( "frame" );
+}
+
+/**
+ * Returns whether the calling thread owns the profiler: the thread that
+ * starts the frames, or any thread before the first frame.
+ *
+ * @param void.
+ *
+ * @return bool true if markers may be recorded on this thread.
+ */
+static bool
+Stds_IsProfilerThread( void ) {
+  return profiler_thread == 0 || SDL_ThreadID() == profiler_thread;
+}
+
+/**
+ * Adds a finished scope's time to the current frame and records an event
+ * for trace export.
+ *
+ * @param int32_t scope id.
+ * @param uint64_t performance counter at the start of the scope.
+ * @param uint64_t performance counter at the end of the scope.
+ * @param bool true if the scope ran on a job thread.
+ *
+ * @return void.
+ */
+static void
+Stds_ProfilerRecord( const int32_t scope, const uint64_t start, const uint64_t end,
+                     const bool is_job ) {
+  profiler.scope_ms[profiler.frame_index][scope] += Stds_TicksToMs( end - start );
+
+  struct profiler_event_t *e = &profiler.events[profiler.event_head];
+  e->scope                   = scope;
+  e->depth                   = profiler.depth;
+  e->start                   = start;
+  e->end                     = end;
+  e->is_job                  = is_job;
+
+  profiler.event_head = ( profiler.event_head + 1 ) % STDS_PROFILER_MAX_EVENTS;
+  if ( profiler.event_count < STDS_PROFILER_MAX_EVENTS ) {
+    profiler.event_count++;
+  }
+}
+
+/**
+ * Converts performance-counter ticks to milliseconds.
+ *
+ * @param uint64_t ticks.
+ *
+ * @return float milliseconds.
+ */
+static float
+Stds_TicksToMs( const uint64_t ticks ) {
+  return ( float ) ( ( double ) ticks * 1000.0 / ( double ) profiler.frequency );
+}
+
+/**
+ * qsort comparator for ascending floats.
+ *
+ * @param void * pointer to the first float.
+ * @param void * pointer to the second float.
+ *
+ * @return int negative, zero or positive.
+ */
+static int
+Stds_CompareFloats( const void *a, const void *b ) {
+  float fa = *( const float * ) a;
+  float fb = *( const float * ) b;
+  return ( fa > fb ) - ( fa < fb );
+}
@@ -0,0 +1,454 @@
+/**
+ * @file replay.c
+ * @author Joshua Crotts
+ * @date October 14 2026
+ * @version 1.0
+ *
+ * @section LICENSE
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License as
+ * published by the Free Software Foundation; either version 2 of
+ * the License, or (at your option) any later version.
+ *
+ * @section DESCRIPTION
+ *
+ * This file defines the input recorder and player. While recording, every event
+ * Stds_ProcessInput handles is written to a file with the frame it arrived in; a
+ * replay feeds the same events back frame by frame instead of polling SDL, so a
+ * session plays out identically across runs. All values are little-endian.
+ *
+ *   header   "STIR", version, reserved (0)                         (12 bytes)
+ *   frame    uint64_t frame time (IEEE double bits), int32_t mouse x, mouse y,
+ *            uint32_t event count, then that many events
+ *   event    uint32_t SDL event type, then its fields as 32-bit words: scancode,
+ *            sym, mod and repeat for keys; button, clicks, x and y for buttons;
+ *            x and y for the wheel; state, x, y, xrel and yrel for motion; or the
+ *            text bytes for text input. Quit events have no fields.
+ *
+ * The frame time is the clamped real time the fixed-timestep loop consumed, so a
+ * replay also takes the same number of update steps per frame. The lockstep loop
+ * records 0. While replaying, live events are drained, and only a quit gets through.
+ */
+#include "../include/replay.h"
+#include "../include/input_thread.h"
+
+static struct input_replay_t replay;
+static const char            replay_magic[4] = { 'S', 'T', 'I', 'R' };
+
+static bool Stds_IsRecordedEvent( const uint32_t );
+static void Stds_WriteReplayEvent( SDL_RWops *, const SDL_Event * );
+static bool Stds_ReadReplayEvent( SDL_RWops *, SDL_Event * );
+static bool Stds_BeginReplayFrame( void );
+static void Stds_EndReplay( void );
+
+/**
+ * Starts writing every processed input event to a file, replacing it. A
+ * recording already in progress is finished first.
+ *
+ * @param const char * path of the recording.
+ *
+ * @return bool true if the file could be opened.
+ */
+bool
+Stds_StartInputRecording( const char *file_path ) {
+  Stds_StopInputRecording();
+
+  SDL_RWops *rw = SDL_RWFromFile( file_path, "wb" );
+
+  if ( rw == NULL ) {
+    SDL_LogInfo( SDL_LOG_CATEGORY_APPLICATION, "Could not open %s for the recording. %s.\n",
+                 file_path, SDL_GetError() );
+    return false;
+  }
+
+  SDL_RWwrite( rw, replay_magic, 1, sizeof( replay_magic ) );
+  SDL_WriteLE32( rw, STDS_REPLAY_VERSION );
+  SDL_WriteLE32( rw, 0 );
+
+  replay.file        = rw;
+  replay.event_count = 0;
+  replay.frame_time  = 0;
+  return true;
+}
+
+/**
+ * Finishes the recording, writing the events of a frame still in progress.
+ *
+ * @param void.
+ *
+ * @return void.
+ */
+void
+Stds_StopInputRecording( void ) {
+  if ( replay.file == NULL ) {
+    return;
+  }
+
+  if ( replay.event_count > 0 ) {
+    Stds_EndInputFrame();
+  }
+
+  SDL_RWclose( replay.file );
+  free( replay.events );
+  replay.file           = NULL;
+  replay.events         = NULL;
+  replay.event_count    = 0;
+  replay.event_capacity = 0;
+}
+
+/**
+ * Starts feeding the events of a recording to Stds_ProcessInput in place of
+ * SDL's. When the recording runs out, input returns to SDL, or the game loop
+ * stops if is_quit_at_end is set.
+ *
+ * @param const char * path of the recording.
+ * @param bool true to stop the game loop after the last recorded frame.
+ *
+ * @return bool true if the recording could be read.
+ */
+bool
+Stds_StartInputReplay( const char *file_path, const bool is_quit_at_end ) {
+  size_t size;
+
+  Stds_StopInputReplay();
+  replay.data = SDL_LoadFile( file_path, &size );
+
+  if ( replay.data == NULL ) {
+    SDL_LogInfo( SDL_LOG_CATEGORY_APPLICATION, "Could not read recording %s. %s.\n", file_path,
+                 SDL_GetError() );
+    return false;
+  }
+
+  replay.rw   = SDL_RWFromConstMem( replay.data, ( int32_t ) size );
+  replay.size = ( Sint64 ) size;
+
+  char magic[4];
+  if ( replay.rw == NULL || size < 12 || SDL_RWread( replay.rw, magic, 1, 4 ) != 4
+       || memcmp( magic, replay_magic, 4 ) != 0
+       || SDL_ReadLE32( replay.rw ) != STDS_REPLAY_VERSION ) {
+    SDL_LogInfo( SDL_LOG_CATEGORY_APPLICATION, "%s is not a valid recording.\n", file_path );
+    Stds_StopInputReplay();
+    return false;
+  }
+
+  SDL_ReadLE32( replay.rw );
+  replay.is_frame_open  = false;
+  replay.is_quit_at_end = is_quit_at_end;
+  return true;
+}
+
+/**
+ * Stops a replay and returns input to SDL.
+ *
+ * @param void.
+ *
+ * @return void.
+ */
+void
+Stds_StopInputReplay( void ) {
+  if ( replay.rw != NULL ) {
+    SDL_RWclose( replay.rw );
+  }
+
+  SDL_free( replay.data );
+  replay.rw            = NULL;
+  replay.data          = NULL;
+  replay.size          = 0;
+  replay.events_left   = 0;
+  replay.is_frame_open = false;
+}
+
+/**
+ * Returns whether input comes from a recording.
+ *
+ * @param void.
+ *
+ * @return bool true while replaying.
+ */
+bool
+Stds_IsReplayingInput( void ) {
+  return replay.rw != NULL;
+}
+
+/**
+ * Passes the real time of a frame through the recorder. A recording stores
+ * it; a replay returns the recorded time instead, so the loop takes the same
+ * steps it took when recorded.
+ *
+ * @param double seconds of real time the frame consumes.
+ *
+ * @return double seconds the frame should consume.
+ */
+double
+Stds_ReplayFrameTime( const double frame_time ) {
+  if ( replay.rw != NULL ) {
+    return Stds_BeginReplayFrame() ? replay.frame_time : frame_time;
+  }
+
+  replay.frame_time = frame_time;
+  return frame_time;
+}
+
+/**
+ * Returns the next input event of this frame, like SDL_PollEvent. Events
+ * come from the recording while replaying, and are recorded while recording.
+ * Otherwise they come from the input thread while it runs, or from SDL.
+ *
+ * @param SDL_Event * event to fill in.
+ *
+ * @return int32_t 1 if there was an event, 0 otherwise.
+ */
+int32_t
+Stds_PollInputEvent( SDL_Event *event ) {
+  if ( replay.rw != NULL ) {
+    if ( Stds_BeginReplayFrame() && replay.events_left > 0 ) {
+      replay.events_left--;
+      if ( Stds_ReadReplayEvent( replay.rw, event ) ) {
+        return 1;
+      }
+      Stds_EndReplay();
+    }
+
+    while ( Stds_PollQueuedEvent( event ) ) {
+      if ( event->type == SDL_QUIT ) {
+        return 1;
+      }
+    }
+    return 0;
+  }
+
+  if ( Stds_PollQueuedEvent( event ) == 0 ) {
+    return 0;
+  }
+
+  if ( replay.file != NULL && Stds_IsRecordedEvent( event->type ) ) {
+    if ( replay.event_count == replay.event_capacity ) {
+      int32_t    capacity = replay.event_capacity == 0 ? 16 : replay.event_capacity * 2;
+      SDL_Event *events   = realloc( replay.events, sizeof( SDL_Event ) * ( size_t ) capacity );
+
+      if ( events == NULL ) {
+        SDL_LogInfo( SDL_LOG_CATEGORY_APPLICATION, "Could not allocate memory for SDL_Event. %s.\n",
+                     SDL_GetError() );
+        exit( EXIT_FAILURE );
+      }
+
+      replay.events         = events;
+      replay.event_capacity = capacity;
+    }
+
+    replay.events[replay.event_count++] = *event;
+  }
+
+  return 1;
+}
+
+/**
+ * Ends the input of a frame. A recording writes the frame with the current
+ * mouse position; a replay moves the mouse to the recorded position.
+ *
+ * @param void.
+ *
+ * @return void.
+ */
+void
+Stds_EndInputFrame( void ) {
+  if ( replay.rw != NULL ) {
+    if ( replay.is_frame_open ) {
+      g_app.mouse.x        = replay.mouse_x;
+      g_app.mouse.y        = replay.mouse_y;
+      replay.is_frame_open = false;
+    }
+    return;
+  }
+
+  if ( replay.file == NULL ) {
+    return;
+  }
+
+  uint64_t bits;
+  memcpy( &bits, &replay.frame_time, sizeof( bits ) );
+
+  SDL_WriteLE64( replay.file, bits );
+  SDL_WriteLE32( replay.file, ( uint32_t ) g_app.mouse.x );
+  SDL_WriteLE32( replay.file, ( uint32_t ) g_app.mouse.y );
+  SDL_WriteLE32( replay.file, ( uint32_t ) replay.event_count );
+  for ( int32_t i = 0; i < replay.event_count; i++ ) {
+    Stds_WriteReplayEvent( replay.file, &replay.events[i] );
+  }
+
+  replay.event_count = 0;
+  replay.frame_time  = 0;
+}
+
+/**
+ * Returns whether Stds_ProcessInput acts on events of a type.
+ *
+ * @param uint32_t SDL event type.
+ *
+ * @return bool true if events of the type are recorded.
+ */
+static bool
+Stds_IsRecordedEvent( const uint32_t type ) {
+  switch ( type ) {
+  case SDL_QUIT:
+  case SDL_KEYDOWN:
+  case SDL_KEYUP:
+  case SDL_MOUSEBUTTONDOWN:
+  case SDL_MOUSEBUTTONUP:
+  case SDL_MOUSEWHEEL:
+  case SDL_MOUSEMOTION:
+  case SDL_TEXTINPUT:
+    return true;
+  default:
+    return false;
+  }
+}
+
+/**
+ * Writes one event in the recording format.
+ *
+ * @param SDL_RWops * destination.
+ * @param SDL_Event * event to write.
+ *
+ * @return void.
+ */
+static void
+Stds_WriteReplayEvent( SDL_RWops *rw, const SDL_Event *e ) {
+  SDL_WriteLE32( rw, e->type );
+
+  switch ( e->type ) {
+  case SDL_KEYDOWN:
+  case SDL_KEYUP:
+    SDL_WriteLE32( rw, ( uint32_t ) e->key.keysym.scancode );
+    SDL_WriteLE32( rw, ( uint32_t ) e->key.keysym.sym );
+    SDL_WriteLE32( rw, e->key.keysym.mod );
+    SDL_WriteLE32( rw, e->key.repeat );
+    break;
+  case SDL_MOUSEBUTTONDOWN:
+  case SDL_MOUSEBUTTONUP:
+    SDL_WriteLE32( rw, e->button.button );
+    SDL_WriteLE32( rw, e->button.clicks );
+    SDL_WriteLE32( rw, ( uint32_t ) e->button.x );
+    SDL_WriteLE32( rw, ( uint32_t ) e->button.y );
+    break;
+  case SDL_MOUSEWHEEL:
+    SDL_WriteLE32( rw, ( uint32_t ) e->wheel.x );
+    SDL_WriteLE32( rw, ( uint32_t ) e->wheel.y );
+    break;
+  case SDL_MOUSEMOTION:
+    SDL_WriteLE32( rw, e->motion.state );
+    SDL_WriteLE32( rw, ( uint32_t ) e->motion.x );
+    SDL_WriteLE32( rw, ( uint32_t ) e->motion.y );
+    SDL_WriteLE32( rw, ( uint32_t ) e->motion.xrel );
+    SDL_WriteLE32( rw, ( uint32_t ) e->motion.yrel );
+    break;
+  case SDL_TEXTINPUT:
+    SDL_RWwrite( rw, e->text.text, 1, SDL_TEXTINPUTEVENT_TEXT_SIZE );
+    break;
+  default:
+    break;
+  }
+}
+
+/**
+ * Reads one event in the recording format.
+ *
+ * @param SDL_RWops * source.
+ * @param SDL_Event * event to fill in.
+ *
+ * @return bool true if a whole, known event was read.
+ */
+static bool
+Stds_ReadReplayEvent( SDL_RWops *rw, SDL_Event *e ) {
+  memset( e, 0, sizeof( SDL_Event ) );
+  e->type = SDL_ReadLE32( rw );
+
+  switch ( e->type ) {
+  case SDL_QUIT:
+    break;
+  case SDL_KEYDOWN:
+  case SDL_KEYUP:
+    e->key.keysym.scancode = ( SDL_Scancode ) SDL_ReadLE32( rw );
+    e->key.keysym.sym      = ( SDL_Keycode ) SDL_ReadLE32( rw );
+    e->key.keysym.mod      = ( Uint16 ) SDL_ReadLE32( rw );
+    e->key.repeat          = ( Uint8 ) SDL_ReadLE32( rw );
+    e->key.state           = e->type == SDL_KEYDOWN ? SDL_PRESSED : SDL_RELEASED;
+    break;
+  case SDL_MOUSEBUTTONDOWN:
+  case SDL_MOUSEBUTTONUP:
+    e->button.button = ( Uint8 ) SDL_ReadLE32( rw );
+    e->button.clicks = ( Uint8 ) SDL_ReadLE32( rw );
+    e->button.x      = ( Sint32 ) SDL_ReadLE32( rw );
+    e->button.y      = ( Sint32 ) SDL_ReadLE32( rw );
+    e->button.state  = e->type == SDL_MOUSEBUTTONDOWN ? SDL_PRESSED : SDL_RELEASED;
+    break;
+  case SDL_MOUSEWHEEL:
+    e->wheel.x = ( Sint32 ) SDL_ReadLE32( rw );
+    e->wheel.y = ( Sint32 ) SDL_ReadLE32( rw );
+    break;
+  case SDL_MOUSEMOTION:
+    e->motion.state = SDL_ReadLE32( rw );
+    e->motion.x     = ( Sint32 ) SDL_ReadLE32( rw );
+    e->motion.y     = ( Sint32 ) SDL_ReadLE32( rw );
+    e->motion.xrel  = ( Sint32 ) SDL_ReadLE32( rw );
+    e->motion.yrel  = ( Sint32 ) SDL_ReadLE32( rw );
+    break;
+  case SDL_TEXTINPUT:
+    SDL_RWread( rw, e->text.text, 1, SDL_TEXTINPUTEVENT_TEXT_SIZE );
+    e->text.text[SDL_TEXTINPUTEVENT_TEXT_SIZE - 1] = '\0';
+    break;
+  default:
+    return false;
+  }
+
+  return SDL_RWtell( rw ) <= replay.size;
+}
+
+/**
+ * Reads the header of the next recorded frame unless one is already open.
+ * The replay ends when no whole header is left.
+ *
+ * @param void.
+ *
+ * @return bool true if a frame is open.
+ */
+static bool
+Stds_BeginReplayFrame( void ) {
+  if ( replay.rw == NULL ) {
+    return false;
+  }
+
+  if ( replay.is_frame_open ) {
+    return true;
+  }
+
+  if ( replay.size - SDL_RWtell( replay.rw ) < STDS_REPLAY_FRAME_SIZE ) {
+    Stds_EndReplay();
+    return false;
+  }
+
+  uint64_t bits = SDL_ReadLE64( replay.rw );
+  memcpy( &replay.frame_time, &bits, sizeof( bits ) );
+  replay.mouse_x       = ( int32_t ) SDL_ReadLE32( replay.rw );
+  replay.mouse_y       = ( int32_t ) SDL_ReadLE32( replay.rw );
+  replay.events_left   = SDL_ReadLE32( replay.rw );
+  replay.is_frame_open = true;
+  return true;
+}
+
+/**
+ * Ends a replay that ran out of frames, stopping the game loop if asked to.
+ *
+ * @param void.
+ *
+ * @return void.
+ */
+static void
+Stds_EndReplay( void ) {
+  SDL_LogDebug( SDL_LOG_CATEGORY_APPLICATION, "Input replay finished." );
+  if ( replay.is_quit_at_end ) {
+    g_app.is_running = false;
+  }
+  Stds_StopInputReplay();
+}
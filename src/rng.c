@@ -0,0 +1,311 @@
+/**
+ * @file rng.c
+ * @author Joshua Crotts
+ * @date October 14 2026
+ * @version 1.0
+ *
+ * @section LICENSE
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License as
+ * published by the Free Software Foundation; either version 2 of
+ * the License, or (at your option) any later version.
+ *
+ * @section DESCRIPTION
+ *
+ * This file defines explicit xoshiro128+ random number generators. A generator
+ * is seeded through splitmix64, so any 64-bit seed gives a good state, and the
+ * same seed always gives the same sequence. Stds_RngFillFloats steps
+ * STDS_RNG_LANES independent streams at once with the vector instruction set
+ * selected in simd.h; every build produces the same lane sequences.
+ *
+ * Each thread also gets its own generator from Stds_GetThreadRng, so job
+ * workers draw numbers without sharing state. The threads' generators derive
+ * from the Stds_SeedRandom seed in the order the threads first ask for one.
+ */
+#include "../include/rng.h"
+
+static SDL_TLSID    rng_slot;
+static SDL_atomic_t rng_threads;
+static SDL_atomic_t rng_generation;
+static uint64_t     rng_seed;
+
+static uint64_t Stds_SplitMix64( uint64_t * );
+static void     Stds_RngStepLanes( struct rng_t *, uint32_t * );
+
+/**
+ * Seeds a generator. Its scalar stream and every batch lane get distinct
+ * states derived from the seed.
+ *
+ * @param rng_t * generator.
+ * @param uint64_t seed.
+ *
+ * @return void.
+ */
+void
+Stds_RngSeed( struct rng_t *rng, const uint64_t seed ) {
+  uint64_t x = seed;
+
+  for ( int32_t k = 0; k < 4; k += 2 ) {
+    uint64_t z = Stds_SplitMix64( &x );
+    rng->s[k]     = ( uint32_t ) z;
+    rng->s[k + 1] = ( uint32_t ) ( z >> 32 );
+  }
+
+  for ( int32_t l = 0; l < STDS_RNG_LANES; l++ ) {
+    for ( int32_t k = 0; k < 4; k += 2 ) {
+      uint64_t z = Stds_SplitMix64( &x );
+      rng->lanes[k][l]     = ( uint32_t ) z;
+      rng->lanes[k + 1][l] = ( uint32_t ) ( z >> 32 );
+    }
+  }
+}
+
+/**
+ * Returns the next 32 random bits of the scalar stream. The upper bits are
+ * the strongest; the lowest few are weaker, as with every xoshiro+ variant.
+ *
+ * @param rng_t * generator.
+ *
+ * @return uint32_t random bits.
+ */
+uint32_t
+Stds_RngNext( struct rng_t *rng ) {
+  uint32_t *     s      = rng->s;
+  const uint32_t result = s[0] + s[3];
+  const uint32_t t      = s[1] << 9;
+
+  s[2] ^= s[0];
+  s[3] ^= s[1];
+  s[1] ^= s[2];
+  s[0] ^= s[3];
+  s[2] ^= t;
+  s[3] = ( s[3] << 11 ) | ( s[3] >> 21 );
+
+  return result;
+}
+
+/**
+ * Returns a random integer in [min, max], inclusive. The range is mapped
+ * with a multiply instead of a modulo, so it uses the strong upper bits.
+ *
+ * @param rng_t * generator.
+ * @param int32_t minimum number to choose from.
+ * @param int32_t maximum number to choose from.
+ *
+ * @return int32_t random number in the set [min, max].
+ */
+int32_t
+Stds_RngInt( struct rng_t *rng, const int32_t min, const int32_t max ) {
+  const uint32_t range = ( uint32_t ) max - ( uint32_t ) min + 1;
+  const uint32_t r     = Stds_RngNext( rng );
+
+  if ( range == 0 ) {
+    return ( int32_t ) r;
+  }
+
+  return ( int32_t ) ( ( uint32_t ) min + ( uint32_t ) ( ( ( uint64_t ) r * range ) >> 32 ) );
+}
+
+/**
+ * Returns a random float in [min, max), with 24 bits of randomness.
+ *
+ * @param rng_t * generator.
+ * @param float minimum number to choose from.
+ * @param float maximum number.
+ *
+ * @return float random number in the set [min, max).
+ */
+float
+Stds_RngFloat( struct rng_t *rng, const float min, const float max ) {
+  return min + ( float ) ( Stds_RngNext( rng ) >> 8 ) * ( 1.0f / 16777216.0f ) * ( max - min );
+}
+
+/**
+ * Fills an array with random floats in [min, max). The batch lanes produce
+ * STDS_RNG_LANES numbers per step, in vector registers where available, so
+ * this is much cheaper per number than calling Stds_RngFloat in a loop.
+ * It does not advance the scalar stream.
+ *
+ * @param rng_t * generator.
+ * @param float * array of at least count floats.
+ * @param int32_t number of floats to write.
+ * @param float minimum number to choose from.
+ * @param float maximum number.
+ *
+ * @return void.
+ */
+void
+Stds_RngFillFloats( struct rng_t *rng, float *out, const int32_t count, const float min,
+                    const float max ) {
+  const float scale = ( max - min ) * ( 1.0f / 16777216.0f );
+  int32_t     i     = 0;
+
+#if defined( STDS_SIMD_SSE2 )
+  __m128i      s0 = _mm_loadu_si128( ( const __m128i * ) rng->lanes[0] );
+  __m128i      s1 = _mm_loadu_si128( ( const __m128i * ) rng->lanes[1] );
+  __m128i      s2 = _mm_loadu_si128( ( const __m128i * ) rng->lanes[2] );
+  __m128i      s3 = _mm_loadu_si128( ( const __m128i * ) rng->lanes[3] );
+  const __m128 vs = _mm_set1_ps( scale );
+  const __m128 vm = _mm_set1_ps( min );
+
+  for ( ; i + 4 <= count; i += 4 ) {
+    const __m128i r = _mm_add_epi32( s0, s3 );
+    const __m128i t = _mm_slli_epi32( s1, 9 );
+
+    s2 = _mm_xor_si128( s2, s0 );
+    s3 = _mm_xor_si128( s3, s1 );
+    s1 = _mm_xor_si128( s1, s2 );
+    s0 = _mm_xor_si128( s0, s3 );
+    s2 = _mm_xor_si128( s2, t );
+    s3 = _mm_or_si128( _mm_slli_epi32( s3, 11 ), _mm_srli_epi32( s3, 21 ) );
+
+    const __m128 f = _mm_cvtepi32_ps( _mm_srli_epi32( r, 8 ) );
+    _mm_storeu_ps( out + i, _mm_add_ps( _mm_mul_ps( f, vs ), vm ) );
+  }
+
+  _mm_storeu_si128( ( __m128i * ) rng->lanes[0], s0 );
+  _mm_storeu_si128( ( __m128i * ) rng->lanes[1], s1 );
+  _mm_storeu_si128( ( __m128i * ) rng->lanes[2], s2 );
+  _mm_storeu_si128( ( __m128i * ) rng->lanes[3], s3 );
+#elif defined( STDS_SIMD_NEON )
+  uint32x4_t        s0 = vld1q_u32( rng->lanes[0] );
+  uint32x4_t        s1 = vld1q_u32( rng->lanes[1] );
+  uint32x4_t        s2 = vld1q_u32( rng->lanes[2] );
+  uint32x4_t        s3 = vld1q_u32( rng->lanes[3] );
+  const float32x4_t vs = vdupq_n_f32( scale );
+  const float32x4_t vm = vdupq_n_f32( min );
+
+  for ( ; i + 4 <= count; i += 4 ) {
+    const uint32x4_t r = vaddq_u32( s0, s3 );
+    const uint32x4_t t = vshlq_n_u32( s1, 9 );
+
+    s2 = veorq_u32( s2, s0 );
+    s3 = veorq_u32( s3, s1 );
+    s1 = veorq_u32( s1, s2 );
+    s0 = veorq_u32( s0, s3 );
+    s2 = veorq_u32( s2, t );
+    s3 = vorrq_u32( vshlq_n_u32( s3, 11 ), vshrq_n_u32( s3, 21 ) );
+
+    const float32x4_t f = vcvtq_f32_u32( vshrq_n_u32( r, 8 ) );
+    vst1q_f32( out + i, vaddq_f32( vmulq_f32( f, vs ), vm ) );
+  }
+
+  vst1q_u32( rng->lanes[0], s0 );
+  vst1q_u32( rng->lanes[1], s1 );
+  vst1q_u32( rng->lanes[2], s2 );
+  vst1q_u32( rng->lanes[3], s3 );
+#endif
+
+  /* The scalar build, and the tail of the vector ones, step the lanes one at a time. */
+  while ( i < count ) {
+    uint32_t r[STDS_RNG_LANES];
+    Stds_RngStepLanes( rng, r );
+
+    for ( int32_t l = 0; l < STDS_RNG_LANES && i < count; l++, i++ ) {
+      out[i] = ( float ) ( r[l] >> 8 ) * scale + min;
+    }
+  }
+}
+
+/**
+ * Seeds the generators of every thread. The calling thread's next
+ * Stds_GetThreadRng uses the seed as is if it is the first to ask; later
+ * threads get seeds derived from it. Call this from the main thread while
+ * no jobs are running.
+ *
+ * @param uint64_t seed.
+ *
+ * @return void.
+ */
+void
+Stds_SeedRandom( const uint64_t seed ) {
+  if ( rng_slot == 0 ) {
+    rng_slot = SDL_TLSCreate();
+  }
+
+  rng_seed = seed;
+  SDL_AtomicSet( &rng_threads, 0 );
+  SDL_AtomicIncRef( &rng_generation );
+}
+
+/**
+ * Returns the calling thread's generator, creating or reseeding it after
+ * Stds_SeedRandom. It must not be handed to another thread.
+ *
+ * @param void.
+ *
+ * @return rng_t * generator of this thread.
+ */
+struct rng_t *
+Stds_GetThreadRng( void ) {
+  if ( rng_slot == 0 ) {
+    rng_slot = SDL_TLSCreate();
+  }
+
+  struct thread_rng_t *t = SDL_TLSGet( rng_slot );
+
+  if ( t == NULL ) {
+    t = malloc( sizeof( struct thread_rng_t ) );
+
+    if ( t == NULL ) {
+      SDL_LogInfo( SDL_LOG_CATEGORY_APPLICATION,
+                   "Could not allocate memory for thread_rng_t. %s.\n", SDL_GetError() );
+      exit( EXIT_FAILURE );
+    }
+
+    t->generation = -1;
+    SDL_TLSSet( rng_slot, t, free );
+  }
+
+  const int32_t generation = SDL_AtomicGet( &rng_generation );
+
+  if ( t->generation != generation ) {
+    t->index      = SDL_AtomicAdd( &rng_threads, 1 );
+    t->generation = generation;
+    Stds_RngSeed( &t->rng, rng_seed ^ ( ( uint64_t ) t->index * 0x9e3779b97f4a7c15ull ) );
+  }
+
+  return &t->rng;
+}
+
+/**
+ * Returns the next output of splitmix64, used to expand seeds.
+ *
+ * @param uint64_t * splitmix64 state.
+ *
+ * @return uint64_t random bits.
+ */
+static uint64_t
+Stds_SplitMix64( uint64_t *x ) {
+  uint64_t z = ( *x += 0x9e3779b97f4a7c15ull );
+
+  z = ( z ^ ( z >> 30 ) ) * 0xbf58476d1ce4e5b9ull;
+  z = ( z ^ ( z >> 27 ) ) * 0x94d049bb133111ebull;
+  return z ^ ( z >> 31 );
+}
+
+/**
+ * Steps every batch lane once and writes their outputs.
+ *
+ * @param rng_t * generator.
+ * @param uint32_t * STDS_RNG_LANES outputs.
+ *
+ * @return void.
+ */
+static void
+Stds_RngStepLanes( struct rng_t *rng, uint32_t *out ) {
+  uint32_t( *s )[STDS_RNG_LANES] = rng->lanes;
+
+  for ( int32_t l = 0; l < STDS_RNG_LANES; l++ ) {
+    const uint32_t t = s[1][l] << 9;
+
+    out[l] = s[0][l] + s[3][l];
+    s[2][l] ^= s[0][l];
+    s[3][l] ^= s[1][l];
+    s[1][l] ^= s[2][l];
+    s[0][l] ^= s[3][l];
+    s[2][l] ^= t;
+    s[3][l] = ( s[3][l] << 11 ) | ( s[3][l] >> 21 );
+  }
+}
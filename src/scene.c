@@ -0,0 +1,349 @@
+/**
+ * @file scene.c
+ * @author Joshua Crotts
+ * @date October 14 2026
+ * @version 1.0
+ *
+ * @section LICENSE
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License as
+ * published by the Free Software Foundation; either version 2 of
+ * the License, or (at your option) any later version.
+ *
+ * @section DESCRIPTION
+ *
+ * This file defines the scene stack. A scene bundles an update and draw delegate with
+ * a resource scope: every texture it loads through Stds_SceneLoadTexture or
+ * Stds_ScenePreloadTexture holds a reference in the texture cache until the scene is
+ * popped, so shared textures are loaded once and a scene's own textures become
+ * evictable as soon as it is gone. Stds_PreloadScene runs a scene's preload hook
+ * while another scene is still playing; its textures decode on the asset loader's
+ * threads, and pushing the scene only waits for whatever has not arrived yet.
+ *
+ * Only the top scene runs. The scenes below it keep their resources, so popping a
+ * pause menu returns to the game without reloading anything. A pushed scene belongs
+ * to the stack, which frees it when it is popped.
+ */
+#include "../include/scene.h"
+
+static struct scene_stack_t stack;
+
+static void Stds_SceneRetain( struct scene_t *scene, const int32_t texture );
+static void Stds_FinishSceneAssets( struct scene_t *scene, const bool is_blocking );
+static void Stds_GrowSceneArray( int32_t **array, int32_t *capacity );
+
+/**
+ * Creates a scene with the given delegate and an empty resource scope. Set
+ * its preload, enter and leave hooks and its data before pushing it.
+ *
+ * @param void (*)( void ) update function.
+ * @param void (*)( void ) draw function.
+ *
+ * @return scene_t * pointer to the scene.
+ */
+struct scene_t *
+Stds_CreateScene( void ( *update )( void ), void ( *draw )( void ) ) {
+  struct scene_t *scene;
+  scene = malloc( sizeof( struct scene_t ) );
+
+  if ( scene == NULL ) {
+    SDL_LogInfo( SDL_LOG_CATEGORY_APPLICATION, "Could not allocate memory for scene_t. %s.\n",
+                 SDL_GetError() );
+    exit( EXIT_FAILURE );
+  }
+
+  memset( scene, 0, sizeof( struct scene_t ) );
+  scene->delegate.update = update;
+  scene->delegate.draw   = draw;
+
+  return scene;
+}
+
+/**
+ * Loads a texture right away and adds it to the scene's scope. Loading the
+ * same texture again from the scene takes no further reference.
+ *
+ * @param scene_t * pointer to the scene.
+ * @param const char * path to the image.
+ *
+ * @return SDL_Texture * the texture, valid while the scene lives.
+ */
+SDL_Texture *
+Stds_SceneLoadTexture( struct scene_t *scene, const char *file_name ) {
+  const int32_t handle = Stds_TextureHandle( file_name );
+
+  Stds_SceneRetain( scene, handle );
+  return Stds_TextureFromHandle( handle );
+}
+
+/**
+ * Queues a texture on the asset loader and adds it to the scene's scope
+ * once it arrives. Meant for the preload hook.
+ *
+ * @param scene_t * pointer to the scene.
+ * @param const char * path to the image.
+ *
+ * @return int32_t handle of the loader request.
+ */
+int32_t
+Stds_ScenePreloadTexture( struct scene_t *scene, const char *file_name ) {
+  const int32_t request = Stds_LoadTextureAsync( file_name );
+
+  Stds_SceneAwaitAsset( scene, request );
+  return request;
+}
+
+/**
+ * Makes the scene wait for any loader request, such as a sound or font,
+ * before it is considered loaded. Textures among them join its scope.
+ *
+ * @param scene_t * pointer to the scene.
+ * @param int32_t handle of the loader request.
+ *
+ * @return void.
+ */
+void
+Stds_SceneAwaitAsset( struct scene_t *scene, const int32_t request ) {
+  if ( scene->pending_count == scene->pending_capacity ) {
+    Stds_GrowSceneArray( &scene->pending, &scene->pending_capacity );
+  }
+
+  scene->pending[scene->pending_count++] = request;
+}
+
+/**
+ * Runs the scene's preload hook, if it has one and it has not run yet, so
+ * its assets load in the background while the current scene plays.
+ *
+ * @param scene_t * pointer to the scene.
+ *
+ * @return void.
+ */
+void
+Stds_PreloadScene( struct scene_t *scene ) {
+  if ( scene->is_preloaded ) {
+    return;
+  }
+
+  scene->is_preloaded = true;
+  if ( scene->preload != NULL ) {
+    scene->preload( scene );
+  }
+}
+
+/**
+ * Returns whether every asset the scene waits for has arrived. Polling this
+ * each frame while a scene preloads also pins its textures as they arrive,
+ * so a full texture cache cannot evict them before the scene is pushed.
+ *
+ * @param scene_t * pointer to the scene.
+ *
+ * @return bool true if nothing is pending.
+ */
+bool
+Stds_IsSceneLoaded( struct scene_t *scene ) {
+  Stds_FinishSceneAssets( scene, false );
+  return scene->pending_count == 0;
+}
+
+/**
+ * Pushes a scene on top of the stack and makes its delegate the running
+ * one. The scene is preloaded if it was not already, and pushing blocks
+ * until its remaining assets have arrived. The stack takes ownership.
+ *
+ * @param scene_t * pointer to the scene.
+ *
+ * @return bool true if pushed, false if the stack is full.
+ */
+bool
+Stds_PushScene( struct scene_t *scene ) {
+  if ( stack.count == STDS_SCENE_STACK_SIZE ) {
+    SDL_LogInfo( SDL_LOG_CATEGORY_APPLICATION, "Scene stack is full.\n" );
+    return false;
+  }
+
+  Stds_PreloadScene( scene );
+  Stds_FinishSceneAssets( scene, true );
+
+  stack.scenes[stack.count++] = scene;
+  g_app.delegate              = scene->delegate;
+
+  if ( scene->enter != NULL ) {
+    scene->enter( scene );
+  }
+
+  return true;
+}
+
+/**
+ * Pops the top scene, runs its leave hook and frees it along with the
+ * references in its scope. The scene below resumes. An update delegate
+ * may pop its own scene, as long as it does not touch the scene after.
+ *
+ * @param void.
+ *
+ * @return void.
+ */
+void
+Stds_PopScene( void ) {
+  if ( stack.count == 0 ) {
+    return;
+  }
+
+  struct scene_t *scene = stack.scenes[--stack.count];
+
+  if ( scene->leave != NULL ) {
+    scene->leave( scene );
+  }
+
+  Stds_SceneDie( scene );
+
+  if ( stack.count > 0 ) {
+    g_app.delegate = stack.scenes[stack.count - 1]->delegate;
+  }
+}
+
+/**
+ * Replaces the top scene. The new scene takes its references before the
+ * old one gives its own back, so textures both use are never unloaded.
+ *
+ * @param scene_t * pointer to the scene.
+ *
+ * @return bool true if the scene was pushed.
+ */
+bool
+Stds_SwitchScene( struct scene_t *scene ) {
+  Stds_PreloadScene( scene );
+  Stds_FinishSceneAssets( scene, true );
+
+  Stds_PopScene();
+  return Stds_PushScene( scene );
+}
+
+/**
+ * Returns the scene on top of the stack.
+ *
+ * @param void.
+ *
+ * @return scene_t * the running scene, or NULL if the stack is empty.
+ */
+struct scene_t *
+Stds_GetScene( void ) {
+  return stack.count > 0 ? stack.scenes[stack.count - 1] : NULL;
+}
+
+/**
+ * Pops every scene, top first.
+ *
+ * @param void.
+ *
+ * @return void.
+ */
+void
+Stds_ClearScenes( void ) {
+  while ( stack.count > 0 ) {
+    Stds_PopScene();
+  }
+}
+
+/**
+ * Gives back the references in a scene's scope and frees it. Use this for
+ * scenes that were never pushed; the stack frees the ones it pops. Assets
+ * still loading finish into the cache without a reference.
+ *
+ * @param scene_t * pointer to the scene.
+ *
+ * @return void.
+ */
+void
+Stds_SceneDie( struct scene_t *scene ) {
+  for ( int32_t i = 0; i < scene->texture_count; i++ ) {
+    Stds_ReleaseTextureHandle( scene->textures[i] );
+  }
+
+  free( scene->textures );
+  free( scene->pending );
+  free( scene );
+}
+
+/**
+ * Adds a texture to a scene's scope, taking a reference unless the scene
+ * already holds one.
+ *
+ * @param scene_t * pointer to the scene.
+ * @param int32_t texture handle.
+ *
+ * @return void.
+ */
+static void
+Stds_SceneRetain( struct scene_t *scene, const int32_t texture ) {
+  if ( texture < 0 ) {
+    return;
+  }
+
+  for ( int32_t i = 0; i < scene->texture_count; i++ ) {
+    if ( scene->textures[i] == texture ) {
+      return;
+    }
+  }
+
+  if ( scene->texture_count == scene->texture_capacity ) {
+    Stds_GrowSceneArray( &scene->textures, &scene->texture_capacity );
+  }
+
+  Stds_RetainTextureHandle( texture );
+  scene->textures[scene->texture_count++] = texture;
+}
+
+/**
+ * Moves finished loader requests out of the pending list, adding textures
+ * to the scope. Blocking waits for every request instead of only checking.
+ *
+ * @param scene_t * pointer to the scene.
+ * @param bool true to wait for unfinished requests.
+ *
+ * @return void.
+ */
+static void
+Stds_FinishSceneAssets( struct scene_t *scene, const bool is_blocking ) {
+  for ( int32_t i = 0; i < scene->pending_count; ) {
+    const int32_t request = scene->pending[i];
+    const int32_t state
+        = is_blocking ? Stds_WaitForAsset( request ) : Stds_GetAssetState( request );
+
+    if ( state < STDS_ASSET_READY ) {
+      i++;
+      continue;
+    }
+
+    if ( state == STDS_ASSET_READY ) {
+      Stds_SceneRetain( scene, Stds_GetAssetTextureHandle( request ) );
+    }
+
+    scene->pending[i] = scene->pending[--scene->pending_count];
+  }
+}
+
+/**
+ * Doubles the capacity of one of a scene's handle arrays.
+ *
+ * @param int32_t ** the array.
+ * @param int32_t * its capacity.
+ *
+ * @return void.
+ */
+static void
+Stds_GrowSceneArray( int32_t **array, int32_t *capacity ) {
+  const int32_t n     = *capacity == 0 ? 16 : *capacity * 2;
+  int32_t *     grown = realloc( *array, sizeof( int32_t ) * ( size_t ) n );
+
+  if ( grown == NULL ) {
+    SDL_LogInfo( SDL_LOG_CATEGORY_APPLICATION, "Could not allocate memory for scene_t. %s.\n",
+                 SDL_GetError() );
+    exit( EXIT_FAILURE );
+  }
+
+  *array    = grown;
+  *capacity = n;
+}
@@ -14,12 +14,35 @@
  * @section DESCRIPTION
  * 
  * This file defines the SDL sound mixer initialization, and how to play/pause both sound
- * effects and music.
+ * effects and music. Sound effects played on CH_ANY go through a voice manager: each
+ * sound plays at most once per frame and on at most its voice limit of channels, and
+ * when every channel is busy, a new sound takes over the oldest voice of equal or
+ * lower priority. Music streams from its file as it plays; sound effects are decoded
+ * whole, so long loops and ambience belong in music.
+ *
+ * Sound effects added with Stds_RegisterSFX keep only their encoded bytes until they
+ * first play. Once decoded chunks exceed the memory budget, the least recently played
+ * ones that are not playing or pinned are freed, and decode again on their next play.
+ * Stds_PreloadSFX decodes a sound ahead of time for when the first play cannot wait.
+ *
+ * The mixer opens at startup with STDS_INIT_AUDIO, or at the first sound loaded or
+ * played with STDS_INIT_LAZY_AUDIO. With neither, sound calls do nothing.
  */
 #include "../include/sound.h"
+#include "../include/pack.h"
+
+static struct voice_manager_t   voice_manager;
+static struct sound_registry_t sound_registry;
+static bool                    is_audio_open;
+
+static int32_t    Stds_ChooseVoice( const int16_t );
+static Mix_Chunk *Stds_DecodeSFX( const int16_t );
+static void       Stds_EvictSFX( const int16_t );
+static bool       Stds_IsChunkPlaying( const Mix_Chunk * );
 
 /**
- * Initializes the sound context for SDL.
+ * Initializes the sound context for SDL, opening the mixer right away if the
+ * init configuration asks for STDS_INIT_AUDIO.
  *
  * @param void.
  *
@@ -27,13 +50,94 @@
  */
 void
 Stds_InitAudio( void ) {
-  g_app.sounds = malloc( sizeof( Mix_Chunk * ) * SND_MAX );
-  g_app.music  = NULL;
-  memset( g_app.sounds, 0, sizeof( Mix_Chunk * ) * SND_MAX );
+  g_app.sounds  = NULL;
+  g_app.music   = NULL;
+  is_audio_open = false;
+  memset( &voice_manager, 0, sizeof( struct voice_manager_t ) );
+  memset( &sound_registry, 0, sizeof( struct sound_registry_t ) );
+  sound_registry.budget = SFX_MEMORY_BUDGET;
+
+  for ( int32_t i = 0; i < SND_MAX; i++ ) {
+    voice_manager.sounds[i].max_voices = SFX_DEFAULT_VOICES;
+  }
+
+  if ( g_app.init_config.subsystems & STDS_INIT_AUDIO ) {
+    Stds_OpenAudio();
+  }
 }
 
 /**
- * Loads a music file from the respective path.
+ * Opens the mixer with the init configuration's format, and allocates the
+ * sound effect table, unless that is already done. Sound functions call this
+ * themselves; call it early to keep the mixer's start-up cost out of the
+ * first sound of a lazily opened context.
+ *
+ * @param void.
+ *
+ * @return bool true if audio is open, false if the configuration has no audio.
+ */
+bool
+Stds_OpenAudio( void ) {
+  const uint32_t audio = STDS_INIT_AUDIO | STDS_INIT_LAZY_AUDIO;
+
+  if ( is_audio_open || ( g_app.init_config.subsystems & audio ) == 0 ) {
+    return is_audio_open;
+  }
+
+  SDL_LogDebug( SDL_LOG_CATEGORY_APPLICATION, "Initializing audio context and SDL Mixer." );
+
+  if ( Mix_OpenAudio( g_app.init_config.audio_frequency, AUDIO_S16SYS,
+                      g_app.init_config.audio_channels, g_app.init_config.audio_buffer )
+       == -1 ) {
+    SDL_LogInfo( SDL_LOG_CATEGORY_APPLICATION, "Could not initialize SDL Mixer.\n" );
+    exit( EXIT_FAILURE );
+  }
+
+  Mix_AllocateChannels( MAX_SND_CHANNELS );
+
+  g_app.sounds = calloc( SND_MAX, sizeof( Mix_Chunk * ) );
+  if ( g_app.sounds == NULL ) {
+    SDL_LogInfo( SDL_LOG_CATEGORY_APPLICATION, "Could not allocate memory for sounds. %s.\n",
+                 SDL_GetError() );
+    exit( EXIT_FAILURE );
+  }
+
+  is_audio_open = true;
+  return true;
+}
+
+/**
+ * Sets how many instances of a sound effect may play at once through CH_ANY,
+ * and its priority when channels run out. A sound at its limit restarts its
+ * oldest instance instead of taking another channel.
+ *
+ * @param int16_t sound effect ID.
+ * @param int16_t most concurrent instances, or 0 for no limit.
+ * @param int16_t priority; higher priorities may take channels from lower.
+ *
+ * @return void.
+ */
+void
+Stds_SetSFXVoices( const int16_t id, const int16_t max_voices, const int16_t priority ) {
+  voice_manager.sounds[id].max_voices = max_voices;
+  voice_manager.sounds[id].priority   = priority;
+}
+
+/**
+ * Starts a new audio frame. Identical sound effects triggered within one frame
+ * play once. The game loop calls this before every update.
+ *
+ * @param void.
+ *
+ * @return void.
+ */
+void
+Stds_UpdateAudio( void ) {
+  voice_manager.frame++;
+}
+
+/**
+ * Loads a music file from the respective path, or from a mounted pack.
  *
  * @param const char* path of music file.
  *
@@ -41,13 +145,18 @@ Stds_InitAudio( void ) {
  */
 void
 Stds_LoadMusic( const char *fileName ) {
+  if ( !Stds_OpenAudio() ) {
+    return;
+  }
+
   if ( g_app.music != NULL ) {
     Mix_HaltMusic();
     Mix_FreeMusic( g_app.music );
     g_app.music = NULL;
   }
 
-  g_app.music = Mix_LoadMUS( fileName );
+  SDL_RWops *rw = Stds_OpenPackRW( fileName );
+  g_app.music   = rw != NULL ? Mix_LoadMUS_RW( rw, 1 ) : Mix_LoadMUS( fileName );
 }
 
 /**
@@ -59,11 +168,16 @@ Stds_LoadMusic( const char *fileName ) {
  */
 void
 Stds_PlayMusic( const bool loop ) {
+  if ( !Stds_OpenAudio() ) {
+    return;
+  }
+
   Mix_PlayMusic( g_app.music, loop ? -1 : 0 );
 }
 
 /**
- * Loads a sound into the respective ID of the SFX.
+ * Loads a sound into the respective ID of the SFX, from a mounted pack
+ * if one has the file.
  * For instance,
  *
  * Stds_LoadSFX("res/sfx/coin.ogg", SND_COIN).
@@ -75,12 +189,115 @@ Stds_PlayMusic( const bool loop ) {
  */
 void
 Stds_LoadSFX( const char *path, const int16_t id ) {
+  if ( !Stds_OpenAudio() ) {
+    return;
+  }
+
   if ( g_app.sounds[id] != NULL ) {
     fprintf( stderr, "Error, could not add %s audio file to id %d. This id already exists!\n", path,
              id );
     exit( EXIT_FAILURE );
   }
-  g_app.sounds[id] = Mix_LoadWAV( path );
+  SDL_RWops *rw    = Stds_OpenPackRW( path );
+  g_app.sounds[id] = rw != NULL ? Mix_LoadWAV_RW( rw, 1 ) : Mix_LoadWAV( path );
+}
+
+/**
+ * Registers a sound effect without decoding it. Only the encoded file, read from
+ * a mounted pack or from the path, stays in memory until the sound first plays.
+ *
+ * @param const char * sound effect path.
+ * @param int16_t sound effect ID.
+ *
+ * @return void.
+ */
+void
+Stds_RegisterSFX( const char *path, const int16_t id ) {
+  struct sfx_asset_t *asset = &sound_registry.assets[id];
+
+  if ( !Stds_OpenAudio() ) {
+    return;
+  }
+
+  if ( g_app.sounds[id] != NULL || asset->bytes != NULL ) {
+    fprintf( stderr, "Error, could not add %s audio file to id %d. This id already exists!\n", path,
+             id );
+    exit( EXIT_FAILURE );
+  }
+
+  SDL_RWops *rw = Stds_OpenPackRW( path );
+  if ( rw == NULL ) {
+    rw = SDL_RWFromFile( path, "rb" );
+  }
+
+  if ( rw == NULL ) {
+    SDL_LogInfo( SDL_LOG_CATEGORY_APPLICATION, "Could not open %s. %s.\n", path, SDL_GetError() );
+    return;
+  }
+
+  const Sint64 size = SDL_RWsize( rw );
+  if ( size <= 0 ) {
+    SDL_LogInfo( SDL_LOG_CATEGORY_APPLICATION, "Could not read %s. %s.\n", path, SDL_GetError() );
+    SDL_RWclose( rw );
+    return;
+  }
+
+  asset->bytes = malloc( ( size_t ) size );
+  if ( asset->bytes == NULL ) {
+    SDL_LogInfo( SDL_LOG_CATEGORY_APPLICATION, "Could not allocate memory for sfx_asset_t. %s.\n",
+                 SDL_GetError() );
+    exit( EXIT_FAILURE );
+  }
+
+  asset->size = SDL_RWread( rw, asset->bytes, 1, ( size_t ) size );
+  SDL_RWclose( rw );
+}
+
+/**
+ * Decodes a registered sound effect now instead of on its first play. A pinned
+ * sound stays decoded regardless of the memory budget until it is unpinned by
+ * preloading it again with is_pinned false.
+ *
+ * @param int16_t sound effect ID.
+ * @param bool true to keep the sound decoded, false to make it evictable again.
+ *
+ * @return void.
+ */
+void
+Stds_PreloadSFX( const int16_t id, const bool is_pinned ) {
+  struct sfx_asset_t *asset = &sound_registry.assets[id];
+
+  asset->is_pinned = is_pinned;
+  if ( Stds_OpenAudio() && g_app.sounds[id] == NULL && asset->bytes != NULL ) {
+    g_app.sounds[id] = Stds_DecodeSFX( id );
+  }
+}
+
+/**
+ * Sets how many bytes the decoded lazy sound effects may use together, freeing
+ * idle ones right away if they are now over it. Pinned and playing sounds can
+ * keep the usage over budget.
+ *
+ * @param size_t budget in bytes.
+ *
+ * @return void.
+ */
+void
+Stds_SetSFXMemoryBudget( const size_t bytes ) {
+  sound_registry.budget = bytes;
+  Stds_EvictSFX( -1 );
+}
+
+/**
+ * Returns how many bytes the decoded lazy sound effects use.
+ *
+ * @param void.
+ *
+ * @return size_t decoded bytes.
+ */
+size_t
+Stds_GetSFXMemoryUsage( void ) {
+  return sound_registry.resident;
 }
 
 /**
@@ -89,6 +306,10 @@ Stds_LoadSFX( const char *path, const int16_t id ) {
  *
  * Ex: Stds_PlaySFX(SND_BRICK_BREAKER, CH_ANY).
  *
+ * A specific channel plays the sound there unconditionally. CH_ANY lets the
+ * voice manager pick the channel, or drop the sound if it already played
+ * this frame or nothing may be stolen for it.
+ *
  * @param int16_t sound effect ID from enum.
  * @param int16_t channel from enum.
  *
@@ -96,5 +317,198 @@ Stds_LoadSFX( const char *path, const int16_t id ) {
  */
 void
 Stds_PlaySFX( const int16_t id, const int16_t channel ) {
-  Mix_PlayChannel( channel, g_app.sounds[id], 0 );
+  struct sfx_info_t *info = &voice_manager.sounds[id];
+  int32_t            ch   = channel;
+
+  /* There is no audio device to play on. */
+  if ( !Stds_OpenAudio() ) {
+    return;
+  }
+
+  if ( channel == CH_ANY ) {
+    if ( info->last_frame == voice_manager.frame + 1 ) {
+      return;
+    }
+
+    ch = Stds_ChooseVoice( id );
+    if ( ch < 0 ) {
+      return;
+    }
+
+    info->last_frame = voice_manager.frame + 1;
+    Mix_HaltChannel( ch );
+  }
+
+  if ( g_app.sounds[id] == NULL && sound_registry.assets[id].bytes != NULL ) {
+    g_app.sounds[id] = Stds_DecodeSFX( id );
+  }
+  sound_registry.assets[id].last_used = ++sound_registry.clock;
+
+  ch = Mix_PlayChannel( ch, g_app.sounds[id], 0 );
+  if ( ch >= 0 && ch < MAX_SND_CHANNELS ) {
+    voice_manager.voices[ch].id       = id;
+    voice_manager.voices[ch].priority = info->priority;
+    voice_manager.voices[ch].started  = ++voice_manager.sequence;
+  }
+}
+
+/**
+ * Picks the channel for a new instance of a sound: its own oldest voice when
+ * it is at its limit, else a free channel, else the oldest voice among the
+ * lowest priority ones if that priority does not exceed the sound's.
+ *
+ * @param int16_t sound effect ID.
+ *
+ * @return int32_t channel, or -1 to drop the sound.
+ */
+static int32_t
+Stds_ChooseVoice( const int16_t id ) {
+  const struct sfx_info_t *info    = &voice_manager.sounds[id];
+  int32_t                  free_ch = -1;
+  int32_t                  oldest  = -1;
+  int32_t                  victim  = -1;
+  int32_t                  playing = 0;
+
+  for ( int32_t ch = 0; ch < MAX_SND_CHANNELS; ch++ ) {
+    const struct sfx_voice_t *v = &voice_manager.voices[ch];
+
+    if ( !Mix_Playing( ch ) ) {
+      free_ch = free_ch < 0 ? ch : free_ch;
+      continue;
+    }
+
+    if ( v->id == id ) {
+      playing++;
+      if ( oldest < 0 || v->started < voice_manager.voices[oldest].started ) {
+        oldest = ch;
+      }
+    }
+
+    const struct sfx_voice_t *w = &voice_manager.voices[victim < 0 ? ch : victim];
+    if ( victim < 0 || v->priority < w->priority
+         || ( v->priority == w->priority && v->started < w->started ) ) {
+      victim = ch;
+    }
+  }
+
+  if ( info->max_voices > 0 && playing >= info->max_voices ) {
+    return oldest;
+  }
+
+  if ( free_ch >= 0 ) {
+    return free_ch;
+  }
+
+  return victim >= 0 && voice_manager.voices[victim].priority <= info->priority ? victim : -1;
+}
+
+/**
+ * Frees every sound effect, registered encoded bytes, and the music.
+ *
+ * @param void.
+ *
+ * @return void.
+ */
+void
+Stds_AudioDie( void ) {
+  if ( g_app.sounds == NULL ) {
+    return;
+  }
+
+  for ( int32_t i = 0; i < SND_MAX; i++ ) {
+    if ( g_app.sounds[i] != NULL ) {
+      Mix_FreeChunk( g_app.sounds[i] );
+    }
+    free( sound_registry.assets[i].bytes );
+  }
+
+  if ( g_app.music != NULL ) {
+    Mix_FreeMusic( g_app.music );
+  }
+
+  free( g_app.sounds );
+  memset( &sound_registry, 0, sizeof( struct sound_registry_t ) );
+  g_app.sounds  = NULL;
+  g_app.music   = NULL;
+  is_audio_open = false;
+}
+
+/**
+ * Decodes a registered sound effect from its encoded bytes, then frees idle
+ * sounds if that took audio over budget.
+ *
+ * @param int16_t sound effect ID.
+ *
+ * @return Mix_Chunk * decoded chunk, or NULL if it could not be decoded.
+ */
+static Mix_Chunk *
+Stds_DecodeSFX( const int16_t id ) {
+  struct sfx_asset_t *asset = &sound_registry.assets[id];
+  SDL_RWops *         rw    = SDL_RWFromConstMem( asset->bytes, ( int32_t ) asset->size );
+  Mix_Chunk *         chunk = Mix_LoadWAV_RW( rw, 1 );
+
+  if ( chunk == NULL ) {
+    SDL_LogInfo( SDL_LOG_CATEGORY_APPLICATION, "Could not decode sound %d. %s.\n", id,
+                 SDL_GetError() );
+    return NULL;
+  }
+
+  asset->decoded_size = chunk->alen;
+  asset->last_used    = ++sound_registry.clock;
+  sound_registry.resident += asset->decoded_size;
+  Stds_EvictSFX( id );
+
+  return chunk;
+}
+
+/**
+ * Frees the least recently played decoded lazy sounds until they fit in the
+ * budget. Pinned sounds, sounds still playing on some channel, and keep are
+ * never freed.
+ *
+ * @param int16_t sound effect ID to keep, or -1.
+ *
+ * @return void.
+ */
+static void
+Stds_EvictSFX( const int16_t keep ) {
+  while ( sound_registry.resident > sound_registry.budget ) {
+    int32_t lru = -1;
+
+    for ( int32_t i = 0; i < SND_MAX; i++ ) {
+      const struct sfx_asset_t *asset = &sound_registry.assets[i];
+      if ( i == keep || asset->bytes == NULL || asset->is_pinned || g_app.sounds[i] == NULL
+           || ( lru >= 0 && asset->last_used >= sound_registry.assets[lru].last_used )
+           || Stds_IsChunkPlaying( g_app.sounds[i] ) ) {
+        continue;
+      }
+      lru = i;
+    }
+
+    if ( lru < 0 ) {
+      return;
+    }
+
+    Mix_FreeChunk( g_app.sounds[lru] );
+    g_app.sounds[lru] = NULL;
+    sound_registry.resident -= sound_registry.assets[lru].decoded_size;
+    sound_registry.assets[lru].decoded_size = 0;
+  }
+}
+
+/**
+ * Returns whether a chunk is playing on any mixer channel.
+ *
+ * @param Mix_Chunk * chunk.
+ *
+ * @return bool true if some channel plays it.
+ */
+static bool
+Stds_IsChunkPlaying( const Mix_Chunk *chunk ) {
+  for ( int32_t ch = 0; ch < MAX_SND_CHANNELS; ch++ ) {
+    if ( Mix_Playing( ch ) && Mix_GetChunk( ch ) == chunk ) {
+      return true;
+    }
+  }
+  return false;
 }
@@ -16,17 +16,29 @@
  * This file defines the standard functions and procedures for math, trigonometry,
  * simple non string.h string manipulation, random numbers, etc. stds.h also defines
  * a few simple macros for min and max.
+ *
+ * Rotations go through Stds_SinCos and Stds_SinCosDegrees instead of cosf and sinf.
+ * Whole-degree angles, which is what entities, particles and trails store, are
+ * looked up in a table of STDS_SIN_TABLE_SIZE sines; other angles are reduced to
+ * an octant and evaluated with short polynomials, accurate to about 1e-7.
  */
 
 #include "../include/stds.h"
+#include "../include/rng.h"
 
 static char number_buffer[MAX_INT_DIGITS];
 static char text_buffer[MAX_LINE_LENGTH];
 static bool seed = false;
 
+/* sin_table[d] is the sine of d degrees; the extra quarter turn lets
+   sin_table[d + 90] give the cosine without wrapping. */
+static float sin_table[STDS_SIN_TABLE_SIZE + STDS_SIN_TABLE_SIZE / 4];
+static bool  is_sin_table_ready = false;
+
 /**
  * Sets the seed for the randomization. This should be called prior to
- * any RNG. It is called by default in the init.c file.
+ * any RNG. It is called by default in the init.c file, with the time of
+ * day; call Stds_SeedRandom afterwards for a reproducible run.
  * @param void.
  *
  * @return void.
@@ -34,14 +46,15 @@ static bool seed = false;
 void
 Stds_SetRandomSeed( void ) {
   if ( !seed ) {
-    srand( ( uint32_t ) time( NULL ) );
+    Stds_SeedRandom( ( uint64_t ) time( NULL ) );
     seed = true;
   }
 }
 
 /**
  * Returns a random integer variable between
- * the interval specified, inclusive.
+ * the interval specified, inclusive, from the calling
+ * thread's generator.
  *
  * @param int32_t minimum number to choose from.
  * @param int32_t maximum number to choose from.
@@ -50,16 +63,7 @@ Stds_SetRandomSeed( void ) {
  */
 inline int32_t
 Stds_RandomInt( const int32_t min, const int32_t max ) {
-  int32_t n = 0;
-  int32_t tmpMax = max;
-  size_t i = 0;
-  do {
-    n |= ((rand() % ( max - min + 1 ) ) + min) << i;
-    tmpMax -= RAND_MAX;
-    i <<= 8;
-  } while (tmpMax > RAND_MAX);
-
-  return n;
+  return Stds_RngInt( Stds_GetThreadRng(), min, max );
 }
 
 /**
@@ -86,17 +90,17 @@ Stds_RandomIntBounded( const int32_t min, const int32_t min_upper_bound,
 
 /**
  * Returns a random floating point variable between
- * the interval specified, inclusive.
+ * the interval specified, from the calling thread's
+ * generator.
  *
  * @param float minimum number to choose from.
  * @param float maximum number to choose from.
  *
- * @return float random number in the set [min, max].
+ * @return float random number in the set [min, max).
  */
 inline float
 Stds_RandomFloat( const float min, const float max ) {
-  float scale = rand() / ( float ) RAND_MAX;
-  return min + scale * ( max - min );
+  return Stds_RngFloat( Stds_GetThreadRng(), min, max );
 }
 
 /**
@@ -306,6 +310,107 @@ Stds_ToDegrees( const float radians ) {
   return ( float ) ( radians * ( 180.0f / PI ) );
 }
 
+/**
+ * Fills the sine table used by Stds_SinCosDegrees. Stds_InitGame calls
+ * this; otherwise the first lookup does, which must then happen before any
+ * other thread rotates something.
+ *
+ * @param void.
+ *
+ * @return void.
+ */
+void
+Stds_InitSinTable( void ) {
+  const int32_t count = STDS_SIN_TABLE_SIZE + STDS_SIN_TABLE_SIZE / 4;
+
+  for ( int32_t d = 0; d < count; d++ ) {
+    sin_table[d] = ( float ) sin( d * ( 2.0 * PI / STDS_SIN_TABLE_SIZE ) );
+  }
+
+  is_sin_table_ready = true;
+}
+
+/**
+ * Computes the sine and cosine of an angle in radians at once. The angle is
+ * reduced by quarter turns to [-PI / 4, PI / 4] and both are evaluated as
+ * polynomials there, then swapped and negated for the quarter it fell in.
+ *
+ * @param float angle in radians.
+ * @param float * receives the sine.
+ * @param float * receives the cosine.
+ *
+ * @return void.
+ */
+void
+Stds_SinCos( const float radians, float *s, float *c ) {
+  /* Past this the reduction loses precision; such angles, and NaN, are rare
+     enough for the library functions. */
+  if ( !( fabsf( radians ) <= 65536.0f ) ) {
+    *s = sinf( radians );
+    *c = cosf( radians );
+    return;
+  }
+
+  /* PI / 2 split into an exact high part and a low part, so subtracting
+     multiples of it does not round away the remainder. */
+  const float   q  = radians * ( float ) ( 2.0 / PI );
+  const int32_t k  = ( int32_t ) ( q < 0 ? q - 0.5f : q + 0.5f );
+  const float   r  = ( radians - ( float ) k * 1.5703125f ) - ( float ) k * 4.83826794897e-4f;
+  const float   r2 = r * r;
+
+  const float sr
+      = r + r * r2 * ( -1.0f / 6 + r2 * ( 1.0f / 120 + r2 * ( -1.0f / 5040 + r2 / 362880 ) ) );
+  const float cr
+      = 1 + r2 * ( -0.5f + r2 * ( 1.0f / 24 + r2 * ( -1.0f / 720 + r2 * ( 1.0f / 40320 ) ) ) );
+
+  switch ( k & 3 ) {
+  case 0:
+    *s = sr;
+    *c = cr;
+    break;
+  case 1:
+    *s = cr;
+    *c = -sr;
+    break;
+  case 2:
+    *s = -sr;
+    *c = -cr;
+    break;
+  default:
+    *s = -cr;
+    *c = sr;
+    break;
+  }
+}
+
+/**
+ * Computes the sine and cosine of an angle in degrees at once. Whole
+ * degrees are looked up in the sine table; fractions use Stds_SinCos.
+ *
+ * @param float angle in degrees.
+ * @param float * receives the sine.
+ * @param float * receives the cosine.
+ *
+ * @return void.
+ */
+void
+Stds_SinCosDegrees( const float degrees, float *s, float *c ) {
+  /* Every float this large is whole, and the table cannot help with NaN. */
+  if ( !( fabsf( degrees ) < 16777216.0f ) || ( float ) ( int32_t ) degrees != degrees ) {
+    Stds_SinCos( Stds_ToRadians( degrees ), s, c );
+    return;
+  }
+
+  if ( !is_sin_table_ready ) {
+    Stds_InitSinTable();
+  }
+
+  int32_t d = ( int32_t ) degrees % STDS_SIN_TABLE_SIZE;
+  d         = d < 0 ? d + STDS_SIN_TABLE_SIZE : d;
+  *s        = sin_table[d];
+  *c        = sin_table[d + STDS_SIN_TABLE_SIZE / 4];
+}
+
 /**
  * Converts an integer into an SDL_Color object. The number should
  * be an unsigned 32-bit integer in the form 0xAARRGGBB (ARGB)
@@ -445,4 +550,86 @@ Stds_StrCatIntArray( const char s[], const int32_t n ) {
   int32_t digits = snprintf( number_buffer, MAX_INT_DIGITS, "%d", n );
   strncat( text_buffer, number_buffer, digits );
   return text_buffer;
-}
\ No newline at end of file
+}
+/**
+ * Hashes a null-terminated string with 32-bit FNV-1a. Used wherever a
+ * string key is looked up in a hash table (e.g. the texture cache).
+ *
+ * @param const char * string to hash.
+ *
+ * @return uint32_t hash of the string.
+ */
+uint32_t
+Stds_HashString( const char *s ) {
+  uint32_t hash = 2166136261u;
+
+  for ( const uint8_t *p = ( const uint8_t * ) s; *p != '\0'; p++ ) {
+    hash ^= *p;
+    hash *= 16777619u;
+  }
+
+  return hash;
+}
+
+/**
+ * Sorts count 64-bit keys with an 8-bit LSD radix sort. The keys are left in
+ * place; order receives the indices of the keys in ascending order, with
+ * equal keys in their original order. Passes over bytes that are the same in
+ * every key are skipped, so keys that only use a few of their bits sort in
+ * few passes.
+ *
+ * @param const uint64_t * array of count keys.
+ * @param uint32_t * array of count indices to fill.
+ * @param uint32_t * scratch array of count indices.
+ * @param int32_t number of keys.
+ *
+ * @return void.
+ */
+void
+Stds_RadixSortKeys( const uint64_t *keys, uint32_t *order, uint32_t *scratch,
+                    const int32_t count ) {
+  uint32_t  counts[8][256];
+  uint32_t *src = order;
+  uint32_t *dst = scratch;
+
+  memset( counts, 0, sizeof( counts ) );
+
+  /* One read of the keys builds the histograms of all eight digits. */
+  for ( int32_t i = 0; i < count; i++ ) {
+    uint64_t key = keys[i];
+    order[i]     = ( uint32_t ) i;
+
+    for ( int32_t pass = 0; pass < 8; pass++ ) {
+      counts[pass][( key >> ( pass * 8 ) ) & 0xff]++;
+    }
+  }
+
+  for ( int32_t pass = 0; pass < 8; pass++ ) {
+    uint32_t *histogram = counts[pass];
+    uint32_t  total     = 0;
+
+    if ( count == 0 || histogram[( keys[0] >> ( pass * 8 ) ) & 0xff] == ( uint32_t ) count ) {
+      continue;
+    }
+
+    for ( int32_t digit = 0; digit < 256; digit++ ) {
+      uint32_t n       = histogram[digit];
+      histogram[digit] = total;
+      total += n;
+    }
+
+    for ( int32_t i = 0; i < count; i++ ) {
+      uint32_t index = src[i];
+      uint32_t d     = ( uint32_t ) ( ( keys[index] >> ( pass * 8 ) ) & 0xff );
+      dst[histogram[d]++] = index;
+    }
+
+    uint32_t *t = src;
+    src         = dst;
+    dst         = t;
+  }
+
+  if ( src != order ) {
+    memcpy( order, src, sizeof( uint32_t ) * ( size_t ) count );
+  }
+}
@@ -0,0 +1,384 @@
+/**
+ * @file telemetry.c
+ * @author Joshua Crotts
+ * @date October 14 2026
+ * @version 1.0
+ *
+ * @section LICENSE
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License as
+ * published by the Free Software Foundation; either version 2 of
+ * the License, or (at your option) any later version.
+ *
+ * @section DESCRIPTION
+ *
+ * This file defines production telemetry. Once started, every frame's length goes
+ * into a per-session and a per-interval histogram with HDR-style buckets, and every
+ * interval a sample is written to an SDL_RWops as a CSV row or a line of JSON: the
+ * interval's mean, median, 99th percentile and worst frame, the session's
+ * percentiles, the live particles, entities, trails, cached textures and fonts, and
+ * the bytes held by the texture cache, object pools and arenas. Particle systems,
+ * entity registries and entity pools belong to the game, so only those passed to
+ * Stds_TelemetryWatch are counted.
+ */
+#include "../include/telemetry.h"
+
+static struct telemetry_t telemetry;
+
+static const char *telemetry_fields[] = {
+  "time_s",          "frames",         "interval_mean_ms", "interval_p50_ms", "interval_p99_ms",
+  "interval_max_ms", "session_p50_ms", "session_p90_ms",   "session_p99_ms",  "session_p999_ms",
+  "session_max_ms",  "particles",      "entities",         "trails",          "textures",
+  "fonts",           "texture_bytes",  "pool_bytes",       "arena_bytes" };
+
+#define STDS_TELEMETRY_FIELDS ( int32_t ) ( sizeof( telemetry_fields ) / sizeof( char * ) )
+
+static inline int32_t Stds_HistogramBucket( const uint32_t us );
+static void           Stds_HistogramRecord( struct frame_histogram_t *h, uint32_t us );
+static double         Stds_HistogramPercentile( const struct frame_histogram_t *h, const float p );
+static void           Stds_TelemetrySample( double *values );
+static void           Stds_TelemetryWrite( const char *text, const size_t length );
+
+/**
+ * Starts recording frame times and writing samples to rw every
+ * interval_seconds. A CSV export starts with a header row. Telemetry owns
+ * rw from then on and closes it in Stds_StopTelemetry.
+ *
+ * @param SDL_RWops * destination, such as SDL_RWFromFile( path, "wb" ).
+ * @param int32_t STDS_TELEMETRY_CSV or STDS_TELEMETRY_JSON.
+ * @param float seconds between samples.
+ *
+ * @return bool true if telemetry started, false if rw is NULL.
+ */
+bool
+Stds_StartTelemetry( SDL_RWops *rw, const int32_t format, const float interval_seconds ) {
+  if ( rw == NULL ) {
+    SDL_LogInfo( SDL_LOG_CATEGORY_APPLICATION, "Could not open the telemetry output. %s.\n",
+                 SDL_GetError() );
+    return false;
+  }
+
+  Stds_StopTelemetry();
+  memset( &telemetry.session, 0, sizeof( struct frame_histogram_t ) );
+  memset( &telemetry.interval, 0, sizeof( struct frame_histogram_t ) );
+
+  telemetry.rw           = rw;
+  telemetry.format       = format;
+  telemetry.frequency    = SDL_GetPerformanceFrequency();
+  telemetry.start        = SDL_GetPerformanceCounter();
+  telemetry.previous     = 0;
+  telemetry.export_ticks = ( uint64_t ) ( ( interval_seconds > 0 ? interval_seconds : 1.0f )
+                                          * ( float ) telemetry.frequency );
+  telemetry.next_export  = telemetry.start + telemetry.export_ticks;
+
+  if ( format == STDS_TELEMETRY_CSV ) {
+    char   line[MAX_LINE_LENGTH];
+    size_t length = 0;
+
+    for ( int32_t i = 0; i < STDS_TELEMETRY_FIELDS; i++ ) {
+      length += ( size_t ) snprintf( line + length, sizeof( line ) - length, "%s%s",
+                                     i == 0 ? "" : ",", telemetry_fields[i] );
+    }
+
+    line[length++] = '\n';
+    Stds_TelemetryWrite( line, length );
+  }
+
+  return true;
+}
+
+/**
+ * Writes a last sample and closes the output. Does nothing if telemetry is
+ * not running.
+ *
+ * @param void.
+ *
+ * @return void.
+ */
+void
+Stds_StopTelemetry( void ) {
+  if ( telemetry.rw == NULL ) {
+    return;
+  }
+
+  Stds_TelemetryExport();
+  SDL_RWclose( telemetry.rw );
+  telemetry.rw = NULL;
+}
+
+/**
+ * Records the time since the previous call as one frame, and writes a
+ * sample once the interval has passed. The game loop calls this once per
+ * frame; it returns right away while telemetry is off.
+ *
+ * @param void.
+ *
+ * @return void.
+ */
+void
+Stds_TelemetryFrame( void ) {
+  if ( telemetry.rw == NULL ) {
+    return;
+  }
+
+  const uint64_t now = SDL_GetPerformanceCounter();
+
+  if ( telemetry.previous != 0 ) {
+    const double   us      = ( double ) ( now - telemetry.previous ) * 1e6 / telemetry.frequency;
+    const uint32_t clamped = us < ( double ) UINT32_MAX ? ( uint32_t ) us : UINT32_MAX;
+
+    Stds_HistogramRecord( &telemetry.session, clamped );
+    Stds_HistogramRecord( &telemetry.interval, clamped );
+  }
+
+  telemetry.previous = now;
+
+  if ( now >= telemetry.next_export ) {
+    Stds_TelemetryExport();
+    telemetry.next_export = now + telemetry.export_ticks;
+  }
+}
+
+/**
+ * Writes a sample right away and starts a new interval.
+ *
+ * @param void.
+ *
+ * @return void.
+ */
+void
+Stds_TelemetryExport( void ) {
+  if ( telemetry.rw == NULL ) {
+    return;
+  }
+
+  double values[STDS_TELEMETRY_FIELDS];
+  char   line[MAX_LINE_LENGTH];
+  size_t length = 0;
+
+  Stds_TelemetrySample( values );
+
+  for ( int32_t i = 0; i < STDS_TELEMETRY_FIELDS; i++ ) {
+    const size_t left = sizeof( line ) - length;
+
+    if ( telemetry.format == STDS_TELEMETRY_JSON ) {
+      length += ( size_t ) snprintf( line + length, left, "%s\"%s\":%.15g", i == 0 ? "{" : ",",
+                                     telemetry_fields[i], values[i] );
+    } else {
+      length += ( size_t ) snprintf( line + length, left, "%s%.15g", i == 0 ? "" : ",",
+                                     values[i] );
+    }
+  }
+
+  if ( telemetry.format == STDS_TELEMETRY_JSON ) {
+    line[length++] = '}';
+  }
+
+  line[length++] = '\n';
+  Stds_TelemetryWrite( line, length );
+
+  memset( &telemetry.interval, 0, sizeof( struct frame_histogram_t ) );
+}
+
+/**
+ * Adds a particle system, entity registry or entity pool to the live
+ * counts. It must be unwatched before it is freed.
+ *
+ * @param int32_t STDS_TELEMETRY_PARTICLES, STDS_TELEMETRY_ENTITIES or
+ *        STDS_TELEMETRY_ENTITY_POOL.
+ * @param void * the particle_system_t, entity_registry_t or entity_pool_t.
+ *
+ * @return void.
+ */
+void
+Stds_TelemetryWatch( const int32_t type, const void *object ) {
+  if ( telemetry.watch_count == STDS_TELEMETRY_MAX_WATCHED ) {
+    SDL_LogDebug( SDL_LOG_CATEGORY_APPLICATION, "Telemetry watch limit reached.\n" );
+    return;
+  }
+
+  telemetry.watched[telemetry.watch_count++] = ( struct telemetry_watch_t ){ type, object };
+}
+
+/**
+ * Removes an object added with Stds_TelemetryWatch.
+ *
+ * @param void * the watched object.
+ *
+ * @return void.
+ */
+void
+Stds_TelemetryUnwatch( const void *object ) {
+  for ( int32_t i = 0; i < telemetry.watch_count; i++ ) {
+    if ( telemetry.watched[i].object == object ) {
+      telemetry.watched[i] = telemetry.watched[--telemetry.watch_count];
+      return;
+    }
+  }
+}
+
+/**
+ * Returns a percentile of every frame time this session.
+ *
+ * @param float percentile, from 0 to 100.
+ *
+ * @return float frame time in milliseconds, or 0 if no frame was recorded.
+ */
+float
+Stds_TelemetryPercentile( const float percentile ) {
+  return ( float ) Stds_HistogramPercentile( &telemetry.session, percentile );
+}
+
+/**
+ * Returns the histogram bucket of a frame time. Times below
+ * 2^STDS_TELEMETRY_SUB_BITS microseconds have a bucket each; above, the top
+ * STDS_TELEMETRY_SUB_BITS + 1 bits pick the bucket.
+ *
+ * @param uint32_t frame time in microseconds.
+ *
+ * @return int32_t bucket index.
+ */
+static inline int32_t
+Stds_HistogramBucket( const uint32_t us ) {
+  const uint32_t sub = 1u << STDS_TELEMETRY_SUB_BITS;
+
+  if ( us < sub ) {
+    return ( int32_t ) us;
+  }
+
+  int32_t msb = 31;
+  while ( ( us >> msb ) == 0 ) {
+    msb--;
+  }
+
+  const int32_t shift = msb - STDS_TELEMETRY_SUB_BITS;
+  return ( shift << STDS_TELEMETRY_SUB_BITS ) + ( int32_t ) ( us >> shift );
+}
+
+/**
+ * Counts one frame in a histogram. Frames longer than the last bucket are
+ * counted in it, though max_us keeps their real length.
+ *
+ * @param frame_histogram_t * histogram.
+ * @param uint32_t frame time in microseconds.
+ *
+ * @return void.
+ */
+static void
+Stds_HistogramRecord( struct frame_histogram_t *h, uint32_t us ) {
+  h->count++;
+  h->sum_us += us;
+  h->max_us = us > h->max_us ? us : h->max_us;
+
+  const uint32_t limit = ( 1u << STDS_TELEMETRY_MAX_BITS ) - 1;
+  h->counts[Stds_HistogramBucket( us < limit ? us : limit )]++;
+}
+
+/**
+ * Returns a percentile of a histogram as the middle of the bucket it falls
+ * in, which is within 1/32 of the true value.
+ *
+ * @param frame_histogram_t * histogram.
+ * @param float percentile, from 0 to 100.
+ *
+ * @return double frame time in milliseconds, or 0 for an empty histogram.
+ */
+static double
+Stds_HistogramPercentile( const struct frame_histogram_t *h, const float p ) {
+  if ( h->count == 0 ) {
+    return 0;
+  }
+
+  const double   share  = p < 0 ? 0 : p > 100 ? 1 : p / 100.0;
+  const uint64_t target = ( uint64_t ) ceil( share * ( double ) h->count );
+  uint64_t       seen   = 0;
+  int32_t        b      = 0;
+
+  for ( ; b < STDS_TELEMETRY_BUCKETS - 1; b++ ) {
+    seen += h->counts[b];
+    if ( seen >= target && seen > 0 ) {
+      break;
+    }
+  }
+
+  /* Invert Stds_HistogramBucket to get the range of bucket b. */
+  const int32_t sub   = 1 << STDS_TELEMETRY_SUB_BITS;
+  const int32_t shift = b < sub ? 0 : ( b >> STDS_TELEMETRY_SUB_BITS ) - 1;
+  const double  low   = b < sub ? b : ( double ) ( ( b - ( shift << STDS_TELEMETRY_SUB_BITS ) )
+                                                   << shift );
+  const double  width = ( double ) ( 1u << shift );
+  const double  us    = low + ( width - 1 ) / 2;
+
+  return ( us < h->max_us ? us : h->max_us ) / 1000.0;
+}
+
+/**
+ * Fills in the values of a sample, in the order of telemetry_fields.
+ *
+ * @param double * array of STDS_TELEMETRY_FIELDS values.
+ *
+ * @return void.
+ */
+static void
+Stds_TelemetrySample( double *values ) {
+  const struct frame_histogram_t *in        = &telemetry.interval;
+  const struct frame_histogram_t *s         = &telemetry.session;
+  double                          particles = 0, entities = 0, trails = 0;
+
+  for ( int32_t i = 0; i < telemetry.watch_count; i++ ) {
+    const struct telemetry_watch_t *w = &telemetry.watched[i];
+
+    if ( w->type == STDS_TELEMETRY_PARTICLES ) {
+      particles += ( ( const struct particle_system_t * ) w->object )->alive_count;
+    } else if ( w->type == STDS_TELEMETRY_ENTITIES ) {
+      entities += ( ( const struct entity_registry_t * ) w->object )->count;
+    } else if ( w->type == STDS_TELEMETRY_ENTITY_POOL ) {
+      const struct entity_pool_t *pool = w->object;
+      entities += pool->capacity - pool->free_count;
+    }
+  }
+
+  for ( const struct trail_t *t = g_app.trail_head.next; t != NULL; t = t->next ) {
+    trails++;
+  }
+
+  values[0]  = ( double ) ( SDL_GetPerformanceCounter() - telemetry.start ) / telemetry.frequency;
+  values[1]  = ( double ) s->count;
+  values[2]  = in->count > 0 ? ( double ) in->sum_us / in->count / 1000.0 : 0;
+  values[3]  = Stds_HistogramPercentile( in, 50 );
+  values[4]  = Stds_HistogramPercentile( in, 99 );
+  values[5]  = in->max_us / 1000.0;
+  values[6]  = Stds_HistogramPercentile( s, 50 );
+  values[7]  = Stds_HistogramPercentile( s, 90 );
+  values[8]  = Stds_HistogramPercentile( s, 99 );
+  values[9]  = Stds_HistogramPercentile( s, 99.9f );
+  values[10] = s->max_us / 1000.0;
+  values[11] = particles;
+  values[12] = entities;
+  values[13] = trails;
+  values[14] = g_app.texture_count;
+  values[15] = g_app.fonts != NULL ? ( double ) Stds_HashMapSize( g_app.fonts ) : 0;
+  values[16] = ( double ) g_app.texture_bytes;
+  values[17] = ( double ) Stds_PoolTotalBytes();
+  values[18] = ( double ) Stds_ArenaTotalBytes();
+}
+
+/**
+ * Writes text to the telemetry output, turning telemetry off if the write
+ * fails.
+ *
+ * @param char * text.
+ * @param size_t length of the text.
+ *
+ * @return void.
+ */
+static void
+Stds_TelemetryWrite( const char *text, const size_t length ) {
+  if ( SDL_RWwrite( telemetry.rw, text, 1, length ) != length ) {
+    SDL_LogInfo( SDL_LOG_CATEGORY_APPLICATION, "Could not write telemetry. %s.\n",
+                 SDL_GetError() );
+    SDL_RWclose( telemetry.rw );
+    telemetry.rw = NULL;
+  }
+}
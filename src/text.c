@@ -13,16 +13,32 @@
  *
  * @section DESCRIPTION
  *
- * This file defines fonts and text-drawing functions and features.
+ * This file defines fonts and text-drawing functions and features. Each font
+ * caches its printable ASCII glyphs in an atlas the first time it is drawn, so
+ * a string is drawn as one batch of quads instead of being rasterized and
+ * uploaded on every call.
  */
+#include "../include/atlas.h"
 #include "../include/draw.h"
+#include "../include/pack.h"
+#include "../lib/structures/include/stds_hashmap.h"
 
-static char text_buffer[MAX_LINE_LENGTH];
+static char      text_buffer[MAX_LINE_LENGTH];
+static SDL_FRect glyph_dst[MAX_LINE_LENGTH];
+static SDL_Rect  glyph_src[MAX_LINE_LENGTH];
+static SDL_Color glyph_colors[MAX_LINE_LENGTH];
 
-static TTF_Font *Stds_GetFont( const char *f, const uint16_t s );
+static struct font_t *Stds_GetFont( const char *f, const uint16_t s );
+static void           Stds_BuildGlyphCache( struct font_t *f );
+static struct font_t *Stds_NewFont( const char *font_file, const uint16_t size );
+static const char *   Stds_FontKey( const char *font_file, const uint16_t size );
+
+static char * font_key;
+static size_t font_key_size;
 
 /**
- * Initializes the TTF font library for use.
+ * Initializes the TTF font library for use, unless it already is. Adding a
+ * font calls this, so it only needs calling to move the cost up front.
  *
  * @param void.
  *
@@ -30,13 +46,17 @@ static TTF_Font *Stds_GetFont( const char *f, const uint16_t s );
  */
 void
 Stds_InitFonts( void ) {
+  if ( g_app.fonts != NULL ) {
+    return;
+  }
+
   if ( TTF_Init() == -1 ) {
     SDL_LogInfo( SDL_LOG_CATEGORY_APPLICATION, "Failed to initialize TTF_Init: %s.\n",
                  SDL_GetError() );
     exit( EXIT_FAILURE );
   }
 
-  g_app.font_tail = &g_app.font_head;
+  g_app.fonts = Stds_HashMapCreate( sizeof( struct font_t * ), STDS_HASHMAP_STRING_KEYS );
 }
 
 /**
@@ -59,33 +79,226 @@ Stds_InitFonts( void ) {
 void
 Stds_DrawText( const float x, float y, const char *font_string, const uint16_t font_size,
                const SDL_Color *c, const char *text, ... ) {
-  SDL_Rect message_rect;
-  message_rect.x = ( int32_t ) x;
-  message_rect.y = ( int32_t ) y;
-
   va_list args;
-  memset( &text_buffer, '\0', sizeof( text_buffer ) );
 
   va_start( args, text );
-  vsprintf( text_buffer, text, args );
+  vsnprintf( text_buffer, sizeof( text_buffer ), text, args );
   va_end( args );
 
-  TTF_Font *   font            = Stds_GetFont( font_string, font_size );
-  SDL_Surface *message_surface = TTF_RenderText_Solid( font, text_buffer, *c );
-  TTF_SizeText( font, text_buffer, &message_rect.w, &message_rect.h );
+  struct font_t *f = Stds_GetFont( font_string, font_size );
 
-  if ( message_surface == NULL ) {
+  if ( f == NULL || f->font == NULL ) {
     SDL_LogInfo( SDL_LOG_CATEGORY_APPLICATION, "Failed to write message: %s.\n", SDL_GetError() );
     exit( EXIT_FAILURE );
   }
 
-  SDL_Texture *message_texture = SDL_CreateTextureFromSurface( g_app.renderer, message_surface );
-  SDL_RenderCopy( g_app.renderer, message_texture, NULL, &message_rect );
+  if ( f->glyph_atlas == NULL ) {
+    Stds_BuildGlyphCache( f );
+  }
+
+  SDL_Texture *page  = NULL;
+  int32_t      count = 0;
+  float        pen_x = x;
+  uint16_t     prev  = 0;
+
+  for ( const char *p = text_buffer; *p != '\0'; p++ ) {
+    uint16_t ch = ( uint8_t ) *p;
+    if ( ch < STDS_GLYPH_FIRST || ch >= STDS_GLYPH_FIRST + STDS_GLYPH_COUNT ) {
+      ch = '?';
+    }
+
+#if SDL_TTF_VERSION_ATLEAST( 2, 0, 14 )
+    if ( prev != 0 ) {
+      pen_x += ( float ) TTF_GetFontKerningSizeGlyphs( f->font, prev, ch );
+    }
+#endif
+    prev = ch;
+
+    const struct glyph_t *       g = &f->glyphs[ch - STDS_GLYPH_FIRST];
+    const struct atlas_region_t *r = Stds_AtlasGetRegion( f->glyph_atlas, g->region );
+
+    if ( r != NULL ) {
+      /* Glyphs that landed on another atlas page need their own batch. */
+      if ( r->texture != page && count > 0 ) {
+        Stds_DrawQuads( page, glyph_dst, glyph_src, glyph_colors, count, false );
+        count = 0;
+      }
+
+      page                = r->texture;
+      glyph_dst[count]    = ( SDL_FRect ){ pen_x, y, ( float ) r->rect.w, ( float ) r->rect.h };
+      glyph_src[count]    = r->rect;
+      glyph_colors[count] = *c;
+      count++;
+    }
+
+    pen_x += ( float ) g->advance;
+  }
+
+  if ( count > 0 ) {
+    Stds_DrawQuads( page, glyph_dst, glyph_src, glyph_colors, count, false );
+  }
+}
+
+/**
+ * Creates a retained text object. Unlike Stds_DrawText, the string is
+ * rasterized into a texture that is kept between frames, so text that rarely
+ * changes (labels, button captions) costs a single copy per draw.
+ *
+ * @param const char * font name (use the file name itself with the extension).
+ * @param uint16_t font size.
+ * @param SDL_Color * pointer to color of text.
+ * @param const char * string to draw.
+ *
+ * @return text_t * pointer to text object.
+ */
+struct text_t *
+Stds_TextCreate( const char *font_path, const uint16_t font_size, const SDL_Color *c,
+                 const char *text ) {
+  struct text_t *t;
+  t = malloc( sizeof( struct text_t ) );
+
+  if ( t == NULL ) {
+    SDL_LogInfo( SDL_LOG_CATEGORY_APPLICATION, "Could not allocate memory for text_t. %s.\n",
+                 SDL_GetError() );
+    exit( EXIT_FAILURE );
+  }
+
+  memset( t, 0, sizeof( struct text_t ) );
+
+  t->font_path = font_path;
+  t->font_size = font_size;
+  t->color     = *c;
+  t->is_dirty  = true;
+
+  if ( text != NULL ) {
+    strncpy( t->text, text, LARGE_TEXT_BUFFER - 1 );
+  }
+
+  return t;
+}
+
+/**
+ * Changes the string of a text object. The texture is only marked for
+ * re-rasterizing when the string actually differs.
+ *
+ * @param text_t * pointer to text object.
+ * @param const char * new string.
+ *
+ * @return void.
+ */
+void
+Stds_TextSet( struct text_t *t, const char *text ) {
+  if ( text == NULL ) {
+    text = "";
+  }
+
+  if ( strncmp( t->text, text, LARGE_TEXT_BUFFER - 1 ) != 0 ) {
+    strncpy( t->text, text, LARGE_TEXT_BUFFER - 1 );
+    t->is_dirty = true;
+  }
+}
 
-  /* Destroys the available message texture and surface to prevent a memory leak,
-     this seems superfluous every time through a call, but PLEASE do it. */
-  SDL_DestroyTexture( message_texture );
-  SDL_FreeSurface( message_surface );
+/**
+ * Changes the color of a text object. Glyphs are rasterized in white, so this
+ * never re-rasterizes the string.
+ *
+ * @param text_t * pointer to text object.
+ * @param SDL_Color * pointer to new color.
+ *
+ * @return void.
+ */
+void
+Stds_TextSetColor( struct text_t *t, const SDL_Color *c ) {
+  t->color = *c;
+}
+
+/**
+ * Changes the font of a text object, re-rasterizing it on the next draw if
+ * the font or size differs.
+ *
+ * @param text_t * pointer to text object.
+ * @param const char * font name.
+ * @param uint16_t font size.
+ *
+ * @return void.
+ */
+void
+Stds_TextSetFont( struct text_t *t, const char *font_path, const uint16_t font_size ) {
+  if ( t->font_size != font_size || t->font_path == NULL ||
+       strcmp( t->font_path, font_path ) != 0 ) {
+    t->font_path = font_path;
+    t->font_size = font_size;
+    t->is_dirty  = true;
+  }
+}
+
+/**
+ * Draws a text object with its top-left corner at (x, y), re-rasterizing it
+ * first if its string or font changed since the last draw.
+ *
+ * @param text_t * pointer to text object.
+ * @param float x coordinate (top-left) of string.
+ * @param float y coordinate (top-left) of string.
+ *
+ * @return void.
+ */
+void
+Stds_TextDraw( struct text_t *t, const float x, const float y ) {
+  if ( t->is_dirty ) {
+    const SDL_Color white = { 0xff, 0xff, 0xff, 0xff };
+
+    Stds_ForgetTextureState( t->texture );
+    SDL_DestroyTexture( t->texture );
+    t->texture  = NULL;
+    t->w        = 0;
+    t->h        = 0;
+    t->is_dirty = false;
+
+    struct font_t *f = Stds_GetFont( t->font_path, t->font_size );
+
+    if ( f != NULL && t->text[0] != '\0' ) {
+      SDL_Surface *surface = TTF_RenderText_Solid( f->font, t->text, white );
+
+      if ( surface == NULL ) {
+        SDL_LogInfo( SDL_LOG_CATEGORY_APPLICATION, "Failed to write message: %s.\n",
+                     SDL_GetError() );
+        exit( EXIT_FAILURE );
+      }
+
+      t->texture = SDL_CreateTextureFromSurface( g_app.renderer, surface );
+      t->w       = surface->w;
+      t->h       = surface->h;
+      SDL_FreeSurface( surface );
+    }
+  }
+
+  if ( t->texture != NULL ) {
+    Stds_SetTextureColorMod( t->texture, t->color.r, t->color.g, t->color.b );
+    Stds_SetTextureAlphaMod( t->texture, t->color.a );
+    Stds_DrawTexture( t->texture, x, y, ( float ) t->w, ( float ) t->h, 0, SDL_FLIP_NONE, NULL,
+                      false );
+  }
+}
+
+/**
+ * Destroys a text object and its texture.
+ *
+ * @param text_t * pointer to text object.
+ *
+ * @return void.
+ */
+void
+Stds_TextDie( struct text_t *t ) {
+  if ( t == NULL ) {
+    return;
+  }
+
+  if ( t->texture != NULL ) {
+    Stds_ForgetTextureState( t->texture );
+    SDL_DestroyTexture( t->texture );
+  }
+
+  free( t );
 }
 
 /**
@@ -98,15 +311,38 @@ Stds_DrawText( const float x, float y, const char *font_string, const uint16_t f
 void
 Stds_FreeFonts( void ) {
   struct font_t *f;
+  void *         value;
+  size_t         it = 0;
+
+  /* No font was ever added, so SDL_ttf never started. */
+  if ( g_app.fonts == NULL ) {
+    return;
+  }
+
   SDL_LogDebug( SDL_LOG_CATEGORY_APPLICATION, "Freeing font.\n" );
 
-  /* Frees the font linked list. */
-  while ( g_app.font_head.next ) {
-    f                    = g_app.font_head.next;
-    g_app.font_head.next = f->next;
+  while ( Stds_HashMapNext( g_app.fonts, &it, NULL, &value ) ) {
+    f = *( struct font_t ** ) value;
+
+    if ( f->glyph_atlas != NULL ) {
+      Stds_AtlasDie( f->glyph_atlas );
+    }
+
+    if ( f->font != NULL ) {
+      TTF_CloseFont( f->font );
+    }
+
+    SDL_free( f->file_data );
     free( f );
   }
 
+  Stds_HashMapDestroy( g_app.fonts );
+  g_app.fonts = NULL;
+
+  free( font_key );
+  font_key      = NULL;
+  font_key_size = 0;
+
   TTF_Quit();
 }
 
@@ -125,19 +361,20 @@ Stds_FreeFonts( void ) {
  */
 void
 Stds_GetStringSize( const char *s, const char *font, const uint16_t size, int32_t *w, int32_t *h ) {
-  TTF_Font *f;
+  struct font_t *f;
   f = Stds_GetFont( font, size );
 
   if ( f != NULL ) {
-    TTF_SizeText( f, s, w, h );
+    TTF_SizeText( f->font, s, w, h );
   } else {
     exit( EXIT_FAILURE );
   }
 }
 
 /**
- * Adds a font to the font linked list in the app struct. A font can be loaded
- * in multiple times, each with different sizes.
+ * Adds a font to the font cache in the app struct. A font can be loaded in
+ * multiple times, each with different sizes; adding the same file and size
+ * again does nothing.
  *
  * @param const char * font name.
  * @param const uint16_t size of font.
@@ -146,55 +383,172 @@ Stds_GetStringSize( const char *s, const char *font, const uint16_t size, int32_
  */
 void
 Stds_AddFont( const char *font_file, const uint16_t size ) {
-  struct font_t *f;
-  f = malloc( sizeof( struct font_t ) );
-
-  if ( f == NULL ) {
-    SDL_LogInfo( SDL_LOG_CATEGORY_APPLICATION, "Could not allocate memory for font_t. %s.\n",
-                 SDL_GetError() );
-    exit( EXIT_FAILURE );
+  Stds_InitFonts();
+  if ( Stds_HashMapGet( g_app.fonts, Stds_FontKey( font_file, size ) ) != NULL ) {
+    return;
   }
 
-  memset( f, 0, sizeof( struct font_t ) );
+  struct font_t *f = Stds_NewFont( font_file, size );
 
-  f->font = TTF_OpenFont( font_file, size );
+  SDL_RWops *rw = Stds_OpenPackRW( font_file );
+  f->font       = rw != NULL ? TTF_OpenFontRW( rw, 1, size ) : TTF_OpenFont( font_file, size );
 
   if ( f->font == NULL ) {
     SDL_LogInfo( SDL_LOG_CATEGORY_APPLICATION, "Could not load font_t %s, %d. Is the path correct?",
                  font_file, size );
   }
+}
 
-  /* Push the font to the linked list. */
-  strncpy( f->name, font_file, strlen( font_file ) + 1 );
-  f->size = size;
+/**
+ * Adds a font like Stds_AddFont, but opens it from the file's contents
+ * already in memory, e.g. read by the asset loader. The font takes
+ * ownership of data, which must come from SDL_malloc or SDL_LoadFile and
+ * stays alive until Stds_FreeFonts. If the font is already loaded, data is
+ * freed instead.
+ *
+ * @param const char * font path, used as the font's name.
+ * @param uint16_t font size.
+ * @param void * contents of the font file.
+ * @param size_t size of the contents in bytes.
+ *
+ * @return void.
+ */
+void
+Stds_AddFontFromMemory( const char *font_file, const uint16_t size, void *data,
+                        const size_t data_size ) {
+  Stds_InitFonts();
+  if ( Stds_HashMapGet( g_app.fonts, Stds_FontKey( font_file, size ) ) != NULL ) {
+    SDL_free( data );
+    return;
+  }
 
-  g_app.font_tail->next = f;
-  g_app.font_tail       = f;
+  struct font_t *f = Stds_NewFont( font_file, size );
+
+  f->font      = TTF_OpenFontRW( SDL_RWFromConstMem( data, ( int ) data_size ), 1, size );
+  f->file_data = data;
+
+  if ( f->font == NULL ) {
+    SDL_LogInfo( SDL_LOG_CATEGORY_APPLICATION, "Could not load font_t %s, %d. Is the path correct?",
+                 font_file, size );
+  }
 }
 
 /**
- * Iterate through the linked list of fonts already loaded into the system.
- * If it is found, we return the font with the corresponding size. Otherwise,
- * NULL is returned.
+ * Looks up a font already loaded into the system by name and size. If it
+ * is not found, NULL is returned.
  *
  * @param const char * font name.
  * @param const uint16_t font size.
  *
- * @return TTF_Font * pointer to font object.
+ * @return font_t * pointer to font object.
  */
-static TTF_Font *
+static struct font_t *
 Stds_GetFont( const char *font_str, const uint16_t font_size ) {
+  struct font_t **f = g_app.fonts != NULL
+                        ? Stds_HashMapGet( g_app.fonts, Stds_FontKey( font_str, font_size ) )
+                        : NULL;
+
+  if ( f == NULL ) {
+    SDL_LogInfo( SDL_LOG_CATEGORY_APPLICATION, "Could not find font %s, %d.", font_str, font_size );
+    return NULL;
+  }
+
+  return *f;
+}
+
+/**
+ * Allocates a font_t with its name and size set and adds it to the font
+ * cache. The caller opens the TTF_Font.
+ *
+ * @param const char * font path, used as the font's name.
+ * @param uint16_t font size.
+ *
+ * @return font_t * pointer to font object.
+ */
+static struct font_t *
+Stds_NewFont( const char *font_file, const uint16_t size ) {
   struct font_t *f;
+  f = malloc( sizeof( struct font_t ) );
+
+  if ( f == NULL ) {
+    SDL_LogInfo( SDL_LOG_CATEGORY_APPLICATION, "Could not allocate memory for font_t. %s.\n",
+                 SDL_GetError() );
+    exit( EXIT_FAILURE );
+  }
+
+  memset( f, 0, sizeof( struct font_t ) );
+  strncpy( f->name, font_file, MAX_FILE_NAME_LEN - 1 );
+  f->size = size;
+
+  Stds_HashMapPut( g_app.fonts, Stds_FontKey( font_file, size ), &f );
+
+  return f;
+}
+
+/**
+ * Builds the font cache key for a file and size, e.g. "res/nes.ttf:16".
+ * The key buffer grows to fit the whole path, so the size suffix is never
+ * cut off. The result is overwritten by the next call.
+ *
+ * @param const char * font path.
+ * @param uint16_t font size.
+ *
+ * @return const char * key.
+ */
+static const char *
+Stds_FontKey( const char *font_file, const uint16_t size ) {
+  /* The path, ':', up to five digits of a uint16_t and the terminator. */
+  const size_t length = strlen( font_file ) + 7;
+
+  if ( length > font_key_size ) {
+    char *key = realloc( font_key, length );
 
-  for ( f = g_app.font_head.next; f != NULL; f = f->next ) {
-    if ( strcmp( f->name, font_str ) == 0 && f->size == font_size ) {
-      return f->font;
+    if ( key == NULL ) {
+      SDL_LogInfo( SDL_LOG_CATEGORY_APPLICATION, "Could not allocate memory for font key. %s.\n",
+                   SDL_GetError() );
+      exit( EXIT_FAILURE );
     }
+
+    font_key      = key;
+    font_key_size = length;
   }
 
-  if ( f == NULL ) {
-    SDL_LogInfo( SDL_LOG_CATEGORY_APPLICATION, "Could not find font %s, %d.", font_str, font_size );
+  snprintf( font_key, font_key_size, "%s:%u", font_file, ( uint32_t ) size );
+  return font_key;
+}
+/**
+ * Rasterizes every printable ASCII glyph of the font once, in white, into a
+ * glyph atlas owned by the font. Drawing then only tints the cached glyphs
+ * with the requested color.
+ *
+ * @param font_t * pointer to font.
+ *
+ * @return void.
+ */
+static void
+Stds_BuildGlyphCache( struct font_t *f ) {
+  const SDL_Color white = { 0xff, 0xff, 0xff, 0xff };
+
+  f->glyph_atlas = Stds_AtlasCreate( STDS_GLYPH_PAGE_SIZE, STDS_GLYPH_PAGE_SIZE );
+
+  for ( uint16_t i = 0; i < STDS_GLYPH_COUNT; i++ ) {
+    uint16_t        ch = ( uint16_t )( STDS_GLYPH_FIRST + i );
+    struct glyph_t *g  = &f->glyphs[i];
+    g->region          = -1;
+    g->advance         = 0;
+
+    if ( !TTF_GlyphIsProvided( f->font, ch ) ) {
+      continue;
+    }
+
+    TTF_GlyphMetrics( f->font, ch, NULL, NULL, NULL, NULL, &g->advance );
+
+    SDL_Surface *surface = TTF_RenderGlyph_Solid( f->font, ch, white );
+    if ( surface != NULL ) {
+      g->region = Stds_AtlasAddSurface( f->glyph_atlas, surface );
+      SDL_FreeSurface( surface );
+    }
   }
 
-  return NULL;
-}
\ No newline at end of file
+  Stds_AtlasUpload( f->glyph_atlas );
+}
@@ -19,6 +19,10 @@
  */
 #include "../include/text_field.h"
 
+static struct stds_pool_t *text_field_pool;
+
+static struct text_field_t *Stds_AllocTextField( void );
+
 /**
  *
  */
@@ -26,14 +30,7 @@ struct text_field_t *
 Stds_CreateTextFieldBlank( float x, float y, const char *font_directory, const uint16_t font_size,
                            SDL_Color *font_color ) {
   struct text_field_t *tf;
-  tf = malloc( sizeof( struct text_field_t ) );
-
-  if ( tf == NULL ) {
-    fprintf( stderr, "Error: could not allocate memory for text_field_t.\n" );
-    exit( EXIT_FAILURE );
-  }
-
-  memset( tf, 0, sizeof( struct text_field_t ) );
+  tf = Stds_AllocTextField();
 
   tf->x              = x;
   tf->y              = y;
@@ -51,17 +48,13 @@ struct text_field_t *
 Stds_CreateTextField( float x, float y, char *text, const char *font_directory,
                       const uint16_t font_size, SDL_Color *c ) {
   struct text_field_t *tf;
-  tf = malloc( sizeof( struct text_field_t ) );
+  tf = Stds_AllocTextField();
 
-  if ( tf == NULL ) {
-    fprintf( stderr, "Error: could not allocate memory for text_field_t.\n" );
-    exit( EXIT_FAILURE );
-  }
-
-  memset( tf, 0, sizeof( struct text_field_t ) );
-
-  tf->x = x;
-  tf->y = y;
+  tf->x              = x;
+  tf->y              = y;
+  tf->font_directory = font_directory;
+  tf->font_size      = font_size;
+  tf->font_color     = c;
   strcpy( tf->text, text );
 
   return tf;
@@ -78,11 +71,44 @@ Stds_AlterTextField( struct text_field_t *tf, float x, float y, char *text ) {
 }
 
 /**
+ * Turns text input into a field on or off. Only one field reads text at a
+ * time, so turning one on takes the focus from any other.
  *
+ * @param text_field_t * text field.
+ * @param bool true to read text into the field, false to stop.
+ *
+ * @return void.
  */
 void
 Stds_ToggleTextField( struct text_field_t *tf, bool can_read_text ) {
-  tf->toggle_text_input = can_read_text;
+  if ( can_read_text ) {
+    Stds_FocusTextField( tf );
+  } else if ( g_app.input.focus == tf ) {
+    Stds_FocusTextField( NULL );
+  }
+}
+
+/**
+ * Makes a text field the one that receives typed text, starting SDL text
+ * input, or stops text input when given NULL.
+ *
+ * @param text_field_t * text field to focus, or NULL.
+ *
+ * @return void.
+ */
+void
+Stds_FocusTextField( struct text_field_t *tf ) {
+  if ( g_app.input.focus != NULL ) {
+    g_app.input.focus->toggle_text_input = false;
+  }
+
+  g_app.input.focus = tf;
+  if ( tf != NULL ) {
+    tf->toggle_text_input = true;
+    SDL_StartTextInput();
+  } else {
+    SDL_StopTextInput();
+  }
 }
 
 /**
@@ -103,6 +129,46 @@ Stds_ReadTextField( struct text_field_t *tf, const SDL_Event *event ) {
 void
 Stds_DrawTextField( struct text_field_t *tf ) {
   if ( strlen( tf->text ) != 0 ) {
-    Stds_DrawText( tf->x, tf->y, tf->font_directory, tf->font_size, tf->font_color, tf->text );
+    /* The text object only re-rasterizes when the field's contents change. */
+    if ( tf->text_object == NULL ) {
+      tf->text_object =
+        Stds_TextCreate( tf->font_directory, tf->font_size, tf->font_color, tf->text );
+    }
+
+    Stds_TextSet( tf->text_object, tf->text );
+    Stds_TextSetColor( tf->text_object, tf->font_color );
+    Stds_TextDraw( tf->text_object, tf->x, tf->y );
+  }
+}
+
+/**
+ * Frees a text field and its text object.
+ *
+ * @param text_field_t * text field to free.
+ *
+ * @return void.
+ */
+void
+Stds_TextFieldDie( struct text_field_t *tf ) {
+  if ( g_app.input.focus == tf ) {
+    g_app.input.focus = NULL;
   }
-}
\ No newline at end of file
+  Stds_TextDie( tf->text_object );
+  Stds_PoolFree( text_field_pool, tf );
+}
+
+/**
+ * Takes a zeroed text_field_t from its pool.
+ *
+ * @param void.
+ *
+ * @return text_field_t * new text field.
+ */
+static struct text_field_t *
+Stds_AllocTextField( void ) {
+  if ( text_field_pool == NULL ) {
+    text_field_pool = Stds_PoolCreate( sizeof( struct text_field_t ), STDS_OBJECT_POOL_BLOCK );
+  }
+
+  return Stds_PoolAlloc( text_field_pool );
+}
@@ -0,0 +1,628 @@
+/**
+ * @file tilemap.c
+ * @author Joshua Crotts
+ * @date October 14 2026
+ * @version 1.0
+ *
+ * @section LICENSE
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License as
+ * published by the Free Software Foundation; either version 2 of
+ * the License, or (at your option) any later version.
+ *
+ * @section DESCRIPTION
+ *
+ * This file defines the binary tilemap format and its streaming loader. A file is a
+ * header, a table of chunk offsets, and one block per chunk; all values are
+ * little-endian.
+ *
+ *   header   "STMP", version, cols, rows, tile_w, tile_h, chunk_size, chunk_cols,
+ *            chunk_rows, reserved (0)                             (40 bytes)
+ *   offsets  uint32_t[chunk_cols * chunk_rows], from the start of the file
+ *   block    uint16_t tiles[chunk_size * chunk_size], row-major, then
+ *            uint8_t flags[chunk_size * chunk_size], padded to 4 bytes
+ *
+ * Edge chunks are padded to the full chunk size. On POSIX systems the file is
+ * memory-mapped and the tile arrays are read in place; elsewhere, chunks are read
+ * through SDL_RWops. Either way, Stds_StreamTilemap keeps only the chunks around the
+ * camera resident, and the rest cost no memory.
+ */
+#include "../include/tilemap.h"
+#include "../include/camera.h"
+#include "../include/draw.h"
+
+#if ( defined( __unix__ ) || defined( __APPLE__ ) ) && SDL_BYTEORDER == SDL_LIL_ENDIAN && \
+    !defined( STDS_NO_MMAP )
+#define STDS_TILEMAP_MMAP
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+static const char tilemap_magic[4] = { 'S', 'T', 'M', 'P' };
+
+static size_t Stds_TilemapBlockSize( const uint32_t chunk_size );
+static bool   Stds_ReadTilemapHeader( struct tilemap_t *map, SDL_RWops *rw, const Sint64 size );
+static void   Stds_LoadTilemapChunk( struct tilemap_t *map, const uint32_t index );
+static void   Stds_EvictTilemapChunk( struct tilemap_t *map, const uint32_t index );
+static void   Stds_BakeTilemapChunk( struct tilemap_t *map, const uint32_t chunk_col,
+                                     const uint32_t chunk_row );
+
+/**
+ * Opens a binary tilemap. Only the header and chunk table are read; chunks
+ * become resident when streamed, drawn or queried. The map scrolls with the
+ * camera unless is_camera_offset_enabled is cleared.
+ *
+ * @param const char * path to the tilemap file.
+ *
+ * @return tilemap_t * the tilemap, or NULL if the file is missing or invalid.
+ */
+struct tilemap_t *
+Stds_LoadTilemap( const char *file_path ) {
+  SDL_RWops *rw = SDL_RWFromFile( file_path, "rb" );
+
+  if ( rw == NULL ) {
+    SDL_LogInfo( SDL_LOG_CATEGORY_APPLICATION, "Could not open tilemap %s. %s.\n", file_path,
+                 SDL_GetError() );
+    return NULL;
+  }
+
+  struct tilemap_t *map = calloc( 1, sizeof( struct tilemap_t ) );
+
+  if ( map == NULL ) {
+    SDL_LogInfo( SDL_LOG_CATEGORY_APPLICATION, "Could not allocate memory for tilemap_t. %s.\n",
+                 SDL_GetError() );
+    exit( EXIT_FAILURE );
+  }
+
+  Sint64 size = SDL_RWsize( rw );
+
+  if ( !Stds_ReadTilemapHeader( map, rw, size ) ) {
+    SDL_LogInfo( SDL_LOG_CATEGORY_APPLICATION, "%s is not a valid tilemap.\n", file_path );
+    SDL_RWclose( rw );
+    free( map->chunk_offsets );
+    free( map );
+    return NULL;
+  }
+
+#ifdef STDS_TILEMAP_MMAP
+  int fd = open( file_path, O_RDONLY );
+
+  if ( fd != -1 ) {
+    void *addr = mmap( NULL, ( size_t ) size, PROT_READ, MAP_PRIVATE, fd, 0 );
+    close( fd );
+
+    if ( addr != MAP_FAILED ) {
+      SDL_RWclose( rw );
+      rw            = NULL;
+      map->map      = addr;
+      map->map_size = ( size_t ) size;
+    }
+  }
+#endif
+
+  /* Without a mapping, chunks are read from the still-open file. */
+  map->rw                       = rw;
+  map->is_camera_offset_enabled = true;
+
+  SDL_LogDebug( SDL_LOG_CATEGORY_APPLICATION, "Loaded tilemap %s (%ux%u, %u chunks).\n",
+                file_path, map->cols, map->rows, map->chunk_cols * map->chunk_rows );
+  return map;
+}
+
+/**
+ * Writes a tilemap in the binary format read by Stds_LoadTilemap.
+ *
+ * @param const char * path of the file to write.
+ * @param uint32_t number of columns.
+ * @param uint32_t number of rows.
+ * @param uint32_t width of a tile in pixels.
+ * @param uint32_t height of a tile in pixels.
+ * @param uint32_t tiles per side of a chunk, or 0 for STDS_GRID_CHUNK_SIZE.
+ * @param uint16_t * cols * rows tile indices, row-major. 0 is empty.
+ * @param uint8_t * cols * rows collision flags, row-major, or NULL for none.
+ *
+ * @return bool true on success.
+ */
+bool
+Stds_SaveTilemap( const char *file_path, const uint32_t cols, const uint32_t rows,
+                  const uint32_t tile_w, const uint32_t tile_h, const uint32_t chunk_size,
+                  const uint16_t *tiles, const uint8_t *flags ) {
+  const uint32_t cs         = chunk_size > 0 ? chunk_size : STDS_GRID_CHUNK_SIZE;
+  const uint32_t chunk_cols = ( cols + cs - 1 ) / cs;
+  const uint32_t chunk_rows = ( rows + cs - 1 ) / cs;
+  const size_t   block      = Stds_TilemapBlockSize( cs );
+  const uint8_t  zero[4]    = { 0, 0, 0, 0 };
+
+  if ( cs > STDS_TILEMAP_MAX_CHUNK_SIZE || cols > STDS_TILEMAP_MAX_SIDE
+       || rows > STDS_TILEMAP_MAX_SIDE ) {
+    SDL_LogInfo( SDL_LOG_CATEGORY_APPLICATION, "Tilemap %s is too large to save.\n", file_path );
+    return false;
+  }
+
+  SDL_RWops *rw = SDL_RWFromFile( file_path, "wb" );
+
+  if ( rw == NULL ) {
+    SDL_LogInfo( SDL_LOG_CATEGORY_APPLICATION, "Could not open %s for the tilemap. %s.\n",
+                 file_path, SDL_GetError() );
+    return false;
+  }
+
+  const uint32_t fields[9] = { STDS_TILEMAP_VERSION, cols, rows, tile_w, tile_h, cs,
+                               chunk_cols, chunk_rows, 0 };
+  SDL_RWwrite( rw, tilemap_magic, 1, sizeof( tilemap_magic ) );
+  for ( int32_t i = 0; i < 9; i++ ) {
+    SDL_WriteLE32( rw, fields[i] );
+  }
+
+  const size_t data_start = STDS_TILEMAP_HEADER_SIZE + sizeof( uint32_t ) * chunk_cols * chunk_rows;
+  for ( uint32_t i = 0; i < chunk_cols * chunk_rows; i++ ) {
+    SDL_WriteLE32( rw, ( uint32_t ) ( data_start + i * block ) );
+  }
+
+  for ( uint32_t cr = 0; cr < chunk_rows; cr++ ) {
+    for ( uint32_t cc = 0; cc < chunk_cols; cc++ ) {
+      for ( uint32_t r = cr * cs; r < ( cr + 1 ) * cs; r++ ) {
+        for ( uint32_t c = cc * cs; c < ( cc + 1 ) * cs; c++ ) {
+          SDL_WriteLE16( rw, r < rows && c < cols ? tiles[r * cols + c] : 0 );
+        }
+      }
+
+      for ( uint32_t r = cr * cs; r < ( cr + 1 ) * cs; r++ ) {
+        for ( uint32_t c = cc * cs; c < ( cc + 1 ) * cs; c++ ) {
+          uint8_t f = r < rows && c < cols && flags != NULL ? flags[r * cols + c] : 0;
+          SDL_RWwrite( rw, &f, 1, 1 );
+        }
+      }
+
+      SDL_RWwrite( rw, zero, 1, block - ( size_t ) cs * cs * 3 );
+    }
+  }
+
+  return SDL_RWclose( rw ) == 0;
+}
+
+/**
+ * Sets the sprite sheet the tilemap draws from. Tile index t > 0 is cell
+ * t - 1 of the sheet, counted row-major with sheet_cols cells per row.
+ *
+ * @param tilemap_t * tilemap.
+ * @param SDL_Texture * sprite sheet texture; the tilemap does not own it.
+ * @param uint32_t number of columns in the sheet.
+ *
+ * @return void.
+ */
+void
+Stds_SetTilemapSpriteSheet( struct tilemap_t *map, SDL_Texture *sprite_sheet,
+                            const uint32_t sheet_cols ) {
+  map->sprite_sheet = sprite_sheet;
+  map->sheet_cols   = sheet_cols > 0 ? sheet_cols : 1;
+
+  for ( uint32_t i = 0; i < map->chunk_cols * map->chunk_rows; i++ ) {
+    if ( map->chunks[i].texture != NULL ) {
+      Stds_ForgetTextureState( map->chunks[i].texture );
+      SDL_DestroyTexture( map->chunks[i].texture );
+      map->chunks[i].texture = NULL;
+    }
+  }
+}
+
+/**
+ * Makes the chunks within margin chunks of the camera's view resident, and
+ * releases every other chunk along with its baked texture. Call this once
+ * per frame after the camera moves.
+ *
+ * @param tilemap_t * tilemap.
+ * @param uint32_t chunks to keep around the view, e.g. STDS_TILEMAP_STREAM_MARGIN.
+ *
+ * @return void.
+ */
+void
+Stds_StreamTilemap( struct tilemap_t *map, const uint32_t margin ) {
+  uint32_t c0, r0, c1, r1;
+
+  const float chunk_w = ( float ) ( map->chunk_size * map->tile_w );
+  const float chunk_h = ( float ) ( map->chunk_size * map->tile_h );
+
+  bool is_visible = Stds_GetVisibleCellRange( 0, 0, chunk_w, chunk_h, map->chunk_cols,
+                                              map->chunk_rows, map->is_camera_offset_enabled,
+                                              &c0, &r0, &c1, &r1 );
+
+  if ( is_visible ) {
+    c0 = c0 > margin ? c0 - margin : 0;
+    r0 = r0 > margin ? r0 - margin : 0;
+    c1 = c1 + margin < map->chunk_cols ? c1 + margin : map->chunk_cols - 1;
+    r1 = r1 + margin < map->chunk_rows ? r1 + margin : map->chunk_rows - 1;
+  }
+
+  for ( uint32_t cr = 0; cr < map->chunk_rows; cr++ ) {
+    for ( uint32_t cc = 0; cc < map->chunk_cols; cc++ ) {
+      uint32_t index = cr * map->chunk_cols + cc;
+
+      if ( is_visible && cc >= c0 && cc <= c1 && cr >= r0 && cr <= r1 ) {
+        Stds_LoadTilemapChunk( map, index );
+      } else if ( map->chunks[index].is_resident ) {
+        Stds_EvictTilemapChunk( map, index );
+      }
+    }
+  }
+}
+
+/**
+ * Draws the chunks of the tilemap that overlap the camera's view. Each chunk
+ * is baked into a texture the first time it is drawn while resident, so the
+ * per-frame cost is one draw per visible chunk. Baked chunks are dropped and
+ * baked again after the renderer reports that render targets were reset.
+ *
+ * @param tilemap_t * tilemap.
+ *
+ * @return void.
+ */
+void
+Stds_DrawTilemap( struct tilemap_t *map ) {
+  uint32_t    c0, r0, c1, r1;
+  const float chunk_w = ( float ) ( map->chunk_size * map->tile_w );
+  const float chunk_h = ( float ) ( map->chunk_size * map->tile_h );
+
+  if ( map->sprite_sheet == NULL ||
+       !Stds_GetVisibleCellRange( 0, 0, chunk_w, chunk_h, map->chunk_cols, map->chunk_rows,
+                                  map->is_camera_offset_enabled, &c0, &r0, &c1, &r1 ) ) {
+    return;
+  }
+
+  if ( map->target_resets != g_app.target_resets ) {
+    map->target_resets = g_app.target_resets;
+
+    for ( uint32_t i = 0; i < map->chunk_cols * map->chunk_rows; i++ ) {
+      if ( map->chunks[i].texture != NULL ) {
+        Stds_ForgetTextureState( map->chunks[i].texture );
+        SDL_DestroyTexture( map->chunks[i].texture );
+        map->chunks[i].texture = NULL;
+      }
+    }
+  }
+
+  for ( uint32_t cr = r0; cr <= r1; cr++ ) {
+    for ( uint32_t cc = c0; cc <= c1; cc++ ) {
+      struct tilemap_chunk_t *chunk = &map->chunks[cr * map->chunk_cols + cc];
+
+      if ( chunk->texture == NULL ) {
+        Stds_BakeTilemapChunk( map, cc, cr );
+      }
+
+      if ( chunk->texture != NULL ) {
+        int32_t w, h;
+        SDL_QueryTexture( chunk->texture, NULL, NULL, &w, &h );
+        Stds_DrawTexture( chunk->texture, ( float ) cc * chunk_w, ( float ) cr * chunk_h,
+                          ( float ) w, ( float ) h, 0, SDL_FLIP_NONE, NULL,
+                          map->is_camera_offset_enabled );
+      }
+    }
+  }
+}
+
+/**
+ * Returns the tile index at a cell, loading its chunk if needed.
+ *
+ * @param tilemap_t * tilemap.
+ * @param uint32_t column.
+ * @param uint32_t row.
+ *
+ * @return uint16_t tile index, or 0 outside the map.
+ */
+uint16_t
+Stds_GetTilemapTile( struct tilemap_t *map, const uint32_t col, const uint32_t row ) {
+  if ( col >= map->cols || row >= map->rows ) {
+    return 0;
+  }
+
+  uint32_t index = ( row / map->chunk_size ) * map->chunk_cols + col / map->chunk_size;
+  Stds_LoadTilemapChunk( map, index );
+
+  const struct tilemap_chunk_t *chunk = &map->chunks[index];
+  return chunk->tiles != NULL
+             ? chunk->tiles[( row % map->chunk_size ) * map->chunk_size + col % map->chunk_size]
+             : 0;
+}
+
+/**
+ * Returns the collision flags at a cell, loading its chunk if needed.
+ *
+ * @param tilemap_t * tilemap.
+ * @param uint32_t column.
+ * @param uint32_t row.
+ *
+ * @return uint8_t flags, or 0 outside the map.
+ */
+uint8_t
+Stds_GetTilemapFlags( struct tilemap_t *map, const uint32_t col, const uint32_t row ) {
+  if ( col >= map->cols || row >= map->rows ) {
+    return 0;
+  }
+
+  uint32_t index = ( row / map->chunk_size ) * map->chunk_cols + col / map->chunk_size;
+  Stds_LoadTilemapChunk( map, index );
+
+  const struct tilemap_chunk_t *chunk = &map->chunks[index];
+  return chunk->flags != NULL
+             ? chunk->flags[( row % map->chunk_size ) * map->chunk_size + col % map->chunk_size]
+             : 0;
+}
+
+/**
+ * Releases every chunk, unmaps or closes the file and frees the tilemap.
+ *
+ * @param tilemap_t * tilemap.
+ *
+ * @return void.
+ */
+void
+Stds_FreeTilemap( struct tilemap_t *map ) {
+  for ( uint32_t i = 0; i < map->chunk_cols * map->chunk_rows; i++ ) {
+    Stds_EvictTilemapChunk( map, i );
+  }
+
+#ifdef STDS_TILEMAP_MMAP
+  if ( map->map != NULL ) {
+    munmap( map->map, map->map_size );
+  }
+#endif
+
+  if ( map->rw != NULL ) {
+    SDL_RWclose( map->rw );
+  }
+
+  free( map->chunk_offsets );
+  free( map->chunks );
+  free( map );
+}
+
+/**
+ * Returns the size of one chunk block: the tiles and flags, padded to four
+ * bytes.
+ *
+ * @param uint32_t tiles per side of a chunk.
+ *
+ * @return size_t bytes.
+ */
+static size_t
+Stds_TilemapBlockSize( const uint32_t chunk_size ) {
+  return ( ( size_t ) chunk_size * chunk_size * 3 + 3 ) & ~( size_t ) 3;
+}
+
+/**
+ * Reads and validates the header and chunk table, and allocates the chunk
+ * array.
+ *
+ * @param tilemap_t * tilemap to fill in.
+ * @param SDL_RWops * file positioned at its start.
+ * @param Sint64 size of the file in bytes.
+ *
+ * @return bool true if the file is a valid tilemap.
+ */
+static bool
+Stds_ReadTilemapHeader( struct tilemap_t *map, SDL_RWops *rw, const Sint64 size ) {
+  char magic[4];
+
+  if ( size < STDS_TILEMAP_HEADER_SIZE || SDL_RWread( rw, magic, 1, 4 ) != 4 ||
+       memcmp( magic, tilemap_magic, 4 ) != 0 || SDL_ReadLE32( rw ) != STDS_TILEMAP_VERSION ) {
+    return false;
+  }
+
+  map->cols       = SDL_ReadLE32( rw );
+  map->rows       = SDL_ReadLE32( rw );
+  map->tile_w     = SDL_ReadLE32( rw );
+  map->tile_h     = SDL_ReadLE32( rw );
+  map->chunk_size = SDL_ReadLE32( rw );
+  map->chunk_cols = SDL_ReadLE32( rw );
+  map->chunk_rows = SDL_ReadLE32( rw );
+  SDL_ReadLE32( rw );
+
+  /* Cap the sizes first, so none of the arithmetic below can wrap. */
+  if ( map->cols == 0 || map->rows == 0 || map->chunk_size == 0 ||
+       map->cols > STDS_TILEMAP_MAX_SIDE || map->rows > STDS_TILEMAP_MAX_SIDE ||
+       map->chunk_size > STDS_TILEMAP_MAX_CHUNK_SIZE ||
+       map->chunk_cols != ( map->cols + map->chunk_size - 1 ) / map->chunk_size ||
+       map->chunk_rows != ( map->rows + map->chunk_size - 1 ) / map->chunk_size ) {
+    return false;
+  }
+
+  const uint64_t table = ( uint64_t ) map->chunk_cols * map->chunk_rows * 4;
+  const size_t   block = Stds_TilemapBlockSize( map->chunk_size );
+
+  /* Chunk offsets are 32-bit, so the table must end within the first 4 GiB too. */
+  if ( table > UINT32_MAX - STDS_TILEMAP_HEADER_SIZE
+       || STDS_TILEMAP_HEADER_SIZE + table > ( uint64_t ) size ) {
+    return false;
+  }
+
+  const uint32_t count = ( uint32_t ) ( table / 4 );
+
+  map->chunk_offsets = malloc( sizeof( uint32_t ) * count );
+  map->chunks        = calloc( count, sizeof( struct tilemap_chunk_t ) );
+
+  if ( map->chunk_offsets == NULL || map->chunks == NULL ) {
+    SDL_LogInfo( SDL_LOG_CATEGORY_APPLICATION,
+                 "Could not allocate memory for tilemap chunks. %s.\n", SDL_GetError() );
+    exit( EXIT_FAILURE );
+  }
+
+  for ( uint32_t i = 0; i < count; i++ ) {
+    map->chunk_offsets[i] = SDL_ReadLE32( rw );
+    if ( map->chunk_offsets[i] % 4 != 0 ||
+         ( Sint64 ) map->chunk_offsets[i] + ( Sint64 ) block > size ) {
+      free( map->chunks );
+      map->chunks = NULL;
+      return false;
+    }
+  }
+
+  return true;
+}
+
+/**
+ * Makes a chunk resident. Mapped chunks point straight into the mapping and
+ * only get a read-ahead hint; otherwise the block is read into a buffer.
+ *
+ * @param tilemap_t * tilemap.
+ * @param uint32_t chunk index.
+ *
+ * @return void.
+ */
+static void
+Stds_LoadTilemapChunk( struct tilemap_t *map, const uint32_t index ) {
+  struct tilemap_chunk_t *chunk = &map->chunks[index];
+  const size_t            block = Stds_TilemapBlockSize( map->chunk_size );
+  uint8_t *               data  = NULL;
+
+  if ( chunk->is_resident ) {
+    return;
+  }
+
+#ifdef STDS_TILEMAP_MMAP
+  if ( map->map != NULL ) {
+    const uintptr_t page  = ( uintptr_t ) sysconf( _SC_PAGESIZE );
+    uint8_t *       start = ( uint8_t * ) map->map + map->chunk_offsets[index];
+    uint8_t *       first = ( uint8_t * ) ( ( uintptr_t ) start & ~( page - 1 ) );
+
+    madvise( first, ( size_t ) ( start + block - first ), MADV_WILLNEED );
+    data = start;
+  }
+#endif
+
+  if ( data == NULL ) {
+    chunk->buffer = malloc( block );
+
+    if ( chunk->buffer == NULL ) {
+      SDL_LogInfo( SDL_LOG_CATEGORY_APPLICATION,
+                   "Could not allocate memory for tilemap chunk. %s.\n", SDL_GetError() );
+      exit( EXIT_FAILURE );
+    }
+
+    data = chunk->buffer;
+    if ( SDL_RWseek( map->rw, map->chunk_offsets[index], RW_SEEK_SET ) < 0 ||
+         SDL_RWread( map->rw, data, 1, block ) != block ) {
+      SDL_LogDebug( SDL_LOG_CATEGORY_APPLICATION, "Could not read tilemap chunk %u.\n", index );
+      memset( data, 0, block );
+    }
+
+#if SDL_BYTEORDER == SDL_BIG_ENDIAN
+    uint16_t *tiles = ( uint16_t * ) data;
+    for ( uint32_t i = 0; i < map->chunk_size * map->chunk_size; i++ ) {
+      tiles[i] = SDL_SwapLE16( tiles[i] );
+    }
+#endif
+  }
+
+  chunk->tiles       = ( const uint16_t * ) data;
+  chunk->flags       = data + ( size_t ) map->chunk_size * map->chunk_size * 2;
+  chunk->is_resident = true;
+  map->resident_count++;
+}
+
+/**
+ * Releases a resident chunk: destroys its baked texture, and frees its buffer
+ * or lets the kernel drop its mapped pages.
+ *
+ * @param tilemap_t * tilemap.
+ * @param uint32_t chunk index.
+ *
+ * @return void.
+ */
+static void
+Stds_EvictTilemapChunk( struct tilemap_t *map, const uint32_t index ) {
+  struct tilemap_chunk_t *chunk = &map->chunks[index];
+
+  if ( chunk->texture != NULL ) {
+    Stds_ForgetTextureState( chunk->texture );
+    SDL_DestroyTexture( chunk->texture );
+    chunk->texture = NULL;
+  }
+
+  if ( !chunk->is_resident ) {
+    return;
+  }
+
+#ifdef STDS_TILEMAP_MMAP
+  if ( map->map != NULL ) {
+    const uintptr_t page  = ( uintptr_t ) sysconf( _SC_PAGESIZE );
+    uint8_t *       start = ( uint8_t * ) map->map + map->chunk_offsets[index];
+    uint8_t *       first = ( uint8_t * ) ( ( uintptr_t ) start & ~( page - 1 ) );
+
+    madvise( first, ( size_t ) ( start + Stds_TilemapBlockSize( map->chunk_size ) - first ),
+             MADV_DONTNEED );
+  }
+#endif
+
+  free( chunk->buffer );
+  chunk->buffer      = NULL;
+  chunk->tiles       = NULL;
+  chunk->flags       = NULL;
+  chunk->is_resident = false;
+  map->resident_count--;
+}
+
+/**
+ * Draws one chunk's tiles into a new render-target texture. Edge chunks are
+ * only as large as the cells they cover. The previous render target is
+ * restored afterwards.
+ *
+ * @param tilemap_t * tilemap.
+ * @param uint32_t column of the chunk.
+ * @param uint32_t row of the chunk.
+ *
+ * @return void.
+ */
+static void
+Stds_BakeTilemapChunk( struct tilemap_t *map, const uint32_t chunk_col,
+                       const uint32_t chunk_row ) {
+  const uint32_t  index       = chunk_row * map->chunk_cols + chunk_col;
+  const uint32_t  cs          = map->chunk_size;
+  const uint32_t  cols        = map->cols - chunk_col * cs < cs ? map->cols - chunk_col * cs : cs;
+  const uint32_t  rows        = map->rows - chunk_row * cs < cs ? map->rows - chunk_row * cs : cs;
+  const SDL_Color transparent = { 0, 0, 0, 0 };
+  int32_t         sheet_w, sheet_h;
+
+  Stds_LoadTilemapChunk( map, index );
+  struct tilemap_chunk_t *chunk = &map->chunks[index];
+
+  chunk->texture = SDL_CreateTexture( g_app.renderer, SDL_PIXELFORMAT_RGBA8888,
+                                      SDL_TEXTUREACCESS_TARGET, ( int ) ( cols * map->tile_w ),
+                                      ( int ) ( rows * map->tile_h ) );
+  if ( chunk->texture == NULL ) {
+    SDL_LogDebug( SDL_LOG_CATEGORY_APPLICATION, "Could not create tilemap chunk texture. %s.\n",
+                  SDL_GetError() );
+    return;
+  }
+  Stds_SetTextureBlendMode( chunk->texture, SDL_BLENDMODE_BLEND );
+  SDL_QueryTexture( map->sprite_sheet, NULL, NULL, &sheet_w, &sheet_h );
+
+  SDL_Texture *previous_target = SDL_GetRenderTarget( g_app.renderer );
+  SDL_SetRenderTarget( g_app.renderer, chunk->texture );
+  Stds_SetDrawColor( &transparent );
+  SDL_RenderClear( g_app.renderer );
+
+  for ( uint32_t r = 0; r < rows; r++ ) {
+    for ( uint32_t c = 0; c < cols; c++ ) {
+      uint16_t tile = chunk->tiles[r * cs + c];
+
+      if ( tile == 0 ) {
+        continue;
+      }
+
+      SDL_Rect  src  = { ( int ) ( ( tile - 1u ) % map->sheet_cols * map->tile_w ),
+                        ( int ) ( ( tile - 1u ) / map->sheet_cols * map->tile_h ),
+                        ( int ) map->tile_w, ( int ) map->tile_h };
+      SDL_FRect dest = { ( float ) ( c * map->tile_w ), ( float ) ( r * map->tile_h ),
+                         ( float ) map->tile_w, ( float ) map->tile_h };
+
+      if ( src.y < sheet_h ) {
+        SDL_RenderCopyF( g_app.renderer, map->sprite_sheet, &src, &dest );
+      }
+    }
+  }
+
+  SDL_SetRenderTarget( g_app.renderer, previous_target );
+}
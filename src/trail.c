@@ -13,10 +13,21 @@
  *
  * @section DESCRIPTION
  *
- * This file defines trail functionality with alpha-blending support.
+ * This file defines trail functionality with alpha-blending support. Trail
+ * emitters keep their segments in a fixed ring and draw them in batches;
+ * the older Stds_Add*Trail functions append heap segments to the g_app trail
+ * list instead, which the game has to update, unlink and free itself.
  */
 #include "../include/trail.h"
 
+static struct stds_pool_t *trail_pool;
+
+static struct trail_t *Stds_AllocTrail( void );
+static int16_t         Stds_TrailSegmentAlpha( const struct trail_emitter_t *e,
+                                               const struct trail_segment_t *segment );
+static void            Stds_DrawTrailSegments( const struct trail_emitter_t *e, const int32_t first,
+                                               const int32_t n );
+
 /**
  * Initializes a trail object using the supplied Entity as the parent
  * where it will stay for the duration of its life. The trail is added
@@ -33,16 +44,7 @@
 void
 Stds_AddTextureTrail( struct entity_t *parent, int16_t alpha_decay, SDL_RendererFlip flip,
                       bool is_transparent ) {
-  struct trail_t *t;
-  t = malloc( sizeof( struct trail_t ) );
-
-  if ( t == NULL ) {
-    SDL_LogInfo( SDL_LOG_CATEGORY_APPLICATION, "Could not allocate memory for trail_t. %s.\n",
-                 SDL_GetError() );
-    exit( EXIT_FAILURE );
-  }
-
-  memset( t, 0, sizeof( struct trail_t ) );
+  struct trail_t *t = Stds_AllocTrail();
 
   t->pos  = Stds_CloneVec2( &parent->pos );
   t->w    = parent->w;
@@ -75,15 +77,7 @@ Stds_AddTextureTrail( struct entity_t *parent, int16_t alpha_decay, SDL_Renderer
  */
 void
 Stds_AddCircleTrail( float x, float y, int32_t r, int16_t alpha_decay, SDL_Color *c ) {
-  struct trail_t *t;
-  t = malloc( sizeof( struct trail_t ) );
-
-  if ( t == NULL ) {
-    SDL_LogInfo( SDL_LOG_CATEGORY_APPLICATION,
-                 "Could not allocate memory for circular trail_t. %s.\n", SDL_GetError() );
-    exit( EXIT_FAILURE );
-  }
-  memset( t, 0, sizeof( struct trail_t ) );
+  struct trail_t *t = Stds_AllocTrail();
 
   t->pos.x = x;
   t->pos.y = y;
@@ -104,15 +98,7 @@ Stds_AddCircleTrail( float x, float y, int32_t r, int16_t alpha_decay, SDL_Color
  */
 void
 Stds_AddSquareTrail( float x, float y, int32_t w, int32_t h, int16_t alpha_decay, SDL_Color *c ) {
-  struct trail_t *t;
-  t = malloc( sizeof( struct trail_t ) );
-
-  if ( t == NULL ) {
-    SDL_LogInfo( SDL_LOG_CATEGORY_APPLICATION,
-                 "Could not allocate memory for square trail_t. %s.\n", SDL_GetError() );
-    exit( EXIT_FAILURE );
-  }
-  memset( t, 0, sizeof( struct trail_t ) );
+  struct trail_t *t = Stds_AllocTrail();
 
   t->pos.x = x;
   t->pos.y = y;
@@ -161,10 +147,10 @@ void
 Stds_TrailDraw( struct trail_t *t ) {
   /* If texture. */
   if ( !( t->flags & STDS_TRAIL_TRANSPARENT_TEXTURE_MASK ) ) {
-    SDL_SetTextureBlendMode( t->texture, SDL_BLENDMODE_BLEND );
+    Stds_SetTextureBlendMode( t->texture, SDL_BLENDMODE_BLEND );
   }
 
-  SDL_SetTextureAlphaMod( t->texture, t->alpha );
+  Stds_SetTextureAlphaMod( t->texture, t->alpha );
   Stds_DrawTexture( t->texture, t->pos.x, t->pos.y, t->w, t->h, t->angle, t->flip, NULL, true );
 
   /* If shape. */
@@ -175,8 +161,315 @@ Stds_TrailDraw( struct trail_t *t ) {
     struct circle_t circle = { t->pos.x + t->r / 2, t->pos.y + t->r / 2, t->r };
     Stds_DrawCircle( &circle, &t->color, true );
   }
+}
 
-  if ( !( t->flags & STDS_TRAIL_TRANSPARENT_TEXTURE_MASK ) ) {
-    SDL_SetTextureBlendMode( t->texture, SDL_BLENDMODE_NONE );
+/**
+ * Creates a trail emitter. Its memory is allocated once here: capacity is
+ * the most segments it ever holds, and once full, each new segment replaces
+ * the oldest. A segment lives for 255 / alpha_decay_rate updates, so a
+ * capacity of that many segments per emit per update is enough.
+ *
+ * @param int32_t maximum number of live segments.
+ * @param int16_t alpha lost per update (should be between 1 and 255).
+ * @param uint32_t one of STDS_TRAIL_TEXTURE_MASK, STDS_TRAIL_TRANSPARENT_TEXTURE_MASK,
+ *        STDS_TRAIL_SQUARE_MASK or STDS_TRAIL_CIRCLE_MASK.
+ * @param SDL_Color * color of shape trails; may be NULL for texture trails.
+ *
+ * @return trail_emitter_t * pointer to the emitter.
+ */
+struct trail_emitter_t *
+Stds_CreateTrailEmitter( const int32_t capacity, const int16_t alpha_decay_rate,
+                         const uint32_t flags, const SDL_Color *color ) {
+  struct trail_emitter_t *e;
+  e = malloc( sizeof( struct trail_emitter_t ) );
+
+  if ( e == NULL ) {
+    SDL_LogInfo( SDL_LOG_CATEGORY_APPLICATION,
+                 "Could not allocate memory for trail_emitter_t. %s.\n", SDL_GetError() );
+    exit( EXIT_FAILURE );
+  }
+
+  memset( e, 0, sizeof( struct trail_emitter_t ) );
+
+  e->capacity    = capacity > 0 ? capacity : 1;
+  e->segments    = malloc( sizeof( struct trail_segment_t ) * ( size_t ) e->capacity );
+  e->draw_rects   = malloc( sizeof( SDL_FRect ) * ( size_t ) e->capacity );
+  e->draw_circles = malloc( sizeof( struct circle_t ) * ( size_t ) e->capacity );
+  e->draw_colors  = malloc( sizeof( SDL_Color ) * ( size_t ) e->capacity );
+
+  if ( e->segments == NULL || e->draw_rects == NULL || e->draw_circles == NULL
+       || e->draw_colors == NULL ) {
+    SDL_LogInfo( SDL_LOG_CATEGORY_APPLICATION,
+                 "Could not allocate memory for trail_emitter_t segments. %s.\n",
+                 SDL_GetError() );
+    exit( EXIT_FAILURE );
+  }
+
+  e->alpha_decay_rate         = alpha_decay_rate > 0 ? alpha_decay_rate : 1;
+  e->flags                    = flags;
+  e->is_camera_offset_enabled = true;
+
+  if ( color != NULL ) {
+    e->color = *color;
+  }
+
+  return e;
+}
+
+/**
+ * Adds a segment to the emitter. For circle emitters, w is the radius and
+ * h is ignored; shape emitters ignore texture and flip.
+ *
+ * @param trail_emitter_t * emitter.
+ * @param float top-left x position.
+ * @param float top-left y position.
+ * @param float width (or radius).
+ * @param float height.
+ * @param SDL_Texture * texture for texture trails.
+ * @param SDL_RendererFlip flip for texture trails.
+ *
+ * @return void.
+ */
+void
+Stds_EmitTrail( struct trail_emitter_t *e, const float x, const float y, const float w,
+                const float h, SDL_Texture *texture, const SDL_RendererFlip flip ) {
+  int32_t index;
+
+  if ( e->count == e->capacity ) {
+    index   = e->head;
+    e->head = ( e->head + 1 ) % e->capacity;
+  } else {
+    index = ( e->head + e->count++ ) % e->capacity;
+  }
+
+  struct trail_segment_t *segment = &e->segments[index];
+  segment->x                      = x;
+  segment->y                      = y;
+  segment->w                      = w;
+  segment->h                      = h;
+  segment->born                   = e->tick;
+  segment->flip                   = flip;
+  segment->texture                = texture;
+}
+
+/**
+ * Adds a segment showing the entity's current frame at its position. The
+ * entity must use a static texture or a non-spritesheet animation.
+ *
+ * @param trail_emitter_t * emitter.
+ * @param entity_t * entity to copy.
+ * @param SDL_RendererFlip flip for the segment.
+ *
+ * @return void.
+ */
+void
+Stds_EmitEntityTrail( struct trail_emitter_t *e, const struct entity_t *parent,
+                      const SDL_RendererFlip flip ) {
+  SDL_Texture *texture;
+
+  if ( parent->animation != NULL ) {
+    if ( parent->animation->id_flags & STDS_SPRITE_SHEET_MASK ) {
+      printf( "Trails are unsupported with entities that have spritesheets.\n" );
+      exit( EXIT_FAILURE );
+    }
+    texture = parent->animation->frames[parent->animation->current_frame_id];
+  } else {
+    texture = parent->texture[0];
+  }
+
+  Stds_EmitTrail( e, parent->pos.x, parent->pos.y, ( float ) parent->w, ( float ) parent->h,
+                  texture, flip );
+}
+
+/**
+ * Ages every segment by one update and drops the ones that have faded out.
+ * Since they all fade at the same rate, only the oldest few are ever
+ * checked.
+ *
+ * @param trail_emitter_t * emitter.
+ *
+ * @return void.
+ */
+void
+Stds_UpdateTrailEmitter( struct trail_emitter_t *e ) {
+  e->tick++;
+
+  while ( e->count > 0 && Stds_TrailSegmentAlpha( e, &e->segments[e->head] ) <= 0 ) {
+    e->head = ( e->head + 1 ) % e->capacity;
+    e->count--;
+  }
+}
+
+/**
+ * Draws the emitter's segments, oldest first. Square trails and runs of
+ * unflipped segments sharing a texture are drawn with one Stds_DrawQuads
+ * call each.
+ *
+ * @param trail_emitter_t * emitter.
+ *
+ * @return void.
+ */
+void
+Stds_DrawTrailEmitter( const struct trail_emitter_t *e ) {
+  /* The live segments are at most two contiguous runs of the ring. */
+  int32_t first_run = e->head + e->count <= e->capacity ? e->count : e->capacity - e->head;
+
+  Stds_DrawTrailSegments( e, e->head, first_run );
+  Stds_DrawTrailSegments( e, 0, e->count - first_run );
+}
+
+/**
+ * Removes every segment from the emitter.
+ *
+ * @param trail_emitter_t * emitter.
+ *
+ * @return void.
+ */
+void
+Stds_ClearTrailEmitter( struct trail_emitter_t *e ) {
+  e->head  = 0;
+  e->count = 0;
+}
+
+/**
+ * Frees the emitter and its ring.
+ *
+ * @param trail_emitter_t * emitter.
+ *
+ * @return void.
+ */
+void
+Stds_TrailEmitterDie( struct trail_emitter_t *e ) {
+  free( e->segments );
+  free( e->draw_rects );
+  free( e->draw_circles );
+  free( e->draw_colors );
+  free( e );
+}
+
+/**
+ * Frees a trail segment. Whoever unlinks a dead trail from the g_app list
+ * calls this instead of free().
+ *
+ * @param trail_t * trail to free.
+ *
+ * @return void.
+ */
+void
+Stds_TrailDie( struct trail_t *t ) {
+  Stds_PoolFree( trail_pool, t );
+}
+
+/**
+ * Takes a zeroed trail segment from the trail pool. Trails are added every
+ * frame and die a few frames later, so they come from a free-list slab
+ * rather than malloc.
+ *
+ * @param void.
+ *
+ * @return trail_t * new trail.
+ */
+static struct trail_t *
+Stds_AllocTrail( void ) {
+  if ( trail_pool == NULL ) {
+    trail_pool = Stds_PoolCreate( sizeof( struct trail_t ), STDS_TRAIL_POOL_BLOCK );
   }
-}
\ No newline at end of file
+
+  return Stds_PoolAlloc( trail_pool );
+}
+
+/**
+ * Computes a segment's alpha from its age. Like Stds_TrailUpdate, a segment
+ * starts losing alpha on the update after it was emitted.
+ *
+ * @param trail_emitter_t * emitter.
+ * @param trail_segment_t * segment.
+ *
+ * @return int16_t alpha, which is zero or negative once the segment is dead.
+ */
+static int16_t
+Stds_TrailSegmentAlpha( const struct trail_emitter_t *e, const struct trail_segment_t *segment ) {
+  int32_t alpha = 0xff - ( int32_t ) ( e->tick - segment->born ) * e->alpha_decay_rate;
+  return ( int16_t ) ( alpha < 0 ? 0 : alpha );
+}
+
+/**
+ * Draws n consecutive ring slots starting at first.
+ *
+ * @param trail_emitter_t * emitter.
+ * @param int32_t first ring index.
+ * @param int32_t number of segments.
+ *
+ * @return void.
+ */
+static void
+Stds_DrawTrailSegments( const struct trail_emitter_t *e, const int32_t first, const int32_t n ) {
+  const struct trail_segment_t *segments = &e->segments[first];
+
+  if ( n <= 0 ) {
+    return;
+  }
+
+  /* The circle mask shares its bits with the two texture masks. */
+  if ( ( e->flags & STDS_TRAIL_CIRCLE_MASK ) == STDS_TRAIL_CIRCLE_MASK ) {
+    const float cx = e->is_camera_offset_enabled ? g_app.camera.x : 0;
+    const float cy = e->is_camera_offset_enabled ? g_app.camera.y : 0;
+
+    for ( int32_t i = 0; i < n; i++ ) {
+      const struct trail_segment_t *s = &segments[i];
+
+      e->draw_circles[i]  = ( struct circle_t ){ s->x + s->w / 2 - cx, s->y + s->w / 2 - cy, s->w };
+      e->draw_colors[i]   = e->color;
+      e->draw_colors[i].a = ( uint8_t ) Stds_TrailSegmentAlpha( e, s );
+    }
+
+    Stds_DrawCircles( e->draw_circles, e->draw_colors, n, true );
+    return;
+  }
+
+  if ( e->flags & STDS_TRAIL_SQUARE_MASK ) {
+    for ( int32_t i = 0; i < n; i++ ) {
+      e->draw_rects[i]    = ( SDL_FRect ){ segments[i].x, segments[i].y, segments[i].w,
+                                        segments[i].h };
+      e->draw_colors[i]   = e->color;
+      e->draw_colors[i].a = ( uint8_t ) Stds_TrailSegmentAlpha( e, &segments[i] );
+    }
+
+    Stds_SetDrawBlendMode( SDL_BLENDMODE_BLEND );
+    Stds_DrawQuads( NULL, e->draw_rects, NULL, e->draw_colors, n, e->is_camera_offset_enabled );
+    return;
+  }
+
+  /* Texture trails: batch each run of unflipped segments with one texture. */
+  for ( int32_t i = 0; i < n; ) {
+    const struct trail_segment_t *s     = &segments[i];
+    uint8_t                       alpha = ( uint8_t ) Stds_TrailSegmentAlpha( e, s );
+
+    if ( ( e->flags & STDS_TRAIL_CIRCLE_MASK ) != STDS_TRAIL_TRANSPARENT_TEXTURE_MASK ) {
+      Stds_SetTextureBlendMode( s->texture, SDL_BLENDMODE_BLEND );
+    }
+
+    if ( s->flip != SDL_FLIP_NONE ) {
+      Stds_SetTextureAlphaMod( s->texture, alpha );
+      Stds_DrawTexture( s->texture, s->x, s->y, s->w, s->h, 0, s->flip, NULL,
+                        e->is_camera_offset_enabled );
+      Stds_SetTextureAlphaMod( s->texture, 0xff );
+      i++;
+      continue;
+    }
+
+    int32_t run = 0;
+    while ( i + run < n && segments[i + run].texture == s->texture &&
+            segments[i + run].flip == SDL_FLIP_NONE ) {
+      const struct trail_segment_t *r = &segments[i + run];
+      e->draw_rects[run]              = ( SDL_FRect ){ r->x, r->y, r->w, r->h };
+      e->draw_colors[run] = ( SDL_Color ){ 0xff, 0xff, 0xff,
+                                           ( uint8_t ) Stds_TrailSegmentAlpha( e, r ) };
+      run++;
+    }
+
+    Stds_DrawQuads( s->texture, e->draw_rects, NULL, e->draw_colors, run,
+                    e->is_camera_offset_enabled );
+    i += run;
+  }
+}
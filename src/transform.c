@@ -0,0 +1,312 @@
+/**
+ * @file transform.c
+ * @author Joshua Crotts
+ * @date October 14 2026
+ * @version 1.0
+ *
+ * @section LICENSE
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License as
+ * published by the Free Software Foundation; either version 2 of
+ * the License, or (at your option) any later version.
+ *
+ * @section DESCRIPTION
+ *
+ * This file defines 2x3 affine transforms and an optional parent-child
+ * hierarchy of them. A composed matrix carries translation, rotation and
+ * scale at once, so layered objects (a player with attached weapons and
+ * trails) do their trig once per change instead of once per draw.
+ *
+ * World matrices of transform nodes are computed lazily: a node keeps its
+ * last world matrix and the version of its parent's world matrix it was
+ * built from, and only recomputes when its own fields or an ancestor changed.
+ */
+#include "../include/transform.h"
+
+static void Stds_RebuildLocalTransform( struct transform_node_t *node );
+
+/**
+ * @param void.
+ *
+ * @return transform_t identity matrix.
+ */
+struct transform_t
+Stds_TransformIdentity( void ) {
+  return ( struct transform_t ){ 1.f, 0, 0, 1.f, 0, 0 };
+}
+
+/**
+ * @param float x offset.
+ * @param float y offset.
+ *
+ * @return transform_t matrix that translates by (x, y).
+ */
+struct transform_t
+Stds_TransformTranslation( const float x, const float y ) {
+  return ( struct transform_t ){ 1.f, 0, 0, 1.f, x, y };
+}
+
+/**
+ * Builds the matrix that scales by (sx, sy), then rotates by angle, then
+ * translates by (x, y).
+ *
+ * @param float x translation.
+ * @param float y translation.
+ * @param float angle of rotation in degrees.
+ * @param float horizontal scale.
+ * @param float vertical scale.
+ *
+ * @return transform_t matrix.
+ */
+struct transform_t
+Stds_TransformFromTRS( const float x, const float y, const float angle, const float sx,
+                       const float sy ) {
+  float s, c;
+  Stds_SinCosDegrees( angle, &s, &c );
+
+  return ( struct transform_t ){ c * sx, s * sx, -s * sy, c * sy, x, y };
+}
+
+/**
+ * Composes two matrices. The result applies child first, then parent, so
+ * it maps child-local points straight into the parent's space.
+ *
+ * @param transform_t * pointer to the outer (parent) matrix.
+ * @param transform_t * pointer to the inner (child) matrix.
+ *
+ * @return transform_t parent * child.
+ */
+struct transform_t
+Stds_TransformCompose( const struct transform_t *parent, const struct transform_t *child ) {
+  struct transform_t m;
+
+  m.a  = parent->a * child->a + parent->c * child->b;
+  m.b  = parent->b * child->a + parent->d * child->b;
+  m.c  = parent->a * child->c + parent->c * child->d;
+  m.d  = parent->b * child->c + parent->d * child->d;
+  m.tx = parent->a * child->tx + parent->c * child->ty + parent->tx;
+  m.ty = parent->b * child->tx + parent->d * child->ty + parent->ty;
+  return m;
+}
+
+/**
+ * Inverts a matrix, e.g. to map a screen point back into an object's local
+ * space.
+ *
+ * @param transform_t * pointer to the matrix.
+ * @param transform_t * pointer that receives the inverse. Untouched on failure.
+ *
+ * @return bool false if the matrix is singular (it has a zero scale).
+ */
+bool
+Stds_TransformInvert( const struct transform_t *m, struct transform_t *out ) {
+  const float det = m->a * m->d - m->b * m->c;
+
+  if ( det == 0 ) {
+    return false;
+  }
+
+  const float        inv = 1.f / det;
+  struct transform_t r;
+
+  r.a  = m->d * inv;
+  r.b  = -m->b * inv;
+  r.c  = -m->c * inv;
+  r.d  = m->a * inv;
+  r.tx = -( r.a * m->tx + r.c * m->ty );
+  r.ty = -( r.b * m->tx + r.d * m->ty );
+
+  *out = r;
+  return true;
+}
+
+/**
+ * @param transform_t * pointer to the matrix.
+ * @param vec2_t * pointer to the point to transform.
+ *
+ * @return vec2_t transformed point.
+ */
+struct vec2_t
+Stds_TransformPoint( const struct transform_t *m, const struct vec2_t *p ) {
+  return Stds_CreateVec2( m->a * p->x + m->c * p->y + m->tx, m->b * p->x + m->d * p->y + m->ty );
+}
+
+/**
+ * Returns the matrix that maps level coordinates to screen coordinates for
+ * the current camera position. Composing it with a world matrix replaces
+ * subtracting the camera offset in each draw call.
+ *
+ * @param void.
+ *
+ * @return transform_t camera matrix.
+ */
+struct transform_t
+Stds_CameraTransform( void ) {
+  return Stds_TransformTranslation( -g_app.camera.x, -g_app.camera.y );
+}
+
+/**
+ * Creates a transform node at the origin of its parent, with no rotation
+ * and unit scale.
+ *
+ * @param transform_node_t * pointer to the parent node, or NULL for a root.
+ *
+ * @return transform_node_t * pointer to the new node.
+ */
+struct transform_node_t *
+Stds_CreateTransformNode( struct transform_node_t *parent ) {
+  struct transform_node_t *node;
+  node = malloc( sizeof( struct transform_node_t ) );
+
+  if ( node == NULL ) {
+    SDL_LogInfo( SDL_LOG_CATEGORY_APPLICATION,
+                 "Could not allocate memory for transform_node_t. %s.\n", SDL_GetError() );
+    exit( EXIT_FAILURE );
+  }
+
+  memset( node, 0, sizeof( struct transform_node_t ) );
+
+  node->parent   = parent;
+  node->scale    = Stds_CreateVec2( 1.f, 1.f );
+  node->local    = Stds_TransformIdentity();
+  node->world    = node->local;
+  node->is_dirty = true;
+  return node;
+}
+
+/**
+ * Attaches a node to a different parent, or detaches it with NULL. The
+ * node's local fields are kept, so it jumps to the same offset relative to
+ * the new parent.
+ *
+ * @param transform_node_t * pointer to the node.
+ * @param transform_node_t * pointer to the new parent, or NULL.
+ *
+ * @return void.
+ */
+void
+Stds_SetTransformNodeParent( struct transform_node_t *node, struct transform_node_t *parent ) {
+  node->parent   = parent;
+  node->is_dirty = true;
+}
+
+/**
+ * @param transform_node_t * pointer to the node.
+ * @param float x position relative to the parent.
+ * @param float y position relative to the parent.
+ *
+ * @return void.
+ */
+void
+Stds_SetTransformNodePosition( struct transform_node_t *node, const float x, const float y ) {
+  if ( node->position.x != x || node->position.y != y ) {
+    node->position = Stds_CreateVec2( x, y );
+    node->is_dirty = true;
+  }
+}
+
+/**
+ * @param transform_node_t * pointer to the node.
+ * @param float angle in degrees relative to the parent.
+ *
+ * @return void.
+ */
+void
+Stds_SetTransformNodeAngle( struct transform_node_t *node, const float angle ) {
+  if ( node->angle != angle ) {
+    node->angle    = angle;
+    node->is_dirty = true;
+  }
+}
+
+/**
+ * @param transform_node_t * pointer to the node.
+ * @param float horizontal scale relative to the parent.
+ * @param float vertical scale relative to the parent.
+ *
+ * @return void.
+ */
+void
+Stds_SetTransformNodeScale( struct transform_node_t *node, const float sx, const float sy ) {
+  if ( node->scale.x != sx || node->scale.y != sy ) {
+    node->scale    = Stds_CreateVec2( sx, sy );
+    node->is_dirty = true;
+  }
+}
+
+/**
+ * Returns the node's world matrix, recomputing it (and its ancestors') only
+ * if something changed since the last query. Calling this every frame for
+ * unchanged nodes costs one version comparison per ancestor.
+ *
+ * @param transform_node_t * pointer to the node.
+ *
+ * @return const transform_t * pointer to the node's world matrix, valid until
+ *         the node changes.
+ */
+const struct transform_t *
+Stds_GetWorldTransform( struct transform_node_t *node ) {
+  const struct transform_t *parent_world = NULL;
+
+  if ( node->parent != NULL ) {
+    parent_world = Stds_GetWorldTransform( node->parent );
+  }
+
+  bool is_parent_current = node->parent == NULL || node->parent->version == node->parent_version;
+  if ( !node->is_dirty && is_parent_current ) {
+    return &node->world;
+  }
+
+  if ( node->is_dirty ) {
+    Stds_RebuildLocalTransform( node );
+  }
+
+  if ( parent_world != NULL ) {
+    node->world          = Stds_TransformCompose( parent_world, &node->local );
+    node->parent_version = node->parent->version;
+  } else {
+    node->world = node->local;
+  }
+
+  node->version++;
+  return &node->world;
+}
+
+/**
+ * @param transform_node_t * pointer to the node.
+ *
+ * @return vec2_t origin of the node in world space.
+ */
+struct vec2_t
+Stds_GetTransformNodeWorldPosition( struct transform_node_t *node ) {
+  const struct transform_t *world = Stds_GetWorldTransform( node );
+  return Stds_CreateVec2( world->tx, world->ty );
+}
+
+/**
+ * Frees a transform node. Children are not freed or detached, so detach or
+ * free them first.
+ *
+ * @param transform_node_t * pointer to the node.
+ *
+ * @return void.
+ */
+void
+Stds_TransformNodeDie( struct transform_node_t *node ) {
+  free( node );
+}
+
+/**
+ * Rebuilds the local matrix of a node from its position, angle and scale.
+ *
+ * @param transform_node_t * pointer to the node.
+ *
+ * @return void.
+ */
+static void
+Stds_RebuildLocalTransform( struct transform_node_t *node ) {
+  node->local    = Stds_TransformFromTRS( node->position.x, node->position.y, node->angle,
+                                       node->scale.x, node->scale.y );
+  node->is_dirty = false;
+}
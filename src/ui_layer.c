@@ -0,0 +1,491 @@
+/**
+ * @file ui_layer.c
+ * @author Joshua Crotts
+ * @date October 14 2026
+ * @version 1.0
+ *
+ * @section LICENSE
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License as
+ * published by the Free Software Foundation; either version 2 of
+ * the License, or (at your option) any later version.
+ *
+ * @section DESCRIPTION
+ *
+ * This file defines retained UI layers for menu and editor screens. A layer
+ * draws its buttons, text fields and custom elements into a cached texture
+ * once, then every frame compares each element's state (position, colors,
+ * texture, caption, hover and press state, focus) with the state it was
+ * drawn in. Only the regions of elements that changed are cleared and
+ * drawn again; an unchanged layer costs one texture copy per frame.
+ *
+ * Together with Stds_SetRedrawOnDemand this lets idle menus skip drawing
+ * entirely: Stds_UILayerUpdate requests a redraw only when a region is dirty.
+ *
+ * A layer redraws itself whole after the renderer reports that render targets
+ * were reset, since the cached texture is blank then.
+ *
+ * Layers draw straight to the renderer, so Stds_UILayerDraw must not be
+ * called inside a sprite batch. While the draw delegate is being recorded
+ * into a command buffer, or if the renderer has no render targets, the
+ * elements are drawn directly every frame instead.
+ */
+#include "../include/ui_layer.h"
+
+#define STDS_UI_FNV_OFFSET 2166136261u
+#define STDS_UI_FNV_PRIME  16777619u
+
+static struct ui_element_t *Stds_UIAddElement( struct ui_layer_t *layer, const uint8_t kind,
+                                               void *widget );
+static void                 Stds_UIAddDirty( struct ui_layer_t *layer, const SDL_Rect *rect );
+static bool                 Stds_UIRefreshElement( struct ui_element_t *e );
+static void                 Stds_UIDrawElement( const struct ui_element_t *e );
+static void                 Stds_UIDrawAll( const struct ui_layer_t *layer );
+static uint32_t             Stds_UIHash( uint32_t hash, const void *data, const size_t size );
+
+/**
+ * Creates a UI layer the size of w by h screen pixels, drawn at the top-left
+ * corner of the screen.
+ *
+ * @param int32_t width of the layer.
+ * @param int32_t height of the layer.
+ * @param SDL_Color * color regions are cleared to before they are redrawn.
+ *        Transparent lets the scene behind the layer show through.
+ *
+ * @return ui_layer_t * pointer to the layer.
+ */
+struct ui_layer_t *
+Stds_CreateUILayer( const int32_t w, const int32_t h, const SDL_Color *background ) {
+  struct ui_layer_t *layer;
+  layer = malloc( sizeof( struct ui_layer_t ) );
+
+  if ( layer == NULL ) {
+    SDL_LogInfo( SDL_LOG_CATEGORY_APPLICATION, "Could not allocate memory for ui_layer_t. %s.\n",
+                 SDL_GetError() );
+    exit( EXIT_FAILURE );
+  }
+
+  memset( layer, 0, sizeof( struct ui_layer_t ) );
+
+  layer->w          = w;
+  layer->h          = h;
+  layer->background = *background;
+  layer->texture    = SDL_CreateTexture( g_app.renderer, SDL_PIXELFORMAT_RGBA8888,
+                                      SDL_TEXTUREACCESS_TARGET, w, h );
+
+  if ( layer->texture == NULL ) {
+    SDL_LogDebug( SDL_LOG_CATEGORY_APPLICATION,
+                  "Could not create UI layer texture, drawing it directly. %s.\n",
+                  SDL_GetError() );
+  } else {
+    Stds_SetTextureBlendMode( layer->texture, SDL_BLENDMODE_BLEND );
+  }
+
+  layer->target_resets = g_app.target_resets;
+  Stds_UILayerInvalidate( layer, NULL );
+  return layer;
+}
+
+/**
+ * Adds a button to a layer. The button's struct is read every frame, so it
+ * must stay alive until it is removed with Stds_UILayerRemove.
+ *
+ * @param ui_layer_t * pointer to the layer.
+ * @param button_t * pointer to the button.
+ *
+ * @return void.
+ */
+void
+Stds_UILayerAddButton( struct ui_layer_t *layer, struct button_t *button ) {
+  Stds_UIAddElement( layer, STDS_UI_BUTTON, button );
+}
+
+/**
+ * Adds a text field to a layer. The field must stay alive until it is
+ * removed with Stds_UILayerRemove.
+ *
+ * @param ui_layer_t * pointer to the layer.
+ * @param text_field_t * pointer to the text field.
+ *
+ * @return void.
+ */
+void
+Stds_UILayerAddTextField( struct ui_layer_t *layer, struct text_field_t *tf ) {
+  Stds_UIAddElement( layer, STDS_UI_TEXT_FIELD, tf );
+}
+
+/**
+ * Adds an element the layer cannot inspect, such as a grid or a panel. It is
+ * drawn by calling draw( data ) with the clip set to the dirty region, and
+ * is only redrawn when its rect is invalidated with Stds_UILayerInvalidate.
+ *
+ * @param ui_layer_t * pointer to the layer.
+ * @param SDL_Rect * bounds the element draws inside.
+ * @param void (*)( void * ) function that draws the element.
+ * @param void * data passed to draw, also used to remove the element.
+ *
+ * @return void.
+ */
+void
+Stds_UILayerAddCustom( struct ui_layer_t *layer, const SDL_Rect *rect, void ( *draw )( void * ),
+                       void *data ) {
+  struct ui_element_t *e = Stds_UIAddElement( layer, STDS_UI_CUSTOM, data );
+  e->draw                = draw;
+  e->rect                = *rect;
+  Stds_UIAddDirty( layer, rect );
+}
+
+/**
+ * Removes a button, text field or custom element (by its data pointer) from
+ * a layer and clears the region it covered.
+ *
+ * @param ui_layer_t * pointer to the layer.
+ * @param void * pointer to the widget.
+ *
+ * @return void.
+ */
+void
+Stds_UILayerRemove( struct ui_layer_t *layer, const void *widget ) {
+  for ( int32_t i = 0; i < layer->element_count; i++ ) {
+    if ( layer->elements[i].widget == widget ) {
+      Stds_UIAddDirty( layer, &layer->elements[i].rect );
+
+      layer->element_count--;
+      memmove( &layer->elements[i], &layer->elements[i + 1],
+               sizeof( struct ui_element_t ) * ( size_t ) ( layer->element_count - i ) );
+      return;
+    }
+  }
+}
+
+/**
+ * Marks a region of a layer to be redrawn, e.g. after a custom element
+ * changed.
+ *
+ * @param ui_layer_t * pointer to the layer.
+ * @param SDL_Rect * region in screen pixels, or NULL for the whole layer.
+ *
+ * @return void.
+ */
+void
+Stds_UILayerInvalidate( struct ui_layer_t *layer, const SDL_Rect *rect ) {
+  if ( rect == NULL ) {
+    layer->dirty[0]    = ( SDL_Rect ){ 0, 0, layer->w, layer->h };
+    layer->dirty_count = 1;
+    Stds_RequestRedraw();
+    return;
+  }
+
+  Stds_UIAddDirty( layer, rect );
+}
+
+/**
+ * Compares every element with the state it was last drawn in and marks the
+ * ones that changed dirty, both where they were and where they are now.
+ * Stds_UILayerDraw calls this itself; call it from the update delegate when
+ * using Stds_SetRedrawOnDemand, so changes request a redraw.
+ *
+ * @param ui_layer_t * pointer to the layer.
+ *
+ * @return void.
+ */
+void
+Stds_UILayerUpdate( struct ui_layer_t *layer ) {
+  if ( layer->target_resets != g_app.target_resets ) {
+    layer->target_resets = g_app.target_resets;
+    Stds_UILayerInvalidate( layer, NULL );
+  }
+
+  for ( int32_t i = 0; i < layer->element_count; i++ ) {
+    struct ui_element_t *e   = &layer->elements[i];
+    SDL_Rect             old = e->rect;
+
+    if ( Stds_UIRefreshElement( e ) ) {
+      Stds_UIAddDirty( layer, &old );
+      Stds_UIAddDirty( layer, &e->rect );
+    }
+  }
+
+  if ( layer->dirty_count > 0 ) {
+    Stds_RequestRedraw();
+  }
+}
+
+/**
+ * Redraws the dirty regions of a layer into its texture, then draws the
+ * texture to the screen. UI layers ignore the camera.
+ *
+ * @param ui_layer_t * pointer to the layer.
+ *
+ * @return bool true if any region was redrawn this call.
+ */
+bool
+Stds_UILayerDraw( struct ui_layer_t *layer ) {
+  Stds_UILayerUpdate( layer );
+
+  if ( layer->texture == NULL || Stds_IsRecordingCommands() ) {
+    Stds_UIDrawAll( layer );
+    layer->dirty_count = 0;
+    return true;
+  }
+
+  const bool is_redrawn = layer->dirty_count > 0;
+
+  if ( is_redrawn ) {
+    SDL_Texture *previous_target = SDL_GetRenderTarget( g_app.renderer );
+    SDL_FRect    camera          = g_app.camera;
+    g_app.camera.x               = 0;
+    g_app.camera.y               = 0;
+
+    SDL_SetRenderTarget( g_app.renderer, layer->texture );
+
+    for ( int32_t d = 0; d < layer->dirty_count; d++ ) {
+      const SDL_Rect *region = &layer->dirty[d];
+
+      SDL_RenderSetClipRect( g_app.renderer, region );
+      Stds_SetDrawBlendMode( SDL_BLENDMODE_NONE );
+      Stds_SetDrawColor( &layer->background );
+      SDL_RenderFillRect( g_app.renderer, region );
+      Stds_SetDrawBlendMode( SDL_BLENDMODE_BLEND );
+
+      for ( int32_t i = 0; i < layer->element_count; i++ ) {
+        if ( SDL_HasIntersection( &layer->elements[i].rect, region ) ) {
+          Stds_UIDrawElement( &layer->elements[i] );
+        }
+      }
+    }
+
+    SDL_RenderSetClipRect( g_app.renderer, NULL );
+    SDL_SetRenderTarget( g_app.renderer, previous_target );
+    g_app.camera       = camera;
+    layer->dirty_count = 0;
+  }
+
+  Stds_DrawTexture( layer->texture, 0, 0, ( float ) layer->w, ( float ) layer->h, 0,
+                    SDL_FLIP_NONE, NULL, false );
+  return is_redrawn;
+}
+
+/**
+ * Frees a layer and its texture. The buttons and text fields in it are not
+ * freed.
+ *
+ * @param ui_layer_t * pointer to the layer.
+ *
+ * @return void.
+ */
+void
+Stds_UILayerDie( struct ui_layer_t *layer ) {
+  if ( layer->texture != NULL ) {
+    Stds_ForgetTextureState( layer->texture );
+    SDL_DestroyTexture( layer->texture );
+  }
+
+  free( layer->elements );
+  free( layer );
+}
+
+/**
+ * Appends an element to a layer. Its signature starts at zero, which the
+ * next update does not match, so the element gets drawn.
+ *
+ * @param ui_layer_t * pointer to the layer.
+ * @param uint8_t STDS_UI_BUTTON, STDS_UI_TEXT_FIELD or STDS_UI_CUSTOM.
+ * @param void * pointer to the widget.
+ *
+ * @return ui_element_t * pointer to the new element.
+ */
+static struct ui_element_t *
+Stds_UIAddElement( struct ui_layer_t *layer, const uint8_t kind, void *widget ) {
+  if ( layer->element_count == layer->element_capacity ) {
+    int32_t capacity = layer->element_capacity == 0 ? 16 : layer->element_capacity * 2;
+    struct ui_element_t *elements =
+      realloc( layer->elements, sizeof( struct ui_element_t ) * ( size_t ) capacity );
+
+    if ( elements == NULL ) {
+      SDL_LogInfo( SDL_LOG_CATEGORY_APPLICATION,
+                   "Could not allocate memory for ui_element_t. %s.\n", SDL_GetError() );
+      exit( EXIT_FAILURE );
+    }
+
+    layer->elements         = elements;
+    layer->element_capacity = capacity;
+  }
+
+  struct ui_element_t *e = &layer->elements[layer->element_count++];
+  memset( e, 0, sizeof( struct ui_element_t ) );
+
+  e->kind   = kind;
+  e->widget = widget;
+  return e;
+}
+
+/**
+ * Adds a region to the dirty list, merging it with every region it
+ * overlaps. When the list is full, the region is merged into the last one.
+ *
+ * @param ui_layer_t * pointer to the layer.
+ * @param SDL_Rect * region in screen pixels.
+ *
+ * @return void.
+ */
+static void
+Stds_UIAddDirty( struct ui_layer_t *layer, const SDL_Rect *rect ) {
+  const SDL_Rect bounds = { 0, 0, layer->w, layer->h };
+  SDL_Rect       region;
+
+  if ( !SDL_IntersectRect( rect, &bounds, &region ) ) {
+    return;
+  }
+
+  for ( int32_t i = 0; i < layer->dirty_count; ) {
+    if ( SDL_HasIntersection( &layer->dirty[i], &region ) ) {
+      SDL_UnionRect( &layer->dirty[i], &region, &region );
+      layer->dirty[i] = layer->dirty[--layer->dirty_count];
+      i               = 0;
+    } else {
+      i++;
+    }
+  }
+
+  if ( layer->dirty_count == STDS_UI_DIRTY_RECTS ) {
+    SDL_UnionRect( &layer->dirty[layer->dirty_count - 1], &region,
+                   &layer->dirty[layer->dirty_count - 1] );
+    return;
+  }
+
+  layer->dirty[layer->dirty_count++] = region;
+}
+
+/**
+ * Recomputes an element's signature, and its bounds when the signature
+ * changed.
+ *
+ * @param ui_element_t * pointer to the element.
+ *
+ * @return bool true if the element looks different than when it was drawn.
+ */
+static bool
+Stds_UIRefreshElement( struct ui_element_t *e ) {
+  uint32_t hash = STDS_UI_FNV_OFFSET;
+
+  if ( e->kind == STDS_UI_BUTTON ) {
+    const struct button_t *b         = e->widget;
+    const SDL_Texture *    texture   = b->texture[b->texture_id];
+    const uint32_t         text_hash = b->text != NULL ? Stds_HashString( b->text ) : 0;
+    const bool             is_hover  = Stds_IsMouseOverButton( ( struct button_t * ) b );
+    const bool             is_down   = is_hover && g_app.mouse.button[SDL_BUTTON_LEFT];
+
+    hash = Stds_UIHash( hash, &b->rect, sizeof( SDL_Rect ) );
+    hash = Stds_UIHash( hash, &b->color, sizeof( SDL_Color ) );
+    hash = Stds_UIHash( hash, &b->text_color, sizeof( SDL_Color ) );
+    hash = Stds_UIHash( hash, &texture, sizeof( texture ) );
+    hash = Stds_UIHash( hash, &text_hash, sizeof( text_hash ) );
+    hash = Stds_UIHash( hash, &b->text_x, sizeof( b->text_x ) );
+    hash = Stds_UIHash( hash, &b->text_y, sizeof( b->text_y ) );
+    hash = Stds_UIHash( hash, &b->is_filled, sizeof( b->is_filled ) );
+    hash = Stds_UIHash( hash, &is_hover, sizeof( is_hover ) );
+    hash = Stds_UIHash( hash, &is_down, sizeof( is_down ) );
+
+    if ( hash == e->signature ) {
+      return false;
+    }
+
+    /* The caption is centered on the button but may be wider than it. */
+    e->rect = b->rect;
+    if ( b->text != NULL && b->text[0] != '\0' ) {
+      SDL_Rect caption = { b->text_x, b->text_y, 0, 0 };
+      Stds_GetStringSize( b->text, b->font_path, b->font_size, &caption.w, &caption.h );
+      SDL_UnionRect( &e->rect, &caption, &e->rect );
+    }
+  } else if ( e->kind == STDS_UI_TEXT_FIELD ) {
+    const struct text_field_t *tf         = e->widget;
+    const uint32_t             text_hash  = Stds_HashString( tf->text );
+    const bool                 is_focused = g_app.input.focus == tf;
+
+    hash = Stds_UIHash( hash, &tf->x, sizeof( tf->x ) );
+    hash = Stds_UIHash( hash, &tf->y, sizeof( tf->y ) );
+    hash = Stds_UIHash( hash, &tf->font_size, sizeof( tf->font_size ) );
+    hash = Stds_UIHash( hash, tf->font_color, sizeof( SDL_Color ) );
+    hash = Stds_UIHash( hash, &text_hash, sizeof( text_hash ) );
+    hash = Stds_UIHash( hash, &is_focused, sizeof( is_focused ) );
+
+    if ( hash == e->signature ) {
+      return false;
+    }
+
+    e->rect = ( SDL_Rect ){ ( int32_t ) tf->x, ( int32_t ) tf->y, 0, 0 };
+    if ( tf->text[0] != '\0' ) {
+      Stds_GetStringSize( tf->text, tf->font_directory, tf->font_size, &e->rect.w, &e->rect.h );
+      e->rect.w++;
+      e->rect.h++;
+    }
+  } else {
+    return false;
+  }
+
+  e->signature = hash;
+  return true;
+}
+
+/**
+ * @param ui_element_t * pointer to the element.
+ *
+ * @return void.
+ */
+static void
+Stds_UIDrawElement( const struct ui_element_t *e ) {
+  switch ( e->kind ) {
+  case STDS_UI_BUTTON:
+    Stds_ButtonDraw( e->widget );
+    break;
+  case STDS_UI_TEXT_FIELD:
+    Stds_DrawTextField( e->widget );
+    break;
+  default:
+    e->draw( e->widget );
+    break;
+  }
+}
+
+/**
+ * Draws every element directly to the current target, for when the layer
+ * cannot be cached.
+ *
+ * @param ui_layer_t * pointer to the layer.
+ *
+ * @return void.
+ */
+static void
+Stds_UIDrawAll( const struct ui_layer_t *layer ) {
+  SDL_FRect camera = g_app.camera;
+  g_app.camera.x   = 0;
+  g_app.camera.y   = 0;
+
+  for ( int32_t i = 0; i < layer->element_count; i++ ) {
+    Stds_UIDrawElement( &layer->elements[i] );
+  }
+
+  g_app.camera = camera;
+}
+
+/**
+ * Folds bytes into a 32-bit FNV-1a hash.
+ *
+ * @param uint32_t hash so far.
+ * @param void * pointer to the bytes.
+ * @param size_t number of bytes.
+ *
+ * @return uint32_t updated hash.
+ */
+static uint32_t
+Stds_UIHash( uint32_t hash, const void *data, const size_t size ) {
+  const uint8_t *bytes = data;
+
+  for ( size_t i = 0; i < size; i++ ) {
+    hash = ( hash ^ bytes[i] ) * STDS_UI_FNV_PRIME;
+  }
+
+  return hash;
+}
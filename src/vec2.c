@@ -15,8 +15,12 @@
  *
  * This file defines the functions for a two-dimensional vector for (x,y) coordinates
  * such as velocity, position, acceleration/deceleration, and other miscellaneous factors.
+ *
+ * The array forms at the end work on contiguous vec2_t arrays, two vectors
+ * per SSE2/NEON register, with a scalar loop for the remainder.
  */
 #include "../include/vec2.h"
+#include "../include/simd.h"
 
 /**
  * Creates a vec2 struct with the specified positions.
@@ -85,8 +89,13 @@ Stds_SubVec2( struct vec2_t *u, const struct vec2_t *v ) {
  */
 inline void
 Stds_RotateVec2( struct vec2_t *v, const float angle ) {
-  v->x = v->x * cosf( angle ) - v->y * sinf( angle );
-  v->y = v->x * sinf( angle ) + v->y * cosf( angle );
+  const float x = v->x;
+  float       s, c;
+
+  Stds_SinCos( angle, &s, &c );
+
+  v->x = x * c - v->y * s;
+  v->y = x * s + v->y * c;
 }
 
 /**
@@ -199,3 +208,229 @@ Stds_DivideToVec2( struct vec2_t *v, const float divide ) {
   v->x /= divide;
   v->y /= divide;
 }
+
+/**
+ * Adds two arrays of vectors element by element: out[i] = u[i] + v[i]. out
+ * may be the same array as u or v.
+ *
+ * @param vec2_t * array that receives the sums.
+ * @param vec2_t * first array.
+ * @param vec2_t * second array.
+ * @param int32_t number of vectors.
+ *
+ * @return void.
+ */
+void
+Stds_AddVec2Array( struct vec2_t *out, const struct vec2_t *u, const struct vec2_t *v,
+                   const int32_t n ) {
+  int32_t i = 0;
+
+#if defined( STDS_SIMD_SSE2 )
+  for ( ; i + 2 <= n; i += 2 ) {
+    __m128 a = _mm_loadu_ps( &u[i].x );
+    __m128 b = _mm_loadu_ps( &v[i].x );
+    _mm_storeu_ps( &out[i].x, _mm_add_ps( a, b ) );
+  }
+#elif defined( STDS_SIMD_NEON )
+  for ( ; i + 2 <= n; i += 2 ) {
+    vst1q_f32( &out[i].x, vaddq_f32( vld1q_f32( &u[i].x ), vld1q_f32( &v[i].x ) ) );
+  }
+#endif
+
+  for ( ; i < n; i++ ) {
+    out[i].x = u[i].x + v[i].x;
+    out[i].y = u[i].y + v[i].y;
+  }
+}
+
+/**
+ * Multiplies every vector of an array by a scalar. out may be the same
+ * array as v.
+ *
+ * @param vec2_t * array that receives the scaled vectors.
+ * @param vec2_t * array to scale.
+ * @param float scalar.
+ * @param int32_t number of vectors.
+ *
+ * @return void.
+ */
+void
+Stds_ScaleVec2Array( struct vec2_t *out, const struct vec2_t *v, const float scale,
+                     const int32_t n ) {
+  int32_t i = 0;
+
+#if defined( STDS_SIMD_SSE2 )
+  const __m128 s = _mm_set1_ps( scale );
+  for ( ; i + 2 <= n; i += 2 ) {
+    _mm_storeu_ps( &out[i].x, _mm_mul_ps( _mm_loadu_ps( &v[i].x ), s ) );
+  }
+#elif defined( STDS_SIMD_NEON )
+  const float32x4_t s = vdupq_n_f32( scale );
+  for ( ; i + 2 <= n; i += 2 ) {
+    vst1q_f32( &out[i].x, vmulq_f32( vld1q_f32( &v[i].x ), s ) );
+  }
+#endif
+
+  for ( ; i < n; i++ ) {
+    out[i].x = v[i].x * scale;
+    out[i].y = v[i].y * scale;
+  }
+}
+
+/**
+ * Rotates every vector of an array by the same angle. The sine and cosine
+ * are computed once for the whole array. out may be the same array as v.
+ *
+ * @param vec2_t * array that receives the rotated vectors.
+ * @param vec2_t * array to rotate.
+ * @param float angle in radians.
+ * @param int32_t number of vectors.
+ *
+ * @return void.
+ */
+void
+Stds_RotateVec2Array( struct vec2_t *out, const struct vec2_t *v, const float angle,
+                      const int32_t n ) {
+  float s, c;
+  Stds_SinCos( angle, &s, &c );
+
+  const struct transform_t rotation = { c, s, -s, c, 0, 0 };
+  Stds_TransformVec2Array( out, v, &rotation, n );
+}
+
+/**
+ * Normalizes every vector of an array. Unlike Stds_NormalizeVec2, a vector
+ * of length zero stays zero instead of becoming NaN. out may be the same
+ * array as v.
+ *
+ * @param vec2_t * array that receives the unit vectors.
+ * @param vec2_t * array to normalize.
+ * @param int32_t number of vectors.
+ *
+ * @return void.
+ */
+void
+Stds_NormalizeVec2Array( struct vec2_t *out, const struct vec2_t *v, const int32_t n ) {
+  int32_t i = 0;
+
+#if defined( STDS_SIMD_SSE2 )
+  const __m128 zero = _mm_setzero_ps();
+  for ( ; i + 2 <= n; i += 2 ) {
+    __m128 p       = _mm_loadu_ps( &v[i].x );
+    __m128 sq      = _mm_mul_ps( p, p );
+    __m128 swapped = _mm_shuffle_ps( sq, sq, _MM_SHUFFLE( 2, 3, 0, 1 ) );
+    __m128 mag     = _mm_sqrt_ps( _mm_add_ps( sq, swapped ) );
+    __m128 unit    = _mm_div_ps( p, mag );
+    _mm_storeu_ps( &out[i].x, _mm_and_ps( _mm_cmpgt_ps( mag, zero ), unit ) );
+  }
+#elif defined( STDS_SIMD_NEON ) && defined( __aarch64__ )
+  const float32x4_t zero = vdupq_n_f32( 0 );
+  for ( ; i + 2 <= n; i += 2 ) {
+    float32x4_t p    = vld1q_f32( &v[i].x );
+    float32x4_t sq   = vmulq_f32( p, p );
+    float32x4_t mag  = vsqrtq_f32( vaddq_f32( sq, vrev64q_f32( sq ) ) );
+    uint32x4_t  keep = vcgtq_f32( mag, zero );
+    uint32x4_t  unit = vreinterpretq_u32_f32( vdivq_f32( p, mag ) );
+    vst1q_f32( &out[i].x, vreinterpretq_f32_u32( vandq_u32( unit, keep ) ) );
+  }
+#endif
+
+  for ( ; i < n; i++ ) {
+    float mag = sqrtf( v[i].x * v[i].x + v[i].y * v[i].y );
+
+    if ( mag > 0 ) {
+      out[i].x = v[i].x / mag;
+      out[i].y = v[i].y / mag;
+    } else {
+      out[i].x = 0;
+      out[i].y = 0;
+    }
+  }
+}
+
+/**
+ * Computes the dot product of each pair of vectors: out[i] = u[i] . v[i].
+ *
+ * @param float * array of n floats that receives the dot products.
+ * @param vec2_t * first array.
+ * @param vec2_t * second array.
+ * @param int32_t number of vectors.
+ *
+ * @return void.
+ */
+void
+Stds_DotVec2Array( float *out, const struct vec2_t *u, const struct vec2_t *v, const int32_t n ) {
+  int32_t i = 0;
+
+#if defined( STDS_SIMD_SSE2 )
+  for ( ; i + 4 <= n; i += 4 ) {
+    __m128 lo = _mm_mul_ps( _mm_loadu_ps( &u[i].x ), _mm_loadu_ps( &v[i].x ) );
+    __m128 hi = _mm_mul_ps( _mm_loadu_ps( &u[i + 2].x ), _mm_loadu_ps( &v[i + 2].x ) );
+    __m128 xs = _mm_shuffle_ps( lo, hi, _MM_SHUFFLE( 2, 0, 2, 0 ) );
+    __m128 ys = _mm_shuffle_ps( lo, hi, _MM_SHUFFLE( 3, 1, 3, 1 ) );
+    _mm_storeu_ps( &out[i], _mm_add_ps( xs, ys ) );
+  }
+#elif defined( STDS_SIMD_NEON )
+  for ( ; i + 4 <= n; i += 4 ) {
+    float32x4_t   lo = vmulq_f32( vld1q_f32( &u[i].x ), vld1q_f32( &v[i].x ) );
+    float32x4_t   hi = vmulq_f32( vld1q_f32( &u[i + 2].x ), vld1q_f32( &v[i + 2].x ) );
+    float32x4x2_t xy = vuzpq_f32( lo, hi );
+    vst1q_f32( &out[i], vaddq_f32( xy.val[0], xy.val[1] ) );
+  }
+#endif
+
+  for ( ; i < n; i++ ) {
+    out[i] = u[i].x * v[i].x + u[i].y * v[i].y;
+  }
+}
+
+/**
+ * Applies a 2x3 affine matrix to every vector of an array. out may be the
+ * same array as v.
+ *
+ * @param vec2_t * array that receives the transformed vectors.
+ * @param vec2_t * array to transform.
+ * @param transform_t * pointer to the matrix.
+ * @param int32_t number of vectors.
+ *
+ * @return void.
+ */
+void
+Stds_TransformVec2Array( struct vec2_t *out, const struct vec2_t *v, const struct transform_t *m,
+                         const int32_t n ) {
+  int32_t i = 0;
+
+  /* With p = ( x0, y0, x1, y1 ) and its pairwise swap q = ( y0, x0, y1, x1 ),
+     the result is p * ( a, d, a, d ) + q * ( c, b, c, b ) + ( tx, ty, tx, ty ). */
+#if defined( STDS_SIMD_SSE2 )
+  const __m128 ad = _mm_setr_ps( m->a, m->d, m->a, m->d );
+  const __m128 cb = _mm_setr_ps( m->c, m->b, m->c, m->b );
+  const __m128 t  = _mm_setr_ps( m->tx, m->ty, m->tx, m->ty );
+  for ( ; i + 2 <= n; i += 2 ) {
+    __m128 p = _mm_loadu_ps( &v[i].x );
+    __m128 q = _mm_shuffle_ps( p, p, _MM_SHUFFLE( 2, 3, 0, 1 ) );
+    __m128 r = _mm_add_ps( _mm_mul_ps( p, ad ), _mm_mul_ps( q, cb ) );
+    _mm_storeu_ps( &out[i].x, _mm_add_ps( r, t ) );
+  }
+#elif defined( STDS_SIMD_NEON )
+  const float       lanes[3][4] = { { m->a, m->d, m->a, m->d },
+                                    { m->c, m->b, m->c, m->b },
+                                    { m->tx, m->ty, m->tx, m->ty } };
+  const float32x4_t ad          = vld1q_f32( lanes[0] );
+  const float32x4_t cb          = vld1q_f32( lanes[1] );
+  const float32x4_t t           = vld1q_f32( lanes[2] );
+  for ( ; i + 2 <= n; i += 2 ) {
+    float32x4_t p = vld1q_f32( &v[i].x );
+    float32x4_t q = vrev64q_f32( p );
+    vst1q_f32( &out[i].x, vaddq_f32( vaddq_f32( vmulq_f32( p, ad ), vmulq_f32( q, cb ) ), t ) );
+  }
+#endif
+
+  for ( ; i < n; i++ ) {
+    const float x = v[i].x;
+    const float y = v[i].y;
+
+    out[i].x = m->a * x + m->c * y + m->tx;
+    out[i].y = m->b * x + m->d * y + m->ty;
+  }
+}
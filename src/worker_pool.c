@@ -0,0 +1,234 @@
+/**
+ * @file worker_pool.c
+ * @author Joshua Crotts
+ * @date October 14 2026
+ * @version 1.0
+ *
+ * @section LICENSE
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License as
+ * published by the Free Software Foundation; either version 2 of
+ * the License, or (at your option) any later version.
+ *
+ * @section DESCRIPTION
+ *
+ * This file defines a small pool of SDL worker threads. A batch is a job
+ * function plus a number of indices; threads claim indices with an atomic
+ * counter so uneven jobs balance themselves out.
+ */
+#include "../include/worker_pool.h"
+
+static int32_t Stds_WorkerThread( void *data );
+static int32_t Stds_WorkerDrain( struct worker_pool_t *pool, void ( *job )( void *, int32_t ),
+                                 void *data, const int32_t job_count );
+
+/**
+ * Creates a worker pool with thread_count threads. Passing 0 or a negative
+ * number uses one thread per CPU core minus one, since the calling thread
+ * also works on every batch.
+ *
+ * @param int32_t number of threads to spawn.
+ *
+ * @return worker_pool_t * pointer to pool.
+ */
+struct worker_pool_t *
+Stds_CreateWorkerPool( int32_t thread_count ) {
+  struct worker_pool_t *pool;
+  pool = malloc( sizeof( struct worker_pool_t ) );
+
+  if ( pool == NULL ) {
+    SDL_LogInfo( SDL_LOG_CATEGORY_APPLICATION, "Could not allocate memory for worker_pool_t. %s.\n",
+                 SDL_GetError() );
+    exit( EXIT_FAILURE );
+  }
+
+  memset( pool, 0, sizeof( struct worker_pool_t ) );
+
+  if ( thread_count <= 0 ) {
+    thread_count = SDL_GetCPUCount() - 1;
+  }
+
+  pool->lock       = SDL_CreateMutex();
+  pool->work_cond  = SDL_CreateCond();
+  pool->done_cond  = SDL_CreateCond();
+  pool->is_running = true;
+
+  if ( thread_count > 0 ) {
+    pool->threads = malloc( sizeof( SDL_Thread * ) * ( size_t ) thread_count );
+
+    if ( pool->threads == NULL ) {
+      SDL_LogInfo( SDL_LOG_CATEGORY_APPLICATION, "Could not allocate memory for worker threads. %s.\n",
+                   SDL_GetError() );
+      exit( EXIT_FAILURE );
+    }
+
+    for ( int32_t i = 0; i < thread_count; i++ ) {
+      pool->threads[i] = SDL_CreateThread( Stds_WorkerThread, "stds_worker", pool );
+
+      if ( pool->threads[i] == NULL ) {
+        SDL_LogInfo( SDL_LOG_CATEGORY_APPLICATION, "Could not create worker thread. %s.\n",
+                     SDL_GetError() );
+        break;
+      }
+
+      pool->thread_count++;
+    }
+  }
+
+  return pool;
+}
+
+/**
+ * Runs job( data, i ) for every i in [0, job_count) across the pool and the
+ * calling thread, and blocks until all of them have returned. Jobs must not
+ * touch the renderer, since SDL rendering is only safe on the main thread.
+ *
+ * @param worker_pool_t * pointer to pool.
+ * @param void (*)(void *, int32_t) job function.
+ * @param void * data passed to every job.
+ * @param int32_t number of jobs.
+ *
+ * @return void.
+ */
+void
+Stds_WorkerPoolRun( struct worker_pool_t *pool, void ( *job )( void *, int32_t ), void *data,
+                    const int32_t job_count ) {
+  if ( job_count <= 0 ) {
+    return;
+  }
+
+  /* Nothing to hand off; skip the locking entirely. */
+  if ( pool == NULL || pool->thread_count == 0 || job_count == 1 ) {
+    for ( int32_t i = 0; i < job_count; i++ ) {
+      job( data, i );
+    }
+    return;
+  }
+
+  SDL_LockMutex( pool->lock );
+
+  /* A worker woken by the last batch may have taken the lock only after that
+     batch finished, and still holds its job. It finds the old counter spent
+     and leaves; resetting next_job before then would hand it this batch's
+     indices to run with the stale job. */
+  while ( pool->active_workers > 0 ) {
+    SDL_CondWait( pool->done_cond, pool->lock );
+  }
+
+  pool->job          = job;
+  pool->job_data     = data;
+  pool->job_count    = job_count;
+  pool->pending_jobs = job_count;
+  SDL_AtomicSet( &pool->next_job, 0 );
+  pool->generation++;
+  SDL_CondBroadcast( pool->work_cond );
+  SDL_UnlockMutex( pool->lock );
+
+  int32_t completed = Stds_WorkerDrain( pool, job, data, job_count );
+
+  /* Wait for the remaining jobs, and for every worker to leave the batch. */
+  SDL_LockMutex( pool->lock );
+  pool->pending_jobs -= completed;
+  while ( pool->pending_jobs > 0 || pool->active_workers > 0 ) {
+    SDL_CondWait( pool->done_cond, pool->lock );
+  }
+  SDL_UnlockMutex( pool->lock );
+}
+
+/**
+ * Stops and joins every worker thread, then frees the pool.
+ *
+ * @param worker_pool_t * pointer to pool.
+ *
+ * @return void.
+ */
+void
+Stds_WorkerPoolDie( struct worker_pool_t *pool ) {
+  if ( pool == NULL ) {
+    return;
+  }
+
+  SDL_LockMutex( pool->lock );
+  pool->is_running = false;
+  SDL_CondBroadcast( pool->work_cond );
+  SDL_UnlockMutex( pool->lock );
+
+  for ( int32_t i = 0; i < pool->thread_count; i++ ) {
+    SDL_WaitThread( pool->threads[i], NULL );
+  }
+
+  SDL_DestroyCond( pool->work_cond );
+  SDL_DestroyCond( pool->done_cond );
+  SDL_DestroyMutex( pool->lock );
+  free( pool->threads );
+  free( pool );
+}
+
+/**
+ * Body of every worker thread: sleeps until a new batch is published, works
+ * on it, and reports back how many jobs it finished.
+ *
+ * @param void * pointer to the owning worker_pool_t.
+ *
+ * @return int32_t 0.
+ */
+static int32_t
+Stds_WorkerThread( void *data ) {
+  struct worker_pool_t *pool = data;
+  uint32_t              seen = 0;
+
+  SDL_LockMutex( pool->lock );
+  while ( true ) {
+    while ( pool->is_running && seen == pool->generation ) {
+      SDL_CondWait( pool->work_cond, pool->lock );
+    }
+
+    if ( !pool->is_running ) {
+      break;
+    }
+
+    void ( *job )( void *, int32_t ) = pool->job;
+    void *  job_data                 = pool->job_data;
+    int32_t job_count                = pool->job_count;
+    seen                             = pool->generation;
+    pool->active_workers++;
+    SDL_UnlockMutex( pool->lock );
+
+    int32_t completed = Stds_WorkerDrain( pool, job, job_data, job_count );
+
+    SDL_LockMutex( pool->lock );
+    pool->pending_jobs -= completed;
+    pool->active_workers--;
+    if ( pool->pending_jobs == 0 && pool->active_workers == 0 ) {
+      SDL_CondSignal( pool->done_cond );
+    }
+  }
+  SDL_UnlockMutex( pool->lock );
+
+  return 0;
+}
+
+/**
+ * Claims and runs jobs from the current batch until none are left.
+ *
+ * @param worker_pool_t * pointer to pool.
+ * @param void (*)(void *, int32_t) job function.
+ * @param void * data passed to every job.
+ * @param int32_t number of jobs in the batch.
+ *
+ * @return int32_t number of jobs this thread ran.
+ */
+static int32_t
+Stds_WorkerDrain( struct worker_pool_t *pool, void ( *job )( void *, int32_t ), void *data,
+                  const int32_t job_count ) {
+  int32_t completed = 0;
+  int32_t i;
+
+  while ( ( i = SDL_AtomicAdd( &pool->next_job, 1 ) ) < job_count ) {
+    job( data, i );
+    completed++;
+  }
+
+  return completed;
+}
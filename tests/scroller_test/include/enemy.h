@@ -3,15 +3,15 @@
 
 #include "../../../include/stds.h"
 #include "../../../include/draw.h"
+#include "../../../include/entity.h"
 #include "../../../include/trail.h"
 
-extern struct entity_t*
-add_enemy( float x, float y );
+#include "game_structs.h"
 
-extern void
-enemy_update( struct entity_t *e );
+extern uint32_t
+add_enemy( struct entity_registry_t *reg, uint32_t type, float x, float y );
 
 extern void
-enemy_draw( struct entity_t *e );
+enemy_draw_batch( struct entity_registry_t *reg, uint32_t first, uint32_t count );
 
 #endif // ENEMY_H
\ No newline at end of file
@@ -3,8 +3,14 @@
 
 #include "../../../include/stds.h"
 
+/* Cold data of an enemy in stage.enemies. */
+struct enemy_t {
+    SDL_Texture *texture;
+};
+
 struct stage_t {
-    struct entity_t enemy_head, *enemy_tail;
+    struct entity_registry_t *enemies;
+    uint32_t                  grass_type;
 };
 
 #endif // GAME_STRUCTS_H
@@ -3,32 +3,34 @@
 /**
  *
  */
-struct entity_t *
-add_enemy( float x, float y ) {
-  struct entity_t *e;
+uint32_t
+add_enemy( struct entity_registry_t *reg, uint32_t type, float x, float y ) {
+  uint32_t        id = Stds_CreateEntityOfType( reg, type );
+  int32_t         i  = Stds_GetEntityIndex( reg, id );
+  struct enemy_t *e  = Stds_GetEntityColdData( reg, id );
+  int32_t         w, h;
 
-  e = malloc( sizeof( struct entity_t ) );
-  memset( e, 0, sizeof( struct entity_t ) );
+  e->texture = Stds_LoadTexture( "tests/scroller_test/res/img/grass.png" );
+  SDL_QueryTexture( e->texture, NULL, NULL, &w, &h );
 
-  e->pos.x      = x;
-  e->pos.y      = y;
-  e->texture[0] = Stds_LoadTexture( "tests/scroller_test/res/img/grass.png" );
-  SDL_QueryTexture( e->texture[0], NULL, NULL, &e->w, &e->h );
+  reg->transforms[i].pos.x = x;
+  reg->transforms[i].pos.y = y;
+  reg->bounds[i].w         = ( float ) w;
+  reg->bounds[i].h         = ( float ) h;
 
-  return e;
+  return id;
 }
 
 /**
  *
  */
 void
-enemy_update( struct entity_t *e ) {}
+enemy_draw_batch( struct entity_registry_t *reg, uint32_t first, uint32_t count ) {
+  const struct enemy_t *e = ( const struct enemy_t * ) ( reg->cold + first * reg->cold_size );
 
-/**
- *
- */
-void
-enemy_draw( struct entity_t *e ) {
-  Stds_DrawTexture( e->texture[0], e->pos.x, e->pos.y, e->w, e->h, e->angle, SDL_FLIP_NONE, NULL,
-                    true );
+  for ( uint32_t i = first; i < first + count; i++, e++ ) {
+    const struct entity_transform_t *t = &reg->transforms[i];
+    Stds_DrawTexture( e->texture, t->pos.x, t->pos.y, reg->bounds[i].w, reg->bounds[i].h,
+                      ( uint16_t ) t->angle, SDL_FLIP_NONE, NULL, true );
+  }
 }
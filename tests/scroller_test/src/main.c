@@ -31,13 +31,11 @@ static void update( void );
 static void check_enemy_collision( void );
 static void add_particles( int32_t, int32_t, size_t );
 
-static void update_trails( void );
 static void update_enemies( void );
 static void update_parallax_backgrounds( void );
 static void update_grid( void );
 static void update_polygons( void );
 
-static void draw_trails( void );
 static void draw_enemies( void );
 static void draw_parallax_backgrounds( void );
 static void draw_grid( void );
@@ -79,17 +77,14 @@ init_scene( void ) {
 
   g_app.delegate.update = update;
   g_app.delegate.draw   = draw;
-  stage.enemy_tail      = &stage.enemy_head;
+  stage.enemies         = Stds_CreateEntityRegistry( 32, sizeof( struct enemy_t ) );
+  stage.grass_type      = Stds_RegisterEntityType( stage.enemies, NULL, enemy_draw_batch );
 
   init_player();
 
   /* Create the green grass tiles for collision testing. */
   for ( uint32_t i = 0, x = 0; i < 30; i++, x += 48 ) {
-    struct entity_t *e;
-    e = add_enemy( x, g_app.LEVEL_HEIGHT - 20 );
-
-    stage.enemy_tail->next = e;
-    stage.enemy_tail       = e;
+    add_enemy( stage.enemies, stage.grass_type, x, g_app.LEVEL_HEIGHT - 20 );
   }
 
   /* Initialize the parallax background with each frame's scroll factor. */
@@ -99,6 +94,7 @@ init_scene( void ) {
                                0.40f, 0.45f, 0.50f, 0.55f, 0.60f};
   Stds_AddParallaxBackground( "tests/scroller_test/res/img/background_4/layer_0", parallax_frames, 1.0f,
                               parallax_scroll, false );
+  Stds_CompositeParallaxBackgrounds();
 
   /* Create the border fade from blue to yellow. */
   SDL_Color c1 = {0xff, 0xff, 0, 0xff};
@@ -145,7 +141,7 @@ init_scene( void ) {
   /* Init text field for testing. */
   SDL_Color c = {0xff, 0, 0, 0xff};
   tf          = Stds_CreateTextFieldBlank( 300.f, 300.f, "tests/scroller_test/res/fonts/nes.ttf", 16, &c );
-  tf->toggle_text_input = true;
+  Stds_ToggleTextField( tf, true );
 
   g_app.text_field_tail->next = tf;
   g_app.text_field_tail = tf;
@@ -163,7 +159,6 @@ update( void ) {
   Stds_CameraUpdate( player );
   Stds_ParticleSystemUpdate( ps );
   update_parallax_backgrounds();
-  update_trails();
   update_enemies();
   player_update();
   update_grid();
@@ -171,32 +166,6 @@ update( void ) {
   update_polygons();
 }
 
-/**
- *
- */
-static void
-update_trails( void ) {
-  struct trail_t *t;
-  struct trail_t *prev;
-
-  prev = &g_app.trail_head;
-
-  for ( t = g_app.trail_head.next; t != NULL; t = t->next ) {
-    Stds_TrailUpdate( t );
-
-    if ( t->flags & STDS_DEATH_MASK ) {
-      if ( t == g_app.trail_tail ) {
-        g_app.trail_tail = prev;
-      }
-
-      prev->next = t->next;
-      free( t );
-      t = prev;
-    }
-    prev = t;
-  }
-}
-
 /**
  *
  */
@@ -213,9 +182,9 @@ update_parallax_backgrounds( void ) {
  */
 static void
 update_enemies( void ) {
-  struct entity_t *e;
-  for ( e = stage.enemy_head.next; e != NULL; e = e->next ) {
-    enum CollisionSide s = Stds_CheckAABBCollision( player, e );
+  for ( uint32_t i = 0; i < stage.enemies->count; i++ ) {
+    SDL_FRect          r = Stds_GetEntityWorldBounds( stage.enemies, i );
+    enum CollisionSide s = Stds_CheckAABBCollisionRect( player, &r );
 
     if ( s == SIDE_TOP || s == SIDE_BOTTOM ) {
       player->velocity.y = 0;
@@ -236,7 +205,6 @@ draw( void ) {
   draw_parallax_backgrounds();
   Stds_ParticleSystemDraw( ps );
   Stds_DrawRectStroke( 0, 0, g_app.SCREEN_WIDTH, g_app.SCREEN_HEIGHT, 8, &c, 0xff );
-  draw_trails();
   draw_enemies();
   player_draw();
   draw_grid();
@@ -247,17 +215,6 @@ draw( void ) {
   Stds_DrawTextField( tf );
 }
 
-/**
- *
- */
-static void
-draw_trails( void ) {
-  struct trail_t *t;
-  for ( t = g_app.trail_head.next; t != NULL; t = t->next ) {
-    Stds_TrailDraw( t );
-  }
-}
-
 /**
  *
  */
@@ -274,10 +231,7 @@ draw_parallax_backgrounds( void ) {
  */
 static void
 draw_enemies( void ) {
-  struct entity_t *e;
-  for ( e = stage.enemy_head.next; e != NULL; e = e->next ) {
-    enemy_draw( e );
-  }
+  Stds_DrawEntityTypes( stage.enemies );
 }
 
 /**
@@ -292,6 +246,7 @@ static void
 cleanup_stage( void ) {
   SDL_LogDebug( SDL_LOG_CATEGORY_APPLICATION, "Freeing player and grid components.\n" );
   free( player );
+  Stds_EntityRegistryDie( stage.enemies );
   Stds_FreeGrid( grid );
   Stds_AnimationDie( fire_animation );
   Stds_CleanUpPolygon( hexa );
@@ -1,6 +1,7 @@
 #include "../include/player.h"
 
 #define ALPHA_DECAY_RATE 20
+#define TRAIL_CAPACITY   16
 #define DECELERATION     0.95f
 #define JUMP_VEL         -8.0f
 #define VELOCITY         5.0f
@@ -15,6 +16,7 @@ static bool                is_moving    = false;
 static bool                is_attacking = false;
 static struct animation_t *walk_animation;
 static struct animation_t *idle_animation;
+static struct trail_emitter_t *trail;
 
 static void key_input_listener( void );
 static void check_animations( void );
@@ -44,6 +46,9 @@ init_player() {
   idle_animation->is_camera_offset_enabled = true;
 
   player->animation                           = idle_animation;
+
+  trail = Stds_CreateTrailEmitter( TRAIL_CAPACITY, ALPHA_DECAY_RATE,
+                                   STDS_TRAIL_TRANSPARENT_TEXTURE_MASK, NULL );
 }
 
 /**
@@ -64,7 +69,8 @@ player_update( void ) {
   check_bounds();
   check_animations();
   Stds_AnimationUpdate( player->animation );
-  Stds_AddTextureTrail( player, ALPHA_DECAY_RATE, player->animation->flip, true );
+  Stds_UpdateTrailEmitter( trail );
+  Stds_EmitEntityTrail( trail, player, player->animation->flip );
 }
 
 /**
@@ -72,6 +78,7 @@ player_update( void ) {
  */
 void
 player_draw( void ) {
+  Stds_DrawTrailEmitter( trail );
   Stds_AnimationDraw( player->animation );
 }
 
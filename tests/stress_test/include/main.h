@@ -0,0 +1,42 @@
+#ifndef MAIN_H
+#define MAIN_H
+
+#include "../../../include/aabb_tree.h"
+#include "../../../include/camera.h"
+#include "../../../include/collision.h"
+#include "../../../include/draw.h"
+#include "../../../include/game.h"
+#include "../../../include/grid.h"
+#include "../../../include/init.h"
+#include "../../../include/particle_system.h"
+#include "../../../include/polygon.h"
+#include "../../../include/profiler.h"
+#include "../../../include/stds.h"
+#include "../../../include/text.h"
+#include "../../../include/trail.h"
+
+/*
+ * One stress-scene entity: a box bouncing around the level, tracked in the
+ * AABB tree. Every fourth one also carries a hexagon tested with SAT.
+ */
+struct stress_entity_t {
+  SDL_FRect         rect;
+  struct vec2_t     velocity;
+  int32_t           proxy;
+  struct polygon_t *polygon;
+};
+
+/*
+ * Size of the stress scene, read from the command line.
+ */
+struct stress_config_t {
+  int32_t entities;
+  int32_t emitters;
+  int32_t trails;
+  int32_t grid_size;
+  int32_t texts;
+  int32_t frames;
+  bool    is_windowed;
+};
+
+#endif // MAIN_H
@@ -0,0 +1,517 @@
+/**
+ * @file main.c
+ * @author Joshua Crotts
+ * @date October 14 2026
+ * @version 1.0
+ *
+ * @section LICENSE
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License as
+ * published by the Free Software Foundation; either version 2 of
+ * the License, or (at your option) any later version.
+ *
+ * @section DESCRIPTION
+ *
+ * This file is a parameterized stress scene for finding the scaling limits of each
+ * subsystem. Built with make stress and run from the repository root:
+ *
+ *   ./stress --entities 2000 --emitters 50 --trails 100 --grid 256 --texts 64
+ *            --frames 600 [--windowed]
+ *
+ * Entities bounce around the level through an AABB tree, with every fourth one
+ * also a hexagon tested with SAT; emitters spray particles into one system; trail
+ * sources circle the screen; a grid of size by size tiles scrolls under the camera;
+ * and text strings are re-laid out every frame. Each subsystem's update and draw are
+ * timed with the profiler, and once the frames have run, a table of min, average and
+ * 99th percentile milliseconds over the last STDS_PROFILER_FRAMES frames is printed.
+ * The scene runs headless unless --windowed is passed.
+ */
+#include "../include/main.h"
+
+#define S_WIDTH              1280
+#define S_HEIGHT             720
+#define STRESS_ENTITY_SIZE   16.0f
+#define STRESS_EMIT_RATE     8  /* Particles per emitter per frame. */
+#define STRESS_PARTICLE_LIFE 60 /* Frames a particle lives. */
+#define STRESS_TRAIL_DECAY   10
+#define STRESS_CELL_SIZE     32
+#define STRESS_FONT          "tests/scroller_test/res/fonts/nes.ttf"
+#define STRESS_TILESET       "tests/scroller_test/res/img/Tilemap.png"
+#define STRESS_TILESET_CELLS 10 /* Columns and rows of the tileset. */
+
+static const char *scope_names[] = { "entities",      "collision",   "particles",
+                                     "trails",        "text",        "draw_entities",
+                                     "draw_particles", "draw_trails", "draw_grid",
+                                     "draw_text",     "submit",      "frame" };
+
+static struct stress_config_t    config = { 1000, 20, 50, 128, 32, 600, false };
+static struct stress_entity_t *  entities;
+static struct aabb_tree_t *      tree;
+static struct particle_system_t *particles;
+static struct trail_emitter_t ** trails;
+static struct grid_t *           grid;
+static struct text_t **          texts;
+static int32_t                   frame;
+static int64_t                   contacts;
+
+static bool parse_arguments( int argc, char *argv[] );
+static void init_scene( void );
+static void cleanup_scene( void );
+static void update( void );
+static void draw( void );
+static void update_entities( void );
+static void update_collisions( void );
+static void update_particles( void );
+static void update_trails( void );
+static void update_text( void );
+static bool count_contact( int32_t proxy, void *data, void *user );
+static void print_report( const double seconds );
+
+/**
+ * Runs the stress scene for the requested number of frames and prints the
+ * timings of every subsystem.
+ *
+ * @param int number of cmd arguments.
+ * @param char *[] array of string arguments.
+ *
+ * @return status code.
+ */
+int
+main( int argc, char *argv[] ) {
+  if ( !parse_arguments( argc, argv ) ) {
+    return EXIT_FAILURE;
+  }
+
+  const uint32_t level_w = ( uint32_t ) ( config.grid_size * STRESS_CELL_SIZE );
+  const uint32_t level_h = level_w;
+
+  if ( config.is_windowed ) {
+    Stds_InitGame( "Stress Test", S_WIDTH, S_HEIGHT, level_w > S_WIDTH ? level_w : S_WIDTH,
+                   level_h > S_HEIGHT ? level_h : S_HEIGHT );
+  } else {
+    Stds_InitGameHeadless( S_WIDTH, S_HEIGHT, level_w > S_WIDTH ? level_w : S_WIDTH,
+                           level_h > S_HEIGHT ? level_h : S_HEIGHT );
+  }
+
+  Stds_InitAppStructures();
+  init_scene();
+
+  const uint64_t start = SDL_GetPerformanceCounter();
+  Stds_GameLoop();
+  const uint64_t end = SDL_GetPerformanceCounter();
+
+  print_report( ( double ) ( end - start ) / ( double ) SDL_GetPerformanceFrequency() );
+  cleanup_scene();
+
+  return EXIT_SUCCESS;
+}
+
+/**
+ * Reads the scene size from the command line. Every option takes a
+ * non-negative count, except --windowed.
+ *
+ * @param int number of cmd arguments.
+ * @param char *[] array of string arguments.
+ *
+ * @return bool false, after printing the usage, if an argument is invalid.
+ */
+static bool
+parse_arguments( int argc, char *argv[] ) {
+  const char *names[]  = { "--entities", "--emitters", "--trails",
+                           "--grid",     "--texts",    "--frames" };
+  int32_t *   values[] = { &config.entities,  &config.emitters, &config.trails,
+                           &config.grid_size, &config.texts,    &config.frames };
+
+  for ( int32_t i = 1; i < argc; i++ ) {
+    if ( strcmp( argv[i], "--windowed" ) == 0 ) {
+      config.is_windowed = true;
+      continue;
+    }
+
+    bool is_known = false;
+    for ( int32_t k = 0; k < 6 && !is_known; k++ ) {
+      if ( strcmp( argv[i], names[k] ) == 0 && i + 1 < argc ) {
+        char *     end;
+        const long n = strtol( argv[++i], &end, 10 );
+
+        is_known   = *end == '\0' && n >= 0 && n <= INT32_MAX;
+        *values[k] = ( int32_t ) n;
+      }
+    }
+
+    if ( !is_known ) {
+      fprintf( stderr,
+               "usage: %s [--entities N] [--emitters N] [--trails N] [--grid N] [--texts N]\n"
+               "          [--frames N] [--windowed]\n",
+               argv[0] );
+      return false;
+    }
+  }
+
+  config.grid_size = config.grid_size > 0 ? config.grid_size : 1;
+  config.frames    = config.frames > 0 ? config.frames : 1;
+  return true;
+}
+
+/**
+ * Builds every subsystem of the scene at its configured size.
+ *
+ * @param void.
+ *
+ * @return void.
+ */
+static void
+init_scene( void ) {
+  g_app.delegate.update = update;
+  g_app.delegate.draw   = draw;
+
+  tree     = Stds_CreateAABBTree( STRESS_ENTITY_SIZE / 4 );
+  entities = calloc( ( size_t ) config.entities + 1, sizeof( struct stress_entity_t ) );
+
+  for ( int32_t i = 0; i < config.entities; i++ ) {
+    struct stress_entity_t *e = &entities[i];
+
+    e->rect     = ( SDL_FRect ){ Stds_RandomFloat( 0, ( float ) g_app.LEVEL_WIDTH ),
+                             Stds_RandomFloat( 0, ( float ) g_app.LEVEL_HEIGHT ),
+                             STRESS_ENTITY_SIZE, STRESS_ENTITY_SIZE };
+    e->velocity = Stds_CreateVec2( Stds_RandomFloat( -3, 3 ), Stds_RandomFloat( -3, 3 ) );
+    e->proxy    = Stds_AABBTreeInsert( tree, &e->rect, e );
+
+    if ( i % 4 == 0 ) {
+      struct vec2_t center = Stds_CreateVec2( e->rect.x + STRESS_ENTITY_SIZE / 2,
+                                              e->rect.y + STRESS_ENTITY_SIZE / 2 );
+      e->polygon = Stds_CreatePolygon( 6, STRESS_ENTITY_SIZE / 2, center,
+                                       ( float ) Stds_RandomInt( 0, 359 ) );
+    }
+  }
+
+  const int32_t emitted = config.emitters * STRESS_EMIT_RATE * ( STRESS_PARTICLE_LIFE + 1 );
+  particles             = Stds_CreateParticleSystemSoA( emitted > 0 ? emitted : 1 );
+
+  SDL_Color trail_color = { 0x40, 0xa0, 0xff, 0xff };
+  trails = calloc( ( size_t ) config.trails + 1, sizeof( struct trail_emitter_t * ) );
+  for ( int32_t i = 0; i < config.trails; i++ ) {
+    trails[i] = Stds_CreateTrailEmitter( 255 / STRESS_TRAIL_DECAY + 1, STRESS_TRAIL_DECAY,
+                                         STDS_TRAIL_SQUARE_MASK, &trail_color );
+  }
+
+  SDL_Color line_color = { 0xff, 0xff, 0xff, 0xff };
+  grid = Stds_CreateGrid( 0, 0, STRESS_CELL_SIZE, STRESS_CELL_SIZE, ( uint32_t ) config.grid_size,
+                          ( uint32_t ) config.grid_size, &line_color, &line_color );
+  Stds_AddSpriteSheetToGrid( grid, STRESS_TILESET, STRESS_TILESET_CELLS, STRESS_TILESET_CELLS );
+
+  for ( int32_t row = 0; row < config.grid_size; row++ ) {
+    for ( int32_t col = 0; col < config.grid_size; col++ ) {
+      const int32_t tile = Stds_RandomInt( 0, STRESS_TILESET_CELLS * STRESS_TILESET_CELLS );
+      Stds_SetGridTileIndex( grid, ( uint32_t ) col, ( uint32_t ) row, ( uint16_t ) tile );
+    }
+  }
+
+  Stds_AddFont( STRESS_FONT, 16 );
+  SDL_Color text_color = { 0xff, 0xff, 0xff, 0xff };
+  texts = calloc( ( size_t ) config.texts + 1, sizeof( struct text_t * ) );
+  for ( int32_t i = 0; i < config.texts; i++ ) {
+    texts[i] = Stds_TextCreate( STRESS_FONT, 16, &text_color, "" );
+  }
+}
+
+/**
+ * Frees everything init_scene created.
+ *
+ * @param void.
+ *
+ * @return void.
+ */
+static void
+cleanup_scene( void ) {
+  for ( int32_t i = 0; i < config.entities; i++ ) {
+    if ( entities[i].polygon != NULL ) {
+      Stds_CleanUpPolygon( entities[i].polygon );
+    }
+  }
+
+  for ( int32_t i = 0; i < config.trails; i++ ) {
+    Stds_TrailEmitterDie( trails[i] );
+  }
+
+  for ( int32_t i = 0; i < config.texts; i++ ) {
+    Stds_TextDie( texts[i] );
+  }
+
+  Stds_AABBTreeDie( tree );
+  Stds_ParticleSystemDie( particles );
+  Stds_FreeGrid( grid );
+  free( entities );
+  free( trails );
+  free( texts );
+}
+
+/**
+ * Updates every subsystem under its own profiler scope, and stops the game
+ * loop once the configured number of frames has run.
+ *
+ * @param void.
+ *
+ * @return void.
+ */
+static void
+update( void ) {
+  STDS_PROFILE_BEGIN( entities );
+  update_entities();
+  STDS_PROFILE_END( entities );
+
+  STDS_PROFILE_BEGIN( collision );
+  update_collisions();
+  STDS_PROFILE_END( collision );
+
+  STDS_PROFILE_BEGIN( particles );
+  update_particles();
+  STDS_PROFILE_END( particles );
+
+  STDS_PROFILE_BEGIN( trails );
+  update_trails();
+  STDS_PROFILE_END( trails );
+
+  STDS_PROFILE_BEGIN( text );
+  update_text();
+  STDS_PROFILE_END( text );
+
+  /* Pan the camera diagonally across the level so grid culling moves. */
+  const float span_x = ( float ) g_app.LEVEL_WIDTH - S_WIDTH;
+  const float span_y = ( float ) g_app.LEVEL_HEIGHT - S_HEIGHT;
+  g_app.camera.x     = span_x > 0 ? fmodf( ( float ) frame * 2.0f, span_x ) : 0;
+  g_app.camera.y     = span_y > 0 ? fmodf( ( float ) frame * 2.0f, span_y ) : 0;
+
+  if ( ++frame >= config.frames ) {
+    g_app.is_running = false;
+  }
+}
+
+/**
+ * Draws every subsystem under its own profiler scope.
+ *
+ * @param void.
+ *
+ * @return void.
+ */
+static void
+draw( void ) {
+  STDS_PROFILE_BEGIN( draw_grid );
+  Stds_DrawGridTiles( grid );
+  STDS_PROFILE_END( draw_grid );
+
+  STDS_PROFILE_BEGIN( draw_entities );
+  SDL_FRect *rects = Stds_FrameAlloc( sizeof( SDL_FRect ) * ( size_t ) ( config.entities + 1 ) );
+  int32_t    count = 0;
+  for ( int32_t i = 0; i < config.entities; i++ ) {
+    if ( Stds_IsRectVisible( &entities[i].rect, true ) ) {
+      rects[count]   = entities[i].rect;
+      rects[count].x = rects[count].x - g_app.camera.x;
+      rects[count].y = rects[count].y - g_app.camera.y;
+      count++;
+    }
+  }
+
+  SDL_Color entity_color = { 0xff, 0x60, 0x40, 0xff };
+  Stds_DrawRects( rects, count, &entity_color, true, false );
+  STDS_PROFILE_END( draw_entities );
+
+  STDS_PROFILE_BEGIN( draw_particles );
+  Stds_ParticleSystemDraw( particles );
+  STDS_PROFILE_END( draw_particles );
+
+  STDS_PROFILE_BEGIN( draw_trails );
+  for ( int32_t i = 0; i < config.trails; i++ ) {
+    Stds_DrawTrailEmitter( trails[i] );
+  }
+  STDS_PROFILE_END( draw_trails );
+
+  STDS_PROFILE_BEGIN( draw_text );
+  for ( int32_t i = 0; i < config.texts; i++ ) {
+    Stds_TextDraw( texts[i], ( float ) ( i % 4 ) * 320.0f, ( float ) ( i / 4 % 40 ) * 18.0f );
+  }
+  STDS_PROFILE_END( draw_text );
+}
+
+/**
+ * Moves the entities, bouncing them off the level edges, and moves their
+ * proxies in the AABB tree.
+ *
+ * @param void.
+ *
+ * @return void.
+ */
+static void
+update_entities( void ) {
+  const float max_x = ( float ) g_app.LEVEL_WIDTH - STRESS_ENTITY_SIZE;
+  const float max_y = ( float ) g_app.LEVEL_HEIGHT - STRESS_ENTITY_SIZE;
+
+  for ( int32_t i = 0; i < config.entities; i++ ) {
+    struct stress_entity_t *e = &entities[i];
+
+    e->rect.x += e->velocity.x;
+    e->rect.y += e->velocity.y;
+
+    if ( e->rect.x < 0 || e->rect.x > max_x ) {
+      e->velocity.x = -e->velocity.x;
+      e->rect.x     = e->rect.x < 0 ? 0 : max_x;
+    }
+
+    if ( e->rect.y < 0 || e->rect.y > max_y ) {
+      e->velocity.y = -e->velocity.y;
+      e->rect.y     = e->rect.y < 0 ? 0 : max_y;
+    }
+
+    Stds_AABBTreeMove( tree, e->proxy, &e->rect, &e->velocity );
+
+    if ( e->polygon != NULL ) {
+      e->polygon->position = Stds_CreateVec2( e->rect.x + STRESS_ENTITY_SIZE / 2,
+                                              e->rect.y + STRESS_ENTITY_SIZE / 2 );
+      e->polygon->angle    = ( float ) ( ( ( int32_t ) e->polygon->angle + 1 ) % 360 );
+      Stds_UpdatePolygon( e->polygon );
+    }
+  }
+}
+
+/**
+ * Queries the AABB tree around every entity and counts the contacts, with
+ * SAT as the narrow phase when both entities are hexagons.
+ *
+ * @param void.
+ *
+ * @return void.
+ */
+static void
+update_collisions( void ) {
+  contacts = 0;
+
+  for ( int32_t i = 0; i < config.entities; i++ ) {
+    Stds_AABBTreeQueryRect( tree, &entities[i].rect, count_contact, &entities[i] );
+  }
+}
+
+/**
+ * Moves each emitter along a circle and sprays STRESS_EMIT_RATE particles
+ * from it, then steps the particle system.
+ *
+ * @param void.
+ *
+ * @return void.
+ */
+static void
+update_particles( void ) {
+  for ( int32_t i = 0; i < config.emitters; i++ ) {
+    const float   t      = ( float ) ( frame + i * 37 ) * 0.02f;
+    const float   radius = 100.0f * ( float ) ( i % 3 + 1 );
+    struct vec2_t origin = Stds_CreateVec2( g_app.camera.x + S_WIDTH / 2 + cosf( t ) * radius,
+                                            g_app.camera.y + S_HEIGHT / 2 + sinf( t ) * radius );
+
+    for ( int32_t k = 0; k < STRESS_EMIT_RATE; k++ ) {
+      struct particle_t p;
+      memset( &p, 0, sizeof( struct particle_t ) );
+
+      p.pos      = origin;
+      p.velocity = Stds_CreateVec2( Stds_RandomFloat( -2, 2 ), Stds_RandomFloat( -2, 2 ) );
+      p.w        = 3;
+      p.h        = 3;
+      p.life     = STRESS_PARTICLE_LIFE;
+      p.color    = ( SDL_Color ){ 0xff, ( uint8_t ) Stds_RandomInt( 64, 255 ), 0x20, 0xff };
+
+      Stds_InsertParticle( particles, &p );
+    }
+  }
+
+  Stds_ParticleSystemUpdate( particles );
+}
+
+/**
+ * Moves each trail source along a figure eight and emits a segment there.
+ *
+ * @param void.
+ *
+ * @return void.
+ */
+static void
+update_trails( void ) {
+  for ( int32_t i = 0; i < config.trails; i++ ) {
+    const float t = ( float ) frame * 0.03f + ( float ) i * 0.25f;
+    const float x = g_app.camera.x + S_WIDTH / 2 + sinf( t ) * ( S_WIDTH / 2 - 32 );
+    const float y = g_app.camera.y + S_HEIGHT / 2 + sinf( t * 2 ) * ( S_HEIGHT / 2 - 32 );
+
+    Stds_EmitTrail( trails[i], x, y, 8, 8, NULL, SDL_FLIP_NONE );
+    Stds_UpdateTrailEmitter( trails[i] );
+  }
+}
+
+/**
+ * Changes every text string, so each one is laid out again every frame.
+ *
+ * @param void.
+ *
+ * @return void.
+ */
+static void
+update_text( void ) {
+  char buffer[SMALL_TEXT_BUFFER];
+
+  for ( int32_t i = 0; i < config.texts; i++ ) {
+    snprintf( buffer, sizeof( buffer ), "text %d, frame %d", i, frame );
+    Stds_TextSet( texts[i], buffer );
+  }
+}
+
+/**
+ * AABB tree callback. Counts a contact when the candidate's real bounds
+ * overlap, and when both are hexagons, only if SAT agrees.
+ *
+ * @param int32_t proxy of the candidate.
+ * @param void * candidate entity.
+ * @param void * querying entity.
+ *
+ * @return bool true to keep querying.
+ */
+static bool
+count_contact( int32_t proxy, void *data, void *user ) {
+  struct stress_entity_t *other = data;
+  struct stress_entity_t *self  = user;
+  ( void ) proxy;
+
+  if ( other == self || !Stds_RectVsRect( &self->rect, &other->rect ) ) {
+    return true;
+  }
+
+  if ( self->polygon == NULL || other->polygon == NULL
+       || Stds_CheckSATOverlap( self->polygon, other->polygon ) ) {
+    contacts++;
+  }
+
+  return true;
+}
+
+/**
+ * Prints the scene size, the overall frame rate and the profiler's
+ * statistics for every scope.
+ *
+ * @param double seconds the game loop ran.
+ *
+ * @return void.
+ */
+static void
+print_report( const double seconds ) {
+  printf( "stress: %d entities, %d emitters, %d trails, %dx%d grid, %d texts, %s\n",
+          config.entities, config.emitters, config.trails, config.grid_size, config.grid_size,
+          config.texts, config.is_windowed ? "windowed" : "headless" );
+  printf( "%d frames in %.3f s (%.1f fps), %d particles alive, %lld contacts last frame\n",
+          frame, seconds, seconds > 0 ? frame / seconds : 0, particles->alive_count,
+          ( long long ) contacts );
+  printf( "%-16s %10s %10s %10s\n", "scope", "min_ms", "avg_ms", "p99_ms" );
+
+  for ( size_t i = 0; i < sizeof( scope_names ) / sizeof( scope_names[0] ); i++ ) {
+    float min_ms, avg_ms, p99_ms;
+
+    Stds_ProfilerGetStats( Stds_ProfilerRegisterScope( scope_names[i] ), &min_ms, &avg_ms,
+                           &p99_ms );
+    printf( "%-16s %10.3f %10.3f %10.3f\n", scope_names[i], min_ms, avg_ms, p99_ms );
+  }
+}
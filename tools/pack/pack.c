@@ -0,0 +1,253 @@
+/**
+ * @file pack.c
+ * @author Joshua Crotts
+ * @date October 14 2026
+ * @version 1.0
+ *
+ * @section LICENSE
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License as
+ * published by the Free Software Foundation; either version 2 of
+ * the License, or (at your option) any later version.
+ *
+ * @section DESCRIPTION
+ *
+ * Offline packer for the asset pack format read by src/pack.c. Build it with
+ * "make pack" and run it from the game's working directory, so the names stored in
+ * the pack match the paths the game loads:
+ *
+ *   ./pack [-rgba] -o game.pak res/img/a.png res/sfx/b.wav res/fonts/c.ttf ...
+ *
+ * With -rgba, .png, .jpg and .bmp files are decoded with SDL_image and stored as
+ * RGBA32 pixels, which trades pack size for zero decode time at startup.
+ */
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "SDL2/SDL.h"
+#include "SDL2/SDL_image.h"
+
+#include "../../include/stddefine.h"
+
+struct pack_input_t {
+  const char *name;
+  uint32_t    offset;
+  uint32_t    size;
+  uint16_t    width;
+  uint16_t    height;
+  uint32_t    type;
+};
+
+static bool Stds_PackWriteFile( FILE *out, struct pack_input_t *input, const bool is_rgba );
+static bool Stds_PackIsImage( const char *name );
+static void Stds_PackWriteLE32( FILE *out, const uint32_t value );
+static void Stds_PackWriteLE16( FILE *out, const uint16_t value );
+static int  Stds_PackCompareInputs( const void *a, const void *b );
+
+int
+main( int argc, char *argv[] ) {
+  const char *out_path = NULL;
+  bool        is_rgba  = false;
+  int32_t     count    = 0;
+
+  struct pack_input_t *inputs = calloc( ( size_t ) argc, sizeof( struct pack_input_t ) );
+
+  if ( inputs == NULL ) {
+    fprintf( stderr, "Could not allocate memory for the pack index.\n" );
+    return EXIT_FAILURE;
+  }
+
+  for ( int32_t i = 1; i < argc; i++ ) {
+    if ( strcmp( argv[i], "-rgba" ) == 0 ) {
+      is_rgba = true;
+    } else if ( strcmp( argv[i], "-o" ) == 0 && i + 1 < argc ) {
+      out_path = argv[++i];
+    } else if ( strlen( argv[i] ) >= STDS_PACK_NAME_LEN ) {
+      fprintf( stderr, "Name %s is longer than %d characters.\n", argv[i], STDS_PACK_NAME_LEN - 1 );
+      return EXIT_FAILURE;
+    } else {
+      inputs[count++].name = argv[i];
+    }
+  }
+
+  if ( out_path == NULL || count == 0 ) {
+    fprintf( stderr, "Usage: %s [-rgba] -o out.pak file...\n", argv[0] );
+    return EXIT_FAILURE;
+  }
+
+  /* The runtime binary-searches the index by name. */
+  qsort( inputs, ( size_t ) count, sizeof( struct pack_input_t ), Stds_PackCompareInputs );
+
+  FILE *out = fopen( out_path, "wb" );
+
+  if ( out == NULL ) {
+    fprintf( stderr, "Could not open %s for writing.\n", out_path );
+    return EXIT_FAILURE;
+  }
+
+  /* Reserve the header and index, write the blobs, then come back and fill
+     in the index now that every offset and size is known. */
+  long data_start = STDS_PACK_HEADER_SIZE + ( long ) count * STDS_PACK_ENTRY_SIZE;
+  fseek( out, data_start, SEEK_SET );
+
+  for ( int32_t i = 0; i < count; i++ ) {
+    long position = ftell( out );
+    long aligned  = ( position + STDS_PACK_ALIGNMENT - 1 ) & ~( long ) ( STDS_PACK_ALIGNMENT - 1 );
+
+    for ( ; position < aligned; position++ ) {
+      fputc( 0, out );
+    }
+
+    inputs[i].offset = ( uint32_t ) aligned;
+
+    if ( !Stds_PackWriteFile( out, &inputs[i], is_rgba && Stds_PackIsImage( inputs[i].name ) ) ) {
+      fclose( out );
+      remove( out_path );
+      return EXIT_FAILURE;
+    }
+  }
+
+  fseek( out, 0, SEEK_SET );
+  fwrite( "SPAK", 1, 4, out );
+  Stds_PackWriteLE32( out, STDS_PACK_VERSION );
+  Stds_PackWriteLE32( out, ( uint32_t ) count );
+  Stds_PackWriteLE32( out, 0 );
+
+  for ( int32_t i = 0; i < count; i++ ) {
+    char name[STDS_PACK_NAME_LEN];
+    memset( name, 0, sizeof( name ) );
+    strncpy( name, inputs[i].name, STDS_PACK_NAME_LEN - 1 );
+
+    fwrite( name, 1, STDS_PACK_NAME_LEN, out );
+    Stds_PackWriteLE32( out, inputs[i].offset );
+    Stds_PackWriteLE32( out, inputs[i].size );
+    Stds_PackWriteLE16( out, inputs[i].width );
+    Stds_PackWriteLE16( out, inputs[i].height );
+    Stds_PackWriteLE32( out, inputs[i].type );
+  }
+
+  fclose( out );
+  printf( "Packed %d files into %s.\n", count, out_path );
+  free( inputs );
+
+  return EXIT_SUCCESS;
+}
+
+/**
+ * Appends one input to the pack, either as-is or decoded to RGBA32 pixels.
+ *
+ * @param FILE * pack being written.
+ * @param pack_input_t * input; its size, type and dimensions are filled in.
+ * @param bool true to store the file as decoded pixels.
+ *
+ * @return bool true on success.
+ */
+static bool
+Stds_PackWriteFile( FILE *out, struct pack_input_t *input, const bool is_rgba ) {
+  if ( is_rgba ) {
+    SDL_Surface *loaded = IMG_Load( input->name );
+    SDL_Surface *rgba =
+      loaded != NULL ? SDL_ConvertSurfaceFormat( loaded, SDL_PIXELFORMAT_RGBA32, 0 ) : NULL;
+
+    SDL_FreeSurface( loaded );
+
+    if ( rgba == NULL || rgba->w > UINT16_MAX || rgba->h > UINT16_MAX ) {
+      fprintf( stderr, "Could not decode %s: %s\n", input->name, SDL_GetError() );
+      SDL_FreeSurface( rgba );
+      return false;
+    }
+
+    for ( int32_t y = 0; y < rgba->h; y++ ) {
+      fwrite( ( uint8_t * ) rgba->pixels + y * rgba->pitch, 4, ( size_t ) rgba->w, out );
+    }
+
+    input->type   = STDS_PACK_RGBA;
+    input->width  = ( uint16_t ) rgba->w;
+    input->height = ( uint16_t ) rgba->h;
+    input->size   = ( uint32_t ) rgba->w * ( uint32_t ) rgba->h * 4;
+    SDL_FreeSurface( rgba );
+    return true;
+  }
+
+  FILE *in = fopen( input->name, "rb" );
+
+  if ( in == NULL ) {
+    fprintf( stderr, "Could not open %s.\n", input->name );
+    return false;
+  }
+
+  char   buffer[1 << 16];
+  size_t n;
+
+  input->type = STDS_PACK_RAW;
+  while ( ( n = fread( buffer, 1, sizeof( buffer ), in ) ) > 0 ) {
+    fwrite( buffer, 1, n, out );
+    input->size += ( uint32_t ) n;
+  }
+
+  fclose( in );
+  return true;
+}
+
+/**
+ * Determines whether a file is an image SDL_image can decode for -rgba.
+ *
+ * @param const char * file name.
+ *
+ * @return bool true for .png, .jpg, .jpeg and .bmp files.
+ */
+static bool
+Stds_PackIsImage( const char *name ) {
+  const char *ext = strrchr( name, '.' );
+
+  return ext != NULL &&
+         ( SDL_strcasecmp( ext, ".png" ) == 0 || SDL_strcasecmp( ext, ".jpg" ) == 0 ||
+           SDL_strcasecmp( ext, ".jpeg" ) == 0 || SDL_strcasecmp( ext, ".bmp" ) == 0 );
+}
+
+/**
+ * Writes a little-endian 32-bit value.
+ *
+ * @param FILE * output.
+ * @param uint32_t value.
+ *
+ * @return void.
+ */
+static void
+Stds_PackWriteLE32( FILE *out, const uint32_t value ) {
+  const uint8_t bytes[4] = { ( uint8_t ) value, ( uint8_t ) ( value >> 8 ),
+                             ( uint8_t ) ( value >> 16 ), ( uint8_t ) ( value >> 24 ) };
+  fwrite( bytes, 1, 4, out );
+}
+
+/**
+ * Writes a little-endian 16-bit value.
+ *
+ * @param FILE * output.
+ * @param uint16_t value.
+ *
+ * @return void.
+ */
+static void
+Stds_PackWriteLE16( FILE *out, const uint16_t value ) {
+  const uint8_t bytes[2] = { ( uint8_t ) value, ( uint8_t ) ( value >> 8 ) };
+  fwrite( bytes, 1, 2, out );
+}
+
+/**
+ * qsort comparator ordering inputs by name.
+ *
+ * @param void * first input.
+ * @param void * second input.
+ *
+ * @return int negative, zero or positive.
+ */
+static int
+Stds_PackCompareInputs( const void *a, const void *b ) {
+  return strcmp( ( ( const struct pack_input_t * ) a )->name,
+                 ( ( const struct pack_input_t * ) b )->name );
+}